@@ -41,6 +41,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "nrf_sdm.h"
 
 #include "bluetooth/bleadv_mandata.h"
+#include "bluetooth/ble_scanflt.h"
 
 /** @addtogroup Bluetooth
   * @{
@@ -224,6 +225,13 @@ bool BleAppInit(const BLEAPP_CFG *pBleAppCfg, bool bEraseBond);
 void BleAppEnterDfu();
 void BleAppRun();
 uint16_t BleAppGetConnHandle();
+
+/**
+ * @brief	Get effective ATT MTU of current connection
+ *
+ * @return	ATT MTU negotiated with peer, default MTU if not exchanged
+ */
+uint16_t BleAppGetAttMtu();
 void BleAppGapDeviceNameSet(const char* ppDeviceName);
 void BleAppAdvManDataSet(uint8_t *pAdvData, int AdvLen, uint8_t *pSrData, int SrLen);
 void BleAppAdvTimeoutHandler();
@@ -236,6 +244,17 @@ bool BleAppScanInit(BLEAPP_SCAN_CFG *pCfg);
 //bool BleAppScanStart();
 void BleAppScan();
 void BleAppScanStop();
+
+/**
+ * @brief	Route advertising reports through a scan filter engine
+ *
+ * When set, advertising reports are given to the engine instead of
+ * BleCentralEvtUserHandler and scanning is resumed right away. Matching devices
+ * are delivered in batches by BleScanFltFlush from the main loop.
+ *
+ * @param	pFlt : Pointer to initialized engine, NULL to restore direct reports
+ */
+void BleAppScanFilterSet(BLESCANFLT * const pFlt);
 bool BleAppConnect(ble_gap_addr_t * const pDevAddr, ble_gap_conn_params_t * const pConnParam);
 bool BleAppEnableNotify(uint16_t ConnHandle, uint16_t CharHandle);
 bool BleAppWrite(uint16_t ConnHandle, uint16_t CharHandle, uint8_t *pData, uint16_t DatLen);
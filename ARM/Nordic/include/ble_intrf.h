@@ -40,13 +40,12 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ble_service.h"
 #include "device_intrf.h"
 #include "cfifo.h"
+#include "bluetooth/ble_ntfpump.h"
 
 /** @addtogroup Bluetooth
   * @{
   */
 
-#define BLEINTRF_TRANSBUFF_MAXLEN       512
-
 /**
  * Calculate require mem
  */
@@ -88,9 +87,7 @@ typedef struct __BleDeviceInterf {
     int			TxCharIdx;	//!< Read characteristic index (to BLE)
     int			PacketSize;	//!< BLE packet size
     HCFIFO		hRxFifo;
-    HCFIFO		hTxFifo;
-    uint8_t     TransBuff[BLEINTRF_TRANSBUFF_MAXLEN];  //
-    int         TransBuffLen;   //!< Data length
+    BLENTFPUMP	TxPump;		//!< Notification pump, packs Tx data into ATT MTU size packets
 } BLEINTRF;
 #pragma pack(pop)
 
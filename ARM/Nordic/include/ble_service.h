@@ -137,6 +137,7 @@ struct __BLE_Service_Data {
     int				LongWrBuffSize;		//!< long write buffer size
     void			*pContext;
     BLESRVC_AUTHREQ	AuthReqCB;			//!< Authorization request callback
+    uint16_t		TxCompleteCnt;		//!< Number of notifications completed in last Tx complete event
 };
 
 #pragma pack(pop)
@@ -43,9 +43,13 @@ Modified by          Date              Description
 
 #include "device_intrf.h"
 #include "cfifo.h"
+#include "esb_link.h"
 
 #define ESBINTRF_CFIFO_MEMSIZE(NbBlk)      CFIFO_TOTAL_MEMSIZE(NbBlk, sizeof(nrf_esb_payload_t))
 
+#define ESBINTRF_LINK_RTO_DEFAULT		32		//!< Reliable mode retransmit timeout in radio events
+#define ESBINTRF_LINK_PRX_QUE			2		//!< Reliable mode ACK payloads queued by PRX
+
 #pragma pack(push, 4)
 typedef struct __EsbDeviceInterfConfig {
     uint8_t BaseAddr0[4];
@@ -63,6 +67,12 @@ typedef struct __EsbDeviceInterfConfig {
     uint8_t *pTxFifoMem;    // Pointer to memory to be used by CFIFO
     uint8_t	IntPrio;		//!< Interrupt priority
     DEVINTRF_EVTCB EvtCB;   //!< Event callback
+    bool    bReliable;      //!< Run EsbLink sliding window over the radio, both ends must match
+    bool    bLinkPack;      //!< Reliable mode, combine small writes into one packet
+    int     LinkWindow;     //!< Reliable mode, packets in flight, power of 2, max ESBLINK_WINDOW_MAX
+    uint32_t LinkRto;       //!< Reliable mode, retransmit timeout in radio events. 0 for default
+    int     LinkMemSize;    //!< Reliable mode, link memory size, see ESBLINK_MEMSIZE
+    uint8_t *pLinkMem;      //!< Reliable mode, pointer to link memory
 } ESBINTRF_CFG;
 
 // BLE interf instance data
@@ -76,6 +86,10 @@ typedef struct __BleDeviceInterf {
     uint8_t BaseAddr0[4];
     uint8_t BaseAddr1[4];
     uint8_t PipePrefix[8];
+    bool    bAckSent;       // PRX, ACK payload sent, number of packets set by the Rx event
+    bool    bReliable;      // EsbLink enabled
+    volatile uint32_t EvtCnt;	// Radio events count, link time base
+    ESBLINK Link;           // Reliable mode link data
 } ESBINTRF;
 #pragma pack(pop)
 
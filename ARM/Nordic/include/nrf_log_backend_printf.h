@@ -0,0 +1,62 @@
+/**-------------------------------------------------------------------------
+@file	nrf_log_backend_printf.h
+
+@brief	nrf_log printf backend, deferred output option
+
+By default the backend formats each message and prints it with printf.
+Attaching a DLOG queues the messages instead, formatting & output happen
+later in DLogProcess.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+Copyright (c) 2026, I-SYST inc., all rights reserved
+
+Permission to use, copy, modify, and distribute this software for any purpose
+with or without fee is hereby granted, provided that the above copyright
+notice and this permission notice appear in all copies, and none of the
+names : I-SYST or its contributors may be used to endorse or
+promote products derived from this software without specific prior written
+permission.
+
+For info or contributing contact : hnhoan at i-syst dot com
+
+THIS SOFTWARE IS PROVIDED BY THE REGENTS AND CONTRIBUTORS ``AS IS'' AND ANY
+EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE REGENTS OR CONTRIBUTORS BE LIABLE FOR ANY
+DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF
+THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+----------------------------------------------------------------------------*/
+#ifndef __NRF_LOG_BACKEND_PRINTF_H__
+#define __NRF_LOG_BACKEND_PRINTF_H__
+
+#include "dlog.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Route nrf_log output to a deferred log.
+ *
+ * Messages are queued with their arguments, nrf_log time stamp is replaced
+ * by the DLOG one.  Hexdump data is copied as words, without the character
+ * column.  %s arguments must point to constant strings.
+ *
+ * @param	pLog	: Initialized deferred log, NULL - back to printf
+ */
+void nrf_log_backend_printf_dlog(DLOG * const pLog);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __NRF_LOG_BACKEND_PRINTF_H__
@@ -130,9 +130,11 @@ typedef struct _BleAppData {
     ble_advdata_manuf_data_t ManufData;
     ble_advdata_manuf_data_t SRManufData;
 	int MaxMtu;
+	uint16_t AttMtu;	// Effective ATT MTU of current connection
 	bool bSecure;
 	bool bAdvertising;
 	bool bScan;
+	BLESCANFLT *pScanFlt;	// Advertising report filter engine
 } BLEAPP_DATA;
 
 #pragma pack(pop)
@@ -463,6 +465,7 @@ static void on_ble_evt(ble_evt_t const * p_ble_evt)
         	g_BleAppData.bAdvertising = false;
         	BleConnLedOn();
         	g_BleAppData.ConnHdl = p_ble_evt->evt.gap_evt.conn_handle;
+        	g_BleAppData.AttMtu = NRF_BLE_MAX_MTU_SIZE;
 
             break;
 
@@ -841,7 +844,25 @@ static void ble_evt_dispatch(ble_evt_t const * p_ble_evt, void *p_context)
             break;
         }
 #endif
-        BleCentralEvtUserHandler((ble_evt_t *)p_ble_evt);
+        if (p_ble_evt->header.evt_id == BLE_GAP_EVT_ADV_REPORT && g_BleAppData.pScanFlt != NULL)
+        {
+        	const ble_gap_evt_adv_report_t *p_adv_report = &p_ble_evt->evt.gap_evt.params.adv_report;
+        	BLESCANFLT_REPORT rpt;
+
+        	memcpy(rpt.Addr, p_adv_report->peer_addr.addr, BLESCANFLT_ADDR_LEN);
+        	rpt.AddrType = p_adv_report->peer_addr.addr_type;
+        	rpt.Rssi = p_adv_report->rssi;
+        	rpt.pData = p_adv_report->data.p_data;
+        	rpt.Len = p_adv_report->data.len;
+        	BleScanFltPut(g_BleAppData.pScanFlt, &rpt);
+
+        	// Report buffer is consumed, resume scanning
+        	BleAppScan();
+        }
+        else
+        {
+        	BleCentralEvtUserHandler((ble_evt_t *)p_ble_evt);
+        }
     }
     if (g_BleAppData.AppRole & BLEAPP_ROLE_PERIPHERAL)
     {
@@ -1248,11 +1269,17 @@ uint16_t BleAppGetConnHandle()
 	return g_BleAppData.ConnHdl;
 }
 
+uint16_t BleAppGetAttMtu()
+{
+	return g_BleAppData.AttMtu > 0 ? g_BleAppData.AttMtu : NRF_BLE_MAX_MTU_SIZE;
+}
+
 /**@brief Function for handling events from the GATT library. */
 void BleGattEvtHandler(nrf_ble_gatt_t * p_gatt, const nrf_ble_gatt_evt_t * p_evt)
 {
     if ((g_BleAppData.ConnHdl == p_evt->conn_handle) && (p_evt->evt_id == NRF_BLE_GATT_EVT_ATT_MTU_UPDATED))
     {
+    	g_BleAppData.AttMtu = p_evt->params.att_mtu_effective;
     	//g_BleAppData.MaxMtu = p_evt->params.att_mtu_effective - 3;//OPCODE_LENGTH - HANDLE_LENGTH;
        // m_ble_nus_max_data_len = p_evt->params.att_mtu_effective - OPCODE_LENGTH - HANDLE_LENGTH;
         //NRF_LOG_INFO("Data len is set to 0x%X(%d)\r\n", m_ble_nus_max_data_len, m_ble_nus_max_data_len);
@@ -1590,6 +1617,11 @@ void BleAppScan()
 	APP_ERROR_CHECK(err_code);
 }
 
+void BleAppScanFilterSet(BLESCANFLT * const pFlt)
+{
+	g_BleAppData.pScanFlt = pFlt;
+}
+
 void BleAppScanStop()
 {
 	if (g_BleAppData.bScan == true)
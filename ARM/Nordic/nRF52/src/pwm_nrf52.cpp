@@ -34,6 +34,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <string.h>
 
 #include "pwm.h"
+#include "pwm_seq.h"
 
 #include "nrf.h"
 
@@ -49,6 +50,10 @@ typedef struct {
 	uint16_t Seq0[PWM_NRF5_MAX_CHAN];
 	uint16_t Seq1[PWM_NRF5_MAX_CHAN];
 	volatile bool bStarted;
+	IRQn_Type IrqNo;					//!< Interrupt number
+	uint32_t IntEn;						//!< Interrupt enable mask for fixed duty mode
+	PWMSEQ * volatile pSeq;				//!< Sequence being played, NULL in fixed duty mode
+	volatile int SeqLast;				//!< Half buffer ending the sequence, -1 not known yet
 } PWM_NRF_DEV;
 
 static PWM_NRF_DEV s_PwmnRFDev[PWM_NRF5_MAX_DEV] = {
@@ -89,7 +94,7 @@ bool PWMInit(PWM_DEV *pDev, const PWM_CFG *pCfg)
 
 	pDev->DevNo = pCfg->DevNo;
 	pDev->Mode = pCfg->Mode;
-	pDev->Mode = pCfg->Mode;
+	pDev->pEvtHandler = pCfg->pEvtHandler;
 	dev = &s_PwmnRFDev[pCfg->DevNo];
 	dev->pDev = pDev;
 	pDev->pDevData = (void*)dev;
@@ -111,41 +116,46 @@ bool PWMInit(PWM_DEV *pDev, const PWM_CFG *pCfg)
 
 	dev->pReg->DECODER = PWM_DECODER_LOAD_Individual << PWM_DECODER_LOAD_Pos;
 
-	dev->pReg->SEQ[0].PTR = (uint32_t)dev->Seq0;
+	dev->pReg->SEQ[0].PTR = (uintptr_t)dev->Seq0;
 	dev->pReg->SEQ[0].CNT = PWM_NRF5_MAX_CHAN;
 	dev->pReg->SEQ[0].REFRESH = 0;
 	dev->pReg->SEQ[0].ENDDELAY = 0;
 
-	dev->pReg->SEQ[1].PTR = (uint32_t)dev->Seq1;
+	dev->pReg->SEQ[1].PTR = (uintptr_t)dev->Seq1;
 	dev->pReg->SEQ[1].CNT = PWM_NRF5_MAX_CHAN;
 	dev->pReg->SEQ[1].REFRESH = 0;
 	dev->pReg->SEQ[1].ENDDELAY = 0;
 
-	if (pCfg->bIntEn)
+	dev->pSeq = NULL;
+	dev->IntEn = 0;
+
+	switch (pCfg->DevNo)
 	{
-		IRQn_Type irqno;
+		case 0:
+			dev->IrqNo = PWM0_IRQn;
+			break;
+		case 1:
+			dev->IrqNo = PWM1_IRQn;
+			break;
+		case 2:
+			dev->IrqNo = PWM2_IRQn;
+			break;
+	}
 
-		dev->pReg->INTEN = PWM_INTEN_LOOPSDONE_Msk | PWM_INTEN_PWMPERIODEND_Msk |
-						   //PWM_INTEN_SEQEND1_Msk | PWM_INTEN_SEQEND0_Msk |
-						   //PWM_INTEN_SEQSTARTED1_Msk | PWM_INTEN_SEQSTARTED0_Msk |
-						   PWM_INTEN_STOPPED_Msk;
+	// Priority is also used by sequence playback
+	NVIC_ClearPendingIRQ(dev->IrqNo);
+	NVIC_SetPriority(dev->IrqNo, pCfg->IntPrio);
 
-		switch (pCfg->DevNo)
-		{
-			case 0:
-				irqno = PWM0_IRQn;
-				break;
-			case 1:
-				irqno = PWM1_IRQn;
-				break;
-			case 2:
-				irqno = PWM2_IRQn;
-				break;
-		}
-		NVIC_ClearPendingIRQ(irqno);
-		NVIC_SetPriority(irqno, pCfg->IntPrio);
-		NVIC_EnableIRQ(irqno);
+	if (pCfg->bIntEn)
+	{
+		dev->IntEn = PWM_INTEN_LOOPSDONE_Msk | PWM_INTEN_PWMPERIODEND_Msk |
+					 //PWM_INTEN_SEQEND1_Msk | PWM_INTEN_SEQEND0_Msk |
+					 //PWM_INTEN_SEQSTARTED1_Msk | PWM_INTEN_SEQSTARTED0_Msk |
+					 PWM_INTEN_STOPPED_Msk;
+
+		NVIC_EnableIRQ(dev->IrqNo);
 	}
+	dev->pReg->INTEN = dev->IntEn;
 
 	PWMEnable(pDev);
 
@@ -231,7 +241,12 @@ bool PWMSetFrequency(PWM_DEV *pDev, uint32_t Freq)
 	dev->TopCount = ct;
 	dev->pReg->COUNTERTOP = ct;
 
-	if (dev->bStarted)
+	if (dev->pSeq)
+	{
+		// Takes effect from the next half buffer refill
+		PwmSeqSetTop(dev->pSeq, ct);
+	}
+	else if (dev->bStarted)
 	{
 		dev->pReg->TASKS_SEQSTART[0] = 1;
 	}
@@ -341,6 +356,14 @@ void PWMStop(PWM_DEV *pDev)
 
 
 bool PWMSetDutyCycle(PWM_DEV *pDev, int Chan, int DutyCycle)
+{
+	if (DutyCycle < 0 || DutyCycle > 100)
+		return false;
+
+	return PWMSetDuty(pDev, Chan, (uint16_t)((DutyCycle * PWM_DUTY_MAX + 50) / 100));
+}
+
+bool PWMSetDuty(PWM_DEV *pDev, int Chan, uint16_t Duty)
 {
 	if (pDev == NULL)
 		return false;
@@ -350,12 +373,11 @@ bool PWMSetDutyCycle(PWM_DEV *pDev, int Chan, int DutyCycle)
 
 	PWM_NRF_DEV *dev = (PWM_NRF_DEV*)pDev->pDevData;
 
-	uint32_t x = dev->TopCount * DutyCycle / 100;
+	if (dev == NULL || dev->pSeq != NULL)
+		return false;
 
-	if (pDev->Mode == PWM_MODE_CENTER)
-	{
-		x >>= 1;
-	}
+	// TopCount is already halved in center mode
+	uint32_t x = PwmDutyToCmp(Duty, dev->TopCount);
 
 	if (dev->Pol[Chan] == PWM_POL_HIGH)
 	{
@@ -407,11 +429,191 @@ bool PWMPlay(PWM_DEV *pDev, int Chan, uint32_t Freq, uint32_t Dur)
 	return true;
 }
 
+/**
+ * @brief	Return to fixed duty mode after sequence playback
+ */
+static void nRF52PWMSeqRestore(PWM_NRF_DEV *pDev)
+{
+	pDev->pReg->SHORTS = 0;
+	pDev->pReg->LOOP = 0;
+	pDev->pReg->SEQ[0].PTR = (uintptr_t)pDev->Seq0;
+	pDev->pReg->SEQ[0].CNT = PWM_NRF5_MAX_CHAN;
+	pDev->pReg->SEQ[0].REFRESH = 0;
+	pDev->pReg->SEQ[1].PTR = (uintptr_t)pDev->Seq1;
+	pDev->pReg->SEQ[1].CNT = PWM_NRF5_MAX_CHAN;
+	pDev->pReg->SEQ[1].REFRESH = 0;
+	pDev->pReg->EVENTS_SEQEND[0] = 0;
+	pDev->pReg->EVENTS_SEQEND[1] = 0;
+	pDev->pReg->INTEN = pDev->IntEn;
+	pDev->pSeq = NULL;
+}
+
+/**
+ * @brief	Set stop after half buffer Half
+ *
+ * SEQ[1] ends with the loop. With LOOP = 1, LOOPSDONE follows SEQEND1. When
+ * SEQ[0] is the last, SEQ[1] playing now must still loop back to it.
+ */
+static inline void nRF52PWMSeqSetLast(PWM_NRF_DEV *pDev, int Half)
+{
+	pDev->SeqLast = Half;
+	pDev->pReg->SHORTS = Half == 0 ? PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk | PWM_SHORTS_SEQEND0_STOP_Msk :
+									 PWM_SHORTS_LOOPSDONE_STOP_Msk;
+}
+
+bool PWMSeqStart(PWM_DEV *pDev, PWMSEQ *pSeq)
+{
+	if (pDev == NULL || pSeq == NULL)
+		return false;
+
+	PWM_NRF_DEV *dev = (PWM_NRF_DEV*)pDev->pDevData;
+
+	if (dev == NULL)
+		return false;
+
+	// Individual decoder loads one compare value per channel each PWM period
+	if (pSeq->NbChan != PWM_NRF5_MAX_CHAN ||
+		pSeq->NbFrame * PWM_NRF5_MAX_CHAN > (int)PWM_SEQ_CNT_CNT_Msk ||
+		pSeq->Repeat > PWM_SEQ_REFRESH_CNT_Msk + 1)
+	{
+		return false;
+	}
+
+	PWMSeqStop(pDev);
+	if (dev->bStarted)
+	{
+		PWMStop(pDev);
+	}
+
+	dev->pReg->INTEN = 0;
+
+	PwmSeqSetTop(pSeq, dev->TopCount);
+	for (int i = 0; i < PWM_NRF5_MAX_CHAN; i++)
+	{
+		PwmSeqSetFlag(pSeq, i, dev->Pol[i] == PWM_POL_HIGH ? 0x8000 : 0);
+	}
+	PwmSeqRewind(pSeq);
+
+	int n0 = PwmSeqFill(pSeq, 0);
+	int n1 = n0 < pSeq->NbFrame ? 0 : PwmSeqFill(pSeq, 1);
+
+	if (n0 <= 0)
+	{
+		dev->pReg->INTEN = dev->IntEn;
+
+		return false;
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		dev->pReg->SEQ[i].PTR = (uintptr_t)pSeq->pBuf[i];
+		dev->pReg->SEQ[i].CNT = PWM_NRF5_MAX_CHAN * pSeq->NbFrame;
+		dev->pReg->SEQ[i].REFRESH = pSeq->Repeat - 1;
+		dev->pReg->SEQ[i].ENDDELAY = 0;
+	}
+
+	// Endless SEQ[0], SEQ[1] ping-pong until the last half is known
+	dev->pReg->LOOP = 1;
+	dev->pReg->SHORTS = PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk;
+	dev->SeqLast = -1;
+
+	if (n1 <= 0)
+	{
+		dev->pReg->SEQ[0].CNT = PWM_NRF5_MAX_CHAN * n0;
+		nRF52PWMSeqSetLast(dev, 0);
+	}
+	else if (n1 < pSeq->NbFrame)
+	{
+		dev->pReg->SEQ[1].CNT = PWM_NRF5_MAX_CHAN * n1;
+		nRF52PWMSeqSetLast(dev, 1);
+	}
+
+	dev->pReg->EVENTS_SEQEND[0] = 0;
+	dev->pReg->EVENTS_SEQEND[1] = 0;
+	dev->pReg->EVENTS_LOOPSDONE = 0;
+	dev->pReg->EVENTS_STOPPED = 0;
+	dev->pSeq = pSeq;
+	dev->pReg->INTEN = PWM_INTEN_SEQEND0_Msk | PWM_INTEN_SEQEND1_Msk | PWM_INTEN_STOPPED_Msk;
+
+	NVIC_ClearPendingIRQ(dev->IrqNo);
+	NVIC_EnableIRQ(dev->IrqNo);
+
+	dev->pReg->TASKS_SEQSTART[0] = 1;
+	dev->bStarted = true;
+
+	return true;
+}
+
+void PWMSeqStop(PWM_DEV *pDev)
+{
+	if (pDev == NULL)
+		return;
+
+	PWM_NRF_DEV *dev = (PWM_NRF_DEV*)pDev->pDevData;
+
+	if (dev == NULL || dev->pSeq == NULL)
+		return;
+
+	dev->pReg->INTEN = 0;
+	if (dev->bStarted)
+	{
+		PWMStop(pDev);
+	}
+	nRF52PWMSeqRestore(dev);
+}
+
+/**
+ * @brief	Refill the half buffer the hardware just finished
+ *
+ * The other half is playing, refill must complete before it ends.
+ */
+static void nRF52PWMSeqIrq(PWM_NRF_DEV *pDev)
+{
+	PWMSEQ *seq = pDev->pSeq;
+
+	// Not reported in sequence mode
+	pDev->pReg->EVENTS_LOOPSDONE = 0;
+	pDev->pReg->EVENTS_PWMPERIODEND = 0;
+
+	for (int i = 0; i < 2; i++)
+	{
+		if (pDev->pReg->EVENTS_SEQEND[i] == 0)
+		{
+			continue;
+		}
+
+		pDev->pReg->EVENTS_SEQEND[i] = 0;
+
+		if (pDev->SeqLast >= 0)
+		{
+			continue;
+		}
+
+		int n = PwmSeqFill(seq, i);
+
+		if (n <= 0)
+		{
+			// Half now playing is the last one
+			nRF52PWMSeqSetLast(pDev, i ^ 1);
+		}
+		else if (n < seq->NbFrame)
+		{
+			pDev->pReg->SEQ[i].CNT = PWM_NRF5_MAX_CHAN * n;
+			nRF52PWMSeqSetLast(pDev, i);
+		}
+	}
+}
+
 void nRF52PWMIrqHandler(int PwmNo)
 {
 	PWM_NRF_DEV *dev = &s_PwmnRFDev[PwmNo];
 	PWM_EVT evt = (PWM_EVT)-1;
 
+	if (dev->pSeq != NULL)
+	{
+		nRF52PWMSeqIrq(dev);
+	}
+
 	if (dev->pReg->EVENTS_LOOPSDONE == 1)
 	{
 		evt = PWM_EVT_STARTED;
@@ -428,6 +630,10 @@ void nRF52PWMIrqHandler(int PwmNo)
 		evt = PWM_EVT_STOPPED;
 		dev->pReg->EVENTS_STOPPED = 0;
 		dev->bStarted = false;
+		if (dev->pSeq != NULL)
+		{
+			nRF52PWMSeqRestore(dev);
+		}
 	}
 
 	if (evt != -1 && dev->pDev->pEvtHandler)
@@ -67,5 +67,10 @@ __WEAK void BleAppRtosWaitEvt(void)
 
 }
 
+__WEAK uint16_t BleAppGetAttMtu()
+{
+	return NRF_BLE_MAX_MTU_SIZE;
+}
+
 
 
@@ -195,32 +195,35 @@ bool BleIntrfStartTx(DEVINTRF *pDevIntrf, int DevAddr)
 	return true;
 }
 
+/**
+ * @brief - Notification pump send callback
+ * 		Queue one notification in the SoftDevice.
+ */
+static BLENTFPUMP_SENDRES BleIntrfSendNotify(void *pCtx, uint8_t *pData, uint16_t Len)
+{
+	BLEINTRF *intrf = (BLEINTRF*)pCtx;
+	uint32_t res = BleSrvcCharNotify(intrf->pBleSrv, intrf->TxCharIdx, pData, Len);
+
+	if (res == NRF_SUCCESS)
+	{
+		return BLENTFPUMP_SENDRES_OK;
+	}
+#if (NRF_SD_BLE_API_VERSION > 3)
+	if (res == NRF_ERROR_RESOURCES)
+#else
+	if (res == BLE_ERROR_NO_TX_PACKETS)
+#endif
+	{
+		// SoftDevice queue full, packet stays in pump until next Tx complete
+		return BLENTFPUMP_SENDRES_BUSY;
+	}
+
+	return BLENTFPUMP_SENDRES_FAIL;
+}
+
 bool BleIntrfNotify(BLEINTRF *pIntrf)
 {
-    BLEINTRF_PKT *pkt;
-    uint32_t res = NRF_SUCCESS;
-
-    if (pIntrf->TransBuffLen > 0)
-    {
-        res = BleSrvcCharNotify(pIntrf->pBleSrv, pIntrf->TxCharIdx, pIntrf->TransBuff, pIntrf->TransBuffLen);
-    }
-    if (res != NRF_ERROR_RESOURCES)
-    {
-        pIntrf->TransBuffLen = 0;
-        do {
-            pkt = (BLEINTRF_PKT *)CFifoGet(pIntrf->hTxFifo);
-            if (pkt != NULL)
-            {
-                uint32_t res = BleSrvcCharNotify(pIntrf->pBleSrv, pIntrf->TxCharIdx, pkt->Data, pkt->Len);
-                if (res == NRF_ERROR_RESOURCES)
-                {
-                    memcpy(pIntrf->TransBuff, pkt->Data, pkt->Len);
-                    pIntrf->TransBuffLen = pkt->Len;
-                    break;
-                }
-            }
-        } while (pkt != NULL);
-    }
+	BleNtfPumpProcess(&pIntrf->TxPump);
 
     return true;
 }
@@ -240,25 +243,19 @@ bool BleIntrfNotify(BLEINTRF *pIntrf)
 int BleIntrfTxData(DEVINTRF *pDevIntrf, uint8_t *pData, int DataLen)
 {
 	BLEINTRF *intrf = (BLEINTRF*)pDevIntrf->pDevData;
-    BLEINTRF_PKT *pkt;
-    int maxlen = intrf->hTxFifo->BlkSize - sizeof(pkt->Len);
-	int cnt = 0;
 
-	while (DataLen > 0)
+	if (intrf->pBleSrv->ConnHdl == BLE_CONN_HANDLE_INVALID)
 	{
-		pkt = (BLEINTRF_PKT *)CFifoPut(intrf->hTxFifo);
-		if (pkt == NULL)
-			break;
-        int l = min(DataLen, maxlen);
-		memcpy(pkt->Data, pData, l);
-		pkt->Len = l;
-		DataLen -= l;
-		pData += l;
-		cnt += l;
+		// Nothing can be sent, discard stale packets & in flight count
+		BleNtfPumpReset(&intrf->TxPump);
+
+		return 0;
 	}
-	BleIntrfNotify(intrf);
 
-	return cnt;
+	// Payload follows the MTU negotiated for the current connection
+	BleNtfPumpSetMtu(&intrf->TxPump, BleAppGetAttMtu());
+
+	return BleNtfPumpWrite(&intrf->TxPump, pData, DataLen);
 }
 
 /**
@@ -298,7 +295,10 @@ void BleIntrfReset(DEVINTRF *pDevIntrf)
  */
 void BleIntrfTxComplete(BLESRVC *pBleSvc, int CharIdx)
 {
-    BleIntrfNotify((BLEINTRF*)pBleSvc->pContext);
+	BLEINTRF *intrf = (BLEINTRF*)pBleSvc->pContext;
+
+	// Frees stack queue slots and pushes next packets in the same event
+	BleNtfPumpTxComplete(&intrf->TxPump, pBleSvc->TxCompleteCnt);
 }
 
 void BleIntrfRxWrCB(BLESRVC *pBleSvc, uint8_t *pData, int Offset, int Len)
@@ -338,15 +338,29 @@ bool BleIntrfInit(BLEINTRF *pBleIntrf, const BLEINTRF_CFG *pCfg)
 		pBleIntrf->PacketSize = pCfg->PacketSize;
 	}
 
+	BLENTFPUMP_CFG pumpcfg;
+
+	pumpcfg.pMem = s_nRFBleTxFifoMem;
+	pumpcfg.MemSize = NRFBLEINTRF_CFIFO_SIZE;
+	pumpcfg.MaxPayload = pBleIntrf->PacketSize - sizeof(((BLEINTRF_PKT*)0)->Len);
+	pumpcfg.PartialInFlight = 1;
+	pumpcfg.SendCB = BleIntrfSendNotify;
+	pumpcfg.pCtx = pBleIntrf;
+
 	if (pCfg->pRxFifoMem == NULL || pCfg->pTxFifoMem == NULL)
 	{
 		pBleIntrf->hRxFifo = CFifoInit(s_nRFBleRxFifoMem, NRFBLEINTRF_CFIFO_SIZE, pBleIntrf->PacketSize, true);
-		pBleIntrf->hTxFifo = CFifoInit(s_nRFBleTxFifoMem, NRFBLEINTRF_CFIFO_SIZE, pBleIntrf->PacketSize, true);
 	}
 	else
 	{
 		pBleIntrf->hRxFifo = CFifoInit(pCfg->pRxFifoMem, pCfg->RxFifoMemSize, pBleIntrf->PacketSize, true);
-		pBleIntrf->hTxFifo = CFifoInit(pCfg->pTxFifoMem, pCfg->TxFifoMemSize, pBleIntrf->PacketSize, true);
+		pumpcfg.pMem = pCfg->pTxFifoMem;
+		pumpcfg.MemSize = pCfg->TxFifoMemSize;
+	}
+
+	if (BleNtfPumpInit(&pBleIntrf->TxPump, &pumpcfg) == false)
+	{
+		return false;
 	}
 
 	pBleIntrf->DevIntrf.pDevData = (void*)pBleIntrf;
@@ -371,7 +385,6 @@ bool BleIntrfInit(BLEINTRF *pBleIntrf, const BLEINTRF_CFG *pCfg)
 	pBleIntrf->DevIntrf.StopTx = BleIntrfStopTx;
 	pBleIntrf->DevIntrf.MaxRetry = 0;
 	pBleIntrf->DevIntrf.EvtCB = pCfg->EvtCB;
-	pBleIntrf->TransBuffLen = 0;
 	atomic_flag_clear(&pBleIntrf->DevIntrf.bBusy);
 
 	return true;
@@ -393,13 +406,7 @@ bool BleIntrf::RequestToSend(int NbBytes)
 	//
 	BleIntrfNotify(&vBleIntrf);
 
-	if (vBleIntrf.hTxFifo)
-	{
-		int avail = CFifoAvail(vBleIntrf.hTxFifo);
-		if ((avail * vBleIntrf.PacketSize) > NbBytes)
-			retval = true;
-	}
-	else
+	if (BleNtfPumpAvail(&vBleIntrf.TxPump) > NbBytes)
 	{
 		retval = true;
 	}
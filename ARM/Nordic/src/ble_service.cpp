@@ -210,6 +210,11 @@ void BleSrvcEvtHandler(BLESRVC *pSrvc, ble_evt_t *pBleEvt)
 #endif
             if (pSrvc->ConnHdl == pBleEvt->evt.gatts_evt.conn_handle)
             {
+#if (NRF_SD_BLE_API_VERSION > 3)
+            	pSrvc->TxCompleteCnt = pBleEvt->evt.gatts_evt.params.hvn_tx_complete.count;
+#else
+            	pSrvc->TxCompleteCnt = pBleEvt->evt.common_evt.params.tx_complete.count;
+#endif
                 for (int i = 0; i < pSrvc->NbChar; i++)
                 {
                     //if (pBleEvt->evt.gatts_evt.params.hvc.handle == pSrvc->pCharArray[i].Hdl.value_handle &&
@@ -413,6 +418,7 @@ uint32_t BleSrvcInit(BLESRVC *pSrvc, const BLESRVC_CFG *pCfg)
     pSrvc->pLongWrBuff = pCfg->pLongWrBuff;
     pSrvc->LongWrBuffSize = pCfg->LongWrBuffSize;
     pSrvc->AuthReqCB = pCfg->AuthReqCB;
+    pSrvc->TxCompleteCnt = 0;
 
     return NRF_SUCCESS;
 }
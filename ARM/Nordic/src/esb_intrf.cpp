@@ -41,6 +41,7 @@ Modified by          Date              Description
 #include "sdk_common.h"
 
 #include "istddef.h"
+#include "interrupt.h"
 #include "esb_intrf.h"
 
 
@@ -48,7 +49,87 @@ static uint8_t s_EsbRxFifoMem[ESBINTRF_CFIFO_MEMSIZE(2)];
 static uint8_t s_EsbTxFifoMem[ESBINTRF_CFIFO_MEMSIZE(2)];
 
 static EsbIntrf *s_pEsbDevice = NULL;
-static volatile bool s_bEsbTxReady = true;
+
+/**
+ * @brief - Move queued packets into the radio Tx FIFO until it is full
+ *
+ * Keeping the radio FIFO full lets the radio chain packets without waiting
+ * for the event handler. On PRX the packets are ACK payloads.
+ * The driver merges Tx events that happen before the handler runs, so the
+ * radio FIFO is not counted here. Writing until it refuses is exact.
+ * Must be called with interrupts disabled.
+ */
+static void EsbIntrfTxFill(ESBINTRF *pIntrf)
+{
+    while (true)
+    {
+        nrf_esb_payload_t *payload = (nrf_esb_payload_t *)CFifoPeek(pIntrf->hTxFifo);
+        if (payload == NULL)
+            break;
+
+        if (nrf_esb_write_payload(payload) == NRF_ERROR_NO_MEM)
+            break;
+
+        // Sent to radio or rejected, either way it leaves the queue
+        CFifoGet(pIntrf->hTxFifo);
+    }
+}
+
+/**
+ * @brief - Report radio transmit completions to EsbLink
+ *
+ * Tx events are merged by the driver when several packets complete before
+ * the handler runs. PTX radio going idle means its FIFO is empty, so all
+ * frames queued were sent. PRX sends one ACK payload per new packet, the
+ * Rx event gives the packet count.
+ *
+ * @param   Cnt : Completions seen by the event, at least 1
+ */
+static void EsbIntrfLinkTxDone(ESBINTRF *pIntrf, int Cnt)
+{
+    // EsbLinkTxDone may queue new frames, they are behind these
+    int n = min(Cnt, (int)pIntrf->Link.RadioQue);
+
+    while (n-- > 0)
+    {
+        EsbLinkTxDone(&pIntrf->Link, true, pIntrf->EvtCnt);
+    }
+}
+
+/**
+ * @brief - EsbLink radio send callback
+ */
+static bool EsbIntrfLinkSend(void *pCtx, const uint8_t *pFrame, int Len)
+{
+    nrf_esb_payload_t payload;
+
+    memset(&payload, 0, offsetof(nrf_esb_payload_t, data));
+    payload.length = Len;
+    payload.noack = false;
+    memcpy(payload.data, pFrame, Len);
+
+    if (nrf_esb_write_payload(&payload) != NRF_SUCCESS)
+    {
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief - EsbLink message receive callback
+ */
+static void EsbIntrfLinkRecv(void *pCtx, const uint8_t *pData, int Len)
+{
+    ESBINTRF *intrf = (ESBINTRF*)pCtx;
+    nrf_esb_payload_t *payload = (nrf_esb_payload_t*)CFifoPut(intrf->hRxFifo);
+
+    if (payload)
+    {
+        payload->length = Len;
+        memcpy(payload->data, pData, Len);
+    }
+}
 
 /**
  * @brief - Disable
@@ -263,13 +344,35 @@ int EsbIntrfTxData(DEVINTRF *pDevIntrf, uint8_t *pData, int DataLen)
     nrf_esb_payload_t *payload;
     int cnt = 0;
 
+    if (intrf->bReliable)
+    {
+        int maxlen = EsbLinkMsgMax(&intrf->Link);
+        uint32_t state = DisableInterrupt();
+
+        while (DataLen > 0)
+        {
+            int l = min(DataLen, maxlen);
+
+            if (EsbLinkWrite(&intrf->Link, pData, l, intrf->EvtCnt) == false)
+                break;
+
+            DataLen -= l;
+            pData += l;
+            cnt += l;
+        }
+
+        EnableInterrupt(state);
+
+        return cnt;
+    }
+
     while (DataLen > 0)
     {
         payload = (nrf_esb_payload_t *)CFifoPut(intrf->hTxFifo);
         if (payload == NULL)
             break;
-        int l = min(DataLen, NRF_ESB_MAX_PAYLOAD_LENGTH);
-        memset(payload, 0, sizeof(nrf_esb_payload_t));
+        int l = min(DataLen, intrf->PacketSize);
+        memset(payload, 0, offsetof(nrf_esb_payload_t, data));
         memcpy(payload->data, pData, l);
         payload->length = l;
         payload->noack = false;
@@ -279,19 +382,11 @@ int EsbIntrfTxData(DEVINTRF *pDevIntrf, uint8_t *pData, int DataLen)
         cnt += l;
     }
 
-    if (s_bEsbTxReady == true)
-    {
-        payload = (nrf_esb_payload_t *)CFifoGet(intrf->hTxFifo);
-        if (payload != NULL)
-        {
-            s_bEsbTxReady = false;
-            uint32_t res = nrf_esb_write_payload(payload);
-            if (res != NRF_ERROR_NO_MEM)
-            {
-                s_bEsbTxReady = true;
-            }
-        }
-    }
+    uint32_t state = DisableInterrupt();
+
+    EsbIntrfTxFill(intrf);
+
+    EnableInterrupt(state);
 
     return cnt;
 }
@@ -337,21 +432,41 @@ void nRFEsbEventHandler(nrf_esb_evt_t const * p_event)
     ESBINTRF *esbintrf = (ESBINTRF *)devintrf->pDevData;
     uint32_t err;
 
+    // Each radio packet completion must get its own event, the event irq
+    // priority must allow the handler to keep up with the radio
+    esbintrf->EvtCnt++;
+
     switch (p_event->evt_id)
     {
         case NRF_ESB_EVENT_TX_FAILED:
-            nrf_esb_flush_tx();
+            // Only drop the failed packet, keep the rest of the pipeline
+            nrf_esb_pop_tx();
+            if (esbintrf->bReliable)
+            {
+                EsbLinkTxDone(&esbintrf->Link, false, esbintrf->EvtCnt);
+            }
+            else
+            {
+                EsbIntrfTxFill(esbintrf);
+            }
             nrf_esb_start_tx();
             break;
         case NRF_ESB_EVENT_TX_SUCCESS:
-            payload = (nrf_esb_payload_t*)CFifoGet(esbintrf->hTxFifo);
-            if (payload)
+            if (esbintrf->bReliable)
             {
-                nrf_esb_write_payload(payload);
+                if (esbintrf->EsbCfg.mode == NRF_ESB_MODE_PRX)
+                {
+                    // Rx event of the same packets follows
+                    esbintrf->bAckSent = true;
+                }
+                else
+                {
+                    EsbIntrfLinkTxDone(esbintrf, nrf_esb_is_idle() ? esbintrf->Link.RadioQue : 1);
+                }
             }
             else
             {
-                s_bEsbTxReady = true;
+                EsbIntrfTxFill(esbintrf);
             }
             if (esbintrf->DevIntrf.EvtCB)
             {
@@ -360,36 +475,51 @@ void nRFEsbEventHandler(nrf_esb_evt_t const * p_event)
             break;
 
         case NRF_ESB_EVENT_RX_RECEIVED:
-#if 1
-       		nrf_esb_payload_t pl;
-   			while (nrf_esb_read_rx_payload(&pl) == NRF_SUCCESS);
-
-			payload = (nrf_esb_payload_t*)CFifoPut(esbintrf->hRxFifo);
-			if (payload)
-			{
-				memcpy(payload, &pl, sizeof(nrf_esb_payload_t));
-			}
-#else
-        	do {
+        {
+        	int rxcnt = 0;
+
+        	// Radio may have received several packets, keep them all
+        	while (true)
+        	{
         		nrf_esb_payload_t pl;
-    			err = nrf_esb_read_rx_payload(&pl);
+
+        		err = nrf_esb_read_rx_payload(&pl);
         		if (err != NRF_SUCCESS)
         		{
         			break;
         		}
+        		rxcnt++;
+
+        		if (esbintrf->bReliable)
+        		{
+        			// Messages go to Rx FIFO through EsbIntrfLinkRecv
+        			EsbLinkRecv(&esbintrf->Link, pl.data, pl.length, esbintrf->EvtCnt);
+        			continue;
+        		}
 
 				payload = (nrf_esb_payload_t*)CFifoPut(esbintrf->hRxFifo);
 				if (payload)
 				{
-					memcpy(payload, &pl, sizeof(nrf_esb_payload_t));
+					memcpy(payload, &pl, offsetof(nrf_esb_payload_t, data) + min((int)pl.length, NRF_ESB_MAX_PAYLOAD_LENGTH));
 				}
-        	} while (err == NRF_SUCCESS);
-#endif
+        	}
+        	if (esbintrf->bReliable)
+        	{
+        		if (esbintrf->bAckSent)
+        		{
+        			// At most one ACK payload went out per packet received
+        			esbintrf->bAckSent = false;
+        			EsbIntrfLinkTxDone(esbintrf, max(rxcnt, 1));
+        		}
+        		// Acknowledge, poll & timed out retransmissions
+        		EsbLinkProcess(&esbintrf->Link, esbintrf->EvtCnt);
+        	}
             if (esbintrf->DevIntrf.EvtCB)
             {
                 esbintrf->DevIntrf.EvtCB(&esbintrf->DevIntrf, DEVINTRF_EVT_RX_DATA, NULL, CFifoUsed(esbintrf->hRxFifo));
             }
             break;
+        }
     }
 }
 
@@ -402,19 +532,62 @@ bool EsbIntrfInit(ESBINTRF *pEsbIntrf, const ESBINTRF_CFG *pCfg)
     bool retval = false;
     nrf_esb_config_t esbcfg = NRF_ESB_DEFAULT_CONFIG;
 
-    if (pCfg->PacketSize <= 0 || pCfg->pRxFifoMem == NULL || pCfg->pTxFifoMem == NULL)
+    if (pCfg->PacketSize <= 0 || pCfg->PacketSize > NRF_ESB_MAX_PAYLOAD_LENGTH)
+    {
+        pEsbIntrf->PacketSize = NRF_ESB_MAX_PAYLOAD_LENGTH;
+    }
+    else
+    {
+        pEsbIntrf->PacketSize = pCfg->PacketSize;
+    }
+    esbcfg.payload_length = pEsbIntrf->PacketSize;
+
+    // Caller FIFO memory is used whenever provided, size it with ESBINTRF_CFIFO_MEMSIZE
+    if (pCfg->pRxFifoMem == NULL || pCfg->RxFifoMemSize <= 0)
     {
-        esbcfg.payload_length = NRF_ESB_MAX_PAYLOAD_LENGTH;
         pEsbIntrf->hRxFifo = CFifoInit(s_EsbRxFifoMem, sizeof(s_EsbRxFifoMem), sizeof(nrf_esb_payload_t), true);
-        pEsbIntrf->hTxFifo = CFifoInit(s_EsbTxFifoMem, sizeof(s_EsbTxFifoMem), sizeof(nrf_esb_payload_t), true);
     }
     else
     {
-        esbcfg.payload_length = pCfg->PacketSize;
         pEsbIntrf->hRxFifo = CFifoInit(pCfg->pRxFifoMem, pCfg->RxFifoMemSize, sizeof(nrf_esb_payload_t), true);
+    }
+
+    if (pCfg->pTxFifoMem == NULL || pCfg->TxFifoMemSize <= 0)
+    {
+        pEsbIntrf->hTxFifo = CFifoInit(s_EsbTxFifoMem, sizeof(s_EsbTxFifoMem), sizeof(nrf_esb_payload_t), true);
+    }
+    else
+    {
         pEsbIntrf->hTxFifo = CFifoInit(pCfg->pTxFifoMem, pCfg->TxFifoMemSize, sizeof(nrf_esb_payload_t), true);
     }
 
+    if (pEsbIntrf->hRxFifo == NULL || pEsbIntrf->hTxFifo == NULL)
+    {
+        return false;
+    }
+
+    pEsbIntrf->bAckSent = false;
+    pEsbIntrf->EvtCnt = 0;
+    pEsbIntrf->bReliable = pCfg->bReliable;
+
+    if (pCfg->bReliable)
+    {
+        // PTX only hears PRX when it transmits, it polls. PRX headers ride in
+        // ACK payloads, keep few queued so that the ACK info stays fresh.
+        ESBLINK_CFG linkcfg = {
+            pCfg->pLinkMem, (uint32_t)pCfg->LinkMemSize, pCfg->LinkWindow, pEsbIntrf->PacketSize,
+            pCfg->Mode == NRF_ESB_MODE_PTX ? NRF_ESB_TX_FIFO_SIZE : ESBINTRF_LINK_PRX_QUE,
+            pCfg->LinkRto > 0 ? pCfg->LinkRto : ESBINTRF_LINK_RTO_DEFAULT,
+            pCfg->bLinkPack, pCfg->Mode == NRF_ESB_MODE_PTX,
+            EsbIntrfLinkSend, EsbIntrfLinkRecv, pEsbIntrf
+        };
+
+        if (EsbLinkInit(&pEsbIntrf->Link, &linkcfg) == false)
+        {
+            return false;
+        }
+    }
+
 #if !(defined(NRF52840_XXAA) || defined(NRF52810_XXAA))
     if (pCfg->Rate < 1000000)
     {
@@ -435,7 +608,6 @@ bool EsbIntrfInit(ESBINTRF *pEsbIntrf, const ESBINTRF_CFG *pCfg)
     esbcfg.protocol = pCfg->Protocol;
     esbcfg.mode = pCfg->Mode;
     esbcfg.tx_output_power = pCfg->TxPower;
-    esbcfg.payload_length = pCfg->PacketSize;
     esbcfg.retransmit_count = pCfg->NbRetry;
     esbcfg.event_handler = nRFEsbEventHandler;
     esbcfg.selective_auto_ack = true;
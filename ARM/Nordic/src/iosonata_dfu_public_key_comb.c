@@ -0,0 +1,295 @@
+/**-------------------------------------------------------------------------
+@file	iosonata_dfu_public_key_comb.c
+
+@brief	ECDSA P-256 public key comb table for EcdsaP256VerifyComb.
+
+Public key X|Y little endian :
+f787a1e859a0adfb62c7363d53e207ea1c702565da2284e8cfbca5d1c2cce561
+67ee80ed03ee325e057f7298ad1501337bbdc7a4d84e9bf136544c30d517090c
+
+Generated by Linux/exemples/EcdsaCombGen, do not edit.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include "ecdsa_p256.h"
+
+const ECDSAP256_COMB g_DfuPublicKeyComb = { {
+	{
+		{ 0xe8a187f7, 0xfbada059, 0x3d36c762, 0xea07e253, 0x6525701c, 0xe88422da, 0xd1a5bccf, 0x61e5ccc2 },
+		{ 0xed80ee67, 0x5e32ee03, 0x98727f05, 0x330115ad, 0xa4c7bd7b, 0xf19b4ed8, 0x304c5436, 0x0c0917d5 }
+	},
+	{
+		{ 0x04ca6dfe, 0x87231f35, 0xc626883c, 0x419a21fe, 0x431e75c3, 0xaf293192, 0x9252e15d, 0x8d1d79e9 },
+		{ 0xaf4c6b98, 0x393f21b7, 0x151ae5dc, 0x03a693cc, 0x4fe6825f, 0x098813fa, 0x23fd268d, 0xe807d410 }
+	},
+	{
+		{ 0x7fd89b8a, 0x3e4bd3e6, 0x10ae7299, 0xdcddd2b5, 0x27163570, 0x39be2831, 0xc7eeb541, 0x95a15faf },
+		{ 0xc0e61e37, 0xaa2b3b8d, 0x43915618, 0xa1b9d46d, 0x5cf798ab, 0xf96fda95, 0xc846a4ca, 0x3745d6a2 }
+	},
+	{
+		{ 0x944d942a, 0xd61cf869, 0xbd4f62ac, 0x265c33a2, 0x71ed7534, 0xfae681c7, 0x0b63ef95, 0x5060279b },
+		{ 0x63ae6e71, 0x84369c48, 0x2ab44f1e, 0x8f07adb5, 0x78bf9585, 0xabd90d67, 0x90b882f4, 0x28de1ca6 }
+	},
+	{
+		{ 0xc2feef01, 0xa3c0f052, 0x79805371, 0xcef6ca75, 0xf13f5cdf, 0xb579f494, 0x9c74d74f, 0x3e04c8aa },
+		{ 0xaf8d3a4f, 0x40f4b5fb, 0x0206f5e9, 0xff87dd69, 0x37a4647b, 0xeb7d3b4b, 0xccc3aef7, 0x2786d670 }
+	},
+	{
+		{ 0x68d25d50, 0x81528560, 0x628227e8, 0x7a4b408e, 0x4918df55, 0xb3241916, 0x84a3c7cb, 0xd948feac },
+		{ 0x907bb221, 0xa19ea548, 0x59e3cbbf, 0xe8025ccf, 0xaaed5311, 0x658746c2, 0xd2c3b9c7, 0x12d4ec52 }
+	},
+	{
+		{ 0x9fd02492, 0x87309ec6, 0x50a7343f, 0xc40bbc9f, 0x732bd1bd, 0x59957f43, 0x24a91134, 0x31687f9f },
+		{ 0x41274f99, 0xc6184bef, 0xf9488acb, 0x241490c2, 0xbe07bd62, 0x0362f107, 0xfc88cfb7, 0xac4af3f6 }
+	},
+	{
+		{ 0xbce2e243, 0x70d957f0, 0xef95490e, 0x9174d895, 0x1772db15, 0x115db6d9, 0xc376968a, 0xe8aa53a8 },
+		{ 0x62e5ad3c, 0x8044d8d1, 0xe94b81b8, 0x367d222f, 0xaee0ea44, 0x88a0aeeb, 0xc7fdc2f4, 0x60da41a6 }
+	},
+	{
+		{ 0xc70b9f0e, 0xab307feb, 0xc401cc09, 0xee7ec992, 0x422025bc, 0x6ab59d35, 0x400298b6, 0x9367add1 },
+		{ 0x4123a2dc, 0x970e0c2f, 0x77a277b0, 0xd7904ef4, 0x66f2338e, 0x95a5a4de, 0x01329a69, 0x3cf1c37e }
+	},
+	{
+		{ 0x02e6d8dc, 0x26c6c24c, 0xf3f88cb2, 0x57c519f5, 0xeb5287b1, 0x72e1eab2, 0xa0acd483, 0x742e2bf9 },
+		{ 0x7caa6927, 0xab4e7e37, 0x5e2b353b, 0x380117ac, 0xcc560c6a, 0x2498a5a3, 0x83373f7d, 0x5e4e8479 }
+	},
+	{
+		{ 0xa1d574b7, 0x81620223, 0x3ebe4c1d, 0x031c5569, 0x8bd5f89d, 0x605b1d26, 0xb53607e9, 0xa054c5ba },
+		{ 0x4fb0d7b6, 0xdd7cf2c6, 0xed92e5e6, 0x73c0b5b7, 0x49a49877, 0x4fba590f, 0x9c6b2e86, 0xb1164356 }
+	},
+	{
+		{ 0x0734a3ea, 0x15873ec2, 0x49858e26, 0xb735e8a1, 0x1d4d4d01, 0xfaa179fc, 0x3a9aa230, 0xa4c23ca2 },
+		{ 0xe629bb78, 0x41bb2eda, 0xebac7dc7, 0x86fd4751, 0xb6827a6d, 0x6b90aa7d, 0xdc4ce51b, 0xf3fa68f4 }
+	},
+	{
+		{ 0x752d979a, 0x702931a5, 0xebe06763, 0x25dfc65d, 0xaeedcdb8, 0x315dee32, 0x7d18f982, 0x25cdf7ef },
+		{ 0x9852fc67, 0x0c66ecfa, 0xdc8174f5, 0xec10c595, 0xe15c209b, 0x4e3016cc, 0x27f6cac1, 0x01f57b7e }
+	},
+	{
+		{ 0x5b1063b4, 0x438d9f2c, 0xd34c9e80, 0x09480dc6, 0x64eec9bf, 0x9528dc39, 0xecfec4a3, 0x994f8354 },
+		{ 0xebc947b5, 0xcbddaab0, 0x467bdba2, 0xc1959686, 0xab1cbd16, 0x926c1207, 0x00abe462, 0x3e4072f8 }
+	},
+	{
+		{ 0xffdd07c5, 0x4ed00326, 0x67a3b96c, 0xae68e986, 0x074e770d, 0xb2d7a606, 0x15e2c48e, 0x5c1f10b0 },
+		{ 0x8e171736, 0x3d8aa678, 0x8e652a57, 0xccacd080, 0x92e6f143, 0x21cf92b6, 0xc9b33151, 0xd6412561 }
+	},
+	{
+		{ 0x613ce40c, 0xc0cd599f, 0x4825dd8c, 0x7aaaa8b5, 0x7c6573fe, 0x3ab987a3, 0xa46889db, 0xbf03dd20 },
+		{ 0x82820ef7, 0x776333f7, 0x456bf03c, 0x6ff5b5cc, 0x5c09bbcd, 0xb1ae21aa, 0xc05c30cc, 0x3761f34e }
+	},
+	{
+		{ 0x3943501e, 0xbc443e53, 0xd7599247, 0xa69c7100, 0xd78f4dc7, 0x19f64207, 0x10ae17d6, 0x5f1511d2 },
+		{ 0x1beffbd5, 0xe784a3f1, 0x40730c35, 0xa799a30f, 0x7c25e8e2, 0x381eed6f, 0x5b704a96, 0x645c462e }
+	},
+	{
+		{ 0xa9d78913, 0xee6b8d36, 0xbb7f5f9a, 0x7b060fbe, 0x283e7e7d, 0x0c1c12e3, 0xe5986d50, 0x0aafe59a },
+		{ 0xb97f57b8, 0x1390ee2c, 0x42a646bc, 0x30700b33, 0xe054507f, 0x0338c0cc, 0x9bf92534, 0x03b30c49 }
+	},
+	{
+		{ 0x02f7c948, 0x3f60e73e, 0xa1804ccc, 0xa4703124, 0x815a3339, 0x0a588933, 0x5851fe72, 0xa0979c27 },
+		{ 0x5adc72a0, 0x6f7f09fb, 0x9b8a1a8d, 0x74d33305, 0x70297aab, 0xa9156553, 0x220e951f, 0x7ed11e0c }
+	},
+	{
+		{ 0xfb8b00b0, 0x95232dee, 0x08840758, 0x242b52c9, 0x83e0bb9f, 0x640de6a1, 0x0ca2a5a0, 0xf510bc8e },
+		{ 0xac858080, 0xe2993c61, 0x8abe1677, 0x9573f880, 0x26a028d6, 0x8e67c76d, 0xb198c9bc, 0x4674b0c3 }
+	},
+	{
+		{ 0xa8a4433c, 0x67a2f508, 0x8096cb25, 0x440d9854, 0x8acddd1a, 0x92f6d525, 0xb20942ad, 0xf85d70bb },
+		{ 0x8b65d5b9, 0x01401cb2, 0x48f37e7d, 0xb907276e, 0xaa9a7294, 0xf1f45651, 0x09e86c5a, 0xbf228156 }
+	},
+	{
+		{ 0x19d052e3, 0xdb13da68, 0xacba6f8f, 0x2df24f31, 0x548ce6e6, 0xf9c49d56, 0x40789ec2, 0x98e99c8c },
+		{ 0x3bc97467, 0xa2814fe3, 0xee980503, 0x58ba1a54, 0xd6771a47, 0x79d4f775, 0x7140ff3b, 0x6b0e3796 }
+	},
+	{
+		{ 0x5350fad6, 0x0253f98c, 0x2d7e00a1, 0xecf5d47a, 0xb4a4ecc3, 0x069a974d, 0x61571377, 0x7ed8347c },
+		{ 0x4ba72962, 0xdf1840ad, 0x712e9385, 0xe93ea866, 0xbfb9d7fb, 0x25958f47, 0x54d0e23d, 0xad1565d9 }
+	},
+	{
+		{ 0xe7f8bb5f, 0x88cbb467, 0x397514b4, 0x28c455d5, 0xe46c0dc1, 0x89db6cb0, 0x70981fee, 0xb3787704 },
+		{ 0x20529e57, 0x46b9f5c4, 0xec88a2c2, 0xcc0dec5c, 0xe7c330b5, 0x65110861, 0x8b09ef1d, 0x361aa251 }
+	},
+	{
+		{ 0x55a3c273, 0x2bb3f64b, 0x45bf75bd, 0xcb90557b, 0xc64556a1, 0xde445c5f, 0xc445b79b, 0xd9bc7765 },
+		{ 0x037cafd6, 0x5595f6d1, 0xc3cf4cc6, 0x22370aa5, 0xe0a7ce82, 0xb3c8dd48, 0x84e52485, 0x10c91551 }
+	},
+	{
+		{ 0xbb3099fa, 0xefaa9cfd, 0x27400fe3, 0xe8386359, 0xfa10be65, 0xa0b7c6ad, 0x9570b936, 0xcaab7520 },
+		{ 0xb16bae22, 0xbefc3ce7, 0xd3c32ce9, 0x47476d68, 0x59c68253, 0x769b055b, 0xd703ce1b, 0xb9fbf53c }
+	},
+	{
+		{ 0xa14a5e0a, 0x361b8b76, 0x9a9cbdec, 0x5fdeb4fc, 0xad9ecf0a, 0x261f47b7, 0xb1cc5d39, 0x0633ee21 },
+		{ 0xd4396067, 0x2e759f62, 0xa85a1d0f, 0xd1665351, 0x06bd9f14, 0x8d6ddd89, 0x75ca32cd, 0x38f7d0a8 }
+	},
+	{
+		{ 0x6697a6d8, 0x9efcc499, 0xa22c7dce, 0x37aa6474, 0x6e3b0a0e, 0x9d788920, 0x217ba3a2, 0xea98bd3b },
+		{ 0x5f224ab9, 0x79e23e8b, 0x02332319, 0xa65ddff8, 0xe77e2bc6, 0x49b40034, 0x98b0ddf6, 0x7549d598 }
+	},
+	{
+		{ 0x129fd9e8, 0xf476c2b6, 0x952b1ace, 0xa2a5faa7, 0x0b79d637, 0xb9c66bc8, 0x2bcfecd9, 0x9289f55b },
+		{ 0x7224894e, 0x823b2a20, 0x1a94c9cb, 0xf4be8170, 0x7a6109b1, 0x0385dd65, 0x6dae957f, 0xb8b14804 }
+	},
+	{
+		{ 0x8597c007, 0xdf396de2, 0xe4dbb6e0, 0x9d34b05b, 0xa9efba58, 0x7186b306, 0xe74f0ffc, 0x414c857a },
+		{ 0x806f6abc, 0x37a4e6a6, 0x043ec7f8, 0x1cc07c31, 0x361d9c60, 0x629f34b2, 0xb3bc8c1c, 0x14113a7c }
+	},
+	{
+		{ 0xfd0b5c2a, 0x0286a5cf, 0x11c24e61, 0x0b98e14e, 0xa3e49f3e, 0xaa2087c8, 0x3633aa0a, 0x4cb65d16 },
+		{ 0x0602e6d2, 0xbcf4c9d5, 0xc11210f2, 0x1277e67b, 0xdad5add1, 0x603b26a8, 0x8fc5c66d, 0x744ea3fa }
+	},
+	{
+		{ 0xbd157f33, 0x9b13cc0b, 0x3b991505, 0x2320a501, 0xdbb682ce, 0xf2a5f9e2, 0x48ac202c, 0x199895a6 },
+		{ 0x6c3dfa22, 0xa230f6fb, 0x3b3b1746, 0xfee12d8c, 0x54f44276, 0x4def8638, 0x09c5f9bf, 0x7efff392 }
+	},
+	{
+		{ 0x358b0287, 0x517348a7, 0xf3fbaaa3, 0x42f3fe39, 0x4696974b, 0x320c402f, 0x39dd6e4c, 0x9790304e },
+		{ 0x4464512d, 0x1d2d8592, 0xb4a84fb4, 0x8faee332, 0xe8787454, 0x36e78b91, 0x4ffc27c7, 0x03b682fe }
+	},
+	{
+		{ 0x5b23cd93, 0x267b16e7, 0x8092f295, 0xdef54473, 0x65f2f5dd, 0x56922623, 0xd5150578, 0x9a486392 },
+		{ 0x40179075, 0x8f4d2e22, 0x36cb2497, 0x5ed301d8, 0x51c9ca53, 0xf95dfe22, 0xd6d2e34a, 0x9feeb2e9 }
+	},
+	{
+		{ 0x10eb824a, 0x80c2a11a, 0x12c36f7d, 0x656bf358, 0xd55b6144, 0x7793e34b, 0xd53045bb, 0x93c4cc0f },
+		{ 0xc6ab4aee, 0x94f00bc1, 0xa182cfb5, 0xa65c4083, 0xb4bb579b, 0x86ae93f3, 0xa6b2a566, 0xd0a01f8a }
+	},
+	{
+		{ 0x4c30196e, 0x905a2542, 0xba51f551, 0x9f7dedb1, 0x92734ae1, 0xa476ab67, 0x0372c9e7, 0x3a499de0 },
+		{ 0xf9309b7a, 0xab2f91d8, 0x7158c2a1, 0xef131059, 0xc827493c, 0xdab5a230, 0x98e0a4e0, 0xfcbc36c7 }
+	},
+	{
+		{ 0xe4a07ebe, 0xcb98df30, 0x1b8ed28d, 0x52d5ad4a, 0x751c6e1c, 0xba953416, 0xeabaafe9, 0x0de564e4 },
+		{ 0x97362583, 0x250b1e38, 0x33e90cdc, 0x0d0bb751, 0x4de26306, 0xb06a9929, 0xea0fd53b, 0xbb377964 }
+	},
+	{
+		{ 0x28af338a, 0xac197cee, 0x5d35027f, 0x6b0302cd, 0x53f4a2a9, 0x9d942437, 0x54586c64, 0x732426d1 },
+		{ 0x7a4ad070, 0xa5241df3, 0x8e33c5f8, 0x1e3edf01, 0x0f472adf, 0x34a4bec6, 0xfff93f53, 0xaecc017c }
+	},
+	{
+		{ 0x4fae8505, 0x6bdea80b, 0x86ddd51b, 0xab8b3dbb, 0xa2557562, 0x0c57f9bc, 0xde77f05b, 0xf818b7e4 },
+		{ 0xe8b1f665, 0x3e3f6670, 0xf7bcb74c, 0xf7d435e1, 0xe2b49683, 0x6fc03bc9, 0xd3ac5a8d, 0x2697fbd7 }
+	},
+	{
+		{ 0xd8b18a03, 0x244e9171, 0xd5036a88, 0x2b8faf55, 0x6bb17300, 0x8d369458, 0x50bb7c9a, 0x4d331607 },
+		{ 0x283be45f, 0x3380c3cb, 0x4c5e3120, 0x5cddb2c3, 0x92246010, 0x45d76e16, 0xf9b594dc, 0x7bb7dfc1 }
+	},
+	{
+		{ 0x98495237, 0xb152216e, 0x84a79007, 0x6ee570d2, 0xa13101ca, 0x3d8c4100, 0x4bcef02c, 0x29266256 },
+		{ 0x61508207, 0xe3945084, 0xd65fe476, 0xd31637d2, 0x49fe9266, 0x9c071745, 0x8e49bbe4, 0xf397eb31 }
+	},
+	{
+		{ 0x4301653a, 0x07b3d9e6, 0xd17a6f9b, 0x90274638, 0x243208a5, 0x40e6eabf, 0xa64cb635, 0xcbb68ef6 },
+		{ 0xe7320a5a, 0xc8805f2f, 0x6a3b0db6, 0x2d7c078d, 0xbe777878, 0x5e92bd2b, 0xf5a914f4, 0x30761bf4 }
+	},
+	{
+		{ 0xa96b84af, 0xaae56dfd, 0x388b5f0a, 0x4a38877e, 0xeb282bf6, 0x60559689, 0xc6ecca00, 0x8bc15a58 },
+		{ 0x6abd149a, 0x000f8066, 0x885c2789, 0x92a30124, 0x27fae85d, 0xa0534ef6, 0x6b3d43b5, 0x56db335b }
+	},
+	{
+		{ 0xaf1045ce, 0x7d5867fe, 0xc63982a9, 0x7b6b1c39, 0x90279cc3, 0x5195870a, 0x4780c322, 0x5b9a9c5d },
+		{ 0x17803087, 0xbfa4123a, 0x165237a6, 0xc849b59e, 0x1c27c188, 0x99e15de6, 0xdbf5c02f, 0x570e4274 }
+	},
+	{
+		{ 0x4258ae89, 0x32a18a2d, 0x55099bc1, 0x839881b8, 0xb1dd498c, 0x822f2cfa, 0xa4659c0c, 0x27816730 },
+		{ 0xb3abb0e1, 0x7114d468, 0xa06c5477, 0x60967b24, 0xd7c542a2, 0xa625098a, 0x697cb3bb, 0x0877f83d }
+	},
+	{
+		{ 0x364267d5, 0x151999ee, 0x91f5e44a, 0xe8d43e71, 0x0db478ef, 0x8ded0e34, 0x11d102bd, 0x8943f65b },
+		{ 0x841896da, 0x7b33c516, 0xa7e988f8, 0x1a62fceb, 0xd38616d3, 0x7f3d264a, 0x7aa2326d, 0x80069bfc }
+	},
+	{
+		{ 0x0c9dab34, 0xdbe4c178, 0x1a2ac963, 0xbf45fe1d, 0x8b75f33d, 0x28da0d2f, 0xe4b6d91b, 0xccd43a72 },
+		{ 0xce639b7a, 0x96847fe5, 0x1a6d1692, 0x8cb199aa, 0xee27d4bf, 0xc05637ff, 0x154efd0f, 0x8c6b30dd }
+	},
+	{
+		{ 0xfc7a7899, 0x10795966, 0x8aae29f8, 0x3c956a44, 0x4b288d21, 0x895dd9fe, 0x644df1b6, 0xf777ffb5 },
+		{ 0x3a9a700e, 0xd8968d8a, 0x711b3a4a, 0xaa437fb3, 0x480b6ecb, 0xd78193ec, 0xf55dff1f, 0x769aa548 }
+	},
+	{
+		{ 0x32f7d6f3, 0xb93fbe9a, 0x70deace7, 0x4432d846, 0x8d1acaba, 0x713bfee7, 0x22d54348, 0xec553bef },
+		{ 0x15258a0e, 0x5cc466db, 0x5503615c, 0xa1d670ca, 0xf289ad26, 0x66cfe5c1, 0x41772932, 0xff9e5282 }
+	},
+	{
+		{ 0x216ebed8, 0x641ac885, 0x908b4a38, 0xb39b07ff, 0x1eabd448, 0xe0ad9227, 0xcf4e4b6c, 0x1c898c78 },
+		{ 0x19f68f78, 0x0c2ec9aa, 0x7f069698, 0x5bc646df, 0x700044ff, 0x7148b279, 0xf554b995, 0x7e9df448 }
+	},
+	{
+		{ 0x1395c916, 0x6796ff54, 0x273043a9, 0x75e06b42, 0x036499d5, 0x20c3ffce, 0x9baa3aee, 0xfe1ce745 },
+		{ 0xef13c1e5, 0x0e873011, 0xb9c25022, 0xe0612c45, 0x05f92be8, 0xa2b4e9af, 0x75f9b629, 0x718d5a57 }
+	},
+	{
+		{ 0x5ab3aa69, 0x78b91250, 0x0d23f074, 0x27bf5504, 0x05b8f0cd, 0x719c39e3, 0x5a64a0f3, 0x3259193c },
+		{ 0x23b0d7ac, 0x66fad832, 0x25b2ddbf, 0x211aff85, 0xa214fc13, 0xdb4309b6, 0x2560668e, 0x18e107f5 }
+	},
+	{
+		{ 0xa108153f, 0x3e55cfe3, 0x631f4913, 0x96b3da16, 0x4979d5a0, 0xaff9bee9, 0x7ab0843d, 0x07f51779 },
+		{ 0x13f05479, 0x67de273e, 0x6767218f, 0x3bf7e82b, 0xe667b1dc, 0xb44bfd4b, 0x0e961d70, 0x22dd6c16 }
+	},
+	{
+		{ 0xb61826db, 0x362d8394, 0x2ca8862a, 0x6cb95279, 0xe50a9f2c, 0xc8180263, 0x42894b40, 0xc20b402b },
+		{ 0x29e84ced, 0xb68d0024, 0x31b87886, 0x418923c5, 0xcc57600b, 0xcea79993, 0xb6fd6f6b, 0x4236e2bb }
+	},
+	{
+		{ 0x81c28c90, 0x6248db00, 0xd44f931f, 0x3ab23249, 0x57cf5f82, 0xb014f766, 0x5dd458d2, 0x0ecf5fa3 },
+		{ 0xf26193aa, 0x2beda0cf, 0xe0cda615, 0x6f9a35c3, 0x43655c9d, 0x4db604a8, 0x023f51b8, 0x19c1b4e3 }
+	},
+	{
+		{ 0xd1a14f25, 0x1a7d4362, 0xf86e199e, 0x36de3cf0, 0xa5296320, 0x3e3a23aa, 0xa69bf342, 0x0f0a58e6 },
+		{ 0xc6d4e472, 0xb0d554f6, 0xbcf475dd, 0x784f379a, 0x6eefea59, 0x09e57329, 0x60181fd5, 0xf4426dcc }
+	},
+	{
+		{ 0x1ef78b18, 0x4bbdabc4, 0x66f212b0, 0x67598143, 0xa679fd7c, 0x805dc503, 0xf4ba776b, 0xed2aed98 },
+		{ 0x83fc9f87, 0x5f2c3914, 0x6ff5f63d, 0xb14e7798, 0xb88dad03, 0x31fd6217, 0x70bb3882, 0xf88e86ec }
+	},
+	{
+		{ 0x0682f34a, 0x5b86ecb6, 0x2445e5f8, 0x1015ceb9, 0xdc10a5f2, 0xecd4f8df, 0x6e9ee8bf, 0xba683fd0 },
+		{ 0x91d4cb76, 0xee12e5a8, 0x56464f96, 0xc98735b2, 0x115ef2a1, 0x8262a7ce, 0x8efaef45, 0xca2c0f31 }
+	},
+	{
+		{ 0x7571525d, 0x3534144f, 0x631b91e3, 0x53e5288a, 0x7a63c33e, 0x63adccf5, 0x2c401476, 0xa9de472a },
+		{ 0x0800a413, 0x93617842, 0xc9d7103a, 0x30710ad3, 0xc6754892, 0xa947d1f8, 0x99de5df9, 0x9d5f2dcc }
+	},
+	{
+		{ 0xc0b05632, 0x2ea00f7b, 0x06936be4, 0x5f74fa9c, 0x23110cbc, 0x043670b9, 0x68630a64, 0x1512a9a7 },
+		{ 0x977f312b, 0xbb2ec0be, 0x9b3b9161, 0x8711da6d, 0xe82a7c95, 0x83865f82, 0x9e2f7147, 0x1e1eb9a9 }
+	},
+	{
+		{ 0x2e0d4bf5, 0x453f8332, 0x242c8886, 0xd1e335db, 0x1fd0a396, 0x0c1c50a6, 0xb97b1e3c, 0xbcf4368d },
+		{ 0x2129cfc1, 0x403531f4, 0x9fb2dfe6, 0xd9faa274, 0x65d1c8ab, 0x8f714b0f, 0xa52ac172, 0xab57e69b }
+	},
+	{
+		{ 0xf2dbf913, 0x92e41fff, 0x16ed2b45, 0xee84d504, 0xcd2046da, 0xbc430b02, 0xaf22d221, 0x1b262bc7 },
+		{ 0xe64be24b, 0xece38862, 0x8fd4fe55, 0x7003d751, 0x4060e882, 0x386b15ec, 0x68d6b7b6, 0x2f997b5a }
+	},
+	{
+		{ 0x396634b5, 0xe8646ae4, 0x7dfadebf, 0x9d27cf86, 0x33819844, 0xf5d1d4ce, 0x5bdccc3c, 0x453d7859 },
+		{ 0x524187e3, 0xdc325d16, 0x40186bc8, 0x64d70edf, 0x3c86a426, 0xb400abd9, 0x7f241150, 0x4be8b058 }
+	},
+} };
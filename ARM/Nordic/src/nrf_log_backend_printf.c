@@ -20,6 +20,7 @@
 #include <stdbool.h>
 
 #include "coredev/uart.h"
+#include "nrf_log_backend_printf.h"
 
 #define HEXDUMP_BYTES_PER_LINE               16
 #define HEXDUMP_HEXBYTE_AREA                 3 // Two bytes for hexbyte and space to separate
@@ -37,6 +38,22 @@ static const char m_default_color[] = "\x1B[0m";
 
 static volatile bool m_rx_done = false;
 
+static DLOG *s_pDLog = NULL;
+
+// Hexdump line, [words - 1][bytes in last word - 1], bytes in display order
+static const char s_DLogHexFmt[4][4][28] __attribute__((section("dlog_fmt"), used)) = {
+    { "%02X\r\n", "%04X\r\n", "%06X\r\n", "%08X\r\n" },
+    { "%08X %02X\r\n", "%08X %04X\r\n", "%08X %06X\r\n", "%08X %08X\r\n" },
+    { "%08X %08X %02X\r\n", "%08X %08X %04X\r\n", "%08X %08X %06X\r\n", "%08X %08X %08X\r\n" },
+    { "%08X %08X %08X %02X\r\n", "%08X %08X %08X %04X\r\n", "%08X %08X %08X %06X\r\n",
+      "%08X %08X %08X %08X\r\n" },
+};
+
+void nrf_log_backend_printf_dlog(DLOG * const pLog)
+{
+    s_pDLog = pLog;
+}
+
 uint32_t nrf_log_backend_init(bool blocking)
 {
 
@@ -100,6 +117,21 @@ static bool nrf_log_backend_stdio_std_handler(
     uint32_t buffer_len      = 0;
     bool     status          = true;
 
+    if (s_pDLog)
+    {
+        // Queue only, formatting is done by DLogProcess
+        DLOG_ARG arg[DLOG_MAXARG];
+
+        nargs = nargs < DLOG_MAXARG ? nargs : DLOG_MAXARG;
+        for (uint32_t i = 0; i < nargs; i++)
+        {
+            arg[i] = p_args[i];
+        }
+        DLogWrite(s_pDLog, p_str, nargs, arg);
+
+        return true;
+    }
+
     if (!timestamp_process(p_timestamp, &str[buffer_len], &buffer_len))
     {
         return false;
@@ -221,6 +253,31 @@ static uint32_t nrf_log_backend_stdio_hexdump_handler(
     uint32_t timestamp_len = p_timestamp ?
             NRF_LOG_TIMESTAMP_DIGITS+2 : 0; //+2 since timestamp is in brackets
 
+    if (s_pDLog)
+    {
+        // Data buffer is not kept, copy it into records as words
+        if (offset == 0)
+        {
+            DLogWrite(s_pDLog, p_str, 0, NULL);
+        }
+
+        while (byte_cnt < length)
+        {
+            DLOG_ARG w[4] = { 0, };
+            int n = 0;
+
+            for (int k = 0; k < HEXDUMP_BYTES_PER_LINE && byte_cnt < length; k++, byte_cnt++)
+            {
+                c = byte_cnt < buf0_length ? p_buf0[byte_cnt] : p_buf1[byte_cnt - buf0_length];
+                w[k >> 2] = (w[k >> 2] << 8) | c;
+                n = k;
+            }
+            DLogWrite(s_pDLog, s_DLogHexFmt[n >> 2][n & 3], (n >> 2) + 1, w);
+        }
+
+        return byte_cnt;
+    }
+
     // If it is the first part of hexdump print the header
     if (offset == 0)
     {
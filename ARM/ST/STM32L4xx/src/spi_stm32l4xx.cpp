@@ -654,6 +654,13 @@ bool STM32L4xxQSPISendCmd(DEVINTRF * const pDev, uint8_t Cmd, uint32_t Addr, uin
 {
 	STM32L4XX_SPIDEV *dev = (STM32L4XX_SPIDEV *)pDev->pDevData;
 
+	if ((dev->pQReg->CCR & QUADSPI_CCR_FMODE_Msk) == QUADSPI_CCR_FMODE_Msk)
+	{
+		// Memory mapped mode is active, abort it before sending new command
+		dev->pQReg->CR |= QUADSPI_CR_ABORT;
+		while (dev->pQReg->CR & QUADSPI_CR_ABORT);
+	}
+
 	dev->CcrReg &= ~(QUADSPI_CCR_INSTRUCTION_Msk | QUADSPI_CCR_IMODE_Msk | QUADSPI_CCR_DMODE_Msk |
 					QUADSPI_CCR_FMODE_Msk | QUADSPI_CCR_ADMODE_Msk | QUADSPI_CCR_DCYC_Msk);
 	dev->CcrReg |= Cmd | QUADSPI_CCR_IMODE_0;
@@ -979,6 +986,51 @@ bool QuadSPISendCmd(SPIDEV * const pDev, uint8_t Cmd, uint32_t Addr, uint8_t Add
 	return false;
 }
 
+const uint8_t *QuadSPIMemMap(SPIDEV * const pDev, uint8_t Cmd, uint8_t AddrLen, uint8_t DummyCycle)
+{
+	if (pDev->Cfg.DevNo != STM32L4XX_SPI_MAXDEV - 1 || AddrLen < 1 || AddrLen > 4)
+	{
+		return NULL;
+	}
+
+	STM32L4XX_SPIDEV *dev = (STM32L4XX_SPIDEV *)pDev->DevIntrf.pDevData;
+
+	if (STM32L4xxQSPIWaitBusy(dev, 100000) == false)
+	{
+		return NULL;
+	}
+
+	uint32_t ccr = dev->CcrReg & ~(QUADSPI_CCR_INSTRUCTION_Msk | QUADSPI_CCR_IMODE_Msk | QUADSPI_CCR_DMODE_Msk |
+								   QUADSPI_CCR_FMODE_Msk | QUADSPI_CCR_ADMODE_Msk | QUADSPI_CCR_DCYC_Msk |
+								   QUADSPI_CCR_ADSIZE_Msk);
+
+	ccr |= Cmd | QUADSPI_CCR_IMODE_0 | QUADSPI_CCR_FMODE_Msk | (DummyCycle << QUADSPI_CCR_DCYC_Pos) |
+		   ((AddrLen - 1) << QUADSPI_CCR_ADSIZE_Pos);
+
+	switch (Cmd)
+	{
+		case FLASH_CMD_DREAD:
+			ccr |= QUADSPI_CCR_ADMODE_0 | QUADSPI_CCR_DMODE_1;
+			break;
+		case FLASH_CMD_QREAD:
+			ccr |= QUADSPI_CCR_ADMODE_0 | QUADSPI_CCR_DMODE_Msk;
+			break;
+		case FLASH_CMD_2READ:
+			ccr |= QUADSPI_CCR_ADMODE_1 | QUADSPI_CCR_DMODE_1;
+			break;
+		case FLASH_CMD_4READ:
+			ccr |= QUADSPI_CCR_ADMODE_Msk | QUADSPI_CCR_DMODE_Msk;
+			break;
+		default:
+			ccr |= QUADSPI_CCR_ADMODE_0 | QUADSPI_CCR_DMODE_0;
+	}
+
+	dev->pQReg->FCR = dev->pQReg->FCR;	// Clear all flags
+	dev->pQReg->CCR = ccr;
+
+	return (const uint8_t *)QSPI_BASE;
+}
+
 SPIMODE SPISetMode(SPIDEV * const pDev, SPIMODE Mode)
 {
 	if (Mode != pDev->Cfg.Mode)
@@ -0,0 +1,630 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	APA102 frame encoder check & benchmark
+
+Checks the encoded stream against a simulated APA102 strip : color orders,
+gamma & level LUT, HDR per pixel brightness, partial update, busy interface,
+random double buffered updates against a reference, end frame latching and
+the LedApa102 class in both SPI and bit-bang mode.
+
+Benchmarks a 300 LEDs strip update with the previous bit-banged LedApa102
+path against the frame encoder plus one SPI transfer.
+
+Usage : Apa102Bench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <random>
+#include <chrono>
+#include <vector>
+
+#include "idelay.h"
+#include "miscdev/led_apa102.h"
+#include "miscdev/led_apa102_frame.h"
+#include "apa102_sim.h"
+
+using namespace std::chrono;
+
+#define NB_LED				300
+#define SPI_RATE			8000000
+#define NB_RANDOM_LOOP		3000
+#define NB_BENCH_LOOP		2000
+
+static std::mt19937 s_Rng(42);
+
+static int RandRange(int Min, int Max)
+{
+	std::uniform_int_distribution<int> d(Min, Max);
+	return d(s_Rng);
+}
+
+static uint32_t RandPixel()
+{
+	return RandRange(0, 0xFFFFFF);
+}
+
+static double usNow()
+{
+	return duration_cast<nanoseconds>(steady_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+// Pixel bit shift of each wire color byte
+static const struct {
+	APA102_ORDER Order;
+	const char *pName;
+	int Shift[3];
+} s_Orders[] = {
+	{ APA102_ORDER_BGR, "BGR", { 0, 8, 16 } },
+	{ APA102_ORDER_BRG, "BRG", { 0, 16, 8 } },
+	{ APA102_ORDER_GBR, "GBR", { 8, 0, 16 } },
+	{ APA102_ORDER_GRB, "GRB", { 8, 16, 0 } },
+	{ APA102_ORDER_RBG, "RBG", { 16, 0, 8 } },
+	{ APA102_ORDER_RGB, "RGB", { 16, 8, 0 } },
+};
+
+static APA102_FRAME_CFG FrameCfg(std::vector<uint8_t> &Mem, int NbLed)
+{
+	APA102_FRAME_CFG cfg;
+
+	Mem.assign(2 * APA102_FRAME_SIZE(NbLed), 0xA5);
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.NbLed = NbLed;
+	cfg.pMem = Mem.data();
+	cfg.MemSize = Mem.size();
+	cfg.Order = APA102_ORDER_BGR;
+	cfg.Brightness = 31;
+	cfg.Level = 255;
+	cfg.Gamma = 2.2;
+
+	return cfg;
+}
+
+/// Expected strip state encoded by the frame for a reference pixel array
+static bool StripMatch(Apa102Sim &Strip, APA102_FRAME *pFrame, const std::vector<uint32_t> &Ref)
+{
+	for (int i = 0; i < Strip.NbLed(); i++)
+	{
+		uint8_t e[4];
+
+		Apa102FrameEncode(pFrame, Ref[i], e);
+		uint32_t exp = ((uint32_t)e[0] << 24) | (e[1] << 16) | (e[2] << 8) | e[3];
+		if (Strip.Led(i) != exp)
+		{
+			printf("    LED %d : %08x expected %08x\n", i, Strip.Led(i), exp);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+// Fixed brightness : header & color order, LUT within 1 of the exact value
+static bool OrderCheck()
+{
+	bool ok = true;
+
+	for (size_t o = 0; o < sizeof(s_Orders) / sizeof(s_Orders[0]); o++)
+	{
+		std::vector<uint8_t> mem;
+		APA102_FRAME_CFG cfg = FrameCfg(mem, NB_LED);
+		APA102_FRAME frame;
+		Apa102Sim strip;
+		std::vector<uint32_t> px(NB_LED);
+		bool res = true;
+
+		cfg.Order = s_Orders[o].Order;
+		cfg.Brightness = 17;
+		cfg.Level = 200;
+		strip.Init(NB_LED, SPI_RATE);
+		res &= Apa102FrameInit(&frame, &cfg);
+
+		for (int i = 0; i < NB_LED; i++)
+		{
+			px[i] = RandPixel();
+		}
+		Apa102FrameSetPixels(&frame, 0, px.data(), NB_LED);
+		res &= Apa102FrameShow(&frame, strip);
+		res &= strip.LastUpdated() == NB_LED;
+
+		for (int i = 0; res && i < NB_LED; i++)
+		{
+			uint32_t led = strip.Led(i);
+
+			res &= (led >> 24) == (0xE0 | 17);
+			for (int c = 0; c < 3; c++)
+			{
+				int v = (px[i] >> s_Orders[o].Shift[c]) & 0xFF;
+				double exact = pow(v / 255.0, 2.2) * 200.0;
+				int got = (led >> (16 - 8 * c)) & 0xFF;
+
+				res &= fabs(got - exact) <= 1.0;
+			}
+		}
+		printf("  order %s : %s\n", s_Orders[o].pName, res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	return ok;
+}
+
+// HDR : light output within half a step of the selected header brightness
+// plus LUT & scale rounding. Compare low level error against fixed brightness
+static bool HdrCheck()
+{
+	std::vector<uint8_t> mem[2];
+	APA102_FRAME_CFG cfg[2] = { FrameCfg(mem[0], 1), FrameCfg(mem[1], 1) };
+	APA102_FRAME frame[2];
+	bool ok = true;
+	double maxerr[2] = { 0, 0 };
+	double lowerr[2] = { 0, 0 };
+	int minbright = 31;
+
+	cfg[0].Gamma = cfg[1].Gamma = 2.6;
+	cfg[1].bHdr = true;
+	ok &= Apa102FrameInit(&frame[0], &cfg[0]);
+	ok &= Apa102FrameInit(&frame[1], &cfg[1]);
+
+	for (int n = 0; n < 256 * 64; n++)
+	{
+		uint32_t px = n < 256 ? n * 0x010101 : n & 1 ? RandPixel() : RandRange(0, 40) * 0x10000 + RandRange(0, 40) * 0x100 + RandRange(0, 40);
+		double pxmax = 0;
+
+		for (int c = 0; c < 3; c++)
+		{
+			double v = pow(((px >> (8 * c)) & 0xFF) / 255.0, 2.6);
+
+			pxmax = v > pxmax ? v : pxmax;
+		}
+
+		for (int m = 0; m < 2; m++)
+		{
+			uint8_t e[4];
+
+			Apa102FrameEncode(&frame[m], px, e);
+
+			int b = e[0] & 0x1F;
+
+			ok &= (e[0] & 0xE0) == 0xE0;
+			if (m == 1 && b > 0)
+			{
+				minbright = b < minbright ? b : minbright;
+			}
+
+			for (int c = 0; c < 3; c++)
+			{
+				double exact = pow(((px >> (8 * c)) & 0xFF) / 255.0, 2.6);
+				double out = e[1 + c] / 255.0 * b / 31.0;
+				double err = fabs(out - exact);
+
+				maxerr[m] = err > maxerr[m] ? err : maxerr[m];
+				if (pxmax < 0.01)
+				{
+					lowerr[m] = err > lowerr[m] ? err : lowerr[m];
+				}
+				if (m == 1 && err > 0.52 / 255.0 * b / 31.0 + 1.0 / 65535.0)
+				{
+					ok = false;
+				}
+			}
+		}
+	}
+
+	printf("  HDR : max error %.5f (fixed %.5f), below 1%% %.6f (fixed %.6f), min header %d : %s\n",
+		   maxerr[1], maxerr[0], lowerr[1], lowerr[0], minbright, ok && lowerr[1] < lowerr[0] / 8 ? "PASS" : "FAIL");
+
+	return ok && lowerr[1] < lowerr[0] / 8;
+}
+
+// Partial update transfers only up to the last changed LED, busy interface
+// defers & merges changes
+static bool PartialCheck()
+{
+	std::vector<uint8_t> mem;
+	APA102_FRAME_CFG cfg = FrameCfg(mem, NB_LED);
+	APA102_FRAME frame;
+	Apa102Sim strip;
+	std::vector<uint32_t> ref(NB_LED, 0);
+	bool ok = true;
+
+	cfg.bPartial = true;
+	strip.Init(NB_LED, SPI_RATE);
+	ok &= Apa102FrameInit(&frame, &cfg);
+	for (int i = 0; i < NB_LED; i++)
+	{
+		ref[i] = RandPixel();
+	}
+	Apa102FrameSetPixels(&frame, 0, ref.data(), NB_LED);
+	ok &= Apa102FrameShow(&frame, strip);
+	ok &= StripMatch(strip, &frame, ref);
+
+	uint64_t bytes = strip.ByteCount();
+
+	for (int i = 10; i < 20; i++)
+	{
+		ref[i] = RandPixel();
+	}
+	Apa102FrameSetPixels(&frame, 10, &ref[10], 10);
+	ok &= Apa102FrameShow(&frame, strip);
+	ok &= strip.ByteCount() - bytes == APA102_START_SIZE + 20 * 4 + APA102_END_SIZE(20);
+	ok &= strip.LastUpdated() == 20;
+	ok &= StripMatch(strip, &frame, ref);
+
+	// Nothing changed, no transfer
+	uint32_t xfer = strip.XferCount();
+	ok &= Apa102FrameShow(&frame, strip) && strip.XferCount() == xfer;
+
+	printf("  partial : %s\n", ok ? "PASS" : "FAIL");
+
+	// Busy
+	DEVINTRF *intrf = strip;
+
+	atomic_flag_test_and_set(&intrf->bBusy);
+	ref[5] = 0x123456;
+	Apa102FrameSetPixels(&frame, 5, &ref[5], 1);
+	ok &= Apa102FrameShow(&frame, strip) == false;
+	ref[100] = 0x654321;
+	Apa102FrameFill(&frame, 100, ref[100], 1);
+	atomic_flag_clear(&intrf->bBusy);
+	ok &= Apa102FrameShow(&frame, strip);
+	ok &= frame.BusyCnt == 1 && strip.LastUpdated() == 101;
+	ok &= StripMatch(strip, &frame, ref);
+
+	// Clipping
+	std::vector<uint32_t> px(10);
+	for (int i = 0; i < 10; i++)
+	{
+		px[i] = RandPixel();
+	}
+	Apa102FrameSetPixels(&frame, -5, px.data(), 10);
+	Apa102FrameSetPixels(&frame, NB_LED - 3, px.data(), 10);
+	Apa102FrameFill(&frame, NB_LED + 1, 0xFFFFFF, 4);
+	Apa102FrameFill(&frame, -10, 0xFFFFFF, 5);
+	for (int i = 0; i < 5; i++)
+	{
+		ref[i] = px[5 + i];
+	}
+	for (int i = 0; i < 3; i++)
+	{
+		ref[NB_LED - 3 + i] = px[i];
+	}
+	ok &= Apa102FrameShow(&frame, strip);
+	ok &= StripMatch(strip, &frame, ref);
+
+	printf("  busy & clip : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Random updates, shows and busy periods. Strip must always match the
+// reference after each completed show, in both full and partial modes
+static bool RandomCheck()
+{
+	bool ok = true;
+
+	for (int mode = 0; mode < 4; mode++)
+	{
+		std::vector<uint8_t> mem;
+		APA102_FRAME_CFG cfg = FrameCfg(mem, NB_LED);
+		APA102_FRAME frame;
+		Apa102Sim strip;
+		std::vector<uint32_t> ref(NB_LED, 0);
+		DEVINTRF *intrf = strip;
+		uint64_t bytes = 0;
+		bool res = true;
+
+		cfg.bPartial = mode & 1;
+		cfg.bHdr = mode & 2;
+		strip.Init(NB_LED, SPI_RATE);
+		res &= Apa102FrameInit(&frame, &cfg);
+
+		for (int n = 0; res && n < NB_RANDOM_LOOP; n++)
+		{
+			int op = RandRange(0, 9);
+			int idx = RandRange(-5, NB_LED);
+			int cnt = RandRange(1, op < 2 ? NB_LED : 16);
+
+			if (op < 5)
+			{
+				std::vector<uint32_t> px(cnt);
+
+				for (int i = 0; i < cnt; i++)
+				{
+					px[i] = RandPixel();
+					if (idx + i >= 0 && idx + i < NB_LED)
+					{
+						ref[idx + i] = px[i];
+					}
+				}
+				Apa102FrameSetPixels(&frame, idx, px.data(), cnt);
+			}
+			else if (op < 7)
+			{
+				uint32_t p = RandPixel();
+
+				for (int i = idx < 0 ? 0 : idx; i < idx + cnt && i < NB_LED; i++)
+				{
+					ref[i] = p;
+				}
+				Apa102FrameFill(&frame, idx, p, cnt);
+			}
+			else if (op < 8)
+			{
+				atomic_flag_test_and_set(&intrf->bBusy);
+				res &= Apa102FrameShow(&frame, strip) == (Apa102FrameChanged(&frame) == false);
+				atomic_flag_clear(&intrf->bBusy);
+			}
+			else
+			{
+				res &= Apa102FrameShow(&frame, strip);
+				res &= StripMatch(strip, &frame, ref);
+			}
+		}
+		res &= strip.StartErrCount() == 0 && strip.LatchErrCount() == 0;
+		bytes = strip.ByteCount();
+
+		printf("  random %-7s %-5s : %u shows, %.1f bytes/show : %s\n", cfg.bPartial ? "partial" : "full",
+			   cfg.bHdr ? "HDR" : "fixed", strip.XferCount(), (double)bytes / strip.XferCount(), res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	return ok;
+}
+
+// End frame must be long enough to latch the last LED, the simulator must
+// catch a short one
+static bool LatchCheck()
+{
+	bool ok = true;
+	int sizes[] = { 1, 15, 16, 17, 64, 300, 1000, 2048 };
+
+	for (size_t s = 0; s < sizeof(sizes) / sizeof(sizes[0]); s++)
+	{
+		std::vector<uint8_t> mem;
+		APA102_FRAME_CFG cfg = FrameCfg(mem, sizes[s]);
+		APA102_FRAME frame;
+		Apa102Sim strip;
+
+		strip.Init(sizes[s], SPI_RATE);
+		ok &= Apa102FrameInit(&frame, &cfg);
+		Apa102FrameFill(&frame, 0, 0x808080, sizes[s]);
+		ok &= Apa102FrameShow(&frame, strip);
+		ok &= strip.LastUpdated() == sizes[s] && strip.LatchErrCount() == 0;
+	}
+
+	Apa102Sim strip;
+	std::vector<uint8_t> mem;
+	APA102_FRAME_CFG cfg = FrameCfg(mem, 1000);
+	APA102_FRAME frame;
+
+	strip.Init(1000, SPI_RATE);
+	Apa102FrameInit(&frame, &cfg);
+	DeviceIntrfTx(strip, 0, Apa102FrameBack(&frame), APA102_START_SIZE + 1000 * APA102_LED_SIZE + 4);
+	ok &= strip.LatchErrCount() > 0;
+
+	printf("  end frame latch : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+static bool ClassCheck()
+{
+	std::vector<uint8_t> mem;
+	APA102_FRAME_CFG cfg = FrameCfg(mem, NB_LED);
+	Apa102Sim strip;
+	LedApa102 led;
+	uint32_t pat[4] = { 0xFF0000, 0x00FF00, 0x0000FF, 0x102030 };
+	uint32_t save[4];
+	bool ok = true;
+
+	memcpy(save, pat, sizeof(pat));
+	cfg.Gamma = 1.0;
+	strip.Init(NB_LED, SPI_RATE);
+	ok &= led.Init(&strip, cfg);
+	led.Level(pat, 4, 2);
+	for (int i = 0; i < 12; i++)
+	{
+		uint32_t p = pat[i & 3];
+		uint32_t exp = 0xFF000000 | ((p & 0xFF) << 16) | (p & 0xFF00) | (p >> 16);
+
+		ok &= strip.Led(i) == exp;
+	}
+	ok &= strip.Led(12) == 0xFF000000;
+	led.Off();
+	ok &= strip.Led(0) == 0xFF000000 && strip.Led(1) == 0xFF00FF00;
+
+	APA102_CFG gcfg = { NB_LED, 0, 1, 0, 2, 31 };
+	LedApa102 gled;
+
+	ok &= gled.Init(gcfg);
+	gled.Level(pat, 4);
+	ok &= memcmp(pat, save, sizeof(pat)) == 0;
+
+	printf("  LedApa102 : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Copy of the previous bit-banged LedApa102::Level with a pin write counter
+static volatile uint32_t s_PinWrite;
+
+static inline void PinWrite() { s_PinWrite = s_PinWrite + 1; }
+
+static void LegacyLevel(uint32_t * const pVal, int NbLeds, uint8_t Brightness)
+{
+	uint32_t bit = 0x80000000;
+
+	PinWrite();
+	while (bit != 0)
+	{
+		PinWrite();
+		usDelay(1);
+		PinWrite();
+		bit >>= 1;
+	}
+
+	uint32_t *p = pVal;
+
+	for (int i = 0; i < NbLeds; i++, p++)
+	{
+		bit = 0x80000000;
+		*p = (*p & 0xFFFFFF) | (0xe0 | Brightness);
+
+		while (bit != 0)
+		{
+			PinWrite();
+			PinWrite();
+			PinWrite();
+			bit >>= 1;
+		}
+	}
+
+	bit = 0x80000000;
+	PinWrite();
+	while (bit != 0)
+	{
+		PinWrite();
+		usDelay(1);
+		PinWrite();
+		bit >>= 1;
+	}
+}
+
+static int NullTxData(DEVINTRF * const pDev, uint8_t *pData, int DataLen) { return DataLen; }
+static bool NullStartTx(DEVINTRF * const pDev, int DevAddr) { return true; }
+static void NullStopTx(DEVINTRF * const pDev) {}
+
+static void Bench()
+{
+	std::vector<uint32_t> px(NB_LED);
+	std::vector<uint8_t> mem;
+	APA102_FRAME_CFG cfg = FrameCfg(mem, NB_LED);
+	APA102_FRAME frame;
+	Apa102Sim strip;
+	double t;
+	int loop = 20;
+
+	for (int i = 0; i < NB_LED; i++)
+	{
+		px[i] = RandPixel();
+	}
+
+	s_PinWrite = 0;
+	t = usNow();
+	for (int n = 0; n < loop; n++)
+	{
+		LegacyLevel(px.data(), NB_LED, 31);
+	}
+	t = (usNow() - t) / loop;
+	printf("  bit-bang legacy     : %8.1f us/frame, %u pin writes, 64 x usDelay(1)\n", t, s_PinWrite / loop);
+
+	// Null interface to time CPU work only
+	DEVINTRF null;
+
+	strip.Init(NB_LED, SPI_RATE);
+	memcpy((void*)&null, (DEVINTRF*)strip, sizeof(null));
+	null.StartTx = NullStartTx;
+	null.TxData = NullTxData;
+	null.StopTx = NullStopTx;
+	atomic_flag_clear(&null.bBusy);
+
+	for (int hdr = 0; hdr < 2; hdr++)
+	{
+		cfg.bHdr = hdr;
+		cfg.bPartial = true;
+		Apa102FrameInit(&frame, &cfg);
+
+		t = usNow();
+		for (int n = 0; n < NB_BENCH_LOOP; n++)
+		{
+			px[n % NB_LED] ^= n;
+			Apa102FrameSetPixels(&frame, 0, px.data(), NB_LED);
+			Apa102FrameShow(&frame, &null);
+		}
+		t = (usNow() - t) / NB_BENCH_LOOP;
+		printf("  %-5s full frame     : %8.2f us/frame CPU, %d bytes, %.1f us on wire at %d MHz\n",
+			   hdr ? "HDR" : "fixed", t, APA102_FRAME_SIZE(NB_LED),
+			   APA102_FRAME_SIZE(NB_LED) * 8e6 / SPI_RATE, SPI_RATE / 1000000);
+
+		t = usNow();
+		for (int n = 0; n < NB_BENCH_LOOP * 10; n++)
+		{
+			Apa102FrameSetPixels(&frame, 0, &px[n & 0xFF], 16);
+			Apa102FrameShow(&frame, &null);
+		}
+		t = (usNow() - t) / (NB_BENCH_LOOP * 10);
+
+		int plen = APA102_START_SIZE + 16 * APA102_LED_SIZE + APA102_END_SIZE(16);
+
+		printf("  %-5s 16 LED update  : %8.2f us/frame CPU, %d bytes, %.1f us on wire\n",
+			   hdr ? "HDR" : "fixed", t, plen, plen * 8e6 / SPI_RATE);
+	}
+
+	t = usNow();
+	for (int n = 0; n < NB_BENCH_LOOP; n++)
+	{
+		Apa102FrameFill(&frame, 0, n, NB_LED);
+	}
+	t = (usNow() - t) / NB_BENCH_LOOP;
+	printf("  fill                : %8.2f us/frame CPU\n", t);
+
+	t = usNow();
+	for (int n = 0; n < 100; n++)
+	{
+		Apa102FrameSetGamma(&frame, 2.0 + n / 100.0, 255);
+	}
+	t = (usNow() - t) / 100;
+	printf("  gamma LUT build     : %8.2f us\n", t);
+}
+
+int main()
+{
+	bool ok = true;
+
+	printf("APA102 frame encoder, %d LEDs\n\n", NB_LED);
+
+	ok &= OrderCheck();
+	ok &= HdrCheck();
+	ok &= PartialCheck();
+	ok &= RandomCheck();
+	ok &= LatchCheck();
+	ok &= ClassCheck();
+
+	printf("\nBenchmark\n");
+	Bench();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
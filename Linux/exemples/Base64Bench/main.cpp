@@ -0,0 +1,374 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Base64 encode/decode check and benchmark
+
+Checks RFC 4648 vectors for both alphabets, random round trips through the
+streaming API with random chunking, padding and line wrapping, error cases
+and SIMD against scalar output. Then measures encode and decode throughput
+against the previous bit by bit encoder.
+
+Usage : Base64Bench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include <string>
+
+#include "base64.h"
+
+#define BENCH_SIZE			(16 * 1024 * 1024)
+#define BENCH_LOOP			8
+
+static int s_FailCnt = 0;
+
+static void Check(bool bOk, const char *pMsg)
+{
+	if (bOk == false)
+	{
+		printf("  FAIL : %s\n", pMsg);
+		s_FailCnt++;
+	}
+}
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+/// Previous encoder, kept for comparison
+static int LegacyEncode(const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen)
+{
+	int idx = 0;
+	uint32_t d = 0;
+	uint8_t *p = (uint8_t *)&d;
+	int len;
+	int cnt = 0;
+
+	while (SrcLen > 0)
+	{
+		d = 0;
+		len = std::min(SrcLen - 1, 2);
+		for (int i = 2; i >= 0 && SrcLen > 0; i--)
+		{
+			p[i] = *pSrc;
+			pSrc++;
+			SrcLen--;
+		}
+		len += 1 + idx;
+		for (int i = idx + 3; i >= idx && cnt < DstLen - 1; i--)
+		{
+			if (i > len)
+				pDest[i] = '=';
+			else {
+				pDest[i] = d & 0x3f;
+				if (pDest[i] < 26)
+					pDest[i] += 'A';
+				else if (pDest[i] < 52)
+					pDest[i] += 'a' - 26;
+				else if (pDest[i] < 62)
+					pDest[i] += '0' - 52;
+				else if (pDest[i] == 63)
+					pDest[i] = '/';
+				else
+					pDest[i] = '+';
+			}
+			d >>= 6;
+			cnt++;
+		}
+		idx += 4;
+	}
+
+	pDest[cnt] = '\0';
+
+	return cnt;
+}
+
+static void CheckVectors()
+{
+	static const char *s_Vect[][2] = {
+		{ "", "" }, { "f", "Zg==" }, { "fo", "Zm8=" }, { "foo", "Zm9v" },
+		{ "foob", "Zm9vYg==" }, { "fooba", "Zm9vYmE=" }, { "foobar", "Zm9vYmFy" },
+	};
+	char enc[64];
+	uint8_t dec[64];
+
+	for (size_t i = 0; i < sizeof(s_Vect) / sizeof(s_Vect[0]); i++)
+	{
+		int l = strlen(s_Vect[i][0]);
+		int n = Base64Encode((const uint8_t*)s_Vect[i][0], l, enc, sizeof(enc));
+
+		Check(n == (int)strlen(s_Vect[i][1]) && strcmp(enc, s_Vect[i][1]) == 0, s_Vect[i][1]);
+
+		n = Base64Decode(s_Vect[i][1], strlen(s_Vect[i][1]), dec, sizeof(dec), BASE64_ALPHABET_STD);
+		Check(n == l && memcmp(dec, s_Vect[i][0], l) == 0, s_Vect[i][0]);
+
+		// Unpadded form decodes the same
+		n = Base64EncodeEx((const uint8_t*)s_Vect[i][0], l, enc, sizeof(enc), BASE64_ALPHABET_STD, false);
+		Check(strchr(enc, '=') == NULL, "unpadded encode");
+		n = Base64Decode(enc, n, dec, sizeof(dec), BASE64_ALPHABET_STD);
+		Check(n == l && memcmp(dec, s_Vect[i][0], l) == 0, "unpadded decode");
+	}
+
+	const uint8_t url[] = { 0xfb, 0xff };
+
+	Base64EncodeEx(url, 2, enc, sizeof(enc), BASE64_ALPHABET_URL, false);
+	Check(strcmp(enc, "-_8") == 0, "URL -_8");
+	Base64EncodeEx(url, 2, enc, sizeof(enc), BASE64_ALPHABET_STD, true);
+	Check(strcmp(enc, "+/8=") == 0, "STD +/8=");
+	Check(Base64Decode("-_8", 3, dec, sizeof(dec), BASE64_ALPHABET_URL) == 2 && dec[0] == 0xfb && dec[1] == 0xff, "URL decode");
+	Check(Base64Decode("-_8", 3, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "URL chars in STD");
+
+	// Whitespace anywhere, errors
+	Check(Base64Decode(" Zm9v\r\nYmFy\n", 12, dec, sizeof(dec), BASE64_ALPHABET_STD) == 6 && memcmp(dec, "foobar", 6) == 0, "white space");
+	Check(Base64Decode("Zm9v YmE=\n", 10, dec, sizeof(dec), BASE64_ALPHABET_STD) == 5, "trailing newline");
+	Check(Base64Decode("Zm9vY", 5, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "dangling char");
+	Check(Base64Decode("Zg==Zg==", 8, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "data after pad");
+	Check(Base64Decode("Z===", 4, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "pad too early");
+	Check(Base64Decode("Zm9=v", 5, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "data inside pad");
+	Check(Base64Decode("Zm9v!mFy", 8, dec, sizeof(dec), BASE64_ALPHABET_STD) < 0, "invalid char");
+	Check(Base64Decode("Zm9vYmFy", 8, dec, 5, BASE64_ALPHABET_STD) < 0, "dest too small");
+	Check(Base64EncodeEx((const uint8_t*)"foo", 3, enc, 4, BASE64_ALPHABET_STD, true) < 0, "enc dest too small");
+
+	// Legacy truncation to whole quads
+	Check(Base64Encode((const uint8_t*)"foobar", 6, enc, 6) == 4 && strcmp(enc, "Zm9v") == 0, "truncate");
+}
+
+/// Stream encode/decode random data in random chunks
+static void CheckStream(bool bSimd)
+{
+	Base64SetSimd(bSimd);
+
+	for (int iter = 0; iter < 2000; iter++)
+	{
+		int len = rand() % 3000;
+		BASE64_ALPHABET alpha = (BASE64_ALPHABET)(rand() & 1);
+		bool bpad = rand() & 1;
+		int linelen = (rand() % 3) == 0 ? 4 * (1 + rand() % 20) : 0;
+		std::vector<uint8_t> src(len), dec(len + 16);
+		std::string ref;
+		std::vector<char> enc(len * 2 + 64);
+
+		for (int i = 0; i < len; i++)
+		{
+			src[i] = rand();
+		}
+
+		// Reference through the one shot API
+		std::vector<char> one(BASE64_ENCODED_LEN(len) + 1);
+		Base64EncodeEx(src.data(), len, one.data(), one.size(), alpha, bpad);
+
+		BASE64_ENCCTX ectx;
+		Base64EncInit(&ectx, alpha, bpad, linelen);
+
+		int o = 0, i = 0;
+		while (i < len)
+		{
+			int l = std::min(len - i, 1 + rand() % 200);
+			int n = Base64EncUpdate(&ectx, &src[i], l, &enc[o], enc.size() - o);
+			if (n < 0)
+			{
+				Check(false, "enc update");
+				return;
+			}
+			o += n;
+			i += l;
+		}
+		o += Base64EncFinal(&ectx, &enc[o], enc.size() - o);
+
+		// Remove line breaks and compare with one shot
+		for (int k = 0; k < o; k++)
+		{
+			if (enc[k] != '\r' && enc[k] != '\n')
+			{
+				ref += enc[k];
+			}
+			else if (linelen == 0)
+			{
+				Check(false, "unexpected line break");
+			}
+		}
+		Check(ref == one.data(), "stream vs one shot");
+
+		if (linelen > 0 && o > 0)
+		{
+			int col = 0;
+			bool ok = enc[o - 1] != '\n';
+			for (int k = 0; k < o; k++)
+			{
+				if (enc[k] == '\r')
+				{
+					ok &= col == linelen && enc[k + 1] == '\n';
+					col = 0;
+					k++;
+				}
+				else
+				{
+					col++;
+				}
+			}
+			Check(ok && col <= linelen, "line wrap");
+		}
+
+		BASE64_DECCTX dctx;
+		Base64DecInit(&dctx, alpha);
+
+		int d = 0;
+		i = 0;
+		while (i < o)
+		{
+			int l = std::min(o - i, 1 + rand() % 300);
+			int n = Base64DecUpdate(&dctx, &enc[i], l, &dec[d], dec.size() - d);
+			if (n < 0)
+			{
+				Check(false, "dec update");
+				return;
+			}
+			d += n;
+			i += l;
+		}
+		int n = Base64DecFinal(&dctx, &dec[d], dec.size() - d);
+		Check(n >= 0, "dec final");
+		d += n;
+		Check(d == len && memcmp(dec.data(), src.data(), len) == 0, "round trip");
+	}
+}
+
+/// SIMD and scalar must agree, including on invalid input
+static void CheckSimdScalar()
+{
+	std::vector<uint8_t> src(4096);
+	std::vector<char> e1(8192), e2(8192);
+	std::vector<uint8_t> d1(4096 + 16), d2(4096 + 16);
+
+	for (int iter = 0; iter < 500; iter++)
+	{
+		int len = rand() % 4096;
+
+		for (int i = 0; i < len; i++)
+		{
+			src[i] = rand();
+		}
+		for (int a = 0; a < 2; a++)
+		{
+			Base64SetSimd(true);
+			int n1 = Base64EncodeEx(src.data(), len, e1.data(), e1.size(), (BASE64_ALPHABET)a, true);
+			Base64SetSimd(false);
+			int n2 = Base64EncodeEx(src.data(), len, e2.data(), e2.size(), (BASE64_ALPHABET)a, true);
+			Check(n1 == n2 && memcmp(e1.data(), e2.data(), n1) == 0, "simd encode");
+
+			// Corrupt one character some of the time
+			if (n1 > 0 && (iter & 1))
+			{
+				e1[rand() % n1] = rand();
+			}
+			Base64SetSimd(true);
+			n1 = Base64Decode(e1.data(), n1, d1.data(), d1.size(), (BASE64_ALPHABET)a);
+			Base64SetSimd(false);
+			n2 = Base64Decode(e1.data(), n2, d2.data(), d2.size(), (BASE64_ALPHABET)a);
+			Check(n1 == n2 && (n1 < 0 || memcmp(d1.data(), d2.data(), n1) == 0), "simd decode");
+		}
+	}
+}
+
+static void Bench()
+{
+	std::vector<uint8_t> src(BENCH_SIZE), dec(BENCH_SIZE + 16);
+	std::vector<char> enc(BASE64_ENCODED_LEN(BENCH_SIZE) + 1);
+	double t;
+	int n = 0;
+
+	for (int i = 0; i < BENCH_SIZE; i++)
+	{
+		src[i] = rand();
+	}
+
+	t = usNow();
+	for (int i = 0; i < BENCH_LOOP; i++)
+	{
+		n = LegacyEncode(src.data(), BENCH_SIZE, enc.data(), enc.size());
+	}
+	t = usNow() - t;
+	printf("  legacy encode      %8.1f MB/s\n", (double)BENCH_SIZE * BENCH_LOOP / t);
+
+	for (int s = 0; s < 2; s++)
+	{
+		bool bsimd = Base64SetSimd(s == 0) && s == 0;
+
+		t = usNow();
+		for (int i = 0; i < BENCH_LOOP; i++)
+		{
+			n = Base64EncodeEx(src.data(), BENCH_SIZE, enc.data(), enc.size(), BASE64_ALPHABET_STD, true);
+		}
+		t = usNow() - t;
+		printf("  %-6s encode      %8.1f MB/s\n", bsimd ? "simd" : "scalar", (double)BENCH_SIZE * BENCH_LOOP / t);
+
+		int d = 0;
+		t = usNow();
+		for (int i = 0; i < BENCH_LOOP; i++)
+		{
+			d = Base64Decode(enc.data(), n, dec.data(), dec.size(), BASE64_ALPHABET_STD);
+		}
+		t = usNow() - t;
+		printf("  %-6s decode      %8.1f MB/s\n", bsimd ? "simd" : "scalar", (double)BENCH_SIZE * BENCH_LOOP / t);
+		Check(d == BENCH_SIZE && memcmp(dec.data(), src.data(), BENCH_SIZE) == 0, "bench round trip");
+	}
+	Base64SetSimd(true);
+}
+
+int main()
+{
+	srand(1);
+
+	printf("Base64, SIMD %s\n\n", Base64SetSimd(true) ? "available" : "not available");
+
+	printf("Vectors\n");
+	CheckVectors();
+	printf("Stream, simd\n");
+	CheckStream(true);
+	printf("Stream, scalar\n");
+	CheckStream(false);
+	printf("SIMD vs scalar\n");
+	CheckSimdScalar();
+	printf("Throughput, %d MB\n", BENCH_SIZE >> 20);
+	Bench();
+
+	printf("\n%s\n", s_FailCnt == 0 ? "PASS" : "FAIL");
+
+	return s_FailCnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,456 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Bit packed field codec check & benchmark
+
+Checks every fixed size BLUEIO & BLEADV layout of blueio_bitpack.h :
+full width layouts must pack to the exact packed structure image and unpack
+back to the same structure, in both bit orders. Compact layouts must round
+trip within half a step and clamp out of range values.
+
+Then times the generated compact TPH pack/unpack against the equivalent hand
+written shift code, and checks both produce the same bytes.
+
+Usage : BitPackBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <random>
+#include <chrono>
+
+#include "blueio_bitpack.h"
+
+using namespace std::chrono;
+
+#define NB_CHECK_LOOP		10000
+#define NB_BENCH_REC		4096
+#define NB_BENCH_LOOP		2000
+
+static std::mt19937 s_Rng(42);
+
+static int32_t RandRange(int32_t Min, int32_t Max)
+{
+	std::uniform_int_distribution<int32_t> d(Min, Max);
+	return d(s_Rng);
+}
+
+static void RandFill(void *pData, int Len)
+{
+	uint8_t *p = (uint8_t*)pData;
+
+	for (int i = 0; i < Len; i++)
+	{
+		p[i] = (uint8_t)RandRange(0, 255);
+	}
+}
+
+// Full width layout : packed image must be the structure image on a little
+// endian host, big endian must round trip
+template <typename L, typename S>
+static bool ImageCheck(const char *pName, void (*Fix)(S&) = NULL)
+{
+	bool ok = (int)L::Size == (int)sizeof(S);
+
+	for (int n = 0; ok && n < NB_CHECK_LOOP; n++)
+	{
+		S d, r;
+		uint8_t buff[sizeof(S) + 4];
+
+		RandFill(&d, sizeof(S));
+		if (Fix)
+		{
+			Fix(d);
+		}
+
+		L::Pack(d, buff);
+		if (memcmp(buff, &d, sizeof(S)) != 0)
+		{
+			ok = false;
+		}
+		memset(&r, 0xA5, sizeof(r));
+		L::Unpack(buff, r);
+		if (memcmp(&r, &d, sizeof(S)) != 0)
+		{
+			ok = false;
+		}
+	}
+
+	printf("%-28s : %2u bytes, image %s\n", pName, L::Size, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+template <typename L, typename S>
+static bool BigEndianCheck(const char *pName, void (*Fix)(S&) = NULL)
+{
+	bool ok = true;
+
+	for (int n = 0; ok && n < NB_CHECK_LOOP; n++)
+	{
+		S d, r;
+		uint8_t buff[sizeof(S) + 4];
+
+		RandFill(&d, sizeof(S));
+		if (Fix)
+		{
+			Fix(d);
+		}
+		L::Pack(d, buff);
+		memset(&r, 0xA5, sizeof(r));
+		L::Unpack(buff, r);
+		if (memcmp(&r, &d, sizeof(S)) != 0)
+		{
+			ok = false;
+		}
+	}
+
+	printf("%-28s : big endian round trip %s\n", pName, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+static void FixBut(BLUEIO_DATA_BUT &d)
+{
+	for (int i = 0; i < BLUEIO_BUTTON_ARRAY_MAX; i++)
+	{
+		d.ButState[i] = (BLUEIO_BUT_STATE)RandRange(BLUEIO_BUT_STATE_OFF, BLUEIO_BUT_STATE_RELEASED);
+	}
+}
+
+static void FixAdc(BLUEIO_DATA_ADC &d)
+{
+	d.Voltage = (float)RandRange(-100000, 100000) / 1000.0f;
+}
+
+static bool FullLayoutCheck()
+{
+	bool ok = true;
+
+	ok &= ImageCheck<BLUEIO_DATA_TPH_LAYOUT, BLUEIO_DATA_TPH>("BLUEIO_DATA_TPH");
+	ok &= ImageCheck<BLUEIO_DATA_GAS_LAYOUT, BLUEIO_DATA_GAS>("BLUEIO_DATA_GAS");
+	ok &= ImageCheck<BLUEIO_DATA_ACCEL_LAYOUT, BLUEIO_DATA_ACCEL>("BLUEIO_DATA_ACCEL");
+	ok &= ImageCheck<BLUEIO_DATA_GYRO_LAYOUT, BLUEIO_DATA_GYRO>("BLUEIO_DATA_GYRO");
+	ok &= ImageCheck<BLUEIO_DATA_MAG_LAYOUT, BLUEIO_DATA_MAG>("BLUEIO_DATA_MAG");
+	ok &= ImageCheck<BLUEIO_DATA_PROXY_LAYOUT, BLUEIO_DATA_PROXY>("BLUEIO_DATA_PROXY");
+	ok &= ImageCheck<BLUEIO_DATA_ADC_LAYOUT, BLUEIO_DATA_ADC>("BLUEIO_DATA_ADC", FixAdc);
+	ok &= ImageCheck<BLUEIO_DATA_GPIO_LAYOUT, BLUEIO_DATA_GPIO>("BLUEIO_DATA_GPIO");
+	ok &= ImageCheck<BLUEIO_DATA_BUT_LAYOUT, BLUEIO_DATA_BUT>("BLUEIO_DATA_BUT", FixBut);
+	ok &= ImageCheck<BLUEIO_DATA_MOTION_LAYOUT, BLUEIO_DATA_MOTION>("BLUEIO_DATA_MOTION");
+	ok &= ImageCheck<BLUEIO_DATA_I2C_LAYOUT, BLUEIO_DATA_I2C>("BLUEIO_DATA_I2C");
+	ok &= ImageCheck<BLUEIO_DATA_SPI_LAYOUT, BLUEIO_DATA_SPI>("BLUEIO_DATA_SPI");
+	ok &= ImageCheck<BLUEIO_DATA_UART_LAYOUT, BLUEIO_DATA_UART>("BLUEIO_DATA_UART");
+	ok &= ImageCheck<BLUEIO_DATA_BAT_LAYOUT, BLUEIO_DATA_BAT>("BLUEIO_DATA_BAT");
+	ok &= ImageCheck<BLEADV_MANDATA_TPHSENSOR_LAYOUT, BLEADV_MANDATA_TPHSENSOR>("BLEADV_MANDATA_TPHSENSOR");
+	ok &= ImageCheck<BLEADV_MANDATA_GASSENSOR_LAYOUT, BLEADV_MANDATA_GASSENSOR>("BLEADV_MANDATA_GASSENSOR");
+	ok &= ImageCheck<BLEADV_MANDATA_IMUSENSOR_LAYOUT, BLEADV_MANDATA_IMUSENSOR>("BLEADV_MANDATA_IMUSENSOR");
+	ok &= ImageCheck<BLEADV_MANDATA_GPIO_LAYOUT, BLEADV_MANDATA_GPIO>("BLEADV_MANDATA_GPIO");
+	ok &= ImageCheck<BLEADV_MANDATA_BUT_LAYOUT, BLEADV_MANDATA_BUT>("BLEADV_MANDATA_BUT");
+
+	// Same TPH description, network order
+	typedef BpLayout<BPENDIAN_BIG,
+		BpField<BLUEIO_DATA_TPH, uint32_t, &BLUEIO_DATA_TPH::Pressure, 32>,
+		BpRawField<BLUEIO_DATA_TPH, int16_t, &BLUEIO_DATA_TPH::Temperature>,
+		BpField<BLUEIO_DATA_TPH, uint16_t, &BLUEIO_DATA_TPH::Humidity, 16>
+	> TPH_BE;
+	typedef BpLayout<BPENDIAN_BIG,
+		BpArrayField<BLUEIO_DATA_BUT, BLUEIO_BUT_STATE, BLUEIO_BUTTON_ARRAY_MAX, &BLUEIO_DATA_BUT::ButState, 32>
+	> BUT_BE;
+
+	ok &= BigEndianCheck<TPH_BE, BLUEIO_DATA_TPH>("BLUEIO_DATA_TPH");
+	ok &= BigEndianCheck<BUT_BE, BLUEIO_DATA_BUT>("BLUEIO_DATA_BUT", FixBut);
+
+	BLUEIO_DATA_TPH tph = { 0x01020304, 0x0506, 0x0708 };
+	uint8_t buff[TPH_BE::Size];
+	const uint8_t exp[] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	TPH_BE::Pack(tph, buff);
+	bool beok = memcmp(buff, exp, sizeof(exp)) == 0;
+	printf("%-28s : big endian byte order %s\n", "BLUEIO_DATA_TPH", beok ? "PASS" : "FAIL");
+
+	return ok && beok;
+}
+
+// Compact layouts, error must be within half a step, out of range clamped
+static bool CompactCheck()
+{
+	bool ok = true;
+	int terr = 0, perr = 0, herr = 0;
+
+	for (int n = 0; n < NB_CHECK_LOOP; n++)
+	{
+		BLEADV_MANDATA_TPHSENSOR d, r;
+		uint8_t buff[BLEADV_MANDATA_TPHSENSOR_COMPACT::Size];
+
+		d.Temperature = (int16_t)RandRange(-4500, 17000);
+		d.Pressure = (uint32_t)RandRange(25000, 1100000);
+		d.Humidity = (uint16_t)RandRange(0, 12500);
+
+		BLEADV_MANDATA_TPHSENSOR_COMPACT::Pack(d, buff);
+		BLEADV_MANDATA_TPHSENSOR_COMPACT::Unpack(buff, r);
+
+		int32_t t = d.Temperature < -4000 ? -4000 : d.Temperature > 16475 ? 16475 : d.Temperature;
+		int32_t p = d.Pressure < 30000 ? 30000 : d.Pressure > 1078575 ? 1078575 : d.Pressure;
+		int32_t h = d.Humidity > 12285 ? 12285 : d.Humidity;
+
+		terr = std::max(terr, abs(r.Temperature - t));
+		perr = std::max(perr, abs((int32_t)r.Pressure - p));
+		herr = std::max(herr, abs(r.Humidity - h));
+	}
+	ok = terr <= 2 && perr == 0 && herr <= 1;
+	printf("%-28s : %u bytes, max err T %d P %d H %d %s\n", "BLEADV_MANDATA_TPHSENSOR_COMPACT",
+		   BLEADV_MANDATA_TPHSENSOR_COMPACT::Size, terr, perr, herr, ok ? "PASS" : "FAIL");
+
+	bool gok = true;
+	for (int n = 0; n < NB_CHECK_LOOP; n++)
+	{
+		BLUEIO_DATA_GAS d, r;
+		uint8_t buff[BLUEIO_DATA_GAS_COMPACT::Size];
+
+		d.GasRes = (uint32_t)RandRange(0, 0xFFFFFF);
+		d.AirQIdx = (uint16_t)RandRange(0, 511);
+		d.AirQuality = (uint8_t)RandRange(0, 7);
+		BLUEIO_DATA_GAS_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_GAS_COMPACT::Unpack(buff, r);
+		gok &= r.GasRes == d.GasRes && r.AirQIdx == d.AirQIdx && r.AirQuality == d.AirQuality;
+	}
+	printf("%-28s : %u bytes, lossless in range %s\n", "BLUEIO_DATA_GAS_COMPACT",
+		   BLUEIO_DATA_GAS_COMPACT::Size, gok ? "PASS" : "FAIL");
+
+	float verr = 0;
+	bool aok = true;
+	for (int n = 0; n < NB_CHECK_LOOP; n++)
+	{
+		BLUEIO_DATA_ADC d, r;
+		uint8_t buff[BLUEIO_DATA_ADC_COMPACT::Size];
+
+		d.ChanId = RandRange(0, 15);
+		d.Voltage = (float)RandRange(0, 4095000) / 1000000.0f;
+		BLUEIO_DATA_ADC_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_ADC_COMPACT::Unpack(buff, r);
+		aok &= r.ChanId == d.ChanId;
+		verr = std::max(verr, fabsf(r.Voltage - d.Voltage));
+	}
+	// Out of range is clamped
+	{
+		BLUEIO_DATA_ADC d = { 3, 5.0f }, r;
+		uint8_t buff[BLUEIO_DATA_ADC_COMPACT::Size];
+
+		BLUEIO_DATA_ADC_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_ADC_COMPACT::Unpack(buff, r);
+		aok &= fabsf(r.Voltage - 4.095f) < 1e-6f;
+		d.Voltage = -1.0f;
+		BLUEIO_DATA_ADC_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_ADC_COMPACT::Unpack(buff, r);
+		aok &= r.Voltage == 0.0f;
+	}
+	aok &= verr <= 0.0005f + 1e-6f;	// Half step + float rounding
+	printf("%-28s : %u bytes, max err %.6f V %s\n", "BLUEIO_DATA_ADC_COMPACT",
+		   BLUEIO_DATA_ADC_COMPACT::Size, verr, aok ? "PASS" : "FAIL");
+
+	bool bok = true;
+	for (int n = 0; n < NB_CHECK_LOOP; n++)
+	{
+		BLUEIO_DATA_BUT d, r;
+		uint8_t buff[BLUEIO_DATA_BUT_COMPACT::Size];
+
+		FixBut(d);
+		BLUEIO_DATA_BUT_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_BUT_COMPACT::Unpack(buff, r);
+		bok &= memcmp(&d, &r, sizeof(d)) == 0;
+	}
+	printf("%-28s : %u bytes, lossless %s\n", "BLUEIO_DATA_BUT_COMPACT",
+		   BLUEIO_DATA_BUT_COMPACT::Size, bok ? "PASS" : "FAIL");
+
+	int vmax = 0;
+	bool batok = true;
+	for (int n = 0; n < NB_CHECK_LOOP; n++)
+	{
+		BLUEIO_DATA_BAT d, r;
+		uint8_t buff[BLUEIO_DATA_BAT_COMPACT::Size];
+
+		d.Level = (uint8_t)RandRange(0, 100);
+		d.Voltage = RandRange(0, 8190);
+		BLUEIO_DATA_BAT_COMPACT::Pack(d, buff);
+		BLUEIO_DATA_BAT_COMPACT::Unpack(buff, r);
+		batok &= r.Level == d.Level;
+		vmax = std::max(vmax, abs(r.Voltage - d.Voltage));
+	}
+	batok &= vmax <= 1;
+	printf("%-28s : %u bytes, max err %d mV %s\n", "BLUEIO_DATA_BAT_COMPACT",
+		   BLUEIO_DATA_BAT_COMPACT::Size, vmax, batok ? "PASS" : "FAIL");
+
+	return ok && gok && aok && bok && batok;
+}
+
+// Hand written equivalent of BLEADV_MANDATA_TPHSENSOR_COMPACT
+static inline void HandPackTph(const BLEADV_MANDATA_TPHSENSOR &d, uint8_t *p)
+{
+	int32_t t = d.Temperature + 4000;
+	int64_t pr = (int64_t)d.Pressure - 30000;
+	uint32_t h = (d.Humidity + 1) / 3;
+
+	t = t <= 0 ? 0 : (t + 2) / 5;
+	if (t > 0xFFF)
+	{
+		t = 0xFFF;
+	}
+	pr = pr <= 0 ? 0 : pr > 0xFFFFF ? 0xFFFFF : pr;
+	if (h > 0xFFF)
+	{
+		h = 0xFFF;
+	}
+
+	uint64_t acc = (uint64_t)t | ((uint64_t)pr << 12) | ((uint64_t)h << 32);
+
+	p[0] = (uint8_t)acc;
+	p[1] = (uint8_t)(acc >> 8);
+	p[2] = (uint8_t)(acc >> 16);
+	p[3] = (uint8_t)(acc >> 24);
+	p[4] = (uint8_t)(acc >> 32);
+	p[5] = (uint8_t)(acc >> 40);
+}
+
+static inline void HandUnpackTph(const uint8_t *p, BLEADV_MANDATA_TPHSENSOR &d)
+{
+	uint64_t acc = (uint64_t)p[0] | ((uint64_t)p[1] << 8) | ((uint64_t)p[2] << 16) |
+				   ((uint64_t)p[3] << 24) | ((uint64_t)p[4] << 32) | ((uint64_t)p[5] << 40);
+
+	d.Temperature = (int16_t)((acc & 0xFFF) * 5 - 4000);
+	d.Pressure = (uint32_t)((acc >> 12) & 0xFFFFF) + 30000;
+	d.Humidity = (uint16_t)(((acc >> 32) & 0xFFF) * 3);
+}
+
+static BLEADV_MANDATA_TPHSENSOR s_Rec[NB_BENCH_REC];
+static BLEADV_MANDATA_TPHSENSOR s_Out[NB_BENCH_REC];
+static uint8_t s_Packed[NB_BENCH_REC][BLEADV_MANDATA_TPHSENSOR_COMPACT::Size];
+static uint8_t s_HandPacked[NB_BENCH_REC][BLEADV_MANDATA_TPHSENSOR_COMPACT::Size];
+
+static uint32_t Checksum()
+{
+	uint32_t s = 0;
+
+	for (int i = 0; i < NB_BENCH_REC; i++)
+	{
+		s += s_Out[i].Pressure + s_Out[i].Temperature + s_Out[i].Humidity;
+	}
+
+	return s;
+}
+
+static bool SpeedBench()
+{
+	for (int i = 0; i < NB_BENCH_REC; i++)
+	{
+		s_Rec[i].Temperature = (int16_t)RandRange(-4000, 8500);
+		s_Rec[i].Pressure = (uint32_t)RandRange(80000, 110000);
+		s_Rec[i].Humidity = (uint16_t)RandRange(0, 10000);
+	}
+
+	// Warm up caches
+	for (int i = 0; i < NB_BENCH_REC; i++)
+	{
+		HandPackTph(s_Rec[i], s_HandPacked[i]);
+		BLEADV_MANDATA_TPHSENSOR_COMPACT::Pack(s_Rec[i], s_Packed[i]);
+		HandUnpackTph(s_HandPacked[i], s_Out[i]);
+	}
+
+	auto t0 = steady_clock::now();
+	for (int l = 0; l < NB_BENCH_LOOP; l++)
+	{
+		for (int i = 0; i < NB_BENCH_REC; i++)
+		{
+			HandPackTph(s_Rec[i], s_HandPacked[i]);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	auto t1 = steady_clock::now();
+	for (int l = 0; l < NB_BENCH_LOOP; l++)
+	{
+		for (int i = 0; i < NB_BENCH_REC; i++)
+		{
+			BLEADV_MANDATA_TPHSENSOR_COMPACT::Pack(s_Rec[i], s_Packed[i]);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	auto t2 = steady_clock::now();
+	for (int l = 0; l < NB_BENCH_LOOP; l++)
+	{
+		for (int i = 0; i < NB_BENCH_REC; i++)
+		{
+			HandUnpackTph(s_HandPacked[i], s_Out[i]);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	auto t3 = steady_clock::now();
+	uint32_t hsum = Checksum();
+	for (int l = 0; l < NB_BENCH_LOOP; l++)
+	{
+		for (int i = 0; i < NB_BENCH_REC; i++)
+		{
+			BLEADV_MANDATA_TPHSENSOR_COMPACT::Unpack(s_Packed[i], s_Out[i]);
+		}
+		__asm__ volatile("" ::: "memory");
+	}
+	auto t4 = steady_clock::now();
+	uint32_t gsum = Checksum();
+
+	double n = (double)NB_BENCH_LOOP * NB_BENCH_REC;
+	double hp = duration_cast<nanoseconds>(t1 - t0).count() / n;
+	double gp = duration_cast<nanoseconds>(t2 - t1).count() / n;
+	double hu = duration_cast<nanoseconds>(t3 - t2).count() / n;
+	double gu = duration_cast<nanoseconds>(t4 - t3).count() / n;
+	bool same = memcmp(s_Packed, s_HandPacked, sizeof(s_Packed)) == 0 && hsum == gsum;
+
+	printf("\nCompact TPH, %d records x %d\n", NB_BENCH_REC, NB_BENCH_LOOP);
+	printf("  pack   : hand written %.2f ns, generated %.2f ns (x%.2f)\n", hp, gp, gp / hp);
+	printf("  unpack : hand written %.2f ns, generated %.2f ns (x%.2f)\n", hu, gu, gu / hu);
+	printf("  same output %s\n", same ? "PASS" : "FAIL");
+
+	return same;
+}
+
+int main()
+{
+	bool ok = true;
+
+	ok &= FullLayoutCheck();
+	printf("\n");
+	ok &= CompactCheck();
+	ok &= SpeedBench();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
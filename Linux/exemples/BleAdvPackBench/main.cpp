@@ -0,0 +1,389 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	BLE advertising payload packer check & benchmark
+
+Checks field range reduction round trip and clamping for each predefined type,
+that TPH, gas, battery, buttons & accel fit one legacy advertisement, and
+decoding of truncated payloads.
+
+Then simulates a multi-sensor beacon advertising every 100 ms with more readings
+than fit in a legacy advertisement. Reports for each reading how often it is sent
+and how old the receiver's copy is on average & at worst, compared with the
+current one reading per advertisement rotation.
+
+Usage : BleAdvPackBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <chrono>
+
+#include "bluetooth/bleadv_packer.h"
+
+using namespace std::chrono;
+
+#define ADV_INTERVAL_MS		100
+#define NB_ADV				36000		// 1 hour
+#define NB_SPEED_LOOP		200000
+
+// User defined readings
+static const BLEADV_PACK_FIELD s_LightField[] = { { 0, 1, 17 } };			// lux
+static const BLEADV_PACK_FIELD s_Co2Field[] = { { 400, 1, 13 } };			// ppm
+static const BLEADV_PACK_FIELD s_SoundField[] = { { 3000, 10, 10 } };		// 0.01 dB unit
+static const BLEADV_PACK_FIELD s_GyroField[] = {							// 0.1 dps unit
+	{ -20000, 40, 10 }, { -20000, 40, 10 }, { -20000, 40, 10 }
+};
+static const BLEADV_PACK_TYPE s_TypeLight = { BLEADV_PACK_TAG_USER, 1, s_LightField };
+static const BLEADV_PACK_TYPE s_TypeCo2 = { BLEADV_PACK_TAG_USER + 1, 1, s_Co2Field };
+static const BLEADV_PACK_TYPE s_TypeSound = { BLEADV_PACK_TAG_USER + 2, 1, s_SoundField };
+static const BLEADV_PACK_TYPE s_TypeGyro = { BLEADV_PACK_TAG_USER + 3, 3, s_GyroField };
+static const BLEADV_PACK_TYPE s_TypeMag = { BLEADV_PACK_TAG_USER + 4, 3, s_GyroField };
+
+static const BLEADV_PACK_TYPE * const s_AllTypes[] = {
+	&g_BleAdvPackTypeTph, &g_BleAdvPackTypeGas, &g_BleAdvPackTypeBat, &g_BleAdvPackTypeBut,
+	&g_BleAdvPackTypeAccel, &s_TypeLight, &s_TypeCo2, &s_TypeSound, &s_TypeGyro, &s_TypeMag,
+};
+static const int s_NbAllTypes = sizeof(s_AllTypes) / sizeof(s_AllTypes[0]);
+
+static std::mt19937 s_Rng(42);
+
+static int32_t RandRange(int32_t Min, int32_t Max)
+{
+	std::uniform_int_distribution<int32_t> d(Min, Max);
+	return d(s_Rng);
+}
+
+static bool RoundTripCheck()
+{
+	bool ok = true;
+
+	for (int t = 0; t < s_NbAllTypes; t++)
+	{
+		const BLEADV_PACK_TYPE *type = s_AllTypes[t];
+		BLEADV_PACK_SLOT slot = { type, 1, 0 };
+		BLEADV_PACKER packer;
+		int maxerr = 0, clamperr = 0;
+
+		BleAdvPackInit(&packer, &slot, 1);
+
+		for (int n = 0; n < 10000; n++)
+		{
+			int32_t val[BLEADV_PACK_FIELD_MAX], exp[BLEADV_PACK_FIELD_MAX];
+			uint8_t buff[BLEADV_PACK_LEGACY_LEN];
+			BLEADV_PACK_READING rd;
+
+			for (int i = 0; i < type->NbField; i++)
+			{
+				const BLEADV_PACK_FIELD *f = &type->pField[i];
+				int64_t max = f->Min + (int64_t)f->Step * ((1LL << f->NbBits) - 1);
+
+				// 10% of values out of range to check clamping
+				val[i] = RandRange(f->Min - (int32_t)(max - f->Min) / 20, (int32_t)(max + (max - f->Min) / 20));
+				exp[i] = val[i] < f->Min ? f->Min : val[i] > max ? (int32_t)max : val[i];
+			}
+			BleAdvPackUpdate(&packer, 0, val, n);
+
+			int len = BleAdvPackBuild(&packer, buff, sizeof(buff), n);
+			if (BleAdvPackDecode(buff, len, s_AllTypes, s_NbAllTypes, &rd, 1, NULL) != 1 || rd.Tag != type->Tag)
+			{
+				printf("Tag %d decode failed\n", type->Tag);
+				return false;
+			}
+			for (int i = 0; i < type->NbField; i++)
+			{
+				int err = abs(rd.Val[i] - exp[i]);
+				if (err > (int)type->pField[i].Step / 2)
+				{
+					clamperr++;
+				}
+				maxerr = err > maxerr ? err : maxerr;
+			}
+		}
+		printf("  tag %2d : %3d bits, max error %3d (step %3u), %s\n", type->Tag, BleAdvPackTypeBits(type),
+			   maxerr, type->pField[0].Step, clamperr ? "FAIL" : "PASS");
+		ok &= clamperr == 0;
+	}
+
+	return ok;
+}
+
+static bool LegacyFitCheck()
+{
+	BLEADV_PACK_SLOT slot[] = {
+		{ &g_BleAdvPackTypeTph, 1, 0 }, { &g_BleAdvPackTypeGas, 1, 0 }, { &g_BleAdvPackTypeBat, 1, 0 },
+		{ &g_BleAdvPackTypeBut, 1, 0 }, { &g_BleAdvPackTypeAccel, 1, 0 },
+	};
+	int32_t v[][BLEADV_PACK_FIELD_MAX] = {
+		{ 2315, 101324, 4550 }, { 125056, 42 }, { 87, 3950 }, { 0x5 }, { -16, 32, 1008 }
+	};
+	BLEADV_PACKER packer;
+	BLEADV_PACK_READING rd[8];
+	uint8_t buff[BLEADV_PACK_LEGACY_LEN];
+
+	BleAdvPackInit(&packer, slot, 5);
+	for (int i = 0; i < 5; i++)
+	{
+		BleAdvPackUpdate(&packer, i, v[i], 0);
+	}
+
+	int len = BleAdvPackBuild(&packer, buff, sizeof(buff), 1);
+	int n = BleAdvPackDecode(buff, len, NULL, 0, rd, 8, NULL);
+	bool ok = n == 5;
+
+	for (int i = 0; i < n && ok; i++)
+	{
+		for (int j = 0; j < 5; j++)
+		{
+			if (rd[i].Tag == slot[j].pType->Tag)
+			{
+				ok &= memcmp(rd[i].Val, v[j], slot[j].pType->NbField * sizeof(int32_t)) == 0;
+			}
+		}
+	}
+
+	// Truncated payload must only return complete readings
+	int nt = BleAdvPackDecode(buff, len - 3, NULL, 0, rd, 8, NULL);
+	ok &= nt >= 0 && nt < n;
+
+	printf("  TPH + gas + battery + buttons + accel : %d bytes of %d, %d readings, truncated %d, %s\n",
+		   len, BLEADV_PACK_LEGACY_LEN, n, nt, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+typedef struct {
+	const char *pName;
+	uint32_t UpdatePeriod;		// ms, 0 random events
+	uint8_t Priority;
+} SENSOR;
+
+static const SENSOR s_Sensors[] = {
+	{ "TPH", 1000, 2 }, { "Gas", 3000, 1 }, { "Battery", 60000, 1 }, { "Buttons", 0, 8 },
+	{ "Accel", 100, 4 }, { "Light", 200, 2 }, { "CO2", 2000, 1 }, { "Sound", 100, 2 }, { "Gyro", 100, 4 },
+	{ "Mag", 100, 3 },
+};
+static const int s_NbSensors = sizeof(s_Sensors) / sizeof(s_Sensors[0]);
+
+typedef struct {
+	uint32_t UpdCnt;			// Number of new values
+	uint32_t LostCnt;			// Values replaced before being sent
+	double DelaySum;			// Update to reception delay of received values
+	uint32_t DelayMax;
+} STAT;
+
+static void Receive(STAT &Stat, bool &bPending, uint32_t Delay)
+{
+	if (bPending)
+	{
+		Stat.DelaySum += Delay;
+		Stat.DelayMax = Delay > Stat.DelayMax ? Delay : Stat.DelayMax;
+		bPending = false;
+	}
+}
+
+static void RandomReading(const BLEADV_PACK_TYPE *pType, int32_t *pVal)
+{
+	for (int i = 0; i < pType->NbField; i++)
+	{
+		const BLEADV_PACK_FIELD *f = &pType->pField[i];
+		pVal[i] = f->Min + RandRange(0, (1 << (f->NbBits > 20 ? 20 : f->NbBits)) - 1) * (int32_t)f->Step;
+	}
+}
+
+/// Run beacon. Returns average update to reception delay over all readings in ms
+static double Beacon(bool bPacked, int Budget, STAT *pStat)
+{
+	BLEADV_PACK_SLOT slot[s_NbSensors];
+	BLEADV_PACKER packer;
+	bool pending[s_NbSensors];			// Receiver does not have last value
+	int rr = 0;
+
+	memset(pStat, 0, sizeof(STAT) * s_NbSensors);
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		slot[i].pType = s_AllTypes[i];
+		slot[i].Priority = s_Sensors[i].Priority;
+		slot[i].MaxAge = 0;
+		pending[i] = false;
+	}
+	BleAdvPackInit(&packer, slot, s_NbSensors);
+
+	for (uint32_t n = 1; n <= NB_ADV; n++)
+	{
+		uint32_t t = n * ADV_INTERVAL_MS;
+
+		for (int i = 0; i < s_NbSensors; i++)
+		{
+			bool upd = s_Sensors[i].UpdatePeriod ? (t % s_Sensors[i].UpdatePeriod) == 0 : RandRange(0, 99) == 0;
+			if (upd || slot[i].bValid == false)
+			{
+				int32_t v[BLEADV_PACK_FIELD_MAX];
+				RandomReading(slot[i].pType, v);
+				BleAdvPackUpdate(&packer, i, v, t);
+				pStat[i].UpdCnt++;
+				if (pending[i])
+				{
+					pStat[i].LostCnt++;
+				}
+				pending[i] = true;
+			}
+		}
+
+		if (bPacked)
+		{
+			uint8_t buff[BLEADV_PACK_EXT_LEN];
+			BLEADV_PACK_READING rd[16];
+			int len = BleAdvPackBuild(&packer, buff, Budget, t);
+			int cnt = BleAdvPackDecode(buff, len, s_AllTypes, s_NbAllTypes, rd, 16, NULL);
+
+			for (int r = 0; r < cnt; r++)
+			{
+				for (int i = 0; i < s_NbSensors; i++)
+				{
+					if (s_AllTypes[i]->Tag == rd[r].Tag)
+					{
+						Receive(pStat[i], pending[i], t - slot[i].UpdateTime);
+					}
+				}
+			}
+		}
+		else
+		{
+			// One reading per advertisement, rotating types
+			Receive(pStat[rr], pending[rr], t - slot[rr].UpdateTime);
+			rr = (rr + 1) % s_NbSensors;
+		}
+	}
+
+	double total = 0;
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		total += pStat[i].DelaySum / (pStat[i].UpdCnt - pStat[i].LostCnt);
+	}
+
+	return total / s_NbSensors;
+}
+
+static void SchedulerBench()
+{
+	STAT rot[s_NbSensors], leg[s_NbSensors], ext[s_NbSensors];
+	int bits = 0;
+
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		bits += BleAdvPackTypeBits(s_AllTypes[i]);
+	}
+
+	printf("\n%d readings, %d bytes packed, advertising every %d ms\n", s_NbSensors,
+		   BLEADV_PACK_HDR_LEN + (bits + 7) / 8, ADV_INTERVAL_MS);
+
+	double arot = Beacon(false, 0, rot);
+	double aleg = Beacon(true, BLEADV_PACK_LEGACY_LEN, leg);
+	double aext = Beacon(true, BLEADV_PACK_EXT_LEN, ext);
+
+	printf("  %-8s %5s %4s | %-22s | %-22s | %-22s\n", "", "upd", "prio", "rotation 1/adv",
+		   "packed legacy 31 B", "packed extended");
+	printf("  %-8s %5s %4s | %6s %7s %7s | %6s %7s %7s | %6s %7s %7s\n", "reading", "ms", "", "rx%",
+		   "delay", "max", "rx%", "delay", "max", "rx%", "delay", "max");
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		STAT *st[3] = { &rot[i], &leg[i], &ext[i] };
+
+		printf("  %-8s %5u %4u", s_Sensors[i].pName, s_Sensors[i].UpdatePeriod, s_Sensors[i].Priority);
+		for (int k = 0; k < 3; k++)
+		{
+			uint32_t rx = st[k]->UpdCnt - st[k]->LostCnt;
+			printf(" | %5.1f%% %5.0fms %5ums", 100.0 * rx / st[k]->UpdCnt, st[k]->DelaySum / rx, st[k]->DelayMax);
+		}
+		printf("\n");
+	}
+	printf("  rx%% : values received before being replaced, delay : update to reception\n");
+	printf("  average delay : rotation %.0f ms, packed legacy %.0f ms, packed extended %.0f ms\n",
+		   arot, aleg, aext);
+}
+
+static void SpeedBench()
+{
+	BLEADV_PACK_SLOT slot[s_NbSensors];
+	BLEADV_PACKER packer;
+	uint8_t buff[BLEADV_PACK_LEGACY_LEN];
+	BLEADV_PACK_READING rd[16];
+	int len = 0, cnt = 0;
+
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		slot[i].pType = s_AllTypes[i];
+		slot[i].Priority = s_Sensors[i].Priority;
+		slot[i].MaxAge = 0;
+	}
+	BleAdvPackInit(&packer, slot, s_NbSensors);
+	for (int i = 0; i < s_NbSensors; i++)
+	{
+		int32_t v[BLEADV_PACK_FIELD_MAX];
+		RandomReading(s_AllTypes[i], v);
+		BleAdvPackUpdate(&packer, i, v, 0);
+	}
+
+	auto t0 = high_resolution_clock::now();
+	for (int n = 0; n < NB_SPEED_LOOP; n++)
+	{
+		len = BleAdvPackBuild(&packer, buff, sizeof(buff), n);
+	}
+	auto t1 = high_resolution_clock::now();
+	for (int n = 0; n < NB_SPEED_LOOP; n++)
+	{
+		cnt += BleAdvPackDecode(buff, len, s_AllTypes, s_NbAllTypes, rd, 16, NULL);
+	}
+	auto t2 = high_resolution_clock::now();
+
+	printf("\nBuild %.0f ns, decode %.0f ns per legacy advertisement (%d readings)\n",
+		   (double)duration_cast<nanoseconds>(t1 - t0).count() / NB_SPEED_LOOP,
+		   (double)duration_cast<nanoseconds>(t2 - t1).count() / NB_SPEED_LOOP, cnt / NB_SPEED_LOOP);
+}
+
+int main()
+{
+	bool ok = true;
+
+	printf("Round trip\n");
+	ok &= RoundTripCheck();
+	ok &= LegacyFitCheck();
+
+	SchedulerBench();
+	SpeedBench();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
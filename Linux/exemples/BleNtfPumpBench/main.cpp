@@ -0,0 +1,316 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	BLE notification pump benchmark
+
+Streams 12 bytes IMU samples through a simulated BLE stack and compares
+the notification pump against the previous BleIntrf Tx path, one notification per
+write chopped at the Tx FIFO block size with a TransBuff copy on queue full.
+Both get the same Tx memory. Reports dropped samples, packets per connection
+event, payload per packet, throughput & sample latency. The received stream is
+checked against the accepted samples.
+
+Usage : BleNtfPumpBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <deque>
+
+#include "cfifo.h"
+#include "ble_stack_sim.h"
+#include "bluetooth/ble_ntfpump.h"
+
+#define SAMPLE_SIZE			12
+#define TX_MEM_SIZE			2048
+#define RUN_TIME_US			10000000ULL
+
+/// Tx path under test
+class TxPath {
+public:
+	virtual ~TxPath() {}
+	virtual bool RequestToSend(int NbBytes) = 0;
+	virtual int TxData(uint8_t *pData, int DataLen) = 0;
+	virtual void TxComplete(int Count) = 0;
+};
+
+/// Previous BleIntrf Tx path : CFIFO of fixed size packets + TransBuff
+class LegacyTxPath : public TxPath {
+public:
+	LegacyTxPath(BleStackSim &Stack, int PacketSize) : vStack(Stack), vPacketSize(PacketSize) {
+		vhTxFifo = CFifoInit(vMem, TX_MEM_SIZE, PacketSize, true);
+		vTransBuffLen = 0;
+	}
+	void Notify() {
+		BLENTFPUMP_SENDRES res = BLENTFPUMP_SENDRES_OK;
+
+		if (vTransBuffLen > 0)
+		{
+			res = vStack.Notify(vTransBuff, vTransBuffLen);
+		}
+		if (res != BLENTFPUMP_SENDRES_BUSY)
+		{
+			vTransBuffLen = 0;
+			uint8_t *p;
+			while ((p = CFifoGet(vhTxFifo)) != NULL)
+			{
+				uint16_t len;
+				memcpy(&len, p, 2);
+				if (vStack.Notify(p + 2, len) == BLENTFPUMP_SENDRES_BUSY)
+				{
+					memcpy(vTransBuff, p + 2, len);
+					vTransBuffLen = len;
+					break;
+				}
+			}
+		}
+	}
+	virtual bool RequestToSend(int NbBytes) {
+		Notify();
+		return CFifoAvail(vhTxFifo) * vPacketSize > NbBytes;
+	}
+	virtual int TxData(uint8_t *pData, int DataLen) {
+		int maxlen = vhTxFifo->BlkSize - 2;
+		int cnt = 0;
+
+		while (DataLen > 0)
+		{
+			uint8_t *p = CFifoPut(vhTxFifo);
+			if (p == NULL)
+				break;
+			uint16_t l = DataLen < maxlen ? DataLen : maxlen;
+			memcpy(p, &l, 2);
+			memcpy(p + 2, pData, l);
+			DataLen -= l;
+			pData += l;
+			cnt += l;
+		}
+		Notify();
+
+		return cnt;
+	}
+	virtual void TxComplete(int Count) { Notify(); }
+
+private:
+	BleStackSim &vStack;
+	int vPacketSize;
+	HCFIFO vhTxFifo;
+	alignas(4) uint8_t vMem[TX_MEM_SIZE];
+	uint8_t vTransBuff[512];
+	int vTransBuffLen;
+};
+
+/// Notification pump Tx path
+class PumpTxPath : public TxPath {
+public:
+	PumpTxPath(BleStackSim &Stack, int MaxPayload) {
+		BLENTFPUMP_CFG cfg;
+
+		cfg.pMem = vMem;
+		cfg.MemSize = TX_MEM_SIZE;
+		cfg.MaxPayload = MaxPayload;
+		cfg.PartialInFlight = 1;
+		cfg.SendCB = BleStackSim::SendCB;
+		cfg.pCtx = &Stack;
+		BleNtfPumpInit(&vPump, &cfg);
+		BleNtfPumpSetMtu(&vPump, Stack.AttMtu());
+	}
+	virtual bool RequestToSend(int NbBytes) {
+		BleNtfPumpProcess(&vPump);
+		return BleNtfPumpAvail(&vPump) > NbBytes;
+	}
+	virtual int TxData(uint8_t *pData, int DataLen) { return BleNtfPumpWrite(&vPump, pData, DataLen); }
+	virtual void TxComplete(int Count) { BleNtfPumpTxComplete(&vPump, Count); }
+	void SetMtu(uint16_t Mtu) { BleNtfPumpSetMtu(&vPump, Mtu); }
+
+private:
+	alignas(4) uint8_t vMem[TX_MEM_SIZE];
+	BLENTFPUMP vPump;
+};
+
+typedef struct {
+	const char *pName;
+	BLESTACKSIM_CFG Stack;
+	uint32_t SampleRate;	// Hz
+} SCENARIO;
+
+static const SCENARIO s_Scenarios[] = {
+	{ "MTU 23, 7.5 ms, 1 kHz", { 7500, 6, 6, 23 }, 1000 },
+	{ "MTU 23, 15 ms, 500 Hz", { 15000, 4, 4, 23 }, 500 },
+	{ "MTU 247, 7.5 ms, 1 kHz", { 7500, 3, 6, 247 }, 1000 },
+	{ "MTU 247, 30 ms, 3.2 kHz", { 30000, 6, 6, 247 }, 3200 },
+};
+
+static bool Run(BleStackSim &Stack, TxPath &Path, uint32_t SampleRate, const char *pName)
+{
+	std::vector<uint8_t> expected;
+	std::deque<std::pair<size_t, uint64_t> > inflight;	// end offset, production time
+	uint64_t period = 1000000ULL / SampleRate;
+	uint64_t tsample = 0;
+	uint32_t seq = 0, drop = 0;
+	uint64_t latsum = 0, latmax = 0, latcnt = 0;
+	size_t rxrun = 0;
+
+	while (Stack.usTime() < RUN_TIME_US || (Stack.RxData().size() < expected.size() && Stack.usTime() < 2 * RUN_TIME_US))
+	{
+		uint64_t tevt = Stack.usTime() + Stack.ConnIntervalUs();
+
+		while (tsample < tevt && tsample < RUN_TIME_US)
+		{
+			uint8_t d[SAMPLE_SIZE];
+
+			memcpy(d, &seq, 4);
+			for (int i = 4; i < SAMPLE_SIZE; i++)
+			{
+				d[i] = (uint8_t)(seq * 7 + i);
+			}
+			seq++;
+
+			if (Path.RequestToSend(SAMPLE_SIZE) && Path.TxData(d, SAMPLE_SIZE) == SAMPLE_SIZE)
+			{
+				expected.insert(expected.end(), d, d + SAMPLE_SIZE);
+				inflight.push_back(std::make_pair(expected.size(), tsample));
+			}
+			else
+			{
+				drop++;
+			}
+			tsample += period;
+		}
+
+		int n = Stack.ConnEvent();
+		Path.TxComplete(n);
+
+		while (inflight.empty() == false && inflight.front().first <= Stack.RxData().size())
+		{
+			uint64_t lat = Stack.usTime() - inflight.front().second;
+			latsum += lat;
+			latmax = lat > latmax ? lat : latmax;
+			latcnt++;
+			inflight.pop_front();
+		}
+		if (Stack.usTime() <= RUN_TIME_US)
+		{
+			rxrun = Stack.RxData().size();
+		}
+	}
+
+	bool ok = Stack.RxData().size() == expected.size() &&
+			  memcmp(Stack.RxData().data(), expected.data(), expected.size()) == 0;
+
+	printf("  %-7s drop %5.1f%%  pkt %6u  pkt/evt %4.2f  bytes/pkt %5.1f  %6.2f kB/s  lat avg %6.2f ms max %6.2f ms  %s\n",
+		   pName, 100.0 * drop / seq, Stack.PktCount(),
+		   Stack.ActiveEvtCount() ? (double)Stack.PktCount() / Stack.ActiveEvtCount() : 0.0,
+		   Stack.PktCount() ? (double)Stack.RxData().size() / Stack.PktCount() : 0.0,
+		   rxrun * 1000.0 / RUN_TIME_US, latcnt ? latsum / 1000.0 / latcnt : 0.0, latmax / 1000.0,
+		   ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Packets queued at MTU 247 must still go out after MTU drops to 23
+static bool MtuShrink()
+{
+	BleStackSim stack;
+	BLESTACKSIM_CFG cfg = { 7500, 6, 1, 247 };
+
+	// Stack holds 1 packet, the rest stays in the pump at 244 bytes payload
+	stack.Init(cfg);
+
+	PumpTxPath *pump = new PumpTxPath(stack, 244);
+	std::vector<uint8_t> expected;
+
+	for (int i = 0; i < 1500; i++)
+	{
+		uint8_t d = (uint8_t)(i * 13);
+
+		if (pump->TxData(&d, 1) == 1)
+		{
+			expected.push_back(d);
+		}
+	}
+
+	stack.AttMtu(23);
+	pump->SetMtu(23);
+
+	for (int i = 0; i < 200 && stack.RxData().size() < expected.size(); i++)
+	{
+		pump->TxComplete(stack.ConnEvent());
+		pump->RequestToSend(0);
+	}
+
+	bool ok = stack.RxData() == expected && stack.RejectCount() == 0;
+
+	printf("MTU 247 -> 23 with %u bytes queued : %u bytes received, %u rejected  %s\n\n",
+		   (unsigned)expected.size(), (unsigned)stack.RxData().size(), stack.RejectCount(), ok ? "PASS" : "FAIL");
+	delete pump;
+
+	return ok;
+}
+
+int main()
+{
+	bool ok = true;
+
+	printf("BLE notification pump, %d bytes samples, %d bytes Tx memory\n\n", SAMPLE_SIZE, TX_MEM_SIZE);
+
+	for (size_t i = 0; i < sizeof(s_Scenarios) / sizeof(s_Scenarios[0]); i++)
+	{
+		const SCENARIO &s = s_Scenarios[i];
+		int payload = s.Stack.AttMtu - BLENTFPUMP_ATT_HDR_LEN;
+
+		printf("%s, %d pkt/evt, queue %d, offered %.2f kB/s\n", s.pName, s.Stack.PktPerEvt,
+			   s.Stack.QueueDepth, s.SampleRate * SAMPLE_SIZE / 1000.0);
+		{
+			BleStackSim stack;
+			stack.Init(s.Stack);
+			LegacyTxPath *legacy = new LegacyTxPath(stack, payload + 2);
+			ok &= Run(stack, *legacy, s.SampleRate, "legacy");
+			delete legacy;
+		}
+		{
+			BleStackSim stack;
+			stack.Init(s.Stack);
+			PumpTxPath *pump = new PumpTxPath(stack, payload);
+			ok &= Run(stack, *pump, s.SampleRate, "pump");
+			delete pump;
+		}
+		printf("\n");
+	}
+
+	ok &= MtuShrink();
+
+	printf("%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,676 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	BLE scan filter engine replay check & benchmark
+
+Generates a synthetic advertising flood from a dense beacon deployment :
+iBeacons, Eddystone beacons, I-SYST sensor tags whose readings change, and
+other vendor devices with rotating payloads. Reports are replayed through the
+scan filter engine with a flush every 100 ms, as a gateway main loop would.
+
+Checks that only matching devices are delivered, that every matching device is
+delivered, and that the last payload of each device is the last one delivered.
+Reports how many records reach the application compared to one callback per
+report, and the engine throughput in reports/sec compared to a plain per report
+filter & device list search done in the application.
+
+Usage : BleScanFltBench [NbDevice] [Seconds]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <queue>
+#include <random>
+#include <chrono>
+
+#include "istddef.h"
+#include "bluetooth/ble_scanflt.h"
+
+using namespace std;
+using namespace std::chrono;
+
+#define FLUSH_PERIOD_MS		100
+#define MIN_RSSI			-90
+#define DEV_TBL_SIZE		2048
+#define BATCH_SIZE			32
+#define NB_ADDR_FILTER		10
+
+typedef enum {
+	DEVCLASS_IBEACON,
+	DEVCLASS_EDDYSTONE,
+	DEVCLASS_ISYST,
+	DEVCLASS_OTHER,
+} DEVCLASS;
+
+typedef struct {
+	uint8_t Addr[6];
+	DEVCLASS Class;
+	uint32_t Interval;		// Advertising interval in msec
+	int BaseRssi;
+	uint32_t NextChange;	// Sensor reading change time
+	uint8_t Data[31];
+	uint8_t Len;
+	bool bAddrFilter;
+} SIMDEV;
+
+typedef struct {
+	uint32_t Time;
+	uint32_t Dev;
+	int8_t Rssi;
+	uint8_t Len;
+	uint8_t Data[31];
+} SIMRPT;
+
+static std::mt19937 s_Rng(1234);
+static vector<SIMDEV> s_Dev;
+static vector<SIMRPT> s_Rpt;
+
+static const uint8_t s_IBeaconUuid[16] = {
+	0xE2, 0xC5, 0x6D, 0xB5, 0xDF, 0xFB, 0x48, 0xD2, 0xB0, 0x60, 0xD0, 0xF5, 0xA7, 0x10, 0x96, 0xE0
+};
+
+static int RandRange(int Min, int Max)
+{
+	uniform_int_distribution<int> d(Min, Max);
+	return d(s_Rng);
+}
+
+static void BuildPayload(SIMDEV &d, uint32_t Time)
+{
+	uint8_t *p = d.Data;
+
+	// Flags
+	*p++ = 2; *p++ = 0x01; *p++ = 0x06;
+
+	switch (d.Class)
+	{
+		case DEVCLASS_IBEACON:
+			*p++ = 0x1A; *p++ = 0xFF; *p++ = 0x4C; *p++ = 0x00; *p++ = 0x02; *p++ = 0x15;
+			memcpy(p, s_IBeaconUuid, 16); p += 16;
+			*p++ = d.Addr[1]; *p++ = d.Addr[0];		// Major
+			*p++ = d.Addr[3]; *p++ = d.Addr[2];		// Minor
+			*p++ = 0xC5;
+			break;
+		case DEVCLASS_EDDYSTONE:
+			*p++ = 3; *p++ = 0x03; *p++ = 0xAA; *p++ = 0xFE;
+			*p++ = 14; *p++ = 0x16; *p++ = 0xAA; *p++ = 0xFE; *p++ = 0x10; *p++ = 0xEB;
+			*p++ = 0x03; memcpy(p, "i-syst", 6); p += 6; *p++ = 0x07;
+			*p++ = d.Addr[0]; *p++ = d.Addr[1];
+			break;
+		case DEVCLASS_ISYST:
+			// Manufacturer data : company ID, BLEADV_MANDATA type TPH + reading
+			*p++ = 12; *p++ = 0xFF;
+			*p++ = ISYST_BLUETOOTH_ID & 0xFF; *p++ = ISYST_BLUETOOTH_ID >> 8;
+			*p++ = 1;
+			for (int i = 0; i < 8; i++)
+			{
+				*p++ = (uint8_t)RandRange(0, 255);
+			}
+			break;
+		case DEVCLASS_OTHER:
+		{
+			// Rotating payload, different on every advertisement
+			int n = RandRange(4, 20);
+			uint16_t cid = (uint16_t)RandRange(0x0002, 0x0FFF);
+
+			cid = cid == ISYST_BLUETOOTH_ID ? 0x004C : cid;
+			*p++ = n + 3; *p++ = 0xFF; *p++ = cid & 0xFF; *p++ = cid >> 8;
+			for (int i = 0; i < n; i++)
+			{
+				*p++ = (uint8_t)RandRange(0, 255);
+			}
+			break;
+		}
+	}
+	d.Len = p - d.Data;
+}
+
+static bool DevMatch(const SIMDEV &d)
+{
+	return d.Class == DEVCLASS_EDDYSTONE || d.Class == DEVCLASS_ISYST || d.bAddrFilter;
+}
+
+static void GenerateFlood(int NbDev, uint32_t Duration)
+{
+	typedef pair<uint32_t, uint32_t> EVT;	// time, device
+	priority_queue<EVT, vector<EVT>, greater<EVT> > q;
+	normal_distribution<double> noise(0.0, 4.0);
+	int naddr = 0;
+
+	s_Dev.resize(NbDev);
+	for (int i = 0; i < NbDev; i++)
+	{
+		SIMDEV &d = s_Dev[i];
+		int r = RandRange(0, 99);
+
+		for (int j = 0; j < 6; j++)
+		{
+			d.Addr[j] = (uint8_t)RandRange(0, 255);
+		}
+		d.Addr[5] |= 0xC0;		// Random static
+		d.Class = r < 35 ? DEVCLASS_IBEACON : r < 50 ? DEVCLASS_EDDYSTONE : r < 70 ? DEVCLASS_ISYST : DEVCLASS_OTHER;
+		d.Interval = RandRange(100, 1000);
+		d.BaseRssi = RandRange(-95, -45);
+		d.NextChange = RandRange(5000, 15000);
+		d.bAddrFilter = d.Class == DEVCLASS_IBEACON && naddr < NB_ADDR_FILTER && ++naddr > 0;
+		BuildPayload(d, 0);
+		q.push(EVT(RandRange(0, d.Interval), i));
+	}
+
+	while (q.empty() == false && q.top().first < Duration)
+	{
+		EVT e = q.top();
+		SIMDEV &d = s_Dev[e.second];
+
+		q.pop();
+		q.push(EVT(e.first + d.Interval + RandRange(0, 10), e.second));	// + advDelay
+
+		if (d.Class == DEVCLASS_OTHER || (d.Class == DEVCLASS_ISYST && e.first >= d.NextChange))
+		{
+			BuildPayload(d, e.first);
+			d.NextChange = e.first + RandRange(5000, 15000);
+		}
+
+		// Scanner misses 20% of advertisements
+		if (RandRange(0, 99) < 20)
+		{
+			continue;
+		}
+
+		SIMRPT r;
+		int rssi = d.BaseRssi + (int)noise(s_Rng);
+
+		r.Time = e.first;
+		r.Dev = e.second;
+		r.Rssi = (int8_t)(rssi < -127 ? -127 : rssi > 0 ? 0 : rssi);
+		r.Len = d.Len;
+		memcpy(r.Data, d.Data, d.Len);
+		s_Rpt.push_back(r);
+	}
+}
+
+// Delivery tracking
+typedef struct {
+	int DlvCnt;
+	uint8_t LastData[31];
+	uint8_t LastLen;
+	int AcceptCnt;				// Reports passing filter & RSSI
+	uint8_t LastAccept[31];
+	uint8_t LastAcceptLen;
+} DEVTRACK;
+
+static vector<DEVTRACK> s_Track;
+static int s_UnknownDlv = 0;
+static int s_NoMatchDlv = 0;
+static int s_BatchCnt = 0;
+
+static int FindDev(const uint8_t *pAddr)
+{
+	// Devices addresses are random, match on full address by scan
+	for (size_t i = 0; i < s_Dev.size(); i++)
+	{
+		if (memcmp(s_Dev[i].Addr, pAddr, 6) == 0)
+		{
+			return (int)i;
+		}
+	}
+
+	return -1;
+}
+
+static void DevHandler(void *pCtx, const BLESCANFLT_DEV *pDev, int Count)
+{
+	s_BatchCnt++;
+
+	for (int i = 0; i < Count; i++)
+	{
+		int n = FindDev(pDev[i].Addr);
+
+		if (n < 0)
+		{
+			s_UnknownDlv++;
+			continue;
+		}
+		if (DevMatch(s_Dev[n]) == false)
+		{
+			s_NoMatchDlv++;
+		}
+		s_Track[n].DlvCnt++;
+		s_Track[n].LastLen = pDev[i].Len;
+		memcpy(s_Track[n].LastData, pDev[i].Data, pDev[i].Len);
+	}
+}
+
+static void NullHandler(void *pCtx, const BLESCANFLT_DEV *pDev, int Count)
+{
+	*(int*)pCtx += Count;
+}
+
+static const BLESCANFLT_FILTER *BuildFilter(int &NbFilter)
+{
+	static BLESCANFLT_FILTER flt[BLESCANFLT_FILTER_MAX];
+	int n = 0;
+
+	memset(flt, 0, sizeof(flt));
+	flt[n].Type = BLESCANFLT_TYPE_MANDATA;
+	flt[n].Len = 2;
+	flt[n].Data[0] = ISYST_BLUETOOTH_ID & 0xFF;
+	flt[n].Data[1] = ISYST_BLUETOOTH_ID >> 8;
+	n++;
+	flt[n].Type = BLESCANFLT_TYPE_UUID16;
+	flt[n].Len = 2;
+	flt[n].Data[0] = 0xAA;
+	flt[n].Data[1] = 0xFE;
+	n++;
+	for (size_t i = 0; i < s_Dev.size(); i++)
+	{
+		if (s_Dev[i].bAddrFilter)
+		{
+			flt[n].Type = BLESCANFLT_TYPE_ADDR;
+			flt[n].Len = 6;
+			memcpy(flt[n].Data, s_Dev[i].Addr, 6);
+			n++;
+		}
+	}
+	NbFilter = n;
+
+	return flt;
+}
+
+static BLESCANFLT s_Flt;
+static BLESCANFLT_DEV s_DevTbl[DEV_TBL_SIZE];
+static uint16_t s_DevQue[DEV_TBL_SIZE];
+static BLESCANFLT_DEV s_Batch[BATCH_SIZE];
+
+static bool InitEngine(BLESCANFLT_EVTCB EvtCB, void *pCtx)
+{
+	BLESCANFLT_CFG cfg;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.pFilter = BuildFilter(cfg.NbFilter);
+	cfg.MinRssi = MIN_RSSI;
+	cfg.DedupWindow = 5000;
+	cfg.RssiDelta = 6;
+	cfg.RssiShift = 2;
+	cfg.pDevTbl = s_DevTbl;
+	cfg.pQue = s_DevQue;
+	cfg.NbDev = DEV_TBL_SIZE;
+	cfg.pBatch = s_Batch;
+	cfg.BatchSize = BATCH_SIZE;
+	cfg.EvtCB = EvtCB;
+	cfg.pCtx = pCtx;
+
+	return BleScanFltInit(&s_Flt, &cfg);
+}
+
+static inline void MakeReport(const SIMRPT &r, BLESCANFLT_REPORT &Rpt)
+{
+	memcpy(Rpt.Addr, s_Dev[r.Dev].Addr, 6);
+	Rpt.AddrType = 1;
+	Rpt.Rssi = r.Rssi;
+	Rpt.pData = r.Data;
+	Rpt.Len = r.Len;
+}
+
+static bool ReplayCheck(uint32_t Duration)
+{
+	uint32_t nextflush = FLUSH_PERIOD_MS;
+
+	s_Track.assign(s_Dev.size(), DEVTRACK());
+	if (InitEngine(DevHandler, NULL) == false)
+	{
+		printf("Init failed\n");
+		return false;
+	}
+
+	for (size_t i = 0; i < s_Rpt.size(); i++)
+	{
+		const SIMRPT &r = s_Rpt[i];
+		BLESCANFLT_REPORT rpt;
+
+		while (r.Time >= nextflush)
+		{
+			BleScanFltFlush(&s_Flt, nextflush);
+			nextflush += FLUSH_PERIOD_MS;
+		}
+
+		MakeReport(r, rpt);
+		BleScanFltPut(&s_Flt, &rpt);
+
+		if (DevMatch(s_Dev[r.Dev]) && r.Rssi >= MIN_RSSI)
+		{
+			DEVTRACK &t = s_Track[r.Dev];
+
+			t.AcceptCnt++;
+			t.LastAcceptLen = r.Len;
+			memcpy(t.LastAccept, r.Data, r.Len);
+		}
+	}
+	BleScanFltFlush(&s_Flt, Duration);
+
+	int nmatch = 0, nseen = 0, nmissed = 0, nstale = 0, dlv = 0, ichange = 0;
+
+	for (size_t i = 0; i < s_Dev.size(); i++)
+	{
+		DEVTRACK &t = s_Track[i];
+
+		dlv += t.DlvCnt;
+		if (DevMatch(s_Dev[i]) == false)
+		{
+			continue;
+		}
+		nmatch++;
+		if (t.AcceptCnt == 0)
+		{
+			continue;
+		}
+		nseen++;
+		if (t.DlvCnt == 0)
+		{
+			nmissed++;
+		}
+		else if (t.LastLen != t.LastAcceptLen || memcmp(t.LastData, t.LastAccept, t.LastLen) != 0)
+		{
+			nstale++;
+		}
+		if (s_Dev[i].Class == DEVCLASS_ISYST)
+		{
+			ichange += t.DlvCnt;
+		}
+	}
+
+	bool ok = s_UnknownDlv == 0 && s_NoMatchDlv == 0 && nmissed == 0 && nstale == 0 &&
+			  dlv == (int)s_Flt.DlvCnt && s_Flt.DropCnt == 0;
+
+	printf("Replay : %d devices, %d matching, %zu reports in %u s (%.0f reports/s)\n",
+		   (int)s_Dev.size(), nmatch, s_Rpt.size(), Duration / 1000, s_Rpt.size() * 1000.0 / Duration);
+	printf("  filtered out      : %u\n", s_Flt.FltCnt);
+	printf("  duplicates        : %u\n", s_Flt.DupCnt);
+	printf("  new devices       : %u, evicted %u\n", s_Flt.NewCnt, s_Flt.EvictCnt);
+	printf("  delivered records : %u in %d batches (%.2f%% of reports, %.0f records/s)\n",
+		   s_Flt.DlvCnt, s_BatchCnt, 100.0 * s_Flt.DlvCnt / s_Rpt.size(), s_Flt.DlvCnt * 1000.0 / Duration);
+	printf("  sensor tag records: %d\n", ichange);
+	printf("  non matching delivered %d, unknown %d, matching never delivered %d of %d, stale last payload %d\n",
+		   s_NoMatchDlv, s_UnknownDlv, nmissed, nseen, nstale);
+	printf("  %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Plain application side handling : every report goes through each filter,
+// parsing the AD structures per filter, then a linear device list search
+typedef struct {
+	uint8_t Addr[6];
+	uint32_t Hash;
+	uint32_t LastSeen;
+	int Rssi;
+} APPDEV;
+
+static bool AppAdFind(const uint8_t *pData, int Len, uint8_t Type, const uint8_t *pVal, int ValLen, bool bList)
+{
+	for (int i = 0; i + 1 < Len && pData[i] > 0; i += pData[i] + 1)
+	{
+		if (pData[i + 1] != Type)
+		{
+			continue;
+		}
+		int dlen = pData[i] - 1;
+		const uint8_t *d = &pData[i + 2];
+
+		for (int j = 0; j + ValLen <= dlen; j += bList ? ValLen : dlen)
+		{
+			if (memcmp(&d[j], pVal, ValLen) == 0)
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+static int AppProcess(const BLESCANFLT_FILTER *pFlt, int NbFlt, vector<APPDEV> &Dev,
+					  const BLESCANFLT_REPORT &Rpt, uint32_t Time)
+{
+	if (Rpt.Rssi < MIN_RSSI)
+	{
+		return 0;
+	}
+
+	bool match = false;
+
+	for (int i = 0; i < NbFlt && match == false; i++)
+	{
+		switch (pFlt[i].Type)
+		{
+			case BLESCANFLT_TYPE_ADDR:
+				match = memcmp(Rpt.Addr, pFlt[i].Data, 6) == 0;
+				break;
+			case BLESCANFLT_TYPE_UUID16:
+				match = AppAdFind(Rpt.pData, Rpt.Len, 0x03, pFlt[i].Data, 2, true) ||
+						AppAdFind(Rpt.pData, Rpt.Len, 0x02, pFlt[i].Data, 2, true);
+				break;
+			case BLESCANFLT_TYPE_UUID128:
+				match = AppAdFind(Rpt.pData, Rpt.Len, 0x07, pFlt[i].Data, 16, true);
+				break;
+			case BLESCANFLT_TYPE_MANDATA:
+				match = AppAdFind(Rpt.pData, Rpt.Len, 0xFF, pFlt[i].Data, pFlt[i].Len, false);
+				break;
+		}
+	}
+	if (match == false)
+	{
+		return 0;
+	}
+
+	uint32_t h = 2166136261U;
+	for (int i = 0; i < Rpt.Len; i++)
+	{
+		h = (h ^ Rpt.pData[i]) * 16777619U;
+	}
+
+	for (size_t i = 0; i < Dev.size(); i++)
+	{
+		if (memcmp(Dev[i].Addr, Rpt.Addr, 6) == 0)
+		{
+			bool changed = Dev[i].Hash != h;
+
+			Dev[i].Hash = h;
+			Dev[i].LastSeen = Time;
+			Dev[i].Rssi = (Dev[i].Rssi * 3 + Rpt.Rssi) / 4;
+
+			return changed;
+		}
+	}
+
+	APPDEV d;
+	memcpy(d.Addr, Rpt.Addr, 6);
+	d.Hash = h;
+	d.LastSeen = Time;
+	d.Rssi = Rpt.Rssi;
+	Dev.push_back(d);
+
+	return 1;
+}
+
+static void SpeedBench()
+{
+	vector<BLESCANFLT_REPORT> rpt(s_Rpt.size());
+	int dlv = 0;
+	uint32_t nextflush = FLUSH_PERIOD_MS;
+
+	for (size_t i = 0; i < s_Rpt.size(); i++)
+	{
+		MakeReport(s_Rpt[i], rpt[i]);
+	}
+
+	InitEngine(NullHandler, &dlv);
+
+	auto t0 = steady_clock::now();
+	for (size_t i = 0; i < rpt.size(); i++)
+	{
+		if (s_Rpt[i].Time >= nextflush)
+		{
+			BleScanFltFlush(&s_Flt, s_Rpt[i].Time);
+			nextflush += FLUSH_PERIOD_MS;
+		}
+		BleScanFltPut(&s_Flt, &rpt[i]);
+	}
+	BleScanFltFlush(&s_Flt, s_Rpt.back().Time);
+	auto t1 = steady_clock::now();
+
+	int nflt;
+	const BLESCANFLT_FILTER *flt = BuildFilter(nflt);
+	vector<APPDEV> appdev;
+	int appdlv = 0;
+
+	auto t2 = steady_clock::now();
+	for (size_t i = 0; i < rpt.size(); i++)
+	{
+		appdlv += AppProcess(flt, nflt, appdev, rpt[i], s_Rpt[i].Time);
+	}
+	auto t3 = steady_clock::now();
+
+	double te = duration_cast<nanoseconds>(t1 - t0).count() / 1e9;
+	double ta = duration_cast<nanoseconds>(t3 - t2).count() / 1e9;
+
+	printf("\nThroughput, %zu reports\n", rpt.size());
+	printf("  scan filter engine : %.2f M reports/s (%.0f ns/report), %d records delivered\n",
+		   rpt.size() / te / 1e6, te * 1e9 / rpt.size(), dlv);
+	printf("  per report in app  : %.2f M reports/s (%.0f ns/report), %d changed reports\n",
+		   rpt.size() / ta / 1e6, ta * 1e9 / rpt.size(), appdlv);
+}
+
+static bool UnitCheck()
+{
+	// Match table on hand built reports
+	static const uint8_t uuid128[16] = {
+		0x9E, 0xCA, 0xDC, 0x24, 0x0E, 0xE5, 0xA9, 0xE0, 0x93, 0xF3, 0xA3, 0xB5, 0x01, 0x00, 0x40, 0x6E
+	};
+	BLESCANFLT_FILTER flt[3];
+	BLESCANFLT_CFG cfg;
+	int cnt = 0;
+
+	memset(flt, 0, sizeof(flt));
+	flt[0].Type = BLESCANFLT_TYPE_UUID128;
+	flt[0].Len = 16;
+	memcpy(flt[0].Data, uuid128, 16);
+	flt[1].Type = BLESCANFLT_TYPE_MANDATA;
+	flt[1].Len = 3;
+	flt[1].Data[0] = 0x77; flt[1].Data[1] = 0x01; flt[1].Data[2] = 0x05;
+	flt[2].Type = BLESCANFLT_TYPE_UUID16;
+	flt[2].Len = 2;
+	flt[2].Data[0] = 0x0D; flt[2].Data[1] = 0x18;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.pFilter = flt;
+	cfg.NbFilter = 3;
+	cfg.MinRssi = -128;
+	cfg.DedupWindow = 1000;
+	cfg.pDevTbl = s_DevTbl;
+	cfg.pQue = s_DevQue;
+	cfg.NbDev = 16;
+	cfg.pBatch = s_Batch;
+	cfg.BatchSize = 4;
+	cfg.EvtCB = NullHandler;
+	cfg.pCtx = &cnt;
+
+	bool ok = BleScanFltInit(&s_Flt, &cfg);
+
+	uint8_t a128[] = { 2, 1, 6, 17, 0x07, 0x9E, 0xCA, 0xDC, 0x24, 0x0E, 0xE5, 0xA9, 0xE0, 0x93, 0xF3, 0xA3, 0xB5, 0x01, 0x00, 0x40, 0x6E };
+	uint8_t amd[] = { 2, 1, 6, 5, 0xFF, 0x77, 0x01, 0x05, 0x10 };
+	uint8_t amdno[] = { 2, 1, 6, 5, 0xFF, 0x77, 0x01, 0x06, 0x10 };
+	uint8_t a16[] = { 2, 1, 6, 5, 0x03, 0x0F, 0x18, 0x0D, 0x18 };
+	uint8_t abad[] = { 2, 1, 6, 9, 0x03, 0x0D, 0x18 };		// Truncated AD structure
+	BLESCANFLT_REPORT r;
+
+	memset(&r, 0, sizeof(r));
+	r.Rssi = -60;
+	r.pData = a128; r.Len = sizeof(a128);
+	ok &= BleScanFltMatch(&s_Flt, &r);
+	r.pData = amd; r.Len = sizeof(amd);
+	ok &= BleScanFltMatch(&s_Flt, &r);
+	r.pData = amdno; r.Len = sizeof(amdno);
+	ok &= !BleScanFltMatch(&s_Flt, &r);
+	r.pData = a16; r.Len = sizeof(a16);
+	ok &= BleScanFltMatch(&s_Flt, &r);
+	r.pData = abad; r.Len = sizeof(abad);
+	ok &= !BleScanFltMatch(&s_Flt, &r);
+
+	// Dedup, RSSI only change, payload change, expiry
+	r.pData = amd; r.Len = sizeof(amd);
+	r.Addr[0] = 1;
+	BleScanFltSetTime(&s_Flt, 0);
+	ok &= BleScanFltPut(&s_Flt, &r);
+	ok &= !BleScanFltPut(&s_Flt, &r);
+	ok &= BleScanFltFlush(&s_Flt, 500) == 1;
+	ok &= !BleScanFltPut(&s_Flt, &r);
+	amd[8] = 0x11;
+	ok &= BleScanFltPut(&s_Flt, &r);
+	ok &= BleScanFltFlush(&s_Flt, 1000) == 1;
+	ok &= !BleScanFltPut(&s_Flt, &r);
+	ok &= BleScanFltFlush(&s_Flt, 2100) == 0;
+	ok &= BleScanFltPut(&s_Flt, &r);			// Expired, new again
+	ok &= s_Flt.NewCnt == 2 && s_Flt.DupCnt == 3;
+
+	// Table full, oldest evicted
+	for (int i = 0; i < 40; i++)
+	{
+		BleScanFltSetTime(&s_Flt, 3000 + i);
+		r.Addr[1] = i;
+		BleScanFltPut(&s_Flt, &r);
+	}
+	ok &= s_Flt.EvictCnt > 0;
+	cnt = 0;
+	BleScanFltFlush(&s_Flt, 3100);
+	ok &= cnt == 16;			// Queue holds one entry per table slot
+
+	printf("Match table, dedup & eviction %s\n\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	int nbdev = argc > 1 ? atoi(argv[1]) : 3000;
+	uint32_t duration = (argc > 2 ? atoi(argv[2]) : 60) * 1000;
+	bool ok = UnitCheck();
+
+	GenerateFlood(nbdev, duration);
+	ok &= ReplayCheck(duration);
+	SpeedBench();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
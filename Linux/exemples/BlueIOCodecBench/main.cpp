@@ -0,0 +1,319 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	BLUEIO record codec check & benchmark
+
+Encodes sensor traces into BLE notification sized blocks, decodes them back and
+compares with the original records & timestamps. Then decodes again with lost
+blocks to check key block resynchronization. Reports bytes per sample and
+samples per notification against verbatim BLUEIO packets, plus encode/decode
+speed.
+
+Traces are synthetic by default: IMU at 100 to 400 Hz with realistic motion and
+noise, environmental at 1 Hz, ADC at 200 Hz. A recorded 3 axis trace can be
+given as a CSV file, one sample per line : time_us,x,y,z
+
+Usage : BlueIOCodecBench [trace.csv]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <vector>
+#include <random>
+#include <chrono>
+
+#include "blueio_codec.h"
+
+using namespace std::chrono;
+
+#define KEY_INTERVAL		64
+#define LOSS_PERIOD			7		// Drop every 7th block in loss test
+#define NB_SPEED_LOOP		20
+#define BLKREC_MAX			256
+
+/// Sensor trace : fixed size records with timestamps
+typedef struct {
+	const char *pName;
+	const BLUEIO_SCHEMA *pSchema;
+	std::vector<uint8_t> Rec;
+	std::vector<uint64_t> Time;
+	size_t Count() const { return Time.size(); }
+	void Add(const void *pRec, uint64_t t) {
+		Rec.insert(Rec.end(), (uint8_t*)pRec, (uint8_t*)pRec + pSchema->RecSize);
+		Time.push_back(t);
+	}
+} TRACE;
+
+static std::mt19937 s_Rng(1234);
+
+static double Noise(double Sigma)
+{
+	std::normal_distribution<double> d(0.0, Sigma);
+	return d(s_Rng);
+}
+
+// Sample time with +/- 50 usec jitter
+static uint64_t SampleTime(int i, uint32_t Rate)
+{
+	return (uint64_t)i * 1000000ULL / Rate + 50 + (int)Noise(20);
+}
+
+static void GenXyz(TRACE &Tr, const char *pName, const BLUEIO_SCHEMA *pSchema, uint32_t Rate,
+				   double Scale, double Amp, double Freq, double Offset, double Sigma, int Dur)
+{
+	Tr.pName = pName;
+	Tr.pSchema = pSchema;
+	for (int i = 0; i < Dur * (int)Rate; i++)
+	{
+		double t = (double)i / Rate;
+		int16_t v[3];
+
+		v[0] = (int16_t)lrint(Scale * (Amp * 0.3 * sin(2 * M_PI * Freq * t + 1.0)) + Noise(Sigma));
+		v[1] = (int16_t)lrint(Scale * (Amp * 0.5 * sin(2 * M_PI * Freq * 0.5 * t)) + Noise(Sigma));
+		v[2] = (int16_t)lrint(Scale * (Offset + Amp * sin(2 * M_PI * Freq * t)) + Noise(Sigma));
+		Tr.Add(v, SampleTime(i, Rate));
+	}
+}
+
+static void GenTph(TRACE &Tr, int Dur)
+{
+	BLUEIO_DATA_TPH d = { 101325, 2150, 4530 };
+
+	Tr.pName = "TPH 1 Hz";
+	Tr.pSchema = &g_BlueIOSchemaTph;
+	for (int i = 0; i < Dur; i++)
+	{
+		d.Pressure += (int)lrint(Noise(3));
+		d.Temperature += (int)lrint(Noise(1.5));
+		d.Humidity += (int)lrint(Noise(4));
+		Tr.Add(&d, SampleTime(i, 1));
+	}
+}
+
+static void GenAdc(TRACE &Tr, int Dur)
+{
+	BLUEIO_DATA_ADC d = { 2, 0.0 };
+
+	Tr.pName = "ADC 200 Hz";
+	Tr.pSchema = &g_BlueIOSchemaAdc;
+	for (int i = 0; i < Dur * 200; i++)
+	{
+		// 12 bits ADC, 3.6V full scale, slow varying 1.8V signal
+		int code = (int)lrint(2048 + 600 * sin(2 * M_PI * 0.2 * i / 200.0) + Noise(2));
+		d.Voltage = code * 3.6f / 4096.0f;
+		Tr.Add(&d, SampleTime(i, 200));
+	}
+}
+
+static bool LoadCsv(TRACE &Tr, const char *pFile)
+{
+	FILE *fp = fopen(pFile, "r");
+
+	if (fp == NULL)
+	{
+		return false;
+	}
+
+	Tr.pName = pFile;
+	Tr.pSchema = &g_BlueIOSchemaAccel;
+
+	char line[256];
+	while (fgets(line, sizeof(line), fp))
+	{
+		unsigned long long t;
+		int x, y, z;
+
+		if (sscanf(line, "%llu,%d,%d,%d", &t, &x, &y, &z) == 4)
+		{
+			int16_t v[3] = { (int16_t)x, (int16_t)y, (int16_t)z };
+			Tr.Add(v, t);
+		}
+	}
+	fclose(fp);
+
+	return Tr.Count() > 0;
+}
+
+/// Encode trace into blocks of BlkSize bytes. Returns first record index of each block
+static std::vector<size_t> Encode(const TRACE &Tr, int BlkSize, std::vector<std::vector<uint8_t> > &Blks)
+{
+	BLUEIO_ENCODER enc;
+	std::vector<size_t> first;
+	size_t i = 0;
+	uint8_t buf[256];
+
+	BlueIOEncInit(&enc, Tr.pSchema, KEY_INTERVAL, true);
+	Blks.clear();
+
+	while (i < Tr.Count())
+	{
+		BlueIOEncBegin(&enc, buf, BlkSize);
+		first.push_back(i);
+		while (i < Tr.Count() && BlueIOEncPut(&enc, &Tr.Rec[i * Tr.pSchema->RecSize], Tr.Time[i]))
+		{
+			i++;
+		}
+		int l = BlueIOEncEnd(&enc);
+		Blks.push_back(std::vector<uint8_t>(buf, buf + l));
+	}
+
+	return first;
+}
+
+/// Decode blocks, skipping every LossPeriod-th one. Checks every decoded record
+static bool Decode(const TRACE &Tr, std::vector<std::vector<uint8_t> > &Blks, std::vector<size_t> &First,
+				   int LossPeriod, size_t *pDecCnt)
+{
+	BLUEIO_DECODER dec;
+	size_t rs = Tr.pSchema->RecSize;
+	std::vector<uint8_t> rec(BLKREC_MAX * rs);
+	uint64_t t[BLKREC_MAX];
+
+	BlueIODecInit(&dec, Tr.pSchema);
+	*pDecCnt = 0;
+
+	for (size_t b = 0; b < Blks.size(); b++)
+	{
+		if (LossPeriod > 0 && (int)(b % LossPeriod) == LossPeriod - 1)
+		{
+			continue;
+		}
+
+		int n = BlueIODecBlock(&dec, Blks[b].data(), Blks[b].size(), rec.data(), t, BLKREC_MAX);
+		if (n < 0)
+		{
+			printf("  block %zu decode error\n", b);
+			return false;
+		}
+		if (n > 0 && (memcmp(rec.data(), &Tr.Rec[First[b] * rs], n * rs) != 0 ||
+			memcmp(t, &Tr.Time[First[b]], n * sizeof(uint64_t)) != 0))
+		{
+			printf("  block %zu mismatch\n", b);
+			return false;
+		}
+		*pDecCnt += n;
+	}
+
+	return true;
+}
+
+static bool Bench(const TRACE &Tr)
+{
+	static const int s_BlkSize[] = { 20, 244 };
+	size_t rs = Tr.pSchema->RecSize;
+	bool ok = true;
+
+	printf("%s : %zu samples of %zu bytes\n", Tr.pName, Tr.Count(), rs);
+
+	for (int k = 0; k < 2; k++)
+	{
+		std::vector<std::vector<uint8_t> > blks;
+		std::vector<size_t> first = Encode(Tr, s_BlkSize[k], blks);
+		size_t total = 0, deccnt, losscnt;
+
+		for (auto &b : blks)
+		{
+			total += b.size();
+		}
+
+		bool rt = Decode(Tr, blks, first, 0, &deccnt) && deccnt == Tr.Count();
+		bool loss = Decode(Tr, blks, first, LOSS_PERIOD, &losscnt);
+
+		// Verbatim : 1 byte packet id + record + 4 bytes timestamp, packed
+		int rawpkt = (s_BlkSize[k] - 1) / (rs + 4);
+		double spp = (double)Tr.Count() / blks.size();
+
+		printf("  %3d bytes blocks : %5.2f bytes/sample, %6.2f samples/pkt (verbatim %d, %d w/o time)"
+			   ", x%.2f, round trip %s, 1/%d loss recovered %4.1f%% %s\n",
+			   s_BlkSize[k], (double)total / Tr.Count(), spp, rawpkt, (s_BlkSize[k] - 1) / (int)rs,
+			   spp / rawpkt, rt ? "PASS" : "FAIL", LOSS_PERIOD, 100.0 * losscnt / Tr.Count(),
+			   loss ? "PASS" : "FAIL");
+		ok &= rt && loss;
+
+		if (k == 1)
+		{
+			auto t0 = high_resolution_clock::now();
+			for (int l = 0; l < NB_SPEED_LOOP; l++)
+			{
+				Encode(Tr, s_BlkSize[k], blks);
+			}
+			auto t1 = high_resolution_clock::now();
+			for (int l = 0; l < NB_SPEED_LOOP; l++)
+			{
+				Decode(Tr, blks, first, 0, &deccnt);
+			}
+			auto t2 = high_resolution_clock::now();
+			double n = (double)Tr.Count() * NB_SPEED_LOOP;
+
+			printf("  encode %.1f ns/sample, decode %.1f ns/sample (incl. check)\n",
+				   duration_cast<nanoseconds>(t1 - t0).count() / n,
+				   duration_cast<nanoseconds>(t2 - t1).count() / n);
+		}
+	}
+	printf("\n");
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	std::vector<TRACE> traces(5);
+	bool ok = true;
+
+	GenXyz(traces[0], "Accel 100 Hz", &g_BlueIOSchemaAccel, 100, 16384, 0.25, 1.8, 1.0, 8, 600);
+	GenXyz(traces[1], "Gyro 400 Hz", &g_BlueIOSchemaGyro, 400, 16.4, 40, 0.9, 0.0, 3, 120);
+	GenXyz(traces[2], "Mag 50 Hz", &g_BlueIOSchemaMag, 50, 6.6, 30, 0.1, 20, 2, 600);
+	GenTph(traces[3], 3600);
+	GenAdc(traces[4], 300);
+
+	if (argc > 1)
+	{
+		TRACE tr;
+
+		if (LoadCsv(tr, argv[1]) == false)
+		{
+			printf("Can't load %s\n", argv[1]);
+			return 1;
+		}
+		traces.push_back(tr);
+	}
+
+	for (auto &tr : traces)
+	{
+		ok &= Bench(tr);
+	}
+
+	printf("%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
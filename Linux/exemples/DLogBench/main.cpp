@@ -0,0 +1,498 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Deferred formatting log benchmark
+
+Measures the cost of a log call in the caller's context, DLOG capturing format
+address & raw arguments into the binary ring versus formatting with snprintf
+& writing out as the UART retarget does, and versus buffered fprintf.  Also
+reports the drain cost per message for text & binary output.
+
+Checks :
+	- Text drain output is identical to snprintf of the same format & arguments
+	- Binary stream, written out through a short & sometimes busy output, decodes
+	  on host from this executable's ELF image to the same text
+	- Ring overflow never blocks, drops are counted & reported
+	- 4 producer threads with a concurrent drain, per thread messages stay in
+	  order and decoded + dropped equals logged
+
+The binary stream is left in /tmp/iosonata_dlog.bin, decode it with
+DLogDecode <path to DLogBench> /tmp/iosonata_dlog.bin
+
+Usage : DLogBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <time.h>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "dlog.h"
+#include "dlog_decoder.h"
+
+#define NB_CALL				100000
+#define BENCH_RING_WORDS	(1 << 20)
+#define MT_NB_THREAD		4
+#define MT_NB_MSG			200000
+#define MT_RING_WORDS		65536
+
+#if defined(__x86_64__) || defined(__i386__)
+static inline uint64_t Ticks() { return __rdtsc(); }
+static const char *s_TickUnit = "cycles";
+#else
+static inline uint64_t Ticks() {
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+static const char *s_TickUnit = "ns";
+#endif
+
+static std::string s_Out;
+static int s_WrCnt;
+static int s_WrMax;
+static uint32_t s_Time;
+
+static int StrWrite(void *pCtx, const uint8_t *pData, int Len)
+{
+	s_WrCnt++;
+	if (s_WrMax > 0)
+	{
+		// Output busy every 5th call, else accepts at most s_WrMax bytes
+		if (s_WrCnt % 5 == 0)
+		{
+			return 0;
+		}
+		Len = Len < s_WrMax ? Len : s_WrMax;
+	}
+	s_Out.append((const char*)pData, Len);
+
+	return Len;
+}
+
+static int NullWrite(void *pCtx, const uint8_t *pData, int Len)
+{
+	return Len;
+}
+
+static uint32_t TimeStamp()
+{
+	return s_Time++;
+}
+
+static bool Init(DLOG *pLog, std::vector<DLOG_ARG> &Mem, size_t NbWord, DLOG_MODE Mode, DLOG_WRCB WrCB, DLOG_TIMECB TimeCB)
+{
+	DLOG_CFG cfg;
+
+	Mem.assign(NbWord, 0);
+	cfg.pMem = Mem.data();
+	cfg.MemSize = NbWord * sizeof(DLOG_ARG);
+	cfg.Mode = Mode;
+	cfg.WriteCB = WrCB;
+	cfg.pCtx = NULL;
+	cfg.TimeCB = TimeCB;
+
+	return DLogInit(pLog, &cfg);
+}
+
+static void Drain(DLOG *pLog)
+{
+	while (DLogProcess(pLog) > 0 || pLog->OutLen > 0);
+}
+
+/// Same messages logged through DLOG & formatted with snprintf
+#define MESSAGES(X) \
+	X("Boot %s v%d.%d\r\n", "IOsonata", 1, 7) \
+	X("Temp %.2f C, hum %5.1f %%\r\n", 23.375f, 48.25f) \
+	X("Reg 0x%08x = %u (%d)\r\n", 0xDEADBEEFU, 4000000000U, -42) \
+	X("Char '%c' oct %o HEX %X\r\n", 'A', 8, 0xABCU) \
+	X("Long %ld %lu %lx\r\n", -1234567890123L, 9876543210UL, 0xFEDCBA9876UL) \
+	X("Sci %e %g %G\r\n", 1.5e-7f, 100000.0f, 1e-5f) \
+	X("Pad [%-6s] [%6s] [%+4d] [%04x]\r\n", "ab", "cd", 7, 0x2aU) \
+	X("Ptr %p\r\n", (void*)0x1234) \
+	X("Args %d %d %d %d %d %d %d %d\r\n", 1, 2, 3, 4, 5, 6, 7, 8)
+
+#define DLOG_MSG(Fmt, ...)		DLOG(pLog, Fmt, __VA_ARGS__);
+#define SNPRINTF_MSG(Fmt, ...)	snprintf(buf, sizeof(buf), Fmt, __VA_ARGS__); Exp += buf;
+
+static void LogMessages(DLOG *pLog)
+{
+	MESSAGES(DLOG_MSG)
+	DLOG(pLog, "No argument\r\n");
+}
+
+static void ExpectedMessages(std::string &Exp)
+{
+	char buf[256];
+
+	MESSAGES(SNPRINTF_MSG)
+	Exp += "No argument\r\n";
+}
+
+static std::string TimePrefix(const std::string &Txt)
+{
+	std::string r;
+	uint32_t t = 0;
+	size_t p = 0;
+
+	while (p < Txt.size())
+	{
+		size_t e = Txt.find('\n', p) + 1;
+
+		r += "[" + std::to_string(t++) + "] " + Txt.substr(p, e - p);
+		p = e;
+	}
+
+	return r;
+}
+
+static bool CheckText()
+{
+	std::vector<DLOG_ARG> mem;
+	DLOG log;
+	std::string exp;
+
+	ExpectedMessages(exp);
+
+	s_Out.clear();
+	s_WrMax = 0;
+	Init(&log, mem, 256, DLOG_MODE_TEXT, StrWrite, NULL);
+	LogMessages(&log);
+	Drain(&log);
+
+	bool ok = s_Out == exp;
+
+	if (ok == false)
+	{
+		printf("Expected :\n%s\nGot :\n%s\n", exp.c_str(), s_Out.c_str());
+	}
+
+	s_Out.clear();
+	s_Time = 0;
+	Init(&log, mem, 256, DLOG_MODE_TEXT, StrWrite, TimeStamp);
+	LogMessages(&log);
+	Drain(&log);
+
+	ok &= s_Out == TimePrefix(exp);
+
+	printf("Text output matches snprintf        : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+static bool CheckBinary()
+{
+	std::vector<DLOG_ARG> mem;
+	DLOG log;
+	std::string exp, txt;
+	DLogDecoder dec;
+
+	ExpectedMessages(exp);
+	exp = TimePrefix(exp);
+
+	s_Out.clear();
+	s_WrCnt = 0;
+	s_WrMax = 7;
+	s_Time = 0;
+	Init(&log, mem, 256, DLOG_MODE_BIN, StrWrite, TimeStamp);
+	LogMessages(&log);
+	for (int i = 0; i < 1000 && (log.OutLen > 0 || log.Head != log.Tail); i++)
+	{
+		DLogProcess(&log);
+	}
+	s_WrMax = 0;
+
+	FILE *fp = fopen("/tmp/iosonata_dlog.bin", "wb");
+	if (fp)
+	{
+		fwrite(s_Out.data(), 1, s_Out.size(), fp);
+		fclose(fp);
+	}
+
+	bool ok = dec.LoadElf("/proc/self/exe");
+
+	// Leading garbage, decoder must find sync
+	const uint8_t junk[] = { 'D', 'L', 'O', 0x12, 0xD1, 0 };
+	dec.Decode(junk, sizeof(junk), txt);
+
+	for (size_t i = 0; i < s_Out.size(); i += 13)
+	{
+		size_t l = s_Out.size() - i < 13 ? s_Out.size() - i : 13;
+		dec.Decode((const uint8_t*)&s_Out[i], l, txt);
+	}
+
+	ok &= txt == exp && dec.ErrorCount() == 0;
+	if (ok == false)
+	{
+		printf("Expected :\n%s\nDecoded :\n%s\n", exp.c_str(), txt.c_str());
+	}
+
+	printf("Binary stream decodes on host       : %s  (%zu bytes vs %zu text, %d short writes)\n",
+		   ok ? "PASS" : "FAIL", s_Out.size(), exp.size(), s_WrCnt);
+
+	return ok;
+}
+
+static bool CheckOverflow()
+{
+	std::vector<DLOG_ARG> mem;
+	DLOG log;
+	int nok;
+
+	s_Out.clear();
+	s_WrMax = 0;
+	Init(&log, mem, 64, DLOG_MODE_TEXT, StrWrite, NULL);
+
+	for (int i = 0; i < 100; i++)
+	{
+		// 5 words per message, 12 fit in 64 words
+		DLOG(&log, "%d %d\r\n", i, i);
+	}
+
+	uint32_t drop = DLogDropCount(&log);
+	nok = 100 - drop;
+	Drain(&log);
+
+	bool ok = nok == 12 && drop == 88 && s_Out.find("*** 88 messages dropped\r\n") != std::string::npos;
+
+	// Ring usable after overflow
+	s_Out.clear();
+	DLOG(&log, "after %d\r\n", 1);
+	Drain(&log);
+	ok &= s_Out == "after 1\r\n";
+
+	printf("Overflow counted, never blocks      : %s  (%d logged, %u dropped)\n", ok ? "PASS" : "FAIL", nok, drop);
+
+	return ok;
+}
+
+static bool CheckMultiProducer()
+{
+	std::vector<DLOG_ARG> mem;
+	DLOG log;
+	std::atomic_int done(0);
+	std::string out;
+
+	s_WrMax = 0;
+	Init(&log, mem, MT_RING_WORDS, DLOG_MODE_TEXT, StrWrite, NULL);
+
+	std::vector<std::thread> th;
+
+	for (int t = 0; t < MT_NB_THREAD; t++)
+	{
+		th.push_back(std::thread([&log, &done, t]() {
+			for (uint32_t i = 0; i < MT_NB_MSG; i++)
+			{
+				DLOG(&log, "T%d %u\n", t, i);
+			}
+			done++;
+		}));
+	}
+
+	s_Out.clear();
+	while (done < MT_NB_THREAD)
+	{
+		DLogProcess(&log);
+	}
+	for (auto &x : th)
+	{
+		x.join();
+	}
+	Drain(&log);
+
+	int64_t last[MT_NB_THREAD];
+	uint64_t nbmsg = 0, nbdrop = 0;
+	bool ok = true;
+	size_t p = 0;
+
+	for (int i = 0; i < MT_NB_THREAD; i++)
+	{
+		last[i] = -1;
+	}
+
+	while (p < s_Out.size())
+	{
+		unsigned t, seq;
+		size_t e = s_Out.find('\n', p);
+
+		if (e == std::string::npos)
+		{
+			ok = false;
+			break;
+		}
+
+		std::string line = s_Out.substr(p, e - p);
+		p = e + 1;
+
+		if (sscanf(line.c_str(), "T%u %u", &t, &seq) == 2 && t < MT_NB_THREAD)
+		{
+			ok &= (int64_t)seq > last[t];
+			last[t] = seq;
+			nbmsg++;
+		}
+		else if (sscanf(line.c_str(), "*** %u messages dropped", &seq) == 1)
+		{
+			nbdrop += seq;
+		}
+		else
+		{
+			ok = false;
+		}
+	}
+
+	ok &= nbmsg + nbdrop == (uint64_t)MT_NB_THREAD * MT_NB_MSG && nbdrop == DLogDropCount(&log);
+
+	printf("%d producers, concurrent drain       : %s  (%lu messages, %lu dropped)\n", MT_NB_THREAD,
+		   ok ? "PASS" : "FAIL", nbmsg, nbdrop);
+
+	return ok;
+}
+
+int main()
+{
+	bool ok = true;
+	std::vector<DLOG_ARG> mem;
+	DLOG log;
+	char buf[256];
+	uint64_t t;
+	double tdlog[3], tprintf[3], tfprintf, tdrain[2];
+	int fd = open("/dev/null", O_WRONLY);
+	FILE *fp = fopen("/dev/null", "w");
+
+	printf("Deferred formatting log, %d calls per measure, %s per call\n\n", NB_CALL, s_TickUnit);
+
+	Init(&log, mem, BENCH_RING_WORDS, DLOG_MODE_TEXT, NullWrite, NULL);
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		// First pass warms up caches & ring pages
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			DLOG(&log, "Sample ready\r\n");
+		}
+		tdlog[0] = (double)(Ticks() - t) / NB_CALL;
+		Drain(&log);
+
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			DLOG(&log, "Sample %d, %u\r\n", i, (unsigned)i * 3);
+		}
+		tdlog[1] = (double)(Ticks() - t) / NB_CALL;
+		Drain(&log);
+
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			DLOG(&log, "Sample %d, x %.3f y %.3f z %d\r\n", i, (float)i * 0.5f, 1.25f, -i);
+		}
+		tdlog[2] = (double)(Ticks() - t) / NB_CALL;
+	}
+
+	t = Ticks();
+	Drain(&log);
+	tdrain[0] = (double)(Ticks() - t) / NB_CALL;
+
+	Init(&log, mem, BENCH_RING_WORDS, DLOG_MODE_BIN, NullWrite, NULL);
+	for (int i = 0; i < NB_CALL; i++)
+	{
+		DLOG(&log, "Sample %d, x %.3f y %.3f z %d\r\n", i, (float)i * 0.5f, 1.25f, -i);
+	}
+	t = Ticks();
+	Drain(&log);
+	tdrain[1] = (double)(Ticks() - t) / NB_CALL;
+
+	for (int pass = 0; pass < 2; pass++)
+	{
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			int l = snprintf(buf, sizeof(buf), "Sample ready\r\n");
+			ok &= write(fd, buf, l) == l;
+		}
+		tprintf[0] = (double)(Ticks() - t) / NB_CALL;
+
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			int l = snprintf(buf, sizeof(buf), "Sample %d, %u\r\n", i, (unsigned)i * 3);
+			ok &= write(fd, buf, l) == l;
+		}
+		tprintf[1] = (double)(Ticks() - t) / NB_CALL;
+
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			int l = snprintf(buf, sizeof(buf), "Sample %d, x %.3f y %.3f z %d\r\n", i, (float)i * 0.5f, 1.25f, -i);
+			ok &= write(fd, buf, l) == l;
+		}
+		tprintf[2] = (double)(Ticks() - t) / NB_CALL;
+
+		t = Ticks();
+		for (int i = 0; i < NB_CALL; i++)
+		{
+			fprintf(fp, "Sample %d, x %.3f y %.3f z %d\r\n", i, (float)i * 0.5f, 1.25f, -i);
+		}
+		tfprintf = (double)(Ticks() - t) / NB_CALL;
+	}
+
+	close(fd);
+	fclose(fp);
+
+	printf("%-28s %10s %16s %10s\n", "Log call", "DLOG", "snprintf+write", "speedup");
+	const char *name[3] = { "no argument", "2 int", "2 int, 2 float" };
+	for (int i = 0; i < 3; i++)
+	{
+		printf("%-28s %10.1f %16.1f %9.1fx\n", name[i], tdlog[i], tprintf[i], tprintf[i] / tdlog[i]);
+		ok &= tdlog[i] < tprintf[i];
+	}
+	printf("%-28s %10s %16.1f\n", "2 int, 2 float, fprintf", "", tfprintf);
+	printf("\nDrain per message, 2 int 2 float : text %.1f, binary %.1f\n\n", tdrain[0], tdrain[1]);
+
+	ok &= CheckText();
+	ok &= CheckBinary();
+	ok &= CheckOverflow();
+	ok &= CheckMultiProducer();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Deferred log binary stream decoder
+
+Decodes a DLOG_MODE_BIN stream captured from the UART or BLE link using the
+ELF image of the firmware that produced it.  Use - to read the stream from
+stdin, e.g. a serial port piped in, text is written as it is decoded.
+
+Usage : DLogDecode <ELF image> <stream file | ->
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <string>
+
+#include "dlog_decoder.h"
+
+int main(int argc, char **argv)
+{
+	if (argc < 3)
+	{
+		printf("Usage : DLogDecode <ELF image> <stream file | ->\n");
+		return 1;
+	}
+
+	DLogDecoder dec;
+
+	if (dec.LoadElf(argv[1]) == false)
+	{
+		printf("No dlog_fmt section in %s\n", argv[1]);
+		return 1;
+	}
+
+	FILE *fp = strcmp(argv[2], "-") == 0 ? stdin : fopen(argv[2], "rb");
+
+	if (fp == NULL)
+	{
+		printf("Failed to open stream %s\n", argv[2]);
+		return 1;
+	}
+
+	uint8_t buf[512];
+	size_t n;
+
+	while ((n = fread(buf, 1, sizeof(buf), fp)) > 0)
+	{
+		std::string txt;
+
+		dec.Decode(buf, n, txt);
+		fputs(txt.c_str(), stdout);
+		fflush(stdout);
+	}
+
+	if (fp != stdin)
+	{
+		fclose(fp);
+	}
+
+	fprintf(stderr, "%u messages, %u dropped on target, %u errors\n", dec.MsgCount(), dec.DropCount(),
+			dec.ErrorCount());
+
+	return 0;
+}
@@ -0,0 +1,411 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	ECDSA P-256 verification check and benchmark
+
+Checks the generic and comb table verification paths against RFC 6979
+vectors, a Wycheproof style table of malformed signatures and keys, and
+random keys and signatures from micro-ecc. Then compares verifications per
+second with uECC_verify and times hash then verify of a firmware image.
+
+Usage : EcdsaBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+#include "isha256.h"
+#include "ecdsa_p256.h"
+#include "uECC.h"
+
+#define RANDOM_ITER			200
+#define BENCH_TIME_US		1000000.0
+#define IMAGE_SIZE			(256 * 1024)
+
+static int s_FailCnt = 0;
+
+static void Check(bool bOk, const char *pMsg)
+{
+	if (bOk == false)
+	{
+		printf("  FAIL : %s\n", pMsg);
+		s_FailCnt++;
+	}
+}
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static void Hex2Bin(const char *pHex, uint8_t *pBin, int Len)
+{
+	for (int i = 0; i < Len; i++)
+	{
+		char s[3] = { pHex[i * 2], pHex[i * 2 + 1], 0 };
+
+		pBin[i] = strtoul(s, NULL, 16);
+	}
+}
+
+static void Sha(const char *pMsg, uint8_t *pHash)
+{
+	SHA256CTX ctx;
+
+	Sha256Init(&ctx);
+	Sha256Update(&ctx, (const uint8_t*)pMsg, strlen(pMsg));
+	Sha256Final(&ctx, pHash);
+}
+
+/// Run all verification paths, they must agree
+/// uECC co-Z precompute of G + Q fails when Q = G, bUecc false skips it
+static bool VerifyAll(const uint8_t *pKey, const uint8_t *pHash, const uint8_t *pSig, const char *pName,
+					  bool bUecc = true)
+{
+	static ECDSAP256_COMB comb;
+	bool res = EcdsaP256Verify(pKey, pHash, pSig);
+	bool bcomb = EcdsaP256CombInit(&comb, pKey);
+
+	if (bcomb == false)
+	{
+		// Invalid key, generic path must reject
+		if (res)
+		{
+			printf("  FAIL : %s, invalid key accepted\n", pName);
+			s_FailCnt++;
+		}
+		return false;
+	}
+
+	bool rcomb = EcdsaP256VerifyComb(&comb, pHash, pSig);
+	bool ruecc = bUecc ? uECC_verify(pKey, pHash, 32, pSig, uECC_secp256r1()) != 0 : res;
+
+	if (res != rcomb || res != ruecc)
+	{
+		printf("  FAIL : %s, generic %d comb %d uECC %d\n", pName, res, rcomb, ruecc);
+		s_FailCnt++;
+	}
+
+	return res;
+}
+
+static const char *s_RfcKey =
+	"60FED4BA255A9D31C961EB74C6356D68C049B8923B61FA6CE669622E60F29FB6"
+	"7903FE1008B8BC99A41AE9E95628BC64F2F1B20C2D7E9F5177A3C294D4462299";
+
+static const char *s_N = "FFFFFFFF00000000FFFFFFFFFFFFFFFFBCE6FAADA7179E84F3B9CAC2FC632551";
+
+static void CheckRfc6979()
+{
+	static const struct {
+		const char *pMsg;
+		const char *pSig;
+	} s_Vect[] = {
+		{ "sample",
+		  "EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716"
+		  "F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8" },
+		{ "test",
+		  "F1ABB023518351CD71D881567B1EA663ED3EFCF6C5132B354F28D3B0B7D38367"
+		  "019F4113742A2B14BD25926B49C649155F267E60D3814B4C0CC84250E46F0083" },
+	};
+	uint8_t key[64], sig[64], hash[32];
+
+	Hex2Bin(s_RfcKey, key, 64);
+
+	for (size_t i = 0; i < sizeof(s_Vect) / sizeof(s_Vect[0]); i++)
+	{
+		Hex2Bin(s_Vect[i].pSig, sig, 64);
+		Sha(s_Vect[i].pMsg, hash);
+		Check(VerifyAll(key, hash, sig, s_Vect[i].pMsg), s_Vect[i].pMsg);
+
+		// Streaming, message split in bytes
+		ECDSAP256_VERIFY ctx;
+		EcdsaP256VerifyInit(&ctx, key, NULL);
+		for (const char *p = s_Vect[i].pMsg; *p; p++)
+		{
+			EcdsaP256VerifyUpdate(&ctx, (const uint8_t*)p, 1);
+		}
+		Check(EcdsaP256VerifyFinal(&ctx, sig), "streaming");
+	}
+}
+
+/// 256 bits big endian add/sub of small values or n, for malformed signatures
+static void Add256(uint8_t *r, const uint8_t *a, const uint8_t *b, bool bSub)
+{
+	int c = 0;
+
+	for (int i = 31; i >= 0; i--)
+	{
+		c = bSub ? a[i] - b[i] + c : a[i] + b[i] + c;
+		r[i] = c;
+		c >>= 8;
+	}
+}
+
+static void CheckWycheproofStyle()
+{
+	uint8_t key[64], sig[64], hash[32], n[32], t[64], h[32], k[64];
+	uint8_t one[32] = { 0 };
+
+	one[31] = 1;
+	Hex2Bin(s_RfcKey, key, 64);
+	Hex2Bin(s_N, n, 32);
+	Hex2Bin("EFD48B2AACB6A8FD1140DD9CD45E81D69D2C877B56AAF991C34D0EA84EAF3716"
+			"F7CB1C942D657C41D436C7A1B6E29F65F3E900DBB9AFF4064DC4AB2F843ACDA8", sig, 64);
+	Sha("sample", hash);
+
+	struct {
+		const char *pName;
+		bool bValid;
+	} c;
+
+#define CASE(name, valid, pk, ph, ps, ...)	do { c.pName = name; c.bValid = valid; \
+		if (VerifyAll(pk, ph, ps, name, ##__VA_ARGS__) != c.bValid) { printf("  FAIL : %s\n", c.pName); s_FailCnt++; } } while (0)
+
+	CASE("valid", true, key, hash, sig);
+
+	memcpy(t, sig, 64);
+	Add256(&t[32], n, &sig[32], true);
+	CASE("s replaced by n - s", true, key, hash, t);
+
+	memcpy(t, sig, 64);
+	memset(t, 0, 32);
+	CASE("r = 0", false, key, hash, t);
+
+	memcpy(t, sig, 64);
+	memset(&t[32], 0, 32);
+	CASE("s = 0", false, key, hash, t);
+
+	memcpy(t, sig, 64);
+	memcpy(t, n, 32);
+	CASE("r = n", false, key, hash, t);
+
+	memcpy(t, sig, 64);
+	memcpy(&t[32], n, 32);
+	CASE("s = n", false, key, hash, t);
+
+	memcpy(t, sig, 64);
+	Add256(t, n, one, false);
+	CASE("r = n + 1", false, key, hash, t);
+
+	memcpy(t, sig, 64);
+	memset(&t[32], 0xff, 32);
+	CASE("s = 2^256 - 1", false, key, hash, t);
+
+	memcpy(t, &sig[32], 32);
+	memcpy(&t[32], sig, 32);
+	CASE("r and s swapped", false, key, hash, t);
+
+	memset(t, 0, 64);
+	CASE("r = s = 0", false, key, hash, t);
+
+	for (int b = 0; b < 256; b += 37)
+	{
+		memcpy(h, hash, 32);
+		h[b >> 3] ^= 1 << (b & 7);
+		CASE("hash bit flipped", false, key, h, sig);
+
+		memcpy(t, sig, 64);
+		t[b >> 3] ^= 1 << (b & 7);
+		CASE("r bit flipped", false, key, hash, t);
+
+		memcpy(t, sig, 64);
+		t[32 + (b >> 3)] ^= 1 << (b & 7);
+		CASE("s bit flipped", false, key, hash, t);
+	}
+
+	// Hash >= n is reduced, hash + n mod 2^256 is a different message
+	memcpy(h, hash, 32);
+	Add256(h, hash, n, false);
+	CASE("hash + n", false, key, h, sig);
+
+	memcpy(k, key, 64);
+	k[63] ^= 1;
+	CASE("key not on curve", false, k, hash, sig);
+
+	memset(k, 0, 64);
+	CASE("key at origin", false, k, hash, sig);
+
+	// Key is G : R = w * (e + r) * G
+	Hex2Bin("6B17D1F2E12C4247F8BCE6E563A440F277037D812DEB33A0F4A13945D898C296"
+			"4FE342E2FE1A7F9B8EE7EB4A7C0F9E162BCE33576B315ECECBB6406837BF51F5", k, 64);
+
+	// e + r = 0 mod n, R at infinity
+	memset(t, 0, 64);
+	t[31] = 5;
+	t[63] = 7;
+	Add256(h, n, t, true);
+	CASE("R at infinity", false, k, h, t, false);
+
+	// e = r, both combs hit the same entries, doubling inside addition
+	memcpy(h, t, 32);
+	CASE("u1 = u2", false, k, h, t, false);
+
+	// Private key 1, s = e + r when nonce is 1, r = x(G)
+	memcpy(t, k, 32);
+	memset(h, 0, 32);
+	h[31] = 3;
+	Add256(&t[32], h, t, false);
+	CASE("nonce 1, key 1", true, k, h, t, false);
+
+#undef CASE
+}
+
+static void CheckRandom()
+{
+	const struct uECC_Curve_t *curve = uECC_secp256r1();
+
+	for (int i = 0; i < RANDOM_ITER; i++)
+	{
+		uint8_t key[64], priv[32], hash[32], sig[64];
+
+		uECC_make_key(key, priv, curve);
+		for (int k = 0; k < 32; k++)
+		{
+			hash[k] = rand();
+		}
+		if (i & 1)
+		{
+			// High hash values, reduced mod n
+			memset(hash, 0xff, 8);
+		}
+		uECC_sign(priv, hash, 32, sig, curve);
+
+		Check(VerifyAll(key, hash, sig, "random"), "random valid");
+
+		sig[rand() & 63] ^= 1 << (rand() & 7);
+		Check(VerifyAll(key, hash, sig, "random") == false, "random corrupted");
+	}
+}
+
+static void Bench()
+{
+	const struct uECC_Curve_t *curve = uECC_secp256r1();
+	uint8_t key[64], priv[32], hash[32], sig[64];
+	static ECDSAP256_COMB comb;
+	double t;
+	int cnt;
+	bool ok = true;
+
+	uECC_make_key(key, priv, curve);
+	memset(hash, 0x5a, 32);
+	uECC_sign(priv, hash, 32, sig, curve);
+	EcdsaP256CombInit(&comb, key);
+
+	t = usNow();
+	for (cnt = 0; usNow() - t < BENCH_TIME_US; cnt++)
+	{
+		ok &= uECC_verify(key, hash, 32, sig, curve) != 0;
+	}
+	t = usNow() - t;
+	double ref = cnt * 1000000.0 / t;
+	printf("  uECC_verify             %8.1f verify/s\n", ref);
+
+	t = usNow();
+	for (cnt = 0; usNow() - t < BENCH_TIME_US; cnt++)
+	{
+		ok &= EcdsaP256Verify(key, hash, sig);
+	}
+	t = usNow() - t;
+	printf("  EcdsaP256Verify         %8.1f verify/s  x%.2f\n", cnt * 1000000.0 / t, cnt * 1000000.0 / t / ref);
+
+	t = usNow();
+	for (cnt = 0; usNow() - t < BENCH_TIME_US; cnt++)
+	{
+		ok &= EcdsaP256VerifyComb(&comb, hash, sig);
+	}
+	t = usNow() - t;
+	printf("  EcdsaP256VerifyComb     %8.1f verify/s  x%.2f\n", cnt * 1000000.0 / t, cnt * 1000000.0 / t / ref);
+
+	t = usNow();
+	for (cnt = 0; cnt < 20; cnt++)
+	{
+		EcdsaP256CombInit(&comb, key);
+	}
+	t = usNow() - t;
+	printf("  EcdsaP256CombInit       %8.1f us\n", t / cnt);
+
+	// Firmware image hashed while received, 4KB chunks
+	std::vector<uint8_t> img(IMAGE_SIZE);
+	for (int i = 0; i < IMAGE_SIZE; i++)
+	{
+		img[i] = rand();
+	}
+	SHA256CTX sha;
+	Sha256Init(&sha);
+	Sha256Update(&sha, img.data(), IMAGE_SIZE);
+	Sha256Final(&sha, hash);
+	uECC_sign(priv, hash, 32, sig, curve);
+
+	t = usNow();
+	for (cnt = 0; cnt < 20; cnt++)
+	{
+		ECDSAP256_VERIFY ctx;
+
+		EcdsaP256VerifyInit(&ctx, NULL, &comb);
+		for (int i = 0; i < IMAGE_SIZE; i += 4096)
+		{
+			EcdsaP256VerifyUpdate(&ctx, &img[i], 4096);
+		}
+		ok &= EcdsaP256VerifyFinal(&ctx, sig);
+	}
+	t = usNow() - t;
+	printf("  %d KB image hash+verify %8.1f us\n", IMAGE_SIZE >> 10, t / cnt);
+
+	Check(ok, "bench verify");
+}
+
+int main()
+{
+	srand(1);
+
+	printf("ECDSA P-256 verify, comb %d teeth, %d doublings\n\n", ECDSAP256_COMB_TEETH, ECDSAP256_COMB_SPACING);
+
+	printf("RFC 6979 vectors\n");
+	CheckRfc6979();
+	printf("Wycheproof style cases\n");
+	CheckWycheproofStyle();
+	printf("Random keys vs uECC, %d\n", RANDOM_ITER);
+	CheckRandom();
+	printf("Throughput\n");
+	Bench();
+
+	printf("\n%s\n", s_FailCnt == 0 ? "PASS" : "FAIL");
+
+	return s_FailCnt == 0 ? 0 : 1;
+}
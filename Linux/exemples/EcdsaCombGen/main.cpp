@@ -0,0 +1,239 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	ECDSA P-256 comb table generator
+
+Generates the C source of a comb table for EcdsaP256VerifyComb from a public
+key, run as part of the build of firmware verifying with a known key. Also
+generates the generator table src/ecdsa_p256_gcomb.c.
+
+Usage : EcdsaCombGen [-l] [-n name] [-o file.c] pubkey
+        EcdsaCombGen -g [-o file.c]
+
+	pubkey		: 128 hex characters, X then Y
+	-l			: X and Y are little endian, as in nrfutil generated keys
+	-n name		: Table variable name, default g_EcdsaP256KeyComb
+	-g			: Generator table g_EcdsaP256GComb
+	-o file.c	: Output file, default stdout
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+#include <libgen.h>
+#include <time.h>
+
+#include "ecdsa_p256.h"
+
+static const char *s_License =
+	"@license\n"
+	"\n"
+	"MIT License\n"
+	"\n"
+	"Copyright (c) %d I-SYST inc. All rights reserved.\n"
+	"\n"
+	"Permission is hereby granted, free of charge, to any person obtaining a copy\n"
+	"of this software and associated documentation files (the \"Software\"), to deal\n"
+	"in the Software without restriction, including without limitation the rights\n"
+	"to use, copy, modify, merge, publish, distribute, sublicense, and/or sell\n"
+	"copies of the Software, and to permit persons to whom the Software is\n"
+	"furnished to do so, subject to the following conditions:\n"
+	"\n"
+	"The above copyright notice and this permission notice shall be included in all\n"
+	"copies or substantial portions of the Software.\n"
+	"\n"
+	"THE SOFTWARE IS PROVIDED \"AS IS\", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR\n"
+	"IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,\n"
+	"FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE\n"
+	"AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER\n"
+	"LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,\n"
+	"OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE\n"
+	"SOFTWARE.\n"
+	"\n"
+	"----------------------------------------------------------------------------*/\n";
+
+static const char *s_Month[] = {
+	"Jan.", "Feb.", "Mar.", "Apr.", "May", "Jun.", "Jul.", "Aug.", "Sep.", "Oct.", "Nov.", "Dec."
+};
+
+static void Usage()
+{
+	printf("Usage : EcdsaCombGen [-l] [-n name] [-o file.c] pubkey\n");
+	printf("        EcdsaCombGen -g [-o file.c]\n");
+}
+
+static bool ParseKey(const char *pHex, bool bLittle, uint8_t *pKey)
+{
+	if (strlen(pHex) != ECDSAP256_KEY_LEN * 2)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < ECDSAP256_KEY_LEN; i++)
+	{
+		char s[3] = { pHex[i * 2], pHex[i * 2 + 1], 0 };
+		char *end;
+
+		pKey[i] = strtoul(s, &end, 16);
+		if (*end != 0)
+		{
+			return false;
+		}
+	}
+
+	// Library takes the configured byte order, tool is built big endian
+	if (bLittle != (ECDSAP256_LITTLE_ENDIAN != 0))
+	{
+		for (int k = 0; k < ECDSAP256_KEY_LEN; k += 32)
+		{
+			for (int i = 0; i < 16; i++)
+			{
+				uint8_t t = pKey[k + i];
+				pKey[k + i] = pKey[k + 31 - i];
+				pKey[k + 31 - i] = t;
+			}
+		}
+	}
+
+	return true;
+}
+
+static void PrintLimbs(FILE *fp, const uint32_t *v)
+{
+	fprintf(fp, "{ ");
+	for (int i = 0; i < 8; i++)
+	{
+		fprintf(fp, "0x%08x%s", v[i], i < 7 ? ", " : " }");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bool bgen = false, blittle = false;
+	const char *name = "g_EcdsaP256KeyComb";
+	const char *outname = NULL;
+	uint8_t key[ECDSAP256_KEY_LEN];
+	int opt;
+
+	while ((opt = getopt(argc, argv, "gln:o:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'g':
+				bgen = true;
+				break;
+			case 'l':
+				blittle = true;
+				break;
+			case 'n':
+				name = optarg;
+				break;
+			case 'o':
+				outname = optarg;
+				break;
+			default:
+				Usage();
+				return 1;
+		}
+	}
+
+	if (bgen)
+	{
+		name = "g_EcdsaP256GComb";
+	}
+	else if (optind >= argc || ParseKey(argv[optind], blittle, key) == false)
+	{
+		Usage();
+		return 1;
+	}
+
+	static ECDSAP256_COMB comb;
+
+	if (EcdsaP256CombInit(&comb, bgen ? NULL : key) == false)
+	{
+		fprintf(stderr, "Public key is not a P-256 curve point\n");
+		return 1;
+	}
+
+	FILE *fp = stdout;
+
+	if (outname != NULL)
+	{
+		fp = fopen(outname, "w");
+		if (fp == NULL)
+		{
+			perror(outname);
+			return 1;
+		}
+
+		char *tmp = strdup(outname);
+		time_t t = time(NULL);
+		struct tm *tm = localtime(&t);
+
+		fprintf(fp, "/**-------------------------------------------------------------------------\n");
+		fprintf(fp, "@file\t%s\n\n", basename(tmp));
+		if (bgen)
+		{
+			fprintf(fp, "@brief\tECDSA P-256 generator comb table.\n\n");
+		}
+		else
+		{
+			fprintf(fp, "@brief\tECDSA P-256 public key comb table for EcdsaP256VerifyComb.\n\n");
+			fprintf(fp, "Public key X|Y%s :\n", blittle ? " little endian" : "");
+			fprintf(fp, "%.64s\n%.64s\n\n", argv[optind], argv[optind] + 64);
+		}
+		fprintf(fp, "Generated by Linux/exemples/EcdsaCombGen, do not edit.\n\n");
+		fprintf(fp, "@author\tHoang Nguyen Hoan\n");
+		fprintf(fp, "@date\t%s %d, %d\n\n", s_Month[tm->tm_mon], tm->tm_mday, tm->tm_year + 1900);
+		fprintf(fp, s_License, tm->tm_year + 1900);
+		free(tmp);
+	}
+
+	fprintf(fp, "#include \"ecdsa_p256.h\"\n\n");
+	fprintf(fp, "const ECDSAP256_COMB %s = { {\n", name);
+	for (int i = 0; i < ECDSAP256_COMB_SIZE; i++)
+	{
+		fprintf(fp, "\t{\n\t\t");
+		PrintLimbs(fp, comb.Pt[i].x);
+		fprintf(fp, ",\n\t\t");
+		PrintLimbs(fp, comb.Pt[i].y);
+		fprintf(fp, "\n\t},\n");
+	}
+	fprintf(fp, "} };\n");
+
+	if (fp != stdout)
+	{
+		fclose(fp);
+	}
+
+	return 0;
+}
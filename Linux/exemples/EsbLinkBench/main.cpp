@@ -0,0 +1,352 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	ESB link goodput benchmark
+
+Saturates a simulated ESB PTX/PRX pair at several packet loss rates and
+compares the goodput of :
+	legacy	: previous EsbIntrf Tx path, radio FIFO kept full, whole FIFO
+			  flushed on TX_FAILED
+	raw		: pipelined radio FIFO, failed packet popped, no recovery
+	link	: EsbLink sliding window over the pipelined radio, with and
+			  without packing
+
+Goodput counts message bytes delivered in order. Link delivery is checked
+exactly once and in order, in both directions for the bidirectional run.
+
+Usage : EsbLinkBench [loss % ...]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "esb_link.h"
+#include "esb_radio_sim.h"
+
+#define RUN_TIME_US			2000000ULL
+#define RADIO_FIFO_SIZE		8		// NRF_ESB_TX_FIFO_SIZE
+#define NB_RETRY			3
+#define RETR_DELAY_US		600
+#define LINK_WINDOW			16
+#define LINK_PAYLOAD		252
+#define LINK_RTO_US			8000
+#define IDLE_US				100
+
+/// One end of a link, message generator and checker
+typedef struct {
+	EsbRadioSim *pSim;
+	int Node;
+	ESBLINK Link;
+	uint8_t LinkMem[ESBLINK_MEMSIZE(LINK_WINDOW, LINK_PAYLOAD)];
+	int MsgLen;
+	bool bSend;
+	uint32_t TxIdx;			// Next message to write
+	uint32_t RxIdx;			// Next message expected
+	uint32_t RxCnt;			// Messages received
+	uint64_t RxBytes;		// In order message bytes received
+	uint32_t ErrCnt;		// Corrupted, duplicate or out of order messages
+	bool bExact;			// Loss not allowed
+} ENDPOINT;
+
+static void MakeMsg(uint32_t Idx, uint8_t *pBuf, int Len)
+{
+	memcpy(pBuf, &Idx, 4);
+	for (int i = 4; i < Len; i++)
+	{
+		pBuf[i] = (Idx * 31 + i) & 0xFF;
+	}
+}
+
+static void CheckMsg(ENDPOINT *pEp, const uint8_t *pData, int Len)
+{
+	uint32_t idx;
+
+	if (Len != pEp->MsgLen)
+	{
+		pEp->ErrCnt++;
+		return;
+	}
+
+	memcpy(&idx, pData, 4);
+
+	for (int i = 4; i < Len; i++)
+	{
+		if (pData[i] != ((idx * 31 + i) & 0xFF))
+		{
+			pEp->ErrCnt++;
+			return;
+		}
+	}
+
+	if (idx < pEp->RxIdx || (pEp->bExact && idx != pEp->RxIdx))
+	{
+		pEp->ErrCnt++;
+		return;
+	}
+
+	pEp->RxIdx = idx + 1;
+	pEp->RxCnt++;
+	pEp->RxBytes += Len;
+}
+
+static bool LinkSendCB(void *pCtx, const uint8_t *pFrame, int Len)
+{
+	ENDPOINT *ep = (ENDPOINT*)pCtx;
+
+	return ep->pSim->Write(ep->Node, pFrame, Len);
+}
+
+static void LinkRecvCB(void *pCtx, const uint8_t *pData, int Len)
+{
+	CheckMsg((ENDPOINT*)pCtx, pData, Len);
+}
+
+static void LinkRadioTxCB(void *pCtx, bool bSent)
+{
+	ENDPOINT *ep = (ENDPOINT*)pCtx;
+
+	EsbLinkTxDone(&ep->Link, bSent, ep->pSim->usTime());
+}
+
+static void LinkRadioRxCB(void *pCtx, const uint8_t *pData, int Len)
+{
+	ENDPOINT *ep = (ENDPOINT*)pCtx;
+
+	EsbLinkRecv(&ep->Link, pData, Len, ep->pSim->usTime());
+}
+
+static void RawRadioRxCB(void *pCtx, const uint8_t *pData, int Len)
+{
+	CheckMsg((ENDPOINT*)pCtx, pData, Len);
+}
+
+static void LegacyRadioTxCB(void *pCtx, bool bSent)
+{
+	ENDPOINT *ep = (ENDPOINT*)pCtx;
+
+	if (bSent == false)
+	{
+		ep->pSim->Flush(ep->Node);
+	}
+}
+
+static void InitRadio(EsbRadioSim &Sim, double Loss)
+{
+	ESBRADIOSIM_CFG cfg = { Loss, NB_RETRY, RETR_DELAY_US, RADIO_FIFO_SIZE, 12345 };
+
+	Sim.Init(cfg);
+}
+
+static void InitEndpoint(ENDPOINT *pEp, EsbRadioSim *pSim, int Node, int MsgLen, bool bSend)
+{
+	memset(pEp, 0, sizeof(ENDPOINT));
+	pEp->pSim = pSim;
+	pEp->Node = Node;
+	pEp->MsgLen = MsgLen;
+	pEp->bSend = bSend;
+}
+
+static void InitLink(ENDPOINT *pEp, bool bPack)
+{
+	bool bptx = pEp->Node == ESBRADIOSIM_NODE_PTX;
+	ESBLINK_CFG cfg = {
+		pEp->LinkMem, sizeof(pEp->LinkMem), LINK_WINDOW, LINK_PAYLOAD,
+		// PRX header rides in ACK payloads, keep few queued so ACK info stays fresh
+		bptx ? RADIO_FIFO_SIZE : 2,
+		LINK_RTO_US, bPack, bptx,
+		LinkSendCB, LinkRecvCB, pEp
+	};
+
+	EsbLinkInit(&pEp->Link, &cfg);
+	pEp->bExact = true;
+	pEp->pSim->SetCallback(pEp->Node, LinkRadioTxCB, LinkRadioRxCB, pEp);
+}
+
+/// Run link, returns false on delivery error
+static bool RunLink(double Loss, int MsgLen, bool bPack, bool bBidir, double *pUp, double *pDown)
+{
+	EsbRadioSim sim;
+	ENDPOINT *ptx = new ENDPOINT;
+	ENDPOINT *prx = new ENDPOINT;
+	uint8_t msg[LINK_PAYLOAD];
+
+	InitRadio(sim, Loss);
+	InitEndpoint(ptx, &sim, ESBRADIOSIM_NODE_PTX, MsgLen, true);
+	InitEndpoint(prx, &sim, ESBRADIOSIM_NODE_PRX, MsgLen, bBidir);
+	InitLink(ptx, bPack);
+	InitLink(prx, bPack);
+
+	while (sim.usTime() < RUN_TIME_US)
+	{
+		ENDPOINT *ep[2] = { ptx, prx };
+		uint32_t now = sim.usTime();
+
+		for (int i = 0; i < 2; i++)
+		{
+			if (ep[i]->bSend == false)
+			{
+				continue;
+			}
+			MakeMsg(ep[i]->TxIdx, msg, MsgLen);
+			while (EsbLinkWrite(&ep[i]->Link, msg, MsgLen, now))
+			{
+				ep[i]->TxIdx++;
+				MakeMsg(ep[i]->TxIdx, msg, MsgLen);
+			}
+			EsbLinkProcess(&ep[i]->Link, now);
+		}
+
+		if (sim.Run() == false)
+		{
+			sim.Idle(IDLE_US);
+		}
+	}
+
+	bool ok = ptx->ErrCnt == 0 && prx->ErrCnt == 0 && prx->RxCnt > 0 && (bBidir == false || ptx->RxCnt > 0);
+
+	// Everything received was written, in order, exactly once
+	ok &= prx->RxIdx == prx->RxCnt && prx->RxCnt <= ptx->TxIdx;
+	ok &= ptx->RxIdx == ptx->RxCnt && ptx->RxCnt <= prx->TxIdx;
+
+	*pUp = prx->RxBytes * 8.0 / (RUN_TIME_US / 1000.0);
+	*pDown = ptx->RxBytes * 8.0 / (RUN_TIME_US / 1000.0);
+
+	delete ptx;
+	delete prx;
+
+	return ok;
+}
+
+/// Run raw radio PTX to PRX, one message per packet
+static bool RunRaw(double Loss, int MsgLen, bool bLegacy, double *pGoodput, double *pDelivered)
+{
+	EsbRadioSim sim;
+	ENDPOINT *ptx = new ENDPOINT;
+	ENDPOINT *prx = new ENDPOINT;
+	uint8_t msg[LINK_PAYLOAD];
+
+	InitRadio(sim, Loss);
+	InitEndpoint(ptx, &sim, ESBRADIOSIM_NODE_PTX, MsgLen, true);
+	InitEndpoint(prx, &sim, ESBRADIOSIM_NODE_PRX, MsgLen, false);
+	sim.SetCallback(ESBRADIOSIM_NODE_PTX, bLegacy ? LegacyRadioTxCB : NULL, NULL, ptx);
+	sim.SetCallback(ESBRADIOSIM_NODE_PRX, NULL, RawRadioRxCB, prx);
+
+	while (sim.usTime() < RUN_TIME_US)
+	{
+		while (sim.TxFifoCount(ESBRADIOSIM_NODE_PTX) < RADIO_FIFO_SIZE)
+		{
+			MakeMsg(ptx->TxIdx, msg, MsgLen);
+			sim.Write(ESBRADIOSIM_NODE_PTX, msg, MsgLen);
+			ptx->TxIdx++;
+		}
+		sim.Run();
+	}
+
+	*pGoodput = prx->RxBytes * 8.0 / (RUN_TIME_US / 1000.0);
+	// Packets still in radio FIFO are not counted as lost
+	uint32_t sent = ptx->TxIdx - sim.TxFifoCount(ESBRADIOSIM_NODE_PTX);
+
+	*pDelivered = sent ? 100.0 * prx->RxCnt / sent : 0.0;
+
+	bool ok = prx->ErrCnt == 0;
+
+	delete ptx;
+	delete prx;
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	double lossdef[] = { 0, 1, 5, 10, 20, 30 };
+	double *loss = lossdef;
+	int nbloss = sizeof(lossdef) / sizeof(lossdef[0]);
+	int msglen[] = { 16, 240 };
+	bool ok = true;
+
+	if (argc > 1)
+	{
+		nbloss = argc - 1;
+		loss = new double[nbloss];
+		for (int i = 0; i < nbloss; i++)
+		{
+			loss[i] = atof(argv[i + 1]);
+		}
+	}
+
+	printf("ESB link goodput, 2 Mbps, %d retries, %d us retransmit delay, %d deep radio FIFO\n",
+		   NB_RETRY, RETR_DELAY_US, RADIO_FIFO_SIZE);
+	printf("Goodput in kbps PTX to PRX, raw delivered %% in ()\n\n");
+
+	for (size_t m = 0; m < sizeof(msglen) / sizeof(msglen[0]); m++)
+	{
+		printf("%d bytes messages\n", msglen[m]);
+		printf("  loss    legacy             raw                link       link pack\n");
+
+		for (int i = 0; i < nbloss; i++)
+		{
+			double l = loss[i] / 100.0;
+			double lg, ld, rg, rd, up, down, pup;
+			bool res = true;
+
+			res &= RunRaw(l, msglen[m], true, &lg, &ld);
+			res &= RunRaw(l, msglen[m], false, &rg, &rd);
+			res &= RunLink(l, msglen[m], false, false, &up, &down);
+			res &= RunLink(l, msglen[m], true, false, &pup, &down);
+
+			printf("  %4.1f%%  %7.1f (%5.1f%%)  %7.1f (%5.1f%%)  %7.1f    %7.1f    %s\n",
+				   loss[i], lg, ld, rg, rd, up, pup, res ? "PASS" : "FAIL");
+			ok &= res;
+		}
+		printf("\n");
+	}
+
+	printf("Bidirectional, 16 bytes messages, link pack\n");
+	printf("  loss    up       down\n");
+	for (int i = 0; i < nbloss; i++)
+	{
+		double up, down;
+		bool res = RunLink(loss[i] / 100.0, 16, true, true, &up, &down);
+
+		printf("  %4.1f%%  %7.1f  %7.1f  %s\n", loss[i], up, down, res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	if (loss != lossdef)
+	{
+		delete[] loss;
+	}
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,143 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Flash memory mapped read benchmark
+
+Compares random small reads through DiskIO::Read (sector cache) against direct
+access through the memory mapped view of a flash image.
+
+Usage : FlashMemMapBench [image file] [read size] [read count]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#include "diskio_flashimg.h"
+
+#define FLASH_SIZE_KB		(32 * 1024 / 8)		// 32 Mbits
+#define READ_SIZE			16
+#define READ_COUNT			1000000
+
+uint8_t g_CacheMem[DISKIO_SECT_SIZE];
+DISKIO_CACHE_DESC g_Cache = {
+	-1, 0xFFFFFFFF, g_CacheMem
+};
+
+FlashImgDiskIO g_FlashImg;
+
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "/tmp/iosonata_flash.bin";
+	int rdsize = argc > 2 ? atoi(argv[2]) : READ_SIZE;
+	int rdcnt = argc > 3 ? atoi(argv[3]) : READ_COUNT;
+
+	if (rdsize <= 0 || rdsize > DISKIO_SECT_SIZE || rdcnt <= 0)
+	{
+		printf("Invalid parameters\n");
+		return 1;
+	}
+
+	if (g_FlashImg.Init(path, FLASH_SIZE_KB, 4, false, &g_Cache, 1) == false)
+	{
+		printf("Failed to open flash image %s\n", path);
+		return 1;
+	}
+
+	const uint8_t *mem = g_FlashImg.MemMap();
+	uint32_t size = FLASH_SIZE_KB * 1024;
+
+	// Fill image with pattern
+	uint8_t d[DISKIO_SECT_SIZE];
+	srand(1);
+	for (uint32_t sect = 0; sect < size / DISKIO_SECT_SIZE; sect++)
+	{
+		for (int i = 0; i < DISKIO_SECT_SIZE; i++)
+		{
+			d[i] = rand();
+		}
+		g_FlashImg.SectWrite(sect, d);
+	}
+
+	uint32_t *offs = new uint32_t[rdcnt];
+	for (int i = 0; i < rdcnt; i++)
+	{
+		offs[i] = (uint32_t)rand() % (size - rdsize);
+	}
+
+	uint8_t buff[DISKIO_SECT_SIZE];
+	uint32_t sum1 = 0, sum2 = 0;
+
+	auto t_start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < rdcnt; i++)
+	{
+		g_FlashImg.Read((uint64_t)offs[i], buff, rdsize);
+		sum1 += buff[0] + buff[rdsize - 1];
+	}
+	auto t_end = std::chrono::high_resolution_clock::now();
+	double tdisk = std::chrono::duration<double, std::nano>(t_end - t_start).count();
+
+	t_start = std::chrono::high_resolution_clock::now();
+	for (int i = 0; i < rdcnt; i++)
+	{
+		const uint8_t *p = mem + offs[i];
+		sum2 += p[0] + p[rdsize - 1];
+	}
+	t_end = std::chrono::high_resolution_clock::now();
+	double tmap = std::chrono::duration<double, std::nano>(t_end - t_start).count();
+
+	printf("Random %d bytes reads x %d\n", rdsize, rdcnt);
+	printf("DiskIO::Read  : %8.1f ns/read\n", tdisk / rdcnt);
+	printf("Mapped view   : %8.1f ns/read\n", tmap / rdcnt);
+	printf("Speedup       : %8.1fx\n", tdisk / tmap);
+	printf("Data %s\n", sum1 == sum2 ? "match" : "MISMATCH");
+
+	// Data written through the sector cache must show in the view
+	uint8_t wr[READ_SIZE];
+	uint64_t woff = size / 2 + 100;
+
+	for (int i = 0; i < READ_SIZE; i++)
+	{
+		wr[i] = ~mem[woff + i];
+	}
+	g_FlashImg.Write(woff, wr, READ_SIZE);
+
+	const uint8_t *p = g_FlashImg.MemMap(woff, READ_SIZE);
+	bool coherent = p != NULL && memcmp(p, wr, READ_SIZE) == 0;
+
+	printf("Cached write %s through view\n", coherent ? "visible" : "NOT VISIBLE");
+
+	delete[] offs;
+	g_FlashImg.Close();
+
+	return sum1 == sum2 && coherent ? 0 : 1;
+}
@@ -0,0 +1,473 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Intel HEX streaming parser and image builder check and benchmark
+
+Generates a multi MB hex file with extended linear and segment addresses,
+gaps, 64KB wrapping records and CR LF/LF line endings. Parses it in random
+chunks into a sparse page image and checks it against the reference, checks
+malformed input, then measures throughput against the previous way of line
+splitting, IHexParseRecord on each line and address tracking by the caller.
+
+Usage : IHexBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+#include <string>
+#include <map>
+
+#include "convutil.h"
+#include "intelhex.h"
+
+#define CHECK_SIZE			(1024 * 1024)
+#define DATA_SIZE			(8 * 1024 * 1024)
+#define IMAGE_MEM_SIZE		(32 * 1024 * 1024)
+#define BENCH_LOOP			5
+
+static int s_FailCnt = 0;
+
+static void Check(bool bOk, const char *pMsg)
+{
+	if (bOk == false)
+	{
+		printf("  FAIL : %s\n", pMsg);
+		s_FailCnt++;
+	}
+}
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static void AddRecord(std::string &Hex, int Type, uint16_t Offset, const uint8_t *pData, int Len, bool bCrLf)
+{
+	char s[16];
+	uint8_t cs = Len + (Offset >> 8) + (Offset & 0xff) + Type;
+
+	snprintf(s, sizeof(s), ":%02X%04X%02X", Len, Offset, Type);
+	Hex += s;
+	for (int i = 0; i < Len; i++)
+	{
+		snprintf(s, sizeof(s), "%02X", pData[i]);
+		Hex += s;
+		cs += pData[i];
+	}
+	snprintf(s, sizeof(s), "%02X", (uint8_t)-cs);
+	Hex += s;
+	Hex += bCrLf ? "\r\n" : "\n";
+}
+
+/// Random hex file, reference content returned as address -> byte map if pRef not NULL
+static void Generate(std::string &Hex, std::map<uint32_t, uint8_t> *pRef, int Size)
+{
+	uint32_t addr = 0x08000000;
+	uint32_t base = 0xffffffff;
+	bool bcrlf = rand() & 1;
+	uint8_t d[255];
+
+	while (Size > 0)
+	{
+		int cnt = (rand() % 4) == 0 ? 1 + rand() % 255 : (rand() & 1 ? 16 : 32);
+
+		if ((rand() % 500) == 0)
+		{
+			// Gap
+			addr += rand() % 100000;
+		}
+		if ((addr >> 16) != (base >> 16))
+		{
+			base = addr & 0xffff0000;
+			d[0] = base >> 24;
+			d[1] = base >> 16;
+			AddRecord(Hex, IHEX_RECTYPE_EXTLADDR, 0, d, 2, bcrlf);
+		}
+		for (int i = 0; i < cnt; i++)
+		{
+			d[i] = rand();
+		}
+		// Record may wrap within 64KB segment
+		for (int i = 0; pRef != NULL && i < cnt; i++)
+		{
+			(*pRef)[base + ((addr + i) & 0xffff)] = d[i];
+		}
+		AddRecord(Hex, IHEX_RECTYPE_DATA, addr & 0xffff, d, cnt, bcrlf);
+		addr += cnt;
+		if ((addr >> 16) != (base >> 16))
+		{
+			// Continue in the segment the wrapped bytes went to
+			addr = base + (addr & 0xffff);
+			addr += 0x10000;
+		}
+		Size -= cnt;
+	}
+
+	// Segment addressing, 0x1234:0 -> 0x12340
+	d[0] = 0x12;
+	d[1] = 0x34;
+	AddRecord(Hex, IHEX_RECTYPE_EXTSEG, 0, d, 2, bcrlf);
+	for (int i = 0; i < 16; i++)
+	{
+		d[i] = i;
+		if (pRef != NULL)
+		{
+			(*pRef)[0x12340 + 0x100 + i] = i;
+		}
+	}
+	AddRecord(Hex, IHEX_RECTYPE_DATA, 0x100, d, 16, bcrlf);
+
+	d[0] = 0x08;
+	d[1] = 0x00;
+	d[2] = 0x01;
+	d[3] = 0x23;
+	AddRecord(Hex, IHEX_RECTYPE_STARTLADDR, 0, d, 4, bcrlf);
+	AddRecord(Hex, IHEX_RECTYPE_EOF, 0, d, 0, bcrlf);
+}
+
+static bool CheckImage(IHEXIMAGE &Img, const std::map<uint32_t, uint8_t> &Ref)
+{
+	bool ok = true;
+	uint32_t nbbyte = 0;
+
+	// Every written byte is in image
+	for (std::map<uint32_t, uint8_t>::const_iterator it = Ref.begin(); it != Ref.end() && ok; it++)
+	{
+		uint8_t b;
+
+		IHexImageRead(&Img, it->first, &b, 1);
+		ok = b == it->second;
+	}
+
+	// Everything else is fill
+	for (int i = 0; i < Img.NbPage && ok; i++)
+	{
+		uint32_t addr;
+		uint8_t *p = IHexImagePage(&Img, i, &addr);
+
+		for (uint32_t k = 0; k < Img.PageSize && ok; k++)
+		{
+			std::map<uint32_t, uint8_t>::const_iterator it = Ref.find(addr + k);
+
+			if (it == Ref.end())
+			{
+				ok = p[k] == Img.Fill;
+			}
+			else
+			{
+				nbbyte++;
+			}
+		}
+	}
+
+	return ok && nbbyte == Ref.size();
+}
+
+static void CheckParse(const std::string &Hex, const std::map<uint32_t, uint8_t> &Ref, std::vector<uint8_t> &Mem)
+{
+	for (int iter = 0; iter < 4; iter++)
+	{
+		IHEXIMAGE img;
+		IHEXPARSER hex;
+		size_t i = 0;
+
+		IHexImageInit(&img, Mem.data(), Mem.size(), 256 << iter, 0xFF);
+		IHexParserInit(&hex, IHexImageDataCB, &img);
+
+		while (i < Hex.size())
+		{
+			size_t l = std::min(Hex.size() - i, (size_t)(1 + rand() % (iter == 0 ? 7 : 5000)));
+
+			IHexParse(&hex, &Hex[i], l);
+			i += l;
+		}
+		Check(IHexParserFinish(&hex) == IHEX_ERR_NONE, "parse");
+		Check(hex.bStartValid && hex.StartAddr == 0x08000123, "start address");
+		Check(CheckImage(img, Ref), "image content");
+
+		// Ranges cover all pages, in order, without overlap or adjacency
+		IHEXRANGE r;
+		uint32_t npage = 0, prevend = 0;
+		bool ok = true;
+
+		for (int k = 0; (k = IHexImageRange(&img, k, &r)) > 0; )
+		{
+			ok &= (r.Addr & (img.PageSize - 1)) == 0 && (npage == 0 || r.Addr > prevend);
+			prevend = r.Addr + r.Len;
+			npage += r.Len / img.PageSize;
+		}
+		Check(ok && npage == (uint32_t)img.NbPage, "ranges");
+	}
+}
+
+static void CheckErrors()
+{
+	static const struct {
+		const char *pHex;
+		IHEX_ERR Err;
+		uint32_t Line;
+	} s_Err[] = {
+		{ ":0400000001020304F2\n:00000001FF\n", IHEX_ERR_NONE, 2 },
+		{ ":0400000001020304F2\n:00000001FF", IHEX_ERR_NONE, 2 },
+		{ "\r\n:0400000001020304F2\r\n\r\n:00000001FF\r\n", IHEX_ERR_NONE, 4 },
+		{ ":0400000001020304F3\n:00000001FF\n", IHEX_ERR_CHECKSUM, 1 },
+		{ ":0400000001020304F\n", IHEX_ERR_FORMAT, 1 },
+		{ ":04000000010203G4F2\n", IHEX_ERR_FORMAT, 1 },
+		{ "0400000001020304F2\n", IHEX_ERR_FORMAT, 1 },
+		{ ":0500000001020304F1\n", IHEX_ERR_LENGTH, 1 },
+		{ ":00000006FA\n", IHEX_ERR_RECORD, 1 },
+		{ ":0400000001020304F2\n", IHEX_ERR_NOEOF, 1 },
+		{ ":00000001FF\ngarbage\n", IHEX_ERR_NONE, 2 },
+	};
+
+	for (size_t i = 0; i < sizeof(s_Err) / sizeof(s_Err[0]); i++)
+	{
+		IHEXPARSER hex;
+		const char *p = s_Err[i].pHex;
+
+		IHexParserInit(&hex, NULL, NULL);
+		for (int k = 0; p[k] != '\0'; k++)
+		{
+			IHexParse(&hex, &p[k], 1);
+		}
+		IHEX_ERR err = IHexParserFinish(&hex);
+
+		if (err != s_Err[i].Err || hex.LineNo != s_Err[i].Line)
+		{
+			printf("  FAIL : case %d err %d line %u\n", (int)i, err, hex.LineNo);
+			s_FailCnt++;
+		}
+	}
+
+	// Line too long
+	std::string l(":");
+	l.append(600, '0');
+	l += "\n";
+	IHEXPARSER hex;
+	IHexParserInit(&hex, NULL, NULL);
+	Check(IHexParse(&hex, l.c_str(), 100) == IHEX_ERR_NONE && IHexParse(&hex, l.c_str() + 100, l.size() - 100) == IHEX_ERR_LENGTH, "long line");
+
+	// Image full
+	uint8_t mem[2 * (256 + sizeof(IHEXPAGE))];
+	uint8_t d[16] = { 0 };
+	IHEXIMAGE img;
+	IHexImageInit(&img, mem, sizeof(mem), 256, 0xFF);
+	Check(IHexImageWrite(&img, 0x1000, d, 16) && IHexImageWrite(&img, 0x10, d, 16) && IHexImageWrite(&img, 0x1010, d, 16), "image 2 pages");
+	Check(IHexImageWrite(&img, 0x2000, d, 16) == false, "image full");
+	Check(img.pPage[0].Addr == 0 && img.pPage[1].Addr == 0x1000, "page order");
+
+	// Single record API
+	IHEXDATA rec;
+	char r1[] = ":10010000214601360121470136007EFE09D2190140\r\n";
+	char r2[] = ":20010000214601360121470136007EFE09D2190140214601360121470136007EFE09D2190140";
+	Check(IHexParseRecord(r1, &rec) && rec.Count == 16 && rec.Offset == 0x100 && rec.Type == 0 && rec.Data[15] == 0x01, "IHexParseRecord");
+	Check(IHexParseRecord(r2, &rec) == false, "IHexParseRecord too long");
+}
+
+/// Previous usage : split lines, IHexParseRecord, caller tracks addresses
+static bool LegacyParseRecord(char *pRec, IHEXDATA *pData)
+{
+	char *p = pRec + 1;
+	int8_t cs = 0;
+
+	pData->Count = (chex2i(*p++) << 4);
+	pData->Count += chex2i(*p++);
+	pData->Offset = (chex2i(*p++) << 12);
+	pData->Offset += (chex2i(*p++) << 8);
+	pData->Offset += (chex2i(*p++) << 4);
+	pData->Offset += chex2i(*p++);
+	pData->Type = (chex2i(*p++) << 4);
+	pData->Type += chex2i(*p++);
+
+	cs += pData->Count + (pData->Offset & 0xff) + ((pData->Offset >> 8u) & 0xff) + pData->Type;
+
+	for (int i = 0; i < pData->Count; i++)
+	{
+		pData->Data[i] = (chex2i(*p++) << 4);
+		pData->Data[i] += chex2i(*p++);
+		cs += pData->Data[i];
+	}
+
+	pData->Checksum = (chex2i(*p++) << 4);
+	pData->Checksum += chex2i(*p++);
+	cs += pData->Checksum;
+
+	return cs == 0;
+}
+
+static bool LegacyParse(const std::string &Hex, std::vector<uint8_t> &Flat, uint32_t FlatBase)
+{
+	char line[600];
+	const char *p = Hex.c_str();
+	const char *end = p + Hex.size();
+	uint32_t base = 0;
+	IHEXDATA rec;
+
+	while (p < end)
+	{
+		int l = 0;
+
+		while (p < end && *p != '\n' && l < (int)sizeof(line) - 1)
+		{
+			line[l++] = *p++;
+		}
+		line[l] = '\0';
+		p++;
+
+		if (LegacyParseRecord(line, &rec) == false)
+		{
+			return false;
+		}
+		switch (rec.Type)
+		{
+			case IHEX_RECTYPE_DATA:
+				for (int i = 0; i < rec.Count; i++)
+				{
+					uint32_t a = base + ((rec.Offset + i) & 0xffff) - FlatBase;
+
+					if (a < Flat.size())
+					{
+						Flat[a] = rec.Data[i];
+					}
+				}
+				break;
+			case IHEX_RECTYPE_EXTLADDR:
+				base = ((rec.Data[0] << 8) | rec.Data[1]) << 16;
+				break;
+			case IHEX_RECTYPE_EXTSEG:
+				base = ((rec.Data[0] << 8) | rec.Data[1]) << 4;
+				break;
+		}
+	}
+
+	return true;
+}
+
+static void Bench(std::vector<uint8_t> &Mem)
+{
+	// Previous parser only takes 16 bytes records
+	std::string hex16, hexmix;
+	std::vector<uint8_t> flat(DATA_SIZE + (DATA_SIZE >> 3));
+	uint8_t d[16];
+	uint32_t addr = 0x08000000;
+
+	for (int i = 0; i < DATA_SIZE; i += 16, addr += 16)
+	{
+		if ((addr & 0xffff) == 0)
+		{
+			d[0] = addr >> 24;
+			d[1] = addr >> 16;
+			AddRecord(hex16, IHEX_RECTYPE_EXTLADDR, 0, d, 2, true);
+		}
+		for (int k = 0; k < 16; k++)
+		{
+			d[k] = rand();
+		}
+		AddRecord(hex16, IHEX_RECTYPE_DATA, addr & 0xffff, d, 16, true);
+	}
+	AddRecord(hex16, IHEX_RECTYPE_EOF, 0, d, 0, true);
+	Generate(hexmix, NULL, DATA_SIZE);
+
+	double t = usNow();
+	bool ok = true;
+
+	for (int i = 0; i < BENCH_LOOP; i++)
+	{
+		ok &= LegacyParse(hex16, flat, 0x08000000);
+	}
+	t = usNow() - t;
+	Check(ok, "legacy parse");
+	printf("  legacy, 16 bytes records      %8.1f MB/s of text\n", (double)hex16.size() * BENCH_LOOP / t);
+
+	const std::string *src[2] = { &hex16, &hexmix };
+	const char *name[2] = { "16 bytes records", "mixed records" };
+
+	for (int s = 0; s < 2; s++)
+	{
+		for (int c = 0; c < 2; c++)
+		{
+			int chunk = c == 0 ? 64 : 4096;
+			IHEXIMAGE img;
+			IHEXPARSER hex;
+
+			t = usNow();
+			for (int i = 0; i < BENCH_LOOP; i++)
+			{
+				IHexImageInit(&img, Mem.data(), Mem.size(), 4096, 0xFF);
+				IHexParserInit(&hex, IHexImageDataCB, &img);
+				for (size_t k = 0; k < src[s]->size(); k += chunk)
+				{
+					IHexParse(&hex, src[s]->c_str() + k, std::min((size_t)chunk, src[s]->size() - k));
+				}
+				ok &= IHexParserFinish(&hex) == IHEX_ERR_NONE;
+			}
+			t = usNow() - t;
+			Check(ok, "stream parse");
+			if (s == 0)
+			{
+				ok &= memcmp(IHexImagePage(&img, 0, NULL), flat.data(), 4096) == 0;
+				Check(ok, "stream vs legacy");
+			}
+			printf("  stream, %-16s %4d B %8.1f MB/s of text, %d pages\n", name[s], chunk,
+				   (double)src[s]->size() * BENCH_LOOP / t, img.NbPage);
+		}
+	}
+}
+
+int main()
+{
+	std::string hex;
+	std::map<uint32_t, uint8_t> ref;
+	std::vector<uint8_t> mem(IMAGE_MEM_SIZE);
+
+	srand(1);
+	Generate(hex, &ref, CHECK_SIZE);
+
+	printf("Intel HEX\n\n");
+
+	printf("Errors\n");
+	CheckErrors();
+	printf("Random chunks, %.1f MB of text\n", hex.size() / 1048576.0);
+	CheckParse(hex, ref, mem);
+	printf("Throughput, %d MB of data\n", DATA_SIZE >> 20);
+	Bench(mem);
+
+	printf("\n%s\n", s_FailCnt == 0 ? "PASS" : "FAIL");
+
+	return s_FailCnt == 0 ? 0 : 1;
+}
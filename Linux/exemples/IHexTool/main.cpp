@@ -0,0 +1,194 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Intel HEX file tool
+
+Streams a hex file through the Intel HEX parser into a sparse page image,
+prints the coalesced flash ranges and optionally writes the image as a flat
+binary.
+
+Usage : IHexTool [-c chunk] [-p pagesize] [-f fill] [-o out.bin] file.hex
+
+	-c chunk	: Read size in bytes, default 4096
+	-p pagesize	: Image page size, default 4096
+	-f fill		: Value of bytes not in file, default 0xFF
+	-o out.bin	: Write binary from lowest to highest page
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <vector>
+
+#include "intelhex.h"
+
+#define IMAGE_MEM_SIZE		(256 * 1024 * 1024)
+
+static const char *s_ErrStr[] = {
+	"none", "format", "length", "checksum", "record", "image full", "no EOF record"
+};
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+int main(int argc, char **argv)
+{
+	int chunk = 4096;
+	uint32_t pagesize = 4096;
+	int fill = 0xFF;
+	const char *outname = NULL;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "c:p:f:o:")) != -1)
+	{
+		switch (opt)
+		{
+			case 'c':
+				chunk = strtol(optarg, NULL, 0);
+				break;
+			case 'p':
+				pagesize = strtoul(optarg, NULL, 0);
+				break;
+			case 'f':
+				fill = strtol(optarg, NULL, 0);
+				break;
+			case 'o':
+				outname = optarg;
+				break;
+			default:
+				printf("Usage : IHexTool [-c chunk] [-p pagesize] [-f fill] [-o out.bin] file.hex\n");
+				return 1;
+		}
+	}
+
+	if (optind >= argc || chunk <= 0)
+	{
+		printf("Usage : IHexTool [-c chunk] [-p pagesize] [-f fill] [-o out.bin] file.hex\n");
+		return 1;
+	}
+
+	int fd = open(argv[optind], O_RDONLY);
+
+	if (fd < 0)
+	{
+		perror(argv[optind]);
+		return 1;
+	}
+
+	std::vector<uint8_t> mem(IMAGE_MEM_SIZE);
+	std::vector<char> buf(chunk);
+	IHEXIMAGE img;
+	IHEXPARSER hex;
+	uint64_t total = 0;
+	int l;
+
+	if (IHexImageInit(&img, mem.data(), mem.size(), pagesize, fill) == false)
+	{
+		printf("Invalid page size %u\n", pagesize);
+		return 1;
+	}
+	IHexParserInit(&hex, IHexImageDataCB, &img);
+
+	double t = usNow();
+
+	while ((l = read(fd, buf.data(), chunk)) > 0)
+	{
+		total += l;
+		if (IHexParse(&hex, buf.data(), l) != IHEX_ERR_NONE)
+		{
+			break;
+		}
+	}
+	close(fd);
+
+	IHEX_ERR err = IHexParserFinish(&hex);
+
+	t = usNow() - t;
+
+	if (err != IHEX_ERR_NONE)
+	{
+		printf("Error : %s at line %u\n", s_ErrStr[err], hex.LineNo);
+		return 1;
+	}
+
+	printf("%u lines, %u data records, %u bytes, %llu bytes of text in %.1f ms (%.1f MB/s)\n",
+		   hex.LineNo, hex.RecCnt, hex.ByteCnt, (unsigned long long)total, t / 1000.0, total / t);
+	if (hex.bStartValid)
+	{
+		printf("Start address 0x%08x\n", hex.StartAddr);
+	}
+	printf("%d pages of %u bytes\n", img.NbPage, img.PageSize);
+
+	IHEXRANGE r;
+
+	for (int i = 0; (i = IHexImageRange(&img, i, &r)) > 0; )
+	{
+		printf("  0x%08x - 0x%08x  %u bytes\n", r.Addr, r.Addr + r.Len - 1, r.Len);
+	}
+
+	if (outname != NULL && img.NbPage > 0)
+	{
+		uint32_t start, end;
+
+		IHexImagePage(&img, 0, &start);
+		IHexImagePage(&img, img.NbPage - 1, &end);
+		end += img.PageSize;
+
+		FILE *fp = fopen(outname, "wb");
+
+		if (fp == NULL)
+		{
+			perror(outname);
+			return 1;
+		}
+
+		std::vector<uint8_t> page(img.PageSize);
+
+		for (uint32_t a = start; a != end; a += img.PageSize)
+		{
+			IHexImageRead(&img, a, page.data(), img.PageSize);
+			fwrite(page.data(), 1, img.PageSize, fp);
+		}
+		fclose(fp);
+		printf("Binary 0x%08x - 0x%08x written to %s\n", start, end - 1, outname);
+	}
+
+	return 0;
+}
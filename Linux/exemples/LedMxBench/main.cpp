@@ -0,0 +1,341 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	LED matrix framebuffer check & benchmark
+
+Runs the LedMx text functions against simulated HT1632 panels, with and
+without framebuffer. Panel RAM is checked against a reference renderer for
+justified text, counters, left & right scrolling and random framebuffer edits.
+Reports bits transmitted per frame for each scenario.
+
+Usage : LedMxBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <random>
+#include <vector>
+
+#include "miscdev/ledmx.h"
+#include "ledmx_sim.h"
+
+#define NB_PANEL			4
+#define NB_COL				(NB_PANEL * LEDMX_PANEL_NBCOL)
+#define NB_RANDOM_LOOP		5000
+
+static std::mt19937 s_Rng(42);
+
+static int RandRange(int Min, int Max)
+{
+	std::uniform_int_distribution<int> d(Min, Max);
+	return d(s_Rng);
+}
+
+// Panels wired in reverse order to catch address mix ups
+static const int s_PanelAddr[NB_PANEL] = { 3, 2, 1, 0 };
+
+/// Display with its own simulated panel chain
+class Display {
+public:
+	Display(bool bFb) {
+		LEDMXCFG cfg;
+
+		memset(&cfg, 0, sizeof(cfg));
+		memset(&vDev, 0, sizeof(vDev));
+		cfg.pIOCfg = &vSim;
+		cfg.NbPanel = NB_PANEL;
+		memcpy(cfg.PanelAddr, s_PanelAddr, sizeof(s_PanelAddr));
+		cfg.pFbMem = bFb ? vFbMem : NULL;
+		LedMxInit(&vDev, &cfg);
+		vSim.ResetStats();
+	}
+
+	/// Panel RAM matches expected columns
+	bool Match(const std::vector<uint8_t> &Exp) {
+		for (int c = 0; c < NB_COL; c++)
+		{
+			if (vSim.Column(s_PanelAddr[c / LEDMX_PANEL_NBCOL], c % LEDMX_PANEL_NBCOL) != Exp[c])
+			{
+				return false;
+			}
+		}
+		return vSim.ErrCount() == 0;
+	}
+
+	LEDMXDEV vDev;
+	LedMxSim vSim;
+	uint8_t vFbMem[LEDMX_FBMEM_SIZE(NB_PANEL)];
+};
+
+/// Reference rendering of text starting at Col
+static std::vector<uint8_t> Render(int Col, const char *pStr)
+{
+	std::vector<uint8_t> cols(NB_COL, 0);
+
+	for (; *pStr; pStr++)
+	{
+		const LEDMXFONT_BITMAP &g = g_FontBitmap[(uint8_t)*pStr];
+
+		for (int i = 0; i < g.Width; i++, Col++)
+		{
+			if (Col >= 0 && Col < NB_COL)
+			{
+				cols[Col] = g.Data[i];
+			}
+		}
+	}
+
+	return cols;
+}
+
+typedef struct {
+	const char *pName;
+	uint64_t Bits[2];		// legacy, framebuffer
+	uint32_t Frames;
+	bool bOk[2];
+} RESULT;
+
+static void Report(const RESULT &r)
+{
+	printf("  %-24s %6u frames  legacy %8.1f bits/frame %s  framebuffer %8.1f bits/frame %s  x%.1f\n",
+		   r.pName, r.Frames, (double)r.Bits[0] / r.Frames, r.bOk[0] ? "PASS" : "FAIL",
+		   (double)r.Bits[1] / r.Frames, r.bOk[1] ? "PASS" : "FAIL",
+		   r.Bits[1] ? (double)r.Bits[0] / r.Bits[1] : 0.0);
+}
+
+static bool Justify()
+{
+	RESULT r = { "justified text", { 0, 0 }, 0, { true, true } };
+	const char *text[] = { "Hello World", "IOsonata", "12:34:56", "Hello World" };
+
+	for (int m = 0; m < 2; m++)
+	{
+		Display d(m == 1);
+
+		for (size_t i = 0; i < sizeof(text) / sizeof(text[0]); i++)
+		{
+			int len = LedMxPixStrLen(&d.vDev, text[i]);
+
+			LedMxPrintLeft(&d.vDev, text[i]);
+			r.bOk[m] &= d.Match(Render(0, text[i]));
+			LedMxPrintCenter(&d.vDev, text[i]);
+			r.bOk[m] &= d.Match(Render((NB_COL - len) >> 1, text[i]));
+			LedMxPrintRight(&d.vDev, text[i]);
+			r.bOk[m] &= d.Match(Render(NB_COL - len, text[i]));
+			// Same text again
+			LedMxPrintRight(&d.vDev, text[i]);
+			r.bOk[m] &= d.Match(Render(NB_COL - len, text[i]));
+		}
+		r.Bits[m] = d.vSim.TxBits();
+	}
+	r.Frames = 4 * sizeof(text) / sizeof(text[0]);
+	Report(r);
+
+	return r.bOk[0] && r.bOk[1];
+}
+
+static bool Counter()
+{
+	RESULT r = { "counter", { 0, 0 }, 0, { true, true } };
+	char s[32];
+
+	for (int m = 0; m < 2; m++)
+	{
+		Display d(m == 1);
+
+		for (int n = 0; n < 1000; n++)
+		{
+			snprintf(s, sizeof(s), "Count %4d", n);
+			LedMxPrintf(&d.vDev, LEDMXPRTMODE_JLEFT, "Count %4d", n);
+			if (n % 97 == 0)
+			{
+				r.bOk[m] &= d.Match(Render(0, s));
+			}
+		}
+		r.bOk[m] &= d.Match(Render(0, s));
+		r.Bits[m] = d.vSim.TxBits();
+	}
+	r.Frames = 1000;
+	Report(r);
+
+	return r.bOk[0] && r.bOk[1];
+}
+
+static bool Scroll(bool bRight)
+{
+	RESULT r = { bRight ? "scroll right" : "scroll left", { 0, 0 }, 0, { true, true } };
+	const char *text = "The quick brown fox jumps over the lazy dog 0123456789";
+	int len;
+
+	// Legacy, blocking
+	{
+		Display d(false);
+
+		len = LedMxPixStrLen(&d.vDev, text);
+		if (bRight)
+		{
+			LedMxPrintScrollRight(&d.vDev, text);
+			r.bOk[0] &= d.Match(Render(NB_COL - 1, text));
+		}
+		else
+		{
+			LedMxPrintScrollLeft(&d.vDev, text);
+			r.bOk[0] &= d.Match(Render(1 - len, text));
+		}
+		r.Bits[0] = d.vSim.TxBits();
+	}
+
+	// Framebuffer, step by step
+	Display d(true);
+	LEDMXSCROLL scroll;
+	int step = 0;
+
+	LedMxScrollInit(&d.vDev, &scroll, text, bRight);
+	while (LedMxScrollStep(&d.vDev, &scroll))
+	{
+		step++;
+		r.bOk[1] &= d.Match(Render(bRight ? step - len : NB_COL - step, text));
+	}
+	r.bOk[1] &= step == len + NB_COL;
+	r.Bits[1] = d.vSim.TxBits();
+
+	// Legacy runs one frame less, it stops with the last column still visible
+	r.Frames = len + NB_COL - 1;
+	r.Bits[1] = r.Bits[1] * r.Frames / step;
+	Report(r);
+
+	// Blocking API on framebuffer
+	Display b(true);
+
+	if (bRight)
+	{
+		LedMxPrintScrollRight(&b.vDev, text);
+	}
+	else
+	{
+		LedMxPrintScrollLeft(&b.vDev, text);
+	}
+	r.bOk[1] &= b.Match(std::vector<uint8_t>(NB_COL, 0));
+
+	return r.bOk[0] && r.bOk[1];
+}
+
+// Random column writes, text, shifts & flushes against a model
+static bool RandomEdit()
+{
+	Display d(true);
+	std::vector<uint8_t> model(NB_COL, 0);
+	uint32_t flush = 0;
+	bool ok = true;
+
+	for (int n = 0; ok && n < NB_RANDOM_LOOP; n++)
+	{
+		int op = RandRange(0, 9);
+
+		if (op < 4)
+		{
+			int c = RandRange(-3, NB_COL + 3);
+			uint8_t v = RandRange(0, 255);
+
+			LedMxFbSetCol(&d.vDev, c, v);
+			if (c >= 0 && c < NB_COL)
+			{
+				model[c] = v;
+			}
+		}
+		else if (op < 6)
+		{
+			char s[8];
+			int c = RandRange(-20, NB_COL);
+
+			for (int i = 0; i < 7; i++)
+			{
+				s[i] = RandRange(' ', '~');
+			}
+			s[7] = 0;
+			int end = LedMxFbDrawStr(&d.vDev, c, s);
+			std::vector<uint8_t> t = Render(c, s);
+			for (int i = c < 0 ? 0 : c; i < end && i < NB_COL; i++)
+			{
+				model[i] = t[i];
+			}
+		}
+		else if (op < 7)
+		{
+			int k = RandRange(-NB_COL - 2, NB_COL + 2);
+			std::vector<uint8_t> t(NB_COL, 0);
+
+			for (int i = 0; i < NB_COL; i++)
+			{
+				if (i - k >= 0 && i - k < NB_COL)
+				{
+					t[i] = model[i - k];
+				}
+			}
+			model = t;
+			LedMxFbShift(&d.vDev, k);
+		}
+		else if (op < 8 && RandRange(0, 20) == 0)
+		{
+			LedMxFbClear(&d.vDev);
+			model.assign(NB_COL, 0);
+		}
+		else
+		{
+			LedMxFlush(&d.vDev);
+			ok &= d.Match(model);
+			flush++;
+		}
+	}
+
+	printf("  random edits             %6u flushes, %.1f bits/flush : %s\n", flush,
+		   (double)d.vSim.TxBits() / flush, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+int main()
+{
+	bool ok = true;
+
+	printf("LED matrix, %d panels, %d columns\n\n", NB_PANEL, NB_COL);
+
+	ok &= Justify();
+	ok &= Counter();
+	ok &= Scroll(false);
+	ok &= Scroll(true);
+	ok &= RandomEdit();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Monotonic clock check & benchmark
+
+Runs MonoClock & ClockSync against simulated counters with known frequency
+error.
+	- 24 bits RTC counter rollover over 3 hours of random read intervals
+	- drift estimation & HF to LF timestamp mapping
+	- cycles per read compared to Timer::uSecond
+
+Usage : MonoClockBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include "timer_sim.h"
+#include "coredev/mono_clock.h"
+
+using namespace std::chrono;
+
+#define NB_READ			10000000
+
+static uint64_t s_TrueNs = 0;		// Simulated true time
+
+/// Counter running at nominal frequency with an error in part per billion
+class SimCounter : public TimerSim {
+public:
+	void SetError(int32_t Ppb) { vPpb = Ppb; }
+	virtual uint64_t TickCount() {
+		return (uint64_t)((unsigned __int128)s_TrueNs * vFreq * (1000000000LL + vPpb) / 1000000000000000000ULL);
+	}
+	// Exact time of counter in its own time base, for verification
+	uint64_t LocalNs() {
+		return (uint64_t)((unsigned __int128)s_TrueNs * (1000000000LL + vPpb) / 1000000000ULL);
+	}
+private:
+	int32_t vPpb = 0;
+};
+
+static const TIMER_CFG s_LFCfg = { 0, TIMER_CLKSRC_LFXTAL, 32768, 1, NULL };
+static const TIMER_CFG s_HFCfg = { 1, TIMER_CLKSRC_HFXTAL, 16000000, 1, NULL };
+
+static bool RolloverCheck()
+{
+	SimCounter lf;
+	MonoClock clk;
+	uint64_t last = 0;
+	uint64_t maxerr = 0;
+	bool mono = true;
+
+	s_TrueNs = 0;
+	lf.Init(s_LFCfg);
+	clk.Init(&lf, 24);
+
+	srand(1);
+
+	// 3 hours, 24 bits counter wraps every 512 s
+	while (s_TrueNs < 3ULL * 3600ULL * 1000000000ULL)
+	{
+		s_TrueNs += (uint64_t)(rand() % 250000) * 1000000ULL + rand();
+
+		uint64_t t = clk.nSecond();
+		uint64_t err = s_TrueNs > t ? s_TrueNs - t : t - s_TrueNs;
+
+		if (t < last)
+		{
+			mono = false;
+		}
+		if (err > maxerr)
+		{
+			maxerr = err;
+		}
+		last = t;
+	}
+
+	printf("  24 bits rollover, 3 hours : mult %u shift %d, %s, max error %llu ns (1 tick = 30518 ns)\n",
+		   clk.Mult(), clk.Shift(), mono ? "monotonic" : "NOT MONOTONIC", (unsigned long long)maxerr);
+
+	return mono && maxerr < 30518;
+}
+
+static bool SyncCheck()
+{
+	SimCounter lf, hf;
+	MonoClock lfclk, hfclk;
+	ClockSync sync;
+	int32_t lfppb = -20000, hfppb = 40000;
+
+	s_TrueNs = 0;
+	lf.Init(s_LFCfg);
+	hf.Init(s_HFCfg);
+	lf.SetError(lfppb);
+	hf.SetError(hfppb);
+	lfclk.Init(&lf, 24);
+	hfclk.Init(&hf, 32);
+	sync.Init(&lfclk, &hfclk);
+
+	// Sample once per second for 1 minute
+	for (int i = 0; i < 60; i++)
+	{
+		s_TrueNs += 1000000000ULL;
+		sync.Sample();
+	}
+
+	int32_t expect = (int32_t)(((1000000000.0 + lfppb) / (1000000000.0 + hfppb) - 1.0) * 1e9);
+
+	// Map HF captures taken up to 10 s after last sample onto LF time base
+	uint64_t maxerr = 0;
+
+	for (int i = 0; i < 1000; i++)
+	{
+		s_TrueNs += 10000000ULL;
+
+		uint64_t m = sync.Map(hfclk.nSecond());
+		uint64_t truelf = lf.LocalNs();
+		uint64_t err = m > truelf ? m - truelf : truelf - m;
+
+		if (err > maxerr)
+		{
+			maxerr = err;
+		}
+	}
+
+	printf("  drift LF %d ppb, HF %d ppb : estimated %d ppb, expected %d ppb, HF->LF map max error %llu ns\n",
+		   lfppb, hfppb, sync.DriftPpb(), expect, (unsigned long long)maxerr);
+
+	return abs(sync.DriftPpb() - expect) < 1000 && maxerr < 2 * 30518;
+}
+
+static inline uint64_t CycleCount()
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return __rdtsc();
+#else
+	return 0;
+#endif
+}
+
+static void ReadBench()
+{
+	TimerSim tmr;
+	MonoClock clk;
+	volatile uint64_t sink = 0;
+
+	tmr.Init(s_HFCfg);
+	clk.Init(&tmr, 32);
+
+	auto t1 = steady_clock::now();
+	uint64_t c1 = CycleCount();
+	for (int i = 0; i < NB_READ; i++)
+	{
+		tmr.Advance(1);
+		sink += clk.nSecond();
+	}
+	uint64_t c2 = CycleCount();
+	double tmono = duration<double, std::nano>(steady_clock::now() - t1).count() / NB_READ;
+	double cmono = (double)(c2 - c1) / NB_READ;
+
+	// Through base class pointer as drivers use it, same as MonoClock does
+	Timer * volatile ptmr = &tmr;
+
+	t1 = steady_clock::now();
+	c1 = CycleCount();
+	for (int i = 0; i < NB_READ; i++)
+	{
+		tmr.Advance(1);
+		sink += ptmr->uSecond();
+	}
+	c2 = CycleCount();
+	double tus = duration<double, std::nano>(steady_clock::now() - t1).count() / NB_READ;
+	double cus = (double)(c2 - c1) / NB_READ;
+
+	printf("  read cost (incl. sim counter) : MonoClock::nSecond %.1f ns %.1f cycles, Timer::uSecond %.1f ns %.1f cycles\n",
+		   tmono, cmono, tus, cus);
+}
+
+int main(int argc, char **argv)
+{
+	printf("MonoClock\n");
+
+	bool ok = RolloverCheck();
+
+	ok &= SyncCheck();
+	ReadBench();
+
+	printf("%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
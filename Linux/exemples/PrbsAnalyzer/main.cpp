@@ -0,0 +1,328 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	PRBS throughput & bit error rate analyzer
+
+Native replacement for Python/uartprbs_rx.py. Reads a PRBS stream from a
+serial port through the Linux UART driver, optionally SLIP decoded, and
+reports throughput, bit error ratio, slips and error bursts once per second.
+With -g it generates the stream instead, so two instances can test a link.
+
+Default type is prbs8, the Prbs8() byte sequence sent by the uart_prbs_tx
+and uart_slip_prbs_tx firmware examples.
+
+Usage : PrbsAnalyzer [-g] [-s] [-t prbs8|prbs7|prbs15|prbs23|prbs31] [-i]
+                     [-b baudrate] [-f rts|xon] [-d seconds] device
+
+	-g : generate instead of analyze
+	-s : SLIP framing on top of UART
+	-t : PRBS type
+	-i : inverted sequence (ITU-T O.150 for prbs15/23/31)
+	-b : baudrate, default 1000000
+	-f : flow control
+	-d : run duration in seconds, default until Ctrl-C
+
+Example on a socat pty pair :
+
+	socat pty,raw,echo=0,link=/tmp/ttyA pty,raw,echo=0,link=/tmp/ttyB &
+	PrbsAnalyzer -g -t prbs31 -i /tmp/ttyA &
+	PrbsAnalyzer -t prbs31 -i /tmp/ttyB
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <time.h>
+
+#include "coredev/uart.h"
+#include "slip_intrf.h"
+#include "prbs.h"
+
+#define BUFF_SIZE			4096
+#define SLIP_FRAME_SIZE		256
+#define FIFO_MEMSIZE		CFIFO_MEMSIZE(65536)
+
+typedef struct {
+	const char *pName;
+	PRBS_TYPE Type;
+} PRBSNAME;
+
+static const PRBSNAME s_PrbsName[] = {
+	{ "prbs8", PRBS_TYPE_PRBS8 },
+	{ "prbs7", PRBS_TYPE_PRBS7 },
+	{ "prbs15", PRBS_TYPE_PRBS15 },
+	{ "prbs23", PRBS_TYPE_PRBS23 },
+	{ "prbs31", PRBS_TYPE_PRBS31 },
+};
+
+static volatile bool s_bQuit = false;
+
+alignas(4) static uint8_t s_UartRxMem[FIFO_MEMSIZE];
+alignas(4) static uint8_t s_UartTxMem[FIFO_MEMSIZE];
+
+static UARTDEV s_UartDev;
+static SLIPDEV s_SlipDev;
+
+static void SigHandler(int Sig)
+{
+	s_bQuit = true;
+}
+
+static double Now()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+static void Usage()
+{
+	printf("Usage : PrbsAnalyzer [-g] [-s] [-t prbs8|prbs7|prbs15|prbs23|prbs31] [-i]\n"
+		   "                     [-b baudrate] [-f rts|xon] [-d seconds] device\n");
+}
+
+static void Report(PRBSCHK &Chk, uint64_t Bytes, double Elapse, bool bFinal)
+{
+	printf("%s%8.1f s  %9.1f kB/s  %s  bits %llu  err %llu  BER %.3e  slips %u  bursts %llu max %u\n",
+		   bFinal ? "\nTotal " : "", Elapse, Bytes / Elapse / 1000.0, Chk.bLocked ? "locked " : "hunting",
+		   (unsigned long long)Chk.BitCnt, (unsigned long long)Chk.Burst.ErrCnt, PrbsChkBer(&Chk),
+		   Chk.SlipCnt, (unsigned long long)Chk.Burst.BurstCnt, Chk.Burst.BurstMax);
+	fflush(stdout);
+}
+
+static void Generate(DEVINTRF *pIntrf, PRBS_TYPE Type, bool bInvert, bool bSlip, double Duration)
+{
+	PRBSGEN gen;
+	uint8_t buff[BUFF_SIZE];
+	uint64_t cnt = 0;
+	double tstart = Now(), trep = tstart + 1.0;
+	int len = bSlip ? SLIP_FRAME_SIZE : BUFF_SIZE;
+
+	PrbsGenInit(&gen, Type, 1, bInvert);
+
+	while (s_bQuit == false && (Duration <= 0.0 || Now() - tstart < Duration))
+	{
+		PrbsGenFill(&gen, buff, len);
+
+		uint8_t *p = buff;
+		int l = len;
+		while (l > 0 && s_bQuit == false)
+		{
+			int n = DeviceIntrfTx(pIntrf, 0, p, l);
+			if (n <= 0)
+			{
+				usleep(100);
+				continue;
+			}
+			p += n;
+			l -= n;
+			cnt += n;
+		}
+
+		double t = Now();
+		if (t >= trep)
+		{
+			printf("%8.1f s  %9.1f kB/s sent\n", t - tstart, cnt / (t - tstart) / 1000.0);
+			fflush(stdout);
+			trep += 1.0;
+		}
+	}
+}
+
+static void Analyze(DEVINTRF *pIntrf, PRBS_TYPE Type, bool bInvert, double Duration)
+{
+	PRBSCHK chk;
+	PRBSCHK_CFG cfg;
+	uint8_t buff[BUFF_SIZE];
+	uint64_t cnt = 0;
+	double tstart = 0.0, trep = 0.0;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.Type = Type;
+	cfg.bInvert = bInvert;
+	PrbsChkInit(&chk, &cfg);
+
+	while (s_bQuit == false && (Duration <= 0.0 || tstart == 0.0 || Now() - tstart < Duration))
+	{
+		int n = DeviceIntrfRx(pIntrf, 0, buff, sizeof(buff));
+
+		if (n <= 0)
+		{
+			usleep(200);
+		}
+		else
+		{
+			if (tstart == 0.0)
+			{
+				// Time starts with first data
+				tstart = Now();
+				trep = tstart + 1.0;
+			}
+			PrbsChkProcess(&chk, buff, n);
+			cnt += n;
+		}
+
+		double t = Now();
+		if (tstart > 0.0 && t >= trep)
+		{
+			Report(chk, cnt, t - tstart, false);
+			trep += 1.0;
+		}
+	}
+
+	if (tstart > 0.0)
+	{
+		Report(chk, cnt, Now() - tstart, true);
+	}
+	else
+	{
+		printf("No data received\n");
+	}
+}
+
+int main(int argc, char **argv)
+{
+	bool bGen = false, bSlip = false, bInvert = false;
+	PRBS_TYPE type = PRBS_TYPE_PRBS8;
+	UART_FLWCTRL flow = UART_FLWCTRL_NONE;
+	int rate = 1000000;
+	double duration = 0.0;
+	int opt;
+
+	while ((opt = getopt(argc, argv, "gst:ib:f:d:h")) != -1)
+	{
+		switch (opt)
+		{
+			case 'g':
+				bGen = true;
+				break;
+			case 's':
+				bSlip = true;
+				break;
+			case 'i':
+				bInvert = true;
+				break;
+			case 't':
+				{
+					size_t i;
+					for (i = 0; i < sizeof(s_PrbsName) / sizeof(PRBSNAME); i++)
+					{
+						if (strcmp(optarg, s_PrbsName[i].pName) == 0)
+						{
+							type = s_PrbsName[i].Type;
+							break;
+						}
+					}
+					if (i >= sizeof(s_PrbsName) / sizeof(PRBSNAME))
+					{
+						Usage();
+						return 1;
+					}
+				}
+				break;
+			case 'b':
+				rate = atoi(optarg);
+				break;
+			case 'f':
+				flow = strcmp(optarg, "rts") == 0 ? UART_FLWCTRL_HW :
+					   strcmp(optarg, "xon") == 0 ? UART_FLWCTRL_XONXOFF : UART_FLWCTRL_NONE;
+				break;
+			case 'd':
+				duration = atof(optarg);
+				break;
+			default:
+				Usage();
+				return 1;
+		}
+	}
+
+	if (optind >= argc)
+	{
+		Usage();
+		return 1;
+	}
+
+	const char *path = argv[optind];
+	UARTCFG cfg;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.DevNo = 0;
+	cfg.pIOPinMap = path;
+	cfg.NbIOPins = strlen(path);
+	cfg.Rate = rate;
+	cfg.DataBits = 8;
+	cfg.Parity = UART_PARITY_NONE;
+	cfg.StopBits = 1;
+	cfg.FlowControl = flow;
+	cfg.bIntMode = true;
+	cfg.bFifoBlocking = true;
+	cfg.RxMemSize = FIFO_MEMSIZE;
+	cfg.pRxMem = s_UartRxMem;
+	cfg.TxMemSize = FIFO_MEMSIZE;
+	cfg.pTxMem = s_UartTxMem;
+
+	if (UARTInit(&s_UartDev, &cfg) == false)
+	{
+		printf("Cannot open %s\n", path);
+		return 1;
+	}
+
+	DEVINTRF *intrf = &s_UartDev.DevIntrf;
+
+	if (bSlip)
+	{
+		SlipInit(&s_SlipDev, intrf, false);
+		intrf = &s_SlipDev.DevIntrf;
+	}
+
+	signal(SIGINT, SigHandler);
+	signal(SIGTERM, SigHandler);
+
+	printf("%s %s%s%s on %s, %d baud\n", bGen ? "Generating" : "Analyzing", s_PrbsName[type].pName,
+		   bInvert ? " inverted" : "", bSlip ? " over SLIP" : "", path, UARTGetRate(&s_UartDev));
+
+	if (bGen)
+	{
+		Generate(intrf, type, bInvert, bSlip, duration);
+	}
+	else
+	{
+		Analyze(intrf, type, bInvert, duration);
+	}
+
+	DeviceIntrfPowerOff(&s_UartDev.DevIntrf);
+
+	return 0;
+}
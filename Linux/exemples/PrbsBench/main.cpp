@@ -0,0 +1,400 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	PRBS generator & checker benchmark
+
+Verifies the word at a time generator against a bit serial LFSR for every
+type, checks error, burst & slip accounting of the checker with injected
+impairments, then reports generation and check rate in Gbit/s. The baseline
+is the byte by byte Prbs8 check done by uartprbs_rx.py & UartPrbsTest,
+in C, and a bit serial LFSR generator.
+
+Usage : PrbsBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <math.h>
+#include <vector>
+#include <algorithm>
+
+#include "prbs.h"
+
+#define GEN_SIZE			(64 * 1024 * 1024)
+#define CHK_SIZE			(4 * 1024 * 1024)
+
+typedef struct {
+	PRBS_TYPE Type;
+	const char *pName;
+	int n;
+	int m;
+	bool bInvert;
+} PRBSDEF;
+
+static const PRBSDEF s_PrbsDef[] = {
+	{ PRBS_TYPE_PRBS7, "PRBS7", 7, 6, false },
+	{ PRBS_TYPE_PRBS15, "PRBS15", 15, 14, true },
+	{ PRBS_TYPE_PRBS23, "PRBS23", 23, 18, true },
+	{ PRBS_TYPE_PRBS31, "PRBS31", 31, 28, true },
+};
+
+static const int s_NbPrbsDef = sizeof(s_PrbsDef) / sizeof(PRBSDEF);
+
+static uint32_t s_Rand = 12345;
+
+static uint32_t Rand()
+{
+	s_Rand ^= s_Rand << 13;
+	s_Rand ^= s_Rand >> 17;
+	s_Rand ^= s_Rand << 5;
+
+	return s_Rand;
+}
+
+static double Now()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+/// Reference bit serial LFSR, LSB first packing
+static void LfsrFill(const PRBSDEF &Def, uint32_t &State, uint8_t *pBuff, int Len)
+{
+	uint32_t mask = (1UL << Def.n) - 1;
+
+	for (int i = 0; i < Len; i++)
+	{
+		uint8_t d = 0;
+
+		for (int j = 0; j < 8; j++)
+		{
+			uint32_t b = ((State >> (Def.n - 1)) ^ (State >> (Def.m - 1))) & 1;
+
+			State = ((State << 1) | b) & mask;
+			d |= (b ^ (Def.bInvert ? 1 : 0)) << j;
+		}
+		pBuff[i] = d;
+	}
+}
+
+static bool TestGenerator()
+{
+	bool ok = true;
+	std::vector<uint8_t> ref(1 << 20), gen(1 << 20);
+
+	printf("Generator vs bit serial LFSR\n");
+
+	for (int k = 0; k < s_NbPrbsDef; k++)
+	{
+		const PRBSDEF &def = s_PrbsDef[k];
+		PRBSGEN g;
+		uint32_t seed = 0x5a5a5a5a & ((1UL << def.n) - 1);
+		uint32_t state = seed;
+
+		PrbsGenInit(&g, def.Type, seed, def.bInvert);
+		LfsrFill(def, state, ref.data(), ref.size());
+
+		// Random split so history carry over between calls is exercised
+		size_t i = 0;
+		while (i < gen.size())
+		{
+			size_t l = std::min((size_t)(Rand() % 300 + 1), gen.size() - i);
+			PrbsGenFill(&g, &gen[i], l);
+			i += l;
+		}
+
+		bool res = memcmp(ref.data(), gen.data(), ref.size()) == 0;
+
+		if (def.Type == PRBS_TYPE_PRBS7)
+		{
+			// Period 127 bits, so 127 bytes
+			res &= memcmp(gen.data(), &gen[127], 1024) == 0;
+		}
+		printf("  %-7s %s\n", def.pName, res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	// Legacy byte sequence
+	PRBSGEN g;
+	uint8_t b[300];
+	uint8_t v = 1;
+	bool res = true;
+
+	PrbsGenInit(&g, PRBS_TYPE_PRBS8, v, false);
+	PrbsGenFill(&g, b, sizeof(b));
+	for (size_t i = 0; i < sizeof(b); i++)
+	{
+		v = Prbs8(v);
+		res &= b[i] == v;
+	}
+	printf("  %-7s %s\n", "PRBS8", res ? "PASS" : "FAIL");
+
+	return ok && res;
+}
+
+typedef struct {
+	const char *pName;
+	double Ber;				// Random bit error ratio
+	int BurstLen;			// Burst length in bits, 0 none
+	int BurstPeriod;		// Bytes between bursts
+	int DropPeriod;			// Bytes between dropped bytes, 0 none
+	int InsertPeriod;		// Bytes between inserted bytes, 0 none
+} IMPAIR;
+
+static const IMPAIR s_Impair[] = {
+	{ "clean", 0.0, 0, 0, 0, 0 },
+	{ "BER 1e-6", 1e-6, 0, 0, 0, 0 },
+	{ "BER 1e-4", 1e-4, 0, 0, 0, 0 },
+	{ "BER 1e-3", 1e-3, 0, 0, 0, 0 },
+	{ "burst 20 bits", 0.0, 20, 50000, 0, 0 },
+	{ "drop 1/100k", 0.0, 0, 0, 100000, 0 },
+	{ "insert 1/100k", 0.0, 0, 0, 0, 100000 },
+	{ "idle then data", 0.0, 0, 0, 0, 0 },
+};
+
+static bool TestChecker(PRBS_TYPE Type, bool bInvert, const char *pTypeName)
+{
+	bool ok = true;
+
+	printf("\nChecker %s, %d MB per case\n", pTypeName, CHK_SIZE >> 20);
+
+	for (size_t k = 0; k < sizeof(s_Impair) / sizeof(IMPAIR); k++)
+	{
+		const IMPAIR &imp = s_Impair[k];
+		std::vector<uint8_t> tx(CHK_SIZE), rx;
+		PRBSGEN g;
+		PRBSCHK chk;
+		PRBSCHK_CFG cfg = { Type, bInvert, 0, 0, 0, 0 };
+		uint64_t errinj = 0, burstinj = 0;
+		int slipinj = 0;
+
+		PrbsGenInit(&g, Type, 0x1234, bInvert);
+		PrbsGenFill(&g, tx.data(), tx.size());
+
+		rx.reserve(tx.size() + 1024);
+
+		if (k == sizeof(s_Impair) / sizeof(IMPAIR) - 1)
+		{
+			// Idle line must not lock
+			rx.insert(rx.end(), 4096, 0);
+			rx.insert(rx.end(), 4096, 0xff);
+		}
+
+		// Bit errors are geometric skips, kept away from the stream start
+		// so the initial sync is clean
+		uint64_t nextbit = imp.Ber > 0.0 ? 8192 * 8 : UINT64_MAX;
+		for (size_t i = 0; i < tx.size(); i++)
+		{
+			if (imp.DropPeriod && i > 8192 && i % imp.DropPeriod == 0)
+			{
+				slipinj++;
+				continue;
+			}
+			if (imp.InsertPeriod && i > 8192 && i % imp.InsertPeriod == 0)
+			{
+				rx.push_back(0x55);
+				slipinj++;
+			}
+
+			uint8_t d = tx[i];
+
+			while (nextbit < (i + 1) * 8)
+			{
+				d ^= 1 << (nextbit & 7);
+				errinj++;
+				double u = (Rand() + 1.0) / 4294967296.0;
+				nextbit += 1 + (uint64_t)(-log(u) / imp.Ber);
+			}
+			if (imp.BurstLen && i > 8192 && i % imp.BurstPeriod == 0)
+			{
+				burstinj++;
+			}
+			rx.push_back(d);
+		}
+
+		// Bursts : flip every other bit plus both ends, count exact
+		if (imp.BurstLen)
+		{
+			size_t off = rx.size() - tx.size();
+			for (size_t i = 8193; i < tx.size(); i++)
+			{
+				if (i % imp.BurstPeriod == 0)
+				{
+					for (int b = 0; b < imp.BurstLen; b += 2)
+					{
+						rx[off + i + b / 8] ^= 1 << (b & 7);
+						errinj++;
+					}
+					if ((imp.BurstLen - 1) & 1)
+					{
+						int b = imp.BurstLen - 1;
+						rx[off + i + b / 8] ^= 1 << (b & 7);
+						errinj++;
+					}
+				}
+			}
+		}
+
+		PrbsChkInit(&chk, &cfg);
+
+		size_t i = 0;
+		while (i < rx.size())
+		{
+			size_t l = std::min((size_t)(Rand() % 4096 + 1), rx.size() - i);
+			PrbsChkProcess(&chk, &rx[i], l);
+			i += l;
+		}
+
+		bool res;
+		if (slipinj)
+		{
+			// Errors of slipped windows are not counted
+			res = chk.SlipCnt == (uint32_t)slipinj && chk.Burst.ErrCnt == 0 &&
+				  chk.LockCnt == (uint32_t)slipinj + 1;
+		}
+		else
+		{
+			// All injected errors lie in committed windows except the last partial one
+			res = chk.SlipCnt == 0 && chk.LockCnt == 1 && chk.Burst.ErrCnt <= errinj &&
+				  errinj - chk.Burst.ErrCnt <= 2 + errinj / 1000;
+			if (imp.BurstLen)
+			{
+				res &= chk.Burst.BurstCnt == burstinj && chk.Burst.BurstMax == (uint32_t)imp.BurstLen;
+			}
+		}
+
+		printf("  %-15s inj %7llu err %7llu  BER %.2e  slips %u  bursts %llu max %u avg %.1f  hunt %llu B  %s\n",
+			   imp.pName, (unsigned long long)errinj, (unsigned long long)chk.Burst.ErrCnt, PrbsChkBer(&chk),
+			   chk.SlipCnt, (unsigned long long)chk.Burst.BurstCnt, chk.Burst.BurstMax,
+			   chk.Burst.BurstCnt ? (double)chk.Burst.BurstBits / chk.Burst.BurstCnt : 0.0,
+			   (unsigned long long)chk.HuntBytes, res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	return ok;
+}
+
+/// Byte by byte Prbs8 check as done by uartprbs_rx.py
+static uint32_t LegacyCheck(const uint8_t *pData, int Len, uint8_t &Val)
+{
+	uint32_t err = 0;
+
+	for (int i = 0; i < Len; i++)
+	{
+		err += pData[i] != Val;
+		Val = Prbs8(pData[i]);
+	}
+
+	return err;
+}
+
+static void Throughput()
+{
+	std::vector<uint8_t> buff(GEN_SIZE);
+	double t;
+
+	printf("\nThroughput, %d MB\n", GEN_SIZE >> 20);
+	printf("  %-7s %12s %12s %12s\n", "", "gen Gbit/s", "check Gbit/s", "bit LFSR");
+
+	for (int k = 0; k < s_NbPrbsDef; k++)
+	{
+		const PRBSDEF &def = s_PrbsDef[k];
+		PRBSGEN g;
+		PRBSCHK chk;
+		PRBSCHK_CFG cfg = { def.Type, def.bInvert, 0, 0, 0, 0 };
+
+		PrbsGenInit(&g, def.Type, 1, def.bInvert);
+		t = Now();
+		for (int i = 0; i < GEN_SIZE; i += 65536)
+		{
+			PrbsGenFill(&g, &buff[i], 65536);
+		}
+		double tgen = Now() - t;
+
+		PrbsChkInit(&chk, &cfg);
+		t = Now();
+		for (int i = 0; i < GEN_SIZE; i += 65536)
+		{
+			PrbsChkProcess(&chk, &buff[i], 65536);
+		}
+		double tchk = Now() - t;
+
+		uint32_t state = 1;
+		t = Now();
+		LfsrFill(def, state, buff.data(), GEN_SIZE / 16);
+		double tlfsr = (Now() - t) * 16;
+
+		printf("  %-7s %12.2f %12.2f %12.3f   %s\n", def.pName, GEN_SIZE * 8e-9 / tgen, GEN_SIZE * 8e-9 / tchk,
+			   GEN_SIZE * 8e-9 / tlfsr, chk.Burst.ErrCnt == 0 && chk.SlipCnt == 0 ? "" : "errors !");
+	}
+
+	PRBSGEN g;
+	PRBSCHK chk;
+	PRBSCHK_CFG cfg = { PRBS_TYPE_PRBS8, false, 0, 0, 0, 0 };
+	uint8_t val = 0;
+
+	PrbsGenInit(&g, PRBS_TYPE_PRBS8, 1, false);
+	t = Now();
+	PrbsGenFill(&g, buff.data(), GEN_SIZE);
+	double tgen = Now() - t;
+
+	PrbsChkInit(&chk, &cfg);
+	t = Now();
+	PrbsChkProcess(&chk, buff.data(), GEN_SIZE);
+	double tchk = Now() - t;
+
+	t = Now();
+	uint32_t err = LegacyCheck(buff.data(), GEN_SIZE, val);
+	double tleg = Now() - t;
+
+	printf("  %-7s %12.2f %12.2f %12s\n", "PRBS8", GEN_SIZE * 8e-9 / tgen, GEN_SIZE * 8e-9 / tchk, "");
+	printf("  legacy byte by byte Prbs8 check %.2f Gbit/s (%u err)\n", GEN_SIZE * 8e-9 / tleg, err);
+}
+
+int main()
+{
+	bool ok = TestGenerator();
+
+	ok &= TestChecker(PRBS_TYPE_PRBS7, false, "PRBS7");
+	ok &= TestChecker(PRBS_TYPE_PRBS31, true, "PRBS31");
+	ok &= TestChecker(PRBS_TYPE_PRBS8, false, "PRBS8");
+
+	Throughput();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,317 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Timed pulse train check & jitter benchmark
+
+Checks the pulse train compiler : edge merging, overlapping pulses, polarity,
+period limits and the PulseTrain configuration sequence. Then plays compiled
+programs on a simulated 16 MHz timer with interrupt latency, from the timer
+interrupt and through a simulated hardware pin event link, and checks every
+pin event against the program. The jitter report compares them to the
+PulseTrain busy loop, modelled as usDelay between toggles preempted by other
+interrupts.
+
+Usage : PulseTrainBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <algorithm>
+
+#include "timer_sim.h"
+#include "pulse_train_sim.h"
+
+#define TIMER_FREQ			16000000
+#define TICK_NS				(1000000000.0 / TIMER_FREQ)
+#define MAX_EVT				64
+
+// Interrupt latency & busy loop preemption model, in timer ticks
+#define IRQ_LAT_MIN			16			// 1 us
+#define IRQ_LAT_MAX			160			// 10 us
+#define PREEMPT_PERCENT		10			// Chance of other interrupt during one usDelay
+#define LOOP_OVERHEAD		5			// Toggle + loop + usDelay call
+
+static PULSE_TRAIN_PIN s_Pins[] = {
+	{ 0, 2, 0 }, { 0, 3, 0 }, { 0, 4, 0 }, { 0, 5, 0 },
+};
+
+static bool Check(bool bOk, const char *pName)
+{
+	printf("  %-56s %s\n", pName, bOk ? "PASS" : "FAIL");
+
+	return bOk;
+}
+
+static bool EvtIs(const PULSE_TRAIN_EVT &Evt, uint32_t Tick, uint32_t HiMask, uint32_t LoMask)
+{
+	return Evt.Tick == Tick && Evt.HiMask == HiMask && Evt.LoMask == LoMask;
+}
+
+static bool TestCompiler()
+{
+	PULSE_TRAIN_EVT evt[MAX_EVT];
+	PULSE_TRAIN_PROG prog;
+	bool ok = true;
+
+	printf("Compiler\n");
+
+	{
+		// 1 us at 16 MHz is 16 ticks, pin 1 starts at the same tick pin 0 ends
+		const PULSE_TRAIN_PULSE p[] = { { 0, 2000, 250 }, { 1, 1000, 500 }, { 0, 0, 1000 } };
+		PULSE_TRAIN_DESC desc = { s_Pins, 2, PULSE_TRAIN_POL_HIGH, NULL, p, 3, 4000 };
+
+		bool res = PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT);
+		ok &= Check(res && prog.NbEvt == 5 && prog.PeriodTick == 64 && prog.IdleHiMask == 0 &&
+					prog.IdleLoMask == 3 && EvtIs(evt[0], 0, 1, 0) && EvtIs(evt[3], 32, 1, 0) &&
+					EvtIs(evt[4], 36, 0, 1), "unordered pulses sorted");
+		ok &= Check(res && EvtIs(evt[1], 16, 2, 1) && EvtIs(evt[2], 24, 0, 2), "same tick edges merged");
+	}
+	{
+		// Overlapping & touching pulses on one pin are one pulse
+		const PULSE_TRAIN_PULSE p[] = { { 0, 0, 1000 }, { 0, 500, 1000 }, { 0, 1500, 500 }, { 0, 3000, 0 } };
+		PULSE_TRAIN_DESC desc = { s_Pins, 1, PULSE_TRAIN_POL_HIGH, NULL, p, 4, 0 };
+
+		bool res = PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT);
+		ok &= Check(res && prog.NbEvt == 2 && EvtIs(evt[0], 0, 1, 0) && EvtIs(evt[1], 32, 0, 1) &&
+					prog.PeriodTick == 32, "overlap union, zero width dropped, period 0");
+	}
+	{
+		const PULSE_TRAIN_POL pol[] = { PULSE_TRAIN_POL_HIGH, PULSE_TRAIN_POL_LOW, PULSE_TRAIN_POL_LOW };
+		const PULSE_TRAIN_PULSE p[] = { { 0, 0, 1000 }, { 1, 0, 1000 }, { 2, 500, 250 } };
+		PULSE_TRAIN_DESC desc = { s_Pins, 3, PULSE_TRAIN_POL_HIGH, pol, p, 3, 2000 };
+
+		bool res = PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT);
+		ok &= Check(res && prog.NbEvt == 4 && EvtIs(evt[0], 0, 1, 2) && EvtIs(evt[1], 8, 0, 4) &&
+					EvtIs(evt[3], 16, 2, 1), "per pin polarity");
+		ok &= Check(res && EvtIs(evt[2], 12, 4, 0) && prog.IdleHiMask == 6 && prog.IdleLoMask == 1,
+					"active low idle high");
+	}
+	{
+		const PULSE_TRAIN_PULSE p[] = { { 0, 0, 1000 }, { 1, 1500, 1000 } };
+		PULSE_TRAIN_DESC desc = { s_Pins, 2, PULSE_TRAIN_POL_HIGH, NULL, p, 2, 2000 };
+
+		ok &= Check(PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT) == false, "pulse past period rejected");
+		desc.nsPeriod = 2500;
+		ok &= Check(PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, 3) == false, "event memory too small rejected");
+		desc.NbPins = 1;
+		ok &= Check(PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT) == false, "pin index out of range rejected");
+	}
+	{
+		// PulseTrain toggles pin k % n every Period starting inactive
+		PULSE_TRAIN_CFG cfg = { s_Pins, 3, 10, PULSE_TRAIN_POL_LOW };
+		bool res = PulseTrainCompileCfg(&prog, &cfg, 1000000, evt, MAX_EVT);
+		bool match = res && prog.NbEvt == 6 && prog.PeriodTick == 60;
+		uint32_t level = prog.IdleHiMask;
+
+		for (int k = 0; match && k < prog.NbEvt; k++)
+		{
+			level ^= 1 << (k % 3);
+			match = evt[k].Tick == (uint32_t)k * 10 && (evt[k].HiMask & ~level) == 0 &&
+					(evt[k].LoMask & level) == 0 && (evt[k].HiMask | evt[k].LoMask) == (1U << (k % 3));
+		}
+		ok &= Check(match && level == prog.IdleHiMask, "PulseTrain configuration sequence");
+	}
+
+	return ok;
+}
+
+/// Jitter statistics in ticks
+class Jitter {
+public:
+	void Add(int64_t Dev) { vDev.push_back(Dev < 0 ? -Dev : Dev); }
+	void Print(const char *pName, uint32_t NbIrq) {
+		std::sort(vDev.begin(), vDev.end());
+		double sum = 0;
+		for (size_t i = 0; i < vDev.size(); i++)
+		{
+			sum += vDev[i];
+		}
+		printf("  %-22s evt %5zu  avg %8.3f  p50 %8.3f  p99 %8.3f  max %8.3f us  irq %5u\n", pName,
+			   vDev.size(), vDev.size() ? sum / vDev.size() * TICK_NS / 1000 : 0, Pct(50), Pct(99),
+			   vDev.size() ? vDev.back() * TICK_NS / 1000 : 0, NbIrq);
+	}
+	int64_t Max() { return vDev.size() ? *std::max_element(vDev.begin(), vDev.end()) : 0; }
+
+private:
+	double Pct(int P) {
+		return vDev.size() ? vDev[(vDev.size() - 1) * P / 100] * TICK_NS / 1000 : 0;
+	}
+	std::vector<int64_t> vDev;
+};
+
+/**
+ * PulseTrain busy loop model : toggle then usDelay(Period). Toggle and loop
+ * overhead and any interrupt taken during the delay push all following edges.
+ */
+static void LegacyModel(const PULSE_TRAIN_CFG &Cfg, uint32_t Loop, Jitter &Jit)
+{
+	uint64_t t = 0;
+	uint64_t period = (uint64_t)Cfg.Period * TIMER_FREQ / 1000000;
+	uint32_t seed = 1;
+
+	for (uint32_t k = 0; k < Loop * Cfg.NbPins; k++)
+	{
+		Jit.Add((int64_t)t - (int64_t)(k * period));
+
+		t += period + LOOP_OVERHEAD;
+		seed = seed * 1664525UL + 1013904223UL;
+		if ((seed >> 8) % 100 < PREEMPT_PERCENT)
+		{
+			seed = seed * 1664525UL + 1013904223UL;
+			t += IRQ_LAT_MIN + (seed >> 8) % (IRQ_LAT_MAX - IRQ_LAT_MIN + 1);
+		}
+	}
+}
+
+static void DoneCB(void *pCtx)
+{
+	(*(int*)pCtx)++;
+}
+
+/**
+ * Play program and check logged pin events against it
+ */
+static bool Play(const PULSE_TRAIN_PROG &Prog, uint32_t Loop, int HwDepth, bool bLatency,
+				 const char *pName, Jitter &Jit)
+{
+	TIMER_CFG tcfg = {};
+	TimerSim timer;
+	PulseTrainHwLinkSim link;
+	PulseTrainSchedSim sched;
+	std::vector<PULSE_TRAIN_SIMEVT> log;
+
+	tcfg.Freq = TIMER_FREQ;
+	timer.Init(tcfg);
+	timer.Advance(1000);
+	if (bLatency)
+	{
+		timer.IrqLatency(IRQ_LAT_MIN, IRQ_LAT_MAX, 7);
+	}
+
+	if (HwDepth > 0)
+	{
+		link.Init(&timer, HwDepth, &log);
+	}
+	sched.SetLog(&log);
+
+	int done = 0;
+	uint64_t start = timer.TickCount();
+	bool ok = sched.Init(&timer, -1, HwDepth > 0 ? &link : NULL);
+
+	ok = ok && sched.Start(&Prog, Loop, DoneCB, &done);
+
+	// First one is pins set to idle by Start
+	ok = ok && log.size() > 0 && log[0].HiMask == Prog.IdleHiMask && log[0].LoMask == Prog.IdleLoMask;
+	if (ok)
+	{
+		log.erase(log.begin());
+	}
+
+	while (timer.AdvanceToTrigger());
+	link.Flush();
+
+	std::stable_sort(log.begin(), log.end(),
+					 [](const PULSE_TRAIN_SIMEVT &a, const PULSE_TRAIN_SIMEVT &b) { return a.Tick < b.Tick; });
+
+	ok = ok && log.size() == (size_t)Prog.NbEvt * Loop && done == 1 && sched.IsRunning() == false &&
+		 sched.EvtCount() == log.size();
+
+	int hwcnt = 0;
+
+	for (size_t i = 0; ok && i < log.size(); i++)
+	{
+		const PULSE_TRAIN_EVT &e = Prog.pEvt[i % Prog.NbEvt];
+		uint64_t expect = start + (i / Prog.NbEvt) * Prog.PeriodTick + e.Tick;
+
+		ok = log[i].HiMask == e.HiMask && log[i].LoMask == e.LoMask && log[i].Tick >= expect;
+		Jit.Add((int64_t)(log[i].Tick - expect));
+		hwcnt += log[i].bHw;
+	}
+
+	ok = ok && (uint64_t)Jit.Max() == sched.LateMax();
+
+	Jit.Print(pName, sched.IrqCount());
+	if (HwDepth > 0)
+	{
+		printf("  %-22s %d of %zu events by hardware, %u late\n", "", hwcnt, log.size(), sched.LateCount());
+	}
+
+	return ok;
+}
+
+int main()
+{
+	bool ok = TestCompiler();
+	PULSE_TRAIN_EVT evt[MAX_EVT];
+	PULSE_TRAIN_PROG prog;
+
+	printf("\nPulseTrain configuration, 4 pins, 20 us, 500 loops, timer %d MHz\n", TIMER_FREQ / 1000000);
+	printf("Interrupt latency %.1f - %.1f us, busy loop preempted %d%% of delays\n\n",
+		   IRQ_LAT_MIN * TICK_NS / 1000, IRQ_LAT_MAX * TICK_NS / 1000, PREEMPT_PERCENT);
+	{
+		PULSE_TRAIN_CFG cfg = { s_Pins, 4, 20, PULSE_TRAIN_POL_HIGH };
+		Jitter legacy, sw0, sw, hw;
+
+		LegacyModel(cfg, 500, legacy);
+		legacy.Print("busy loop", 0);
+
+		ok &= PulseTrainCompileCfg(&prog, &cfg, TIMER_FREQ, evt, MAX_EVT);
+		ok &= Check(Play(prog, 250, 0, false, "timer irq, no latency", sw0) && sw0.Max() == 0, "timer irq, no latency");
+		ok &= Check(Play(prog, 250, 0, true, "timer irq", sw), "timer irq");
+		ok &= Check(Play(prog, 250, 4, true, "hw link depth 4", hw) && hw.Max() == 0, "hw link depth 4");
+	}
+
+	printf("\nPulse description, 4 pins, mixed widths & polarity, 200 loops\n\n");
+	{
+		const PULSE_TRAIN_POL pol[] = {
+			PULSE_TRAIN_POL_HIGH, PULSE_TRAIN_POL_LOW, PULSE_TRAIN_POL_HIGH, PULSE_TRAIN_POL_HIGH
+		};
+		const PULSE_TRAIN_PULSE p[] = {
+			{ 0, 0, 5000 }, { 1, 2500, 12000 }, { 2, 5000, 2000 }, { 3, 5000, 40000 },
+			{ 0, 20000, 5000 }, { 2, 30000, 2000 }, { 1, 35000, 8000 }, { 2, 60000, 15000 },
+		};
+		PULSE_TRAIN_DESC desc = { s_Pins, 4, PULSE_TRAIN_POL_HIGH, pol, p, 8, 100000 };
+		Jitter sw, hw1, hw4, hw8;
+
+		ok &= PulseTrainCompile(&prog, &desc, TIMER_FREQ, evt, MAX_EVT);
+		printf("  %d pulses compiled to %d events\n", desc.NbPulses, prog.NbEvt);
+		ok &= Check(Play(prog, 200, 0, true, "timer irq", sw), "timer irq");
+		ok &= Check(Play(prog, 200, 1, true, "hw link depth 1", hw1), "hw link depth 1");
+		ok &= Check(Play(prog, 200, 4, true, "hw link depth 4", hw4), "hw link depth 4");
+		ok &= Check(Play(prog, 200, 8, true, "hw link depth 8", hw8) && hw8.Max() == 0, "hw link depth 8");
+	}
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
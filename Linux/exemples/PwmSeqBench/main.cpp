@@ -0,0 +1,448 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	PWM sequence waveform engine check & benchmark
+
+Plays waveforms through the PWM sequence engine on a simulated nRF52 PWM
+peripheral and checks the compare values output period by period : phase
+shifted looped tables, one shot envelopes, streams, polarity and end of
+sequence. Measures interrupt rate and CPU cost per sample against updating
+the duty cycle from a timer interrupt at every sample.
+
+Usage : PwmSeqBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include <chrono>
+#include <vector>
+
+#include "pwm_seq.h"
+#include "pwm_sim.h"
+
+#define PWM_FREQ			20000
+#define NB_FRAME			32
+
+static const PWM_CFG s_PwmCfg = {
+	.DevNo = 0,
+	.Freq = PWM_FREQ,
+	.Mode = PWM_MODE_EDGE,
+	.bIntEn = true,
+	.IntPrio = 6,
+	.pEvtHandler = NULL,
+};
+
+static const PWM_CHAN_CFG s_PwmChanCfg[] = {
+	{ 0, PWM_POL_LOW, 0, 1 },
+	{ 1, PWM_POL_LOW, 0, 2 },
+	{ 2, PWM_POL_HIGH, 0, 3 },
+	{ 3, PWM_POL_LOW, 0, 4 },
+};
+
+static PWM_DEV s_Pwm;
+static PwmSim *s_pSim;
+static uint32_t s_StopEvtCnt = 0;
+static uint16_t s_SeqMem[PWMSEQ_MEMSIZE(NB_FRAME, 4)];
+
+static void PwmEvtHandler(PWM_DEV *pDev, PWM_EVT Evt)
+{
+	if (Evt == PWM_EVT_STOPPED)
+	{
+		s_StopEvtCnt++;
+	}
+}
+
+static void PwmSetup(uint32_t IrqLatency)
+{
+	PWM_CFG cfg = s_PwmCfg;
+
+	cfg.pEvtHandler = PwmEvtHandler;
+	s_pSim = PwmSimDevice(0);
+	s_pSim->Reset();
+	PWMInit(&s_Pwm, &cfg);
+	PWMOpenChannel(&s_Pwm, s_PwmChanCfg, 4);
+	s_pSim->IrqLatency(IrqLatency);
+	s_pSim->Record(true);
+	s_StopEvtCnt = 0;
+}
+
+static uint16_t Flag(int Chan)
+{
+	return s_PwmChanCfg[Chan].Pol == PWM_POL_HIGH ? 0x8000 : 0;
+}
+
+/// Compare recorded output with expected duty per sample and channel
+static bool CheckOutput(const std::vector<uint16_t> Exp[4], uint32_t Repeat, size_t NbSample)
+{
+	const std::vector<uint16_t> &out = s_pSim->Output();
+	uint32_t top = s_pSim->COUNTERTOP;
+
+	if (out.size() < NbSample * Repeat * 4)
+	{
+		printf("    output too short %zu < %zu\n", out.size() / 4, NbSample * Repeat);
+		return false;
+	}
+
+	for (size_t p = 0; p < NbSample * Repeat; p++)
+	{
+		size_t s = p / Repeat;
+
+		for (int c = 0; c < 4; c++)
+		{
+			uint16_t e = PwmDutyToCmp(Exp[c][s], top) | Flag(c);
+
+			if (out[p * 4 + c] != e)
+			{
+				printf("    period %zu chan %d : %04x expected %04x\n", p, c, out[p * 4 + c], e);
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static bool TestGenerators()
+{
+	bool ok = true;
+	uint16_t tbl[1024];
+
+	PwmWaveSine(tbl, 256, 1000, 31000);
+	ok &= tbl[0] == 16000 && tbl[64] == 31000 && tbl[128] == 16000 && tbl[192] == 1000;
+	for (int i = 1; i < 64; i++)
+	{
+		ok &= tbl[i] > tbl[i - 1] && tbl[i] + tbl[256 - i] == 32000;
+	}
+
+	PwmWaveRamp(tbl, 100, PWM_DUTY_MAX, 0);
+	ok &= tbl[0] == PWM_DUTY_MAX && tbl[99] == 0;
+	for (int i = 1; i < 100; i++)
+	{
+		ok &= tbl[i] < tbl[i - 1];
+	}
+
+	PWMWAVE_ADSR env = { 10, 20, 30, 40, 30000, 12000 };
+	uint32_t len = PwmWaveAdsr(tbl, 1024, &env);
+
+	ok &= len == 100 && tbl[0] == 3000 && tbl[9] == 30000 && tbl[29] == 12000 &&
+		  tbl[30] == 12000 && tbl[59] == 12000 && tbl[99] == 0 && tbl[79] == 6000;
+	ok &= PwmWaveAdsr(tbl, 99, &env) == 0;
+
+	printf("  waveform generators                             : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// 3 phase sine from one table & constant channel, looped
+static bool TestPhase()
+{
+	const uint32_t len = 100, repeat = 2, nbsample = 2000;
+	uint16_t sine[len];
+	PWMSEQ_CFG cfg = { s_SeqMem, NB_FRAME, 4, repeat };
+	PWMSEQ seq;
+	std::vector<uint16_t> exp[4];
+
+	PwmWaveSine(sine, len, 0, PWM_DUTY_MAX);
+	PwmSetup(5);
+	PwmSeqInit(&seq, &cfg);
+	PwmSeqSetTable(&seq, 0, sine, len, 0, true);
+	PwmSeqSetTable(&seq, 1, sine, len, len / 3, true);
+	PwmSeqSetTable(&seq, 2, sine, len, 2 * len / 3, true);
+	PwmSeqSetConst(&seq, 3, PWM_DUTY_MAX / 4);
+
+	for (uint32_t s = 0; s < nbsample; s++)
+	{
+		exp[0].push_back(sine[s % len]);
+		exp[1].push_back(sine[(s + len / 3) % len]);
+		exp[2].push_back(sine[(s + 2 * len / 3) % len]);
+		exp[3].push_back(PWM_DUTY_MAX / 4);
+	}
+
+	bool ok = PWMSeqStart(&s_Pwm, &seq);
+
+	s_pSim->Run(nbsample * repeat);
+	ok &= CheckOutput(exp, repeat, nbsample) && s_pSim->LateCount() == 0 && s_pSim->IsRunning();
+
+	PWMSeqStop(&s_Pwm);
+	ok &= s_pSim->IsRunning() == false;
+
+	// Back to fixed duty mode
+	s_pSim->ClearOutput();
+	ok &= PWMSetDutyCycle(&s_Pwm, 0, 50) && PWMSetDuty(&s_Pwm, 2, PWM_DUTY_MAX / 8);
+	PWMStart(&s_Pwm, 0);
+	s_pSim->Run(10);
+	ok &= s_pSim->Output()[36] == s_pSim->COUNTERTOP / 2 && s_pSim->Output()[38] == ((s_pSim->COUNTERTOP / 8) | 0x8000);
+	PWMStop(&s_Pwm);
+
+	printf("  3 phase looped sine, IRQ latency 5 periods      : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// One shot envelope ending inside a half buffer, sequence must stop right after it
+static bool TestOneShot()
+{
+	bool ok = true;
+	uint16_t env[1000];
+	PWMWAVE_ADSR adsr = { 100, 150, 300, 250, PWM_DUTY_MAX, PWM_DUTY_MAX / 2 };
+	uint32_t len = PwmWaveAdsr(env, 1000, &adsr);
+	uint16_t ramp[77];
+
+	PwmWaveRamp(ramp, 77, 0, PWM_DUTY_MAX);
+
+	for (uint32_t repeat = 1; repeat <= 3; repeat++)
+	{
+		for (int half = 0; half < 2; half++)
+		{
+			// Adjust length so that the end falls inside either half buffer
+			uint32_t l = len - 13 - half * NB_FRAME;
+			PWMSEQ_CFG cfg = { s_SeqMem, NB_FRAME, 4, repeat };
+			PWMSEQ seq;
+			std::vector<uint16_t> exp[4];
+
+			PwmSetup(3);
+			PwmSeqInit(&seq, &cfg);
+			PwmSeqSetTable(&seq, 0, env, l, 0, false);
+			PwmSeqSetTable(&seq, 1, ramp, 77, 10, false);
+			PwmSeqSetConst(&seq, 2, 1234);
+			PwmSeqSetTable(&seq, 3, env, l, l / 2, false);
+
+			for (uint32_t s = 0; s < l; s++)
+			{
+				exp[0].push_back(env[s]);
+				exp[1].push_back(s < 67 ? ramp[s + 10] : ramp[76]);
+				exp[2].push_back(1234);
+				exp[3].push_back(s < l - l / 2 ? env[s + l / 2] : env[l - 1]);
+			}
+
+			ok &= PWMSeqStart(&s_Pwm, &seq);
+			ok &= s_pSim->RunToStop(10 * l * repeat);
+			ok &= s_pSim->PeriodCount() == l * repeat && s_StopEvtCnt == 1;
+			ok &= CheckOutput(exp, repeat, l) && s_pSim->LateCount() == 0;
+			// Driver back in fixed duty mode
+			ok &= PWMSetDuty(&s_Pwm, 0, 0);
+		}
+	}
+
+	printf("  one shot ADSR envelope & ramp, exact stop       : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+/// Stream source, DDS sine with a finite number of samples
+typedef struct {
+	uint32_t Phase;
+	uint32_t Inc;
+	uint32_t Left;
+	uint32_t CallCnt;
+} TONE;
+
+static uint16_t ToneSample(uint32_t Phase)
+{
+	return (uint16_t)(PWM_DUTY_MAX / 2 + (PWM_DUTY_MAX / 2 - 1) * sin(Phase * (2.0 * M_PI / 4294967296.0)));
+}
+
+static int ToneFill(void *pCtx, int Chan, uint16_t *pDuty, int Count)
+{
+	TONE *t = (TONE*)pCtx;
+	int n = Count < (int)t->Left ? Count : t->Left;
+
+	for (int i = 0; i < n; i++)
+	{
+		pDuty[i] = ToneSample(t->Phase);
+		t->Phase += t->Inc;
+	}
+	t->Left -= n;
+	t->CallCnt++;
+
+	return n;
+}
+
+// Streams, including one ending on a half buffer boundary
+static bool TestStream()
+{
+	bool ok = true;
+	uint32_t lens[] = { 1000, NB_FRAME * 20, NB_FRAME * 21, 5 };
+
+	for (size_t k = 0; k < sizeof(lens) / sizeof(lens[0]); k++)
+	{
+		PWMSEQ_CFG cfg = { s_SeqMem, NB_FRAME, 4, 1 };
+		PWMSEQ seq;
+		TONE tone[2] = { { 0, 0x01000000, lens[k], 0 }, { 0x40000000, 0x00400000, lens[k] / 2, 0 } };
+		std::vector<uint16_t> exp[4];
+
+		for (uint32_t s = 0; s < lens[k]; s++)
+		{
+			exp[0].push_back(ToneSample(tone[0].Inc * s));
+			exp[1].push_back(ToneSample(tone[1].Phase + tone[1].Inc * (s < lens[k] / 2 ? s : lens[k] / 2 - 1)));
+			exp[2].push_back(0);
+			exp[3].push_back(0);
+		}
+
+		PwmSetup(8);
+		PwmSeqInit(&seq, &cfg);
+		PwmSeqSetStream(&seq, 0, ToneFill, &tone[0]);
+		PwmSeqSetStream(&seq, 1, ToneFill, &tone[1]);
+		ok &= PWMSeqStart(&s_Pwm, &seq);
+		ok &= s_pSim->RunToStop(10 * lens[k]);
+		ok &= s_pSim->PeriodCount() == lens[k] && s_StopEvtCnt == 1;
+		ok &= CheckOutput(exp, 1, lens[k]) && s_pSim->LateCount() == 0;
+		ok &= seq.SampleCnt == lens[k];
+	}
+
+	printf("  stream refill callbacks, end on half boundary   : %s\n", ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Refill must complete within one half buffer play time
+static bool TestLatency()
+{
+	bool ok = true;
+	uint16_t sine[64];
+	uint32_t maxok = 0;
+
+	PwmWaveSine(sine, 64, 0, PWM_DUTY_MAX);
+
+	for (uint32_t lat = 0; lat <= 2 * NB_FRAME; lat += 4)
+	{
+		PWMSEQ_CFG cfg = { s_SeqMem, NB_FRAME, 4, 1 };
+		PWMSEQ seq;
+
+		PwmSetup(lat);
+		PwmSeqInit(&seq, &cfg);
+		PwmSeqSetTable(&seq, 0, sine, 64, 0, true);
+		PWMSeqStart(&s_Pwm, &seq);
+		s_pSim->Run(10000);
+
+		bool late = s_pSim->LateCount() > 0;
+
+		if (late == false)
+		{
+			maxok = lat;
+		}
+		// Late exactly when the interrupt runs after the other half ended
+		ok &= late == (lat > NB_FRAME);
+		PWMSeqStop(&s_Pwm);
+	}
+
+	printf("  late refill detection, max latency %2u periods   : %s\n", maxok, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// Interrupt rate and CPU time per sample for 4 channels
+static bool Bench()
+{
+	const uint32_t nbsample = 400000;
+	uint16_t sine[256];
+	PWMSEQ_CFG cfg = { s_SeqMem, NB_FRAME, 4, 1 };
+	PWMSEQ seq;
+	volatile uint32_t sink = 0;
+
+	PwmWaveSine(sine, 256, 0, PWM_DUTY_MAX);
+
+	printf("\n  %u samples, 4 channels, %u Hz sample rate\n", nbsample, PWM_FREQ);
+
+	// Previous method, timer interrupt at sample rate calling DutyCycle on each channel
+	PwmSetup(0);
+	s_pSim->Record(false);
+	PWMStart(&s_Pwm, 0);
+
+	auto t0 = std::chrono::steady_clock::now();
+	for (uint32_t s = 0; s < nbsample; s++)
+	{
+		for (int c = 0; c < 4; c++)
+		{
+			PWMSetDuty(&s_Pwm, c, sine[(s + c * 64) & 255]);
+		}
+		sink += ((const uint16_t*)s_pSim->SEQ[0].PTR)[0];
+	}
+	auto t1 = std::chrono::steady_clock::now();
+	double nsdirect = std::chrono::duration<double, std::nano>(t1 - t0).count() / nbsample;
+	PWMStop(&s_Pwm);
+
+	printf("  %-22s IRQ/s %7u  %6.1f ns/sample\n", "DutyCycle per sample", PWM_FREQ, nsdirect);
+
+	for (int nbframe = 8; nbframe <= NB_FRAME; nbframe <<= 1)
+	{
+		PwmSetup(0);
+		s_pSim->Record(false);
+		cfg.NbFrame = nbframe;
+		PwmSeqInit(&seq, &cfg);
+		for (int c = 0; c < 4; c++)
+		{
+			PwmSeqSetTable(&seq, c, sine, 256, c * 64, true);
+		}
+		PwmSeqSetTop(&seq, s_pSim->COUNTERTOP);
+
+		t0 = std::chrono::steady_clock::now();
+		for (uint32_t s = 0; s < nbsample; s += nbframe)
+		{
+			PwmSeqFill(&seq, (s / nbframe) & 1);
+			sink += s_SeqMem[0];
+		}
+		t1 = std::chrono::steady_clock::now();
+		double nsseq = std::chrono::duration<double, std::nano>(t1 - t0).count() / nbsample;
+
+		// Interrupt rate from the simulated peripheral
+		PWMSeqStart(&s_Pwm, &seq);
+		s_pSim->Run(PWM_FREQ);
+		uint32_t irq = s_pSim->IrqCount();
+		PWMSeqStop(&s_Pwm);
+
+		char name[32];
+		snprintf(name, sizeof(name), "sequence %2d frames", nbframe);
+		printf("  %-22s IRQ/s %7u  %6.1f ns/sample  late %u\n", name, irq, nsseq, s_pSim->LateCount());
+	}
+
+	return sink != 0xFFFFFFFF;
+}
+
+int main()
+{
+	bool ok = true;
+
+	printf("PWM sequence engine, %u Hz PWM, %d frames per half buffer\n\n", PWM_FREQ, NB_FRAME);
+
+	ok &= TestGenerators();
+	ok &= TestPhase();
+	ok &= TestOneShot();
+	ok &= TestStream();
+	ok &= TestLatency();
+	ok &= Bench();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,304 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Serial EEPROM configuration commit benchmark
+
+Runs the Seep driver against the simulated I2C EEPROM.
+
+Commit of a configuration record with scattered field updates
+	- direct page writes with full write delay after each write
+	- page write cache with acknowledge polling and a single flush
+
+Wear spreading of the key/value record log compared to in place rewrite of the
+same values.
+
+Usage : SeepCommitBench [number of commits]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+
+#include "seep.h"
+#include "seep_kvlog.h"
+#include "seep_sim.h"
+
+using namespace std::chrono;
+
+#define CFG_ADDR			0x40		// Configuration record location
+#define CFG_NBFIELD			24			// Number of 4 bytes fields in configuration record
+#define CFG_NBUPDATE		10			// Fields modified per commit
+#define KVLOG_ADDR			0x200
+#define KVLOG_SIZE			0x400
+#define KVLOG_NBKEY			6
+#define KVLOG_NBWRITE		5000
+
+// M24C64S : 64Kbits, 2 bytes address length, 32 bytes per page, Write delays 5 ms
+static const SEEP_CFG s_M24C64SEepCfg = {
+	0x50,			// Device address
+	2,				// Address length
+	32,				// Page size
+	64 * 1024 / 8,	// Total size in bytes
+	5,				// Twr : 5 ms
+	{-1, -1, },		// No write protect pin
+	NULL,
+	NULL,
+	false,			// Write delay
+};
+
+static const SEEP_CFG s_M24C64SEepCfgAckPoll = {
+	0x50,			// Device address
+	2,				// Address length
+	32,				// Page size
+	64 * 1024 / 8,	// Total size in bytes
+	5,				// Twr : 5 ms
+	{-1, -1, },		// No write protect pin
+	NULL,
+	NULL,
+	true,			// Acknowledge polling
+};
+
+// Same device with write cycle time removed, used to run a large number of
+// writes for the wear test
+static const SEEP_CFG s_M24C64SEepCfgNoDelay = {
+	0x50, 2, 32, 64 * 1024 / 8, 0, {-1, -1, }, NULL, NULL, true,
+};
+
+uint8_t g_CacheMem[4][32];
+SEEP_CACHE_DESC g_SeepCache[4] = {
+	{ 0xFFFFFFFF, 0, 0, g_CacheMem[0] },
+	{ 0xFFFFFFFF, 0, 0, g_CacheMem[1] },
+	{ 0xFFFFFFFF, 0, 0, g_CacheMem[2] },
+	{ 0xFFFFFFFF, 0, 0, g_CacheMem[3] },
+};
+
+// Commit configuration changes, one SeepWrite per modified field
+static double CommitConfig(SEEPDEV * const pDev, uint32_t *pCfg, int NbCommit, bool bFlush)
+{
+	double tmax = 0;
+
+	for (int n = 0; n < NbCommit; n++)
+	{
+		auto t1 = steady_clock::now();
+
+		for (int i = 0; i < CFG_NBUPDATE; i++)
+		{
+			int idx = (n * 7 + i * 5) % CFG_NBFIELD;
+
+			pCfg[idx] = rand();
+			SeepWrite(pDev, CFG_ADDR + idx * 4, (uint8_t*)&pCfg[idx], 4);
+		}
+
+		if (bFlush)
+		{
+			SeepFlush(pDev);
+		}
+
+		double t = duration<double, std::milli>(steady_clock::now() - t1).count();
+
+		if (t > tmax)
+		{
+			tmax = t;
+		}
+	}
+
+	return tmax;
+}
+
+static bool VerifyConfig(SEEPDEV * const pDev, SeepSim &Sim, uint32_t *pCfg)
+{
+	uint32_t d[CFG_NBFIELD];
+
+	SeepRead(pDev, CFG_ADDR, (uint8_t*)d, sizeof(d));
+
+	return memcmp(d, pCfg, sizeof(d)) == 0 && memcmp(&Sim.Mem()[CFG_ADDR], pCfg, sizeof(d)) == 0;
+}
+
+static void ConfigBench(int NbCommit)
+{
+	uint32_t cfg[CFG_NBFIELD];
+	SEEPDEV seep;
+	SeepSim sim;
+
+	printf("Configuration commit : %d fields of %d updated, %d commits\n", CFG_NBUPDATE, CFG_NBFIELD, NbCommit);
+
+	// Direct write with full write delay
+	sim.Init(s_M24C64SEepCfg);
+	SeepInit(&seep, &s_M24C64SEepCfg, sim);
+	memset(cfg, 0xFF, sizeof(cfg));
+	srand(1);
+
+	auto t1 = steady_clock::now();
+	double tmax = CommitConfig(&seep, cfg, NbCommit, false);
+	double t = duration<double, std::milli>(steady_clock::now() - t1).count();
+
+	printf("  Direct write      : %8.2f ms/commit (max %8.2f), %3u write cycles, bus %6u us, nack %u, %s\n",
+		   t / NbCommit, tmax, sim.WrCycles() / NbCommit, sim.BusTime() / NbCommit, sim.NackCount(),
+		   VerifyConfig(&seep, sim, cfg) ? "OK" : "MISMATCH");
+
+	// Page cache, acknowledge polling, single flush
+	sim.Init(s_M24C64SEepCfgAckPoll);
+	SeepInit(&seep, &s_M24C64SEepCfgAckPoll, sim);
+	SeepSetCache(&seep, g_SeepCache, 4);
+	memset(cfg, 0xFF, sizeof(cfg));
+	srand(1);
+
+	t1 = steady_clock::now();
+	tmax = CommitConfig(&seep, cfg, NbCommit, true);
+	t = duration<double, std::milli>(steady_clock::now() - t1).count();
+
+	printf("  Cache + ack poll  : %8.2f ms/commit (max %8.2f), %3u write cycles, bus %6u us, nack %u, %s\n",
+		   t / NbCommit, tmax, sim.WrCycles() / NbCommit, sim.BusTime() / NbCommit, sim.NackCount(),
+		   VerifyConfig(&seep, sim, cfg) ? "OK" : "MISMATCH");
+}
+
+static void KvLogBench()
+{
+	SEEPDEV seep;
+	SeepSim sim;
+	SEEP_KVLOG kvlog;
+	uint32_t val[KVLOG_NBKEY];
+	int pgstart = KVLOG_ADDR / s_M24C64SEepCfgNoDelay.PageSize;
+	int pgend = (KVLOG_ADDR + KVLOG_SIZE) / s_M24C64SEepCfgNoDelay.PageSize;
+
+	printf("\nKey/value log : %d keys, %d writes, %d bytes region\n", KVLOG_NBKEY, KVLOG_NBWRITE, KVLOG_SIZE);
+
+	sim.Init(s_M24C64SEepCfgNoDelay);
+	SeepInit(&seep, &s_M24C64SEepCfgNoDelay, sim);
+
+	if (SeepKvLogInit(&kvlog, &seep, KVLOG_ADDR, KVLOG_SIZE) == false)
+	{
+		printf("  KV log init failed\n");
+		return;
+	}
+
+	srand(2);
+	for (int i = 0; i < KVLOG_NBWRITE; i++)
+	{
+		int k = i % KVLOG_NBKEY;
+
+		val[k] = rand();
+		SeepKvLogWrite(&kvlog, k, (uint8_t*)&val[k], 4);
+	}
+
+	uint32_t maxcnt = 0;
+
+	for (int i = pgstart; i < pgend; i++)
+	{
+		if (sim.PageWrCycles()[i] > maxcnt)
+		{
+			maxcnt = sim.PageWrCycles()[i];
+		}
+	}
+
+	// Re-init as after power cycle, values must be recovered
+	SEEP_KVLOG kvlog2;
+	bool ok = SeepKvLogInit(&kvlog2, &seep, KVLOG_ADDR, KVLOG_SIZE);
+
+	for (int i = 0; i < KVLOG_NBKEY && ok; i++)
+	{
+		uint32_t d = 0;
+
+		ok = SeepKvLogRead(&kvlog2, i, (uint8_t*)&d, 4) == 4 && d == val[i];
+	}
+
+	printf("  KV log            : max %u write cycles per page, %u compactions, recovery %s\n",
+		   maxcnt, kvlog.CompactCnt, ok ? "OK" : "FAILED");
+
+	// Same values rewritten in place
+	sim.Init(s_M24C64SEepCfgNoDelay);
+	SeepInit(&seep, &s_M24C64SEepCfgNoDelay, sim);
+
+	for (int i = 0; i < KVLOG_NBWRITE; i++)
+	{
+		int k = i % KVLOG_NBKEY;
+
+		val[k] = rand();
+		SeepWrite(&seep, KVLOG_ADDR + k * 4, (uint8_t*)&val[k], 4);
+	}
+
+	maxcnt = 0;
+	for (int i = pgstart; i < pgend; i++)
+	{
+		if (sim.PageWrCycles()[i] > maxcnt)
+		{
+			maxcnt = sim.PageWrCycles()[i];
+		}
+	}
+
+	printf("  In place rewrite  : max %u write cycles per page\n", maxcnt);
+}
+
+// Device stops acknowledging during its write cycle, accesses must fail
+static bool AckPollTimeout()
+{
+	SeepSim sim;
+	SEEPDEV dev;
+	uint8_t d[8] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+
+	sim.Init(s_M24C64SEepCfgAckPoll);
+	SeepInit(&dev, &s_M24C64SEepCfgAckPoll, sim);
+
+	bool ok = SeepWrite(&dev, 0, d, sizeof(d)) == sizeof(d);
+
+	sim.SetStuck(true);
+
+	ok &= SeepWaitReady(&dev) == false;
+	ok &= SeepRead(&dev, 0, d, sizeof(d)) == 0;
+	ok &= SeepWrite(&dev, 0x40, d, sizeof(d)) == 0;
+
+	sim.SetStuck(false);
+
+	uint8_t r[8];
+
+	ok &= SeepRead(&dev, 0, r, sizeof(r)) == sizeof(r) && memcmp(r, d, sizeof(r)) == 0;
+
+	printf("Ack poll timeout    : read & write fail while device NACKs, recover after : %s\n",
+		   ok ? "OK" : "FAILED");
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	int nbcommit = argc > 1 ? atoi(argv[1]) : 20;
+
+	if (nbcommit <= 0)
+	{
+		nbcommit = 20;
+	}
+
+	ConfigBench(nbcommit);
+	KvLogBench();
+
+	return AckPollTimeout() ? 0 : 1;
+}
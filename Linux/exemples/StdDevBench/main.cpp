@@ -0,0 +1,529 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	stdio device layer latency benchmark
+
+Runs the same main loop job on the stdio device layer with simulated devices,
+first the blocking way the layer used to be, then event driven with
+non-blocking descriptors, stream buffers & StdDevPoll.
+
+	- Console UART at 115200 : a status line every 10 ms, commands arriving
+	  every 97 ms answered with a line
+	- Telemetry stream at 50 kB/s : a 64 KB file copied from the file system
+	- File system : 800 us access per read, synchronous
+
+Reports console command latency, status line lateness & time blocked in the
+status write, file copy time, and checks that every byte reached its device in
+order.  Also checks the BLE notification pump as a stdio device and times the
+layer calls on host.
+
+Usage : StdDevBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <string>
+#include <vector>
+
+#include "stddev.h"
+#include "stddev_sim.h"
+#include "ble_stack_sim.h"
+#include "bluetooth/ble_ntfpump.h"
+
+extern "C" {
+int _open(const char * const pPathName, int Flags, int Mode);
+int _close(int Fd);
+int _read(int Fd, char *pBuff, size_t Len);
+int _write(int Fd, char *pBuff, size_t Len);
+}
+
+#define RUN_US				3000000ULL
+#define CON_BYTE_US			87			// 115200 baud
+#define TEL_BYTE_US			20			// 50 kB/s
+#define FILE_SIZE			65536
+#define FILE_ACCESS_US		800
+#define FILE_CHUNK			512
+#define STATUS_PERIOD_US	10000
+#define STATUS_LEN			60
+#define CMD_PERIOD_US		97000
+#define IDLE_US				20
+
+typedef struct {
+	uint64_t CmdCnt;
+	uint64_t CmdLatSum;
+	uint64_t CmdLatMax;
+	uint64_t StatusCnt;
+	uint64_t StatusLateMax;
+	uint64_t StatusBlockMax;
+	uint32_t StatusShort;
+	uint64_t CopyDoneUs;
+	bool bOk;
+} RESULT;
+
+static StdDevSimClock s_Clock;
+static SerialStdDevSim s_Con;
+static SerialStdDevSim s_Tel;
+static FileStdDevSim s_File;
+static std::vector<uint64_t> s_CmdTime;		// Arrival time of each command end
+static uint8_t s_ConRxMem[64];
+static uint8_t s_ConTxMem[1024];
+static uint8_t s_TelTxMem[1024];
+
+static int Setup(bool bEvent)
+{
+	s_Clock = StdDevSimClock();
+	s_Con.Init(&s_Clock, CON_BYTE_US, 64, 64, !bEvent);
+	s_Tel.Init(&s_Clock, TEL_BYTE_US, 256, 16, !bEvent);
+	s_File.Init(&s_Clock, FILE_SIZE, FILE_ACCESS_US, 20);
+
+	InstallBlkDev(s_Con.Dev(), STDIN_FILENO);
+	InstallBlkDev(s_Con.Dev(), STDOUT_FILENO);
+	InstallBlkDev(s_File.Dev(), STDFS_FILENO);
+
+	int fd = InstallBlkDev(s_Tel.Dev(), STDDEV_USER_FILENO);
+
+	s_CmdTime.clear();
+	for (uint64_t t = CMD_PERIOD_US; t < RUN_US; t += CMD_PERIOD_US)
+	{
+		s_Con.RxInject(t, "?\r", 2);
+		s_CmdTime.push_back(t + 2 * CON_BYTE_US);
+	}
+
+	return fd;
+}
+
+static void Cleanup(int TelFd)
+{
+	RemoveBlkDev(STDIN_FILENO);
+	RemoveBlkDev(STDOUT_FILENO);
+	RemoveBlkDev(STDFS_FILENO);
+	RemoveBlkDev(TelFd);
+}
+
+static void Status(RESULT &Res, uint64_t &Next)
+{
+	char line[STATUS_LEN + 1];
+	uint64_t t = s_Clock.usTime();
+
+	snprintf(line, sizeof(line), "ST %06u t=%-10llu %-35s\r\n", (unsigned)Res.StatusCnt,
+			 (unsigned long long)Next, "temp 23.5 hum 48.0 bat 3712");
+
+	uint64_t late = t - Next;
+	Res.StatusLateMax = late > Res.StatusLateMax ? late : Res.StatusLateMax;
+
+	int n = _write(STDOUT_FILENO, line, STATUS_LEN);
+
+	if (n != STATUS_LEN)
+	{
+		Res.StatusShort++;
+	}
+
+	uint64_t blk = s_Clock.usTime() - t;
+	Res.StatusBlockMax = blk > Res.StatusBlockMax ? blk : Res.StatusBlockMax;
+	Res.StatusCnt++;
+	Next += STATUS_PERIOD_US;
+}
+
+static void Command(RESULT &Res, const char *pData, int Len)
+{
+	for (int i = 0; i < Len; i++)
+	{
+		if (pData[i] == '\r' && Res.CmdCnt < s_CmdTime.size())
+		{
+			uint64_t lat = s_Clock.usTime() - s_CmdTime[Res.CmdCnt];
+
+			Res.CmdLatSum += lat;
+			Res.CmdLatMax = lat > Res.CmdLatMax ? lat : Res.CmdLatMax;
+			Res.CmdCnt++;
+			_write(STDOUT_FILENO, (char*)"OK ready, 3 streams open\r\n", 26);
+		}
+	}
+}
+
+static bool Verify(RESULT &Res)
+{
+	const std::vector<uint8_t> &f = s_File.Data();
+	const std::string &con = s_Con.TxData();
+	uint64_t st = 0, ok = 0;
+	size_t p = 0;
+	bool res = s_Tel.TxData().size() == f.size() && memcmp(s_Tel.TxData().data(), f.data(), f.size()) == 0;
+
+	// Console lines must not be broken
+	while (p < con.size())
+	{
+		size_t e = con.find("\r\n", p);
+
+		if (e == std::string::npos)
+		{
+			res = false;
+			break;
+		}
+		if (con.compare(p, 3, "ST ") == 0 && e - p == STATUS_LEN - 2)
+		{
+			st++;
+		}
+		else if (con.compare(p, e - p, "OK ready, 3 streams open") == 0)
+		{
+			ok++;
+		}
+		else
+		{
+			res = false;
+		}
+		p = e + 2;
+	}
+
+	return res && st == Res.StatusCnt && ok == Res.CmdCnt && Res.CmdCnt == s_CmdTime.size();
+}
+
+/// Blocking descriptors, each call waits for its device
+static RESULT RunBlocking()
+{
+	RESULT res;
+	int tel = Setup(false);
+	int fd = _open("FAT:/log.bin", 0, 0);
+	uint64_t next = STATUS_PERIOD_US;
+	size_t copied = 0;
+	char buf[FILE_CHUNK];
+
+	memset(&res, 0, sizeof(res));
+
+	while (s_Clock.usTime() < RUN_US || copied < FILE_SIZE)
+	{
+		if (copied < FILE_SIZE)
+		{
+			int n = _read(fd, buf, FILE_CHUNK);
+
+			if (n > 0)
+			{
+				copied += _write(tel, buf, n);
+			}
+			if (copied >= FILE_SIZE)
+			{
+				res.CopyDoneUs = s_Clock.usTime();
+			}
+		}
+
+		while (s_Clock.usTime() >= next && next < RUN_US)
+		{
+			Status(res, next);
+		}
+
+		// No way to know if console has data, read waits for it
+		int n = _read(STDIN_FILENO, buf, 16);
+		if (n > 0)
+		{
+			Command(res, buf, n);
+		}
+		else if (copied >= FILE_SIZE)
+		{
+			s_Clock.Advance(IDLE_US);
+		}
+	}
+
+	_close(fd);
+	res.bOk = Verify(res);
+	Cleanup(tel);
+
+	return res;
+}
+
+/// Non-blocking buffered descriptors multiplexed with StdDevPoll
+static RESULT RunEvent()
+{
+	RESULT res;
+	int tel = Setup(true);
+	int fd = _open("FAT:/log.bin", 0, 0);
+	uint64_t next = STATUS_PERIOD_US;
+	size_t copied = 0;
+	char chunk[FILE_CHUNK];
+	int chunklen = 0, chunkoff = 0;
+
+	memset(&res, 0, sizeof(res));
+
+	StdDevSetNonBlock(STDIN_FILENO, true);
+	StdDevSetNonBlock(STDOUT_FILENO, true);
+	StdDevSetNonBlock(tel, true);
+	StdDevSetBuffer(STDIN_FILENO, s_ConRxMem, sizeof(s_ConRxMem), NULL, 0);
+	StdDevSetBuffer(STDOUT_FILENO, NULL, 0, s_ConTxMem, sizeof(s_ConTxMem));
+	StdDevSetBuffer(tel, NULL, 0, s_TelTxMem, sizeof(s_TelTxMem));
+
+	while (s_Clock.usTime() < RUN_US || copied < FILE_SIZE)
+	{
+		STDDEV_POLLFD fds[2] = {
+			{ STDIN_FILENO, STDDEV_POLLIN, 0 },
+			{ tel, STDDEV_POLLOUT, 0 },
+		};
+		bool busy = false;
+
+		StdDevPoll(fds, 2);
+
+		if (fds[0].REvents & STDDEV_POLLIN)
+		{
+			char buf[16];
+			int n = _read(STDIN_FILENO, buf, sizeof(buf));
+
+			if (n > 0)
+			{
+				Command(res, buf, n);
+			}
+			busy = true;
+		}
+
+		while (s_Clock.usTime() >= next && next < RUN_US)
+		{
+			Status(res, next);
+			busy = true;
+		}
+
+		if ((fds[1].REvents & STDDEV_POLLOUT) && copied < FILE_SIZE)
+		{
+			if (chunkoff >= chunklen)
+			{
+				chunklen = _read(fd, chunk, FILE_CHUNK);
+				chunkoff = 0;
+			}
+			if (chunklen > 0)
+			{
+				int n = _write(tel, &chunk[chunkoff], chunklen - chunkoff);
+
+				if (n > 0)
+				{
+					chunkoff += n;
+					copied += n;
+				}
+			}
+			if (copied >= FILE_SIZE)
+			{
+				res.CopyDoneUs = s_Clock.usTime();
+			}
+			busy = true;
+		}
+
+		if (busy == false)
+		{
+			// Sleep until next event
+			s_Clock.Advance(IDLE_US);
+		}
+	}
+
+	// Flush stream buffers
+	for (int i = 0; i < 100000; i++)
+	{
+		StdDevProcess();
+		s_Clock.Advance(IDLE_US);
+	}
+
+	_close(fd);
+	res.bOk = Verify(res);
+	Cleanup(tel);
+
+	return res;
+}
+
+static void Print(const char *pName, const RESULT &Res)
+{
+	printf("%-9s %8.2f %8.2f %10.2f %10.2f %8u %9.3f  %s\n", pName,
+		   Res.CmdCnt ? Res.CmdLatSum / 1000.0 / Res.CmdCnt : 0.0, Res.CmdLatMax / 1000.0,
+		   Res.StatusLateMax / 1000.0, Res.StatusBlockMax / 1000.0, Res.StatusShort,
+		   Res.CopyDoneUs / 1000000.0, Res.bOk ? "PASS" : "FAIL");
+}
+
+/// BLE notification pump installed as a stdio device
+static bool CheckBle()
+{
+	static uint8_t mem[BLENTFPUMP_MEMSIZE(8, 244)];
+	BleStackSim stack;
+	BLESTACKSIM_CFG scfg = { 7500, 4, 4, 247 };
+	BLENTFPUMP pump;
+	BLENTFPUMP_CFG pcfg;
+	STDDEV dev = { "BLE", &pump, NULL, NULL, NULL, BleNtfPumpStdDevWrite, NULL, BleNtfPumpStdDevPoll };
+	std::string sent;
+	int eagain = 0, blocked = 0;
+
+	stack.Init(scfg);
+	memset(&pcfg, 0, sizeof(pcfg));
+	pcfg.pMem = mem;
+	pcfg.MemSize = sizeof(mem);
+	pcfg.MaxPayload = 244;
+	pcfg.PartialInFlight = 1;
+	pcfg.SendCB = BleStackSim::SendCB;
+	pcfg.pCtx = &stack;
+	BleNtfPumpInit(&pump, &pcfg);
+	BleNtfPumpSetMtu(&pump, stack.AttMtu());
+
+	int fd = InstallBlkDev(&dev, STDDEV_USER_FILENO);
+	StdDevSetNonBlock(fd, true);
+
+	for (int i = 0; i < 20000; i++)
+	{
+		char line[40];
+		int l = snprintf(line, sizeof(line), "tel %05d %08x\n", i, i * 2654435761U);
+		int off = 0;
+
+		while (off < l)
+		{
+			STDDEV_POLLFD pfd = { fd, STDDEV_POLLOUT, 0 };
+
+			if (StdDevPoll(&pfd, 1) == 0)
+			{
+				// Pump full, wait for connection event
+				blocked++;
+				BleNtfPumpTxComplete(&pump, stack.ConnEvent());
+				continue;
+			}
+
+			int n = _write(fd, &line[off], l - off);
+
+			if (n < 0)
+			{
+				eagain += errno == EAGAIN;
+				BleNtfPumpTxComplete(&pump, stack.ConnEvent());
+				continue;
+			}
+			sent.append(&line[off], n);
+			off += n;
+		}
+	}
+	for (int i = 0; i < 1000; i++)
+	{
+		BleNtfPumpTxComplete(&pump, stack.ConnEvent());
+	}
+	RemoveBlkDev(fd);
+
+	bool ok = stack.RxData().size() == sent.size() && memcmp(stack.RxData().data(), sent.data(), sent.size()) == 0 &&
+			  blocked > 0;
+
+	printf("BLE pump as stdio device : %zu bytes, %d polls not ready, %d EAGAIN, %.1f bytes/pkt  %s\n",
+		   sent.size(), blocked, eagain, (double)stack.RxData().size() / stack.PktCount(), ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+static uint64_t NsTime()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+/// Host cost of the layer calls
+static void CallCost()
+{
+	static uint8_t txmem[65536];
+	int tel = Setup(true);
+	char line[STATUS_LEN];
+	const int nb = 100000;
+
+	memset(line, 'x', sizeof(line));
+	StdDevSetNonBlock(STDIN_FILENO, true);
+	StdDevSetNonBlock(STDOUT_FILENO, true);
+	StdDevSetNonBlock(tel, true);
+	StdDevSetBuffer(STDIN_FILENO, s_ConRxMem, sizeof(s_ConRxMem), NULL, 0);
+	StdDevSetBuffer(tel, NULL, 0, s_TelTxMem, sizeof(s_TelTxMem));
+
+	STDDEV_POLLFD fds[3] = {
+		{ STDIN_FILENO, STDDEV_POLLIN, 0 },
+		{ STDOUT_FILENO, STDDEV_POLLOUT, 0 },
+		{ tel, STDDEV_POLLOUT, 0 },
+	};
+
+	uint64_t t = NsTime();
+	for (int i = 0; i < nb; i++)
+	{
+		StdDevPoll(fds, 3);
+	}
+	double tpoll = (double)(NsTime() - t) / nb;
+
+	double twr = 0;
+	for (int i = 0; i < nb; i += 1000)
+	{
+		// Device FIFO full & clock stopped, writes only queue
+		s_Con.Init(&s_Clock, CON_BYTE_US, 64, 64, false);
+		s_Con.Dev()->Write(s_Con.Dev()->pDevObj, STDOUT_FILENO, txmem, 64);
+		StdDevSetBuffer(STDOUT_FILENO, NULL, 0, txmem, sizeof(txmem));
+		t = NsTime();
+		for (int j = 0; j < 1000; j++)
+		{
+			_write(STDOUT_FILENO, line, sizeof(line));
+		}
+		twr += NsTime() - t;
+	}
+	twr /= nb;
+
+	StdDevSetBuffer(STDOUT_FILENO, NULL, 0, NULL, 0);
+	t = NsTime();
+	for (int i = 0; i < nb; i++)
+	{
+		_write(STDOUT_FILENO, line, sizeof(line));
+	}
+	double teagain = (double)(NsTime() - t) / nb;
+
+	Cleanup(tel);
+
+	printf("Host cost : StdDevPoll 3 fds %.0f ns, buffered %d bytes write %.0f ns, EAGAIN write %.0f ns\n",
+		   tpoll, STATUS_LEN, twr, teagain);
+}
+
+int main()
+{
+	printf("stdio devices : console %d us/byte, telemetry %d us/byte, file %d us access, %d KB copy\n\n",
+		   CON_BYTE_US, TEL_BYTE_US, FILE_ACCESS_US, FILE_SIZE / 1024);
+	printf("%-9s %17s %10s %10s %8s %9s\n", "", "cmd latency ms", "status", "status", "status", "copy");
+	printf("%-9s %8s %8s %10s %10s %8s %9s\n", "mode", "avg", "max", "late ms", "block ms", "short", "done s");
+
+	RESULT blk = RunBlocking();
+	Print("blocking", blk);
+
+	RESULT evt = RunEvent();
+	Print("event", evt);
+
+	bool ok = blk.bOk && evt.bOk;
+
+	// Event driven must bound latency by the longest synchronous call (file read)
+	ok &= evt.CmdLatMax < 2 * FILE_ACCESS_US + 1000 && evt.StatusLateMax < 2 * FILE_ACCESS_US + 1000;
+	ok &= evt.StatusBlockMax == 0 && evt.StatusShort == 0;
+	ok &= evt.CopyDoneUs < FILE_SIZE * TEL_BYTE_US * 11ULL / 10;
+	ok &= evt.CmdLatMax < blk.CmdLatMax && evt.StatusLateMax < blk.StatusLateMax;
+
+	printf("\n");
+	ok &= CheckBle();
+	CallCost();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
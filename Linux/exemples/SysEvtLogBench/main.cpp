@@ -0,0 +1,412 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Binary system event log check & benchmark
+
+Measures events per second logged by the binary event log against SysStatus
+with a description string and against formatting the text at log time.  Checks
+that records written by concurrent producers are never torn and that lost
+records are accounted for, the message formatter, and persistence to a flash
+image across a restart.  The flash image and format table are left for
+SysEvtLogDecode.
+
+Usage : SysEvtLogBench [image file]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+#include <vector>
+#include <algorithm>
+
+#include "sysstatus.h"
+#include "sysevtlog.h"
+#include "diskio_flashimg.h"
+
+#define BENCH_COUNT			5000000
+#define RING_SIZE			1024
+#define NB_PRODUCER			4
+#define PRODUCER_COUNT		1000000
+#define FLASH_SIZE_KB		64
+#define PERSIST_SECT		4		// Region start sector
+#define PERSIST_NBSECT		8
+
+#define BENCH_EVTFMT(X) \
+	X(EVTFMT_BOOT,		"Boot, reset reason 0x%08x") \
+	X(EVTFMT_BATLOW,	"Battery low %u mV") \
+	X(EVTFMT_TEMP,		"Temperature %d.%02u C, sensor %c") \
+	X(EVTFMT_SEQ,		"Event %u of %u, %% done %3u") \
+	X(EVTFMT_PROD,		"Producer %u count %u check %x %x")
+
+enum { BENCH_EVTFMT(SYSEVTLOG_FMT_ENUM) };
+
+static const char * const s_EvtFmt[] = { BENCH_EVTFMT(SYSEVTLOG_FMT_STR) };
+static const int s_NbEvtFmt = sizeof(s_EvtFmt) / sizeof(s_EvtFmt[0]);
+
+static SYSEVTLOG_REC s_LogMem[RING_SIZE];
+static int s_FailCnt = 0;
+
+static void Check(bool bOk, const char *pMsg)
+{
+	printf("  %-56s %s\n", pMsg, bOk ? "PASS" : "FAIL");
+	if (bOk == false)
+	{
+		s_FailCnt++;
+	}
+}
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+static uint32_t s_Time = 0;
+
+static uint32_t TimeStamp()
+{
+	return s_Time++;
+}
+
+static void Throughput()
+{
+	SYSEVTLOG_CFG cfg = { s_LogMem, RING_SIZE, TimeStamp };
+	SYSEVTLOG log;
+	char text[RING_SIZE / 8][SYSSTATUS_DESC_MAX];
+	double t;
+	volatile uint32_t mv = 3300;
+
+	printf("Throughput, %d events\n", BENCH_COUNT);
+
+	SysEvtLogInit(&log, &cfg);
+	t = usNow();
+	for (int i = 0; i < BENCH_COUNT; i++)
+	{
+		SYSEVTLOG(&log, SYSSTATUS_TYPE_WRN | 1, SYSEVTLOG_FMTID_NONE);
+	}
+	t = usNow() - t;
+	printf("  %-36s %8.2f Mevt/s  %6.1f ns/evt\n", "event log, code only", BENCH_COUNT / t, t * 1000 / BENCH_COUNT);
+
+	t = usNow();
+	for (int i = 0; i < BENCH_COUNT; i++)
+	{
+		SYSEVTLOG(&log, SYSSTATUS_TYPE_WRN | 2, EVTFMT_BATLOW, mv);
+	}
+	t = usNow() - t;
+	printf("  %-36s %8.2f Mevt/s  %6.1f ns/evt\n", "event log, 1 arg", BENCH_COUNT / t, t * 1000 / BENCH_COUNT);
+
+	t = usNow();
+	for (int i = 0; i < BENCH_COUNT; i++)
+	{
+		SYSEVTLOG(&log, SYSSTATUS_TYPE_ERR | 3, EVTFMT_PROD, (uint32_t)i, mv, 3, 4);
+	}
+	t = usNow() - t;
+	printf("  %-36s %8.2f Mevt/s  %6.1f ns/evt\n", "event log, 4 args", BENCH_COUNT / t, t * 1000 / BENCH_COUNT);
+
+	char desc[] = "Battery low, switching to power save mode";
+
+	t = usNow();
+	for (int i = 0; i < BENCH_COUNT; i++)
+	{
+		SysStatusSet(SYSSTATUS_TYPE_WRN | 2, desc);
+	}
+	t = usNow() - t;
+	printf("  %-36s %8.2f Mevt/s  %6.1f ns/evt\n", "SysStatusSet with description", BENCH_COUNT / t, t * 1000 / BENCH_COUNT);
+
+	t = usNow();
+	for (int i = 0; i < BENCH_COUNT; i++)
+	{
+		snprintf(text[i & (RING_SIZE / 8 - 1)], SYSSTATUS_DESC_MAX, s_EvtFmt[EVTFMT_BATLOW], (unsigned)mv);
+	}
+	t = usNow() - t;
+	printf("  %-36s %8.2f Mevt/s  %6.1f ns/evt\n", "text formatted at log time", BENCH_COUNT / t, t * 1000 / BENCH_COUNT);
+}
+
+static SYSEVTLOG s_MtLog;
+static volatile bool s_bGo = false;
+
+static void *Producer(void *pArg)
+{
+	uint32_t id = (uint32_t)(uintptr_t)pArg;
+
+	while (s_bGo == false);
+
+	for (uint32_t i = 0; i < PRODUCER_COUNT; i++)
+	{
+		uint32_t a[4] = { id, i, ~i, id ^ (i * 2654435761U) };
+
+		SysEvtLogWrite(&s_MtLog, SYSSTATUS_TYPE_RNT | id, EVTFMT_PROD, 4, a);
+	}
+
+	return NULL;
+}
+
+static void MultiProducer()
+{
+	SYSEVTLOG_CFG cfg = { s_LogMem, RING_SIZE, NULL };
+	pthread_t th[NB_PRODUCER];
+	SYSEVTLOG_REC rec[64];
+	int64_t last[NB_PRODUCER];
+	uint32_t seq = 1, read = 0, lost = 0, bad = 0;
+
+	printf("\n%d producers x %d events, ring %d records, concurrent reader, producers flood the ring\n", NB_PRODUCER, PRODUCER_COUNT, RING_SIZE);
+
+	SysEvtLogInit(&s_MtLog, &cfg);
+	for (int i = 0; i < NB_PRODUCER; i++)
+	{
+		last[i] = -1;
+		pthread_create(&th[i], NULL, Producer, (void*)(uintptr_t)i);
+	}
+
+	double t = usNow();
+	s_bGo = true;
+
+	uint32_t total = NB_PRODUCER * PRODUCER_COUNT;
+
+	while (seq <= total)
+	{
+		uint32_t l = 0;
+		int n = SysEvtLogGet(&s_MtLog, &seq, rec, 64, &l);
+
+		lost += l;
+		for (int i = 0; i < n; i++)
+		{
+			uint32_t id = rec[i].Arg[0];
+
+			if (id >= NB_PRODUCER || rec[i].NbArg != 4 || rec[i].Code != id ||
+				rec[i].Arg[2] != ~rec[i].Arg[1] || rec[i].Arg[3] != (id ^ (rec[i].Arg[1] * 2654435761U)) ||
+				(int64_t)rec[i].Arg[1] <= last[id])
+			{
+				bad++;
+				continue;
+			}
+			last[id] = rec[i].Arg[1];
+		}
+		read += n;
+	}
+
+	for (int i = 0; i < NB_PRODUCER; i++)
+	{
+		pthread_join(th[i], NULL);
+	}
+	t = usNow() - t;
+
+	printf("  %.2f Mevt/s, read %u, lost %u (%.1f%%)\n", total / t, read, lost, 100.0 * lost / total);
+	Check(bad == 0, "no torn or out of order record");
+	Check(read + lost == total && SysEvtLogHead(&s_MtLog) == total, "all records read or counted lost");
+}
+
+static void Formatter()
+{
+	char buff[128];
+	SYSEVTLOG_REC rec = {};
+	const char * const fmt[] = { "%5d|%-4x|%%|%c|%s|%lu|%u" };
+
+	printf("\nFormatter\n");
+
+	rec.FmtId = EVTFMT_TEMP;
+	rec.NbArg = 3;
+	rec.Arg[0] = (uint32_t)-12;
+	rec.Arg[1] = 5;
+	rec.Arg[2] = 'A';
+	SysEvtLogFormat(&rec, s_EvtFmt, s_NbEvtFmt, buff, sizeof(buff));
+	Check(strcmp(buff, "Temperature -12.05 C, sensor A") == 0, "signed, precision & char");
+
+	rec.FmtId = EVTFMT_SEQ;
+	rec.Arg[0] = 3;
+	rec.Arg[1] = 4;
+	rec.Arg[2] = 75;
+	SysEvtLogFormat(&rec, s_EvtFmt, s_NbEvtFmt, buff, sizeof(buff));
+	Check(strcmp(buff, "Event 3 of 4, % done  75") == 0, "percent & width");
+
+	rec.FmtId = 0;
+	rec.NbArg = 4;
+	rec.Arg[0] = (uint32_t)-7;
+	rec.Arg[1] = 0xab;
+	rec.Arg[2] = 'z';
+	rec.Arg[3] = 42;
+	int l = SysEvtLogFormat(&rec, fmt, 1, buff, sizeof(buff));
+	Check(strcmp(buff, "   -7|ab  |%|z|%s|42|?") == 0 && l == (int)strlen(buff), "unsupported & missing args");
+
+	l = SysEvtLogFormat(&rec, fmt, 1, buff, 8);
+	Check(strcmp(buff, "   -7|a") == 0 && l == 22, "truncated, full length returned");
+
+	rec.FmtId = SYSEVTLOG_FMTID_NONE;
+	rec.NbArg = 2;
+	SysEvtLogFormat(&rec, s_EvtFmt, s_NbEvtFmt, buff, sizeof(buff));
+	Check(strcmp(buff, "0xfffffff9 0xab") == 0, "no format string");
+
+	rec.FmtId = 100;
+	SysEvtLogFormat(&rec, s_EvtFmt, s_NbEvtFmt, buff, sizeof(buff));
+	Check(strcmp(buff, "fmt 100 0xfffffff9 0xab") == 0, "unknown format id");
+}
+
+/**
+ * Read region back, records ordered by sector sequence
+ */
+static std::vector<SYSEVTLOG_REC> ReadRegion(DiskIO &Disk)
+{
+	std::vector<SYSEVTLOG_SECT> sects;
+	std::vector<SYSEVTLOG_REC> recs;
+	SYSEVTLOG_SECT s;
+
+	for (int i = 0; i < PERSIST_NBSECT; i++)
+	{
+		if (Disk.SectRead(PERSIST_SECT + i, (uint8_t*)&s) && SysEvtLogSectValid(&s))
+		{
+			sects.push_back(s);
+		}
+	}
+	std::sort(sects.begin(), sects.end(),
+			  [](const SYSEVTLOG_SECT &a, const SYSEVTLOG_SECT &b) { return a.SectSeq < b.SectSeq; });
+	for (size_t i = 0; i < sects.size(); i++)
+	{
+		recs.insert(recs.end(), sects[i].Rec, sects[i].Rec + sects[i].NbRec);
+	}
+
+	return recs;
+}
+
+static void Persistence(const char *pPath)
+{
+	FlashImgDiskIO disk;
+	SysEvtLog log;
+	SYSEVTLOG_CFG cfg = { s_LogMem, 64, TimeStamp };
+	uint32_t nsect = 0;
+
+	printf("\nPersistence to %s, sectors %d-%d\n", pPath, PERSIST_SECT, PERSIST_SECT + PERSIST_NBSECT - 1);
+
+	remove(pPath);
+	if (disk.Init(pPath, FLASH_SIZE_KB, 4) == false)
+	{
+		Check(false, "flash image open");
+		return;
+	}
+
+	s_Time = 1000;
+	log.Init(cfg);
+	Check(log.PersistInit(&disk, PERSIST_SECT, PERSIST_NBSECT), "persist init on blank region");
+
+	// Boot then periodic readings, persisted every 10 events
+	SYSEVTLOG(log, SYSSTATUS_TYPE_RNT | SYSSTATUS_STARTED, EVTFMT_BOOT, 0x4);
+	for (uint32_t i = 1; i < 200; i++)
+	{
+		if (i % 50 == 0)
+		{
+			SYSEVTLOG(log, SYSSTATUS_TYPE_WRN | (SYSSTATUS_MODID_APP << 16) | 0x101, EVTFMT_BATLOW, 3300 - i);
+		}
+		else
+		{
+			SYSEVTLOG(log, SYSSTATUS_TYPE_RNT | SYSSTATUS_RUNNING, EVTFMT_TEMP, 20 + i % 5, i % 100, 'A' + i % 3);
+		}
+		if (i % 10 == 0)
+		{
+			nsect += log.Persist();
+		}
+	}
+	nsect += log.Persist(true);
+
+	std::vector<SYSEVTLOG_REC> recs = ReadRegion(disk);
+
+	// 200 records, 14 sectors written, region keeps last 8
+	bool ok = nsect == (200 + SYSEVTLOG_SECT_NBREC - 1) / SYSEVTLOG_SECT_NBREC && log.PersistLost() == 0 &&
+			  recs.size() == (PERSIST_NBSECT - 1) * SYSEVTLOG_SECT_NBREC + 200 % SYSEVTLOG_SECT_NBREC;
+
+	for (size_t i = 0; ok && i < recs.size(); i++)
+	{
+		ok = recs[i].Seq == 200 - recs.size() + i + 1 && recs[i].TimeStamp == 1000 + recs[i].Seq - 1;
+	}
+	Check(ok, "last sectors persisted in order");
+
+	// Restart, logging resumes after most recent sector
+	SysEvtLog log2;
+
+	s_Time = 5000;
+	log2.Init(cfg);
+	ok = log2.PersistInit(&disk, PERSIST_SECT, PERSIST_NBSECT);
+	SYSEVTLOG(log2, SYSSTATUS_TYPE_RNT | SYSSTATUS_STARTED, EVTFMT_BOOT, 0x1);
+	SYSEVTLOG(log2, SYSSTATUS_TYPE_ERR | (SYSSTATUS_MODID_FILE << 16) | SYSSTATUS_FILEWRITE, SYSEVTLOG_FMTID_NONE, 7);
+	ok &= log2.Persist() == 0 && log2.Persist(true) == 1;
+
+	std::vector<SYSEVTLOG_REC> recs2 = ReadRegion(disk);
+
+	ok &= recs2.size() == recs.size() - SYSEVTLOG_SECT_NBREC + 2 && recs2.back().TimeStamp == 5001 &&
+		  recs2.back().Code == (SYSSTATUS_TYPE_ERR | (SYSSTATUS_MODID_FILE << 16) | SYSSTATUS_FILEWRITE) &&
+		  memcmp(&recs2[0], &recs[SYSEVTLOG_SECT_NBREC], sizeof(SYSEVTLOG_REC)) == 0;
+	Check(ok, "restart resumes after most recent sector");
+
+	// Torn sector is ignored
+	SYSEVTLOG_SECT s;
+
+	disk.SectRead(PERSIST_SECT + 3, (uint8_t*)&s);
+	s.Rec[2].Arg[0] ^= 1;
+	disk.SectWrite(PERSIST_SECT + 3, (uint8_t*)&s);
+	Check(ReadRegion(disk).size() == recs2.size() - s.NbRec, "corrupted sector rejected");
+	s.Rec[2].Arg[0] ^= 1;
+	disk.SectWrite(PERSIST_SECT + 3, (uint8_t*)&s);
+
+	disk.Close();
+
+	// Format table for the decoder, one line per format id
+	char path[256];
+
+	snprintf(path, sizeof(path), "%s.fmt", pPath);
+	FILE *fp = fopen(path, "w");
+
+	if (fp)
+	{
+		for (int i = 0; i < s_NbEvtFmt; i++)
+		{
+			fprintf(fp, "%s\n", s_EvtFmt[i]);
+		}
+		fclose(fp);
+		printf("  decode with : SysEvtLogDecode %s %s %d %d\n", pPath, path, PERSIST_SECT, PERSIST_NBSECT);
+	}
+}
+
+int main(int argc, char **argv)
+{
+	const char *path = argc > 1 ? argv[1] : "/tmp/iosonata_evtlog.bin";
+
+	Throughput();
+	MultiProducer();
+	Formatter();
+	Persistence(path);
+
+	printf("\n%s\n", s_FailCnt == 0 ? "PASS" : "FAIL");
+
+	return s_FailCnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,163 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Binary system event log decoder
+
+Decodes event log sectors persisted by SysEvtLog from a disk or flash image
+dump into text.  Sectors are validated and ordered by write sequence.  The
+format file holds one format string per line, line number is the format id.
+It is usually generated from the same X macro list as the firmware format ids.
+Without format file, arguments are printed in hex.
+
+Usage : SysEvtLogDecode <image file> [format file] [start sector] [nb sectors]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+
+#include "sysevtlog.h"
+
+static bool LoadFmt(const char *pPath, std::vector<std::string> &Fmt)
+{
+	FILE *fp = fopen(pPath, "r");
+	char line[512];
+
+	if (fp == NULL)
+	{
+		return false;
+	}
+
+	while (fgets(line, sizeof(line), fp))
+	{
+		line[strcspn(line, "\r\n")] = 0;
+		Fmt.push_back(line);
+	}
+	fclose(fp);
+
+	return true;
+}
+
+static const char *TypeName(STATUS Code)
+{
+	switch (Code & SYSSTATUS_TYPE_MASK)
+	{
+		case SYSSTATUS_TYPE_RNT:
+			return "RNT";
+		case SYSSTATUS_TYPE_WRN:
+			return "WRN";
+		case SYSSTATUS_TYPE_ERR:
+			return "ERR";
+		case SYSSTATUS_TYPE_FERR:
+			return "FERR";
+	}
+
+	return "?";
+}
+
+int main(int argc, char **argv)
+{
+	if (argc < 2)
+	{
+		printf("Usage : SysEvtLogDecode <image file> [format file] [start sector] [nb sectors]\n");
+		return 1;
+	}
+
+	std::vector<std::string> fmt;
+	std::vector<const char *> fmttbl;
+
+	if (argc > 2 && LoadFmt(argv[2], fmt) == false)
+	{
+		printf("Failed to open format file %s\n", argv[2]);
+		return 1;
+	}
+	for (size_t i = 0; i < fmt.size(); i++)
+	{
+		fmttbl.push_back(fmt[i].c_str());
+	}
+
+	FILE *fp = fopen(argv[1], "rb");
+
+	if (fp == NULL)
+	{
+		printf("Failed to open image %s\n", argv[1]);
+		return 1;
+	}
+
+	long start = argc > 3 ? atol(argv[3]) : 0;
+	long nbsect = argc > 4 ? atol(argv[4]) : -1;
+	std::vector<SYSEVTLOG_SECT> sects;
+	SYSEVTLOG_SECT s;
+	long invalid = 0;
+
+	fseek(fp, start * SYSEVTLOG_SECT_SIZE, SEEK_SET);
+	for (long i = 0; (nbsect < 0 || i < nbsect) && fread(&s, SYSEVTLOG_SECT_SIZE, 1, fp) == 1; i++)
+	{
+		if (SysEvtLogSectValid(&s))
+		{
+			sects.push_back(s);
+		}
+		else if (s.Magic == SYSEVTLOG_SECT_MAGIC)
+		{
+			invalid++;
+		}
+	}
+	fclose(fp);
+
+	std::stable_sort(sects.begin(), sects.end(),
+					 [](const SYSEVTLOG_SECT &a, const SYSEVTLOG_SECT &b) { return a.SectSeq < b.SectSeq; });
+
+	printf("%zu sectors, %ld corrupted\n\n", sects.size(), invalid);
+	printf("%-9s %8s %10s %-4s %-3s %-4s  %s\n", "SECT.REC", "SEQ", "TIME", "TYPE", "MOD", "CODE", "MESSAGE");
+
+	for (size_t i = 0; i < sects.size(); i++)
+	{
+		// Gap in write sequence means sectors were overwritten or lost
+		if (i > 0 && sects[i].SectSeq != sects[i - 1].SectSeq + 1)
+		{
+			printf("--- %u sectors missing\n", sects[i].SectSeq - sects[i - 1].SectSeq - 1);
+		}
+		for (int j = 0; j < sects[i].NbRec; j++)
+		{
+			const SYSEVTLOG_REC &r = sects[i].Rec[j];
+			char msg[256];
+
+			SysEvtLogFormat(&r, fmttbl.data(), fmttbl.size(), msg, sizeof(msg));
+			printf("%6u.%-2d %8u %10u %-4s %03x %04x  %s\n", sects[i].SectSeq, j, r.Seq, r.TimeStamp,
+				   TypeName(r.Code), (r.Code & SYSSTATUS_MODID_MASK) >> 16, r.Code & SYSSTATUS_CODE_MASK, msg);
+		}
+	}
+
+	return 0;
+}
@@ -0,0 +1,205 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Timer wheel benchmark
+
+Runs 10k software timers on the simulated timer.  Reports insert, cancel and
+expire cost in real time and the number of hardware wakeups in virtual time,
+with and without slack.
+
+Usage : TimerWheelBench [number of timers]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <chrono>
+#include <vector>
+
+#include "timer_sim.h"
+#include "coredev/timer_wheel.h"
+
+using namespace std::chrono;
+
+#define NB_TIMER			10000
+#define SIM_FREQ			32768		// Same as RTC
+
+static const TIMER_CFG s_TimerCfg = {
+	0,						// DevNo
+	TIMER_CLKSRC_DEFAULT,
+	SIM_FREQ,
+	1,
+	NULL,
+};
+
+TimerSim g_Timer;
+TimerWheel g_Wheel;
+
+std::vector<SWTIMER> g_SwTimer;
+uint32_t g_ExpCnt = 0;
+uint64_t g_MaxLate = 0;
+uint32_t g_EarlyCnt = 0;
+
+static void SwTimerHandler(SWTIMER * const pSwTimer, void * const pContext)
+{
+	uint64_t now = g_Timer.TickCount();
+	// Nominal expiry of this occurrence. Periodic timers already moved to next one
+	uint64_t exp = pSwTimer->Period ? pSwTimer->Expire - pSwTimer->Period : pSwTimer->Expire;
+
+	g_ExpCnt++;
+
+	if (now < exp)
+	{
+		g_EarlyCnt++;
+	}
+	else if (now - exp > g_MaxLate)
+	{
+		g_MaxLate = now - exp;
+	}
+}
+
+static void RunOneShot(int NbTimer, uint32_t msSlack)
+{
+	g_Timer.Init(s_TimerCfg);
+	g_Wheel.Init(&g_Timer);
+	g_SwTimer.assign(NbTimer, SWTIMER());
+	g_ExpCnt = g_EarlyCnt = 0;
+	g_MaxLate = 0;
+	srand(1);
+
+	// Delays from 1 ms to 60 s
+	auto t1 = steady_clock::now();
+	for (int i = 0; i < NbTimer; i++)
+	{
+		g_Wheel.Start(&g_SwTimer[i], (uint32_t)(1 + rand() % 60000), TIMER_TRIG_TYPE_SINGLE, msSlack, SwTimerHandler);
+	}
+	double tins = duration<double, std::nano>(steady_clock::now() - t1).count() / NbTimer;
+
+	// Cancel every 4th
+	t1 = steady_clock::now();
+	for (int i = 0; i < NbTimer; i += 4)
+	{
+		g_Wheel.Stop(&g_SwTimer[i]);
+	}
+	double tcan = duration<double, std::nano>(steady_clock::now() - t1).count() / ((NbTimer + 3) / 4);
+	uint32_t nbactive = g_Wheel.Count();
+
+	t1 = steady_clock::now();
+	while (g_Wheel.Count() > 0 && g_Timer.AdvanceToTrigger());
+	double texp = duration<double, std::nano>(steady_clock::now() - t1).count() / g_ExpCnt;
+
+	printf("  one shot, slack %4u ms : insert %6.1f ns, cancel %5.1f ns, expire %6.1f ns, "
+		   "%u/%u fired, %u wakeups, late max %.2f ms, early %u\n",
+		   msSlack, tins, tcan, texp, g_ExpCnt, nbactive, g_Timer.IrqCount(),
+		   g_MaxLate * 1000.0 / SIM_FREQ, g_EarlyCnt);
+}
+
+static void RunPeriodic(int NbTimer, uint32_t SlackPct)
+{
+	g_Timer.Init(s_TimerCfg);
+	g_Wheel.Init(&g_Timer);
+	g_SwTimer.assign(NbTimer, SWTIMER());
+	g_ExpCnt = g_EarlyCnt = 0;
+	g_MaxLate = 0;
+	srand(2);
+
+	// Periods from 10 ms to 10 s
+	for (int i = 0; i < NbTimer; i++)
+	{
+		uint32_t period = 10 + rand() % 10000;
+
+		g_Wheel.Start(&g_SwTimer[i], period, TIMER_TRIG_TYPE_CONTINUOUS, period * SlackPct / 100, SwTimerHandler);
+	}
+
+	// 60 s of virtual time
+	auto t1 = steady_clock::now();
+	uint64_t end = g_Timer.TickCount() + 60 * SIM_FREQ;
+
+	while (g_Timer.TickCount() < end && g_Timer.AdvanceToTrigger());
+
+	double texp = duration<double, std::nano>(steady_clock::now() - t1).count() / g_ExpCnt;
+
+	printf("  periodic, slack %3u %%  : expire %6.1f ns, %u expirations, %u wakeups in 60 s, late max %.2f ms, early %u\n",
+		   SlackPct, texp, g_ExpCnt, g_Timer.IrqCount(), g_MaxLate * 1000.0 / SIM_FREQ, g_EarlyCnt);
+
+	for (int i = 0; i < NbTimer; i++)
+	{
+		g_Wheel.Stop(&g_SwTimer[i]);
+	}
+}
+
+// Long periods at high timer frequency must not wrap
+static bool CheckConversion()
+{
+	TIMER_CFG cfg = s_TimerCfg;
+	bool ok = true;
+
+	cfg.Freq = 16000000;
+	g_Timer.Init(cfg);
+	g_Wheel.Init(&g_Timer);
+
+	uint64_t f = g_Timer.Frequency();
+
+	ok &= g_Wheel.nsToTick(30ULL * 60 * 1000000000ULL) == 30ULL * 60 * f;
+	ok &= g_Wheel.nsToTick(10ULL * 86400 * 1000000000ULL) == 10ULL * 86400 * f;
+	ok &= g_Wheel.nsToTick(1000000000ULL + 1) == f + 1;
+
+	printf("  ns to tick, 30 min & 10 days at %u Hz : %s\n", (uint32_t)f, ok ? "OK" : "FAILED");
+
+	bool okns = g_Wheel.TickToNs(30ULL * 60 * f) == 30ULL * 60 * 1000000000ULL;
+	okns &= g_Wheel.TickToNs(10ULL * 86400 * f) == 10ULL * 86400 * 1000000000ULL;
+	okns &= g_Wheel.TickToNs(f + 1) == 1000000000ULL + 62;
+
+	printf("  tick to ns, 30 min & 10 days at %u Hz : %s\n", (uint32_t)f, okns ? "OK" : "FAILED");
+
+	ok &= okns;
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	int nbtimer = argc > 1 ? atoi(argv[1]) : NB_TIMER;
+
+	if (nbtimer <= 0)
+	{
+		nbtimer = NB_TIMER;
+	}
+
+	printf("Timer wheel, %d timers, %d Hz timer\n", nbtimer, SIM_FREQ);
+
+	RunOneShot(nbtimer, 0);
+	RunOneShot(nbtimer, 10);
+	RunOneShot(nbtimer, 100);
+	RunPeriodic(nbtimer, 0);
+	RunPeriodic(nbtimer, 5);
+
+	return CheckConversion() ? 0 : 1;
+}
@@ -0,0 +1,570 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Linux UART driver benchmark
+
+Runs two UART instances back to back over a pty pair and reports sustained
+throughput and round trip latency. Without arguments the bench creates the
+pty pair itself and links the two masters the way socat does. Ports created
+by socat can be given instead :
+
+	socat -d -d pty,raw,echo=0 pty,raw,echo=0
+	UartLinuxBench /dev/pts/3 /dev/pts/4
+
+The direct mode is the previous host path (uart_osx) : one read or write
+system call per UARTRx/UARTTx as done by uart_prbs_tx/rx. PRBS streams are
+verified on the receiving side in both directions at the same time. Latency
+is measured with the remote end echoing from its UART_EVT_RXDATA handler.
+
+Usage : UartLinuxBench [PortA PortB]
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <termios.h>
+#include <pthread.h>
+#include <time.h>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include "coredev/uart.h"
+#include "prbs.h"
+#include "uart_linux.h"
+
+#define STREAM_SIZE			(8 * 1024 * 1024)
+#define DIRECT_SIZE			(256 * 1024)
+#define BYTE_SIZE			(1024 * 1024)
+#define PING_COUNT			2000
+#define PING_SIZE			16
+#define FIFO_MEMSIZE		CFIFO_MEMSIZE(16384)
+
+static char s_PortPath[2][64];
+static int s_hMaster[2] = { -1, -1 };
+
+static uint64_t usNow()
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+
+	return (uint64_t)t.tv_sec * 1000000ULL + t.tv_nsec / 1000;
+}
+
+/// One direction of the pty link, same job as socat
+static void *Bridge(void *pArg)
+{
+	int idx = (int)(intptr_t)pArg;
+	int rd = s_hMaster[idx];
+	int wr = s_hMaster[idx ^ 1];
+	uint8_t buff[65536];
+
+	while (true)
+	{
+		int n = read(rd, buff, sizeof(buff));
+
+		if (n <= 0)
+		{
+			// EIO while slave side is closed
+			usleep(1000);
+			continue;
+		}
+
+		uint8_t *p = buff;
+		while (n > 0)
+		{
+			int l = write(wr, p, n);
+			if (l <= 0)
+			{
+				usleep(100);
+				continue;
+			}
+			p += l;
+			n -= l;
+		}
+	}
+
+	return NULL;
+}
+
+static bool CreatePtyLink()
+{
+	for (int i = 0; i < 2; i++)
+	{
+		s_hMaster[i] = posix_openpt(O_RDWR | O_NOCTTY);
+		if (s_hMaster[i] < 0 || grantpt(s_hMaster[i]) < 0 || unlockpt(s_hMaster[i]) < 0)
+		{
+			return false;
+		}
+		strncpy(s_PortPath[i], ptsname(s_hMaster[i]), sizeof(s_PortPath[i]) - 1);
+
+		// Raw slave so nothing is echoed back before a port is opened
+		struct termios t;
+		int fd = open(s_PortPath[i], O_RDWR | O_NOCTTY);
+		if (fd < 0)
+		{
+			return false;
+		}
+		tcgetattr(fd, &t);
+		cfmakeraw(&t);
+		tcsetattr(fd, TCSANOW, &t);
+		close(fd);
+	}
+
+	for (int i = 0; i < 2; i++)
+	{
+		pthread_t h;
+		pthread_create(&h, NULL, Bridge, (void*)(intptr_t)i);
+		pthread_detach(h);
+	}
+
+	return true;
+}
+
+// ---- Direct system call path (previous host implementation) ----
+
+static int OpenDirect(const char *pPath)
+{
+	int fd = open(pPath, O_RDWR | O_NOCTTY);
+	struct termios t;
+
+	if (fd < 0)
+	{
+		return -1;
+	}
+
+	tcgetattr(fd, &t);
+	cfmakeraw(&t);
+	t.c_cc[VMIN] = 0;
+	t.c_cc[VTIME] = 10;
+	tcsetattr(fd, TCSANOW, &t);
+	tcflush(fd, TCIOFLUSH);
+
+	return fd;
+}
+
+typedef struct {
+	int hFile;
+	int Size;
+} DIRECTARG;
+
+static void *DirectTx(void *pArg)
+{
+	DIRECTARG *a = (DIRECTARG*)pArg;
+	uint8_t d = 1;
+
+	for (int i = 0; i < a->Size; i++)
+	{
+		while (write(a->hFile, &d, 1) <= 0);
+		d = Prbs8(d);
+	}
+
+	return NULL;
+}
+
+static bool RunDirect()
+{
+	int fa = OpenDirect(s_PortPath[0]);
+	int fb = OpenDirect(s_PortPath[1]);
+	DIRECTARG arg = { fa, DIRECT_SIZE };
+	pthread_t h;
+	uint8_t val = 1, d;
+	int err = 0, cnt = 0;
+
+	if (fa < 0 || fb < 0)
+	{
+		printf("Cannot open ports\n");
+		return false;
+	}
+
+	uint64_t t = usNow();
+
+	pthread_create(&h, NULL, DirectTx, &arg);
+
+	while (cnt < DIRECT_SIZE)
+	{
+		if (read(fb, &d, 1) <= 0)
+		{
+			break;
+		}
+		err += d != val;
+		val = Prbs8(d);
+		cnt++;
+	}
+	t = usNow() - t;
+
+	pthread_join(h, NULL);
+	close(fa);
+	close(fb);
+
+	bool ok = cnt == DIRECT_SIZE && err == 0;
+
+	printf("  direct 1 byte/call    A->B   %8.2f kB/s  %2u syscall/byte                %s\n",
+		   cnt * 1000.0 / t, 2, ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+// ---- UART driver ----
+
+typedef struct {
+	UARTDEV Dev;
+	pthread_mutex_t Lock;
+	pthread_cond_t Cond;
+	std::atomic<int> RxEvtCnt;
+	std::atomic<int> TxEvtCnt;
+	std::atomic<int> LineEvtCnt;
+	bool bEcho;
+	alignas(4) uint8_t RxMem[FIFO_MEMSIZE];
+	alignas(4) uint8_t TxMem[FIFO_MEMSIZE];
+} BENCHPORT;
+
+static BENCHPORT s_Port[2];
+
+static int UartEvtHandler(UARTDEV * const pDev, UART_EVT EvtId, uint8_t *pBuffer, int BufferLen)
+{
+	BENCHPORT *port = pDev == &s_Port[0].Dev ? &s_Port[0] : &s_Port[1];
+
+	switch (EvtId)
+	{
+		case UART_EVT_RXTIMEOUT:
+		case UART_EVT_RXDATA:
+			port->RxEvtCnt++;
+			if (port->bEcho)
+			{
+				uint8_t buff[256];
+				int l = UARTRx(pDev, buff, sizeof(buff));
+				UARTTx(pDev, buff, l);
+			}
+			else
+			{
+				pthread_mutex_lock(&port->Lock);
+				pthread_cond_signal(&port->Cond);
+				pthread_mutex_unlock(&port->Lock);
+			}
+			break;
+		case UART_EVT_TXREADY:
+			port->TxEvtCnt++;
+			pthread_mutex_lock(&port->Lock);
+			pthread_cond_signal(&port->Cond);
+			pthread_mutex_unlock(&port->Lock);
+			break;
+		case UART_EVT_LINESTATE:
+			port->LineEvtCnt++;
+			break;
+	}
+
+	return 0;
+}
+
+static bool OpenPort(int Idx)
+{
+	UARTCFG cfg;
+
+	memset(&cfg, 0, sizeof(cfg));
+	cfg.DevNo = Idx;
+	cfg.pIOPinMap = s_PortPath[Idx];
+	cfg.NbIOPins = strlen(s_PortPath[Idx]);
+	cfg.Rate = 3000000;
+	cfg.DataBits = 8;
+	cfg.Parity = UART_PARITY_NONE;
+	cfg.StopBits = 1;
+	cfg.FlowControl = UART_FLWCTRL_NONE;
+	cfg.bIntMode = true;
+	cfg.EvtCallback = UartEvtHandler;
+	cfg.bFifoBlocking = true;
+	cfg.RxMemSize = FIFO_MEMSIZE;
+	cfg.pRxMem = s_Port[Idx].RxMem;
+	cfg.TxMemSize = FIFO_MEMSIZE;
+	cfg.pTxMem = s_Port[Idx].TxMem;
+
+	pthread_mutex_init(&s_Port[Idx].Lock, NULL);
+	pthread_cond_init(&s_Port[Idx].Cond, NULL);
+	s_Port[Idx].bEcho = false;
+
+	return UARTInit(&s_Port[Idx].Dev, &cfg);
+}
+
+/// Wait for an event on port, 10 ms max
+static void WaitEvt(BENCHPORT *pPort)
+{
+	struct timespec t;
+
+	clock_gettime(CLOCK_REALTIME, &t);
+	t.tv_nsec += 10000000;
+	if (t.tv_nsec >= 1000000000)
+	{
+		t.tv_sec++;
+		t.tv_nsec -= 1000000000;
+	}
+	pthread_mutex_lock(&pPort->Lock);
+	pthread_cond_timedwait(&pPort->Cond, &pPort->Lock, &t);
+	pthread_mutex_unlock(&pPort->Lock);
+}
+
+typedef struct {
+	BENCHPORT *pPort;
+	int Size;			// Bytes to transfer
+	int ChunkSize;		// Bytes per UARTTx/UARTRx call
+	int Cnt;
+	int ErrCnt;
+	uint64_t usTime;
+} STREAMARG;
+
+static void *StreamTx(void *pArg)
+{
+	STREAMARG *a = (STREAMARG*)pArg;
+	uint8_t buff[4096];
+	uint8_t d = 1;
+	uint64_t t = usNow();
+
+	a->Cnt = 0;
+	while (a->Cnt < a->Size)
+	{
+		int l = std::min(a->ChunkSize, a->Size - a->Cnt);
+		for (int i = 0; i < l; i++)
+		{
+			buff[i] = d;
+			d = Prbs8(d);
+		}
+		uint8_t *p = buff;
+		while (l > 0)
+		{
+			int n = UARTTx(&a->pPort->Dev, p, l);
+			if (n <= 0)
+			{
+				WaitEvt(a->pPort);
+				continue;
+			}
+			p += n;
+			l -= n;
+			a->Cnt += n;
+		}
+	}
+	a->usTime = usNow() - t;
+
+	return NULL;
+}
+
+static void *StreamRx(void *pArg)
+{
+	STREAMARG *a = (STREAMARG*)pArg;
+	uint8_t buff[4096];
+	uint8_t val = 1;
+	uint64_t t = usNow();
+	uint64_t tlast = t;
+
+	a->Cnt = 0;
+	a->ErrCnt = 0;
+	while (a->Cnt < a->Size && usNow() - tlast < 2000000)
+	{
+		int n = UARTRx(&a->pPort->Dev, buff, std::min(a->ChunkSize, (int)sizeof(buff)));
+		if (n <= 0)
+		{
+			WaitEvt(a->pPort);
+			continue;
+		}
+		for (int i = 0; i < n; i++)
+		{
+			a->ErrCnt += buff[i] != val;
+			val = Prbs8(buff[i]);
+		}
+		a->Cnt += n;
+		tlast = usNow();
+	}
+	a->usTime = usNow() - t;
+
+	return NULL;
+}
+
+static bool RunStream(const char *pName, int Size, int ChunkSize, bool bDuplex)
+{
+	STREAMARG tx[2], rx[2];
+	pthread_t htx[2], hrx[2];
+	int nbdir = bDuplex ? 2 : 1;
+	bool ok = true;
+
+	for (int i = 0; i < nbdir; i++)
+	{
+		tx[i] = { &s_Port[i], Size, ChunkSize, 0, 0, 0 };
+		rx[i] = { &s_Port[i ^ 1], Size, ChunkSize, 0, 0, 0 };
+		pthread_create(&hrx[i], NULL, StreamRx, &rx[i]);
+	}
+	for (int i = 0; i < nbdir; i++)
+	{
+		pthread_create(&htx[i], NULL, StreamTx, &tx[i]);
+	}
+	for (int i = 0; i < nbdir; i++)
+	{
+		pthread_join(htx[i], NULL);
+		pthread_join(hrx[i], NULL);
+
+		LINUXUARTDEV *rd = (LINUXUARTDEV*)s_Port[i ^ 1].Dev.DevIntrf.pDevData;
+		bool res = rx[i].Cnt == Size && rx[i].ErrCnt == 0;
+
+		printf("  %-21s %s   %8.2f kB/s  %5.1f bytes/read syscall  err %d  %s\n", pName,
+			   i == 0 ? "A->B" : "B->A", rx[i].Cnt * 1000.0 / rx[i].usTime,
+			   rd->RxSysCnt ? (double)rd->RxCnt / rd->RxSysCnt : 0.0, rx[i].ErrCnt, res ? "PASS" : "FAIL");
+		ok &= res;
+	}
+
+	return ok;
+}
+
+static void ResetCounters()
+{
+	for (int i = 0; i < 2; i++)
+	{
+		LINUXUARTDEV *d = (LINUXUARTDEV*)s_Port[i].Dev.DevIntrf.pDevData;
+		d->RxCnt = d->TxCnt = d->RxSysCnt = d->TxSysCnt = 0;
+	}
+}
+
+static bool RunLatency()
+{
+	std::vector<uint32_t> rtt;
+	uint8_t ping[PING_SIZE], pong[PING_SIZE];
+	int fail = 0;
+
+	s_Port[1].bEcho = true;
+
+	for (int i = 0; i < PING_COUNT; i++)
+	{
+		for (int j = 0; j < PING_SIZE; j++)
+		{
+			ping[j] = (uint8_t)(i + j);
+		}
+
+		uint64_t t = usNow();
+		int cnt = 0;
+
+		UARTTx(&s_Port[0].Dev, ping, PING_SIZE);
+		while (cnt < PING_SIZE && usNow() - t < 100000)
+		{
+			int n = UARTRx(&s_Port[0].Dev, &pong[cnt], PING_SIZE - cnt);
+			if (n <= 0)
+			{
+				WaitEvt(&s_Port[0]);
+				continue;
+			}
+			cnt += n;
+		}
+		t = usNow() - t;
+		if (cnt != PING_SIZE || memcmp(ping, pong, PING_SIZE) != 0)
+		{
+			fail++;
+			continue;
+		}
+		rtt.push_back((uint32_t)t);
+	}
+
+	s_Port[1].bEcho = false;
+
+	if (rtt.empty())
+	{
+		printf("  latency : no echo  FAIL\n");
+		return false;
+	}
+
+	std::sort(rtt.begin(), rtt.end());
+
+	uint64_t sum = 0;
+	for (size_t i = 0; i < rtt.size(); i++)
+	{
+		sum += rtt[i];
+	}
+
+	bool ok = fail == 0;
+
+	printf("  round trip %d bytes, echo from Rx event : min %u us  avg %.1f us  p99 %u us  max %u us  %s\n",
+		   PING_SIZE, rtt[0], (double)sum / rtt.size(), rtt[rtt.size() * 99 / 100], rtt.back(),
+		   ok ? "PASS" : "FAIL");
+
+	return ok;
+}
+
+int main(int argc, char **argv)
+{
+	bool ok = true;
+
+	if (argc >= 3)
+	{
+		strncpy(s_PortPath[0], argv[1], sizeof(s_PortPath[0]) - 1);
+		strncpy(s_PortPath[1], argv[2], sizeof(s_PortPath[1]) - 1);
+	}
+	else if (CreatePtyLink() == false)
+	{
+		printf("Cannot create pty pair\n");
+		return 1;
+	}
+
+	printf("Linux UART, %s <-> %s\n\n", s_PortPath[0], s_PortPath[1]);
+
+	ok &= RunDirect();
+
+	if (OpenPort(0) == false || OpenPort(1) == false)
+	{
+		printf("UARTInit failed\nFAIL\n");
+		return 1;
+	}
+
+	ResetCounters();
+	ok &= RunStream("uart 1 byte/call", BYTE_SIZE, 1, false);
+	ResetCounters();
+	ok &= RunStream("uart 4096 bytes/call", STREAM_SIZE, 4096, false);
+	ResetCounters();
+	ok &= RunStream("uart full duplex", STREAM_SIZE, 4096, true);
+
+	printf("\n");
+	ok &= RunLatency();
+
+	// Port must come back after disable/enable
+	UARTDisable(&s_Port[0].Dev);
+	UARTEnable(&s_Port[0].Dev);
+	ResetCounters();
+	ok &= RunStream("uart after re-enable", BYTE_SIZE, 4096, false);
+
+	printf("\n  events A : rx %d  tx ready %d  line %d\n", s_Port[0].RxEvtCnt.load(),
+		   s_Port[0].TxEvtCnt.load(), s_Port[0].LineEvtCnt.load());
+	printf("  events B : rx %d  tx ready %d  line %d\n", s_Port[1].RxEvtCnt.load(),
+		   s_Port[1].TxEvtCnt.load(), s_Port[1].LineEvtCnt.load());
+
+	DeviceIntrfPowerOff(&s_Port[0].Dev.DevIntrf);
+	DeviceIntrfPowerOff(&s_Port[1].Dev.DevIntrf);
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,581 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	Linux USB HID host backend benchmark
+
+Runs a simulated HID firmware on /dev/uhid when available, otherwise on a
+SOCK_SEQPACKET socket pair with hidraw read/write semantic. Measures
+synchronous versus pipelined report round trips, queued output throughput,
+streamed input delivery latency, timeout accuracy & input queue overflow.
+Every test checks the report payloads and prints PASS or FAIL.
+
+Usage : UsbHidBench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/socket.h>
+#include <linux/uhid.h>
+#include <atomic>
+#include <thread>
+#include <string>
+#include <vector>
+
+#include "usb_hidhost_impl.h"
+
+#define FW_VID				0x1915
+#define FW_PID				0xDB01
+#define REP_SIZE			64
+#define QUEUE_DEPTH			256
+
+#define CMD_ECHO			0x01	// Reply with same report
+#define CMD_STREAM			0x02	// [1..4] count, [5..8] period usec
+#define CMD_DATA			0x03	// [1..4] sequence, no reply
+#define CMD_STATUS			0x04	// Reply with data count & sequence errors
+
+#define RTT_COUNT			2000
+#define PIPE_WINDOW			16
+#define DATA_COUNT			20000
+#define STREAM_COUNT		8000
+#define STREAM_PERIOD_US	125		// High speed interrupt endpoint
+#define TIMEOUT_US			500
+#define TIMEOUT_COUNT		200
+#define OVERFLOW_COUNT		1000
+
+// Vendor defined, 64 bytes input & output, no report id
+static const uint8_t s_RepDesc[] = {
+	0x06, 0x00, 0xFF, 0x09, 0x01, 0xA1, 0x01, 0x15, 0x00, 0x26, 0xFF, 0x00, 0x75, 0x08,
+	0x95, REP_SIZE, 0x09, 0x01, 0x81, 0x02,
+	0x95, REP_SIZE, 0x09, 0x01, 0x91, 0x02,
+	0xC0
+};
+
+/// Simulated device firmware
+class HidFw {
+public:
+	HidFw() : vFd(-1), vbUhid(false), vbRun(false), vDataCnt(0), vDataErr(0) {}
+	~HidFw() { Stop(); }
+
+	bool StartUhid() {
+		int fd = open("/dev/uhid", O_RDWR | O_CLOEXEC);
+
+		if (fd < 0)
+		{
+			return false;
+		}
+
+		struct uhid_event ev;
+
+		memset(&ev, 0, sizeof(ev));
+		ev.type = UHID_CREATE2;
+		strcpy((char*)ev.u.create2.name, "I-SYST HID bench");
+		ev.u.create2.rd_size = sizeof(s_RepDesc);
+		memcpy(ev.u.create2.rd_data, s_RepDesc, sizeof(s_RepDesc));
+		ev.u.create2.bus = 3;	// BUS_USB
+		ev.u.create2.vendor = FW_VID;
+		ev.u.create2.product = FW_PID;
+
+		if (write(fd, &ev, sizeof(ev)) != sizeof(ev))
+		{
+			close(fd);
+			return false;
+		}
+		vFd = fd;
+		vbUhid = true;
+		Run();
+
+		return true;
+	}
+
+	/// Returns host side descriptor
+	int StartSocket() {
+		int sv[2];
+
+		if (socketpair(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0, sv) < 0)
+		{
+			return -1;
+		}
+		vFd = sv[1];
+		vbUhid = false;
+		Run();
+
+		return sv[0];
+	}
+
+	void Stop() {
+		if (vThread.joinable())
+		{
+			vbRun = false;
+			vThread.join();
+		}
+		if (vFd >= 0)
+		{
+			if (vbUhid)
+			{
+				struct uhid_event ev;
+
+				memset(&ev, 0, sizeof(ev));
+				ev.type = UHID_DESTROY;
+				if (write(vFd, &ev, sizeof(ev))) {}
+			}
+			close(vFd);
+			vFd = -1;
+		}
+	}
+
+	bool IsUhid() { return vbUhid; }
+
+private:
+	void Run() {
+		vbRun = true;
+		vThread = std::thread(&HidFw::Thread, this);
+	}
+
+	bool Send(const uint8_t *pData) {
+		if (vbUhid)
+		{
+			struct uhid_event ev;
+
+			memset(&ev, 0, sizeof(ev));
+			ev.type = UHID_INPUT2;
+			ev.u.input2.size = REP_SIZE;
+			memcpy(ev.u.input2.data, pData, REP_SIZE);
+
+			return write(vFd, &ev, sizeof(ev)) == sizeof(ev);
+		}
+
+		return write(vFd, pData, REP_SIZE) == REP_SIZE;
+	}
+
+	/// Receive output report, report id stripped
+	int Recv(uint8_t *pData) {
+		if (vbUhid)
+		{
+			struct uhid_event ev;
+
+			if (read(vFd, &ev, sizeof(ev)) <= 0 || ev.type != UHID_OUTPUT || ev.u.output.size < 2)
+			{
+				return 0;
+			}
+			memcpy(pData, &ev.u.output.data[1], ev.u.output.size - 1);
+
+			return ev.u.output.size - 1;
+		}
+
+		uint8_t buf[REP_SIZE + 1];
+		int l = read(vFd, buf, sizeof(buf));
+
+		if (l < 2)
+		{
+			return 0;
+		}
+		memcpy(pData, &buf[1], l - 1);
+
+		return l - 1;
+	}
+
+	void Stream(uint32_t Count, uint32_t PeriodUs) {
+		uint8_t d[REP_SIZE];
+		struct timespec ts;
+
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+
+		for (uint32_t i = 0; i < Count && vbRun; i++)
+		{
+			if (PeriodUs > 0)
+			{
+				ts.tv_nsec += PeriodUs * 1000;
+				if (ts.tv_nsec >= 1000000000)
+				{
+					ts.tv_nsec -= 1000000000;
+					ts.tv_sec++;
+				}
+				clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+			}
+
+			uint64_t t = UsbHidDevice_Impl::nsTime();
+
+			d[0] = CMD_STREAM;
+			memcpy(&d[1], &i, 4);
+			memcpy(&d[8], &t, 8);
+			for (int j = 16; j < REP_SIZE; j++)
+			{
+				d[j] = (uint8_t)(i + j);
+			}
+			Send(d);
+		}
+	}
+
+	void Thread() {
+		struct pollfd pfd = { vFd, POLLIN, 0 };
+		uint8_t d[REP_SIZE];
+
+		while (vbRun)
+		{
+			if (poll(&pfd, 1, 10) <= 0)
+			{
+				continue;
+			}
+
+			memset(d, 0, sizeof(d));
+			if (Recv(d) <= 0)
+			{
+				continue;
+			}
+
+			uint32_t v;
+
+			switch (d[0])
+			{
+				case CMD_ECHO:
+					Send(d);
+					break;
+				case CMD_STREAM:
+				{
+					uint32_t p;
+
+					memcpy(&v, &d[1], 4);
+					memcpy(&p, &d[5], 4);
+					Stream(v, p);
+					break;
+				}
+				case CMD_DATA:
+					memcpy(&v, &d[1], 4);
+					if (v != vDataCnt || d[REP_SIZE - 1] != (uint8_t)v)
+					{
+						vDataErr++;
+					}
+					vDataCnt++;
+					break;
+				case CMD_STATUS:
+					memcpy(&d[1], &vDataCnt, 4);
+					memcpy(&d[5], &vDataErr, 4);
+					vDataCnt = vDataErr = 0;
+					Send(d);
+					break;
+			}
+		}
+	}
+
+	int vFd;
+	bool vbUhid;
+	std::atomic<bool> vbRun;
+	std::thread vThread;
+	uint32_t vDataCnt;
+	uint32_t vDataErr;
+};
+
+static void FillEcho(uint8_t *pBuf, uint32_t Seq)
+{
+	pBuf[0] = CMD_ECHO;
+	memcpy(&pBuf[1], &Seq, 4);
+	for (int i = 5; i < REP_SIZE; i++)
+	{
+		pBuf[i] = (uint8_t)(Seq * 3 + i);
+	}
+}
+
+static bool Report(const char *pName, bool Ok)
+{
+	printf("  %-44s %s\n", pName, Ok ? "PASS" : "FAIL");
+
+	return Ok;
+}
+
+/// Synchronous write then read, one report in flight
+static bool TestRoundTripSync(UsbHidDevice_Impl &Dev, double &Rate)
+{
+	uint8_t out[REP_SIZE], in[REP_SIZE];
+	uint64_t t = UsbHidDevice_Impl::nsTime();
+	bool ok = true;
+
+	for (uint32_t i = 0; i < RTT_COUNT && ok; i++)
+	{
+		FillEcho(out, i);
+		ok = Dev.WriteOutputReport(0, out, REP_SIZE, false) &&
+			 Dev.ReadInputReport(0, in, REP_SIZE, false) == REP_SIZE && memcmp(in, out, REP_SIZE) == 0;
+	}
+	t = UsbHidDevice_Impl::nsTime() - t;
+	Rate = RTT_COUNT * 1e9 / t;
+	printf("  sync round trip      : %8.0f reports/s, %6.1f us each\n", Rate, t / 1000.0 / RTT_COUNT);
+
+	return Report("synchronous round trip", ok);
+}
+
+/// Queued writes, up to PIPE_WINDOW reports in flight
+static bool TestRoundTripPipe(UsbHidDevice_Impl &Dev, double &Rate)
+{
+	uint8_t out[REP_SIZE], in[REP_SIZE], exp[REP_SIZE];
+	uint64_t t = UsbHidDevice_Impl::nsTime();
+	uint32_t sent = 0, rcvd = 0;
+	bool ok = true;
+
+	while (rcvd < RTT_COUNT && ok)
+	{
+		while (sent < RTT_COUNT && sent - rcvd < PIPE_WINDOW)
+		{
+			FillEcho(out, sent);
+			if (Dev.QueueOutputReport(0, out, REP_SIZE) == false)
+			{
+				break;
+			}
+			sent++;
+		}
+
+		FillEcho(exp, rcvd);
+		ok = Dev.GetInputReport(in, REP_SIZE, 1000000) == REP_SIZE && memcmp(in, exp, REP_SIZE) == 0;
+		rcvd++;
+	}
+	t = UsbHidDevice_Impl::nsTime() - t;
+	Rate = RTT_COUNT * 1e9 / t;
+	printf("  pipelined round trip : %8.0f reports/s, window %d\n", Rate, PIPE_WINDOW);
+
+	const USBHID_LATSTAT &lat = Dev.OutLatency(0);
+
+	printf("  output queue latency : avg %6.1f us, max %7.1f us\n",
+		   lat.Cnt ? lat.SumNs / 1000.0 / lat.Cnt : 0.0, lat.MaxNs / 1000.0);
+
+	return Report("pipelined round trip, order & payload", ok);
+}
+
+/// Output only stream, checked by the firmware
+static bool TestOutput(UsbHidDevice_Impl &Dev)
+{
+	uint8_t out[REP_SIZE], in[REP_SIZE];
+	uint64_t t = UsbHidDevice_Impl::nsTime();
+	uint32_t full = 0;
+
+	memset(out, 0, sizeof(out));
+	out[0] = CMD_DATA;
+
+	for (uint32_t i = 0; i < DATA_COUNT; i++)
+	{
+		memcpy(&out[1], &i, 4);
+		out[REP_SIZE - 1] = (uint8_t)i;
+		while (Dev.QueueOutputReport(0, out, REP_SIZE) == false)
+		{
+			full++;
+			usleep(20);
+		}
+	}
+
+	bool ok = Dev.FlushOutput(5000000);
+
+	t = UsbHidDevice_Impl::nsTime() - t;
+
+	uint32_t cnt = 0, err = 0;
+
+	memset(out, 0, sizeof(out));
+	out[0] = CMD_STATUS;
+	ok = ok && Dev.WriteOutputReport(0, out, REP_SIZE, false) && Dev.ReadInputReport(0, in, REP_SIZE, false) == REP_SIZE;
+	memcpy(&cnt, &in[1], 4);
+	memcpy(&err, &in[5], 4);
+	ok = ok && in[0] == CMD_STATUS && cnt == DATA_COUNT && err == 0 && Dev.OutErrorCount() == 0;
+
+	printf("  queued output        : %8.0f reports/s, %u received, %u out of order, queue full %u\n",
+		   DATA_COUNT * 1e9 / t, cnt, err, full);
+
+	return Report("queued output reports", ok);
+}
+
+/// Device paced input stream
+static bool TestStream(UsbHidDevice_Impl &Dev)
+{
+	uint8_t out[REP_SIZE], in[REP_SIZE];
+	uint32_t p = STREAM_PERIOD_US, n = STREAM_COUNT;
+	uint64_t lsum = 0, lmax = 0;
+	bool ok = true;
+
+	Dev.ResetStats();
+	memset(out, 0, sizeof(out));
+	out[0] = CMD_STREAM;
+	memcpy(&out[1], &n, 4);
+	memcpy(&out[5], &p, 4);
+	ok = Dev.WriteOutputReport(0, out, REP_SIZE, false);
+
+	for (uint32_t i = 0; i < STREAM_COUNT && ok; i++)
+	{
+		uint32_t seq;
+		uint64_t tsent;
+
+		ok = Dev.GetInputReport(in, REP_SIZE, 1000000) == REP_SIZE;
+		if (ok == false)
+		{
+			break;
+		}
+
+		uint64_t l = UsbHidDevice_Impl::nsTime();
+
+		memcpy(&seq, &in[1], 4);
+		memcpy(&tsent, &in[8], 8);
+		l -= tsent;
+		lsum += l;
+		lmax = l > lmax ? l : lmax;
+		ok = in[0] == CMD_STREAM && seq == i && in[REP_SIZE - 1] == (uint8_t)(i + REP_SIZE - 1);
+	}
+
+	const USBHID_LATSTAT &lat = Dev.InLatency(0);
+
+	printf("  input stream         : %u reports @ %u us, drop %u\n", n, p, Dev.InDropCount());
+	printf("  device to app        : avg %6.1f us, max %7.1f us\n", lsum / 1000.0 / STREAM_COUNT, lmax / 1000.0);
+	printf("  input queue latency  : avg %6.1f us, max %7.1f us\n",
+		   lat.Cnt ? lat.SumNs / 1000.0 / lat.Cnt : 0.0, lat.MaxNs / 1000.0);
+
+	return Report("streamed input, sequence & payload", ok && Dev.InDropCount() == 0);
+}
+
+static bool TestTimeout(UsbHidDevice_Impl &Dev)
+{
+	uint8_t in[REP_SIZE];
+	uint64_t sum = 0, min = UINT64_MAX, max = 0;
+	bool ok = true;
+
+	for (int i = 0; i < TIMEOUT_COUNT; i++)
+	{
+		uint64_t t = UsbHidDevice_Impl::nsTime();
+
+		ok &= Dev.GetInputReport(in, REP_SIZE, TIMEOUT_US) == 0;
+		t = UsbHidDevice_Impl::nsTime() - t;
+		sum += t;
+		min = t < min ? t : min;
+		max = t > max ? t : max;
+	}
+
+	double avg = sum / 1000.0 / TIMEOUT_COUNT;
+
+	printf("  %u us timeout       : min %6.1f us, avg %6.1f us, max %7.1f us\n", TIMEOUT_US,
+		   min / 1000.0, avg, max / 1000.0);
+
+	// Never early, late by less than scheduling noise on average
+	return Report("usec timeout", ok && min >= TIMEOUT_US * 1000ULL && avg < TIMEOUT_US + 1000);
+}
+
+static bool TestOverflow(UsbHidDevice_Impl &Dev)
+{
+	uint8_t out[REP_SIZE], in[REP_SIZE];
+	uint32_t p = 0, n = OVERFLOW_COUNT;
+	uint32_t drop0 = Dev.InDropCount();
+	bool ok;
+
+	memset(out, 0, sizeof(out));
+	out[0] = CMD_STREAM;
+	memcpy(&out[1], &n, 4);
+	memcpy(&out[5], &p, 4);
+	ok = Dev.WriteOutputReport(0, out, REP_SIZE, false);
+
+	// Nobody reads, wait for all reports to be received
+	for (int i = 0; i < 200 && Dev.InDropCount() - drop0 < OVERFLOW_COUNT - QUEUE_DEPTH; i++)
+	{
+		usleep(10000);
+	}
+	usleep(20000);
+
+	uint32_t drop = Dev.InDropCount() - drop0;
+	int pending = Dev.InputPending();
+
+	for (uint32_t i = 0; i < QUEUE_DEPTH && ok; i++)
+	{
+		uint32_t seq;
+
+		ok = Dev.GetInputReport(in, REP_SIZE, 0) == REP_SIZE;
+		memcpy(&seq, &in[1], 4);
+		ok = ok && seq == i;
+	}
+
+	printf("  overflow             : %u sent, %d queued, %u dropped\n", n, pending, drop);
+
+	return Report("input overflow drops newest, keeps order",
+				  ok && pending == QUEUE_DEPTH && drop == OVERFLOW_COUNT - QUEUE_DEPTH && Dev.InputPending() == 0);
+}
+
+int main()
+{
+	HidFw fw;
+	UsbHidDevice_Impl dev;
+	bool ok = false;
+
+	if (fw.StartUhid())
+	{
+		std::vector<std::string> paths;
+
+		for (int i = 0; i < 200 && paths.empty(); i++)
+		{
+			usleep(10000);
+			UsbHidDevice_Impl::Find(FW_VID, FW_PID, paths);
+		}
+		ok = paths.empty() == false && dev.Init(paths[0].c_str(), QUEUE_DEPTH);
+		if (ok)
+		{
+			printf("Transport : uhid, %s\n\n", paths[0].c_str());
+		}
+		else
+		{
+			fw.Stop();
+		}
+	}
+
+	if (ok == false)
+	{
+		int fd = fw.StartSocket();
+
+		ok = fd >= 0 && dev.Init(fd, REP_SIZE, REP_SIZE, false, QUEUE_DEPTH);
+		printf("Transport : SOCK_SEQPACKET socket pair, /dev/uhid not available\n\n");
+	}
+
+	if (ok == false)
+	{
+		printf("Cannot open device\nFAIL\n");
+		return 1;
+	}
+
+	double sync, pipe;
+
+	ok &= TestRoundTripSync(dev, sync);
+	ok &= TestRoundTripPipe(dev, pipe);
+	printf("  pipelined speedup    : x%.1f\n", pipe / sync);
+	ok &= TestOutput(dev);
+	ok &= TestStream(dev);
+	ok &= TestTimeout(dev);
+	ok &= TestOverflow(dev);
+
+	dev.Close();
+	fw.Stop();
+
+	printf("\n%s\n", ok ? "PASS" : "FAIL");
+
+	return ok ? 0 : 1;
+}
@@ -0,0 +1,784 @@
+/**-------------------------------------------------------------------------
+@file	main.cpp
+
+@brief	UTF-8 conversion conformance check and benchmark
+
+Checks utf8.c against a straightforward Unicode Table 3-7 reference : all
+code points round trip through UTF-16 and UTF-32, every 1 to 3 bytes sequence
+and a 4 bytes subset validate the same at all SIMD block offsets, named
+malformed cases, random fuzz, destination limits and the codecvt facet.
+Then compares throughput with the previous code point at a time conversion
+over mixed script corpora.
+
+Usage : Utf8Bench
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include <wchar.h>
+#include <string>
+#include <vector>
+#include <locale>
+
+#include "utf8.h"
+#include "utf8cvt.h"
+
+#define CORPUS_SIZE			(2 * 1024 * 1024)
+#define BENCH_TIME_US		300000.0
+
+static int s_FailCnt = 0;
+
+static void Check(bool bOk, const char *pMsg)
+{
+	if (bOk == false)
+	{
+		if (s_FailCnt < 20)
+		{
+			printf("  FAIL : %s\n", pMsg);
+		}
+		s_FailCnt++;
+	}
+}
+
+static double usNow()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000.0 + ts.tv_nsec / 1000.0;
+}
+
+/// Reference encoder
+static int RefEncode(uint32_t c, uint8_t *p)
+{
+	if (c < 0x80)
+	{
+		p[0] = c;
+		return 1;
+	}
+	if (c < 0x800)
+	{
+		p[0] = 0xc0 | (c >> 6);
+		p[1] = 0x80 | (c & 0x3f);
+		return 2;
+	}
+	if (c < 0x10000)
+	{
+		p[0] = 0xe0 | (c >> 12);
+		p[1] = 0x80 | ((c >> 6) & 0x3f);
+		p[2] = 0x80 | (c & 0x3f);
+		return 3;
+	}
+	p[0] = 0xf0 | (c >> 18);
+	p[1] = 0x80 | ((c >> 12) & 0x3f);
+	p[2] = 0x80 | ((c >> 6) & 0x3f);
+	p[3] = 0x80 | (c & 0x3f);
+
+	return 4;
+}
+
+/**
+ * Reference validator, Unicode Table 3-7 well formed byte sequences.
+ * Same return convention as utf8validate.
+ */
+static int RefValidate(const uint8_t *p, size_t Len, size_t *pValid)
+{
+	size_t i = 0;
+
+	while (i < Len)
+	{
+		uint8_t b = p[i];
+		int n;
+		uint8_t lo = 0x80, hi = 0xbf;
+
+		if (b < 0x80)
+		{
+			i++;
+			continue;
+		}
+		if (b >= 0xc2 && b <= 0xdf)
+			n = 2;
+		else if (b >= 0xe0 && b <= 0xef)
+		{
+			n = 3;
+			lo = b == 0xe0 ? 0xa0 : 0x80;
+			hi = b == 0xed ? 0x9f : 0xbf;
+		}
+		else if (b >= 0xf0 && b <= 0xf4)
+		{
+			n = 4;
+			lo = b == 0xf0 ? 0x90 : 0x80;
+			hi = b == 0xf4 ? 0x8f : 0xbf;
+		}
+		else
+		{
+			*pValid = i;
+			return -1;
+		}
+
+		for (int k = 1; k < n; k++)
+		{
+			if (i + k >= Len)
+			{
+				*pValid = i;
+				return 1;
+			}
+			uint8_t c = p[i + k];
+			if (k == 1 ? (c < lo || c > hi) : (c & 0xc0) != 0x80)
+			{
+				*pValid = i;
+				return -1;
+			}
+		}
+		i += n;
+	}
+	*pValid = Len;
+
+	return 0;
+}
+
+/// Validate with and without SIMD, both must match the reference
+static void CheckValidate(const uint8_t *p, size_t Len, const char *pName)
+{
+	size_t rv, v1, v2;
+	int rr = RefValidate(p, Len, &rv);
+
+	utf8setsimd(true);
+	int r1 = utf8validate((const char*)p, Len, &v1);
+	utf8setsimd(false);
+	int r2 = utf8validate((const char*)p, Len, &v2);
+	utf8setsimd(true);
+
+	if (r1 != rr || v1 != rv || r2 != rr || v2 != rv)
+	{
+		char s[160];
+		snprintf(s, sizeof(s), "%s, len %zu, ref %d/%zu simd %d/%zu scalar %d/%zu", pName, Len, rr, rv, r1, v1, r2, v2);
+		Check(false, s);
+	}
+}
+
+static void CheckAllCodePoints(bool bSimd)
+{
+	std::vector<uint8_t> u8;
+	std::vector<uint32_t> u32;
+	std::vector<uint16_t> u16;
+
+	for (uint32_t c = 0; c < 0x110000; c++)
+	{
+		if (c >= 0xd800 && c < 0xe000)
+		{
+			continue;
+		}
+		uint8_t b[4];
+		int n = RefEncode(c, b);
+		u8.insert(u8.end(), b, b + n);
+		u32.push_back(c);
+		if (c >= 0x10000)
+		{
+			u16.push_back(0xd800 | ((c - 0x10000) >> 10));
+			u16.push_back(0xdc00 | ((c - 0x10000) & 0x3ff));
+		}
+		else
+		{
+			u16.push_back(c);
+		}
+	}
+
+	utf8setsimd(bSimd);
+
+	size_t v;
+	Check(utf8validate((const char*)u8.data(), u8.size(), &v) == 0 && v == u8.size(), "all code points validate");
+
+	std::vector<uint32_t> d32(u8.size());
+	size_t sl = u8.size(), dl = d32.size();
+	Check(utf8toutf32((const char*)u8.data(), &sl, d32.data(), &dl) == 0 && sl == u8.size() &&
+		  dl == u32.size() && memcmp(d32.data(), u32.data(), dl * 4) == 0, "all code points to UTF-32");
+
+	std::vector<uint16_t> d16(u8.size());
+	sl = u8.size();
+	dl = d16.size();
+	Check(utf8toutf16((const char*)u8.data(), &sl, d16.data(), &dl) == 0 && sl == u8.size() &&
+		  dl == u16.size() && memcmp(d16.data(), u16.data(), dl * 2) == 0, "all code points to UTF-16");
+
+	std::vector<char> d8(u32.size() * 4);
+	sl = u32.size();
+	dl = d8.size();
+	Check(utf32toutf8(u32.data(), &sl, d8.data(), &dl) == 0 && sl == u32.size() &&
+		  dl == u8.size() && memcmp(d8.data(), u8.data(), dl) == 0, "all code points from UTF-32");
+
+	sl = u16.size();
+	dl = d8.size();
+	Check(utf16toutf8(u16.data(), &sl, d8.data(), &dl) == 0 && sl == u16.size() &&
+		  dl == u8.size() && memcmp(d8.data(), u8.data(), dl) == 0, "all code points from UTF-16");
+
+	utf8setsimd(true);
+}
+
+/// Every 1 to 3 bytes sequence and a 4 bytes subset, embedded in ASCII at
+/// varying offsets so they land anywhere across SIMD blocks
+static void CheckAllSequences()
+{
+	uint8_t buf[48];
+	int cnt = 0;
+
+	for (uint32_t x = 0; x < 0x1000000; x++)
+	{
+		int len = x < 0x100 ? 1 : x < 0x10000 ? 2 : 3;
+		int off = (x * 7) % 34;
+
+		memset(buf, 'a', sizeof(buf));
+		for (int k = 0; k < len; k++)
+		{
+			buf[off + k] = x >> (8 * (len - 1 - k));
+		}
+		CheckValidate(buf, sizeof(buf), "sequence");
+		// Truncated at the end
+		CheckValidate(buf, off + len, "sequence at end");
+		cnt++;
+	}
+
+	static const uint8_t s_Tail[] = { 0x41, 0x7f, 0x80, 0x8f, 0x90, 0x9f, 0xa0, 0xbf, 0xc0, 0xf4 };
+
+	for (uint32_t b0 = 0xf0; b0 <= 0xff; b0++)
+	{
+		for (uint32_t b1 = 0; b1 < 256; b1++)
+		{
+			for (uint8_t b2 : s_Tail)
+			{
+				for (uint8_t b3 : s_Tail)
+				{
+					int off = (b1 + b2) % 34;
+
+					memset(buf, 'a', sizeof(buf));
+					buf[off] = b0;
+					buf[off + 1] = b1;
+					buf[off + 2] = b2;
+					buf[off + 3] = b3;
+					CheckValidate(buf, sizeof(buf), "4 bytes sequence");
+					cnt++;
+				}
+			}
+		}
+	}
+	printf("  %d sequences\n", cnt);
+}
+
+static void CheckNamed()
+{
+	static const struct {
+		const char *pName;
+		const char *pStr;
+		int Res;
+		int Valid;
+	} s_Cases[] = {
+		{ "ASCII", "hello", 0, 5 },
+		{ "2 bytes", "\xc3\xa9t\xc3\xa9", 0, 5 },
+		{ "max 3 bytes", "\xef\xbf\xbf", 0, 3 },
+		{ "max code point", "\xf4\x8f\xbf\xbf", 0, 4 },
+		{ "noncharacter U+FFFE", "\xef\xbf\xbe", 0, 3 },
+		{ "overlong /", "a\xc0\xaf", -1, 1 },
+		{ "overlong 2 bytes C1", "\xc1\xbf", -1, 0 },
+		{ "overlong 3 bytes", "\xe0\x80\xaf", -1, 0 },
+		{ "overlong 4 bytes", "\xf0\x80\x80\xaf", -1, 0 },
+		{ "overlong 4 bytes U+FFFF", "\xf0\x8f\xbf\xbf", -1, 0 },
+		{ "high surrogate", "ab\xed\xa0\x80", -1, 2 },
+		{ "low surrogate", "\xed\xbf\xbf", -1, 0 },
+		{ "last before surrogates", "\xed\x9f\xbf", 0, 3 },
+		{ "above U+10FFFF", "\xf4\x90\x80\x80", -1, 0 },
+		{ "5 bytes form", "\xf8\x88\x80\x80\x80", -1, 0 },
+		{ "6 bytes form", "\xfc\x84\x80\x80\x80\x80", -1, 0 },
+		{ "FE", "\xfe", -1, 0 },
+		{ "FF", "x\xff", -1, 1 },
+		{ "lone continuation", "\x80", -1, 0 },
+		{ "missing continuation", "\xe2\x82" "a", -1, 0 },
+		{ "truncated 3 bytes", "ok\xe2\x82", 1, 2 },
+		{ "truncated 4 bytes", "\xf0\x9f\x98", 1, 0 },
+		{ "too many continuations", "\xc3\xa9\xa9", -1, 2 },
+	};
+
+	for (size_t i = 0; i < sizeof(s_Cases) / sizeof(s_Cases[0]); i++)
+	{
+		size_t v, len = strlen(s_Cases[i].pStr);
+		int r = utf8validate(s_Cases[i].pStr, len, &v);
+		Check(r == s_Cases[i].Res && (int)v == s_Cases[i].Valid, s_Cases[i].pName);
+
+		// Conversion stops at the same place
+		uint16_t d[16];
+		size_t sl = len, dl = 16;
+		r = utf8toutf16(s_Cases[i].pStr, &sl, d, &dl);
+		Check(r == s_Cases[i].Res && (int)sl == s_Cases[i].Valid, s_Cases[i].pName);
+	}
+
+	// UTF-16 & UTF-32 errors
+	uint16_t u16[] = { 'a', 0xdc00, 'b' };
+	char d[16];
+	size_t sl = 3, dl = 16;
+	Check(utf16toutf8(u16, &sl, d, &dl) == -1 && sl == 1 && dl == 1, "unpaired low surrogate");
+	u16[1] = 0xd800;
+	sl = 3;
+	dl = 16;
+	Check(utf16toutf8(u16, &sl, d, &dl) == -1 && sl == 1, "unpaired high surrogate");
+	sl = 2;
+	dl = 16;
+	Check(utf16toutf8(u16, &sl, d, &dl) == 1 && sl == 1, "high surrogate at end");
+	uint32_t u32[] = { 'a', 0x110000 };
+	sl = 2;
+	dl = 16;
+	Check(utf32toutf8(u32, &sl, d, &dl) == -1 && sl == 1, "UTF-32 above U+10FFFF");
+	u32[1] = 0xdfff;
+	sl = 2;
+	dl = 16;
+	Check(utf32toutf8(u32, &sl, d, &dl) == -1 && sl == 1, "UTF-32 surrogate");
+
+	// Destination limits
+	const char *emoji = "a\xf0\x9f\x98\x80";
+	uint16_t w[2];
+	sl = 5;
+	dl = 2;
+	Check(utf8toutf16(emoji, &sl, w, &dl) == 1 && sl == 1 && dl == 1, "no room for surrogate pair");
+	uint32_t e32 = 0x1f600;
+	sl = 1;
+	dl = 3;
+	Check(utf32toutf8(&e32, &sl, d, &dl) == 1 && sl == 0 && dl == 0, "no room for 4 bytes");
+	sl = 1;
+	dl = 4;
+	Check(utf32toutf8(&e32, &sl, d, &dl) == 0 && dl == 4 && memcmp(d, emoji + 1, 4) == 0, "exact fit");
+
+	// Legacy wide char API
+	wchar_t wc[8];
+	int isl = 5, idl = 8;
+	Check(utf8towcs(emoji, &isl, wc, &idl) == 0 && isl == 5 && idl == (sizeof(wchar_t) == 2 ? 3 : 2), "utf8towcs");
+	char back[16];
+	int wl = idl, bl = 16;
+	Check(wcstoutf8(wc, &wl, back, &bl) == 0 && bl == 5 && memcmp(back, emoji, 5) == 0, "wcstoutf8");
+	Check(utf8towcs_length("\xc3\xa9t\xc3\xa9\xe2", 6, 100) == 3, "utf8towcs_length");
+}
+
+/// Locale facet through the public codecvt interface
+class Utf8Facet : public std::codecvt_utf8 {
+public:
+	Utf8Facet() {}
+	~Utf8Facet() {}
+};
+
+static void CheckFacet()
+{
+	Utf8Facet f;
+	std::mbstate_t st = std::mbstate_t();
+	const char *src = "Gr\xc3\xbc\xc3\x9f" "e \xe4\xb8\x96\xe7\x95\x8c \xf0\x9f\x98\x80\xe2\x82";
+	size_t len = strlen(src);
+	wchar_t dst[32];
+	const char *fn;
+	wchar_t *tn;
+
+	std::codecvt_base::result r = f.in(st, src, src + len, fn, dst, dst + 32, tn);
+	Check(r == std::codecvt_base::partial && fn == src + len - 2, "facet in partial");
+
+	char out[64];
+	const wchar_t *wn;
+	char *on;
+	r = f.out(st, dst, tn, wn, out, out + 64, on);
+	Check(r == std::codecvt_base::ok && on - out == (int)len - 2 && memcmp(out, src, len - 2) == 0, "facet out");
+
+	Check(f.length(st, src, src + len, 4) == 6, "facet length");
+	Check(f.max_length() == 4, "facet max length");
+}
+
+static void CheckFuzz()
+{
+	static const char *s_Pieces[] = { "a", "Zz ", "\xc3\xa9", "\xd0\x96", "\xe4\xb8\x96", "\xef\xbf\xbd", "\xf0\x9f\x98\x80", "\xf4\x8f\xbf\xbf" };
+	std::vector<uint8_t> buf;
+
+	for (int iter = 0; iter < 20000; iter++)
+	{
+		buf.clear();
+		int n = rand() % 80;
+		for (int i = 0; i < n; i++)
+		{
+			const char *p = s_Pieces[rand() % 8];
+			buf.insert(buf.end(), p, p + strlen(p));
+		}
+		if (buf.size() > 0 && (iter & 1))
+		{
+			int k = rand() % 3;
+			for (int i = 0; i <= k; i++)
+			{
+				buf[rand() % buf.size()] = rand();
+			}
+		}
+		if (buf.size() > 0 && (iter % 3) == 0)
+		{
+			buf.resize(buf.size() - 1);
+		}
+		CheckValidate(buf.data(), buf.size(), "fuzz");
+
+		// Transcode and compare with validation result
+		size_t rv;
+		int rr = RefValidate(buf.data(), buf.size(), &rv);
+		for (int simd = 0; simd < 2; simd++)
+		{
+			utf8setsimd(simd);
+			std::vector<uint32_t> d32(buf.size() + 1);
+			size_t sl = buf.size(), dl = d32.size();
+			int r = utf8toutf32((const char*)buf.data(), &sl, d32.data(), &dl);
+			Check(r == rr && sl == rv, "fuzz utf8toutf32");
+
+			std::vector<char> b8(dl * 4 + 1);
+			size_t bl = b8.size(), dl2 = dl;
+			r = utf32toutf8(d32.data(), &dl2, b8.data(), &bl);
+			Check(r == 0 && bl == rv && memcmp(b8.data(), buf.data(), rv) == 0, "fuzz round trip");
+		}
+		utf8setsimd(true);
+	}
+}
+
+/// Reference UTF-16/32 to UTF-8, same return convention as utf16toutf8
+static int RefEncodeUnits(const uint32_t *pSrc, size_t Len, bool bUtf16, std::vector<uint8_t> &Out, size_t *pUsed)
+{
+	size_t i = 0;
+
+	Out.clear();
+	while (i < Len)
+	{
+		uint32_t c = pSrc[i];
+		size_t n = 1;
+
+		if (c >= 0xd800 && c < 0xe000)
+		{
+			if (bUtf16 == false || c >= 0xdc00)
+				break;
+			if (i + 1 >= Len)
+			{
+				*pUsed = i;
+				return 1;
+			}
+			if (pSrc[i + 1] < 0xdc00 || pSrc[i + 1] >= 0xe000)
+				break;
+			c = 0x10000 + ((c - 0xd800) << 10) + (pSrc[i + 1] - 0xdc00);
+			n = 2;
+		}
+		else if (c > 0x10ffff)
+			break;
+
+		uint8_t b[4];
+		int l = RefEncode(c, b);
+		Out.insert(Out.end(), b, b + l);
+		i += n;
+	}
+	*pUsed = i;
+
+	return i < Len ? -1 : 0;
+}
+
+static void CheckEncodeFuzz()
+{
+	static const uint32_t s_Units[] = { 'a', ' ', 0x7f, 0x80, 0xe9, 0x416, 0x7ff, 0x800, 0x4e16, 0xfffd, 0xffff,
+										0xd83d, 0xde00, 0xdbff, 0xdfff, 0x1f600, 0x10ffff, 0x110000, 0x80000000 };
+	std::vector<uint32_t> u;
+	std::vector<uint8_t> ref;
+
+	for (int iter = 0; iter < 20000; iter++)
+	{
+		bool b16 = iter & 1;
+		int n = rand() % 64;
+		int bad = rand() % 4;
+
+		u.clear();
+		for (int i = 0; i < n; i++)
+		{
+			uint32_t c = s_Units[rand() % (b16 ? 15 : 11)];
+
+			// Mostly well formed, pairs for UTF-16 supplementary planes
+			if (b16 && c >= 0x10000)
+			{
+				u.push_back(0xd800 + ((c - 0x10000) >> 10));
+				c = 0xdc00 + ((c - 0x10000) & 0x3ff);
+			}
+			u.push_back(c);
+		}
+		if (bad == 0 && n > 0)
+		{
+			u[rand() % u.size()] = s_Units[11 + rand() % 8] & (b16 ? 0xffff : 0xffffffff);
+		}
+
+		size_t used;
+		int rr = RefEncodeUnits(u.data(), u.size(), b16, ref, &used);
+
+		for (int simd = 0; simd < 2; simd++)
+		{
+			std::vector<char> out(u.size() * 4 + 1);
+			size_t sl = u.size(), dl = out.size();
+			int r;
+
+			utf8setsimd(simd);
+			if (b16)
+			{
+				std::vector<uint16_t> w(u.begin(), u.end());
+				r = utf16toutf8(w.data(), &sl, out.data(), &dl);
+			}
+			else
+			{
+				r = utf32toutf8(u.data(), &sl, out.data(), &dl);
+			}
+			Check(r == rr && sl == used && dl == ref.size() && memcmp(out.data(), ref.data(), dl) == 0,
+				  b16 ? "fuzz utf16toutf8" : "fuzz utf32toutf8");
+		}
+		utf8setsimd(true);
+	}
+}
+
+/// Previous code point at a time conversion, for comparison
+static int LegacyOctetCount(char c)
+{
+	char mask = (char)0xfc;
+	int retval = 6;
+
+	if ((c & 0x80) == 0)
+		return 1;
+
+	while ((c & mask) != mask && retval > 0)
+	{
+		retval--;
+		mask <<= 1;
+	}
+
+	return retval;
+}
+
+static int LegacyUtf8ToWcs(const char *pSrc, int *pSrcSize, wchar_t *pDest, int *pDestLen)
+{
+	int len = *pSrcSize;
+	const char *srcend = pSrc + *pSrcSize;
+	wchar_t *destend = pDest + *pDestLen;
+
+	*pSrcSize = 0;
+	*pDestLen = 0;
+	while (pSrc < srcend && pDest < destend)
+	{
+		int cnt = LegacyOctetCount(*pSrc);
+
+		if (cnt <= 0)
+			return -1;
+		if (cnt > len)
+			return 1;
+
+		if (cnt > 1)
+		{
+			char mask = (char)0x7f;
+
+			*pDest = (*pSrc & (mask >> cnt));
+			pSrc++;
+			++*pSrcSize;
+			for (int i = 1; i < cnt && pSrc != srcend; i++)
+			{
+				if ((*pSrc & 0xc0) != 0x80)
+					return 0;
+				*pDest <<= 6;
+				*pDest |= (*pSrc & 0x3f);
+				pSrc++;
+				++*pSrcSize;
+			}
+		}
+		else
+		{
+			*pDest = (*pSrc & 0x7f);
+			pSrc++;
+			++*pSrcSize;
+		}
+		pDest++;
+		++*pDestLen;
+		len -= cnt;
+	}
+
+	return 0;
+}
+
+static int LegacyWcsToUtf8(const wchar_t *pSrc, int *pSrcLen, char *pDest, int *pDestSize)
+{
+	const wchar_t *srcend = pSrc + *pSrcLen;
+	char *destend = pDest + *pDestSize;
+
+	*pSrcLen = 0;
+	*pDestSize = 0;
+	while (pSrc < srcend && pDest < destend)
+	{
+		wchar_t c = *pSrc;
+		int cnt = c < 0x80 ? 1 : c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+
+		if (cnt > 1)
+		{
+			if ((pDest + cnt) >= destend)
+				return 1;
+
+			char *p = pDest + cnt - 1;
+			for (int i = 1; i < cnt; i++)
+			{
+				*p-- = 0x80 | (c & 0x3f);
+				c >>= 6;
+			}
+			char mask = 0xfc << (6 - cnt);
+			*p = mask | (c & ~mask);
+			pDest += cnt;
+			(*pDestSize) += cnt;
+		}
+		else
+		{
+			*pDest++ = (char)c;
+			++*pDestSize;
+		}
+		pSrc++;
+		++*pSrcLen;
+	}
+
+	return 0;
+}
+
+typedef struct {
+	const char *pName;
+	const char *pWords[12];
+	int AsciiPct;		// Percent of ASCII words mixed in
+} CORPUS_DEF;
+
+static const CORPUS_DEF s_Corpora[] = {
+	{ "English log", { "sensor", "timeout", "0x3f2a", "ok", "retry", "BLE", "connected", "[info]", "12.5", "temp=", "done", "\n" }, 100 },
+	{ "French names", { "\xc3\xa9t\xc3\xa9", "gar\xc3\xa7on", "na\xc3\xafve", "d\xc3\xa9j\xc3\xa0", "ma\xc3\xaetre", "No\xc3\xabl", "\xc5\x93uvre", "fa\xc3\xa7" "ade", "c\xc5\x93ur", "h\xc3\xb4tel", "\xc3\xa0", "\xc3\xa9l\xc3\xa8ve" }, 60 },
+	{ "Cyrillic", { "\xd0\xbf\xd1\x80\xd0\xb8\xd0\xb2\xd0\xb5\xd1\x82", "\xd0\xbc\xd0\xb8\xd1\x80", "\xd0\xb4\xd0\xb0\xd1\x82\xd1\x87\xd0\xb8\xd0\xba", "\xd0\xbe\xd1\x88\xd0\xb8\xd0\xb1\xd0\xba\xd0\xb0", "\xd1\x81\xd0\xb5\xd1\x82\xd1\x8c", "\xd1\x82\xd0\xb5\xd0\xbc\xd0\xbf", "\xd0\xb4\xd0\xb0", "\xd0\xbd\xd0\xb5\xd1\x82", "\xd1\x83\xd0\xb7\xd0\xb5\xd0\xbb", "\xd0\xb1\xd0\xb0\xd1\x82", "\xd0\xba\xd0\xbe\xd0\xb4", "\xd0\xb6\xd1\x83\xd1\x80" }, 15 },
+	{ "CJK", { "\xe4\xbc\xa0\xe6\x84\x9f\xe5\x99\xa8", "\xe8\xbf\x9e\xe6\x8e\xa5", "\xe8\xb6\x85\xe6\x97\xb6", "\xe6\xb8\xa9\xe5\xba\xa6", "\xe8\xae\xbe\xe5\xa4\x87", "\xe6\x95\xb0\xe6\x8d\xae", "\xe3\x82\xbb\xe3\x83\xb3\xe3\x82\xb5", "\xe6\x8e\xa5\xe7\xb6\x9a", "\xec\x84\xbc\xec\x84\x9c", "\xe9\x94\x99\xe8\xaf\xaf", "\xe7\x94\xb5\xe6\xb1\xa0", "\xe3\x80\x82" }, 10 },
+	{ "Emoji chat", { "\xf0\x9f\x98\x80", "\xf0\x9f\x91\x8d", "ok", "\xf0\x9f\x94\x8b", "lol", "\xe2\x9d\xa4\xef\xb8\x8f", "\xf0\x9f\x9a\x80", "yes", "\xf0\x9f\x8e\x89", "no", "\xf0\x9f\x93\xb6", "!" }, 40 },
+};
+
+static std::string MakeCorpus(const CORPUS_DEF &Def)
+{
+	static const char *s_Ascii[] = { "id", "0042", "value", "dev", "-", "ERR", "rx", "tx" };
+	std::string s;
+
+	while (s.size() < CORPUS_SIZE)
+	{
+		if (rand() % 100 < Def.AsciiPct && Def.AsciiPct < 100)
+		{
+			s += s_Ascii[rand() % 8];
+		}
+		else
+		{
+			s += Def.pWords[rand() % 12];
+		}
+		s += ' ';
+	}
+
+	return s;
+}
+
+template <typename F>
+static double MBps(size_t Bytes, F Fn)
+{
+	double t = usNow();
+	int cnt = 0;
+
+	do {
+		Fn();
+		cnt++;
+	} while (usNow() - t < BENCH_TIME_US);
+
+	return (double)Bytes * cnt / (usNow() - t);
+}
+
+static void Bench()
+{
+	printf("\n%-14s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "MB/s", "valid", "valid", "legacy", "to32", "to32", "to16",
+		   "legacy", "from32", "from16");
+	printf("%-14s %8s %8s %8s %8s %8s %8s %8s %8s %8s\n", "", "scalar", "simd", "towcs", "scalar", "simd", "simd",
+		   "wcsto", "simd", "simd");
+
+	for (size_t i = 0; i < sizeof(s_Corpora) / sizeof(s_Corpora[0]); i++)
+	{
+		std::string c = MakeCorpus(s_Corpora[i]);
+		size_t len = c.size();
+		std::vector<uint32_t> d32(len);
+		std::vector<uint16_t> d16(len);
+		std::vector<wchar_t> dw(len);
+		std::vector<char> d8(len * 4);
+		size_t n32 = len, n16 = len, sl = len;
+		bool ok = true;
+
+		utf8toutf32(c.data(), &sl, d32.data(), &n32);
+		sl = len;
+		utf8toutf16(c.data(), &sl, d16.data(), &n16);
+
+		utf8setsimd(false);
+		double vs = MBps(len, [&]() { size_t v; ok &= utf8validate(c.data(), len, &v) == 0; });
+		double ds = MBps(len, [&]() { size_t s = len, d = len; ok &= utf8toutf32(c.data(), &s, d32.data(), &d) == 0; });
+		utf8setsimd(true);
+		double vv = MBps(len, [&]() { size_t v; ok &= utf8validate(c.data(), len, &v) == 0; });
+		double dv = MBps(len, [&]() { size_t s = len, d = len; ok &= utf8toutf32(c.data(), &s, d32.data(), &d) == 0; });
+		double d16v = MBps(len, [&]() { size_t s = len, d = len; ok &= utf8toutf16(c.data(), &s, d16.data(), &d) == 0; });
+		double lg = MBps(len, [&]() { int s = len, d = len; LegacyUtf8ToWcs(c.data(), &s, dw.data(), &d); });
+		double ev = MBps(len, [&]() { size_t s = n32, d = len * 4; ok &= utf32toutf8(d32.data(), &s, d8.data(), &d) == 0; });
+		double e16 = MBps(len, [&]() { size_t s = n16, d = len * 4; ok &= utf16toutf8(d16.data(), &s, d8.data(), &d) == 0; });
+
+		int wl = n32, bl = len * 4;
+		std::vector<wchar_t> w(d32.begin(), d32.begin() + n32);
+		double le = MBps(len, [&]() { int s = wl, d = bl; LegacyWcsToUtf8(w.data(), &s, d8.data(), &d); });
+
+		Check(ok, s_Corpora[i].pName);
+
+		printf("%-14s %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f %8.0f\n", s_Corpora[i].pName, vs, vv, lg, ds, dv, d16v,
+			   le, ev, e16);
+	}
+	printf("MB/s of UTF-8 text, %d KB corpora\n", CORPUS_SIZE >> 10);
+}
+
+int main()
+{
+	srand(1);
+
+	printf("UTF-8 conversion, SIMD %s\n\n", utf8setsimd(true) ? "available" : "not available");
+
+	printf("All code points\n");
+	CheckAllCodePoints(true);
+	CheckAllCodePoints(false);
+	printf("All 1 to 3 bytes sequences & 4 bytes subset\n");
+	CheckAllSequences();
+	printf("Named cases\n");
+	CheckNamed();
+	printf("codecvt facet\n");
+	CheckFacet();
+	printf("Fuzz\n");
+	CheckFuzz();
+	CheckEncodeFuzz();
+	Bench();
+
+	printf("\n%s\n", s_FailCnt == 0 ? "PASS" : "FAIL");
+
+	return s_FailCnt == 0 ? 0 : 1;
+}
@@ -0,0 +1,41 @@
+# Common rules for Linux host examples, included by each example Makefile
+#
+# Example Makefile sets :
+#	TARGET		: executable name
+#	SRCS		: optional extra C sources, main.cpp is always built
+#	CPPFLAGS	: optional extra include paths
+#
+# Library ../../lib/Build/libIOsonata_Linux.a is brought up to date first.
+# Output : Build/$(TARGET)
+
+IOSONATA_ROOT	= ../../..
+IOSONATA_LIB_DIR= $(IOSONATA_ROOT)/Linux/lib
+IOSONATA_LIB	= $(IOSONATA_LIB_DIR)/Build/libIOsonata_Linux.a
+BUILD_DIR		= Build
+
+CPPFLAGS		+= -I$(IOSONATA_ROOT)/include -I$(IOSONATA_LIB_DIR)/include
+CFLAGS			+= -std=gnu11 -O2 -Wall
+CXXFLAGS		+= -std=gnu++14 -O2 -Wall
+LDLIBS			+= -lpthread -lm
+
+OBJS			= $(addprefix $(BUILD_DIR)/obj/, $(notdir $(SRCS:.c=.o)))
+
+vpath %.c $(sort $(dir $(SRCS)))
+
+.PHONY: all clean FORCE
+
+all: $(BUILD_DIR)/$(TARGET)
+
+$(BUILD_DIR)/$(TARGET): main.cpp $(OBJS) $(IOSONATA_LIB)
+	@mkdir -p $(dir $@)
+	$(CXX) $(CPPFLAGS) $(CXXFLAGS) main.cpp $(OBJS) $(IOSONATA_LIB) $(LDFLAGS) $(LDLIBS) -o $@
+
+$(BUILD_DIR)/obj/%.o: %.c
+	@mkdir -p $(dir $@)
+	$(CC) $(CPPFLAGS) $(CFLAGS) -c $< -o $@
+
+$(IOSONATA_LIB): FORCE
+	$(MAKE) -C $(IOSONATA_LIB_DIR)
+
+clean:
+	rm -rf $(BUILD_DIR)
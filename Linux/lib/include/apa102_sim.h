@@ -0,0 +1,115 @@
+/**-------------------------------------------------------------------------
+@file	apa102_sim.h
+
+@brief	Simulated APA102 LED strip on SPI for Linux
+
+Device interface sink that decodes the SPI byte stream the way a chain of
+APA102 LEDs would. A transfer must begin with a 32 zero bits start frame. LED i
+takes the i-th 32 bits frame that follows if its 3 marker bits are set. Each
+LED delays the data it forwards by half a clock, so LED i only latches when at
+least i / 2 more clocks follow its frame. The first frame without a marker ends
+the update and LEDs further down keep their state.
+
+Wire time is accounted at the configured SPI clock rate.
+
+Usage :
+
+	Apa102Sim strip;
+
+	strip.Init(300, 8000000);
+	Apa102FrameShow(&frame, strip);
+	uint32_t led = strip.Led(10);		// 0xHHC0C1C2, header + wire colors
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __APA102_SIM_H__
+#define __APA102_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "device_intrf.h"
+
+/** @addtogroup MiscDev
+  * @{
+  */
+
+/// @brief	Simulated APA102 LED strip
+class Apa102Sim : public DeviceIntrf {
+public:
+	/**
+	 * @brief	Initialize strip, all LEDs off
+	 *
+	 * @param	NbLed	: Number of LEDs
+	 * @param	Rate	: SPI clock in Hz
+	 */
+	bool Init(int NbLed, int Rate);
+
+	operator DEVINTRF * const () { return &vDevIntrf; }
+	virtual int Rate(int DataRate) { vRate = DataRate; return vRate; }
+	virtual int Rate(void) { return vRate; }
+	virtual bool StartRx(int DevAddr) { return false; }
+	virtual int RxData(uint8_t *pBuff, int BuffLen) { return 0; }
+	virtual void StopRx(void) {}
+	virtual bool StartTx(int DevAddr) { return DeviceIntrfStartTx(&vDevIntrf, DevAddr); }
+	virtual int TxData(uint8_t *pData, int DataLen) { return DeviceIntrfTxData(&vDevIntrf, pData, DataLen); }
+	virtual void StopTx(void) { DeviceIntrfStopTx(&vDevIntrf); }
+
+	/// LED state, header byte in bits 31-24 followed by the 3 color bytes in wire order
+	uint32_t Led(int Idx) { return vLed[Idx]; }
+	int NbLed() { return (int)vLed.size(); }
+
+	uint64_t usWireTime() { return vWireNs / 1000; }	//!< Total wire time
+	uint32_t XferCount() { return vXferCnt; }			//!< Number of transfers
+	uint64_t ByteCount() { return vByteCnt; }			//!< Total bytes clocked
+	int LastUpdated() { return vLastUpdated; }			//!< LEDs latched by last transfer
+	uint32_t StartErrCount() { return vStartErrCnt; }	//!< Transfers without valid start frame
+	uint32_t LatchErrCount() { return vLatchErrCnt; }	//!< LED frames lost to a short end frame
+
+private:
+	static bool SimStartTx(DEVINTRF * const pDevIntrf, int DevAddr);
+	static int SimTxData(DEVINTRF * const pDevIntrf, uint8_t *pData, int DataLen);
+	static void SimStopTx(DEVINTRF * const pDevIntrf);
+	void Decode();
+
+	DEVINTRF vDevIntrf;
+	int vRate;
+	std::vector<uint32_t> vLed;
+	std::vector<uint8_t> vXfer;			// Bytes of transfer in progress
+	uint64_t vWireNs;
+	uint32_t vXferCnt;
+	uint64_t vByteCnt;
+	int vLastUpdated;
+	uint32_t vStartErrCnt;
+	uint32_t vLatchErrCnt;
+};
+
+/** @} End of group MiscDev */
+
+#endif // __APA102_SIM_H__
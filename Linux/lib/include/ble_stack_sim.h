@@ -0,0 +1,132 @@
+/**-------------------------------------------------------------------------
+@file	ble_stack_sim.h
+
+@brief	Simulated BLE stack notification path for Linux
+
+Models the part of a BLE peripheral stack that limits notification throughput :
+a notification queue of fixed depth filled by the application and drained at
+connection events, each able to carry a limited number of packets. Payload is
+limited by the ATT MTU. Time only moves when the application calls ConnEvent.
+
+Its send function matches the BLENTFPUMP send callback so the notification
+pump can be run and benchmarked on host.
+
+Usage :
+
+	BLESTACKSIM_CFG cfg = { 7500, 6, 4, 247 };
+	BleStackSim stack;
+
+	stack.Init(cfg);
+	pumpcfg.SendCB = BleStackSim::SendCB;
+	pumpcfg.pCtx = &stack;
+	...
+	int n = stack.ConnEvent();
+	BleNtfPumpTxComplete(&pump, n);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLE_STACK_SIM_H__
+#define __BLE_STACK_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+
+#include "bluetooth/ble_ntfpump.h"
+
+/** @addtogroup Bluetooth
+  * @{
+  */
+
+#pragma pack(push, 4)
+
+/// Simulated stack configuration
+typedef struct __Ble_Stack_Sim_Config {
+	uint32_t ConnIntervalUs;	//!< Connection interval in usec
+	int PktPerEvt;				//!< Max packets transmitted per connection event
+	int QueueDepth;				//!< Stack notification queue depth
+	uint16_t AttMtu;			//!< Negotiated ATT MTU
+} BLESTACKSIM_CFG;
+
+#pragma pack(pop)
+
+/// @brief	Simulated BLE stack notification queue
+class BleStackSim {
+public:
+	bool Init(const BLESTACKSIM_CFG &Cfg);
+
+	/**
+	 * @brief	Queue one notification, same semantic as sd_ble_gatts_hvx
+	 *
+	 * @param	pData	: Pointer to payload
+	 * @param	Len		: Payload length, must not exceed ATT MTU - 3
+	 *
+	 * @return	BLENTFPUMP_SENDRES_BUSY when queue is full
+	 */
+	BLENTFPUMP_SENDRES Notify(uint8_t *pData, uint16_t Len);
+
+	/**
+	 * @brief	Run one connection event
+	 *
+	 * Time advances by one connection interval. Queued packets are transmitted
+	 * up to the per event limit and their payload appended to the received data.
+	 *
+	 * @return	Number of packets transmitted. This is the Tx complete count
+	 */
+	int ConnEvent();
+
+	/// BLENTFPUMP send callback, pCtx is the BleStackSim instance
+	static BLENTFPUMP_SENDRES SendCB(void *pCtx, uint8_t *pData, uint16_t Len) {
+		return ((BleStackSim*)pCtx)->Notify(pData, Len);
+	}
+
+	uint64_t usTime() { return vusTime; }
+	uint16_t AttMtu() { return vCfg.AttMtu; }
+	void AttMtu(uint16_t Mtu) { vCfg.AttMtu = Mtu; }	//!< Change MTU, ex. on reconnection
+	uint32_t ConnIntervalUs() { return vCfg.ConnIntervalUs; }
+	const std::vector<uint8_t> &RxData() { return vRxData; }
+	uint32_t EvtCount() { return vEvtCnt; }
+	uint32_t ActiveEvtCount() { return vActiveEvtCnt; }	//!< Events carrying at least one packet
+	uint32_t PktCount() { return vPktCnt; }
+	uint32_t RejectCount() { return vRejectCnt; }
+
+private:
+	BLESTACKSIM_CFG vCfg;
+	uint64_t vusTime;
+	std::deque<std::vector<uint8_t> > vQueue;
+	std::vector<uint8_t> vRxData;
+	uint32_t vEvtCnt;
+	uint32_t vActiveEvtCnt;
+	uint32_t vPktCnt;
+	uint32_t vRejectCnt;
+};
+
+/** @} End of group Bluetooth */
+
+#endif // __BLE_STACK_SIM_H__
@@ -0,0 +1,178 @@
+/**-------------------------------------------------------------------------
+@file	diskio_flashimg.h
+
+@brief	Flash image disk I/O for Linux
+
+Flash disk emulation backed by a memory mapped flash image file.  It provides the
+same memory mapped read view as FlashDiskIO on Quad SPI with execute in place
+support.  This allows code consuming read only assets directly from flash to run
+unmodified on host.
+
+Usage :
+
+FlashImgDiskIO g_FlashImg;
+
+g_FlashImg.Init("flash.bin", 16 * 1024 / 8, 4);	// 16 Mbits image, 4KB erase sector
+
+const uint8_t *p = g_FlashImg.MemMap();
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __DISKIO_FLASHIMG_H__
+#define __DISKIO_FLASHIMG_H__
+
+#include <stdint.h>
+
+#include "diskio.h"
+
+/** @addtogroup Storage
+  * @{
+  */
+
+/// @brief	Flash image disk class
+///
+/// Emulates a NOR flash on host using a memory mapped image file.
+/// Erased state is 0xFF.
+class FlashImgDiskIO : public DiskIO {
+public:
+	FlashImgDiskIO();
+	virtual ~FlashImgDiskIO();
+
+	/**
+	 * @brief	Initialize flash image disk.
+	 *
+	 * The image file is created and filled with erased state (0xFF) if it does not
+	 * exist or is smaller than requested size.
+	 *
+	 * @param	pPath		: Path of flash image file
+	 * @param	TotalSize	: Total flash size in KBytes
+	 * @param	SectSize	: Sector erase size in KBytes
+	 * @param	bReadOnly	: true - map image read only
+	 * @param	pCacheBlk	: Pointer to static cache block (optional)
+	 * @param	NbCacheBlk	: Size of cache block (Number of cache sector)
+	 *
+	 * @return
+	 * 			- true 	: Success
+	 * 			- false	: Failed
+	 */
+	bool Init(const char *pPath, uint32_t TotalSize, uint16_t SectSize, bool bReadOnly = false,
+			  DISKIO_CACHE_DESC * const pCacheBlk = NULL, int NbCacheBlk = 0);
+
+	/**
+	 * @brief	Unmap and close flash image
+	 */
+	void Close();
+
+	/**
+	 * @brief	Get total disk size.
+	 *
+	 * @return	Total size in KBytes
+	 */
+	virtual uint32_t GetSize(void) { return vTotalSize; }
+
+	/**
+	 * @brief	Device specific minimum erasable block size in bytes.
+	 *
+	 * @return	Block size in bytes
+	 */
+	virtual uint32_t GetMinEraseSize() { return vSectSize * 1024; }
+
+	/**
+	 * @brief	Read one sector from flash image.
+	 *
+	 * @param	SectNo	: Sector number to read
+	 * @param	pBuff	: Pointer to buffer to receive sector data. Must be at least
+	 * 					  1 sector size
+	 *
+	 * @return
+	 * 			- true	: Success
+	 * 			- false	: Failed
+	 */
+	virtual bool SectRead(uint32_t SectNo, uint8_t *pBuff);
+
+	/**
+	 * @brief	Write one sector to flash image
+	 *
+	 * @param	SectNo	: Sector number to write
+	 * @param	pData	: Pointer to sector data to write. Must be at least
+	 * 					  1 sector size
+	 *
+	 * @return
+	 * 			- true	: Success
+	 * 			- false	: Failed
+	 */
+	virtual bool SectWrite(uint32_t SectNo, uint8_t *pData);
+
+	/**
+	 * @brief	Erase whole flash image
+	 */
+	virtual void Erase();
+
+	/**
+	 * @brief	Erase flash sectors
+	 *
+	 * @param	SectNo	: Starting erase sector number
+	 * @param	NbSect	: Number of consecutive sectors to erase
+	 */
+	virtual void EraseSector(uint32_t SectNo, int NbSect);
+
+	/**
+	 * @brief	Get direct read access to flash content
+	 *
+	 * Dirty sectors of the DiskIO write back cache are written to the image first
+	 * so that the view shows data written through DiskIO::Write.  Get the view
+	 * again after further writes.
+	 *
+	 * @return	Pointer to start of flash image or NULL if not initialized
+	 */
+	const uint8_t *MemMap();
+
+	/**
+	 * @brief	Get direct read access to a range of flash content
+	 *
+	 * Same as MemMap() but only the cache sectors covering the range are written back.
+	 *
+	 * @param	Offset	: Byte offset in flash
+	 * @param	Len		: Number of bytes to be accessed
+	 *
+	 * @return	Pointer to flash content at Offset or NULL if out of range
+	 */
+	const uint8_t *MemMap(uint64_t Offset, uint32_t Len);
+
+private:
+	uint32_t vTotalSize;	//!< Total flash size in KBytes
+	uint16_t vSectSize;		//!< Erase sector size in KBytes
+	bool	vbReadOnly;		//!< Image mapped read only
+	int		vFd;			//!< Image file descriptor
+	uint8_t	*vpMem;			//!< Mapped image memory
+};
+
+/** @} End of group Storage */
+
+#endif // __DISKIO_FLASHIMG_H__
@@ -0,0 +1,128 @@
+/**-------------------------------------------------------------------------
+@file	dlog_decoder.h
+
+@brief	Host decoder for deferred log binary streams
+
+Rebuilds the text of DLOG_MODE_BIN streams.  Format strings are read from the
+dlog_fmt section of the target ELF image and %s arguments pointing into
+the image are resolved from its loaded sections.  The sync record gives the
+run time address of the format section, any load bias is removed.
+
+Decoding is streaming, data can be fed in chunks of any size.  On a corrupt
+record the decoder drops sync and searches for the next sync record.
+
+Usage :
+
+	DLogDecoder dec;
+	std::string txt;
+
+	dec.LoadElf("firmware.elf");
+	while ((n = read(fd, buf, sizeof(buf))) > 0)
+	{
+		dec.Decode(buf, n, txt);
+	}
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __DLOG_DECODER_H__
+#define __DLOG_DECODER_H__
+
+#include <stdint.h>
+#include <vector>
+#include <string>
+
+#include "dlog.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/// @brief	Deferred log binary stream decoder
+class DLogDecoder {
+public:
+	DLogDecoder();
+
+	/**
+	 * @brief	Load format strings & constant data from target ELF image.
+	 *
+	 * 32 & 64 bits little endian images are supported.
+	 *
+	 * @param	pFileName	: ELF file path
+	 *
+	 * @return	true - image contains a dlog_fmt section
+	 */
+	bool LoadElf(const char *pFileName);
+
+	/**
+	 * @brief	Decode stream data.
+	 *
+	 * @param	pData	: Stream data
+	 * @param	Len		: Data length
+	 * @param	Out		: Decoded text is appended
+	 *
+	 * @return	Number of messages decoded
+	 */
+	int Decode(const uint8_t *pData, int Len, std::string &Out);
+
+	/// Reset stream state, image is kept
+	void Reset();
+
+	uint32_t MsgCount() { return vMsgCnt; }
+	uint32_t DropCount() { return vDropCnt; }		//!< Messages dropped on target
+	uint32_t ErrorCount() { return vErrCnt; }		//!< Corrupt records & unknown formats
+	bool IsSynced() { return vbSync; }
+
+private:
+	typedef struct {
+		std::string Name;
+		uint64_t Addr;
+		std::vector<uint8_t> Data;
+	} SECT;
+
+	static const char *StrCB(void *pCtx, DLOG_ARG Addr);
+	const char *ImageStr(uint64_t Addr);
+	uint64_t Word(size_t Off);
+	bool FindSync();
+	void Message(const uint64_t *pRec, int NbArg, std::string &Out);
+
+	std::vector<SECT> vSect;
+	int vFmtSect;				//!< Index of dlog_fmt section, -1 none
+	std::vector<uint8_t> vBuf;	//!< Undecoded stream data
+	bool vbSync;
+	int vWordSize;				//!< Target word size from sync
+	uint64_t vBias;				//!< Target run time address - image address
+	bool vbTimeStamp;
+	uint32_t vMsgCnt;
+	uint32_t vDropCnt;
+	uint32_t vErrCnt;
+};
+
+/** @} End of group Utilities */
+
+#endif // __DLOG_DECODER_H__
@@ -0,0 +1,157 @@
+/**-------------------------------------------------------------------------
+@file	esb_radio_sim.h
+
+@brief	Simulated Enhanced ShockBurst radio pair for Linux
+
+Models a PTX/PRX pair the way the Nordic ESB driver behaves : the PTX
+transmits the head of its TX FIFO and retries up to NbRetry times until it
+gets an ACK. The PRX answers with the head of its own TX FIFO as ACK
+payload. An ACK payload is removed from the PRX FIFO when the next new packet
+arrives, the driver assumes it was delivered at that point. The PRX drops
+retransmitted packets by PID. Each packet and each ACK is lost at the
+configured rate. When retries are exhausted, the PTX packet is popped and
+reported failed.
+
+Time is in usec and only moves in Run and Idle.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __ESB_RADIO_SIM_H__
+#define __ESB_RADIO_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+
+/** @addtogroup device_intrf
+  * @{
+  */
+
+#define ESBRADIOSIM_NODE_PTX		0	//!< Primary transmitter
+#define ESBRADIOSIM_NODE_PRX		1	//!< Primary receiver
+
+#define ESBRADIOSIM_PAYLOAD_MAX		252
+
+/**
+ * @brief	Transmit done callback.
+ *
+ * The packet is already removed from the FIFO.
+ *
+ * @param	pCtx	: User context pointer
+ * @param	bSent	: true - packet acknowledged, false - retries exhausted
+ */
+typedef void (*ESBRADIOSIM_TXCB)(void *pCtx, bool bSent);
+
+/**
+ * @brief	Packet received callback.
+ *
+ * @param	pCtx	: User context pointer
+ * @param	pData	: Pointer to payload
+ * @param	Len		: Payload length in bytes
+ */
+typedef void (*ESBRADIOSIM_RXCB)(void *pCtx, const uint8_t *pData, int Len);
+
+#pragma pack(push, 4)
+
+/// Simulated radio configuration
+typedef struct __Esb_Radio_Sim_Config {
+	double LossRate;			//!< Packet & ACK loss probability 0..1
+	int NbRetry;				//!< PTX retransmit count
+	uint32_t RetrDelayUs;		//!< PTX retransmit delay, start to start
+	int TxFifoSize;				//!< TX FIFO depth, both nodes
+	uint32_t Seed;				//!< Random seed
+} ESBRADIOSIM_CFG;
+
+#pragma pack(pop)
+
+/// @brief	Simulated ESB radio pair
+class EsbRadioSim {
+public:
+	bool Init(const ESBRADIOSIM_CFG &Cfg);
+
+	void SetCallback(int Node, ESBRADIOSIM_TXCB TxCB, ESBRADIOSIM_RXCB RxCB, void *pCtx);
+
+	/**
+	 * @brief	Queue one packet, same semantic as nrf_esb_write_payload
+	 *
+	 * On the PRX, the packet is an ACK payload.
+	 *
+	 * @return	false - FIFO full or invalid length
+	 */
+	bool Write(int Node, const uint8_t *pData, int Len);
+
+	/// Remove all queued packets, same as nrf_esb_flush_tx
+	void Flush(int Node);
+
+	int TxFifoCount(int Node) { return (int)vNode[Node].TxFifo.size(); }
+
+	/**
+	 * @brief	PTX transmits its head packet, with retries
+	 *
+	 * Callbacks are called as the events happen.
+	 *
+	 * @return	false - PTX FIFO empty, nothing done
+	 */
+	bool Run();
+
+	/// Let time pass with the radio idle
+	void Idle(uint32_t Us) { vusTime += Us; }
+
+	/// Air time of a packet including ramp up, 2 Mbps
+	static uint32_t PktTimeUs(int Len) { return 130 + 4 * (Len + 10); }
+
+	uint64_t usTime() { return vusTime; }
+	uint32_t AttemptCount() { return vAttemptCnt; }
+	uint32_t FailCount() { return vFailCnt; }
+
+private:
+	typedef struct {
+		std::deque<std::vector<uint8_t> > TxFifo;
+		ESBRADIOSIM_TXCB TxCB;
+		ESBRADIOSIM_RXCB RxCB;
+		void *pCtx;
+	} NODE;
+
+	bool Lost();
+
+	ESBRADIOSIM_CFG vCfg;
+	NODE vNode[2];
+	uint64_t vusTime;
+	uint32_t vRand;
+	uint8_t vPid;				//!< PTX packet id
+	int vPrxLastPid;			//!< Last PID received by PRX, -1 none
+	uint16_t vPrxLastCrc;		//!< Checksum of last packet received by PRX
+	bool vbAckAttached;			//!< PRX FIFO head was sent as ACK payload
+	uint32_t vAttemptCnt;
+	uint32_t vFailCnt;
+};
+
+/** @} end group device_intrf */
+
+#endif // __ESB_RADIO_SIM_H__
@@ -0,0 +1,75 @@
+/**-------------------------------------------------------------------------
+@file	idelay.h
+
+@brief	Delay functions for Linux host.
+
+Same interface as the MCU delay loop functions, implemented with nanosleep so
+that generic driver code can run on host.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __IDELAY_H__
+#define __IDELAY_H__
+
+#include <stdint.h>
+#include <time.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/**
+ * @brief	Nanosecond delay.
+ *
+ * @param	cnt : nanosecond count
+ */
+static inline void nsDelay(uint32_t cnt) {
+	struct timespec t = { (time_t)(cnt / 1000000000UL), (long)(cnt % 1000000000UL) };
+
+	while (nanosleep(&t, &t) != 0);
+}
+
+/**
+ * @brief	Microsecond delay.
+ *
+ * @param	cnt : microsecond delay count
+ */
+static inline void usDelay(uint32_t cnt) {
+	struct timespec t = { (time_t)(cnt / 1000000UL), (long)(cnt % 1000000UL) * 1000L };
+
+	while (nanosleep(&t, &t) != 0);
+}
+
+static inline void msDelay(uint32_t ms) {
+	usDelay(ms * 1000UL);
+}
+
+/** @} End of group Utilities */
+
+#endif	// __IDELAY_H__
@@ -0,0 +1,59 @@
+/**-------------------------------------------------------------------------
+@file	iopinctrl.h
+
+@brief	I/O pin control for Linux host.
+
+There is no GPIO on host.  These no-op implementations allow generic driver code
+using optional pins (chip select, write protect, ...) to be built and run
+unchanged against simulated devices.  Pin reads return 0.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __IOPINCTRL_H__
+#define __IOPINCTRL_H__
+
+#include <stdint.h>
+
+#include "coredev/iopincfg.h"
+
+/** @addtogroup IOPin
+  * @{
+  */
+
+static inline void IOPinSetDir(int PortNo, int PinNo, IOPINDIR Dir) {}
+static inline int IOPinRead(int PortNo, int PinNo) { return 0; }
+static inline void IOPinSet(int PortNo, int PinNo) {}
+static inline void IOPinClear(int PortNo, int PinNo) {}
+static inline void IOPinToggle(int PortNo, int PinNo) {}
+static inline uint32_t IOPinReadPort(int PortNo) { return 0; }
+static inline void IOPinWritePort(int PortNo, uint32_t Data) {}
+
+/** @} End of group IOPin */
+
+#endif	// __IOPINCTRL_H__
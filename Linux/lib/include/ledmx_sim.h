@@ -0,0 +1,110 @@
+/**-------------------------------------------------------------------------
+@file	ledmx_sim.h
+
+@brief	Simulated HT1632 LED matrix panels for Linux
+
+Implements the LED matrix platform I/O functions (LedMxIOInit, LedMxStartTx,
+LedMxTxData, LedMxStopTx) on host. Bits clocked while a panel is selected are
+decoded as HT1632 commands (ID 100) or successive RAM writes (ID 101, 7 bits
+nibble address, 4 bits per address) into a 64 nibbles RAM per panel. Bits and
+chip select transactions are counted so that bus traffic per frame can be
+measured.
+
+Usage :
+
+	LedMxSim sim;
+	LEDMXCFG cfg = { &sim, 4, { 0, 1, 2, 3 }, };
+
+	LedMxInit(&dev, &cfg);
+	sim.ResetStats();
+	LedMxPrintLeft(&dev, "Hello");
+	printf("%u bits\n", sim.TxBits());
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __LEDMX_SIM_H__
+#define __LEDMX_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "miscdev/ledmx.h"
+
+/** @addtogroup MiscDev
+  * @{
+  */
+
+#define LEDMXSIM_RAM_SIZE		64		//!< Nibble addresses per panel, 32 columns x 8 rows
+
+/// @brief	Simulated HT1632 panel chain
+class LedMxSim {
+public:
+	LedMxSim() { Reset(); }
+
+	/// Clear all panel RAM & counters
+	void Reset();
+	void ResetStats() { vTxBits = 0; vTxCnt = 0; }
+
+	/// Column content as sent by LedMxTxData, 8 bits MSB first
+	uint8_t Column(int PanelAddr, int Col) {
+		return (vPanel[PanelAddr].Ram[Col << 1] << 4) | vPanel[PanelAddr].Ram[(Col << 1) + 1];
+	}
+	bool LedOn(int PanelAddr) { return vPanel[PanelAddr].bLedOn; }
+	uint32_t CmdCount(int PanelAddr) { return vPanel[PanelAddr].CmdCnt; }
+
+	uint64_t TxBits() { return vTxBits; }		//!< Bits clocked since ResetStats
+	uint32_t TxCount() { return vTxCnt; }		//!< Chip select transactions since ResetStats
+	uint32_t ErrCount() { return vErrCnt; }		//!< Malformed transactions
+
+	// Platform I/O
+	void StartTx(int PanelAddr);
+	void TxData(uint32_t Data, int NbBits);
+	void StopTx(int PanelAddr);
+
+private:
+	typedef struct {
+		uint8_t Ram[LEDMXSIM_RAM_SIZE];
+		bool bSysEn;
+		bool bLedOn;
+		uint32_t CmdCnt;
+	} PANEL;
+
+	void Decode(PANEL &Panel);
+
+	PANEL vPanel[LEDMX_MAX_PANEL];
+	int vSel;						// Selected panel, -1 none
+	std::vector<uint8_t> vBits;		// Bits of current transaction
+	uint64_t vTxBits;
+	uint32_t vTxCnt;
+	uint32_t vErrCnt;
+};
+
+/** @} End of group MiscDev */
+
+#endif // __LEDMX_SIM_H__
@@ -0,0 +1,106 @@
+/**-------------------------------------------------------------------------
+@file	nrf.h
+
+@brief	nRF52 register definitions for Linux host.
+
+Only the PWM peripheral is defined, its registers are the simulated block of
+pwm_sim.h. Lets the nRF52 PWM driver build on host, see
+pwm_sim.cpp. IRQ numbers index the simulated devices.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __NRF_H__
+#define __NRF_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#include "pwm_sim.h"
+
+typedef enum {
+	PWM0_IRQn = 0,
+	PWM1_IRQn = 1,
+	PWM2_IRQn = 2,
+} IRQn_Type;
+
+typedef PwmSim NRF_PWM_Type;
+
+#define NRF_PWM0								(&g_PwmSim[0])
+#define NRF_PWM1								(&g_PwmSim[1])
+#define NRF_PWM2								(&g_PwmSim[2])
+
+// Same bit values as the nRF52 headers
+#define PWM_SHORTS_SEQEND0_STOP_Msk				(1UL << 0)
+#define PWM_SHORTS_SEQEND1_STOP_Msk				(1UL << 1)
+#define PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk		(1UL << 2)
+#define PWM_SHORTS_LOOPSDONE_SEQSTART1_Msk		(1UL << 3)
+#define PWM_SHORTS_LOOPSDONE_STOP_Pos			4
+#define PWM_SHORTS_LOOPSDONE_STOP_Msk			(1UL << PWM_SHORTS_LOOPSDONE_STOP_Pos)
+#define PWM_SHORTS_LOOPSDONE_STOP_Enabled		1UL
+
+#define PWM_INTEN_STOPPED_Msk					(1UL << 1)
+#define PWM_INTEN_SEQSTARTED0_Msk				(1UL << 2)
+#define PWM_INTEN_SEQSTARTED1_Msk				(1UL << 3)
+#define PWM_INTEN_SEQEND0_Msk					(1UL << 4)
+#define PWM_INTEN_SEQEND1_Msk					(1UL << 5)
+#define PWM_INTEN_PWMPERIODEND_Msk				(1UL << 6)
+#define PWM_INTEN_LOOPSDONE_Msk					(1UL << 7)
+
+#define PWM_ENABLE_ENABLE_Disabled				0UL
+#define PWM_ENABLE_ENABLE_Enabled				1UL
+
+#define PWM_MODE_UPDOWN_Up						0UL
+#define PWM_MODE_UPDOWN_UpAndDown				1UL
+
+#define PWM_PRESCALER_PRESCALER_DIV_1			0UL
+#define PWM_PRESCALER_PRESCALER_DIV_2			1UL
+#define PWM_PRESCALER_PRESCALER_DIV_4			2UL
+#define PWM_PRESCALER_PRESCALER_DIV_8			3UL
+#define PWM_PRESCALER_PRESCALER_DIV_16			4UL
+#define PWM_PRESCALER_PRESCALER_DIV_32			5UL
+#define PWM_PRESCALER_PRESCALER_DIV_64			6UL
+#define PWM_PRESCALER_PRESCALER_DIV_128			7UL
+
+#define PWM_DECODER_LOAD_Pos					0
+#define PWM_DECODER_LOAD_Individual				2UL
+
+#define PWM_SEQ_CNT_CNT_Msk						0x7FFFUL
+#define PWM_SEQ_REFRESH_CNT_Msk					0xFFFFFFUL
+
+#define PWM_PSEL_OUT_CONNECT_Pos				31
+#define PWM_PSEL_OUT_CONNECT_Disconnected		1UL
+
+void NVIC_EnableIRQ(IRQn_Type IRQn);
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+static inline void NVIC_SetPriority(IRQn_Type IRQn, uint32_t Priority) {
+}
+
+#endif // __NRF_H__
@@ -0,0 +1,121 @@
+/**-------------------------------------------------------------------------
+@file	pulse_train_sim.h
+
+@brief	Simulated pulse train hardware link for Linux
+
+Models a timer + PPI + GPIOTE style pin event link : armed events drive pins
+exactly on their tick without CPU. Executed events are committed lazily to a
+log when the scheduler looks at the link or on Flush, using their own tick.
+
+PulseTrainSchedSim logs CPU driven pin events with the timer tick at which
+they were output, so both can be merged and checked against the program.
+
+Usage :
+
+	TimerSim timer;
+	PulseTrainHwLinkSim link;
+	PulseTrainSchedSim sched;
+
+	link.Init(&timer, 4);
+	sched.Init(&timer, -1, &link);
+	sched.Start(&prog, 10);
+	while (timer.AdvanceToTrigger());
+	link.Flush();
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __PULSE_TRAIN_SIM_H__
+#define __PULSE_TRAIN_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+
+#include "pulse_train.h"
+
+#pragma pack(push, 4)
+
+/// Logged pin event
+typedef struct __Pulse_Train_Sim_Evt {
+	uint64_t Tick;				//!< Absolute timer tick
+	uint32_t HiMask;			//!< Pins driven high
+	uint32_t LoMask;			//!< Pins driven low
+	bool bHw;					//!< true - driven by hardware link
+} PULSE_TRAIN_SIMEVT;
+
+#pragma pack(pop)
+
+/// @brief	Simulated hardware pin event link
+class PulseTrainHwLinkSim : public PulseTrainHwLink {
+public:
+	PulseTrainHwLinkSim() : vpTimer(NULL), vDepth(0), vHead(0), vCnt(0), vpLog(NULL) {}
+
+	/**
+	 * @brief	Initialize link
+	 *
+	 * @param	pTimer	: Timer giving current tick
+	 * @param	Depth	: Number of events armed at the same time,
+	 * 					  max PULSE_TRAIN_HWLINK_MAXDEPTH
+	 * @param	pLog	: Log to append executed events to
+	 *
+	 * @return	true - success
+	 */
+	bool Init(Timer * const pTimer, int Depth, std::vector<PULSE_TRAIN_SIMEVT> *pLog);
+
+	virtual int Depth() { return vDepth; }
+	virtual int Avail();
+	virtual bool Arm(uint64_t Tick, uint32_t HiMask, uint32_t LoMask);
+	virtual void Disarm();
+
+	/// Commit executed events to log
+	void Flush();
+
+private:
+	Timer *vpTimer;
+	int vDepth;
+	int vHead;
+	int vCnt;
+	PULSE_TRAIN_SIMEVT vSlot[PULSE_TRAIN_HWLINK_MAXDEPTH];
+	std::vector<PULSE_TRAIN_SIMEVT> *vpLog;
+};
+
+/// @brief	Pulse train scheduler logging CPU driven pin events
+class PulseTrainSchedSim : public PulseTrainSched {
+public:
+	PulseTrainSchedSim() : vpLog(NULL) {}
+
+	void SetLog(std::vector<PULSE_TRAIN_SIMEVT> *pLog) { vpLog = pLog; }
+
+protected:
+	virtual void Output(uint32_t HiMask, uint32_t LoMask);
+
+private:
+	std::vector<PULSE_TRAIN_SIMEVT> *vpLog;
+};
+
+#endif // __PULSE_TRAIN_SIM_H__
@@ -0,0 +1,190 @@
+/**-------------------------------------------------------------------------
+@file	pwm_sim.h
+
+@brief	Simulated PWM peripheral for Linux
+
+Models the nRF52 PWM sequence player running on virtual time, one step per
+PWM period. Two sequences of compare values (individual decoder, one word per
+channel per period) are read from memory as the hardware EasyDMA would, each
+value held REFRESH + 1 periods. Sequence end, loop and stop events, shortcuts
+and the interrupt are modeled. The interrupt handler runs a configurable
+number of PWM periods after the event to test refill latency.
+
+Registers keep the nRF52 names, the nRF52 PWM driver is compiled unchanged
+against this block (see nrf.h).
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __PWM_SIM_H__
+#define __PWM_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+
+#define PWMSIM_MAX_DEV				3
+#define PWMSIM_MAX_CHAN				4
+
+#define PWMSIM_IDLE					0xFFFF		//!< Output value recorded while stopped
+
+// Task numbers
+#define PWMSIM_TASK_STOP			0
+#define PWMSIM_TASK_SEQSTART0		1
+#define PWMSIM_TASK_SEQSTART1		2
+
+typedef void (*PWMSIM_IRQHANDLER)();
+
+class PwmSim;
+
+/// Task register, writing non zero triggers the task
+class PwmSimTask {
+public:
+	void Init(PwmSim *pSim, int TaskNo) { vpSim = pSim; vTaskNo = TaskNo; }
+	PwmSimTask &operator=(uint32_t Val);
+
+private:
+	PwmSim *vpSim;
+	int vTaskNo;
+};
+
+/// Sequence registers
+typedef struct __Pwm_Sim_Seq {
+	uintptr_t PTR;				//!< Compare values
+	uint32_t CNT;				//!< Nb of words
+	uint32_t REFRESH;			//!< Additional periods each value is held
+	uint32_t ENDDELAY;			//!< Not modeled
+} PWMSIM_SEQ;
+
+/// @brief	Simulated nRF52 like PWM sequence player
+class PwmSim {
+public:
+	PwmSim();
+
+	/// Reset registers, state and statistics, interrupt stays connected
+	void Reset();
+
+	/// Run task TaskNo, PWMSIM_TASK_x
+	void Task(int TaskNo);
+
+	/**
+	 * @brief	Run PWM periods
+	 *
+	 * Interrupt handler is called in between periods.
+	 *
+	 * @param	NbPeriod	: Nb of PWM periods
+	 */
+	void Run(uint64_t NbPeriod);
+
+	/**
+	 * @brief	Run until stopped
+	 *
+	 * Interrupt pending when stopped is run without waiting for latency.
+	 *
+	 * @param	MaxPeriod	: Max nb of PWM periods
+	 *
+	 * @return	true - stopped
+	 */
+	bool RunToStop(uint64_t MaxPeriod);
+
+	/// Connect interrupt handler, NULL - interrupt disabled
+	void SetIrqHandler(PWMSIM_IRQHANDLER Handler) { vIrqHandler = Handler; }
+	void ClearPendingIrq() { vbIrqPending = false; }
+	void IrqLatency(uint32_t NbPeriod) { vIrqLatency = NbPeriod; }
+
+	bool IsRunning() { return vbRun; }
+	uint64_t PeriodCount() { return vPeriodCnt; }
+	uint32_t IrqCount() { return vIrqCnt; }
+	uint32_t LateCount() { return vLateCnt; }	//!< Sequences started before their refill interrupt ran
+	uint32_t ReadCount() { return vReadCnt; }	//!< Compare values read from memory
+
+	/// Record output, NbChan words per period
+	void Record(bool bEn) { vbRecord = bEn; }
+	const std::vector<uint16_t> &Output() { return vOutput; }
+	void ClearOutput() { vOutput.clear(); }
+
+	// Registers
+	PwmSimTask TASKS_STOP;
+	PwmSimTask TASKS_SEQSTART[2];
+	volatile uint32_t EVENTS_STOPPED;
+	volatile uint32_t EVENTS_SEQSTARTED[2];
+	volatile uint32_t EVENTS_SEQEND[2];
+	volatile uint32_t EVENTS_PWMPERIODEND;
+	volatile uint32_t EVENTS_LOOPSDONE;
+	uint32_t SHORTS;
+	uint32_t INTEN;
+	uint32_t ENABLE;
+	uint32_t MODE;
+	uint32_t COUNTERTOP;
+	uint32_t PRESCALER;
+	uint32_t DECODER;
+	uint32_t LOOP;
+	PWMSIM_SEQ SEQ[2];
+	struct {
+		uint32_t OUT[PWMSIM_MAX_CHAN];
+	} PSEL;
+
+private:
+	void SeqStart(int SeqNo);
+	void Stop();
+	void Play(int SeqNo);
+	void SeqEnd();
+	void Event(volatile uint32_t &Evt, uint32_t IntMsk);
+	void Halt();
+
+	bool vbRun;					// Generating PWM
+	bool vbPlaying;				// Reading sequence
+	int vCur;					// Sequence playing
+	uint32_t vElem;				// Element index in sequence
+	uint32_t vRefreshLeft;		// Periods left for current element
+	uint32_t vLoopCnt;
+	uint16_t vOut[PWMSIM_MAX_CHAN];
+	bool vbRefillPending[2];
+	bool vbIrqPending;
+	uint64_t vIrqDue;
+	uint32_t vIrqLatency;
+	PWMSIM_IRQHANDLER vIrqHandler;
+	uint64_t vPeriodCnt;
+	uint32_t vIrqCnt;
+	uint32_t vLateCnt;
+	uint32_t vReadCnt;
+	bool vbRecord;
+	std::vector<uint16_t> vOutput;
+};
+
+extern PwmSim g_PwmSim[PWMSIM_MAX_DEV];
+
+/**
+ * @brief	Get simulated peripheral of PWM device
+ *
+ * @param	DevNo	: PWM device number
+ *
+ * @return	Pointer to simulated peripheral, NULL if invalid
+ */
+PwmSim *PwmSimDevice(int DevNo);
+
+#endif // __PWM_SIM_H__
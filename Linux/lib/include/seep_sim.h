@@ -0,0 +1,156 @@
+/**-------------------------------------------------------------------------
+@file	seep_sim.h
+
+@brief	I2C Serial EEPROM simulator for Linux
+
+Device interface emulating a 24xx family I2C EEPROM for host testing of the Seep
+driver.  It enforces the behaviours that a real part has and a plain memory buffer
+does not :
+	- Address is NACK'ed while an internal write cycle is in progress (Twr)
+	- Sequential write wraps around within the page
+	- Memory address high bits are taken from the device address block select
+	  bits when address length is too short for the whole memory
+
+Usage :
+
+SeepSim g_SeepSim;
+
+g_SeepSim.Init(s_AT24CS08EepCfg);
+SeepInit(&g_SeepDev, &s_AT24CS08EepCfg, g_SeepSim);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __SEEP_SIM_H__
+#define __SEEP_SIM_H__
+
+#include <stdint.h>
+#include <chrono>
+
+#include "device_intrf.h"
+#include "seep.h"
+
+/** @addtogroup Storage
+  * @{
+  */
+
+/// @brief	Simulated I2C Serial EEPROM device interface
+class SeepSim : public DeviceIntrf {
+public:
+	SeepSim();
+	virtual ~SeepSim();
+	SeepSim(SeepSim&);	// Copy ctor not allowed
+
+	/**
+	 * @brief	Initialize simulator with EEPROM configuration
+	 *
+	 * Memory is set to erased state (0xFF)
+	 *
+	 * @param	Cfg	: Serial EEPROM configuration to simulate
+	 *
+	 * @return	true - success
+	 */
+	bool Init(const SEEP_CFG &Cfg);
+
+	operator DEVINTRF * const () { return &vDevIntrf; }
+	int Rate(int DataRate) { vRate = DataRate; return vRate; }
+	int Rate(void) { return vRate; }
+	virtual bool StartRx(int DevAddr);
+	virtual int RxData(uint8_t *pBuff, int BuffLen);
+	virtual void StopRx(void);
+	virtual bool StartTx(int DevAddr);
+	virtual int TxData(uint8_t *pData, int DataLen);
+	virtual void StopTx(void);
+
+	/**
+	 * @brief	Get direct access to simulated memory content
+	 *
+	 * @return	Pointer to memory array
+	 */
+	uint8_t *Mem() { return vpMem; }
+
+	/**
+	 * @brief	Number of internal write cycles performed
+	 */
+	uint32_t WrCycles() { return vWrCycles; }
+
+	/**
+	 * @brief	Number of write cycles per page. Array of Size / PageSize entries
+	 */
+	const uint32_t *PageWrCycles() { return vpPageWrCnt; }
+
+	/**
+	 * @brief	Number of address NACK
+	 */
+	uint32_t NackCount() { return vNackCnt; }
+
+	/**
+	 * @brief	Number of bytes transfered on the bus including device address
+	 */
+	uint32_t BusBytes() { return vBusBytes; }
+
+	/**
+	 * @brief	Estimated bus time in usec from byte count and bus rate (9 clocks per byte)
+	 */
+	uint32_t BusTime() { return (uint64_t)vBusBytes * 9000000ULL / vRate; }
+
+	void ResetCounters() { vWrCycles = 0; vNackCnt = 0; vBusBytes = 0; }
+
+	/**
+	 * @brief	Simulate a device that never acknowledges its address
+	 *
+	 * @param	bStuck	: true - NACK every transfer
+	 */
+	void SetStuck(bool bStuck) { vbStuck = bStuck; }
+
+private:
+	bool IsBusy();
+	uint32_t MemAddr(int DevAddr, uint32_t Addr);
+
+	DEVINTRF vDevIntrf;
+	SEEP_CFG vCfg;
+	int vRate;
+	uint8_t *vpMem;
+	uint32_t *vpPageWrCnt;
+	uint8_t *vpPage;			// Page write staging buffer
+	int vDevAddr;				// Device address of current transfer
+	bool vbAck;					// Current transfer addressed & acknowledged
+	bool vbStuck;				// NACK every transfer
+	int vAddrIdx;				// Number of memory address bytes received
+	uint32_t vAddr;				// Current memory address pointer
+	uint32_t vPageAddr;			// Page of current write
+	uint8_t vDirty[256 / 8];	// Latched bytes in page buffer (bit map), page size max 256
+	std::chrono::steady_clock::time_point vBusyUntil;
+	uint32_t vWrCycles;
+	uint32_t vNackCnt;
+	uint32_t vBusBytes;
+};
+
+/** @} End of group Storage */
+
+#endif // __SEEP_SIM_H__
@@ -0,0 +1,121 @@
+/**-------------------------------------------------------------------------
+@file	serial_sim.h
+
+@brief	Simulated serial link pair with error injection for Linux
+
+Two device interfaces connected back to back, as two UARTs wired together or
+two ends of a packet radio. Each direction moves bytes at the configured rate
+through a limited Tx FIFO and Rx FIFO. Bytes are corrupted at the configured
+bit error rate and dropped at the configured byte drop rate. Rx FIFO overrun
+drops bytes as a real UART does.
+
+In packet mode, each TxData call is one packet and each RxData call returns
+one packet. Drop rate then applies to whole packets.
+
+Time is in usec and only moves in Advance.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __SERIAL_SIM_H__
+#define __SERIAL_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+
+#include "device_intrf.h"
+
+/** @addtogroup device_intrf
+  * @{
+  */
+
+#pragma pack(push, 4)
+
+/// Simulated serial link configuration
+typedef struct __Serial_Sim_Config {
+	uint32_t ByteRate;			//!< Bytes per second each direction, ex. baudrate / 10
+	int TxFifoSize;				//!< Tx FIFO size in bytes, packets in packet mode
+	int RxFifoSize;				//!< Rx FIFO size in bytes, packets in packet mode
+	double Ber;					//!< Bit error rate
+	double DropRate;			//!< Byte drop probability, packet in packet mode
+	bool bPacket;				//!< Packet mode
+	int PacketMax;				//!< Max packet size in packet mode
+	uint32_t Seed;				//!< Random seed
+} SERIALSIM_CFG;
+
+#pragma pack(pop)
+
+/// @brief	Simulated serial link pair
+class SerialSim {
+public:
+	bool Init(const SERIALSIM_CFG &Cfg);
+
+	/**
+	 * @brief	Get device interface of one end
+	 *
+	 * @param	Idx	: End 0 or 1
+	 */
+	DEVINTRF *Intrf(int Idx) { return &vPort[Idx].DevIntrf; }
+
+	/// Move data on the wire for Us usec
+	void Advance(uint32_t Us);
+
+	uint64_t usTime() { return vusTime; }
+	uint32_t ErrCount() { return vErrCnt; }			//!< Bytes or packets corrupted
+	uint32_t DropCount() { return vDropCnt; }		//!< Bytes or packets dropped
+	uint32_t OverrunCount() { return vOvrCnt; }		//!< Bytes or packets lost on Rx FIFO full
+
+private:
+	typedef struct {
+		DEVINTRF DevIntrf;
+		SerialSim *pSim;
+		int Idx;
+		std::deque<std::vector<uint8_t> > TxFifo;	// One byte per entry in byte mode
+		std::deque<std::vector<uint8_t> > RxFifo;
+		int TxCnt;				// Bytes or packets in TxFifo
+		double Credit;			// Wire bytes that can be sent
+	} PORT;
+
+	static int RxData(DEVINTRF * const pDevIntrf, uint8_t *pBuff, int BuffLen);
+	static int TxData(DEVINTRF * const pDevIntrf, uint8_t *pData, int DataLen);
+	uint32_t Rand();
+	bool Corrupt(std::vector<uint8_t> &Data);
+
+	SERIALSIM_CFG vCfg;
+	PORT vPort[2];
+	uint64_t vusTime;
+	uint32_t vRand;
+	uint32_t vErrCnt;
+	uint32_t vDropCnt;
+	uint32_t vOvrCnt;
+};
+
+/** @} end group device_intrf */
+
+#endif // __SERIAL_SIM_H__
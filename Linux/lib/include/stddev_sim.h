@@ -0,0 +1,156 @@
+/**-------------------------------------------------------------------------
+@file	stddev_sim.h
+
+@brief	Simulated stdio devices for Linux
+
+Mock devices implementing the STDDEV functions so the stdio device layer can be
+run and timed on host.  Time is virtual, shared by the devices through a
+StdDevSimClock.  It moves when the application idles or when a device call
+has to wait, the waiting time is accounted as blocked time.
+
+SerialStdDevSim models a UART or BLE stream : a Tx FIFO drained at one byte per
+byte period and an Rx FIFO filled by injected data at its arrival time.  In
+blocking mode Read waits for data and Write waits for FIFO space, as the UART
+driver does with bFifoBlocking.  Otherwise they return what is available.
+
+FileStdDevSim models a FAT file on an SD card : every read costs a fixed access
+latency plus transfer time and is always synchronous.
+
+Usage :
+
+	StdDevSimClock clk;
+	SerialStdDevSim con;
+
+	con.Init(&clk, 87, 64, 64, false);
+	InstallBlkDev(con.Dev(), STDIN_FILENO);
+	InstallBlkDev(con.Dev(), STDOUT_FILENO);
+	con.RxInject(10000, "?\r", 2);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __STDDEV_SIM_H__
+#define __STDDEV_SIM_H__
+
+#include <stdint.h>
+#include <vector>
+#include <deque>
+#include <string>
+
+#include "stddev.h"
+
+/// Virtual time in usec
+class StdDevSimClock {
+public:
+	StdDevSimClock() : vusTime(0) {}
+	uint64_t usTime() { return vusTime; }
+	void Advance(uint64_t us) { vusTime += us; }
+	void AdvanceTo(uint64_t usTime) { vusTime = usTime > vusTime ? usTime : vusTime; }
+
+private:
+	uint64_t vusTime;
+};
+
+/// @brief	Simulated serial stream device
+class SerialStdDevSim {
+public:
+	/**
+	 * @brief	Initialize device
+	 *
+	 * @param	pClock		: Shared virtual clock
+	 * @param	BytePeriodUs: Time to transmit or receive one byte
+	 * @param	TxFifoSize	: Tx FIFO size in bytes
+	 * @param	RxFifoSize	: Rx FIFO size in bytes, overflow is dropped
+	 * @param	bBlocking	: true - Read & Write wait
+	 */
+	bool Init(StdDevSimClock *pClock, uint32_t BytePeriodUs, int TxFifoSize, int RxFifoSize, bool bBlocking);
+
+	/// Data arrives on the line starting at usTime, one byte per byte period
+	void RxInject(uint64_t usTime, const char *pData, int Len);
+
+	STDDEV *Dev() { return &vDev; }
+	const std::string &TxData() { return vTxData; }			//!< Data accepted for transmit
+	uint64_t TxIdleTime() { return vTxEnd; }				//!< Time Tx FIFO is empty
+	uint64_t BlockedUs() { return vBlockedUs; }				//!< Time waited inside calls
+	uint32_t RxDropCount() { return vRxDropCnt; }
+
+private:
+	static int Read(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len);
+	static int Write(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len);
+	static int Poll(void * const pDevObj, int Handle, int Events);
+
+	void Update();
+	int TxAvail();
+
+	STDDEV vDev;
+	StdDevSimClock *vpClock;
+	uint32_t vBytePeriod;
+	int vTxFifoSize;
+	int vRxFifoSize;
+	bool vbBlocking;
+	uint64_t vTxEnd;
+	std::deque<std::pair<uint64_t, uint8_t> > vRxLine;		// Arrival time, byte
+	std::deque<uint8_t> vRxFifo;
+	std::string vTxData;
+	uint64_t vBlockedUs;
+	uint32_t vRxDropCnt;
+};
+
+/// @brief	Simulated file system with one synchronous file
+class FileStdDevSim {
+public:
+	/**
+	 * @brief	Initialize device
+	 *
+	 * @param	pClock		: Shared virtual clock
+	 * @param	Size		: File size in bytes, content is a known pattern
+	 * @param	AccessUs	: Latency of each read
+	 * @param	BytesPerUs	: Transfer rate
+	 */
+	bool Init(StdDevSimClock *pClock, size_t Size, uint32_t AccessUs, uint32_t BytesPerUs);
+
+	STDDEV *Dev() { return &vDev; }
+	const std::vector<uint8_t> &Data() { return vData; }
+	uint64_t BusyUs() { return vBusyUs; }					//!< Time spent in reads
+
+private:
+	static int Open(void * const pDevObj, const char *pDevName, int Flags, int Mode);
+	static int Close(void * const pDevObj, int Handle);
+	static int Read(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len);
+	static int Seek(void * const pDevObj, int Handle, int Offset);
+
+	STDDEV vDev;
+	StdDevSimClock *vpClock;
+	std::vector<uint8_t> vData;
+	size_t vOffset;
+	uint32_t vAccessUs;
+	uint32_t vBytesPerUs;
+	uint64_t vBusyUs;
+};
+
+#endif // __STDDEV_SIM_H__
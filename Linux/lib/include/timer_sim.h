@@ -0,0 +1,137 @@
+/**-------------------------------------------------------------------------
+@file	timer_sim.h
+
+@brief	Simulated timer for Linux
+
+Timer implementation running on virtual time.  Time only moves when the
+application calls Advance or AdvanceToTrigger.  Triggers are fired in time order
+on the calling thread, as the interrupt would on target.  This makes timer based
+code deterministic and fast to test on host.
+
+Usage :
+
+TimerSim g_Timer;
+
+g_Timer.Init(s_TimerCfg);			// Freq 32768 like the nRF5x RTC
+g_Timer.EnableTimerTrigger(0, 100000000ULL, TIMER_TRIG_TYPE_CONTINUOUS, Handler);
+g_Timer.Advance(32768);				// Run 1 sec, Handler called 10 times
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __TIMER_SIM_H__
+#define __TIMER_SIM_H__
+
+#include <stdint.h>
+
+#include "coredev/timer.h"
+
+/** @addtogroup Timer
+  * @{
+  */
+
+#define TIMER_SIM_MAX_TRIGGER_EVT		4	//!< Same as nRF5x RTC
+
+/// @brief	Virtual time timer
+class TimerSim : public Timer {
+public:
+	TimerSim();
+	virtual ~TimerSim();
+
+	virtual bool Init(const TIMER_CFG &Cfg);
+	virtual bool Enable() { vbEnabled = true; return true; }
+	virtual void Disable() { vbEnabled = false; }
+	virtual void Reset() { vTick = 0; }
+	virtual uint32_t Frequency(uint32_t Freq);
+	virtual uint32_t Frequency(void) { return vFreq; }
+	virtual uint64_t TickCount() { return vTick; }
+	int MaxTimerTrigger() { return TIMER_SIM_MAX_TRIGGER_EVT; }
+	virtual uint32_t EnableTimerTrigger(int TrigNo, uint32_t msPeriod, TIMER_TRIG_TYPE Type,
+										TIMER_TRIGCB const Handler = NULL, void * const pContext = NULL) {
+		return (uint32_t)(EnableTimerTrigger(TrigNo, (uint64_t)((uint64_t)msPeriod * 1000000ULL), Type, Handler, pContext) / 1000000ULL);
+	}
+	virtual uint64_t EnableTimerTrigger(int TrigNo, uint64_t nsPeriod, TIMER_TRIG_TYPE Type,
+										TIMER_TRIGCB const Handler = NULL, void * const pContext = NULL);
+	virtual void DisableTimerTrigger(int TrigNo);
+	int FindAvailTimerTrigger(void);
+
+	/**
+	 * @brief	Move virtual time forward, firing triggers on the way
+	 *
+	 * @param	NbTick	: Number of ticks to advance
+	 */
+	void Advance(uint64_t NbTick);
+
+	/**
+	 * @brief	Move virtual time to the next trigger and fire it.  Equivalent
+	 * 			to sleeping until the next timer interrupt
+	 *
+	 * @return	false - no trigger enabled, time not moved
+	 */
+	bool AdvanceToTrigger();
+
+	/**
+	 * @brief	Number of trigger interrupts fired
+	 */
+	uint32_t IrqCount() { return vIrqCnt; }
+
+	/**
+	 * @brief	Simulate interrupt latency
+	 *
+	 * Trigger handlers run a random number of ticks after the trigger tick,
+	 * uniformly distributed in [MinTick, MaxTick]. Time seen by the handler
+	 * includes the latency. Default is no latency.
+	 *
+	 * @param	MinTick	: Min latency in ticks
+	 * @param	MaxTick	: Max latency in ticks
+	 * @param	Seed	: Random seed
+	 */
+	void IrqLatency(uint32_t MinTick, uint32_t MaxTick, uint32_t Seed = 1) {
+		vLatMin = MinTick;
+		vLatMax = MaxTick > MinTick ? MaxTick : MinTick;
+		vLatSeed = Seed;
+	}
+
+private:
+	int NextTrigger();
+	void Fire(int TrigNo);
+
+	bool vbEnabled;
+	uint64_t vTick;
+	uint32_t vIrqCnt;
+	uint32_t vLatMin;
+	uint32_t vLatMax;
+	uint32_t vLatSeed;
+	uint64_t vCC[TIMER_SIM_MAX_TRIGGER_EVT];		//!< Absolute trigger tick, 0 - disabled
+	uint64_t vPeriod[TIMER_SIM_MAX_TRIGGER_EVT];	//!< Trigger period in ticks
+	TIMER_TRIGGER vTrigger[TIMER_SIM_MAX_TRIGGER_EVT];
+};
+
+/** @} End of group Timer */
+
+#endif // __TIMER_SIM_H__
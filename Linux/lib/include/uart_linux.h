@@ -0,0 +1,109 @@
+/**-------------------------------------------------------------------------
+@file	uart_linux.h
+
+@brief	Linux UART device implementation
+
+Implements UARTDEV on a Linux tty (serial port, USB CDC, pty). The port is
+configured in raw mode through termios2 so any baudrate can be requested
+(BOTHER), and the serial driver low latency flag is set when supported.
+
+A dedicated I/O thread waits on epoll and moves data in bulk between the file
+descriptor and the hRxFifo/hTxFifo CFIFOs. It plays the role of the interrupt
+handler on MCU targets : UARTEVTCB events are fired from this thread with the
+same meaning as the nRF5x driver, keep them short.
+
+	UART_EVT_RXDATA		: new data in Rx FIFO, BufferLen = CFifoUsed
+	UART_EVT_RXTIMEOUT	: same but the line went idle (kernel buffer drained)
+	UART_EVT_TXREADY	: data sent, BufferLen = CFifoAvail of Tx FIFO
+	UART_EVT_LINESTATE	: hangup or error counters changed (see UART_LINESTATE_xxx)
+
+The Rx FIFO is never overrun. When full, data is left in the kernel buffer so
+hardware flow control (or the pty) pushes back until the application reads.
+
+UARTCFG.pIOPinMap is the device path string, NbIOPins its length. DevNo
+selects the instance slot returned by UARTGetInstance.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __UART_LINUX_H__
+#define __UART_LINUX_H__
+
+#include <stdint.h>
+#include <pthread.h>
+
+#include "coredev/uart.h"
+
+/** @addtogroup device_intrf
+  * @{
+  */
+
+#define LINUXUART_DEVPATH_MAXLEN	255
+#define LINUXUART_MAXDEV			8			//!< Max number of instances (DevNo)
+#define LINUXUART_BUFF_SIZE			4096		//!< Bulk transfer size per system call
+#define LINUXUART_CFIFO_SIZE		CFIFO_MEMSIZE(LINUXUART_BUFF_SIZE)	//!< Default FIFO memory
+
+#pragma pack(push, 4)
+
+/// Linux UART private data
+typedef struct __Uart_Linux_Dev {
+	int DevNo;								//!< Instance number
+	int hDevFile;							//!< tty file descriptor
+	int hEpoll;								//!< epoll handle of I/O thread
+	int hWakeEvt;							//!< eventfd used to wake I/O thread
+	char DevPath[LINUXUART_DEVPATH_MAXLEN + 1];	//!< Device path
+	UARTDEV *pUartDev;						//!< Pointer to generic UART dev. data
+	pthread_t hThread;						//!< I/O thread
+	pthread_mutex_t RxLock;					//!< Rx FIFO lock (replaces interrupt disable)
+	pthread_mutex_t TxLock;					//!< Tx FIFO & Tx cache lock
+	volatile bool bRun;						//!< I/O thread running
+	bool bThread;							//!< I/O thread created
+	bool bOrigValid;						//!< OrigAttr contains original settings
+	bool bICount;							//!< Driver supports TIOCGICOUNT
+	uint32_t EpollEvt;						//!< Events currently armed on hDevFile
+	uint32_t RxCnt;							//!< Total bytes received
+	uint32_t TxCnt;							//!< Total bytes transmitted
+	uint32_t RxSysCnt;						//!< Number of read system calls
+	uint32_t TxSysCnt;						//!< Number of write system calls
+	uint32_t ErrCnt;						//!< Framing, parity & overrun errors
+	uint32_t FrameErrCnt;					//!< Last driver frame error count
+	uint32_t ParityErrCnt;					//!< Last driver parity error count
+	uint32_t OverrunCnt;					//!< Last driver overrun count
+	int TxCacheLen;							//!< Bytes in Tx cache
+	int TxCacheOff;							//!< Bytes of Tx cache already written
+	uint8_t OrigAttr[64];					//!< Original struct termios2, opaque to keep asm/termbits.h private
+	uint8_t TxCache[LINUXUART_BUFF_SIZE];	//!< Data taken from Tx FIFO not yet accepted by the driver
+	uint8_t RxFifoMem[LINUXUART_CFIFO_SIZE];	//!< Default Rx FIFO memory
+	uint8_t TxFifoMem[LINUXUART_CFIFO_SIZE];	//!< Default Tx FIFO memory
+} LINUXUARTDEV;
+
+#pragma pack(pop)
+
+/** @} end group device_intrf */
+
+#endif // __UART_LINUX_H__
@@ -0,0 +1,217 @@
+/**-------------------------------------------------------------------------
+@file	usb_hidhost_impl.h
+
+@brief	Generic class of Host side USB HID device access
+		Implementation class for Linux hidraw
+
+An I/O thread waits on the hidraw node.  Every input report is time stamped
+and pushed into a lock free single producer, single consumer report queue, so
+no report is lost to a slow reader as long as the queue has room.  When the
+queue is full the new report is dropped and counted.  Readers wait on an
+eventfd with usec timeout.
+
+Output reports can be written synchronously or queued.  Queued reports are
+written back to back by the I/O thread while the caller goes on, which keeps
+the device's output endpoint busy at its poll rate.
+
+Per report id latency statistics are kept : input from reception by the I/O
+thread to dequeue, output from queueing to write completion.
+
+Queue operations are meant for one application thread.
+
+Usage :
+
+	std::vector<std::string> paths;
+	UsbHidDevice_Impl dev;
+
+	if (UsbHidDevice_Impl::Find(0x1915, 0xDB01, paths) > 0 && dev.Init(paths[0].c_str()))
+	{
+		dev.QueueOutputReport(0, req, sizeof(req));
+		int l = dev.GetInputReport(rep, sizeof(rep), 2000);
+	}
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __USB_HIDHOST_IMPL_H__
+#define __USB_HIDHOST_IMPL_H__
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <thread>
+
+#include "usb/usb_hidhost.h"
+
+#define USBHID_QUEUE_DEPTH_DEF		256			//!< Default input & output queue depth
+#define USBHID_TIMEOUT_DEF			1000000		//!< Default read timeout in usec
+
+/// Latency statistics in nsec
+typedef struct __Usb_Hid_Latency_Stat {
+	uint32_t Cnt;
+	uint64_t MinNs;
+	uint64_t MaxNs;
+	uint64_t SumNs;
+} USBHID_LATSTAT;
+
+class UsbHidDevice_Impl : public UsbHidDevice {
+public:
+	UsbHidDevice_Impl();
+	virtual ~UsbHidDevice_Impl();
+
+	/**
+	 * @brief	Open hidraw device node & start I/O thread
+	 *
+	 * Report sizes and report id use are read from the report descriptor.
+	 *
+	 * @param	pDevPath	: Device node, ex. /dev/hidraw0
+	 * @param	QueueDepth	: Number of reports in each queue, rounded up to power of 2
+	 *
+	 * @return	true - success
+	 */
+	virtual bool Init(const char *pDevPath, int QueueDepth = USBHID_QUEUE_DEPTH_DEF);
+
+	/**
+	 * @brief	Use already open descriptor with hidraw read/write semantic
+	 *
+	 * The descriptor is owned and closed by the device.
+	 *
+	 * @param	Fd			: Open descriptor, one report per read & write
+	 * @param	MaxInRepSize: Max input report size, report id excluded
+	 * @param	MaxOutRepSize: Max output report size, report id excluded
+	 * @param	bNumbered	: Reports are prefixed by their report id
+	 * @param	QueueDepth	: Number of reports in each queue, rounded up to power of 2
+	 *
+	 * @return	true - success
+	 */
+	virtual bool Init(int Fd, uint32_t MaxInRepSize, uint32_t MaxOutRepSize, bool bNumbered,
+					  int QueueDepth = USBHID_QUEUE_DEPTH_DEF);
+	void Close();
+
+	/**
+	 * @brief	Find hidraw nodes of a device
+	 *
+	 * @param	Vid		: Vendor id
+	 * @param	Pid		: Product id
+	 * @param	Paths	: Device nodes found
+	 *
+	 * @return	Number of nodes found
+	 */
+	static int Find(uint16_t Vid, uint16_t Pid, std::vector<std::string> &Paths);
+
+	virtual void GetDeviceCapabilities() {}
+	virtual int ReadInputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize, bool CtrlTrans = true);
+	virtual bool WriteOutputReport(int RepNo, uint8_t *pBuf, uint32_t Bufsize, bool CtrlTrans = true);
+	virtual int ReadFeatureReport(int RepNo, uint8_t *pBuf, uint32_t BufSize);
+	virtual bool WriteFeatureReport(int RepNo, uint8_t *pBuf, uint32_t BufSize);
+	virtual bool GetSerialNumber(std::string &sn);
+
+	/**
+	 * @brief	Input report hook, called from the I/O thread
+	 *
+	 * @return	false - report consumed, not queued
+	 */
+	virtual bool ProcessInputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize) { return true; }
+	virtual bool WaitResponse(int TimeOutSec);
+	virtual bool WaitResponseUs(uint32_t TimeoutUs);
+	virtual bool QueueOutputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize);
+
+	/**
+	 * @brief	Dequeue next input report
+	 *
+	 * @param	pBuf		: Buffer to receive report data, report id excluded
+	 * @param	BufSize		: Buffer size
+	 * @param	TimeoutUs	: Max wait in usec, 0 - no wait
+	 * @param	pRepNo		: Optional, report id
+	 * @param	pTimeNs		: Optional, CLOCK_MONOTONIC reception time
+	 *
+	 * @return	Report length, 0 on timeout
+	 */
+	int GetInputReport(uint8_t *pBuf, uint32_t BufSize, uint32_t TimeoutUs, int *pRepNo = NULL,
+					   uint64_t *pTimeNs = NULL);
+
+	/// Wait for queued output reports to be written, return false on timeout
+	bool FlushOutput(uint32_t TimeoutUs);
+
+	void SetTimeout(uint32_t TimeoutUs) { vTimeoutUs = TimeoutUs; }
+	int InputPending() { return vInQue.Put.load() - vInQue.Get.load(); }
+	uint32_t InDropCount() { return vInDropCnt; }
+	uint32_t OutErrorCount() { return vOutErrCnt; }
+	const USBHID_LATSTAT &InLatency(int RepNo) { return vInLat[RepNo & 0xFF]; }
+	const USBHID_LATSTAT &OutLatency(int RepNo) { return vOutLat[RepNo & 0xFF]; }
+	void ResetStats();
+
+	static uint64_t nsTime();
+
+protected:
+	virtual void ReadDeviceInfo();
+
+private:
+	/// Lock free single producer, single consumer report queue
+	typedef struct {
+		std::vector<uint8_t> Mem;
+		uint32_t SlotSize;
+		uint32_t Depth;
+		std::atomic<uint32_t> Put;
+		std::atomic<uint32_t> Get;
+	} REPQUE;
+
+	/// Report slot header, data follows
+	typedef struct {
+		uint64_t TimeNs;
+		uint16_t Len;
+		uint8_t RepNo;
+	} REPSLOT;
+
+	bool Start(int QueueDepth);
+	void IoThread();
+	void QueInit(REPQUE &Que, uint32_t MaxDataSize, int Depth);
+	REPSLOT *QueSlot(REPQUE &Que, uint32_t Idx) { return (REPSLOT*)&Que.Mem[(Idx % Que.Depth) * Que.SlotSize]; }
+	bool WaitEvt(int EvtFd, uint64_t DeadlineNs);
+	void LatAdd(USBHID_LATSTAT &Stat, uint64_t Ns);
+	bool WriteReport(int RepNo, const uint8_t *pBuf, uint32_t BufSize);
+
+	int vFd;
+	bool vbNumbered;			//!< Reports prefixed by report id
+	std::string vSysName;		//!< hidrawN
+	uint32_t vTimeoutUs;
+	std::thread vThread;
+	std::atomic<bool> vbRun;
+	int vInEvt;					//!< Signaled on input report queued
+	int vOutEvt;				//!< Signaled on output report queued or stop
+	int vOutDoneEvt;			//!< Signaled on output report written
+	REPQUE vInQue;
+	REPQUE vOutQue;
+	std::atomic<uint32_t> vInDropCnt;
+	std::atomic<uint32_t> vOutErrCnt;
+	USBHID_LATSTAT vInLat[256];
+	USBHID_LATSTAT vOutLat[256];
+};
+
+#endif   // __USB_HIDHOST_IMPL_H__
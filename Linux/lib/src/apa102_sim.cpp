@@ -0,0 +1,150 @@
+/**-------------------------------------------------------------------------
+@file	apa102_sim.cpp
+
+@brief	Simulated APA102 LED strip on SPI for Linux
+
+See apa102_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "apa102_sim.h"
+
+static void Apa102SimDisable(DEVINTRF * const pDevIntrf) {}
+static void Apa102SimEnable(DEVINTRF * const pDevIntrf) {}
+static int Apa102SimGetRate(DEVINTRF * const pDevIntrf) { return ((Apa102Sim*)pDevIntrf->pDevData)->Rate(); }
+static int Apa102SimSetRate(DEVINTRF * const pDevIntrf, int Rate) { return ((Apa102Sim*)pDevIntrf->pDevData)->Rate(Rate); }
+static bool Apa102SimStartRx(DEVINTRF * const pDevIntrf, int DevAddr) { return false; }
+static int Apa102SimRxData(DEVINTRF * const pDevIntrf, uint8_t *pBuff, int BuffLen) { return 0; }
+static void Apa102SimStopRx(DEVINTRF * const pDevIntrf) {}
+static void Apa102SimReset(DEVINTRF * const pDevIntrf) {}
+static void Apa102SimPowerOff(DEVINTRF * const pDevIntrf) {}
+
+bool Apa102Sim::Init(int NbLed, int Rate)
+{
+	if (NbLed <= 0 || Rate <= 0)
+	{
+		return false;
+	}
+
+	vRate = Rate;
+	vLed.assign(NbLed, 0);
+	vXfer.clear();
+	vWireNs = 0;
+	vXferCnt = 0;
+	vByteCnt = 0;
+	vLastUpdated = 0;
+	vStartErrCnt = 0;
+	vLatchErrCnt = 0;
+
+	vDevIntrf.pDevData = this;
+	vDevIntrf.IntPrio = 0;
+	vDevIntrf.EvtCB = NULL;
+	vDevIntrf.MaxRetry = 0;
+	vDevIntrf.bDma = true;
+	vDevIntrf.Type = DEVINTRF_TYPE_SPI;
+	vDevIntrf.Disable = Apa102SimDisable;
+	vDevIntrf.Enable = Apa102SimEnable;
+	vDevIntrf.GetRate = Apa102SimGetRate;
+	vDevIntrf.SetRate = Apa102SimSetRate;
+	vDevIntrf.StartRx = Apa102SimStartRx;
+	vDevIntrf.RxData = Apa102SimRxData;
+	vDevIntrf.StopRx = Apa102SimStopRx;
+	vDevIntrf.StartTx = SimStartTx;
+	vDevIntrf.TxData = SimTxData;
+	vDevIntrf.StopTx = SimStopTx;
+	vDevIntrf.Reset = Apa102SimReset;
+	vDevIntrf.PowerOff = Apa102SimPowerOff;
+	vDevIntrf.EnCnt = 1;
+	atomic_flag_clear(&vDevIntrf.bBusy);
+
+	return true;
+}
+
+bool Apa102Sim::SimStartTx(DEVINTRF * const pDevIntrf, int DevAddr)
+{
+	((Apa102Sim*)pDevIntrf->pDevData)->vXfer.clear();
+
+	return true;
+}
+
+int Apa102Sim::SimTxData(DEVINTRF * const pDevIntrf, uint8_t *pData, int DataLen)
+{
+	Apa102Sim *sim = (Apa102Sim*)pDevIntrf->pDevData;
+
+	sim->vXfer.insert(sim->vXfer.end(), pData, pData + DataLen);
+	sim->vWireNs += (uint64_t)DataLen * 8000000000ULL / sim->vRate;
+	sim->vByteCnt += DataLen;
+
+	return DataLen;
+}
+
+void Apa102Sim::SimStopTx(DEVINTRF * const pDevIntrf)
+{
+	Apa102Sim *sim = (Apa102Sim*)pDevIntrf->pDevData;
+
+	sim->vXferCnt++;
+	sim->Decode();
+}
+
+void Apa102Sim::Decode()
+{
+	size_t len = vXfer.size();
+
+	vLastUpdated = 0;
+
+	if (len < 4 || vXfer[0] != 0 || vXfer[1] != 0 || vXfer[2] != 0 || vXfer[3] != 0)
+	{
+		vStartErrCnt++;
+
+		return;
+	}
+
+	for (int i = 0; i < (int)vLed.size(); i++)
+	{
+		size_t off = 4 + 4 * (size_t)i;
+
+		if (off + 4 > len || (vXfer[off] & 0xE0) != 0xE0)
+		{
+			break;
+		}
+
+		// Data for LED i lags i half clocks behind the controller
+		if ((len - off - 4) * 8 * 2 < (size_t)i)
+		{
+			vLatchErrCnt++;
+			continue;
+		}
+
+		vLed[i] = ((uint32_t)vXfer[off] << 24) | ((uint32_t)vXfer[off + 1] << 16) |
+				  ((uint32_t)vXfer[off + 2] << 8) | vXfer[off + 3];
+		vLastUpdated++;
+	}
+}
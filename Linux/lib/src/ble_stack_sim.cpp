@@ -0,0 +1,99 @@
+/**-------------------------------------------------------------------------
+@file	ble_stack_sim.cpp
+
+@brief	Simulated BLE stack notification path for Linux
+
+See ble_stack_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include "ble_stack_sim.h"
+
+bool BleStackSim::Init(const BLESTACKSIM_CFG &Cfg)
+{
+	if (Cfg.ConnIntervalUs == 0 || Cfg.PktPerEvt <= 0 || Cfg.QueueDepth <= 0 ||
+		Cfg.AttMtu < BLENTFPUMP_DEFAULT_MTU)
+	{
+		return false;
+	}
+
+	vCfg = Cfg;
+	vusTime = 0;
+	vQueue.clear();
+	vRxData.clear();
+	vEvtCnt = 0;
+	vActiveEvtCnt = 0;
+	vPktCnt = 0;
+	vRejectCnt = 0;
+
+	return true;
+}
+
+BLENTFPUMP_SENDRES BleStackSim::Notify(uint8_t *pData, uint16_t Len)
+{
+	if (Len == 0 || Len > vCfg.AttMtu - BLENTFPUMP_ATT_HDR_LEN)
+	{
+		vRejectCnt++;
+		return BLENTFPUMP_SENDRES_FAIL;
+	}
+
+	if ((int)vQueue.size() >= vCfg.QueueDepth)
+	{
+		return BLENTFPUMP_SENDRES_BUSY;
+	}
+
+	vQueue.push_back(std::vector<uint8_t>(pData, pData + Len));
+
+	return BLENTFPUMP_SENDRES_OK;
+}
+
+int BleStackSim::ConnEvent()
+{
+	int cnt = 0;
+
+	vusTime += vCfg.ConnIntervalUs;
+	vEvtCnt++;
+
+	while (cnt < vCfg.PktPerEvt && vQueue.empty() == false)
+	{
+		std::vector<uint8_t> &pkt = vQueue.front();
+
+		vRxData.insert(vRxData.end(), pkt.begin(), pkt.end());
+		vQueue.pop_front();
+		cnt++;
+	}
+
+	if (cnt > 0)
+	{
+		vActiveEvtCnt++;
+		vPktCnt += cnt;
+	}
+
+	return cnt;
+}
@@ -0,0 +1,218 @@
+/**-------------------------------------------------------------------------
+@file	diskio_flashimg.cpp
+
+@brief	Flash image disk I/O for Linux
+
+Flash disk emulation backed by a memory mapped flash image file.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "diskio_flashimg.h"
+
+FlashImgDiskIO::FlashImgDiskIO() : DiskIO()
+{
+	vTotalSize = 0;
+	vSectSize = 4;
+	vbReadOnly = false;
+	vFd = -1;
+	vpMem = NULL;
+}
+
+FlashImgDiskIO::~FlashImgDiskIO()
+{
+	Close();
+}
+
+bool FlashImgDiskIO::Init(const char *pPath, uint32_t TotalSize, uint16_t SectSize, bool bReadOnly,
+						  DISKIO_CACHE_DESC * const pCacheBlk, int NbCacheBlk)
+{
+	if (pPath == NULL || TotalSize == 0)
+		return false;
+
+	Close();
+
+	size_t size = (size_t)TotalSize * 1024;
+	int fd = open(pPath, bReadOnly ? O_RDONLY : O_RDWR | O_CREAT, 0644);
+
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+
+	if (fstat(fd, &st) < 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	if ((size_t)st.st_size < size)
+	{
+		if (bReadOnly)
+		{
+			close(fd);
+			return false;
+		}
+
+		// Extend image with erased state
+		uint8_t d[DISKIO_SECT_SIZE];
+		memset(d, 0xFF, sizeof(d));
+
+		off_t off = st.st_size;
+		while ((size_t)off < size)
+		{
+			size_t l = size - off;
+			if (l > sizeof(d))
+				l = sizeof(d);
+			if (pwrite(fd, d, l, off) != (ssize_t)l)
+			{
+				close(fd);
+				return false;
+			}
+			off += l;
+		}
+	}
+
+	void *p = mmap(NULL, size, bReadOnly ? PROT_READ : PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (p == MAP_FAILED)
+	{
+		close(fd);
+		return false;
+	}
+
+	vFd = fd;
+	vpMem = (uint8_t*)p;
+	vTotalSize = TotalSize;
+	vSectSize = SectSize > 0 ? SectSize : 4;
+	vbReadOnly = bReadOnly;
+
+	if (pCacheBlk && NbCacheBlk > 0)
+	{
+		SetCache(pCacheBlk, NbCacheBlk);
+	}
+
+	return true;
+}
+
+void FlashImgDiskIO::Close()
+{
+	if (vpMem)
+	{
+		Flush();
+		munmap(vpMem, (size_t)vTotalSize * 1024);
+		vpMem = NULL;
+	}
+
+	if (vFd >= 0)
+	{
+		close(vFd);
+		vFd = -1;
+	}
+}
+
+const uint8_t *FlashImgDiskIO::MemMap()
+{
+	if (vpMem)
+	{
+		Flush();
+	}
+
+	return vpMem;
+}
+
+const uint8_t *FlashImgDiskIO::MemMap(uint64_t Offset, uint32_t Len)
+{
+	if (vpMem == NULL || Offset + Len > (uint64_t)vTotalSize * 1024)
+		return NULL;
+
+	Flush(Offset, Len);
+
+	return vpMem + Offset;
+}
+
+bool FlashImgDiskIO::SectRead(uint32_t SectNo, uint8_t *pBuff)
+{
+	uint64_t addr = (uint64_t)SectNo * DISKIO_SECT_SIZE;
+
+	if (vpMem == NULL || pBuff == NULL || addr + DISKIO_SECT_SIZE > (uint64_t)vTotalSize * 1024)
+		return false;
+
+	memcpy(pBuff, vpMem + addr, DISKIO_SECT_SIZE);
+
+	return true;
+}
+
+bool FlashImgDiskIO::SectWrite(uint32_t SectNo, uint8_t *pData)
+{
+	uint64_t addr = (uint64_t)SectNo * DISKIO_SECT_SIZE;
+
+	if (vpMem == NULL || vbReadOnly || pData == NULL ||
+		addr + DISKIO_SECT_SIZE > (uint64_t)vTotalSize * 1024)
+		return false;
+
+	memcpy(vpMem + addr, pData, DISKIO_SECT_SIZE);
+
+	return true;
+}
+
+void FlashImgDiskIO::Erase()
+{
+	if (vpMem == NULL || vbReadOnly)
+		return;
+
+	Reset();
+	memset(vpMem, 0xFF, (size_t)vTotalSize * 1024);
+	msync(vpMem, (size_t)vTotalSize * 1024, MS_ASYNC);
+}
+
+void FlashImgDiskIO::EraseSector(uint32_t SectNo, int NbSect)
+{
+	if (vpMem == NULL || vbReadOnly || NbSect <= 0)
+		return;
+
+	uint64_t addr = (uint64_t)SectNo * vSectSize * 1024;
+	uint64_t len = (uint64_t)NbSect * vSectSize * 1024;
+	uint64_t size = (uint64_t)vTotalSize * 1024;
+
+	if (addr >= size)
+		return;
+
+	if (addr + len > size)
+		len = size - addr;
+
+	// Drop cached sectors, their content is no longer valid
+	Reset();
+	memset(vpMem + addr, 0xFF, len);
+}
@@ -0,0 +1,389 @@
+/**-------------------------------------------------------------------------
+@file	dlog_decoder.cpp
+
+@brief	Host decoder for deferred log binary streams
+
+See dlog_decoder.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+
+#include "dlog_decoder.h"
+
+#define ELF_SHT_PROGBITS		1
+#define ELF_SHF_ALLOC			2
+
+static uint64_t GetLE(const uint8_t *p, int Len)
+{
+	uint64_t v = 0;
+
+	for (int i = Len - 1; i >= 0; i--)
+	{
+		v = (v << 8) | p[i];
+	}
+
+	return v;
+}
+
+DLogDecoder::DLogDecoder()
+{
+	vFmtSect = -1;
+	Reset();
+}
+
+void DLogDecoder::Reset()
+{
+	vBuf.clear();
+	vbSync = false;
+	vWordSize = sizeof(uint32_t);
+	vBias = 0;
+	vbTimeStamp = false;
+	vMsgCnt = 0;
+	vDropCnt = 0;
+	vErrCnt = 0;
+}
+
+bool DLogDecoder::LoadElf(const char *pFileName)
+{
+	FILE *fp = fopen(pFileName, "rb");
+
+	if (fp == NULL)
+	{
+		return false;
+	}
+
+	std::vector<uint8_t> img;
+	uint8_t b[4096];
+	size_t n;
+
+	while ((n = fread(b, 1, sizeof(b), fp)) > 0)
+	{
+		img.insert(img.end(), b, b + n);
+	}
+	fclose(fp);
+
+	vSect.clear();
+	vFmtSect = -1;
+
+	if (img.size() < 64 || memcmp(img.data(), "\x7f" "ELF", 4) != 0 || img[5] != 1)
+	{
+		// Not ELF or big endian
+		return false;
+	}
+
+	bool b64 = img[4] == 2;
+	uint64_t shoff = b64 ? GetLE(&img[0x28], 8) : GetLE(&img[0x20], 4);
+	size_t shentsize = GetLE(&img[b64 ? 0x3A : 0x2E], 2);
+	size_t shnum = GetLE(&img[b64 ? 0x3C : 0x30], 2);
+	size_t shstrndx = GetLE(&img[b64 ? 0x3E : 0x32], 2);
+
+	if (shentsize < (b64 ? 64U : 40U) || shstrndx >= shnum || shoff + shnum * shentsize > img.size())
+	{
+		return false;
+	}
+
+	const uint8_t *shstr = &img[shoff + shstrndx * shentsize];
+	uint64_t stroff = b64 ? GetLE(&shstr[24], 8) : GetLE(&shstr[16], 4);
+	uint64_t strsize = b64 ? GetLE(&shstr[32], 8) : GetLE(&shstr[20], 4);
+
+	if (stroff + strsize > img.size())
+	{
+		return false;
+	}
+
+	for (size_t i = 0; i < shnum; i++)
+	{
+		const uint8_t *sh = &img[shoff + i * shentsize];
+		uint32_t name = GetLE(sh, 4);
+		uint32_t type = GetLE(&sh[4], 4);
+		uint64_t flags = b64 ? GetLE(&sh[8], 8) : GetLE(&sh[8], 4);
+		uint64_t addr = b64 ? GetLE(&sh[16], 8) : GetLE(&sh[12], 4);
+		uint64_t off = b64 ? GetLE(&sh[24], 8) : GetLE(&sh[16], 4);
+		uint64_t size = b64 ? GetLE(&sh[32], 8) : GetLE(&sh[20], 4);
+
+		if (type != ELF_SHT_PROGBITS || (flags & ELF_SHF_ALLOC) == 0 || off + size > img.size() ||
+			name >= strsize)
+		{
+			continue;
+		}
+
+		SECT s;
+
+		s.Name.assign((const char*)&img[stroff + name], strnlen((const char*)&img[stroff + name], strsize - name));
+		s.Addr = addr;
+		s.Data.assign(&img[off], &img[off + size]);
+		if (s.Name == "dlog_fmt")
+		{
+			vFmtSect = vSect.size();
+		}
+		vSect.push_back(s);
+	}
+
+	return vFmtSect >= 0;
+}
+
+const char *DLogDecoder::ImageStr(uint64_t Addr)
+{
+	for (size_t i = 0; i < vSect.size(); i++)
+	{
+		const SECT &s = vSect[i];
+
+		if (Addr >= s.Addr && Addr < s.Addr + s.Data.size())
+		{
+			const char *p = (const char*)&s.Data[Addr - s.Addr];
+
+			// Must be terminated within section
+			return memchr(p, 0, s.Addr + s.Data.size() - Addr) ? p : NULL;
+		}
+	}
+
+	return NULL;
+}
+
+const char *DLogDecoder::StrCB(void *pCtx, DLOG_ARG Addr)
+{
+	DLogDecoder *dec = (DLogDecoder*)pCtx;
+
+	return dec->ImageStr(Addr - dec->vBias);
+}
+
+uint64_t DLogDecoder::Word(size_t Off)
+{
+	return GetLE(&vBuf[Off], vWordSize);
+}
+
+bool DLogDecoder::FindSync()
+{
+	static const uint8_t magic[4] = { 'D', 'L', 'O', 'G' };
+	size_t p = 0;
+
+	while (p + 4 <= vBuf.size())
+	{
+		const uint8_t *m = (const uint8_t*)memmem(&vBuf[p], vBuf.size() - p, magic, 4);
+
+		if (m == NULL)
+		{
+			break;
+		}
+
+		p = m - vBuf.data();
+
+		for (int w = 4; w <= 8; w += 4)
+		{
+			size_t start = p - (DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC) * w;
+
+			if (p < (size_t)(DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC) * w)
+			{
+				continue;
+			}
+			if (start + (DLOG_REC_HDRLEN + DLOG_SYNC_NBARG) * w > vBuf.size())
+			{
+				// Incomplete, wait for more data
+				size_t keep = (DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC) * 8;
+
+				vBuf.erase(vBuf.begin(), vBuf.begin() + (p > keep ? p - keep : 0));
+				return false;
+			}
+
+			vWordSize = w;
+			if (Word(start) == (DLOG_REC_MARK | (DLOG_SYNC_NBARG << 8) | (DLOG_REC_HDRLEN + DLOG_SYNC_NBARG)) &&
+				Word(start + 2 * w) == DLOG_FMTID_SYNC &&
+				Word(start + (DLOG_REC_HDRLEN + DLOG_SYNC_ARG_WORDSIZE) * w) == (uint64_t)w)
+			{
+				vBuf.erase(vBuf.begin(), vBuf.begin() + start);
+				vbSync = true;
+
+				return true;
+			}
+		}
+		p++;
+	}
+
+	// Keep what could be the start of a sync record
+	size_t keep = (DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC) * 8 + 3;
+
+	if (vBuf.size() > keep)
+	{
+		vBuf.erase(vBuf.begin(), vBuf.end() - keep);
+	}
+
+	return false;
+}
+
+void DLogDecoder::Message(const uint64_t *pRec, int NbArg, std::string &Out)
+{
+	char buf[512];
+	int len = 0;
+
+	if (vbTimeStamp)
+	{
+		len = snprintf(buf, sizeof(buf), "[%u] ", (unsigned)pRec[1]);
+	}
+
+	if ((uint32_t)pRec[2] == DLOG_FMTID_DROP)
+	{
+		snprintf(&buf[len], sizeof(buf) - len, "*** %u messages dropped\r\n", (unsigned)pRec[3]);
+		vDropCnt += pRec[3];
+		Out += buf;
+
+		return;
+	}
+
+	const SECT &fs = vSect[vFmtSect];
+	uint64_t id = pRec[2];
+	const char *pfmt = NULL;
+
+	if (id < fs.Data.size())
+	{
+		pfmt = memchr(&fs.Data[id], 0, fs.Data.size() - id) ? (const char*)&fs.Data[id] : NULL;
+	}
+	else
+	{
+		// Format string outside dlog_fmt, ex. forwarded from another log API.
+		// Id is its 32 bits offset from the section start
+		pfmt = ImageStr(fs.Addr + (int32_t)id);
+	}
+
+	if (pfmt == NULL)
+	{
+		vErrCnt++;
+		return;
+	}
+
+	std::string fmt(pfmt);
+	DLOG_ARG arg[DLOG_MAXARG];
+
+	if (vWordSize < (int)sizeof(long))
+	{
+		// long is target word size, remove modifiers so arguments are not widened
+		size_t p = 0;
+
+		while ((p = fmt.find('%', p)) != std::string::npos)
+		{
+			size_t q = fmt.find_first_not_of("-+ #0123456789.", p + 1);
+
+			while (q < fmt.size() && strchr("lztj", fmt[q]) && fmt[q] != 0)
+			{
+				fmt.erase(q, 1);
+			}
+			p = q < fmt.size() ? q + 1 : q;
+		}
+	}
+
+	for (int i = 0; i < NbArg; i++)
+	{
+		arg[i] = pRec[DLOG_REC_HDRLEN + i];
+	}
+
+	len += DLogFormat(&buf[len], sizeof(buf) - len, fmt.c_str(), NbArg, arg, StrCB, this);
+	Out += buf;
+	vMsgCnt++;
+}
+
+int DLogDecoder::Decode(const uint8_t *pData, int Len, std::string &Out)
+{
+	int cnt = 0;
+	size_t off = 0;
+
+	vBuf.insert(vBuf.end(), pData, pData + Len);
+
+	while (true)
+	{
+		if (vbSync == false)
+		{
+			vBuf.erase(vBuf.begin(), vBuf.begin() + off);
+			off = 0;
+			if (FindSync() == false)
+			{
+				break;
+			}
+		}
+
+		size_t w = vWordSize;
+
+		if (off + w > vBuf.size())
+		{
+			break;
+		}
+
+		uint64_t hdr = Word(off);
+		int len = hdr & 0xFF;
+		int nbarg = (hdr >> 8) & 0xF;
+
+		if ((hdr & ~0xFFFULL) != DLOG_REC_MARK || nbarg > DLOG_MAXARG || len != DLOG_REC_HDRLEN + nbarg)
+		{
+			// Corrupt, search for next sync
+			vErrCnt++;
+			vbSync = false;
+			off++;
+			continue;
+		}
+
+		if (off + len * w > vBuf.size())
+		{
+			break;
+		}
+
+		uint64_t rec[DLOG_REC_HDRLEN + DLOG_MAXARG];
+
+		for (int i = 0; i < len; i++)
+		{
+			rec[i] = Word(off + i * w);
+		}
+		off += len * w;
+
+		if ((uint32_t)rec[2] == DLOG_FMTID_SYNC)
+		{
+			if (nbarg >= DLOG_SYNC_NBARG && rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC] == DLOG_SYNC_MAGIC)
+			{
+				vBias = vFmtSect >= 0 ? rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_FMTADDR] - vSect[vFmtSect].Addr : 0;
+				vbTimeStamp = rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_FLAGS] & DLOG_SYNC_FLAG_TIMESTAMP;
+			}
+			continue;
+		}
+
+		if (vFmtSect < 0 && (uint32_t)rec[2] != DLOG_FMTID_DROP)
+		{
+			vErrCnt++;
+			continue;
+		}
+
+		Message(rec, nbarg, Out);
+		cnt++;
+	}
+
+	if (vbSync)
+	{
+		vBuf.erase(vBuf.begin(), vBuf.begin() + off);
+	}
+
+	return cnt;
+}
@@ -0,0 +1,216 @@
+/**-------------------------------------------------------------------------
+@file	esb_radio_sim.cpp
+
+@brief	Simulated Enhanced ShockBurst radio pair for Linux
+
+See esb_radio_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "esb_radio_sim.h"
+
+static uint16_t EsbRadioSimCrc(const std::vector<uint8_t> &Pkt)
+{
+	uint16_t crc = 0xFFFF;
+
+	for (size_t i = 0; i < Pkt.size(); i++)
+	{
+		crc = (crc >> 8) | (crc << 8);
+		crc ^= Pkt[i];
+		crc ^= (crc & 0xFF) >> 4;
+		crc ^= crc << 12;
+		crc ^= (crc & 0xFF) << 5;
+	}
+
+	return crc;
+}
+
+bool EsbRadioSim::Init(const ESBRADIOSIM_CFG &Cfg)
+{
+	if (Cfg.LossRate < 0.0 || Cfg.LossRate >= 1.0 || Cfg.NbRetry < 0 || Cfg.TxFifoSize <= 0)
+	{
+		return false;
+	}
+
+	vCfg = Cfg;
+	for (int i = 0; i < 2; i++)
+	{
+		vNode[i].TxFifo.clear();
+		vNode[i].TxCB = NULL;
+		vNode[i].RxCB = NULL;
+		vNode[i].pCtx = NULL;
+	}
+	vusTime = 0;
+	vRand = Cfg.Seed ? Cfg.Seed : 1;
+	vPid = 0;
+	vPrxLastPid = -1;
+	vPrxLastCrc = 0;
+	vbAckAttached = false;
+	vAttemptCnt = 0;
+	vFailCnt = 0;
+
+	return true;
+}
+
+void EsbRadioSim::SetCallback(int Node, ESBRADIOSIM_TXCB TxCB, ESBRADIOSIM_RXCB RxCB, void *pCtx)
+{
+	vNode[Node].TxCB = TxCB;
+	vNode[Node].RxCB = RxCB;
+	vNode[Node].pCtx = pCtx;
+}
+
+bool EsbRadioSim::Write(int Node, const uint8_t *pData, int Len)
+{
+	if (Len < 0 || Len > ESBRADIOSIM_PAYLOAD_MAX || (int)vNode[Node].TxFifo.size() >= vCfg.TxFifoSize)
+	{
+		return false;
+	}
+
+	vNode[Node].TxFifo.push_back(std::vector<uint8_t>(pData, pData + Len));
+
+	return true;
+}
+
+void EsbRadioSim::Flush(int Node)
+{
+	vNode[Node].TxFifo.clear();
+
+	if (Node == ESBRADIOSIM_NODE_PRX)
+	{
+		vbAckAttached = false;
+	}
+}
+
+bool EsbRadioSim::Lost()
+{
+	// xorshift32
+	vRand ^= vRand << 13;
+	vRand ^= vRand >> 17;
+	vRand ^= vRand << 5;
+
+	return (double)vRand / 4294967296.0 < vCfg.LossRate;
+}
+
+bool EsbRadioSim::Run()
+{
+	NODE &ptx = vNode[ESBRADIOSIM_NODE_PTX];
+	NODE &prx = vNode[ESBRADIOSIM_NODE_PRX];
+
+	if (ptx.TxFifo.empty())
+	{
+		return false;
+	}
+
+	// Callbacks may modify the FIFO
+	std::vector<uint8_t> pkt = ptx.TxFifo.front();
+	uint16_t crc = EsbRadioSimCrc(pkt);
+
+	vPid = (vPid + 1) & 3;
+
+	for (int retry = 0; retry <= vCfg.NbRetry; retry++)
+	{
+		uint32_t t = PktTimeUs(pkt.size());
+
+		vAttemptCnt++;
+
+		if (Lost() == false)
+		{
+			bool bnew = vPid != vPrxLastPid || crc != vPrxLastCrc;
+
+			if (bnew)
+			{
+				vPrxLastPid = vPid;
+				vPrxLastCrc = crc;
+
+				if (vbAckAttached)
+				{
+					// New packet means the PTX moved on, previous ACK payload
+					// is considered delivered
+					vbAckAttached = false;
+					prx.TxFifo.pop_front();
+					if (prx.TxCB)
+					{
+						prx.TxCB(prx.pCtx, true);
+					}
+				}
+			}
+
+			std::vector<uint8_t> ackpl;
+			bool backpl = prx.TxFifo.empty() == false;
+
+			if (backpl)
+			{
+				ackpl = prx.TxFifo.front();
+				vbAckAttached = true;
+			}
+
+			t += PktTimeUs(ackpl.size());
+
+			if (bnew && prx.RxCB)
+			{
+				prx.RxCB(prx.pCtx, pkt.data(), pkt.size());
+			}
+
+			if (Lost() == false)
+			{
+				vusTime += t;
+				if (ptx.TxFifo.empty() == false)
+				{
+					ptx.TxFifo.pop_front();
+				}
+				if (ptx.TxCB)
+				{
+					ptx.TxCB(ptx.pCtx, true);
+				}
+				if (backpl && ptx.RxCB)
+				{
+					ptx.RxCB(ptx.pCtx, ackpl.data(), ackpl.size());
+				}
+
+				return true;
+			}
+		}
+
+		vusTime += t > vCfg.RetrDelayUs ? t : vCfg.RetrDelayUs;
+	}
+
+	vFailCnt++;
+	if (ptx.TxFifo.empty() == false)
+	{
+		ptx.TxFifo.pop_front();
+	}
+	if (ptx.TxCB)
+	{
+		ptx.TxCB(ptx.pCtx, false);
+	}
+
+	return true;
+}
@@ -0,0 +1,175 @@
+/**-------------------------------------------------------------------------
+@file	ledmx_sim.cpp
+
+@brief	Simulated HT1632 LED matrix panels for Linux
+
+See ledmx_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "ledmx_sim.h"
+
+void LedMxSim::Reset()
+{
+	memset(vPanel, 0, sizeof(vPanel));
+	vSel = -1;
+	vBits.clear();
+	vTxBits = 0;
+	vTxCnt = 0;
+	vErrCnt = 0;
+}
+
+void LedMxSim::StartTx(int PanelAddr)
+{
+	if (PanelAddr < 0 || PanelAddr >= LEDMX_MAX_PANEL || vSel >= 0)
+	{
+		vErrCnt++;
+		return;
+	}
+
+	vSel = PanelAddr;
+	vBits.clear();
+}
+
+void LedMxSim::TxData(uint32_t Data, int NbBits)
+{
+	vTxBits += NbBits;
+
+	for (uint32_t mask = 1UL << (NbBits - 1); mask != 0; mask >>= 1)
+	{
+		vBits.push_back((Data & mask) ? 1 : 0);
+	}
+}
+
+void LedMxSim::StopTx(int PanelAddr)
+{
+	if (vSel != PanelAddr)
+	{
+		vErrCnt++;
+		vSel = -1;
+		return;
+	}
+
+	vTxCnt++;
+	Decode(vPanel[vSel]);
+	vSel = -1;
+}
+
+void LedMxSim::Decode(PANEL &Panel)
+{
+	size_t n = vBits.size();
+	size_t i = 3;
+
+	if (n < 3)
+	{
+		vErrCnt++;
+		return;
+	}
+
+	int id = (vBits[0] << 2) | (vBits[1] << 1) | vBits[2];
+
+	if (id == 4)
+	{
+		// 100 ccccccccx ccccccccx ...
+		if (n == 3 || (n - 3) % 9 != 0)
+		{
+			vErrCnt++;
+			return;
+		}
+		for (; i < n; i += 9)
+		{
+			int cmd = 0;
+
+			for (int b = 0; b < 8; b++)
+			{
+				cmd = (cmd << 1) | vBits[i + b];
+			}
+			switch (cmd)
+			{
+				case 0x00: Panel.bSysEn = false; break;
+				case 0x01: Panel.bSysEn = true; break;
+				case 0x02: Panel.bLedOn = false; break;
+				case 0x03: Panel.bLedOn = true; break;
+			}
+			Panel.CmdCnt++;
+		}
+	}
+	else if (id == 5)
+	{
+		// 101 aaaaaaa dddd dddd ...
+		if (n < 10 || (n - 10) % 4 != 0)
+		{
+			vErrCnt++;
+			return;
+		}
+
+		int addr = 0;
+
+		for (; i < 10; i++)
+		{
+			addr = (addr << 1) | vBits[i];
+		}
+		for (; i < n; i += 4)
+		{
+			Panel.Ram[addr % LEDMXSIM_RAM_SIZE] = (vBits[i] << 3) | (vBits[i + 1] << 2) |
+												  (vBits[i + 2] << 1) | vBits[i + 3];
+			addr++;
+		}
+	}
+	else
+	{
+		vErrCnt++;
+	}
+}
+
+extern "C" {
+
+void LedMxIOInit(LEDMXDEV *pLedMxDev, LEDMXCFG *pCfg)
+{
+	pLedMxDev->pIODev = pCfg->pIOCfg;
+}
+
+void LedMxStartTx(LEDMXDEV *pDev, int PanelAddr)
+{
+	((LedMxSim*)pDev->pIODev)->StartTx(PanelAddr);
+}
+
+void LedMxStopTx(LEDMXDEV *pDev, int PanelAddr)
+{
+	((LedMxSim*)pDev->pIODev)->StopTx(PanelAddr);
+}
+
+void LedMxTxData(LEDMXDEV *pDev, uint32_t Data, int NbBits)
+{
+	((LedMxSim*)pDev->pIODev)->TxData(Data, NbBits);
+}
+
+}
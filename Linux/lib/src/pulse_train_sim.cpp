@@ -0,0 +1,120 @@
+/**-------------------------------------------------------------------------
+@file	pulse_train_sim.cpp
+
+@brief	Simulated pulse train hardware link for Linux
+
+See pulse_train_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include "pulse_train_sim.h"
+
+bool PulseTrainHwLinkSim::Init(Timer * const pTimer, int Depth, std::vector<PULSE_TRAIN_SIMEVT> *pLog)
+{
+	if (pTimer == NULL || Depth <= 0 || Depth > PULSE_TRAIN_HWLINK_MAXDEPTH)
+	{
+		return false;
+	}
+
+	vpTimer = pTimer;
+	vDepth = Depth;
+	vHead = 0;
+	vCnt = 0;
+	vpLog = pLog;
+
+	return true;
+}
+
+void PulseTrainHwLinkSim::Flush()
+{
+	if (vpTimer == NULL)
+	{
+		return;
+	}
+
+	uint64_t now = vpTimer->TickCount();
+
+	// Compare channels fire in tick order
+	while (vCnt > 0 && vSlot[vHead].Tick <= now)
+	{
+		if (vpLog)
+		{
+			vpLog->push_back(vSlot[vHead]);
+		}
+		vHead = vHead + 1 < vDepth ? vHead + 1 : 0;
+		vCnt--;
+	}
+}
+
+int PulseTrainHwLinkSim::Avail()
+{
+	Flush();
+
+	return vDepth - vCnt;
+}
+
+bool PulseTrainHwLinkSim::Arm(uint64_t Tick, uint32_t HiMask, uint32_t LoMask)
+{
+	Flush();
+
+	// Compare on current tick would be missed
+	if (vCnt >= vDepth || Tick <= vpTimer->TickCount())
+	{
+		return false;
+	}
+
+	int idx = vHead + vCnt;
+	PULSE_TRAIN_SIMEVT *p = &vSlot[idx < vDepth ? idx : idx - vDepth];
+
+	p->Tick = Tick;
+	p->HiMask = HiMask;
+	p->LoMask = LoMask;
+	p->bHw = true;
+	vCnt++;
+
+	return true;
+}
+
+void PulseTrainHwLinkSim::Disarm()
+{
+	Flush();
+
+	vHead = 0;
+	vCnt = 0;
+}
+
+void PulseTrainSchedSim::Output(uint32_t HiMask, uint32_t LoMask)
+{
+	if (vpLog)
+	{
+		PULSE_TRAIN_SIMEVT evt = { vpTimer->TickCount(), HiMask, LoMask, false };
+
+		vpLog->push_back(evt);
+	}
+}
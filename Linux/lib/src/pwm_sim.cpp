@@ -0,0 +1,318 @@
+/**-------------------------------------------------------------------------
+@file	pwm_sim.cpp
+
+@brief	Simulated PWM peripheral for Linux
+
+See pwm_sim.h
+
+The pwm.h API is the nRF52 driver itself, built over the simulated registers.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "nrf.h"
+#include "pwm_sim.h"
+
+PwmSimTask &PwmSimTask::operator=(uint32_t Val)
+{
+	if (Val)
+	{
+		vpSim->Task(vTaskNo);
+	}
+
+	return *this;
+}
+
+PwmSim::PwmSim()
+{
+	TASKS_STOP.Init(this, PWMSIM_TASK_STOP);
+	TASKS_SEQSTART[0].Init(this, PWMSIM_TASK_SEQSTART0);
+	TASKS_SEQSTART[1].Init(this, PWMSIM_TASK_SEQSTART1);
+	vIrqHandler = NULL;
+	vIrqLatency = 0;
+	vbRecord = false;
+	Reset();
+}
+
+void PwmSim::Reset()
+{
+	EVENTS_STOPPED = 0;
+	EVENTS_SEQSTARTED[0] = EVENTS_SEQSTARTED[1] = 0;
+	EVENTS_SEQEND[0] = EVENTS_SEQEND[1] = 0;
+	EVENTS_PWMPERIODEND = 0;
+	EVENTS_LOOPSDONE = 0;
+	SHORTS = 0;
+	INTEN = 0;
+	ENABLE = 0;
+	MODE = 0;
+	COUNTERTOP = 0x3FF;
+	PRESCALER = 0;
+	DECODER = 0;
+	LOOP = 0;
+	memset(SEQ, 0, sizeof(SEQ));
+	memset(&PSEL, 0xFF, sizeof(PSEL));
+	vbRun = false;
+	vbPlaying = false;
+	vCur = 0;
+	vElem = 0;
+	vRefreshLeft = 0;
+	vLoopCnt = 0;
+	memset(vOut, 0, sizeof(vOut));
+	vbRefillPending[0] = vbRefillPending[1] = false;
+	vbIrqPending = false;
+	vIrqDue = 0;
+	vPeriodCnt = 0;
+	vIrqCnt = 0;
+	vLateCnt = 0;
+	vReadCnt = 0;
+	vOutput.clear();
+}
+
+void PwmSim::Task(int TaskNo)
+{
+	switch (TaskNo)
+	{
+		case PWMSIM_TASK_STOP:
+			Stop();
+			break;
+		case PWMSIM_TASK_SEQSTART0:
+			SeqStart(0);
+			break;
+		case PWMSIM_TASK_SEQSTART1:
+			SeqStart(1);
+			break;
+	}
+}
+
+void PwmSim::Event(volatile uint32_t &Evt, uint32_t IntMsk)
+{
+	Evt = 1;
+
+	if ((INTEN & IntMsk) && vbIrqPending == false)
+	{
+		vbIrqPending = true;
+		vIrqDue = vPeriodCnt + vIrqLatency;
+	}
+}
+
+void PwmSim::Halt()
+{
+	vbRun = false;
+	vbPlaying = false;
+	Event(EVENTS_STOPPED, PWM_INTEN_STOPPED_Msk);
+}
+
+void PwmSim::Play(int SeqNo)
+{
+	vCur = SeqNo;
+	vElem = 0;
+	vRefreshLeft = 0;
+	vbPlaying = true;
+	Event(EVENTS_SEQSTARTED[SeqNo], SeqNo ? PWM_INTEN_SEQSTARTED1_Msk : PWM_INTEN_SEQSTARTED0_Msk);
+}
+
+void PwmSim::SeqStart(int SeqNo)
+{
+	vbRun = true;
+	vLoopCnt = LOOP;
+	Play(SeqNo & 1);
+}
+
+void PwmSim::Stop()
+{
+	if (vbRun || vbPlaying)
+	{
+		Halt();
+	}
+	else
+	{
+		Event(EVENTS_STOPPED, PWM_INTEN_STOPPED_Msk);
+	}
+}
+
+void PwmSim::SeqEnd()
+{
+	int cur = vCur;
+	uint32_t msk = cur ? PWM_INTEN_SEQEND1_Msk : PWM_INTEN_SEQEND0_Msk;
+
+	vbPlaying = false;
+	if (INTEN & msk)
+	{
+		vbRefillPending[cur] = true;
+	}
+	Event(EVENTS_SEQEND[cur], msk);
+
+	if (SHORTS & (cur ? PWM_SHORTS_SEQEND1_STOP_Msk : PWM_SHORTS_SEQEND0_STOP_Msk))
+	{
+		Halt();
+		return;
+	}
+
+	if (LOOP == 0)
+	{
+		// Keep generating last value
+		return;
+	}
+
+	if (cur == 0)
+	{
+		Play(1);
+		return;
+	}
+
+	if (vLoopCnt > 0)
+	{
+		vLoopCnt--;
+	}
+	if (vLoopCnt > 0)
+	{
+		Play(0);
+		return;
+	}
+
+	Event(EVENTS_LOOPSDONE, PWM_INTEN_LOOPSDONE_Msk);
+
+	if (SHORTS & (PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk | PWM_SHORTS_LOOPSDONE_SEQSTART1_Msk))
+	{
+		vLoopCnt = LOOP;
+		Play(SHORTS & PWM_SHORTS_LOOPSDONE_SEQSTART0_Msk ? 0 : 1);
+	}
+	else if (SHORTS & PWM_SHORTS_LOOPSDONE_STOP_Msk)
+	{
+		Halt();
+	}
+}
+
+void PwmSim::Run(uint64_t NbPeriod)
+{
+	for (uint64_t n = 0; ; n++)
+	{
+		if (vbIrqPending && vIrqHandler && vPeriodCnt >= vIrqDue)
+		{
+			vbIrqPending = false;
+			vbRefillPending[0] = vbRefillPending[1] = false;
+			vIrqCnt++;
+			vIrqHandler();
+		}
+
+		if (n >= NbPeriod)
+		{
+			break;
+		}
+
+		if (vbPlaying && vRefreshLeft == 0)
+		{
+			// EasyDMA load of next element
+			if (vElem == 0 && vbRefillPending[vCur])
+			{
+				vLateCnt++;
+			}
+			memcpy(vOut, &((const uint16_t*)SEQ[vCur].PTR)[vElem * PWMSIM_MAX_CHAN], sizeof(vOut));
+			vReadCnt += PWMSIM_MAX_CHAN;
+			vRefreshLeft = SEQ[vCur].REFRESH + 1;
+		}
+
+		if (vbRecord)
+		{
+			for (int i = 0; i < PWMSIM_MAX_CHAN; i++)
+			{
+				vOutput.push_back(vbRun ? vOut[i] : PWMSIM_IDLE);
+			}
+		}
+
+		vPeriodCnt++;
+
+		if (vbRun)
+		{
+			Event(EVENTS_PWMPERIODEND, PWM_INTEN_PWMPERIODEND_Msk);
+		}
+
+		if (vbPlaying && --vRefreshLeft == 0)
+		{
+			vElem++;
+			if (vElem * PWMSIM_MAX_CHAN >= SEQ[vCur].CNT)
+			{
+				SeqEnd();
+			}
+		}
+	}
+}
+
+bool PwmSim::RunToStop(uint64_t MaxPeriod)
+{
+	while (vbRun && MaxPeriod > 0)
+	{
+		Run(1);
+		MaxPeriod--;
+	}
+
+	// Run pending interrupt now, PWM is idle
+	vIrqDue = vPeriodCnt;
+	Run(0);
+
+	return vbRun == false;
+}
+
+PwmSim g_PwmSim[PWMSIM_MAX_DEV];
+
+PwmSim *PwmSimDevice(int DevNo)
+{
+	if (DevNo < 0 || DevNo >= PWMSIM_MAX_DEV)
+	{
+		return NULL;
+	}
+
+	return &g_PwmSim[DevNo];
+}
+
+//
+// pwm.h implementation, the nRF52 driver over the simulated registers
+//
+
+#include "../../../ARM/Nordic/nRF52/src/pwm_nrf52.cpp"
+
+static const PWMSIM_IRQHANDLER s_PwmSimIrqVect[PWMSIM_MAX_DEV] = {
+	PWM0_IRQHandler, PWM1_IRQHandler, PWM2_IRQHandler
+};
+
+void NVIC_EnableIRQ(IRQn_Type IRQn)
+{
+	g_PwmSim[IRQn].SetIrqHandler(s_PwmSimIrqVect[IRQn]);
+}
+
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	g_PwmSim[IRQn].SetIrqHandler(NULL);
+}
+
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	g_PwmSim[IRQn].ClearPendingIrq();
+}
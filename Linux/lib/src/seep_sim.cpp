@@ -0,0 +1,271 @@
+/**-------------------------------------------------------------------------
+@file	seep_sim.cpp
+
+@brief	I2C Serial EEPROM simulator for Linux
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdlib.h>
+#include <string.h>
+
+#include "seep_sim.h"
+
+using namespace std::chrono;
+
+static void SeepSimDisable(DEVINTRF * const pDev) {}
+static void SeepSimEnable(DEVINTRF * const pDev) {}
+static int SeepSimGetRate(DEVINTRF * const pDev) { return ((SeepSim*)pDev->pDevData)->Rate(); }
+static int SeepSimSetRate(DEVINTRF * const pDev, int Rate) { return ((SeepSim*)pDev->pDevData)->Rate(Rate); }
+static bool SeepSimStartRx(DEVINTRF * const pDev, int DevAddr) { return ((SeepSim*)pDev->pDevData)->StartRx(DevAddr); }
+static int SeepSimRxData(DEVINTRF * const pDev, uint8_t *pBuff, int BuffLen) { return ((SeepSim*)pDev->pDevData)->RxData(pBuff, BuffLen); }
+static void SeepSimStopRx(DEVINTRF * const pDev) { ((SeepSim*)pDev->pDevData)->StopRx(); }
+static bool SeepSimStartTx(DEVINTRF * const pDev, int DevAddr) { return ((SeepSim*)pDev->pDevData)->StartTx(DevAddr); }
+static int SeepSimTxData(DEVINTRF * const pDev, uint8_t *pData, int DataLen) { return ((SeepSim*)pDev->pDevData)->TxData(pData, DataLen); }
+static void SeepSimStopTx(DEVINTRF * const pDev) { ((SeepSim*)pDev->pDevData)->StopTx(); }
+static void SeepSimReset(DEVINTRF * const pDev) {}
+static void SeepSimPowerOff(DEVINTRF * const pDev) {}
+
+SeepSim::SeepSim() : vDevIntrf()
+{
+	memset(&vCfg, 0, sizeof(vCfg));
+	vpMem = NULL;
+	vpPage = NULL;
+	vpPageWrCnt = NULL;
+	vRate = 400000;
+	vbStuck = false;
+	ResetCounters();
+}
+
+SeepSim::~SeepSim()
+{
+	free(vpMem);
+	free(vpPage);
+	free(vpPageWrCnt);
+}
+
+bool SeepSim::Init(const SEEP_CFG &Cfg)
+{
+	if (Cfg.PageSize == 0 || Cfg.PageSize > 256 || Cfg.Size == 0)
+	{
+		return false;
+	}
+
+	vCfg = Cfg;
+
+	free(vpMem);
+	free(vpPage);
+	free(vpPageWrCnt);
+
+	vpMem = (uint8_t*)malloc(Cfg.Size);
+	vpPage = (uint8_t*)malloc(Cfg.PageSize);
+	vpPageWrCnt = (uint32_t*)calloc(Cfg.Size / Cfg.PageSize, sizeof(uint32_t));
+
+	if (vpMem == NULL || vpPage == NULL || vpPageWrCnt == NULL)
+	{
+		return false;
+	}
+
+	memset(vpMem, 0xFF, Cfg.Size);
+
+	vDevIntrf.pDevData = this;
+	vDevIntrf.Type = DEVINTRF_TYPE_I2C;
+	vDevIntrf.MaxRetry = 0;
+	vDevIntrf.Disable = SeepSimDisable;
+	vDevIntrf.Enable = SeepSimEnable;
+	vDevIntrf.GetRate = SeepSimGetRate;
+	vDevIntrf.SetRate = SeepSimSetRate;
+	vDevIntrf.StartRx = SeepSimStartRx;
+	vDevIntrf.RxData = SeepSimRxData;
+	vDevIntrf.StopRx = SeepSimStopRx;
+	vDevIntrf.StartTx = SeepSimStartTx;
+	vDevIntrf.TxData = SeepSimTxData;
+	vDevIntrf.StopTx = SeepSimStopTx;
+	vDevIntrf.Reset = SeepSimReset;
+	vDevIntrf.PowerOff = SeepSimPowerOff;
+	atomic_flag_clear(&vDevIntrf.bBusy);
+
+	vAddr = 0;
+	vbAck = false;
+	vBusyUntil = steady_clock::now();
+	ResetCounters();
+
+	return true;
+}
+
+bool SeepSim::IsBusy()
+{
+	return steady_clock::now() < vBusyUntil;
+}
+
+// Memory address with block select bits from device address
+uint32_t SeepSim::MemAddr(int DevAddr, uint32_t Addr)
+{
+	uint32_t shift = vCfg.AddrLen << 3;
+
+	if (shift < 32 && (vCfg.Size >> shift) > 1)
+	{
+		Addr |= (uint32_t)(DevAddr & 7) << shift;
+	}
+
+	return Addr % vCfg.Size;
+}
+
+bool SeepSim::StartRx(int DevAddr)
+{
+	vBusBytes++;
+
+	// Restart from a write sequence, address only, nothing to write
+	memset(vDirty, 0, sizeof(vDirty));
+
+	if ((DevAddr & ~7) != (vCfg.DevAddr & ~7) || IsBusy() || vbStuck)
+	{
+		vbAck = false;
+		vNackCnt++;
+
+		return false;
+	}
+
+	vbAck = true;
+
+	return true;
+}
+
+int SeepSim::RxData(uint8_t *pBuff, int BuffLen)
+{
+	if (vbAck == false)
+	{
+		return 0;
+	}
+
+	for (int i = 0; i < BuffLen; i++)
+	{
+		// Sequential read rolls over at end of memory
+		pBuff[i] = vpMem[vAddr];
+		vAddr = (vAddr + 1) % vCfg.Size;
+	}
+
+	vBusBytes += BuffLen;
+
+	return BuffLen;
+}
+
+void SeepSim::StopRx(void)
+{
+	vbAck = false;
+}
+
+bool SeepSim::StartTx(int DevAddr)
+{
+	vBusBytes++;
+
+	memset(vDirty, 0, sizeof(vDirty));
+	vAddrIdx = 0;
+
+	if ((DevAddr & ~7) != (vCfg.DevAddr & ~7) || IsBusy() || vbStuck)
+	{
+		vbAck = false;
+		vNackCnt++;
+
+		return false;
+	}
+
+	vbAck = true;
+	vDevAddr = DevAddr;
+	vAddr = 0;
+
+	return true;
+}
+
+int SeepSim::TxData(uint8_t *pData, int DataLen)
+{
+	if (vbAck == false)
+	{
+		return 0;
+	}
+
+	int cnt = 0;
+
+	// Memory address MSB first
+	while (vAddrIdx < vCfg.AddrLen && cnt < DataLen)
+	{
+		vAddr = (vAddr << 8) | pData[cnt++];
+		vAddrIdx++;
+
+		if (vAddrIdx == vCfg.AddrLen)
+		{
+			vAddr = MemAddr(vDevAddr, vAddr);
+			vPageAddr = vAddr - (vAddr % vCfg.PageSize);
+			memcpy(vpPage, &vpMem[vPageAddr], vCfg.PageSize);
+		}
+	}
+
+	// Data is latched in page buffer.  Address counter wraps around within page
+	while (cnt < DataLen)
+	{
+		uint32_t off = vAddr % vCfg.PageSize;
+
+		vpPage[off] = pData[cnt++];
+		vDirty[off >> 3] |= 1 << (off & 7);
+		vAddr = vPageAddr + ((off + 1) % vCfg.PageSize);
+	}
+
+	vBusBytes += cnt;
+
+	return cnt;
+}
+
+void SeepSim::StopTx(void)
+{
+	bool dirty = false;
+
+	if (vbAck == false)
+	{
+		return;
+	}
+
+	vbAck = false;
+
+	for (int i = 0; i < vCfg.PageSize; i++)
+	{
+		if (vDirty[i >> 3] & (1 << (i & 7)))
+		{
+			vpMem[vPageAddr + i] = vpPage[i];
+			dirty = true;
+		}
+	}
+
+	if (dirty)
+	{
+		// Stop condition starts internal write cycle
+		vWrCycles++;
+		vpPageWrCnt[vPageAddr / vCfg.PageSize]++;
+		vBusyUntil = steady_clock::now() + milliseconds(vCfg.WrDelay);
+		memset(vDirty, 0, sizeof(vDirty));
+	}
+}
@@ -0,0 +1,246 @@
+/**-------------------------------------------------------------------------
+@file	serial_sim.cpp
+
+@brief	Simulated serial link pair with error injection for Linux
+
+See serial_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+
+#include "serial_sim.h"
+
+static void SerialSimDisable(DEVINTRF * const pDevIntrf) {}
+static void SerialSimEnable(DEVINTRF * const pDevIntrf) {}
+static int SerialSimGetRate(DEVINTRF * const pDevIntrf) { return 0; }
+static int SerialSimSetRate(DEVINTRF * const pDevIntrf, int Rate) { return 0; }
+static bool SerialSimStartRx(DEVINTRF * const pDevIntrf, int DevAddr) { return true; }
+static void SerialSimStopRx(DEVINTRF * const pDevIntrf) {}
+static bool SerialSimStartTx(DEVINTRF * const pDevIntrf, int DevAddr) { return true; }
+static void SerialSimStopTx(DEVINTRF * const pDevIntrf) {}
+static void SerialSimReset(DEVINTRF * const pDevIntrf) {}
+static void SerialSimPowerOff(DEVINTRF * const pDevIntrf) {}
+
+bool SerialSim::Init(const SERIALSIM_CFG &Cfg)
+{
+	if (Cfg.ByteRate == 0 || Cfg.TxFifoSize <= 0 || Cfg.RxFifoSize <= 0 || Cfg.Ber < 0.0 ||
+		Cfg.DropRate < 0.0 || (Cfg.bPacket && Cfg.PacketMax <= 0))
+	{
+		return false;
+	}
+
+	vCfg = Cfg;
+	vusTime = 0;
+	vRand = Cfg.Seed ? Cfg.Seed : 1;
+	vErrCnt = 0;
+	vDropCnt = 0;
+	vOvrCnt = 0;
+
+	for (int i = 0; i < 2; i++)
+	{
+		PORT &p = vPort[i];
+
+		p.DevIntrf.pDevData = &p;
+		p.DevIntrf.IntPrio = 0;
+		p.DevIntrf.EvtCB = NULL;
+		p.DevIntrf.MaxRetry = 0;
+		p.DevIntrf.bDma = false;
+		p.DevIntrf.Type = DEVINTRF_TYPE_UART;
+		p.DevIntrf.Disable = SerialSimDisable;
+		p.DevIntrf.Enable = SerialSimEnable;
+		p.DevIntrf.GetRate = SerialSimGetRate;
+		p.DevIntrf.SetRate = SerialSimSetRate;
+		p.DevIntrf.StartRx = SerialSimStartRx;
+		p.DevIntrf.RxData = RxData;
+		p.DevIntrf.StopRx = SerialSimStopRx;
+		p.DevIntrf.StartTx = SerialSimStartTx;
+		p.DevIntrf.TxData = TxData;
+		p.DevIntrf.StopTx = SerialSimStopTx;
+		p.DevIntrf.Reset = SerialSimReset;
+		p.DevIntrf.PowerOff = SerialSimPowerOff;
+		p.DevIntrf.EnCnt = 1;
+		atomic_flag_clear(&p.DevIntrf.bBusy);
+		p.pSim = this;
+		p.Idx = i;
+		p.TxFifo.clear();
+		p.RxFifo.clear();
+		p.TxCnt = 0;
+		p.Credit = 0;
+	}
+
+	return true;
+}
+
+uint32_t SerialSim::Rand()
+{
+	// xorshift32
+	vRand ^= vRand << 13;
+	vRand ^= vRand >> 17;
+	vRand ^= vRand << 5;
+
+	return vRand;
+}
+
+/**
+ * @brief	Apply bit errors.
+ *
+ * @return	true - data was corrupted
+ */
+bool SerialSim::Corrupt(std::vector<uint8_t> &Data)
+{
+	if (vCfg.Ber <= 0.0)
+	{
+		return false;
+	}
+
+	bool bErr = false;
+	double lnq = log(1.0 - vCfg.Ber);
+	size_t nbbits = Data.size() * 8;
+
+	// Geometric skip to next bit error
+	for (size_t bit = 0; ; bit++)
+	{
+		double u = (Rand() + 1.0) / 4294967297.0;
+
+		bit += (size_t)(log(u) / lnq);
+		if (bit >= nbbits)
+		{
+			break;
+		}
+		Data[bit >> 3] ^= 1 << (bit & 7);
+		bErr = true;
+	}
+
+	return bErr;
+}
+
+int SerialSim::RxData(DEVINTRF * const pDevIntrf, uint8_t *pBuff, int BuffLen)
+{
+	PORT *p = (PORT*)pDevIntrf->pDevData;
+	int cnt = 0;
+
+	if (p->pSim->vCfg.bPacket)
+	{
+		if (p->RxFifo.empty() || BuffLen <= 0)
+		{
+			return 0;
+		}
+
+		std::vector<uint8_t> &pkt = p->RxFifo.front();
+
+		cnt = (int)pkt.size() < BuffLen ? pkt.size() : BuffLen;
+		memcpy(pBuff, pkt.data(), cnt);
+		p->RxFifo.pop_front();
+
+		return cnt;
+	}
+
+	while (cnt < BuffLen && p->RxFifo.empty() == false)
+	{
+		pBuff[cnt++] = p->RxFifo.front()[0];
+		p->RxFifo.pop_front();
+	}
+
+	return cnt;
+}
+
+int SerialSim::TxData(DEVINTRF * const pDevIntrf, uint8_t *pData, int DataLen)
+{
+	PORT *p = (PORT*)pDevIntrf->pDevData;
+	SERIALSIM_CFG &cfg = p->pSim->vCfg;
+	int cnt = 0;
+
+	if (cfg.bPacket)
+	{
+		if (DataLen <= 0 || DataLen > cfg.PacketMax || p->TxCnt >= cfg.TxFifoSize)
+		{
+			return 0;
+		}
+		p->TxFifo.push_back(std::vector<uint8_t>(pData, pData + DataLen));
+		p->TxCnt++;
+
+		return DataLen;
+	}
+
+	while (cnt < DataLen && p->TxCnt < cfg.TxFifoSize)
+	{
+		p->TxFifo.push_back(std::vector<uint8_t>(1, pData[cnt++]));
+		p->TxCnt++;
+	}
+
+	return cnt;
+}
+
+void SerialSim::Advance(uint32_t Us)
+{
+	vusTime += Us;
+
+	for (int i = 0; i < 2; i++)
+	{
+		PORT &src = vPort[i];
+		PORT &dst = vPort[i ^ 1];
+
+		src.Credit += (double)Us * vCfg.ByteRate / 1000000.0;
+
+		while (src.TxFifo.empty() == false && src.Credit >= src.TxFifo.front().size())
+		{
+			std::vector<uint8_t> d = src.TxFifo.front();
+
+			src.Credit -= d.size();
+			src.TxFifo.pop_front();
+			src.TxCnt--;
+
+			if (vCfg.DropRate > 0.0 && Rand() < vCfg.DropRate * 4294967296.0)
+			{
+				vDropCnt++;
+				continue;
+			}
+
+			if (Corrupt(d))
+			{
+				vErrCnt++;
+			}
+
+			if ((int)dst.RxFifo.size() >= vCfg.RxFifoSize)
+			{
+				vOvrCnt++;
+				continue;
+			}
+			dst.RxFifo.push_back(d);
+		}
+
+		if (src.TxFifo.empty())
+		{
+			// Idle wire does not store credit
+			src.Credit = 0;
+		}
+	}
+}
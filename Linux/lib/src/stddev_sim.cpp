@@ -0,0 +1,251 @@
+/**-------------------------------------------------------------------------
+@file	stddev_sim.cpp
+
+@brief	Simulated stdio devices for Linux
+
+See stddev_sim.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "stddev_sim.h"
+
+bool SerialStdDevSim::Init(StdDevSimClock *pClock, uint32_t BytePeriodUs, int TxFifoSize, int RxFifoSize, bool bBlocking)
+{
+	if (pClock == NULL || BytePeriodUs == 0 || TxFifoSize <= 0 || RxFifoSize <= 0)
+	{
+		return false;
+	}
+
+	memset(&vDev, 0, sizeof(vDev));
+	strcpy(vDev.Name, "SER");
+	vDev.pDevObj = this;
+	vDev.Read = Read;
+	vDev.Write = Write;
+	vDev.Poll = Poll;
+
+	vpClock = pClock;
+	vBytePeriod = BytePeriodUs;
+	vTxFifoSize = TxFifoSize;
+	vRxFifoSize = RxFifoSize;
+	vbBlocking = bBlocking;
+	vTxEnd = 0;
+	vRxLine.clear();
+	vRxFifo.clear();
+	vTxData.clear();
+	vBlockedUs = 0;
+	vRxDropCnt = 0;
+
+	return true;
+}
+
+void SerialStdDevSim::RxInject(uint64_t usTime, const char *pData, int Len)
+{
+	for (int i = 0; i < Len; i++)
+	{
+		vRxLine.push_back(std::make_pair(usTime + (i + 1) * vBytePeriod, (uint8_t)pData[i]));
+	}
+}
+
+void SerialStdDevSim::Update()
+{
+	while (vRxLine.empty() == false && vRxLine.front().first <= vpClock->usTime())
+	{
+		if ((int)vRxFifo.size() < vRxFifoSize)
+		{
+			vRxFifo.push_back(vRxLine.front().second);
+		}
+		else
+		{
+			vRxDropCnt++;
+		}
+		vRxLine.pop_front();
+	}
+}
+
+int SerialStdDevSim::TxAvail()
+{
+	uint64_t t = vpClock->usTime();
+	int used = vTxEnd > t ? (vTxEnd - t + vBytePeriod - 1) / vBytePeriod : 0;
+
+	return vTxFifoSize - used;
+}
+
+int SerialStdDevSim::Read(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len)
+{
+	SerialStdDevSim *dev = (SerialStdDevSim*)pDevObj;
+
+	dev->Update();
+
+	if (dev->vRxFifo.empty() && dev->vbBlocking && dev->vRxLine.empty() == false)
+	{
+		// Wait for next byte
+		uint64_t t = dev->vpClock->usTime();
+
+		dev->vpClock->AdvanceTo(dev->vRxLine.front().first);
+		dev->vBlockedUs += dev->vpClock->usTime() - t;
+		dev->Update();
+	}
+
+	if (dev->vRxFifo.empty())
+	{
+		return -1;
+	}
+
+	size_t cnt = 0;
+
+	while (cnt < Len && dev->vRxFifo.empty() == false)
+	{
+		pBuff[cnt++] = dev->vRxFifo.front();
+		dev->vRxFifo.pop_front();
+	}
+
+	return cnt;
+}
+
+int SerialStdDevSim::Write(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len)
+{
+	SerialStdDevSim *dev = (SerialStdDevSim*)pDevObj;
+	size_t cnt = 0;
+
+	while (cnt < Len)
+	{
+		int n = dev->TxAvail();
+
+		n = n < (int)(Len - cnt) ? n : Len - cnt;
+		if (n > 0)
+		{
+			uint64_t t = dev->vpClock->usTime();
+
+			dev->vTxEnd = (dev->vTxEnd > t ? dev->vTxEnd : t) + (uint64_t)n * dev->vBytePeriod;
+			dev->vTxData.append((const char*)&pBuff[cnt], n);
+			cnt += n;
+		}
+		if (cnt >= Len || dev->vbBlocking == false)
+		{
+			break;
+		}
+
+		// Wait for one byte to go out
+		dev->vpClock->Advance(dev->vBytePeriod);
+		dev->vBlockedUs += dev->vBytePeriod;
+	}
+
+	return cnt;
+}
+
+int SerialStdDevSim::Poll(void * const pDevObj, int Handle, int Events)
+{
+	SerialStdDevSim *dev = (SerialStdDevSim*)pDevObj;
+	int ev = 0;
+
+	dev->Update();
+	if (dev->vRxFifo.empty() == false)
+	{
+		ev |= STDDEV_POLLIN;
+	}
+	if (dev->TxAvail() > 0)
+	{
+		ev |= STDDEV_POLLOUT;
+	}
+
+	return ev & Events;
+}
+
+bool FileStdDevSim::Init(StdDevSimClock *pClock, size_t Size, uint32_t AccessUs, uint32_t BytesPerUs)
+{
+	if (pClock == NULL || BytesPerUs == 0)
+	{
+		return false;
+	}
+
+	memset(&vDev, 0, sizeof(vDev));
+	strcpy(vDev.Name, "FAT:");
+	vDev.pDevObj = this;
+	vDev.Open = Open;
+	vDev.Close = Close;
+	vDev.Read = Read;
+	vDev.Seek = Seek;
+
+	vpClock = pClock;
+	vData.resize(Size);
+	for (size_t i = 0; i < Size; i++)
+	{
+		vData[i] = (uint8_t)(i * 7 + (i >> 8) + 3);
+	}
+	vOffset = 0;
+	vAccessUs = AccessUs;
+	vBytesPerUs = BytesPerUs;
+	vBusyUs = 0;
+
+	return true;
+}
+
+int FileStdDevSim::Open(void * const pDevObj, const char *pDevName, int Flags, int Mode)
+{
+	((FileStdDevSim*)pDevObj)->vOffset = 0;
+
+	return 0;
+}
+
+int FileStdDevSim::Close(void * const pDevObj, int Handle)
+{
+	return 0;
+}
+
+int FileStdDevSim::Read(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len)
+{
+	FileStdDevSim *dev = (FileStdDevSim*)pDevObj;
+	size_t l = dev->vData.size() - dev->vOffset;
+
+	l = l < Len ? l : Len;
+	memcpy(pBuff, &dev->vData[dev->vOffset], l);
+	dev->vOffset += l;
+
+	uint64_t t = dev->vAccessUs + l / dev->vBytesPerUs;
+
+	dev->vpClock->Advance(t);
+	dev->vBusyUs += t;
+
+	return l;
+}
+
+int FileStdDevSim::Seek(void * const pDevObj, int Handle, int Offset)
+{
+	FileStdDevSim *dev = (FileStdDevSim*)pDevObj;
+
+	if (Offset < 0 || (size_t)Offset > dev->vData.size())
+	{
+		return -1;
+	}
+	dev->vOffset = Offset;
+
+	return Offset;
+}
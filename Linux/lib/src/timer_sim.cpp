@@ -0,0 +1,209 @@
+/**-------------------------------------------------------------------------
+@file	timer_sim.cpp
+
+@brief	Simulated timer for Linux
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "timer_sim.h"
+
+TimerSim::TimerSim()
+{
+	vbEnabled = false;
+	vTick = 0;
+	vIrqCnt = 0;
+	vLatMin = 0;
+	vLatMax = 0;
+	vLatSeed = 1;
+	vFreq = 0;
+	vnsPeriod = 0;
+	vEvtHandler = NULL;
+	memset(vCC, 0, sizeof(vCC));
+	memset(vPeriod, 0, sizeof(vPeriod));
+	memset(vTrigger, 0, sizeof(vTrigger));
+}
+
+TimerSim::~TimerSim()
+{
+}
+
+bool TimerSim::Init(const TIMER_CFG &Cfg)
+{
+	vDevNo = Cfg.DevNo;
+	vEvtHandler = Cfg.EvtHandler;
+	vTick = 0;
+	vIrqCnt = 0;
+	vRollover = 0;
+	vLastCount = 0;
+
+	Frequency(Cfg.Freq);
+
+	vbEnabled = true;
+
+	return true;
+}
+
+uint32_t TimerSim::Frequency(uint32_t Freq)
+{
+	vFreq = Freq > 0 ? Freq : 1000000;
+	vnsPeriod = 1000000000ULL / (uint64_t)vFreq;
+
+	return vFreq;
+}
+
+uint64_t TimerSim::EnableTimerTrigger(int TrigNo, uint64_t nsPeriod, TIMER_TRIG_TYPE Type,
+									  TIMER_TRIGCB const Handler, void * const pContext)
+{
+	if (TrigNo < 0 || TrigNo >= TIMER_SIM_MAX_TRIGGER_EVT)
+	{
+		return 0;
+	}
+
+	uint64_t cc = (nsPeriod * vFreq + 500000000ULL) / 1000000000ULL;
+
+	if (cc == 0)
+	{
+		return 0;
+	}
+
+	vPeriod[TrigNo] = cc;
+	vCC[TrigNo] = vTick + cc;
+	vTrigger[TrigNo].Type = Type;
+	vTrigger[TrigNo].nsPeriod = cc * 1000000000ULL / vFreq;
+	vTrigger[TrigNo].Handler = Handler;
+	vTrigger[TrigNo].pContext = pContext;
+
+	return vTrigger[TrigNo].nsPeriod;
+}
+
+void TimerSim::DisableTimerTrigger(int TrigNo)
+{
+	if (TrigNo < 0 || TrigNo >= TIMER_SIM_MAX_TRIGGER_EVT)
+	{
+		return;
+	}
+
+	vCC[TrigNo] = 0;
+	vPeriod[TrigNo] = 0;
+	vTrigger[TrigNo].Type = TIMER_TRIG_TYPE_SINGLE;
+	vTrigger[TrigNo].Handler = NULL;
+	vTrigger[TrigNo].pContext = NULL;
+	vTrigger[TrigNo].nsPeriod = 0;
+}
+
+int TimerSim::FindAvailTimerTrigger(void)
+{
+	for (int i = 0; i < TIMER_SIM_MAX_TRIGGER_EVT; i++)
+	{
+		if (vTrigger[i].nsPeriod == 0)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+int TimerSim::NextTrigger()
+{
+	int idx = -1;
+
+	for (int i = 0; i < TIMER_SIM_MAX_TRIGGER_EVT; i++)
+	{
+		if (vCC[i] != 0 && (idx < 0 || vCC[i] < vCC[idx]))
+		{
+			idx = i;
+		}
+	}
+
+	return idx;
+}
+
+void TimerSim::Fire(int TrigNo)
+{
+	uint64_t lat = vLatMin;
+
+	if (vLatMax > vLatMin)
+	{
+		vLatSeed = vLatSeed * 1664525UL + 1013904223UL;
+		lat += (vLatSeed >> 8) % (vLatMax - vLatMin + 1);
+	}
+
+	vTick = (vCC[TrigNo] > vTick ? vCC[TrigNo] : vTick) + lat;
+	vIrqCnt++;
+
+	if (vTrigger[TrigNo].Type == TIMER_TRIG_TYPE_CONTINUOUS)
+	{
+		vCC[TrigNo] += vPeriod[TrigNo];
+	}
+	else
+	{
+		vCC[TrigNo] = 0;
+	}
+
+	if (vTrigger[TrigNo].Handler)
+	{
+		vTrigger[TrigNo].Handler(this, TrigNo, vTrigger[TrigNo].pContext);
+	}
+
+	if (vEvtHandler)
+	{
+		vEvtHandler(this, TIMER_EVT_TRIGGER(TrigNo));
+	}
+}
+
+void TimerSim::Advance(uint64_t NbTick)
+{
+	uint64_t end = vTick + NbTick;
+	int idx;
+
+	while (vbEnabled && (idx = NextTrigger()) >= 0 && vCC[idx] <= end)
+	{
+		Fire(idx);
+	}
+
+	// Handlers may have run past the end
+	vTick = vTick > end ? vTick : end;
+}
+
+bool TimerSim::AdvanceToTrigger()
+{
+	int idx = NextTrigger();
+
+	if (vbEnabled == false || idx < 0)
+	{
+		return false;
+	}
+
+	Fire(idx);
+
+	return true;
+}
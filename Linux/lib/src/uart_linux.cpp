@@ -0,0 +1,868 @@
+/**-------------------------------------------------------------------------
+@file	uart_linux.cpp
+
+@brief	Linux UART device implementation.
+
+See uart_linux.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/ioctl.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <asm/termbits.h>
+#include <linux/serial.h>
+
+#include "uart_linux.h"
+
+static_assert(sizeof(struct termios2) <= sizeof(((LINUXUARTDEV*)0)->OrigAttr), "OrigAttr too small");
+
+static LINUXUARTDEV s_LinuxUartDev[LINUXUART_MAXDEV];
+
+static inline void LinuxUARTWake(LINUXUARTDEV * const pDev)
+{
+	uint64_t v = 1;
+
+	if (write(pDev->hWakeEvt, &v, sizeof(v)) < 0)
+	{
+		// Counter saturated, thread is already signaled
+	}
+}
+
+static inline void LinuxUARTLineStateEvt(LINUXUARTDEV * const pDev)
+{
+	if (pDev->pUartDev->EvtCallback)
+	{
+		uint8_t buff = (uint8_t)pDev->pUartDev->LineState;
+
+		pDev->pUartDev->EvtCallback(pDev->pUartDev, UART_EVT_LINESTATE, &buff, 1);
+	}
+}
+
+/**
+ * @brief	Detach from a port that hung up (USB unplugged, pty master closed).
+ *
+ * Hangup is level triggered and cannot be masked, the descriptor is removed
+ * from the epoll set until the interface is enabled again.
+ */
+static void LinuxUARTHangup(LINUXUARTDEV * const pDev)
+{
+	if (pDev->EpollEvt == 0xffffffffU)
+	{
+		return;
+	}
+
+	epoll_ctl(pDev->hEpoll, EPOLL_CTL_DEL, pDev->hDevFile, NULL);
+	pDev->EpollEvt = 0xffffffffU;
+	pDev->pUartDev->LineState &= ~(UART_LINESTATE_DCD | UART_LINESTATE_DSR);
+	LinuxUARTLineStateEvt(pDev);
+}
+
+/**
+ * @brief	Report framing, parity & overrun errors counted by the serial driver.
+ */
+static void LinuxUARTCheckErr(LINUXUARTDEV * const pDev)
+{
+	struct serial_icounter_struct ic;
+
+	if (pDev->bICount == false || ioctl(pDev->hDevFile, TIOCGICOUNT, &ic) < 0)
+	{
+		return;
+	}
+
+	uint32_t state = 0;
+
+	if ((uint32_t)ic.frame != pDev->FrameErrCnt)
+	{
+		state |= UART_LINESTATE_FRMERR;
+	}
+	if ((uint32_t)ic.parity != pDev->ParityErrCnt)
+	{
+		state |= UART_LINESTATE_PARERR;
+	}
+	if ((uint32_t)(ic.overrun + ic.buf_overrun) != pDev->OverrunCnt)
+	{
+		state |= UART_LINESTATE_OVR;
+		pDev->pUartDev->RxOECnt += ic.overrun + ic.buf_overrun - pDev->OverrunCnt;
+	}
+
+	if (state)
+	{
+		pDev->ErrCnt += ic.frame + ic.parity + ic.overrun + ic.buf_overrun -
+						pDev->FrameErrCnt - pDev->ParityErrCnt - pDev->OverrunCnt;
+		pDev->FrameErrCnt = ic.frame;
+		pDev->ParityErrCnt = ic.parity;
+		pDev->OverrunCnt = ic.overrun + ic.buf_overrun;
+		pDev->pUartDev->LineState = (pDev->pUartDev->LineState & ~(UART_LINESTATE_FRMERR |
+									 UART_LINESTATE_PARERR | UART_LINESTATE_OVR)) | state;
+		LinuxUARTLineStateEvt(pDev);
+	}
+}
+
+/**
+ * @brief	Move received data from driver to Rx FIFO.
+ *
+ * Reads no more than the FIFO can take so nothing is ever dropped.
+ */
+static void LinuxUARTRead(LINUXUARTDEV * const pDev)
+{
+	uint8_t buff[LINUXUART_BUFF_SIZE];
+	HCFIFO hfifo = pDev->pUartDev->hRxFifo;
+
+	pthread_mutex_lock(&pDev->RxLock);
+	int l = CFifoAvail(hfifo);
+	pthread_mutex_unlock(&pDev->RxLock);
+
+	if (l <= 0)
+	{
+		return;
+	}
+
+	l = l < (int)sizeof(buff) ? l : (int)sizeof(buff);
+
+	int n = read(pDev->hDevFile, buff, l);
+
+	pDev->RxSysCnt++;
+
+	if (n <= 0)
+	{
+		if (n == 0 || errno == EIO)
+		{
+			LinuxUARTHangup(pDev);
+		}
+		return;
+	}
+
+	pthread_mutex_lock(&pDev->RxLock);
+	uint8_t *s = buff;
+	int cnt = n;
+	while (cnt > 0)
+	{
+		int len = cnt;
+		uint8_t *p = CFifoPutMultiple(hfifo, &len);
+		if (p == NULL)
+		{
+			break;
+		}
+		memcpy(p, s, len);
+		s += len;
+		cnt -= len;
+	}
+	int used = CFifoUsed(hfifo);
+	pthread_mutex_unlock(&pDev->RxLock);
+
+	pDev->RxCnt += n;
+
+	LinuxUARTCheckErr(pDev);
+
+	if (pDev->pUartDev->EvtCallback)
+	{
+		// A short read means the driver buffer is empty, the line is idle
+		pDev->pUartDev->EvtCallback(pDev->pUartDev, n < l ? UART_EVT_RXTIMEOUT : UART_EVT_RXDATA, NULL, used);
+	}
+}
+
+/**
+ * @brief	Send Tx cache then Tx FIFO content until the driver refuses.
+ *
+ * Must be called with TxLock owned.
+ *
+ * @return	Number of bytes accepted by the driver
+ */
+static int LinuxUARTSend(LINUXUARTDEV * const pDev)
+{
+	HCFIFO hfifo = pDev->pUartDev->hTxFifo;
+	int cnt = 0;
+
+	while (true)
+	{
+		if (pDev->TxCacheOff >= pDev->TxCacheLen)
+		{
+			// Transfer to cache before sending as CFifo releases the memory
+			// immediately and the driver may only take part of it.
+			pDev->TxCacheLen = 0;
+			pDev->TxCacheOff = 0;
+
+			while (pDev->TxCacheLen < LINUXUART_BUFF_SIZE)
+			{
+				int l = LINUXUART_BUFF_SIZE - pDev->TxCacheLen;
+				uint8_t *p = CFifoGetMultiple(hfifo, &l);
+				if (p == NULL)
+				{
+					break;
+				}
+				memcpy(&pDev->TxCache[pDev->TxCacheLen], p, l);
+				pDev->TxCacheLen += l;
+			}
+
+			if (pDev->TxCacheLen == 0)
+			{
+				pDev->pUartDev->bTxReady = true;
+				break;
+			}
+		}
+
+		int l = pDev->TxCacheLen - pDev->TxCacheOff;
+		int n = write(pDev->hDevFile, &pDev->TxCache[pDev->TxCacheOff], l);
+
+		pDev->TxSysCnt++;
+
+		if (n <= 0)
+		{
+			break;
+		}
+
+		pDev->TxCacheOff += n;
+		pDev->TxCnt += n;
+		cnt += n;
+
+		if (n < l)
+		{
+			// Driver buffer full
+			break;
+		}
+	}
+
+	return cnt;
+}
+
+static void LinuxUARTWrite(LINUXUARTDEV * const pDev)
+{
+	pthread_mutex_lock(&pDev->TxLock);
+	int cnt = LinuxUARTSend(pDev);
+	int avail = CFifoAvail(pDev->pUartDev->hTxFifo);
+	pthread_mutex_unlock(&pDev->TxLock);
+
+	if (cnt > 0 && pDev->pUartDev->EvtCallback)
+	{
+		pDev->pUartDev->EvtCallback(pDev->pUartDev, UART_EVT_TXREADY, NULL, avail);
+	}
+}
+
+/**
+ * @brief	Arm epoll with the events the FIFO states allow.
+ *
+ * Readable is only waited for when Rx FIFO has room and writable only when
+ * there is something to send, otherwise level triggered epoll would spin.
+ */
+static void LinuxUARTArm(LINUXUARTDEV * const pDev)
+{
+	if (pDev->EpollEvt == 0xffffffffU)
+	{
+		return;
+	}
+
+	uint32_t evt = 0;
+
+	pthread_mutex_lock(&pDev->RxLock);
+	if (CFifoAvail(pDev->pUartDev->hRxFifo) > 0)
+	{
+		evt |= EPOLLIN;
+	}
+	else
+	{
+		// Data pending in driver, RxData will wake us up
+		pDev->pUartDev->bRxReady = true;
+	}
+	pthread_mutex_unlock(&pDev->RxLock);
+
+	pthread_mutex_lock(&pDev->TxLock);
+	if (pDev->TxCacheOff < pDev->TxCacheLen || CFifoUsed(pDev->pUartDev->hTxFifo) > 0)
+	{
+		evt |= EPOLLOUT;
+	}
+	pthread_mutex_unlock(&pDev->TxLock);
+
+	if (evt != pDev->EpollEvt)
+	{
+		struct epoll_event e;
+
+		e.events = evt;
+		e.data.fd = pDev->hDevFile;
+		epoll_ctl(pDev->hEpoll, EPOLL_CTL_MOD, pDev->hDevFile, &e);
+		pDev->EpollEvt = evt;
+	}
+}
+
+/**
+ * @brief	I/O thread, stands in for the UART interrupt handler.
+ */
+static void *LinuxUARTThread(void *pArg)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pArg;
+	struct epoll_event evt[2];
+
+	while (dev->bRun)
+	{
+		LinuxUARTArm(dev);
+
+		int n = epoll_wait(dev->hEpoll, evt, 2, -1);
+
+		if (n < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		for (int i = 0; i < n; i++)
+		{
+			if (evt[i].data.fd == dev->hWakeEvt)
+			{
+				uint64_t v;
+
+				if (read(dev->hWakeEvt, &v, sizeof(v)) < 0)
+				{
+					continue;
+				}
+				// Application queued Tx data
+				LinuxUARTWrite(dev);
+				continue;
+			}
+
+			if (evt[i].events & EPOLLIN)
+			{
+				LinuxUARTRead(dev);
+			}
+			if (evt[i].events & EPOLLOUT)
+			{
+				LinuxUARTWrite(dev);
+			}
+			if ((evt[i].events & (EPOLLHUP | EPOLLERR)) && !(evt[i].events & EPOLLIN))
+			{
+				LinuxUARTHangup(dev);
+			}
+		}
+	}
+
+	return NULL;
+}
+
+static int LinuxUARTApplyRate(LINUXUARTDEV * const pDev, int Rate)
+{
+	struct termios2 t;
+
+	if (ioctl(pDev->hDevFile, TCGETS2, &t) < 0)
+	{
+		return 0;
+	}
+
+	if (Rate > 0)
+	{
+		// BOTHER takes any rate, the driver picks the closest divisor
+		t.c_cflag &= ~CBAUD;
+		t.c_cflag |= BOTHER;
+		t.c_ispeed = Rate;
+		t.c_ospeed = Rate;
+
+		if (ioctl(pDev->hDevFile, TCSETS2, &t) < 0 || ioctl(pDev->hDevFile, TCGETS2, &t) < 0)
+		{
+			return 0;
+		}
+	}
+
+	return t.c_ospeed;
+}
+
+/**
+ * @brief	Open & configure port from UARTDEV settings, then start I/O thread.
+ */
+static bool LinuxUARTOpen(LINUXUARTDEV * const pDev)
+{
+	UARTDEV *uartdev = pDev->pUartDev;
+	struct termios2 t;
+
+	pDev->hDevFile = open(pDev->DevPath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+	if (pDev->hDevFile < 0)
+	{
+		return false;
+	}
+
+	// Exclusive access, prevents additional opens except by root
+	if (ioctl(pDev->hDevFile, TIOCEXCL) < 0 || ioctl(pDev->hDevFile, TCGETS2, &t) < 0)
+	{
+		close(pDev->hDevFile);
+		pDev->hDevFile = -1;
+		return false;
+	}
+
+	if (pDev->bOrigValid == false)
+	{
+		memcpy(pDev->OrigAttr, &t, sizeof(t));
+		pDev->bOrigValid = true;
+	}
+
+	// Raw mode
+	t.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF | IXANY | INPCK);
+	t.c_oflag &= ~OPOST;
+	t.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+	t.c_cflag &= ~(CSIZE | PARENB | PARODD | CMSPAR | CSTOPB | CRTSCTS);
+	t.c_cflag |= CREAD | CLOCAL;
+	t.c_cc[VMIN] = 0;
+	t.c_cc[VTIME] = 0;
+
+	switch (uartdev->DataBits)
+	{
+		case 5:
+			t.c_cflag |= CS5;
+			break;
+		case 6:
+			t.c_cflag |= CS6;
+			break;
+		case 7:
+			t.c_cflag |= CS7;
+			break;
+		default:
+			t.c_cflag |= CS8;
+	}
+
+	switch (uartdev->Parity)
+	{
+		case UART_PARITY_ODD:
+			t.c_cflag |= PARENB | PARODD;
+			break;
+		case UART_PARITY_EVEN:
+			t.c_cflag |= PARENB;
+			break;
+		case UART_PARITY_MARK:
+			t.c_cflag |= PARENB | PARODD | CMSPAR;
+			break;
+		case UART_PARITY_SPACE:
+			t.c_cflag |= PARENB | CMSPAR;
+			break;
+		default:
+			break;
+	}
+	if (t.c_cflag & PARENB)
+	{
+		t.c_iflag |= INPCK;
+	}
+
+	if (uartdev->StopBits > 1)
+	{
+		t.c_cflag |= CSTOPB;
+	}
+
+	if (uartdev->FlowControl == UART_FLWCTRL_HW)
+	{
+		t.c_cflag |= CRTSCTS;
+	}
+	else if (uartdev->FlowControl == UART_FLWCTRL_XONXOFF)
+	{
+		t.c_iflag |= IXON | IXOFF;
+	}
+
+	if (uartdev->Rate > 0)
+	{
+		t.c_cflag &= ~CBAUD;
+		t.c_cflag |= BOTHER;
+		t.c_ispeed = uartdev->Rate;
+		t.c_ospeed = uartdev->Rate;
+	}
+
+	if (ioctl(pDev->hDevFile, TCSETS2, &t) < 0)
+	{
+		close(pDev->hDevFile);
+		pDev->hDevFile = -1;
+		return false;
+	}
+
+	uartdev->Rate = LinuxUARTApplyRate(pDev, 0);
+
+	// Low latency : serial driver pushes received data without waiting for
+	// its flip buffer timer. Not all drivers support it (pty, some USB).
+	struct serial_struct ser;
+
+	if (ioctl(pDev->hDevFile, TIOCGSERIAL, &ser) == 0)
+	{
+		ser.flags |= ASYNC_LOW_LATENCY;
+		ioctl(pDev->hDevFile, TIOCSSERIAL, &ser);
+	}
+
+	struct serial_icounter_struct ic;
+
+	pDev->bICount = ioctl(pDev->hDevFile, TIOCGICOUNT, &ic) == 0;
+	if (pDev->bICount)
+	{
+		pDev->FrameErrCnt = ic.frame;
+		pDev->ParityErrCnt = ic.parity;
+		pDev->OverrunCnt = ic.overrun + ic.buf_overrun;
+	}
+
+	ioctl(pDev->hDevFile, TCFLSH, TCIOFLUSH);
+
+	pDev->TxCacheLen = 0;
+	pDev->TxCacheOff = 0;
+	uartdev->bRxReady = false;
+	uartdev->bTxReady = true;
+	uartdev->LineState = UART_LINESTATE_DCD | UART_LINESTATE_DSR;
+
+	pDev->hEpoll = epoll_create1(EPOLL_CLOEXEC);
+	pDev->hWakeEvt = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	struct epoll_event e;
+
+	e.events = EPOLLIN;
+	e.data.fd = pDev->hWakeEvt;
+	epoll_ctl(pDev->hEpoll, EPOLL_CTL_ADD, pDev->hWakeEvt, &e);
+
+	e.events = EPOLLIN;
+	e.data.fd = pDev->hDevFile;
+	epoll_ctl(pDev->hEpoll, EPOLL_CTL_ADD, pDev->hDevFile, &e);
+	pDev->EpollEvt = EPOLLIN;
+
+	pDev->bRun = true;
+	pDev->bThread = pthread_create(&pDev->hThread, NULL, LinuxUARTThread, pDev) == 0;
+
+	if (pDev->bThread == false)
+	{
+		close(pDev->hWakeEvt);
+		close(pDev->hEpoll);
+		close(pDev->hDevFile);
+		pDev->hDevFile = -1;
+		return false;
+	}
+
+	return true;
+}
+
+static void LinuxUARTClose(LINUXUARTDEV * const pDev)
+{
+	if (pDev->bThread)
+	{
+		pDev->bRun = false;
+		LinuxUARTWake(pDev);
+		pthread_join(pDev->hThread, NULL);
+		pDev->bThread = false;
+		close(pDev->hWakeEvt);
+		close(pDev->hEpoll);
+	}
+
+	if (pDev->hDevFile >= 0)
+	{
+		close(pDev->hDevFile);
+		pDev->hDevFile = -1;
+	}
+}
+
+static int LinuxUARTGetRate(DEVINTRF * const pDev)
+{
+	return ((LINUXUARTDEV *)pDev->pDevData)->pUartDev->Rate;
+}
+
+static int LinuxUARTSetRate(DEVINTRF * const pDev, int Rate)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->pDevData;
+
+	if (dev->hDevFile >= 0)
+	{
+		Rate = LinuxUARTApplyRate(dev, Rate);
+	}
+	dev->pUartDev->Rate = Rate;
+
+	return Rate;
+}
+
+static inline bool LinuxUARTStartRx(DEVINTRF * const pDev, int DevAddr) {
+	return true;
+}
+
+static int LinuxUARTRxData(DEVINTRF * const pDev, uint8_t *pBuff, int Bufflen)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->pDevData;
+	bool bwake = false;
+	int cnt = 0;
+
+	pthread_mutex_lock(&dev->RxLock);
+	while (Bufflen > 0)
+	{
+		int l = Bufflen;
+		uint8_t *p = CFifoGetMultiple(dev->pUartDev->hRxFifo, &l);
+		if (p == NULL)
+		{
+			break;
+		}
+		memcpy(pBuff, p, l);
+		cnt += l;
+		pBuff += l;
+		Bufflen -= l;
+	}
+	if (cnt > 0 && dev->pUartDev->bRxReady)
+	{
+		// Room again, resume reading from driver
+		dev->pUartDev->bRxReady = false;
+		bwake = true;
+	}
+	pthread_mutex_unlock(&dev->RxLock);
+
+	if (bwake)
+	{
+		LinuxUARTWake(dev);
+	}
+
+	return cnt;
+}
+
+static inline void LinuxUARTStopRx(DEVINTRF * const pDev) {
+}
+
+static inline bool LinuxUARTStartTx(DEVINTRF * const pDev, int DevAddr) {
+	return true;
+}
+
+static int LinuxUARTTxData(DEVINTRF * const pDev, uint8_t *pData, int Datalen)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->pDevData;
+	bool bwake = false;
+	int cnt = 0;
+
+	if (dev->hDevFile < 0)
+	{
+		return 0;
+	}
+
+	pthread_mutex_lock(&dev->TxLock);
+
+	while (Datalen > 0)
+	{
+		int l = Datalen;
+		uint8_t *p = CFifoPutMultiple(dev->pUartDev->hTxFifo, &l);
+		if (p == NULL)
+		{
+			break;
+		}
+		memcpy(p, pData, l);
+		Datalen -= l;
+		pData += l;
+		cnt += l;
+
+		if (dev->pUartDev->bTxReady)
+		{
+			dev->pUartDev->bTxReady = false;
+			bwake = true;
+		}
+	}
+
+	if (bwake && dev->bThread && pthread_equal(pthread_self(), dev->hThread))
+	{
+		// Called from an event handler, send now as the Tx interrupt would.
+		// The thread re-arms for whatever the driver could not take.
+		LinuxUARTSend(dev);
+		bwake = false;
+	}
+
+	pthread_mutex_unlock(&dev->TxLock);
+
+	if (bwake)
+	{
+		LinuxUARTWake(dev);
+	}
+
+	return cnt;
+}
+
+static inline void LinuxUARTStopTx(DEVINTRF * const pDev) {
+}
+
+static void LinuxUARTDisable(DEVINTRF * const pDev)
+{
+	LinuxUARTClose((LINUXUARTDEV *)pDev->pDevData);
+}
+
+static void LinuxUARTEnable(DEVINTRF * const pDev)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->pDevData;
+
+	if (dev->hDevFile < 0)
+	{
+		CFifoFlush(dev->pUartDev->hTxFifo);
+		LinuxUARTOpen(dev);
+	}
+}
+
+static void LinuxUARTPowerOff(DEVINTRF * const pDev)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->pDevData;
+
+	LinuxUARTClose(dev);
+
+	// Give the port back the way we found it
+	if (dev->bOrigValid)
+	{
+		int fd = open(dev->DevPath, O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+		if (fd >= 0)
+		{
+			ioctl(fd, TCSETS2, dev->OrigAttr);
+			close(fd);
+		}
+	}
+}
+
+void UARTSetCtrlLineState(UARTDEV * const pDev, uint32_t LineState)
+{
+	LINUXUARTDEV *dev = (LINUXUARTDEV *)pDev->DevIntrf.pDevData;
+	int bits = 0;
+
+	if (dev == NULL || dev->hDevFile < 0)
+	{
+		return;
+	}
+
+	if (LineState & UART_LINESTATE_DTR)
+	{
+		bits |= TIOCM_DTR;
+	}
+	if (LineState & UART_LINESTATE_RTS)
+	{
+		bits |= TIOCM_RTS;
+	}
+
+	int clr = (TIOCM_DTR | TIOCM_RTS) & ~bits;
+
+	ioctl(dev->hDevFile, TIOCMBIS, &bits);
+	ioctl(dev->hDevFile, TIOCMBIC, &clr);
+}
+
+UARTDEV * const UARTGetInstance(int DevNo)
+{
+	if (DevNo < 0 || DevNo >= LINUXUART_MAXDEV)
+	{
+		return NULL;
+	}
+
+	return s_LinuxUartDev[DevNo].pUartDev;
+}
+
+bool UARTInit(UARTDEV * const pDev, const UARTCFG *pCfg)
+{
+	if (pDev == NULL || pCfg == NULL || pCfg->pIOPinMap == NULL || pCfg->NbIOPins <= 0 ||
+		pCfg->NbIOPins > LINUXUART_DEVPATH_MAXLEN)
+	{
+		return false;
+	}
+
+	if (pCfg->DevNo < 0 || pCfg->DevNo >= LINUXUART_MAXDEV)
+	{
+		return false;
+	}
+
+	LINUXUARTDEV *dev = &s_LinuxUartDev[pCfg->DevNo];
+
+	if (dev->pUartDev != NULL)
+	{
+		// Re-init, release previous port
+		LinuxUARTClose(dev);
+	}
+	else
+	{
+		pthread_mutex_init(&dev->RxLock, NULL);
+		pthread_mutex_init(&dev->TxLock, NULL);
+	}
+
+	dev->DevNo = pCfg->DevNo;
+	dev->hDevFile = -1;
+	dev->bThread = false;
+	dev->bOrigValid = false;
+	dev->RxCnt = 0;
+	dev->TxCnt = 0;
+	dev->RxSysCnt = 0;
+	dev->TxSysCnt = 0;
+	dev->ErrCnt = 0;
+	memcpy(dev->DevPath, pCfg->pIOPinMap, pCfg->NbIOPins);
+	dev->DevPath[pCfg->NbIOPins] = 0;
+
+	if (pCfg->pRxMem && pCfg->RxMemSize > 0)
+	{
+		pDev->hRxFifo = CFifoInit(pCfg->pRxMem, pCfg->RxMemSize, 1, pCfg->bFifoBlocking);
+	}
+	else
+	{
+		pDev->hRxFifo = CFifoInit(dev->RxFifoMem, LINUXUART_CFIFO_SIZE, 1, pCfg->bFifoBlocking);
+	}
+
+	if (pCfg->pTxMem && pCfg->TxMemSize > 0)
+	{
+		pDev->hTxFifo = CFifoInit(pCfg->pTxMem, pCfg->TxMemSize, 1, pCfg->bFifoBlocking);
+	}
+	else
+	{
+		pDev->hTxFifo = CFifoInit(dev->TxFifoMem, LINUXUART_CFIFO_SIZE, 1, pCfg->bFifoBlocking);
+	}
+
+	pDev->DevIntrf.pDevData = dev;
+	dev->pUartDev = pDev;
+
+	pDev->Mode = pCfg->Mode;
+	pDev->Duplex = pCfg->Duplex;
+	pDev->Rate = pCfg->Rate;
+	pDev->DataBits = pCfg->DataBits;
+	pDev->Parity = pCfg->Parity;
+	pDev->StopBits = pCfg->StopBits;
+	pDev->FlowControl = pCfg->FlowControl;
+	pDev->bIrDAFixPulse = pCfg->bIrDAFixPulse;
+	pDev->bIrDAInvert = pCfg->bIrDAInvert;
+	pDev->bIrDAMode = pCfg->bIrDAMode;
+	pDev->IrDAPulseDiv = pCfg->IrDAPulseDiv;
+	pDev->bIntMode = pCfg->bIntMode;
+	pDev->EvtCallback = pCfg->EvtCallback;
+	pDev->RxOECnt = 0;
+
+	if (LinuxUARTOpen(dev) == false)
+	{
+		dev->pUartDev = NULL;
+		pDev->DevIntrf.pDevData = NULL;
+		return false;
+	}
+
+	pDev->DevIntrf.Type = DEVINTRF_TYPE_UART;
+	pDev->DevIntrf.bDma = false;
+	pDev->DevIntrf.Disable = LinuxUARTDisable;
+	pDev->DevIntrf.Enable = LinuxUARTEnable;
+	pDev->DevIntrf.GetRate = LinuxUARTGetRate;
+	pDev->DevIntrf.SetRate = LinuxUARTSetRate;
+	pDev->DevIntrf.StartRx = LinuxUARTStartRx;
+	pDev->DevIntrf.RxData = LinuxUARTRxData;
+	pDev->DevIntrf.StopRx = LinuxUARTStopRx;
+	pDev->DevIntrf.StartTx = LinuxUARTStartTx;
+	pDev->DevIntrf.TxData = LinuxUARTTxData;
+	pDev->DevIntrf.StopTx = LinuxUARTStopTx;
+	pDev->DevIntrf.MaxRetry = UART_RETRY_MAX;
+	pDev->DevIntrf.PowerOff = LinuxUARTPowerOff;
+	pDev->DevIntrf.EnCnt = 1;
+	atomic_flag_clear(&pDev->DevIntrf.bBusy);
+
+	return true;
+}
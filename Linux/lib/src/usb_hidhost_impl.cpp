@@ -0,0 +1,712 @@
+/**-------------------------------------------------------------------------
+@file	usb_hidhost_impl.cpp
+
+@brief	Generic class of Host side USB HID device access
+		Implementation class for Linux hidraw
+
+See usb_hidhost_impl.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <dirent.h>
+#include <poll.h>
+#include <time.h>
+#include <sys/ioctl.h>
+#include <sys/eventfd.h>
+#include <linux/hidraw.h>
+
+#include "usb_hidhost_impl.h"
+
+#define USBHID_REPORT_MAXSIZE_DEF	64
+
+// Control transfer requests, Linux 5.11 and later
+#ifndef HIDIOCGINPUT
+#define HIDIOCGINPUT(len)    _IOC(_IOC_WRITE|_IOC_READ, 'H', 0x0A, len)
+#define HIDIOCSOUTPUT(len)   _IOC(_IOC_WRITE|_IOC_READ, 'H', 0x0B, len)
+#endif
+
+uint64_t UsbHidDevice_Impl::nsTime()
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+}
+
+UsbHidDevice_Impl::UsbHidDevice_Impl() :
+	vFd(-1), vbNumbered(false), vTimeoutUs(USBHID_TIMEOUT_DEF), vbRun(false),
+	vInEvt(-1), vOutEvt(-1), vOutDoneEvt(-1), vInDropCnt(0), vOutErrCnt(0)
+{
+	vMaxInRepSize = 0;
+	vMaxOutRepSize = 0;
+	vMaxFeatRepSize = 0;
+	vInQue.Put = vInQue.Get = 0;
+	vOutQue.Put = vOutQue.Get = 0;
+	ResetStats();
+}
+
+UsbHidDevice_Impl::~UsbHidDevice_Impl()
+{
+	Close();
+}
+
+bool UsbHidDevice_Impl::Init(const char *pDevPath, int QueueDepth)
+{
+	Close();
+
+	int fd = open(pDevPath, O_RDWR | O_CLOEXEC);
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	const char *p = strrchr(pDevPath, '/');
+
+	vSysName = p ? p + 1 : pDevPath;
+	vFd = fd;
+	ReadDeviceInfo();
+
+	return Start(QueueDepth);
+}
+
+bool UsbHidDevice_Impl::Init(int Fd, uint32_t MaxInRepSize, uint32_t MaxOutRepSize, bool bNumbered, int QueueDepth)
+{
+	Close();
+
+	if (Fd < 0)
+	{
+		return false;
+	}
+
+	vSysName.clear();
+	vFd = Fd;
+	vMaxInRepSize = MaxInRepSize;
+	vMaxOutRepSize = MaxOutRepSize;
+	vMaxFeatRepSize = 0;
+	vbNumbered = bNumbered;
+
+	return Start(QueueDepth);
+}
+
+void UsbHidDevice_Impl::ReadDeviceInfo()
+{
+	struct hidraw_report_descriptor desc;
+	int size = 0;
+
+	vMaxInRepSize = vMaxOutRepSize = vMaxFeatRepSize = USBHID_REPORT_MAXSIZE_DEF;
+	vbNumbered = false;
+
+	if (ioctl(vFd, HIDIOCGRDESCSIZE, &size) < 0 || size <= 0 || size > HID_MAX_DESCRIPTOR_SIZE)
+	{
+		return;
+	}
+
+	desc.size = size;
+	if (ioctl(vFd, HIDIOCGRDESC, &desc) < 0)
+	{
+		return;
+	}
+
+	// Sum report bits per main item type & report id
+	std::vector<uint32_t> bits[3] = {
+		std::vector<uint32_t>(256), std::vector<uint32_t>(256), std::vector<uint32_t>(256)
+	};
+	uint32_t rsize = 0, rcount = 0, id = 0;
+	int i = 0;
+
+	while (i < size)
+	{
+		uint8_t b = desc.value[i];
+
+		if (b == 0xFE)
+		{
+			// Long item
+			i += i + 1 < size ? 3 + desc.value[i + 1] : size;
+			continue;
+		}
+
+		int n = (b & 3) == 3 ? 4 : b & 3;
+		uint32_t v = 0;
+
+		for (int j = n - 1; j >= 0; j--)
+		{
+			v = (v << 8) | (i + 1 + j < size ? desc.value[i + 1 + j] : 0);
+		}
+
+		switch (b & 0xFC)
+		{
+			case 0x74:	// Report Size
+				rsize = v;
+				break;
+			case 0x94:	// Report Count
+				rcount = v;
+				break;
+			case 0x84:	// Report ID
+				id = v & 0xFF;
+				vbNumbered = true;
+				break;
+			case 0x80:	// Input
+				bits[0][id] += rsize * rcount;
+				break;
+			case 0x90:	// Output
+				bits[1][id] += rsize * rcount;
+				break;
+			case 0xB0:	// Feature
+				bits[2][id] += rsize * rcount;
+				break;
+		}
+		i += 1 + n;
+	}
+
+	uint32_t max[3] = { 0, 0, 0 };
+
+	for (int t = 0; t < 3; t++)
+	{
+		for (int j = 0; j < 256; j++)
+		{
+			uint32_t l = (bits[t][j] + 7) / 8;
+
+			max[t] = l > max[t] ? l : max[t];
+		}
+	}
+
+	vMaxInRepSize = max[0] > 0 ? max[0] : USBHID_REPORT_MAXSIZE_DEF;
+	vMaxOutRepSize = max[1] > 0 ? max[1] : USBHID_REPORT_MAXSIZE_DEF;
+	vMaxFeatRepSize = max[2];
+}
+
+void UsbHidDevice_Impl::QueInit(REPQUE &Que, uint32_t MaxDataSize, int Depth)
+{
+	// Power of 2 so free running indexes stay valid across wrap around
+	Que.Depth = 1;
+	while ((int)Que.Depth < Depth)
+	{
+		Que.Depth <<= 1;
+	}
+	Que.SlotSize = (sizeof(REPSLOT) + MaxDataSize + 7) & ~7;
+	Que.Mem.assign((size_t)Que.SlotSize * Que.Depth, 0);
+	Que.Put = 0;
+	Que.Get = 0;
+}
+
+bool UsbHidDevice_Impl::Start(int QueueDepth)
+{
+	if (QueueDepth <= 0)
+	{
+		QueueDepth = USBHID_QUEUE_DEPTH_DEF;
+	}
+
+	// I/O thread reads until EAGAIN
+	fcntl(vFd, F_SETFL, fcntl(vFd, F_GETFL) | O_NONBLOCK);
+
+	QueInit(vInQue, vMaxInRepSize, QueueDepth);
+	QueInit(vOutQue, vMaxOutRepSize, QueueDepth);
+	vInDropCnt = 0;
+	vOutErrCnt = 0;
+	ResetStats();
+
+	vInEvt = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	vOutEvt = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+	vOutDoneEvt = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+	if (vInEvt < 0 || vOutEvt < 0 || vOutDoneEvt < 0)
+	{
+		Close();
+		return false;
+	}
+
+	vbRun = true;
+	vThread = std::thread(&UsbHidDevice_Impl::IoThread, this);
+
+	return true;
+}
+
+void UsbHidDevice_Impl::Close()
+{
+	if (vThread.joinable())
+	{
+		vbRun = false;
+		eventfd_write(vOutEvt, 1);
+		vThread.join();
+	}
+
+	int *fds[4] = { &vFd, &vInEvt, &vOutEvt, &vOutDoneEvt };
+
+	for (int i = 0; i < 4; i++)
+	{
+		if (*fds[i] >= 0)
+		{
+			close(*fds[i]);
+			*fds[i] = -1;
+		}
+	}
+}
+
+void UsbHidDevice_Impl::IoThread()
+{
+	std::vector<uint8_t> buf(vMaxInRepSize + 1);
+	struct pollfd pfd[2] = {
+		{ vFd, POLLIN, 0 },
+		{ vOutEvt, POLLIN, 0 },
+	};
+
+	while (vbRun)
+	{
+		bool outpend = vOutQue.Get.load(std::memory_order_relaxed) != vOutQue.Put.load(std::memory_order_acquire);
+
+		pfd[0].events = POLLIN | (outpend ? POLLOUT : 0);
+
+		if (poll(pfd, 2, -1) < 0)
+		{
+			if (errno == EINTR)
+			{
+				continue;
+			}
+			break;
+		}
+
+		if (pfd[1].revents & POLLIN)
+		{
+			eventfd_t v;
+			eventfd_read(vOutEvt, &v);
+		}
+
+		if (pfd[0].revents & (POLLERR | POLLNVAL))
+		{
+			// Device removed
+			break;
+		}
+
+		bool bwritable = pfd[0].revents & POLLOUT;
+
+		while (vbRun)
+		{
+			// Drain input first so the kernel report buffer never fills while writing
+			int n;
+
+			while ((n = read(vFd, buf.data(), buf.size())) > 0)
+			{
+				uint64_t t = nsTime();
+				int off = vbNumbered ? 1 : 0;
+				int repno = vbNumbered ? buf[0] : 0;
+				uint32_t put = vInQue.Put.load(std::memory_order_relaxed);
+
+				if (n <= off || ProcessInputReport(repno, &buf[off], n - off) == false)
+				{
+					continue;
+				}
+
+				if (put - vInQue.Get.load(std::memory_order_acquire) >= vInQue.Depth)
+				{
+					vInDropCnt++;
+					continue;
+				}
+
+				REPSLOT *slot = QueSlot(vInQue, put);
+
+				slot->TimeNs = t;
+				slot->RepNo = repno;
+				slot->Len = n - off;
+				memcpy(&slot[1], &buf[off], n - off);
+				vInQue.Put.store(put + 1, std::memory_order_release);
+				eventfd_write(vInEvt, 1);
+			}
+
+			if (n == 0 && (pfd[0].revents & POLLHUP))
+			{
+				// Peer closed
+				vbRun = false;
+				break;
+			}
+
+			uint32_t get = vOutQue.Get.load(std::memory_order_relaxed);
+
+			if (bwritable == false || get == vOutQue.Put.load(std::memory_order_acquire))
+			{
+				break;
+			}
+
+			REPSLOT *slot = QueSlot(vOutQue, get);
+
+			if (WriteReport(slot->RepNo, (uint8_t*)&slot[1], slot->Len) == false)
+			{
+				if (errno == EAGAIN)
+				{
+					// Wait for POLLOUT
+					break;
+				}
+				vOutErrCnt++;
+			}
+
+			LatAdd(vOutLat[slot->RepNo], nsTime() - slot->TimeNs);
+			vOutQue.Get.store(get + 1, std::memory_order_release);
+			eventfd_write(vOutDoneEvt, 1);
+		}
+	}
+
+	// Wake waiters
+	vbRun = false;
+	eventfd_write(vInEvt, 1);
+	eventfd_write(vOutDoneEvt, 1);
+}
+
+bool UsbHidDevice_Impl::WriteReport(int RepNo, const uint8_t *pBuf, uint32_t BufSize)
+{
+	uint8_t buf[BufSize + 1];
+
+	// hidraw expects report id first, 0 if reports are not numbered
+	buf[0] = RepNo;
+	memcpy(&buf[1], pBuf, BufSize);
+
+	return write(vFd, buf, BufSize + 1) == (ssize_t)BufSize + 1;
+}
+
+bool UsbHidDevice_Impl::WaitEvt(int EvtFd, uint64_t DeadlineNs)
+{
+	uint64_t t = nsTime();
+
+	if (t >= DeadlineNs)
+	{
+		return false;
+	}
+
+	struct pollfd pfd = { EvtFd, POLLIN, 0 };
+	struct timespec ts;
+
+	ts.tv_sec = (DeadlineNs - t) / 1000000000ULL;
+	ts.tv_nsec = (DeadlineNs - t) % 1000000000ULL;
+
+	if (ppoll(&pfd, 1, &ts, NULL) <= 0)
+	{
+		return false;
+	}
+
+	eventfd_t v;
+	eventfd_read(EvtFd, &v);
+
+	return true;
+}
+
+void UsbHidDevice_Impl::LatAdd(USBHID_LATSTAT &Stat, uint64_t Ns)
+{
+	if (Stat.Cnt == 0 || Ns < Stat.MinNs)
+	{
+		Stat.MinNs = Ns;
+	}
+	if (Ns > Stat.MaxNs)
+	{
+		Stat.MaxNs = Ns;
+	}
+	Stat.SumNs += Ns;
+	Stat.Cnt++;
+}
+
+void UsbHidDevice_Impl::ResetStats()
+{
+	memset(vInLat, 0, sizeof(vInLat));
+	memset(vOutLat, 0, sizeof(vOutLat));
+}
+
+int UsbHidDevice_Impl::GetInputReport(uint8_t *pBuf, uint32_t BufSize, uint32_t TimeoutUs, int *pRepNo, uint64_t *pTimeNs)
+{
+	if (vInEvt < 0)
+	{
+		return 0;
+	}
+
+	uint64_t deadline = nsTime() + TimeoutUs * 1000ULL;
+
+	while (true)
+	{
+		uint32_t get = vInQue.Get.load(std::memory_order_relaxed);
+
+		if (get != vInQue.Put.load(std::memory_order_acquire))
+		{
+			REPSLOT *slot = QueSlot(vInQue, get);
+			uint32_t l = slot->Len < BufSize ? slot->Len : BufSize;
+
+			memcpy(pBuf, &slot[1], l);
+			if (pRepNo)
+			{
+				*pRepNo = slot->RepNo;
+			}
+			if (pTimeNs)
+			{
+				*pTimeNs = slot->TimeNs;
+			}
+			LatAdd(vInLat[slot->RepNo], nsTime() - slot->TimeNs);
+			vInQue.Get.store(get + 1, std::memory_order_release);
+
+			return l;
+		}
+
+		if (TimeoutUs == 0 || WaitEvt(vInEvt, deadline) == false)
+		{
+			return 0;
+		}
+	}
+}
+
+bool UsbHidDevice_Impl::WaitResponseUs(uint32_t TimeoutUs)
+{
+	uint64_t deadline = nsTime() + TimeoutUs * 1000ULL;
+
+	while (InputPending() == 0)
+	{
+		if (vInEvt < 0 || WaitEvt(vInEvt, deadline) == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UsbHidDevice_Impl::WaitResponse(int TimeOutSec)
+{
+	return WaitResponseUs(TimeOutSec < 4000 ? TimeOutSec * 1000000U : 4000000000U);
+}
+
+int UsbHidDevice_Impl::ReadInputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize, bool CtrlTrans)
+{
+	if (vFd < 0)
+	{
+		return 0;
+	}
+
+	if (CtrlTrans == false)
+	{
+		// Next report of any id from interrupt transfers
+		return GetInputReport(pBuf, BufSize, vTimeoutUs);
+	}
+
+	uint8_t buf[vMaxInRepSize + 1];
+
+	buf[0] = RepNo;
+
+	int l = ioctl(vFd, HIDIOCGINPUT(sizeof(buf)), buf);
+
+	if (l <= 1)
+	{
+		return 0;
+	}
+
+	l = (uint32_t)(l - 1) < BufSize ? l - 1 : BufSize;
+	memcpy(pBuf, &buf[1], l);
+
+	return l;
+}
+
+bool UsbHidDevice_Impl::WriteOutputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize, bool CtrlTrans)
+{
+	if (vFd < 0 || BufSize > vMaxOutRepSize)
+	{
+		return false;
+	}
+
+	if (CtrlTrans)
+	{
+		uint8_t buf[BufSize + 1];
+
+		buf[0] = RepNo;
+		memcpy(&buf[1], pBuf, BufSize);
+
+		return ioctl(vFd, HIDIOCSOUTPUT(BufSize + 1), buf) >= 0;
+	}
+
+	uint64_t deadline = nsTime() + vTimeoutUs * 1000ULL;
+
+	while (WriteReport(RepNo, pBuf, BufSize) == false)
+	{
+		struct pollfd pfd = { vFd, POLLOUT, 0 };
+		int64_t rem = (int64_t)(deadline - nsTime()) / 1000000;
+
+		if (errno != EAGAIN || rem <= 0 || poll(&pfd, 1, rem) <= 0)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+bool UsbHidDevice_Impl::QueueOutputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize)
+{
+	if (vOutEvt < 0 || BufSize > vMaxOutRepSize)
+	{
+		return false;
+	}
+
+	uint32_t put = vOutQue.Put.load(std::memory_order_relaxed);
+
+	if (put - vOutQue.Get.load(std::memory_order_acquire) >= vOutQue.Depth)
+	{
+		return false;
+	}
+
+	REPSLOT *slot = QueSlot(vOutQue, put);
+
+	slot->TimeNs = nsTime();
+	slot->RepNo = RepNo;
+	slot->Len = BufSize;
+	memcpy(&slot[1], pBuf, BufSize);
+	vOutQue.Put.store(put + 1, std::memory_order_release);
+	eventfd_write(vOutEvt, 1);
+
+	return true;
+}
+
+bool UsbHidDevice_Impl::FlushOutput(uint32_t TimeoutUs)
+{
+	uint64_t deadline = nsTime() + TimeoutUs * 1000ULL;
+
+	while (vOutQue.Get.load(std::memory_order_acquire) != vOutQue.Put.load(std::memory_order_relaxed))
+	{
+		if (vOutDoneEvt < 0 || WaitEvt(vOutDoneEvt, deadline) == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int UsbHidDevice_Impl::ReadFeatureReport(int RepNo, uint8_t *pBuf, uint32_t BufSize)
+{
+	if (vFd < 0)
+	{
+		return 0;
+	}
+
+	uint8_t buf[BufSize + 1];
+
+	buf[0] = RepNo;
+
+	int l = ioctl(vFd, HIDIOCGFEATURE(BufSize + 1), buf);
+
+	if (l <= 1)
+	{
+		return 0;
+	}
+
+	memcpy(pBuf, &buf[1], l - 1);
+
+	return l - 1;
+}
+
+bool UsbHidDevice_Impl::WriteFeatureReport(int RepNo, uint8_t *pBuf, uint32_t BufSize)
+{
+	if (vFd < 0)
+	{
+		return false;
+	}
+
+	uint8_t buf[BufSize + 1];
+
+	buf[0] = RepNo;
+	memcpy(&buf[1], pBuf, BufSize);
+
+	return ioctl(vFd, HIDIOCSFEATURE(BufSize + 1), buf) >= 0;
+}
+
+/**
+ * @brief	Read a key from hidraw sysfs uevent
+ */
+static bool UEventValue(const std::string &SysName, const char *pKey, std::string &Val)
+{
+	std::string path = "/sys/class/hidraw/" + SysName + "/device/uevent";
+	FILE *fp = fopen(path.c_str(), "r");
+	char line[256];
+	size_t l = strlen(pKey);
+	bool res = false;
+
+	if (fp == NULL)
+	{
+		return false;
+	}
+
+	while (fgets(line, sizeof(line), fp))
+	{
+		if (strncmp(line, pKey, l) == 0 && line[l] == '=')
+		{
+			line[strcspn(line, "\r\n")] = 0;
+			Val = &line[l + 1];
+			res = true;
+			break;
+		}
+	}
+	fclose(fp);
+
+	return res;
+}
+
+bool UsbHidDevice_Impl::GetSerialNumber(std::string &sn)
+{
+	return vSysName.empty() == false && UEventValue(vSysName, "HID_UNIQ", sn);
+}
+
+int UsbHidDevice_Impl::Find(uint16_t Vid, uint16_t Pid, std::vector<std::string> &Paths)
+{
+	DIR *dir = opendir("/sys/class/hidraw");
+	struct dirent *d;
+	int cnt = 0;
+
+	if (dir == NULL)
+	{
+		return 0;
+	}
+
+	while ((d = readdir(dir)) != NULL)
+	{
+		std::string id;
+		unsigned bus, vid, pid;
+
+		if (strncmp(d->d_name, "hidraw", 6) != 0 || UEventValue(d->d_name, "HID_ID", id) == false)
+		{
+			continue;
+		}
+
+		// HID_ID=bus:vid:pid, 8 hex digits each
+		if (sscanf(id.c_str(), "%x:%x:%x", &bus, &vid, &pid) == 3 && vid == Vid && pid == Pid)
+		{
+			Paths.push_back(std::string("/dev/") + d->d_name);
+			cnt++;
+		}
+	}
+	closedir(dir);
+
+	return cnt;
+}
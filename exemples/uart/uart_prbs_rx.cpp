@@ -45,7 +45,11 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "prbs.h"
 
 
+#ifdef __linux__
+char s_DevPath[] = {"/dev/ttyACM0"};
+#else
 char s_DevPath[] = {"/dev/cu.usbmodem142122"};
+#endif
 
 // UART configuration data
 const UARTCFG g_UartCfg = {
@@ -3,7 +3,12 @@
 
 @brief	Base64 encode/decode.
 
-This is the base64 binary to ASCII encoder/decoder
+This is the base64 binary to ASCII encoder/decoder (RFC 4648). Standard and
+URL safe alphabets, optional padding & line wrapping. Encoding and decoding
+can be done in one call or by chunks through a streaming context.
+
+Conversion is table driven. On host builds, x86 (SSSE3, runtime detected) and
+AArch64 (NEON) process 12/48 bytes per step.
 
 @author Hoang Nguyen Hoan
 @date	Nov. 3, 2012
@@ -37,10 +42,47 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef __BASE64_H__
 #define __BASE64_H__
 
+#include <stdint.h>
+#include <stdbool.h>
+
 /** @addtogroup Utilities
   * @{
   */
 
+/// Encoded length of n bytes with padding, excluding line breaks & NUL
+#define BASE64_ENCODED_LEN(n)		((((n) + 2) / 3) * 4)
+
+/// Max decoded length of n characters
+#define BASE64_DECODED_MAX(n)		((((n) + 3) / 4) * 3)
+
+typedef enum __Base64_Alphabet {
+	BASE64_ALPHABET_STD,			//!< Standard alphabet, '+' '/'
+	BASE64_ALPHABET_URL,			//!< URL & file name safe alphabet, '-' '_'
+} BASE64_ALPHABET;
+
+#pragma pack(push, 4)
+
+/// Streaming encoder context
+typedef struct __Base64_Enc_Ctx {
+	BASE64_ALPHABET Alphabet;
+	bool bPad;						//!< Pad last quad with '='
+	int LineLen;					//!< Characters per line, multiple of 4, 0 no line break
+	int Col;						//!< Characters on current line
+	int RemLen;						//!< Bytes held waiting for a full triplet
+	uint8_t Rem[3];
+} BASE64_ENCCTX;
+
+/// Streaming decoder context
+typedef struct __Base64_Dec_Ctx {
+	BASE64_ALPHABET Alphabet;
+	int QuadLen;					//!< Characters held waiting for a full quad
+	int PadCnt;						//!< '=' received in current quad
+	bool bEnd;						//!< Padded quad completed, only white spaces may follow
+	uint8_t Quad[4];				//!< 6 bits values
+} BASE64_DECCTX;
+
+#pragma pack(pop)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -48,20 +90,130 @@ extern "C" {
 /**
  * @brief	Encode binary to base64 ASCII format.
  *
+ * Standard alphabet, padded, NUL terminated. Output is truncated to whole
+ * quads fitting in the destination buffer.
+ *
  * @param 	pSrc 	: Pointer to source binary data
  * @param	SrcLen	: Source data length in bytes
  * @param	pDest	: Pointer to ASCII destination buffer
  * @param	DstLen	: Destination buffer length in bytes
  *
- * @return	Number of bytes encoded
+ * @return	Number of characters encoded
  */
-int Base64Encode(uint8_t *pSrc, int SrcLen, char *pDest, int DstLen);
+int Base64Encode(const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen);
 
-/** @} End of group Utilities */
+/**
+ * @brief	Encode binary to base64, NUL terminated.
+ *
+ * @param 	pSrc 		: Pointer to source binary data
+ * @param	SrcLen		: Source data length in bytes
+ * @param	pDest		: Pointer to ASCII destination buffer
+ * @param	DstLen		: Destination buffer length, BASE64_ENCODED_LEN(SrcLen) + 1
+ * @param	Alphabet	: Alphabet to use
+ * @param	bPad		: Pad with '='
+ *
+ * @return	Number of characters encoded, -1 if destination too small
+ */
+int Base64EncodeEx(const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen,
+				   BASE64_ALPHABET Alphabet, bool bPad);
+
+/**
+ * @brief	Decode base64 to binary.
+ *
+ * White spaces are skipped, padding is optional.
+ *
+ * @param 	pSrc 		: Pointer to base64 characters
+ * @param	SrcLen		: Number of characters
+ * @param	pDest		: Pointer to destination buffer
+ * @param	DstLen		: Destination buffer length, BASE64_DECODED_MAX(SrcLen) always fits
+ * @param	Alphabet	: Alphabet to use
+ *
+ * @return	Number of bytes decoded, -1 on invalid input or destination too small
+ */
+int Base64Decode(const char *pSrc, int SrcLen, uint8_t *pDest, int DstLen, BASE64_ALPHABET Alphabet);
+
+/**
+ * @brief	Initialize streaming encoder.
+ *
+ * @param	pCtx		: Context
+ * @param	Alphabet	: Alphabet to use
+ * @param	bPad		: Pad with '='
+ * @param	LineLen		: Insert CR LF every LineLen characters (76 for MIME), 0 none
+ *
+ * @return	false if LineLen is not a multiple of 4
+ */
+bool Base64EncInit(BASE64_ENCCTX * const pCtx, BASE64_ALPHABET Alphabet, bool bPad, int LineLen);
+
+/**
+ * @brief	Encode a chunk. Bytes not making a full triplet are held.
+ *
+ * @param	pCtx	: Context
+ * @param 	pSrc 	: Pointer to source binary data
+ * @param	SrcLen	: Source data length in bytes
+ * @param	pDest	: Pointer to destination buffer, not NUL terminated
+ * @param	DstLen	: Destination buffer length, BASE64_ENCODED_LEN(SrcLen + 2) plus
+ * 					  line breaks always fits
+ *
+ * @return	Number of characters written, -1 if destination too small
+ */
+int Base64EncUpdate(BASE64_ENCCTX * const pCtx, const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen);
+
+/**
+ * @brief	Encode held bytes and padding.
+ *
+ * @param	pCtx	: Context
+ * @param	pDest	: Pointer to destination buffer
+ * @param	DstLen	: Destination buffer length, 6 always fits
+ *
+ * @return	Number of characters written, -1 if destination too small
+ */
+int Base64EncFinal(BASE64_ENCCTX * const pCtx, char *pDest, int DstLen);
+
+/**
+ * @brief	Initialize streaming decoder.
+ *
+ * @param	pCtx		: Context
+ * @param	Alphabet	: Alphabet to use
+ */
+void Base64DecInit(BASE64_DECCTX * const pCtx, BASE64_ALPHABET Alphabet);
+
+/**
+ * @brief	Decode a chunk. Characters not making a full quad are held.
+ *
+ * @param	pCtx	: Context
+ * @param 	pSrc 	: Pointer to base64 characters
+ * @param	SrcLen	: Number of characters
+ * @param	pDest	: Pointer to destination buffer
+ * @param	DstLen	: Destination buffer length, BASE64_DECODED_MAX(SrcLen) always fits
+ *
+ * @return	Number of bytes decoded, -1 on invalid input or destination too small
+ */
+int Base64DecUpdate(BASE64_DECCTX * const pCtx, const char *pSrc, int SrcLen, uint8_t *pDest, int DstLen);
+
+/**
+ * @brief	Decode held characters of an unpadded end.
+ *
+ * @param	pCtx	: Context
+ * @param	pDest	: Pointer to destination buffer
+ * @param	DstLen	: Destination buffer length, 2 always fits
+ *
+ * @return	Number of bytes decoded, -1 if input was truncated
+ */
+int Base64DecFinal(BASE64_DECCTX * const pCtx, uint8_t *pDest, int DstLen);
+
+/**
+ * @brief	Enable/disable SIMD bulk conversion, for test & benchmark.
+ *
+ * @param	bEnable	: true to use SIMD when available (default)
+ *
+ * @return	true if SIMD is available on this target
+ */
+bool Base64SetSimd(bool bEnable);
 
 #ifdef __cplusplus
 }
 #endif
 
+/** @} End of group Utilities */
 
 #endif // __BASE64_H__
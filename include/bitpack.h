@@ -0,0 +1,563 @@
+/**-------------------------------------------------------------------------
+@file	bitpack.h
+
+@brief	Compile time bit packed field codec.
+
+Describes the wire layout of a structure once, as a list of field descriptors,
+and generates the pack/unpack code for it. Offsets and shifts are compile time
+constants, so the generated code is the same straight shift/mask sequence one
+would write by hand.
+
+Each field is range reduced to NbBits bits (1 to 32) : the member value is
+clamped to [Min, Min + Step * (2^NbBits - 1)] and sent as (Value - Min) / Step,
+rounded. Step is a rational StepNum / StepDen so fixed point and float members
+can be scaled, ex. 0.001 V step for a float voltage is StepNum 1, StepDen 1000.
+
+Bit order :
+	BPENDIAN_LITTLE : LSB first bit stream, first field in the low bits of
+					  byte 0. Byte aligned 8/16/32 bits fields are then little
+					  endian, same as a packed structure on Cortex-M.
+	BPENDIAN_BIG	: MSB first bit stream (network order), first field in the
+					  high bits of byte 0.
+
+Requires C++11 or later.
+
+Usage :
+
+	typedef BpLayout<BPENDIAN_LITTLE,
+		BpField<BLUEIO_DATA_TPH, int16_t, &BLUEIO_DATA_TPH::Temperature, 12, -4000, 5>,
+		BpField<BLUEIO_DATA_TPH, uint32_t, &BLUEIO_DATA_TPH::Pressure, 20, 30000>,
+		BpField<BLUEIO_DATA_TPH, uint16_t, &BLUEIO_DATA_TPH::Humidity, 12, 0, 3>
+	> TPH_COMPACT;
+
+	uint8_t buff[TPH_COMPACT::Size];	// 6 bytes instead of 8
+
+	TPH_COMPACT::Pack(tph, buff);
+	...
+	TPH_COMPACT::Unpack(buff, tph);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BITPACK_H__
+#define __BITPACK_H__
+
+#include <stdint.h>
+#include <string.h>
+
+#ifdef __cplusplus
+
+#include <type_traits>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+/// Bit order of the packed stream
+typedef enum __Bit_Pack_Endian {
+	BPENDIAN_LITTLE,		//!< LSB first, little endian bytes
+	BPENDIAN_BIG			//!< MSB first, big endian bytes
+} BPENDIAN;
+
+/**
+ * @brief	Store NbBits of Val at bit offset Off.
+ *
+ * Target bits must be zero. With constant Off & NbBits, the loop is unrolled
+ * into a few shifts and byte ORs.
+ *
+ * @param	E		: Bit order
+ * @param	pBuff	: Pointer to packed buffer
+ * @param	Off		: Bit offset
+ * @param	NbBits	: Number of bits (1 to 32)
+ * @param	Val		: Value to store, must fit in NbBits
+ */
+template <BPENDIAN E>
+static inline void BpPutBits(uint8_t *pBuff, unsigned Off, unsigned NbBits, uint32_t Val)
+{
+	uint8_t *p = pBuff + (Off >> 3);
+	unsigned sh = Off & 7;
+	unsigned nb = (sh + NbBits + 7) >> 3;
+
+	if (E == BPENDIAN_LITTLE)
+	{
+		uint64_t acc = (uint64_t)Val << sh;
+
+		for (unsigned i = 0; i < nb; i++)
+		{
+			p[i] |= (uint8_t)(acc >> (i << 3));
+		}
+	}
+	else
+	{
+		uint64_t acc = (uint64_t)Val << (64 - sh - NbBits);
+
+		for (unsigned i = 0; i < nb; i++)
+		{
+			p[i] |= (uint8_t)(acc >> (56 - (i << 3)));
+		}
+	}
+}
+
+/**
+ * @brief	Load NbBits at bit offset Off.
+ *
+ * @param	E		: Bit order
+ * @param	pBuff	: Pointer to packed buffer
+ * @param	Off		: Bit offset
+ * @param	NbBits	: Number of bits (1 to 32)
+ *
+ * @return	Value
+ */
+template <BPENDIAN E>
+static inline uint32_t BpGetBits(const uint8_t *pBuff, unsigned Off, unsigned NbBits)
+{
+	const uint8_t *p = pBuff + (Off >> 3);
+	unsigned sh = Off & 7;
+	unsigned nb = (sh + NbBits + 7) >> 3;
+	uint64_t acc = 0;
+
+	if (E == BPENDIAN_LITTLE)
+	{
+		for (unsigned i = 0; i < nb; i++)
+		{
+			acc |= (uint64_t)p[i] << (i << 3);
+		}
+
+		return (uint32_t)((acc >> sh) & ((1ULL << NbBits) - 1));
+	}
+
+	for (unsigned i = 0; i < nb; i++)
+	{
+		acc |= (uint64_t)p[i] << (56 - (i << 3));
+	}
+
+	return (uint32_t)((acc << sh) >> (64 - NbBits));
+}
+
+/// Place NbBits of Val at bit offset Off of a 64 bits word, for layouts up to 64 bits
+template <BPENDIAN E>
+static inline uint64_t BpWordPut(unsigned Off, unsigned NbBits, uint32_t Val)
+{
+	return E == BPENDIAN_LITTLE ? (uint64_t)Val << Off : (uint64_t)Val << (64 - Off - NbBits);
+}
+
+/// Extract NbBits at bit offset Off of a 64 bits word
+template <BPENDIAN E>
+static inline uint32_t BpWordGet(uint64_t Word, unsigned Off, unsigned NbBits)
+{
+	uint64_t mask = (1ULL << NbBits) - 1;
+
+	return (uint32_t)((E == BPENDIAN_LITTLE ? Word >> Off : Word >> (64 - Off - NbBits)) & mask);
+}
+
+/// Word <-> bytes, unrolled at compile time so the compiler merges the byte accesses
+template <BPENDIAN E, unsigned Idx, unsigned Count>
+struct BpWordBytes {
+	static constexpr unsigned Shift = E == BPENDIAN_LITTLE ? Idx << 3 : 56 - (Idx << 3);
+
+	static inline void Store(uint8_t *pBuff, uint64_t Word) {
+		pBuff[Idx] = (uint8_t)(Word >> Shift);
+		BpWordBytes<E, Idx + 1, Count>::Store(pBuff, Word);
+	}
+
+	static inline uint64_t Load(const uint8_t *pBuff) {
+		return ((uint64_t)pBuff[Idx] << Shift) | BpWordBytes<E, Idx + 1, Count>::Load(pBuff);
+	}
+};
+
+template <BPENDIAN E, unsigned Count>
+struct BpWordBytes<E, Count, Count> {
+	static inline void Store(uint8_t *, uint64_t) {}
+	static inline uint64_t Load(const uint8_t *) { return 0; }
+};
+
+/// Value <-> quantized code conversion, integer & enum members
+template <typename T, int32_t Min, uint32_t StepNum, uint32_t StepDen, uint32_t Max>
+static inline uint32_t BpQuantize(T Val, std::false_type)
+{
+	// Lim is the largest input that rounds to at most Max. Clamping to it
+	// first keeps the division in 32 bits whenever the range allows, no 64 bits
+	// division on Cortex-M, and makes the final clamp unneeded unless the step
+	// is below one member unit.
+	constexpr uint64_t Lim = ((Max + 1ULL) * StepNum - StepNum / 2 - 1) / StepDen;
+	typedef typename std::conditional<(Lim * StepDen + StepNum / 2 <= 0xFFFFFFFFULL),
+									  uint32_t, uint64_t>::type U;
+
+	// Clamp without early return so the compiler can use conditional moves
+	int64_t d = (int64_t)Val - Min;
+
+	d = d < 0 ? 0 : d;
+	d = d > (int64_t)Lim ? (int64_t)Lim : d;
+
+	U q = (U)d;
+
+	if (StepNum != 1 || StepDen != 1)
+	{
+		q = (q * StepDen + StepNum / 2) / StepNum;
+	}
+
+	if (StepDen > StepNum)
+	{
+		q = q > Max ? Max : q;
+	}
+
+	return (uint32_t)q;
+}
+
+/// Value <-> quantized code conversion, float members
+template <typename T, int32_t Min, uint32_t StepNum, uint32_t StepDen, uint32_t Max>
+static inline uint32_t BpQuantize(T Val, std::true_type)
+{
+	T d = (Val - (T)Min) * (T)StepDen / (T)StepNum + (T)0.5;
+
+	d = d > 0 ? d : 0;		// Also clears NaN
+
+	return d >= (T)Max ? Max : (uint32_t)d;
+}
+
+template <typename T, int32_t Min, uint32_t StepNum, uint32_t StepDen>
+static inline T BpDequantize(uint32_t Code, std::false_type)
+{
+	if (StepNum == 1 && StepDen == 1)
+	{
+		return (T)(Min + (int64_t)Code);
+	}
+
+	return (T)(Min + (int64_t)Code * StepNum / StepDen);
+}
+
+template <typename T, int32_t Min, uint32_t StepNum, uint32_t StepDen>
+static inline T BpDequantize(uint32_t Code, std::true_type)
+{
+	return (T)Min + (T)Code * (T)StepNum / (T)StepDen;
+}
+
+/**
+ * @brief	Scalar field descriptor.
+ *
+ * @param	S		: Structure type
+ * @param	T		: Member type, integer, enum or float
+ * @param	M		: Pointer to member
+ * @param	NbBits	: Packed width, 1 to 32
+ * @param	Min		: Value of code 0, in member unit
+ * @param	StepNum	: Step numerator, in member unit
+ * @param	StepDen	: Step denominator
+ */
+template <typename S, typename T, T S::*M, unsigned NbBits, int32_t Min = 0,
+		  uint32_t StepNum = 1, uint32_t StepDen = 1>
+struct BpField {
+	static_assert(NbBits > 0 && NbBits <= 32, "BpField width must be 1 to 32 bits");
+	static_assert(StepNum > 0 && StepDen > 0, "BpField step must not be zero");
+
+	typedef std::is_floating_point<T> IsFloat;
+
+	static constexpr unsigned Bits = NbBits;
+	static constexpr uint32_t Max = (uint32_t)((1ULL << NbBits) - 1);
+
+	/// Quantized code of the member
+	static inline uint32_t Get(const S &Data) {
+		return BpQuantize<T, Min, StepNum, StepDen, Max>(Data.*M, IsFloat());
+	}
+
+	/// Restore the member from its code
+	static inline void Set(S &Data, uint32_t Code) {
+		Data.*M = BpDequantize<T, Min, StepNum, StepDen>(Code, IsFloat());
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Pack(const S &Data, uint8_t *pBuff) {
+		BpPutBits<E>(pBuff, Off, NbBits, Get(Data));
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Unpack(const uint8_t *pBuff, S &Data) {
+		Set(Data, BpGetBits<E>(pBuff, Off, NbBits));
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline uint64_t Encode(const S &Data) {
+		return BpWordPut<E>(Off, NbBits, Get(Data));
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Decode(uint64_t Word, S &Data) {
+		Set(Data, BpWordGet<E>(Word, Off, NbBits));
+	}
+};
+
+/**
+ * @brief	Array field descriptor.
+ *
+ * Each of the Count elements is packed like a BpField of NbBits.
+ */
+template <typename S, typename T, unsigned Count, T (S::*M)[Count], unsigned NbBits,
+		  int32_t Min = 0, uint32_t StepNum = 1, uint32_t StepDen = 1>
+struct BpArrayField {
+	static_assert(NbBits > 0 && NbBits <= 32, "BpArrayField element width must be 1 to 32 bits");
+	static_assert(StepNum > 0 && StepDen > 0, "BpArrayField step must not be zero");
+
+	typedef std::is_floating_point<T> IsFloat;
+
+	static constexpr unsigned Bits = NbBits * Count;
+	static constexpr uint32_t Max = (uint32_t)((1ULL << NbBits) - 1);
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Pack(const S &Data, uint8_t *pBuff) {
+		for (unsigned i = 0; i < Count; i++)
+		{
+			BpPutBits<E>(pBuff, Off + i * NbBits, NbBits,
+						 BpQuantize<T, Min, StepNum, StepDen, Max>((Data.*M)[i], IsFloat()));
+		}
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Unpack(const uint8_t *pBuff, S &Data) {
+		for (unsigned i = 0; i < Count; i++)
+		{
+			(Data.*M)[i] = BpDequantize<T, Min, StepNum, StepDen>(
+								BpGetBits<E>(pBuff, Off + i * NbBits, NbBits), IsFloat());
+		}
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline uint64_t Encode(const S &Data) {
+		uint64_t w = 0;
+
+		for (unsigned i = 0; i < Count; i++)
+		{
+			w |= BpWordPut<E>(Off + i * NbBits, NbBits,
+							  BpQuantize<T, Min, StepNum, StepDen, Max>((Data.*M)[i], IsFloat()));
+		}
+
+		return w;
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Decode(uint64_t Word, S &Data) {
+		for (unsigned i = 0; i < Count; i++)
+		{
+			(Data.*M)[i] = BpDequantize<T, Min, StepNum, StepDen>(
+								BpWordGet<E>(Word, Off + i * NbBits, NbBits), IsFloat());
+		}
+	}
+};
+
+/// Member bits <-> raw code, integer & enum members, two's complement
+template <typename T>
+static inline uint32_t BpRawGet(T Val, std::false_type)
+{
+	return (uint32_t)(typename std::make_unsigned<T>::type)Val;
+}
+
+/// Member bits <-> raw code, float members, IEEE bit image
+template <typename T>
+static inline uint32_t BpRawGet(T Val, std::true_type)
+{
+	uint32_t v;
+
+	memcpy(&v, &Val, sizeof(v));
+
+	return v;
+}
+
+template <typename T>
+static inline T BpRawSet(uint32_t Code, std::false_type)
+{
+	return (T)(typename std::make_unsigned<T>::type)Code;
+}
+
+template <typename T>
+static inline T BpRawSet(uint32_t Code, std::true_type)
+{
+	T m;
+
+	memcpy(&m, &Code, sizeof(m));
+
+	return m;
+}
+
+/**
+ * @brief	Raw bit image field descriptor.
+ *
+ * Member bits are copied as is, full width : two's complement integers,
+ * enums, IEEE float. Member must be 1 to 4 bytes, float must be 4 bytes.
+ */
+template <typename S, typename T, T S::*M>
+struct BpRawField {
+	static_assert(sizeof(T) <= 4, "BpRawField member must be 1 to 4 bytes");
+	static_assert(!std::is_floating_point<T>::value || sizeof(T) == 4, "BpRawField float must be 4 bytes");
+
+	typedef std::is_floating_point<T> IsFloat;
+
+	static constexpr unsigned Bits = sizeof(T) << 3;
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Pack(const S &Data, uint8_t *pBuff) {
+		BpPutBits<E>(pBuff, Off, Bits, BpRawGet<T>(Data.*M, IsFloat()));
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Unpack(const uint8_t *pBuff, S &Data) {
+		Data.*M = BpRawSet<T>(BpGetBits<E>(pBuff, Off, Bits), IsFloat());
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline uint64_t Encode(const S &Data) {
+		return BpWordPut<E>(Off, Bits, BpRawGet<T>(Data.*M, IsFloat()));
+	}
+
+	template <BPENDIAN E, unsigned Off>
+	static inline void Decode(uint64_t Word, S &Data) {
+		Data.*M = BpRawSet<T>(BpWordGet<E>(Word, Off, Bits), IsFloat());
+	}
+};
+
+/// Field list walker, each field gets its compile time bit offset
+template <BPENDIAN E, unsigned Off, typename... F>
+struct BpFieldList {
+	static constexpr unsigned Bits = Off;
+
+	template <typename S>
+	static inline void Pack(const S &, uint8_t *) {}
+
+	template <typename S>
+	static inline void Unpack(const uint8_t *, S &) {}
+
+	template <typename S>
+	static inline uint64_t Encode(const S &) { return 0; }
+
+	template <typename S>
+	static inline void Decode(uint64_t, S &) {}
+};
+
+template <BPENDIAN E, unsigned Off, typename F0, typename... F>
+struct BpFieldList<E, Off, F0, F...> {
+	typedef BpFieldList<E, Off + F0::Bits, F...> Next;
+
+	static constexpr unsigned Bits = Next::Bits;
+
+	template <typename S>
+	static inline void Pack(const S &Data, uint8_t *pBuff) {
+		F0::template Pack<E, Off>(Data, pBuff);
+		Next::Pack(Data, pBuff);
+	}
+
+	template <typename S>
+	static inline void Unpack(const uint8_t *pBuff, S &Data) {
+		F0::template Unpack<E, Off>(pBuff, Data);
+		Next::Unpack(pBuff, Data);
+	}
+
+	template <typename S>
+	static inline uint64_t Encode(const S &Data) {
+		return F0::template Encode<E, Off>(Data) | Next::Encode(Data);
+	}
+
+	template <typename S>
+	static inline void Decode(uint64_t Word, S &Data) {
+		F0::template Decode<E, Off>(Word, Data);
+		Next::Decode(Word, Data);
+	}
+};
+
+/**
+ * @brief	Packed layout of a structure.
+ *
+ * Fields are packed back to back in list order, starting at bit 0.
+ *
+ * @param	E	: Bit order
+ * @param	F	: Field descriptors (BpField, BpArrayField, BpRawField)
+ */
+template <BPENDIAN E, typename... F>
+struct BpLayout {
+	typedef BpFieldList<E, 0, F...> List;
+	typedef std::integral_constant<bool, (List::Bits <= 64)> InWord;
+
+	static constexpr unsigned Bits = List::Bits;				//!< Total packed bits
+	static constexpr unsigned Size = (List::Bits + 7) >> 3;	//!< Packed size in bytes
+
+	/**
+	 * @brief	Pack structure into buffer.
+	 *
+	 * @param	Data	: Structure to pack
+	 * @param	pBuff	: Buffer of at least Size bytes
+	 *
+	 * @return	Number of bytes written (Size)
+	 */
+	template <typename S>
+	static inline int Pack(const S &Data, uint8_t *pBuff) {
+		Pack(Data, pBuff, InWord());
+
+		return Size;
+	}
+
+	/**
+	 * @brief	Unpack buffer into structure.
+	 *
+	 * @param	pBuff	: Packed data of at least Size bytes
+	 * @param	Data	: Structure to fill
+	 *
+	 * @return	Number of bytes consumed (Size)
+	 */
+	template <typename S>
+	static inline int Unpack(const uint8_t *pBuff, S &Data) {
+		Unpack(pBuff, Data, InWord());
+
+		return Size;
+	}
+
+private:
+	// Up to 64 bits, all fields are combined in a register then stored
+	template <typename S>
+	static inline void Pack(const S &Data, uint8_t *pBuff, std::true_type) {
+		BpWordBytes<E, 0, Size>::Store(pBuff, List::Encode(Data));
+	}
+
+	template <typename S>
+	static inline void Unpack(const uint8_t *pBuff, S &Data, std::true_type) {
+		List::Decode(BpWordBytes<E, 0, Size>::Load(pBuff), Data);
+	}
+
+	// Larger layouts are built in place in the buffer
+	template <typename S>
+	static inline void Pack(const S &Data, uint8_t *pBuff, std::false_type) {
+		memset(pBuff, 0, Size);
+		List::Pack(Data, pBuff);
+	}
+
+	template <typename S>
+	static inline void Unpack(const uint8_t *pBuff, S &Data, std::false_type) {
+		List::Unpack(pBuff, Data);
+	}
+};
+
+/** @} End of group Utilities */
+
+#endif // __cplusplus
+
+#endif // __BITPACK_H__
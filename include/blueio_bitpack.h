@@ -0,0 +1,222 @@
+/**-------------------------------------------------------------------------
+@file	blueio_bitpack.h
+
+@brief	Packed wire layouts of BLUEIO & BLEADV manufacturer data structures.
+
+Each structure is described once with bitpack.h field descriptors.
+
+	xxx_LAYOUT	: Full width, lossless. Little endian output is byte for byte
+				  the packed structure image, for compatibility with existing
+				  receivers.
+	xxx_COMPACT	: Range reduced fields for bandwidth limited links, ex. TPH in
+				  6 bytes with 12 bits temperature (0.05C), 20 bits pressure
+				  (1 Pa) and 12 bits humidity (0.03%).
+
+Variable length structures (PPI, Audio) have no fixed layout.
+
+Usage :
+
+	uint8_t buff[BLEADV_MANDATA_TPHSENSOR_COMPACT::Size];
+
+	BLEADV_MANDATA_TPHSENSOR_COMPACT::Pack(tph, buff);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLUEIO_BITPACK_H__
+#define __BLUEIO_BITPACK_H__
+
+#include "bitpack.h"
+#include "blueio_types.h"
+#include "bluetooth/bleadv_mandata.h"
+
+#ifdef __cplusplus
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+// BLUEIO data, full width
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_TPH, uint32_t, &BLUEIO_DATA_TPH::Pressure, 32>,
+	BpRawField<BLUEIO_DATA_TPH, int16_t, &BLUEIO_DATA_TPH::Temperature>,
+	BpField<BLUEIO_DATA_TPH, uint16_t, &BLUEIO_DATA_TPH::Humidity, 16>
+> BLUEIO_DATA_TPH_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_GAS, uint32_t, &BLUEIO_DATA_GAS::GasRes, 32>,
+	BpField<BLUEIO_DATA_GAS, uint16_t, &BLUEIO_DATA_GAS::AirQIdx, 16>,
+	BpField<BLUEIO_DATA_GAS, uint8_t, &BLUEIO_DATA_GAS::AirQuality, 8>
+> BLUEIO_DATA_GAS_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_ACCEL, uint16_t, &BLUEIO_DATA_ACCEL::AccelX, 16>,
+	BpField<BLUEIO_DATA_ACCEL, uint16_t, &BLUEIO_DATA_ACCEL::AccelY, 16>,
+	BpField<BLUEIO_DATA_ACCEL, uint16_t, &BLUEIO_DATA_ACCEL::AccelZ, 16>
+> BLUEIO_DATA_ACCEL_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_GYRO, uint16_t, &BLUEIO_DATA_GYRO::GyroX, 16>,
+	BpField<BLUEIO_DATA_GYRO, uint16_t, &BLUEIO_DATA_GYRO::GyroY, 16>,
+	BpField<BLUEIO_DATA_GYRO, uint16_t, &BLUEIO_DATA_GYRO::GyroZ, 16>
+> BLUEIO_DATA_GYRO_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_MAG, uint16_t, &BLUEIO_DATA_MAG::MagX, 16>,
+	BpField<BLUEIO_DATA_MAG, uint16_t, &BLUEIO_DATA_MAG::MagY, 16>,
+	BpField<BLUEIO_DATA_MAG, uint16_t, &BLUEIO_DATA_MAG::MagZ, 16>
+> BLUEIO_DATA_MAG_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_PROXY, uint32_t, &BLUEIO_DATA_PROXY::Id, 32>,
+	BpField<BLUEIO_DATA_PROXY, uint32_t, &BLUEIO_DATA_PROXY::Val, 32>
+> BLUEIO_DATA_PROXY_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_ADC, uint32_t, &BLUEIO_DATA_ADC::ChanId, 32>,
+	BpRawField<BLUEIO_DATA_ADC, float, &BLUEIO_DATA_ADC::Voltage>
+> BLUEIO_DATA_ADC_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_GPIO, uint8_t, &BLUEIO_DATA_GPIO::PortNo, 8>,
+	BpField<BLUEIO_DATA_GPIO, uint32_t, &BLUEIO_DATA_GPIO::PinVal, 32>
+> BLUEIO_DATA_GPIO_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpArrayField<BLUEIO_DATA_BUT, BLUEIO_BUT_STATE, BLUEIO_BUTTON_ARRAY_MAX, &BLUEIO_DATA_BUT::ButState, 32>
+> BLUEIO_DATA_BUT_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_MOTION, uint32_t, &BLUEIO_DATA_MOTION::Id, 32>,
+	BpField<BLUEIO_DATA_MOTION, uint32_t, &BLUEIO_DATA_MOTION::Val, 32>
+> BLUEIO_DATA_MOTION_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_I2C, uint8_t, &BLUEIO_DATA_I2C::Id, 8>,
+	BpField<BLUEIO_DATA_I2C, uint8_t, &BLUEIO_DATA_I2C::Len, 8>,
+	BpArrayField<BLUEIO_DATA_I2C, uint8_t, BLUEIO_I2C_DATA_LEN_MAX, &BLUEIO_DATA_I2C::Data, 8>
+> BLUEIO_DATA_I2C_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_SPI, uint8_t, &BLUEIO_DATA_SPI::Id, 8>,
+	BpField<BLUEIO_DATA_SPI, uint8_t, &BLUEIO_DATA_SPI::Len, 8>,
+	BpArrayField<BLUEIO_DATA_SPI, uint8_t, BLUEIO_I2C_DATA_LEN_MAX, &BLUEIO_DATA_SPI::Data, 8>
+> BLUEIO_DATA_SPI_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_UART, uint8_t, &BLUEIO_DATA_UART::Id, 8>,
+	BpField<BLUEIO_DATA_UART, uint8_t, &BLUEIO_DATA_UART::Len, 8>,
+	BpArrayField<BLUEIO_DATA_UART, uint8_t, BLUEIO_I2C_DATA_LEN_MAX, &BLUEIO_DATA_UART::Data, 8>
+> BLUEIO_DATA_UART_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_BAT, uint8_t, &BLUEIO_DATA_BAT::Level, 8>,
+	BpRawField<BLUEIO_DATA_BAT, int32_t, &BLUEIO_DATA_BAT::Voltage>
+> BLUEIO_DATA_BAT_LAYOUT;
+
+// BLUEIO data, compact
+
+/// Temperature -40 to 164.75C by 0.05C, pressure 30000 to 1078575 Pa, humidity 0 to 100% by 0.03%
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_TPH, int16_t, &BLUEIO_DATA_TPH::Temperature, 12, -4000, 5>,
+	BpField<BLUEIO_DATA_TPH, uint32_t, &BLUEIO_DATA_TPH::Pressure, 20, 30000>,
+	BpField<BLUEIO_DATA_TPH, uint16_t, &BLUEIO_DATA_TPH::Humidity, 12, 0, 3>
+> BLUEIO_DATA_TPH_COMPACT;
+
+/// Gas resistance 24 bits, air quality index 0 to 511, air quality 0 to 7
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_GAS, uint32_t, &BLUEIO_DATA_GAS::GasRes, 24>,
+	BpField<BLUEIO_DATA_GAS, uint16_t, &BLUEIO_DATA_GAS::AirQIdx, 9>,
+	BpField<BLUEIO_DATA_GAS, uint8_t, &BLUEIO_DATA_GAS::AirQuality, 3>
+> BLUEIO_DATA_GAS_COMPACT;
+
+/// Channel 0 to 15, voltage 0 to 4.095V by 1mV
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_ADC, uint32_t, &BLUEIO_DATA_ADC::ChanId, 4>,
+	BpField<BLUEIO_DATA_ADC, float, &BLUEIO_DATA_ADC::Voltage, 12, 0, 1, 1000>
+> BLUEIO_DATA_ADC_COMPACT;
+
+/// 2 bits per button state, 2 bytes instead of 32
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpArrayField<BLUEIO_DATA_BUT, BLUEIO_BUT_STATE, BLUEIO_BUTTON_ARRAY_MAX, &BLUEIO_DATA_BUT::ButState, 2>
+> BLUEIO_DATA_BUT_COMPACT;
+
+/// Level 0 to 127%, voltage 0 to 8190 mV by 2 mV
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLUEIO_DATA_BAT, uint8_t, &BLUEIO_DATA_BAT::Level, 7>,
+	BpField<BLUEIO_DATA_BAT, int32_t, &BLUEIO_DATA_BAT::Voltage, 12, 0, 2>
+> BLUEIO_DATA_BAT_COMPACT;
+
+// BLEADV manufacturer data, full width
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_TPHSENSOR, uint32_t, &BLEADV_MANDATA_TPHSENSOR::Pressure, 32>,
+	BpRawField<BLEADV_MANDATA_TPHSENSOR, int16_t, &BLEADV_MANDATA_TPHSENSOR::Temperature>,
+	BpField<BLEADV_MANDATA_TPHSENSOR, uint16_t, &BLEADV_MANDATA_TPHSENSOR::Humidity, 16>
+> BLEADV_MANDATA_TPHSENSOR_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_GASSENSOR, uint32_t, &BLEADV_MANDATA_GASSENSOR::GasRes, 32>,
+	BpField<BLEADV_MANDATA_GASSENSOR, uint16_t, &BLEADV_MANDATA_GASSENSOR::AirQIdx, 16>
+> BLEADV_MANDATA_GASSENSOR_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_IMUSENSOR, uint16_t, &BLEADV_MANDATA_IMUSENSOR::x, 16>,
+	BpField<BLEADV_MANDATA_IMUSENSOR, uint16_t, &BLEADV_MANDATA_IMUSENSOR::y, 16>,
+	BpField<BLEADV_MANDATA_IMUSENSOR, uint16_t, &BLEADV_MANDATA_IMUSENSOR::z, 16>
+> BLEADV_MANDATA_IMUSENSOR_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_GPIO, uint32_t, &BLEADV_MANDATA_GPIO::State, 32>
+> BLEADV_MANDATA_GPIO_LAYOUT;
+
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_BUT, uint32_t, &BLEADV_MANDATA_BUT::State, 32>
+> BLEADV_MANDATA_BUT_LAYOUT;
+
+// BLEADV manufacturer data, compact
+
+/// Same ranges as BLUEIO_DATA_TPH_COMPACT
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_TPHSENSOR, int16_t, &BLEADV_MANDATA_TPHSENSOR::Temperature, 12, -4000, 5>,
+	BpField<BLEADV_MANDATA_TPHSENSOR, uint32_t, &BLEADV_MANDATA_TPHSENSOR::Pressure, 20, 30000>,
+	BpField<BLEADV_MANDATA_TPHSENSOR, uint16_t, &BLEADV_MANDATA_TPHSENSOR::Humidity, 12, 0, 3>
+> BLEADV_MANDATA_TPHSENSOR_COMPACT;
+
+/// Gas resistance 24 bits, air quality index 0 to 511
+typedef BpLayout<BPENDIAN_LITTLE,
+	BpField<BLEADV_MANDATA_GASSENSOR, uint32_t, &BLEADV_MANDATA_GASSENSOR::GasRes, 24>,
+	BpField<BLEADV_MANDATA_GASSENSOR, uint16_t, &BLEADV_MANDATA_GASSENSOR::AirQIdx, 9>
+> BLEADV_MANDATA_GASSENSOR_COMPACT;
+
+/** @} End of group Utilities */
+
+#endif // __cplusplus
+
+#endif // __BLUEIO_BITPACK_H__
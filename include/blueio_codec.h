@@ -0,0 +1,260 @@
+/**-------------------------------------------------------------------------
+@file	blueio_codec.h
+
+@brief	Compact streaming record codec for BLUEIO sensor data
+
+Records are described by a schema listing the offset and type of each field
+of the BLUEIO_DATA_xxx structure. Records are packed into blocks sized to fit a
+transport packet (i.e. BLE notification). Each field is encoded as the zigzag
+varint of its difference to a prediction from the previous records.  Slowly
+changing sensor data compresses to 1 byte per field most of the time.
+
+The prediction is the previous value, or for schemas with BLUEIO_CODEC_PRED_LINEAR
+the linear extrapolation of the 2 previous values.  Motion sensors sampled well
+above their signal bandwidth move by hundreds of counts per sample, their second
+difference stays within the 1 byte range.
+
+Block format :
+
+	Id		: BLUEIO_CODEC_ID(DataType), distinct from verbatim BLUEIO packet ids
+	Flags	: BLUEIO_CODEC_FLAG_xxx | 6 bits block sequence number
+	Records	: [varint time] + one varint per field, up to end of block
+
+Timestamps are optional. When present, the first record of a key block holds
+the absolute time base. Each other record holds the zigzag varint of the change
+of its sample interval, 1 byte for a regularly sampled sensor with jitter.
+
+A block flagged BLUEIO_CODEC_FLAG_KEY holds absolute values for its first
+record and can be decoded on its own.  The encoder emits a key block every
+KeyInterval records.  Other blocks depend on the previous block.  The decoder
+detects missing blocks using the sequence number, drops blocks until the next key
+block and then resumes.
+
+Float fields are coded on their IEEE bit pattern, lossless.
+
+Usage :
+
+	BLUEIO_ENCODER enc;
+
+	BlueIOEncInit(&enc, &g_BlueIOSchemaAccel, 64, true);
+	BlueIOEncBegin(&enc, pktbuff, 20);
+	while (BlueIOEncPut(&enc, &AccelData, TimeUs) == true) { ... }
+	int len = BlueIOEncEnd(&enc);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLUEIO_CODEC_H__
+#define __BLUEIO_CODEC_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "blueio_types.h"
+
+/** @addtogroup Bluetooth
+  * @{
+  */
+
+#define BLUEIO_CODEC_ID_FLAG			0x80	//!< Set in block id, verbatim BLUEIO packets ids are lower
+#define BLUEIO_CODEC_ID(DataType)		(BLUEIO_CODEC_ID_FLAG | (DataType))
+
+#define BLUEIO_CODEC_FLAG_KEY			(1<<7)	//!< First record holds absolute values
+#define BLUEIO_CODEC_FLAG_TIME			(1<<6)	//!< Records have timestamps
+#define BLUEIO_CODEC_SEQ_MASK			0x3F	//!< Block sequence number bits
+
+#define BLUEIO_CODEC_BLKHDR_LEN			2		//!< Block header length
+#define BLUEIO_CODEC_RECSIZE_MAX		32		//!< Max record size in bytes
+
+#define BLUEIO_CODEC_PRED_DELTA			1		//!< Predict previous value
+#define BLUEIO_CODEC_PRED_LINEAR		2		//!< Predict 2 * previous - second previous
+
+/// Record field types
+typedef enum __BlueIO_Field_Type {
+	BLUEIO_FIELDTYPE_U8,
+	BLUEIO_FIELDTYPE_S8,
+	BLUEIO_FIELDTYPE_U16,
+	BLUEIO_FIELDTYPE_S16,
+	BLUEIO_FIELDTYPE_U32,
+	BLUEIO_FIELDTYPE_S32,
+	BLUEIO_FIELDTYPE_F32,		//!< float, coded on its bit pattern
+} BLUEIO_FIELDTYPE;
+
+#pragma pack(push, 4)
+
+/// Record field descriptor
+typedef struct __BlueIO_Field {
+	uint8_t Offset;				//!< Offset of field in record
+	BLUEIO_FIELDTYPE Type;		//!< Field type
+} BLUEIO_FIELD;
+
+/// Record schema
+typedef struct __BlueIO_Schema {
+	uint8_t DataType;			//!< BLUEIO_DATA_TYPE_xxx
+	uint8_t RecSize;			//!< Record size in bytes
+	uint8_t Pred;				//!< Predictor, BLUEIO_CODEC_PRED_xxx
+	int NbField;				//!< Number of fields
+	const BLUEIO_FIELD *pField;	//!< Field array
+} BLUEIO_SCHEMA;
+
+/// Encoder instance data
+typedef struct __BlueIO_Encoder {
+	const BLUEIO_SCHEMA *pSchema;
+	uint16_t KeyInterval;		//!< Records between key blocks
+	bool bTime;					//!< Encode timestamps
+	uint8_t Seq;				//!< Next block sequence number
+	uint32_t RecSinceKey;		//!< Records encoded since last key block
+	uint64_t PrevTime;			//!< Timestamp of previous record
+	uint64_t PrevIntv;			//!< Previous sample interval
+	uint8_t Prev[BLUEIO_CODEC_RECSIZE_MAX];	//!< Previous record
+	uint8_t Prev2[BLUEIO_CODEC_RECSIZE_MAX];	//!< Second previous record
+	uint8_t Hist;				//!< Number of valid previous records, up to 2
+	uint8_t *pBlk;				//!< Current block buffer
+	int BlkSize;				//!< Current block buffer size
+	int BlkLen;					//!< Current block length
+	int Cnt;					//!< Records in current block
+	bool bKey;					//!< Current block is a key block
+} BLUEIO_ENCODER;
+
+/// Decoder instance data
+typedef struct __BlueIO_Decoder {
+	const BLUEIO_SCHEMA *pSchema;
+	bool bSync;					//!< Previous record is valid
+	uint8_t Seq;				//!< Expected block sequence number
+	uint64_t PrevTime;			//!< Timestamp of previous record
+	uint64_t PrevIntv;			//!< Previous sample interval
+	uint8_t Prev[BLUEIO_CODEC_RECSIZE_MAX];	//!< Previous record
+	uint8_t Prev2[BLUEIO_CODEC_RECSIZE_MAX];	//!< Second previous record
+	uint8_t Hist;				//!< Number of valid previous records, up to 2
+	uint32_t LostCnt;			//!< Number of missing blocks detected
+	uint32_t DropCnt;			//!< Number of blocks dropped waiting for a key block
+} BLUEIO_DECODER;
+
+#pragma pack(pop)
+
+extern const BLUEIO_SCHEMA g_BlueIOSchemaTph;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaGas;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaAccel;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaGyro;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaMag;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaProxy;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaAdc;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaGpio;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaMotion;
+extern const BLUEIO_SCHEMA g_BlueIOSchemaBat;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Find predefined schema of a data type
+ *
+ * @param	DataType : BLUEIO_DATA_TYPE_xxx
+ *
+ * @return	Pointer to schema, NULL if type has no schema
+ */
+const BLUEIO_SCHEMA *BlueIOSchemaFind(uint8_t DataType);
+
+/**
+ * @brief	Initialize encoder
+ *
+ * @param	pEnc		: Pointer to encoder instance data
+ * @param	pSchema		: Record schema
+ * @param	KeyInterval	: Emit a key block when that many records were encoded since
+ * 						  the last one. 0 makes every block a key block
+ * @param	bTime		: true to encode timestamps
+ *
+ * @return	true - success
+ */
+bool BlueIOEncInit(BLUEIO_ENCODER * const pEnc, const BLUEIO_SCHEMA * const pSchema, uint16_t KeyInterval, bool bTime);
+
+/**
+ * @brief	Start a new block
+ *
+ * @param	pEnc		: Pointer to encoder instance data
+ * @param	pBuff		: Block buffer, i.e. notification payload
+ * @param	BuffSize	: Block buffer size in bytes
+ *
+ * @return	false - Buffer too small for header
+ */
+bool BlueIOEncBegin(BLUEIO_ENCODER * const pEnc, uint8_t *pBuff, int BuffSize);
+
+/**
+ * @brief	Add a record to current block
+ *
+ * @param	pEnc		: Pointer to encoder instance data
+ * @param	pRec		: Pointer to BLUEIO_DATA_xxx record
+ * @param	Timestamp	: Record timestamp, must not be lower than previous one
+ *
+ * @return	false - Block full, record not added. End block and put it in next one
+ */
+bool BlueIOEncPut(BLUEIO_ENCODER * const pEnc, const void *pRec, uint64_t Timestamp);
+
+/**
+ * @brief	Complete current block
+ *
+ * @param	pEnc	: Pointer to encoder instance data
+ *
+ * @return	Block length in bytes, 0 if it has no record
+ */
+int BlueIOEncEnd(BLUEIO_ENCODER * const pEnc);
+
+/**
+ * @brief	Initialize decoder
+ *
+ * @param	pDec	: Pointer to decoder instance data
+ * @param	pSchema	: Record schema
+ *
+ * @return	true - success
+ */
+bool BlueIODecInit(BLUEIO_DECODER * const pDec, const BLUEIO_SCHEMA * const pSchema);
+
+/**
+ * @brief	Decode one block
+ *
+ * @param	pDec		: Pointer to decoder instance data
+ * @param	pBlk		: Pointer to block
+ * @param	Len			: Block length in bytes
+ * @param	pRec		: Buffer receiving decoded records
+ * @param	pTimestamp	: Buffer receiving record timestamps, can be NULL
+ * @param	MaxRec		: Max number of records the buffers can hold
+ *
+ * @return	Number of records decoded. 0 if block is dropped waiting for a key block.
+ * 			-1 if block is malformed or buffers too small
+ */
+int BlueIODecBlock(BLUEIO_DECODER * const pDec, const uint8_t *pBlk, int Len, void *pRec,
+				   uint64_t *pTimestamp, int MaxRec);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Bluetooth */
+
+#endif // __BLUEIO_CODEC_H__
@@ -0,0 +1,270 @@
+/**-------------------------------------------------------------------------
+@file	ble_ntfpump.h
+
+@brief	Batched BLE notification pump.
+
+Coalesces small writes into full ATT payload (MTU - 3) packets and pushes as
+many of them into the BLE stack notification queue as it will take. Packets
+rejected because the stack queue is full stay in place and are retried on the
+next transmit complete event. No copy is made.
+
+The pump is stack agnostic. The stack is accessed through a single send
+callback so that the packing and queueing logic can be run on host against
+a simulated stack.
+
+A partially filled packet is only sent when fewer than PartialInFlight packets
+are pending in the stack. Otherwise it keeps coalescing new data until the next
+transmit complete event. Full packets are always sent immediately.
+
+Usage :
+
+	static uint8_t s_PumpMem[BLENTFPUMP_MEMSIZE(8, 244)];
+
+	BLENTFPUMP_CFG cfg = {
+		.pMem = s_PumpMem,
+		.MemSize = sizeof(s_PumpMem),
+		.MaxPayload = 244,
+		.PartialInFlight = 1,
+		.SendCB = MySendNotify,
+		.pCtx = &MyChar,
+	};
+	BleNtfPumpInit(&g_Pump, &cfg);
+
+	// On MTU exchanged
+	BleNtfPumpSetMtu(&g_Pump, AttMtu);
+
+	// Producer
+	BleNtfPumpWrite(&g_Pump, pData, DataLen);
+
+	// On stack transmit complete event
+	BleNtfPumpTxComplete(&g_Pump, Count);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLE_NTFPUMP_H__
+#define __BLE_NTFPUMP_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+	#include <atomic>
+	using namespace std;
+#else
+	#include <stdatomic.h>
+#endif
+
+/** @addtogroup Bluetooth
+  * @{
+  */
+
+#define BLENTFPUMP_ATT_HDR_LEN			3		//!< ATT notification opcode + handle
+#define BLENTFPUMP_DEFAULT_MTU			23		//!< ATT MTU before MTU exchange
+#define BLENTFPUMP_DEFAULT_PAYLOAD		(BLENTFPUMP_DEFAULT_MTU - BLENTFPUMP_ATT_HDR_LEN)
+
+/// Memory size in bytes required for NbPkt packets of MaxPayload bytes
+#define BLENTFPUMP_MEMSIZE(NbPkt, MaxPayload)	((NbPkt) * (((MaxPayload) + 2 + 3) & ~3))
+
+/// Result of the send callback
+typedef enum __Ble_NtfPump_SendRes {
+	BLENTFPUMP_SENDRES_OK,		//!< Packet accepted by the stack
+	BLENTFPUMP_SENDRES_BUSY,	//!< Stack queue full, retry on next transmit complete
+	BLENTFPUMP_SENDRES_FAIL,	//!< Packet rejected, drop it
+} BLENTFPUMP_SENDRES;
+
+/**
+ * @brief	Send callback.
+ *
+ * Queue one notification into the BLE stack. The stack must have copied the
+ * data when returning BLENTFPUMP_SENDRES_OK.
+ *
+ * @param	pCtx	: User context pointer from config
+ * @param	pData	: Pointer to payload
+ * @param	Len		: Payload length in bytes
+ *
+ * @return	Send result
+ */
+typedef BLENTFPUMP_SENDRES (*BLENTFPUMP_SENDCB)(void *pCtx, uint8_t *pData, uint16_t Len);
+
+#pragma pack(push, 4)
+
+/// Notification pump configuration
+typedef struct __Ble_NtfPump_Config {
+	uint8_t *pMem;				//!< Packet memory, see BLENTFPUMP_MEMSIZE
+	uint32_t MemSize;			//!< Packet memory size in bytes
+	uint16_t MaxPayload;		//!< Max payload per packet. Max ATT MTU - 3
+	uint16_t PartialInFlight;	//!< Send partial packet only when fewer packets are in flight. 0 defaults to 1
+	BLENTFPUMP_SENDCB SendCB;	//!< Stack send callback
+	void *pCtx;					//!< User context passed to SendCB
+} BLENTFPUMP_CFG;
+
+/// Packet slot layout in pump memory
+typedef struct __Ble_NtfPump_Packet {
+	uint16_t Len;				//!< Payload length in bytes
+	uint8_t Data[1];			//!< Payload, variable length
+} BLENTFPUMP_PKT;
+
+/// Notification pump instance data
+typedef struct __Ble_NtfPump {
+	uint8_t *pMem;				//!< Packet memory
+	uint16_t SlotSize;			//!< Slot size in bytes
+	uint16_t NbSlot;			//!< Total number of packet slots
+	uint16_t MaxPayload;		//!< Max payload per packet
+	uint16_t Payload;			//!< Current payload per packet (ATT MTU - 3)
+	uint16_t PartialInFlight;	//!< Partial packet send threshold
+	volatile uint16_t Head;		//!< Index of oldest queued packet
+	volatile uint16_t Cnt;		//!< Number of queued packets
+	volatile bool bTailOpen;	//!< Last queued packet still accepts data
+	uint16_t InFlight;			//!< Packets accepted by the stack not yet transmitted. Owner only
+	atomic_uint TxDone;			//!< Transmitted count reported by TxComplete, applied by the owner
+	atomic_flag bBusy;			//!< Pump owned by a context
+	volatile bool bPending;		//!< Process requested while owned by another context
+	BLENTFPUMP_SENDCB SendCB;	//!< Stack send callback
+	void *pCtx;					//!< User context passed to SendCB
+	uint32_t PktCnt;			//!< Total packets sent
+	uint32_t ByteCnt;			//!< Total payload bytes sent
+	uint32_t BusyCnt;			//!< Number of send rejected with stack queue full
+	uint32_t DropCnt;			//!< Number of packets dropped on send failure
+} BLENTFPUMP;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize notification pump.
+ *
+ * Packet payload starts at the default ATT MTU. Call BleNtfPumpSetMtu once the
+ * MTU has been exchanged.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ * @param	pCfg	: Pointer to configuration data
+ *
+ * @return	true - Success
+ */
+bool BleNtfPumpInit(BLENTFPUMP * const pPump, const BLENTFPUMP_CFG * const pCfg);
+
+/**
+ * @brief	Set the effective ATT MTU.
+ *
+ * Packet payload becomes MTU - 3, limited to MaxPayload. Packets already
+ * queued at a larger payload are split at send time.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ * @param	Mtu		: Effective ATT MTU
+ */
+void BleNtfPumpSetMtu(BLENTFPUMP * const pPump, uint16_t Mtu);
+
+/**
+ * @brief	Queue data and send what can be sent.
+ *
+ * Data is appended to the last open packet first, then to new packets.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ * @param	pData	: Pointer to data
+ * @param	DataLen	: Data length in bytes
+ *
+ * @return	Number of bytes queued. Less than DataLen when pump is full
+ */
+int BleNtfPumpWrite(BLENTFPUMP * const pPump, const uint8_t *pData, int DataLen);
+
+/**
+ * @brief	Push queued packets into the stack.
+ *
+ * Safe to call from any context. If the pump is owned by a preempted context,
+ * the request is recorded and executed by the owner before releasing it.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ */
+void BleNtfPumpProcess(BLENTFPUMP * const pPump);
+
+/**
+ * @brief	Stack transmit complete event.
+ *
+ * The count is accumulated atomically and applied to the in flight count by the
+ * context owning the pump, so it is safe to call from the stack event handler.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ * @param	Count	: Number of packets transmitted. 0 if unknown, all in flight
+ * 					  packets are considered transmitted.
+ */
+void BleNtfPumpTxComplete(BLENTFPUMP * const pPump, int Count);
+
+/**
+ * @brief	Get number of bytes that can be queued.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ *
+ * @return	Free space in bytes at current payload size
+ */
+int BleNtfPumpAvail(BLENTFPUMP * const pPump);
+
+/**
+ * @brief	Discard all queued data and in flight count.
+ *
+ * Call on disconnect.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ */
+void BleNtfPumpReset(BLENTFPUMP * const pPump);
+
+/**
+ * @brief	Get number of queued packets.
+ *
+ * @param	pPump	: Pointer to pump instance data
+ *
+ * @return	Number of packets waiting to be sent
+ */
+static inline int BleNtfPumpPending(BLENTFPUMP * const pPump) { return pPump->Cnt; }
+
+/**
+ * @brief	stdio device write function, pDevObj is the pump.
+ *
+ * Lets the pump be installed as a stdio device so the notification stream can
+ * be written & polled along with the UART & file descriptors.
+ *
+ * 		STDDEV g_BleStdDev = { "BLE", &g_Pump, NULL, NULL, NULL,
+ * 							   BleNtfPumpStdDevWrite, NULL, BleNtfPumpStdDevPoll };
+ * 		int fd = InstallBlkDev(&g_BleStdDev, STDDEV_USER_FILENO);
+ */
+int BleNtfPumpStdDevWrite(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len);
+
+/// stdio device poll function, POLLOUT when the pump has free space
+int BleNtfPumpStdDevPoll(void * const pDevObj, int Handle, int Events);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Bluetooth */
+
+#endif // __BLE_NTFPUMP_H__
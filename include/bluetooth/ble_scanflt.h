@@ -0,0 +1,280 @@
+/**-------------------------------------------------------------------------
+@file	ble_scanflt.h
+
+@brief	BLE central scan report filter & deduplication engine.
+
+Sits between the stack advertising report event and the application so that
+dense beacon deployments do not flood the main loop.
+
+	- Filters on address, 16/128 bits service UUID and manufacturer data
+	  prefix, compiled into a small match table at init (sorted addresses &
+	  16 bits UUIDs, AD structures parsed once only when needed). A report
+	  passes when there is no filter or it matches any of them, and its RSSI
+	  is at least MinRssi.
+	- Fixed size open addressing device table keyed by address. Reports with
+	  the same payload as the last one of a device seen within DedupWindow
+	  only update its smoothed RSSI. Devices not seen for DedupWindow expire.
+	- RSSI smoothed per device by an exponential moving average.
+	- Devices that are new, changed payload or moved smoothed RSSI by RssiDelta
+	  are queued once and delivered in batches from the main loop by
+	  BleScanFltFlush.
+
+No stack dependency. BleScanFltPut may be called from the stack event handler
+while BleScanFltFlush runs in the main loop. A report arriving while a flush
+holds the table is dropped and counted.
+
+Usage :
+
+	static const BLESCANFLT_FILTER s_Filter[] = {
+		{ BLESCANFLT_TYPE_MANDATA, 2, { 0x77, 0x01 } },		// Company ID 0x0177
+		{ BLESCANFLT_TYPE_UUID16, 2, { 0xAA, 0xFE } },		// Eddystone
+	};
+	static BLESCANFLT_DEV s_DevTbl[256];
+	static uint16_t s_DevQue[256];
+	static BLESCANFLT_DEV s_Batch[16];
+
+	void ScanDevHandler(void *pCtx, const BLESCANFLT_DEV *pDev, int Count) { ... }
+
+	BLESCANFLT_CFG cfg = {
+		s_Filter, 2, -90, 5000, 6, 2, s_DevTbl, s_DevQue, 256, s_Batch, 16, ScanDevHandler, NULL
+	};
+	BleScanFltInit(&g_ScanFlt, &cfg);
+	BleAppScanFilterSet(&g_ScanFlt);
+	...
+	// Main loop, every 100 ms
+	BleScanFltFlush(&g_ScanFlt, msTime);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLE_SCANFLT_H__
+#define __BLE_SCANFLT_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+	#include <atomic>
+	using namespace std;
+#else
+	#include <stdatomic.h>
+#endif
+
+/** @addtogroup Bluetooth
+  * @{
+  */
+
+#define BLESCANFLT_ADDR_LEN			6		//!< BLE device address length
+#define BLESCANFLT_DATA_MAX			31		//!< Max advertising payload kept per device (legacy size)
+#define BLESCANFLT_FILTER_DATA_MAX	16		//!< Max filter data length
+#define BLESCANFLT_FILTER_MAX		16		//!< Max number of filters
+#define BLESCANFLT_PROBE_MAX		8		//!< Max device table probe length
+
+/// Filter types
+typedef enum __Ble_ScanFlt_Type {
+	BLESCANFLT_TYPE_ADDR,		//!< Device address, 6 bytes LSB first
+	BLESCANFLT_TYPE_UUID16,		//!< 16 bits service UUID, 2 bytes little endian
+	BLESCANFLT_TYPE_UUID128,	//!< 128 bits service UUID, 16 bytes little endian
+	BLESCANFLT_TYPE_MANDATA,	//!< Manufacturer data prefix, company ID first, 1 to 16 bytes
+} BLESCANFLT_TYPE;
+
+#pragma pack(push, 4)
+
+/// Report filter
+typedef struct __Ble_ScanFlt_Filter {
+	BLESCANFLT_TYPE Type;		//!< Filter type
+	uint8_t Len;				//!< Data length in bytes
+	uint8_t Data[BLESCANFLT_FILTER_DATA_MAX];	//!< Data to match
+} BLESCANFLT_FILTER;
+
+/// Advertising report, as received from the stack
+typedef struct __Ble_ScanFlt_Report {
+	uint8_t Addr[BLESCANFLT_ADDR_LEN];	//!< Device address
+	uint8_t AddrType;			//!< Address type
+	int8_t Rssi;				//!< Received signal strength in dBm
+	const uint8_t *pData;		//!< Advertising payload (AD structures)
+	uint16_t Len;				//!< Payload length in bytes
+} BLESCANFLT_REPORT;
+
+/// Device table entry, also the record delivered to the application
+typedef struct __Ble_ScanFlt_Dev {
+	uint8_t Addr[BLESCANFLT_ADDR_LEN];	//!< Device address
+	uint8_t AddrType;			//!< Address type
+	uint8_t Len;				//!< Payload length, truncated to BLESCANFLT_DATA_MAX
+	uint8_t Data[BLESCANFLT_DATA_MAX];	//!< Last advertising payload
+	int16_t RssiQ4;				//!< Smoothed RSSI, dBm Q4 fixed point
+	int8_t Rssi;				//!< Last RSSI in dBm
+	int8_t RssiSent;			//!< Smoothed RSSI in dBm at last delivery
+	uint32_t DataHash;			//!< Payload hash, 0 - free entry
+	uint32_t FirstSeen;			//!< Time of first report in msec
+	uint32_t LastSeen;			//!< Time of last report in msec
+	uint32_t Count;				//!< Number of reports since first seen
+	volatile bool bQueued;		//!< Waiting for delivery
+	bool bNew;					//!< Not delivered yet since first seen
+} BLESCANFLT_DEV;
+
+/**
+ * @brief	Device batch delivery callback.
+ *
+ * @param	pCtx	: User context pointer from config
+ * @param	pDev	: Array of new or changed devices
+ * @param	Count	: Number of devices in array
+ */
+typedef void (*BLESCANFLT_EVTCB)(void *pCtx, const BLESCANFLT_DEV *pDev, int Count);
+
+/// Scan filter engine configuration
+typedef struct __Ble_ScanFlt_Config {
+	const BLESCANFLT_FILTER *pFilter;	//!< Filter list, NULL - accept all
+	int NbFilter;				//!< Number of filters, max BLESCANFLT_FILTER_MAX
+	int8_t MinRssi;				//!< Min RSSI in dBm, -128 - no limit
+	uint32_t DedupWindow;		//!< Dedup window & device expiry in msec
+	uint8_t RssiDelta;			//!< Smoothed RSSI change in dB to redeliver, 0 - never
+	uint8_t RssiShift;			//!< RSSI average weight 1/2^RssiShift, 0 - no smoothing
+	BLESCANFLT_DEV *pDevTbl;	//!< Device table memory
+	uint16_t *pQue;				//!< Delivery queue memory, NbDev entries
+	int NbDev;					//!< Number of device table entries, power of 2, max 32768
+	BLESCANFLT_DEV *pBatch;		//!< Batch delivery buffer
+	int BatchSize;				//!< Number of entries in batch buffer
+	BLESCANFLT_EVTCB EvtCB;		//!< Batch delivery callback
+	void *pCtx;					//!< User context passed to EvtCB
+} BLESCANFLT_CFG;
+
+/// Scan filter engine instance data
+typedef struct __Ble_ScanFlt {
+	uint64_t AddrKey[BLESCANFLT_FILTER_MAX];	//!< Sorted address filters
+	uint16_t Uuid16[BLESCANFLT_FILTER_MAX];		//!< Sorted 16 bits UUID filters
+	const BLESCANFLT_FILTER *pUuid128[BLESCANFLT_FILTER_MAX];	//!< 128 bits UUID filters
+	const BLESCANFLT_FILTER *pManData[BLESCANFLT_FILTER_MAX];	//!< Manufacturer data filters
+	uint8_t NbAddr;				//!< Number of address filters
+	uint8_t NbUuid16;			//!< Number of 16 bits UUID filters
+	uint8_t NbUuid128;			//!< Number of 128 bits UUID filters
+	uint8_t NbManData;			//!< Number of manufacturer data filters
+	bool bAcceptAll;			//!< No filter
+	int8_t MinRssi;				//!< Min RSSI in dBm
+	uint8_t RssiDelta;			//!< Smoothed RSSI change to redeliver
+	uint8_t RssiShift;			//!< RSSI average weight
+	uint32_t DedupWindow;		//!< Dedup window in msec
+	BLESCANFLT_DEV *pDevTbl;	//!< Device table
+	uint16_t DevMask;			//!< Device table size - 1
+	uint16_t *pQue;				//!< Delivery queue of device indexes
+	volatile uint16_t QueHead;	//!< Delivery queue head
+	volatile uint16_t QueCnt;	//!< Delivery queue count
+	BLESCANFLT_DEV *pBatch;		//!< Batch delivery buffer
+	int BatchSize;				//!< Batch buffer size
+	BLESCANFLT_EVTCB EvtCB;		//!< Batch delivery callback
+	void *pCtx;					//!< User context passed to EvtCB
+	volatile uint32_t CurTime;	//!< Current time in msec, set by flush
+	atomic_flag bBusy;			//!< Table owned by a context
+	uint32_t RxCnt;				//!< Total reports received
+	uint32_t FltCnt;			//!< Reports rejected by filters
+	uint32_t DupCnt;			//!< Duplicate reports suppressed
+	uint32_t NewCnt;			//!< New devices
+	uint32_t EvictCnt;			//!< Live devices evicted by table full
+	uint32_t DropCnt;			//!< Reports dropped while flush held the table
+	uint32_t DlvCnt;			//!< Device records delivered
+} BLESCANFLT;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize scan filter engine.
+ *
+ * Compiles the filter list into the match table. Filters are referenced, the
+ * list must stay valid.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ * @param	pCfg	: Pointer to configuration data
+ *
+ * @return	true - Success
+ */
+bool BleScanFltInit(BLESCANFLT * const pFlt, const BLESCANFLT_CFG * const pCfg);
+
+/**
+ * @brief	Process one advertising report.
+ *
+ * Called from the stack event handler.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ * @param	pRpt	: Pointer to report
+ *
+ * @return	true - Device queued for delivery (new or changed)
+ */
+bool BleScanFltPut(BLESCANFLT * const pFlt, const BLESCANFLT_REPORT * const pRpt);
+
+/**
+ * @brief	Deliver queued devices.
+ *
+ * Copies queued devices into the batch buffer and calls the callback once per
+ * batch, until the queue is empty. Also sets the engine time used to stamp
+ * reports, so call it periodically from the main loop.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ * @param	CurTime	: Current time in msec
+ *
+ * @return	Number of devices delivered
+ */
+int BleScanFltFlush(BLESCANFLT * const pFlt, uint32_t CurTime);
+
+/**
+ * @brief	Test report against the match table only.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ * @param	pRpt	: Pointer to report
+ *
+ * @return	true - Report passes filters
+ */
+bool BleScanFltMatch(BLESCANFLT * const pFlt, const BLESCANFLT_REPORT * const pRpt);
+
+/**
+ * @brief	Clear device table and delivery queue.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ */
+void BleScanFltReset(BLESCANFLT * const pFlt);
+
+/**
+ * @brief	Set engine time without delivering.
+ *
+ * @param	pFlt	: Pointer to engine instance data
+ * @param	CurTime	: Current time in msec
+ */
+static inline void BleScanFltSetTime(BLESCANFLT * const pFlt, uint32_t CurTime) {
+	pFlt->CurTime = CurTime;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Bluetooth */
+
+#endif // __BLE_SCANFLT_H__
@@ -43,6 +43,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 /// Manufacture specific advertisement data type
 #define BLEADV_MANDATA_TYPE_SN			0xFF						//!< Device Serial Number or UID (8 bytes)
+#define BLEADV_MANDATA_TYPE_PACKED		0xFE						//!< Multiple bit packed readings (see bleadv_packer.h)
 #define BLEADV_MANDATA_TYPE_TPH			BLUEIO_DATA_TYPE_TPH		//!< Environmental sensor data (Temperature, Pressure, Humidity)
 #define BLEADV_MANDATA_TYPE_GAS			BLUEIO_DATA_TYPE_GAS		//!< Gas sensor data
 #define BLEADV_MANDATA_TYPE_ACCEL		BLUEIO_DATA_TYPE_ACCEL		//!< Accelerometer sensor data
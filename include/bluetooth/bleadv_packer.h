@@ -0,0 +1,224 @@
+/**-------------------------------------------------------------------------
+@file	bleadv_packer.h
+
+@brief	Bit packed multi-reading advertising payload.
+
+Packs several typed sensor readings into one manufacturer specific data
+payload. Each reading is a 4 bits tag followed by its fields. Each field is
+range reduced to the fewest bits: value is clamped to [Min, Min + Step * (2^NbBits - 1)]
+and sent as (Value - Min) / Step. TPH, gas, battery, buttons & accel fit
+together in a 31 bytes legacy advertisement.
+
+Payload format, as BLEADV_MANDATA :
+
+	Type	: BLEADV_MANDATA_TYPE_PACKED
+	Seq		: Incremented on each new payload, for receiver dedup
+	Data	: LSB first bit stream of { Tag:4, Field0, Field1, ... }, tag 0 ends
+
+A scheduler chooses which readings go into each payload when they do not all fit.
+Each reading slot has a priority. Its score grows with the time since it was last
+sent, doubled when its value changed. Slots are packed by decreasing score while
+they fit. Readings older than their MaxAge are not sent.
+
+The encoder/decoder has no stack dependency.
+
+Usage :
+
+	static BLEADV_PACK_SLOT s_Slot[] = {
+		{ &g_BleAdvPackTypeTph, 4, 60000 },
+		{ &g_BleAdvPackTypeBat, 1, 0 },
+	};
+	BLEADV_PACKER packer;
+
+	BleAdvPackInit(&packer, s_Slot, 2);
+	...
+	int32_t tph[] = { Temperature, Pressure, Humidity };
+	BleAdvPackUpdate(&packer, 0, tph, msTime);
+	...
+	int len = BleAdvPackBuild(&packer, buff, BLEADV_PACK_LEGACY_LEN, msTime);
+	BleAppAdvManDataSet(buff, len, NULL, 0);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __BLEADV_PACKER_H__
+#define __BLEADV_PACKER_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "bluetooth/bleadv_mandata.h"
+
+/** @addtogroup Bluetooth
+  * @{
+  */
+
+#define BLEADV_PACK_LEGACY_LEN		24		//!< Legacy 31 bytes advertisement less flags & manufacturer AD header
+#define BLEADV_PACK_EXT_LEN			248		//!< Extended 255 bytes advertisement less flags & manufacturer AD header
+#define BLEADV_PACK_HDR_LEN			2		//!< Type + Seq
+#define BLEADV_PACK_TAG_BITS		4
+#define BLEADV_PACK_FIELD_MAX		4		//!< Max number of fields per reading
+#define BLEADV_PACK_SLOT_MAX		64		//!< Max number of slots per packer
+
+/// Predefined reading tags. 0 marks end of data
+#define BLEADV_PACK_TAG_END			0
+#define BLEADV_PACK_TAG_TPH			1		//!< Temperature, Pressure, Humidity
+#define BLEADV_PACK_TAG_GAS			2		//!< Gas resistance, air quality index
+#define BLEADV_PACK_TAG_BAT			3		//!< Battery level & voltage
+#define BLEADV_PACK_TAG_BUT			4		//!< Button states
+#define BLEADV_PACK_TAG_ACCEL		5		//!< Accelerometer x, y, z
+#define BLEADV_PACK_TAG_USER		8		//!< First tag for user defined types. Max 15
+
+#pragma pack(push, 4)
+
+/// Range reduced field
+typedef struct __BleAdv_Pack_Field {
+	int32_t Min;				//!< Lowest value
+	uint32_t Step;				//!< Quantization step in value unit
+	uint8_t NbBits;				//!< Encoded size in bits, 1 to 32
+} BLEADV_PACK_FIELD;
+
+/// Reading type descriptor
+typedef struct __BleAdv_Pack_Type {
+	uint8_t Tag;				//!< Reading tag, 1 to 15
+	uint8_t NbField;			//!< Number of fields, max BLEADV_PACK_FIELD_MAX
+	const BLEADV_PACK_FIELD *pField;	//!< Field array
+} BLEADV_PACK_TYPE;
+
+/// Reading slot. Type, Priority & MaxAge are set by user, other members by the packer
+typedef struct __BleAdv_Pack_Slot {
+	const BLEADV_PACK_TYPE *pType;	//!< Reading type
+	uint8_t Priority;			//!< Scheduling weight, 0 never sent
+	uint32_t MaxAge;			//!< Stop sending reading older than this, 0 no limit
+	int32_t Val[BLEADV_PACK_FIELD_MAX];	//!< Current field values
+	uint32_t UpdateTime;		//!< Time of last update
+	uint32_t SentTime;			//!< Time last sent
+	bool bValid;				//!< Has a value
+	bool bChanged;				//!< Value changed since last sent
+} BLEADV_PACK_SLOT;
+
+/// Packer instance data
+typedef struct __BleAdv_Packer {
+	BLEADV_PACK_SLOT *pSlot;	//!< Slot array
+	int NbSlot;					//!< Number of slots
+	uint8_t Seq;				//!< Payload sequence number
+} BLEADV_PACKER;
+
+/// Decoded reading
+typedef struct __BleAdv_Pack_Reading {
+	uint8_t Tag;						//!< Reading tag
+	int32_t Val[BLEADV_PACK_FIELD_MAX];	//!< Field values
+} BLEADV_PACK_READING;
+
+#pragma pack(pop)
+
+/// TPH : Temperature -40 to 85 C 0.05 step, Pressure 30 to 110 kPa 2 Pa step, Humidity 0.5 % step.
+/// Same units as BLEADV_MANDATA_TPHSENSOR
+extern const BLEADV_PACK_TYPE g_BleAdvPackTypeTph;
+/// Gas : Resistance 64 ohm step up to 4 Mohm, air quality index 0 to 511
+extern const BLEADV_PACK_TYPE g_BleAdvPackTypeGas;
+/// Battery : Level 0 to 100 %, voltage 1.8 to 4.35 V 10 mV step
+extern const BLEADV_PACK_TYPE g_BleAdvPackTypeBat;
+/// Buttons : 8 states bit field
+extern const BLEADV_PACK_TYPE g_BleAdvPackTypeBut;
+/// Accel : x, y, z in mG, +/- 8 G 16 mG step
+extern const BLEADV_PACK_TYPE g_BleAdvPackTypeAccel;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize packer
+ *
+ * @param	pPacker	: Pointer to packer instance data
+ * @param	pSlot	: Slot array, pType, Priority & MaxAge set
+ * @param	NbSlot	: Number of slots
+ *
+ * @return	true - success
+ */
+bool BleAdvPackInit(BLEADV_PACKER * const pPacker, BLEADV_PACK_SLOT *pSlot, int NbSlot);
+
+/**
+ * @brief	Update reading of a slot
+ *
+ * @param	pPacker	: Pointer to packer instance data
+ * @param	SlotIdx	: Slot index
+ * @param	pVal	: Field values, NbField of slot type
+ * @param	Time	: Current time, any unit consistent with MaxAge
+ */
+void BleAdvPackUpdate(BLEADV_PACKER * const pPacker, int SlotIdx, const int32_t *pVal, uint32_t Time);
+
+/**
+ * @brief	Build advertisement payload
+ *
+ * Chooses readings to send & packs them.
+ *
+ * @param	pPacker	: Pointer to packer instance data
+ * @param	pBuff	: Payload buffer
+ * @param	BuffLen	: Payload budget in bytes, i.e. BLEADV_PACK_LEGACY_LEN
+ * @param	Time	: Current time
+ *
+ * @return	Payload length in bytes, 0 if nothing to send
+ */
+int BleAdvPackBuild(BLEADV_PACKER * const pPacker, uint8_t *pBuff, int BuffLen, uint32_t Time);
+
+/**
+ * @brief	Get size of a reading in bits, tag included
+ *
+ * @param	pType	: Reading type
+ *
+ * @return	Number of bits
+ */
+int BleAdvPackTypeBits(const BLEADV_PACK_TYPE *pType);
+
+/**
+ * @brief	Decode advertisement payload
+ *
+ * Decoding stops at the first tag with no known type.
+ *
+ * @param	pData		: Payload
+ * @param	Len			: Payload length
+ * @param	pTypes		: Known types, NULL to use predefined types
+ * @param	NbType		: Number of types in pTypes
+ * @param	pReading	: Buffer receiving decoded readings
+ * @param	MaxReading	: Max number of readings in buffer
+ * @param	pSeq		: Receives payload sequence number, can be NULL
+ *
+ * @return	Number of readings decoded, -1 if not a packed payload
+ */
+int BleAdvPackDecode(const uint8_t *pData, int Len, const BLEADV_PACK_TYPE * const *pTypes, int NbType,
+					 BLEADV_PACK_READING *pReading, int MaxReading, uint8_t *pSeq);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Bluetooth */
+
+#endif // __BLEADV_PACKER_H__
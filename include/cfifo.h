@@ -38,6 +38,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef __FIFO_H__
 #define __FIFO_H__
 
+#include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
 
@@ -108,6 +109,24 @@ HCFIFO const CFifoInit(uint8_t * const pMemBlk, uint32_t TotalMemSize, uint32_t
  */
 uint8_t *CFifoGet(HCFIFO const hFifo);
 
+/**
+ * @brief	Get pointer to oldest FIFO block without removing it.
+ *
+ * Use CFifoGet to remove the block once it is consumed.
+ *
+ * @param	hFifo : CFIFO handle
+ *
+ * @return	Pointer to the FIFO buffer, NULL if empty
+ */
+static inline uint8_t *CFifoPeek(HCFIFO const hFifo) {
+	if (hFifo == NULL)
+		return NULL;
+
+	int32_t idx = hFifo->GetIdx;
+
+	return idx < 0 ? NULL : hFifo->pMemStart + idx * hFifo->BlkSize;
+}
+
 /**
  * @brief	Retrieve FIFO data in multiple blocks by returning pointer to FIFO memory blocks
  * for reading.
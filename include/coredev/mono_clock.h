@@ -0,0 +1,248 @@
+/**-------------------------------------------------------------------------
+@file	mono_clock.h
+
+@brief	64 bits monotonic nanosecond clock service
+
+MonoClock extends the hardware counter of any Timer to a 64 bits monotonic
+timestamp in nanosecond.  Counter to nanosecond conversion uses a fixed point
+multiplier, no division on read.  Reading is lock free, it does not depend on
+the timer interrupt having processed the counter overflow.  The base must be
+updated at least once per half counter wrap, either by reading the clock or by
+calling Update from the timer overflow event.
+
+ClockSync estimates the rate difference between 2 clocks from paired samples
+and maps timestamps of one onto the other.  Typical use is to map high
+resolution captures of the HF timer onto the low power RTC time base.
+
+Usage :
+
+TimerLFnRF5x g_LFTimer;
+TimerHFnRF5x g_HFTimer;
+MonoClock g_LFClock;
+MonoClock g_HFClock;
+ClockSync g_ClockSync;
+
+g_LFClock.Init(&g_LFTimer, 24);		// RTC counter is 24 bits
+g_HFClock.Init(&g_HFTimer, 32);
+
+uint64_t t = g_LFClock.nSecond();
+
+g_ClockSync.Init(&g_LFClock, &g_HFClock);
+g_ClockSync.Sample();				// Periodically, i.e. once per second
+...
+uint64_t lft = g_ClockSync.Map(g_HFClock.TickToNs(capture));
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __MONO_CLOCK_H__
+#define __MONO_CLOCK_H__
+
+#include <stdint.h>
+
+#include "coredev/timer.h"
+
+// Writer is an interrupt on the same core, ordering by the compiler is
+// sufficient for the sequence counter
+#define MONOCLOCK_BARRIER()		__asm volatile ("" ::: "memory")
+
+/** @addtogroup Timer
+  * @{
+  */
+
+#ifdef __cplusplus
+
+/// @brief	64 bits monotonic nanosecond clock over a Timer counter
+class MonoClock {
+public:
+	MonoClock();
+	virtual ~MonoClock() {}
+	MonoClock(MonoClock&);	// copy ctor not allowed
+
+	/**
+	 * @brief	Initialize clock on an initialized timer
+	 *
+	 * @param	pTimer	: Pointer to timer
+	 * @param	CntBits	: Hardware counter width in bits. 24 for nRF5x RTC, 32 for TIMER
+	 *
+	 * @return	true - success
+	 */
+	bool Init(Timer * const pTimer, int CntBits);
+
+	/**
+	 * @brief	Recalculate conversion factors after timer frequency changed
+	 */
+	void Calibrate();
+
+	/**
+	 * @brief	Get current time in nanosecond since Init
+	 *
+	 * Inline, only the time is computed.  The base update past half counter
+	 * wrap is the only out of line call.
+	 *
+	 * @return	64 bits monotonic timestamp in nsec
+	 */
+	uint64_t nSecond() {
+		uint32_t seq, d;
+		uint64_t ns;
+
+		// Retry if base was updated by an interrupt while reading
+		do {
+			seq = vSeq;
+			MONOCLOCK_BARRIER();
+			d = ((uint32_t)vpTimer->TickCount() - vBaseRaw) & vMask;
+			ns = vBaseNs + (((uint64_t)d * vMult + vBaseFrac) >> vShift);
+			MONOCLOCK_BARRIER();
+		} while ((seq & 1) || seq != vSeq);
+
+		// Past half wrap, move base forward so that next wrap is not missed
+		if (d > (vMask >> 1))
+		{
+			Update();
+		}
+
+		return ns;
+	}
+
+	/**
+	 * @brief	Get extended 64 bits counter value since Init
+	 *
+	 * @return	Tick count
+	 */
+	uint64_t Tick();
+
+	/**
+	 * @brief	Convert extended tick count to nanosecond
+	 *
+	 * @param	Tick	: Tick count as returned by Tick()
+	 *
+	 * @return	Time in nsec
+	 */
+	uint64_t TickToNs(uint64_t Tick);
+
+	/**
+	 * @brief	Move base forward to current counter.
+	 *
+	 * Must be called at least once per half counter wrap if the clock is not
+	 * read that often.  Timer overflow event is a good place.
+	 */
+	void Update();
+
+	uint32_t Mult() { return vMult; }
+	int Shift() { return vShift; }
+
+private:
+	void Read(uint64_t &Tick, uint64_t &Ns);
+	void UpdateBase(uint32_t Raw);
+
+	Timer *vpTimer;
+	uint32_t vMask;			//!< Hardware counter mask
+	uint32_t vMult;			//!< Fixed point tick to nsec multiplier
+	int vShift;				//!< Fixed point shift
+	volatile uint32_t vSeq;	//!< Sequence count, odd while base is being updated
+	uint32_t vBaseRaw;		//!< Hardware counter value at base
+	uint64_t vBaseTick;		//!< Extended tick count at base
+	uint64_t vBaseNs;		//!< Time at base in nsec
+	uint32_t vBaseFrac;		//!< Fractional nsec at base, vShift bits
+};
+
+/// @brief	Rate estimation & timestamp mapping between 2 clocks
+class ClockSync {
+public:
+	ClockSync();
+	virtual ~ClockSync() {}
+
+	/**
+	 * @brief	Initialize
+	 *
+	 * @param	pRef	: Reference clock, time base to map to
+	 * @param	pSrc	: Source clock, time base to map from
+	 *
+	 * @return	true - success
+	 */
+	bool Init(MonoClock * const pRef, MonoClock * const pSrc);
+
+	/**
+	 * @brief	Take a paired reading of both clocks and update rate estimate
+	 *
+	 * Rate is estimated over the span since the first sample, so precision
+	 * improves as samples accumulate.
+	 *
+	 * The source clock is read before and after the reference.  The mid point is
+	 * used as the source time.
+	 */
+	void Sample();
+
+	/**
+	 * @brief	Add a paired reading obtained by other means, for example an HF
+	 * 			timer capture triggered by the RTC through PPI
+	 *
+	 * @param	RefNs	: Reference clock time in nsec
+	 * @param	SrcNs	: Source clock time in nsec at the same instant
+	 */
+	void AddSample(uint64_t RefNs, uint64_t SrcNs);
+
+	/**
+	 * @brief	Map source clock timestamp to reference clock time base
+	 *
+	 * Valid for timestamps within about 30 minutes of the last sample
+	 *
+	 * @param	SrcNs	: Source clock timestamp in nsec
+	 *
+	 * @return	Reference clock timestamp in nsec
+	 */
+	uint64_t Map(uint64_t SrcNs);
+
+	/**
+	 * @brief	Estimated rate difference, reference relative to source
+	 *
+	 * @return	Drift in part per billion
+	 */
+	int32_t DriftPpb();
+
+	/**
+	 * @brief	Number of samples taken
+	 */
+	uint32_t SampleCount() { return vNbSample; }
+
+private:
+	MonoClock *vpRef;
+	MonoClock *vpSrc;
+	uint32_t vNbSample;
+	uint64_t vRefNs;		//!< Last sample reference time
+	uint64_t vSrcNs;		//!< Last sample source time
+	uint64_t vRefAnchor;	//!< Reference time of rate estimation start sample
+	uint64_t vSrcAnchor;	//!< Source time of rate estimation start sample
+	int64_t vRate;			//!< Estimated rate - 1, Q32 fixed point
+};
+
+#endif // __cplusplus
+
+/** @} End of group Timer */
+
+#endif // __MONO_CLOCK_H__
@@ -234,6 +234,25 @@ void QuadSPISetMemSize(SPIDEV * const pDev, uint32_t Size);
  */
 bool QuadSPISendCmd(SPIDEV * const pDev, uint8_t Cmd, uint32_t Addr, uint8_t AddrLen, uint32_t DataLen, uint8_t DummyCycle);
 
+/**
+ * @brief	Enable Quad SPI memory mapped (execute in place) read mode
+ *
+ * Once enabled, the whole Flash memory can be read directly through the returned
+ * pointer without going through the command/data sequence.  Sending any other command
+ * with QuadSPISendCmd automatically exits memory mapped mode.  This function must
+ * be called again to re-enable it.
+ *
+ * This is only available on Quad SPI interface that supports memory mapped mode.
+ *
+ * @param	pDev : SPI device handle
+ * @param	Cmd : Flash read command code used for memory mapped access
+ * @param	AddrLen : Flash address size in bytes
+ * @param	DummyCycle : Number of dummy clock cycle of the read command
+ *
+ * @return	Pointer to mapped Flash memory or NULL if not supported
+ */
+const uint8_t *QuadSPIMemMap(SPIDEV * const pDev, uint8_t Cmd, uint8_t AddrLen, uint8_t DummyCycle);
+
 /**
  * @brief	Set SPI slave data for read command.
  *
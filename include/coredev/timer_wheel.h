@@ -0,0 +1,260 @@
+/**-------------------------------------------------------------------------
+@file	timer_wheel.h
+
+@brief	Software timer service multiplexed over a single hardware timer trigger
+
+Hierarchical timer wheel scheduling any number of software timers using one
+trigger of a Timer implementation.  Software timer memory is provided by the
+caller, insert & cancel are O(1).  The hardware trigger is reprogrammed for the
+next deadline only (tickless).  Timers with slack are aligned to coarse tick
+boundaries within their tolerance window so that they expire together and
+wake the system once.
+
+Wheel has TIMER_WHEEL_LEVELS levels of 2^TIMER_WHEEL_SLOT_BITS slots.  A level l
+slot spans 2^(l * TIMER_WHEEL_SLOT_BITS) timer ticks.  Timers further away than
+the wheel span are kept in an overflow list.
+
+Usage :
+
+TimerLFnRF5x g_Timer;
+TimerWheel g_TimerWheel;
+SWTIMER g_LedTimer;
+
+void LedTimerHandler(SWTIMER * const pSwTimer, void * const pContext)
+{
+	...
+}
+
+g_Timer.Init(s_TimerCfg);
+g_TimerWheel.Init(&g_Timer);
+
+// LED blink every 500 ms, can be delayed up to 20 ms to share a wakeup
+g_TimerWheel.Start(&g_LedTimer, 500000000ULL, TIMER_TRIG_TYPE_CONTINUOUS, 20000000ULL,
+				   LedTimerHandler);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __TIMER_WHEEL_H__
+#define __TIMER_WHEEL_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "coredev/timer.h"
+
+/** @addtogroup Timer
+  * @{
+  */
+
+#ifndef TIMER_WHEEL_SLOT_BITS
+#define TIMER_WHEEL_SLOT_BITS		6		//!< Slots per level = 2^TIMER_WHEEL_SLOT_BITS, max 6
+#endif
+
+#ifndef TIMER_WHEEL_LEVELS
+#define TIMER_WHEEL_LEVELS			4		//!< Number of wheel levels
+#endif
+
+#if TIMER_WHEEL_SLOT_BITS * (TIMER_WHEEL_LEVELS - 1) > 32
+#error "Slot span of top wheel level must fit in 32 bits"
+#endif
+
+#define TIMER_WHEEL_NBSLOT			(1 << TIMER_WHEEL_SLOT_BITS)
+#define TIMER_WHEEL_SLOT_MASK		(TIMER_WHEEL_NBSLOT - 1)
+
+/// Minimum hardware trigger delay in timer ticks.  Compare register set too
+/// close to the current counter value may not trigger
+#ifndef TIMER_WHEEL_MIN_TICK
+#define TIMER_WHEEL_MIN_TICK		2
+#endif
+
+typedef struct __Software_Timer SWTIMER;
+
+/**
+ * @brief	Software timer expiry handler type
+ *
+ * Called from the hardware timer interrupt.  Software timers can be started or
+ * stopped from the handler, including the expired timer itself.
+ *
+ * @param	pSwTimer : Pointer to expired software timer
+ * @param	pContext : Pointer to user context passed to Start
+ */
+typedef void (*SWTIMER_CB)(SWTIMER * const pSwTimer, void * const pContext);
+
+#pragma pack(push, 4)
+
+/// @brief	Software timer.
+///
+/// Memory is owned by the caller and must remain valid while the timer is
+/// active.  Members are private to the timer wheel.
+struct __Software_Timer {
+	SWTIMER *pNext;			//!< Next timer in slot list
+	SWTIMER **ppPrev;		//!< Link pointing to this timer, NULL if not active
+	uint64_t Expire;		//!< Nominal expiry tick
+	uint64_t WheelTick;		//!< Expiry tick after slack alignment
+	uint64_t Period;		//!< Period in ticks, 0 - single shot
+	uint64_t Slack;			//!< Tolerated delay in ticks
+	SWTIMER_CB Handler;		//!< Expiry handler
+	void *pContext;			//!< User context
+};
+
+#pragma pack(pop)
+
+/// @brief	Timer wheel software timer service
+///
+/// One trigger of the hardware Timer is used exclusively by the wheel.
+class TimerWheel {
+public:
+	TimerWheel();
+	virtual ~TimerWheel();
+	TimerWheel(TimerWheel&);	// copy ctor not allowed
+
+	/**
+	 * @brief	Initialize timer wheel on an initialized hardware timer
+	 *
+	 * @param	pTimer	: Pointer to hardware timer
+	 * @param	TrigNo	: Timer trigger to use. -1 to use first available
+	 *
+	 * @return	true - success
+	 */
+	bool Init(Timer * const pTimer, int TrigNo = -1);
+
+	/**
+	 * @brief	Start or restart a software timer
+	 *
+	 * @param	pSwTimer : Pointer to software timer memory
+	 * @param	nsPeriod : Delay to expiry and period for continuous timer in nsec
+	 * @param	Type	 : Single shot or continuous
+	 * @param	nsSlack	 : Tolerated expiry delay in nsec, used to coalesce wakeups.
+	 * 					   0 - expire at exact tick
+	 * @param	Handler	 : Expiry handler
+	 * @param	pContext : Optional user context passed to handler
+	 *
+	 * @return	true - success
+	 */
+	bool Start(SWTIMER * const pSwTimer, uint64_t nsPeriod, TIMER_TRIG_TYPE Type, uint64_t nsSlack,
+			   SWTIMER_CB const Handler, void * const pContext = NULL);
+
+	/**
+	 * @brief	Millisecond version of Start
+	 */
+	bool Start(SWTIMER * const pSwTimer, uint32_t msPeriod, TIMER_TRIG_TYPE Type, uint32_t msSlack,
+			   SWTIMER_CB const Handler, void * const pContext = NULL) {
+		return Start(pSwTimer, (uint64_t)((uint64_t)msPeriod * 1000000ULL), Type, (uint64_t)((uint64_t)msSlack * 1000000ULL),
+					 Handler, pContext);
+	}
+
+	/**
+	 * @brief	Stop a software timer.  Does nothing if timer is not active
+	 *
+	 * @param	pSwTimer : Pointer to software timer
+	 */
+	void Stop(SWTIMER * const pSwTimer);
+
+	/**
+	 * @brief	Check if software timer is active
+	 */
+	bool IsActive(SWTIMER * const pSwTimer) { return pSwTimer->ppPrev != NULL; }
+
+	/**
+	 * @brief	Expire all timers due at current tick count and reprogram the
+	 * 			hardware trigger.
+	 *
+	 * Called from the timer trigger handler.  Can also be called by application
+	 * after wakeup from other sources.
+	 */
+	void Process();
+
+	/**
+	 * @brief	Get earliest software timer expiry tick
+	 *
+	 * @return	Tick count, UINT64_MAX if no timer is active
+	 */
+	uint64_t NextExpire();
+
+	/**
+	 * @brief	Number of active software timers
+	 */
+	uint32_t Count() { return vCount; }
+
+	/**
+	 * @brief	Number of hardware trigger interrupts handled
+	 */
+	uint32_t WakeupCount() { return vWakeupCnt; }
+
+	/**
+	 * @brief	Convert nsec to timer tick, rounded up
+	 */
+	uint64_t nsToTick(uint64_t nsVal) {
+		uint64_t f = vpTimer->Frequency();
+
+		// Split in seconds & remainder, nsVal * f overflows past ~19 min at 16 MHz
+		return (nsVal / 1000000000ULL) * f + ((nsVal % 1000000000ULL) * f + 999999999ULL) / 1000000000ULL;
+	}
+
+	/**
+	 * @brief	Convert timer tick to nsec, rounded down
+	 */
+	uint64_t TickToNs(uint64_t Tick) {
+		uint64_t f = vpTimer->Frequency();
+
+		// Same split as nsToTick, Tick * 1e9 overflows past ~19 min at 16 MHz
+		return (Tick / f) * 1000000000ULL + (Tick % f) * 1000000000ULL / f;
+	}
+
+	/**
+	 * @brief	Trigger handler entry, TIMER_TRIGCB type
+	 */
+	static void TimerTrigHandler(Timer * const pTimer, int TrigNo, void * const pContext);
+
+protected:
+	void Insert(SWTIMER * const pSwTimer);
+	void Remove(SWTIMER * const pSwTimer);
+	void Advance(uint64_t Tick, uint32_t &IntState);
+	uint64_t NextEvent();
+	void Reprogram();
+
+private:
+	Timer *vpTimer;
+	int vTrigNo;
+	uint64_t vCurTick;			//!< Wheel time in ticks, all timers before this are processed
+	uint64_t vArmedTick;		//!< Tick at which the hardware trigger is armed, UINT64_MAX - not armed
+	uint32_t vCount;			//!< Number of active timers
+	uint32_t vWakeupCnt;		//!< Number of trigger interrupts
+	bool vbInProcess;			//!< Processing expired timers, reprogram deferred to end of processing
+	uint64_t vOccupied[TIMER_WHEEL_LEVELS];	//!< Non empty slot bit map per level
+	SWTIMER *vpSlot[TIMER_WHEEL_LEVELS][TIMER_WHEEL_NBSLOT];
+	uint32_t vSlotMin[TIMER_WHEEL_LEVELS - 1][TIMER_WHEEL_NBSLOT];	//!< Lower bound of expiry offset in
+															//!< slot for level 1 and up. Avoids
+															//!< scanning slot list to find deadline
+	SWTIMER *vpOverflow;		//!< Timers beyond wheel span
+};
+
+/** @} End of group Timer */
+
+#endif // __TIMER_WHEEL_H__
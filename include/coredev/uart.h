@@ -215,6 +215,16 @@ void UARTvprintf(UARTDEV * const pDev, const char *pFormat, va_list vl);
 void UARTRetargetEnable(UARTDEV * const pDev, int FileNo);
 void UARTRetargetDisable(UARTDEV * const pDev, int FileNo);
 
+/**
+ * @brief	Deferred log output callback (DLOG_WRCB), pCtx is the UARTDEV.
+ *
+ * Non blocking.  Writes only what fits in the Tx FIFO, nothing when the
+ * interface is busy or has no Tx FIFO.
+ *
+ * @return	Number of bytes accepted, 0 - retry later
+ */
+int UARTDLogWrite(void *pCtx, const uint8_t *pData, int Len);
+
 #ifdef __cplusplus
 }
 
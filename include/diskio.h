@@ -154,6 +154,14 @@ public:
 	void SetCache(DISKIO_CACHE_DESC * const pCacheBlk, int NbCacheBlk);
 	void Flush();
 
+	/**
+	 * @brief	Write back dirty cache sectors overlapping a byte range
+	 *
+	 * @param	Offset	: Byte offset on disk
+	 * @param	Len		: Number of bytes
+	 */
+	void Flush(uint64_t Offset, uint32_t Len);
+
 protected:
 
 private:
@@ -140,6 +140,9 @@ g_FlashDisk.SectRead(1, buff);	// Read sector 1
 g_FlashDisk.SectWrite(2, buff);	// Write sector 2
 g_FlashDisk.Erase();			// Mass erase flash
 
+// Direct read access to flash content (Quad SPI with memory mapped support only)
+const uint8_t *p = g_FlashDisk.MemMap();
+
 
 @author	Hoang Nguyen Hoan
 @date	Aug. 30, 2016
@@ -345,6 +348,50 @@ public:
      */
     virtual bool SectWrite(uint32_t SectNo, uint8_t *pData);
 
+    /**
+     * @brief	Read data from flash at byte offset.
+     *
+     * When memory mapped mode is enabled, data is copied directly from the mapped
+     * Flash memory, bypassing the sector cache.  Otherwise it goes through the
+     * normal DiskIO sector cache.
+     *
+     * @param	Offset	: Byte offset in flash memory
+     * @param	pBuff	: Pointer to buffer to receive data
+     * @param	Len		: Number of bytes to read
+     *
+     * @return	Number of bytes read
+     */
+    using DiskIO::Read;
+    virtual int Read(uint64_t Offset, uint8_t *pBuff, uint32_t Len);
+
+    /**
+     * @brief	Enable memory mapped read mode and get direct access to flash content.
+     *
+     * On Quad SPI interface supporting execute in place (XIP), the whole flash is mapped
+     * into the MCU address space.  Read only data such as fonts, lookup tables or firmware
+     * images can then be used directly from flash without copying into RAM.
+     *
+     * Any other flash command (status, id, write, erase) exits memory mapped mode
+     * on the interface.  Write & erase operations remap once completed.  After other
+     * commands the mapping is restored on the next MemMap() or MemMapPtr() call.
+     * Therefore do not keep the pointer across calls to this object, get it again
+     * with MemMapPtr() before accessing the content.
+     *
+     * Writes still in the cache are not visible through the pointer.  Call Flush()
+     * on the range first.  Read() does it.
+     *
+     * @return	Pointer to start of flash memory.\n
+     * 			NULL if interface does not support memory mapped mode
+     */
+    const uint8_t *MemMap();
+
+    /**
+     * @brief	Get memory mapped pointer, remapping if a command exited mapped mode
+     *
+     * @return	Pointer to start of flash memory or NULL if not mapped
+     */
+    const uint8_t *MemMapPtr() { return vbMemMap ? MemMap() : NULL; }
+
     /**
      * @brief	Read Flash ID
      *
@@ -410,6 +457,19 @@ protected:
      */
     bool WaitReady(uint32_t Timeout = 100000, uint32_t usRtyDelay = 0);
 
+    /**
+     * @brief	Restore memory mapped mode after a write or erase command
+     */
+    void MemMapRestore();
+
+    /**
+     * @brief	Send Quad SPI command
+     *
+     * The interface leaves memory mapped mode on any command.  The mapped pointer
+     * is invalidated here so that it is never used while unmapped.
+     */
+    bool QSPISendCmd(uint8_t Cmd, uint32_t Addr, uint8_t AddrLen, uint32_t DataLen, uint8_t DummyCycle);
+
 private:
     uint16_t    vSectSize;		//!< Erasable sector size in KBytes
     uint16_t    vBlkSize;		//!< Erasable block size in KBytes
@@ -422,6 +482,8 @@ private:
     							//!< user application to perform task switch or other thing while waiting.
     CMDCYCLE	vRdCmd;			//!< QSPI read/write and dummy cycle
     CMDCYCLE	vWrCmd;			//!< QSPI read/write and dummy cycle
+    const uint8_t *vpMemMap;	//!< Memory mapped flash access, NULL if not currently mapped
+    bool		vbMemMap;		//!< Memory mapped mode requested by MemMap()
 };
 
 #ifdef __cplusplus
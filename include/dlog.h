@@ -0,0 +1,286 @@
+/**-------------------------------------------------------------------------
+@file	dlog.h
+
+@brief	Deferred formatting log
+
+printf style logging without formatting on the calling context.  A log call only
+captures the format string id, a time stamp and the raw integer arguments into
+a binary ring.  Formatting is done later by DLogProcess, called from a low
+priority task or the idle loop, which writes the text through a write callback
+such as UARTDLogWrite for the retargeted UART or a BLE stream.  In binary mode
+the records are shipped as is and formatted on host by a decoder using the
+firmware ELF file.
+
+Writing is lock free, multiple threads and interrupts can log at the same
+time.  When the ring is full the message is dropped and counted, the caller is
+never blocked.  Drops are reported in the output stream.
+
+Format strings are placed in the dlog_fmt section.  A record stores the string
+offset in the section rather than a pointer so that the host decoder can find
+it in the ELF file.  GNU ld places the orphan section after read only data and
+defines __start_dlog_fmt.  A linker script listing sections explicitly needs
+
+	dlog_fmt : { __start_dlog_fmt = .; KEEP(*(dlog_fmt)) } > FLASH
+
+Arguments are captured as DLOG_ARG (uintptr_t) :
+	- Integers and characters are captured as is.
+	- %s arguments must remain valid until formatted, string literals or static
+	  strings.  In binary mode they must be in a section loaded from the ELF file.
+	- Floating point values are captured as float bits for %f, %e, %g.
+	- In C, pass strings & pointers with DLOG_STR() and floating point values
+	  with DLOG_FLOAT().  C++ converts them automatically.
+
+Usage :
+
+	static DLOG_ARG s_DLogMem[256];
+	DLOG g_DLog;
+	DLOG_CFG cfg = { s_DLogMem, sizeof(s_DLogMem), DLOG_MODE_TEXT, UARTDLogWrite, &g_UartDev, NULL };
+
+	DLogInit(&g_DLog, &cfg);
+
+	DLOG(&g_DLog, "Battery %u mV, temperature %.1f\r\n", mv, DLOG_FLOAT(t));
+
+	// Idle loop
+	DLogProcess(&g_DLog);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __DLOG_H__
+#define __DLOG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+#define DLOG_MAXARG				8			//!< Max number of arguments per log call
+#define DLOG_REC_HDRLEN			3			//!< Record header words, header, time stamp, format id
+#define DLOG_REC_MARK			0xD1000000	//!< Record header marker
+#define DLOG_FMTID_DROP			0xFFFFFFFF	//!< Drop report record, Arg 0 : number dropped
+#define DLOG_FMTID_SYNC			0xFFFFFFFE	//!< Binary stream sync record, see DLOG_SYNC_ARG
+#define DLOG_SYNC_MAGIC			0x474F4C44	//!< 'DLOG'
+#define DLOG_SYNC_FLAG_TIMESTAMP	1		//!< Records carry a time stamp
+#define DLOG_OUTBUF_SIZE		160			//!< Drain output buffer size, max formatted length
+
+/// Sync record arguments
+typedef enum __DLog_Sync_Arg {
+	DLOG_SYNC_ARG_MAGIC,				//!< DLOG_SYNC_MAGIC
+	DLOG_SYNC_ARG_WORDSIZE,				//!< sizeof(DLOG_ARG) on target
+	DLOG_SYNC_ARG_FMTADDR,				//!< Run time address of format string section
+	DLOG_SYNC_ARG_FLAGS,				//!< DLOG_SYNC_FLAG_xxx
+	DLOG_SYNC_NBARG
+} DLOG_SYNC_ARG;
+
+/// Argument word
+typedef uintptr_t DLOG_ARG;
+
+/// Drain output mode
+typedef enum __DLog_Mode {
+	DLOG_MODE_TEXT,						//!< Format on target
+	DLOG_MODE_BIN						//!< Ship binary records to host decoder
+} DLOG_MODE;
+
+/**
+ * @brief	Output write callback.
+ *
+ * @param	pCtx	: User context
+ * @param	pData	: Data to write
+ * @param	Len		: Data length
+ *
+ * @return	Number of bytes accepted, can be less than Len when output is busy
+ */
+typedef int (*DLOG_WRCB)(void *pCtx, const uint8_t *pData, int Len);
+
+/**
+ * @brief	Time stamp callback.
+ *
+ * Called from the logging context, must be interrupt safe.
+ */
+typedef uint32_t (*DLOG_TIMECB)(void);
+
+/**
+ * @brief	%s argument resolver for DLogFormat.
+ *
+ * @param	pCtx	: User context
+ * @param	Addr	: String address as captured
+ *
+ * @return	Pointer to string, NULL if not found
+ */
+typedef const char *(*DLOG_STRCB)(void *pCtx, DLOG_ARG Addr);
+
+#pragma pack(push, 4)
+
+/// Configuration
+typedef struct __DLog_Config {
+	DLOG_ARG *pMem;						//!< Ring memory
+	size_t MemSize;						//!< Ring memory size in bytes, number of words must be power of 2
+	DLOG_MODE Mode;						//!< Output mode
+	DLOG_WRCB WriteCB;					//!< Output write callback
+	void *pCtx;							//!< Write callback context
+	DLOG_TIMECB TimeCB;					//!< Time stamp callback, NULL - none
+} DLOG_CFG;
+
+/// Deferred log
+typedef struct __DLog_Dev {
+	DLOG_ARG *pRing;					//!< Record ring
+	uint32_t Mask;						//!< Number of words - 1
+	volatile uint32_t Head;				//!< Next word to reserve, atomic access in dlog.c
+	volatile uint32_t Tail;				//!< Next word to drain, atomic access in dlog.c
+	volatile uint32_t DropCnt;			//!< Messages dropped
+	uint32_t DropRep;					//!< Drops already reported
+	DLOG_MODE Mode;
+	DLOG_WRCB WriteCB;
+	void *pCtx;
+	DLOG_TIMECB TimeCB;
+	bool bSync;							//!< Sync record sent
+	int OutLen;							//!< Pending output length
+	int OutOff;							//!< Pending output written
+	uint8_t OutBuf[DLOG_OUTBUF_SIZE];	//!< Pending output
+} DLOG;
+
+#pragma pack(pop)
+
+/// Float argument, passed as its bits
+static inline DLOG_ARG DLOG_FLOAT(float Val) {
+	union { float f; uint32_t u; } v;
+	v.f = Val;
+	return v.u;
+}
+
+/// String or pointer argument in C
+#define DLOG_STR(s)			((DLOG_ARG)(s))
+
+#ifdef __cplusplus
+#define DLOG(pLog, Fmt, ...) do { \
+		static const char __dlog_fmt[] __attribute__((section("dlog_fmt"), used)) = Fmt; \
+		DLogWriteArgs(pLog, __dlog_fmt, ##__VA_ARGS__); \
+	} while (0)
+#else
+/**
+ * @brief	Log message.
+ *
+ * 		DLOG(&g_DLog, "Value %d %s\n", val, DLOG_STR("unit"));
+ *
+ * Format string must be a string literal.  In C, strings & pointers must be
+ * passed with DLOG_STR and floating point values with DLOG_FLOAT.  In C++
+ * arguments are converted automatically.
+ */
+#define DLOG(pLog, Fmt, ...) do { \
+		static const char __dlog_fmt[] __attribute__((section("dlog_fmt"), used)) = Fmt; \
+		const DLOG_ARG __dlog_arg[] = { 0, ##__VA_ARGS__ }; \
+		DLogWrite(pLog, __dlog_fmt, sizeof(__dlog_arg) / sizeof(DLOG_ARG) - 1, &__dlog_arg[1]); \
+	} while (0)
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize deferred log.
+ *
+ * @param	pLog	: Pointer to log
+ * @param	pCfg	: Pointer to configuration
+ *
+ * @return	true - success
+ */
+bool DLogInit(DLOG * const pLog, const DLOG_CFG * const pCfg);
+
+/**
+ * @brief	Queue one message.
+ *
+ * Use DLOG macro.  Lock free, can be called from interrupts.
+ *
+ * Format strings from elsewhere, ex. another log API, are accepted if they
+ * are constant & in the image, within 2 GB of the dlog_fmt section.
+ *
+ * @param	pLog	: Pointer to log
+ * @param	pFmt	: Format string in dlog_fmt section
+ * @param	NbArg	: Number of arguments, max DLOG_MAXARG
+ * @param	pArg	: Arguments
+ *
+ * @return	false - ring full, message dropped
+ */
+bool DLogWrite(DLOG * const pLog, const char *pFmt, int NbArg, const DLOG_ARG *pArg);
+
+/**
+ * @brief	Drain queued messages to output.
+ *
+ * Call from one low priority context.  Returns when the ring is empty or the
+ * output does not accept more data.
+ *
+ * @param	pLog	: Pointer to log
+ *
+ * @return	Number of messages written
+ */
+int DLogProcess(DLOG * const pLog);
+
+/// Number of messages dropped since init
+static inline uint32_t DLogDropCount(DLOG * const pLog) {
+	return pLog->DropCnt;
+}
+
+/**
+ * @brief	Format message from captured arguments.
+ *
+ * Conversions d, i, u, x, X, o, c, s, p, f, F, e, E, g, G with flags, width,
+ * precision & length modifiers.  * width is not supported.
+ *
+ * @param	pBuff	: Buffer to receive message
+ * @param	BuffLen	: Buffer size
+ * @param	pFmt	: Format string
+ * @param	NbArg	: Number of arguments
+ * @param	pArg	: Arguments
+ * @param	StrCB	: %s resolver, NULL - arguments are pointers
+ * @param	pCtx	: Resolver context
+ *
+ * @return	Message length, can be larger than BuffLen - 1 when truncated
+ */
+int DLogFormat(char *pBuff, int BuffLen, const char *pFmt, int NbArg, const DLOG_ARG *pArg,
+			   DLOG_STRCB StrCB, void *pCtx);
+
+#ifdef __cplusplus
+}
+
+static inline DLOG_ARG DLogArg(float Val) { return DLOG_FLOAT(Val); }
+static inline DLOG_ARG DLogArg(double Val) { return DLOG_FLOAT((float)Val); }
+template<typename T> static inline DLOG_ARG DLogArg(T Val) { return (DLOG_ARG)Val; }
+
+template<typename... T> static inline bool DLogWriteArgs(DLOG * const pLog, const char *pFmt, T... Args) {
+	const DLOG_ARG arg[] = { 0, DLogArg(Args)... };
+	return DLogWrite(pLog, pFmt, sizeof...(Args), &arg[1]);
+}
+#endif
+
+/** @} End of group Utilities */
+
+#endif // __DLOG_H__
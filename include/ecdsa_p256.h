@@ -0,0 +1,184 @@
+/**-------------------------------------------------------------------------
+@file	ecdsa_p256.h
+
+@brief	ECDSA P-256 signature verification with precomputed comb tables.
+
+Verification only, all inputs are public so nothing here is constant time.
+Field arithmetic is done on 8 x 32 bits limbs with the NIST fast reduction,
+using 64 bits limbs where the compiler has a 128 bits type.
+
+EcdsaP256Verify works with any public key. It uses Shamir's trick : one
+chain of 256 doublings where the public key term is added by 4 bits windows
+of precomputed multiples and the generator term through the fixed generator
+comb table (g_EcdsaP256GComb).
+
+EcdsaP256VerifyComb is for a key known in advance such as a firmware update
+signing key. A comb table for the key is generated at build time with
+Linux/exemples/EcdsaCombGen or at run time with EcdsaP256CombInit. Both
+scalar multiplications then share ECDSAP256_COMB_SPACING doublings, about a
+quarter of the work of the generic path.
+
+EcdsaP256VerifyInit/Update/Final hash the message with a reentrant SHA-256
+while it is received and verify at the end.
+
+Keys are 64 bytes X|Y, signatures 64 bytes r|s, hash 32 bytes, each 32 bytes
+value big endian like micro-ecc. Define ECDSAP256_LITTLE_ENDIAN to 1 for little
+endian values, matching micro-ecc built with uECC_VLI_NATIVE_LITTLE_ENDIAN=1
+as in the nRF5 libraries and nrfutil generated keys.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __ECDSA_P256_H__
+#define __ECDSA_P256_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#include "isha256.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+#ifndef ECDSAP256_LITTLE_ENDIAN
+#define ECDSAP256_LITTLE_ENDIAN		0
+#endif
+
+#define ECDSAP256_KEY_LEN			64		//!< Public key X|Y length
+#define ECDSAP256_SIG_LEN			64		//!< Signature r|s length
+#define ECDSAP256_HASH_LEN			32		//!< Hash length
+
+#define ECDSAP256_COMB_TEETH		6		//!< Scalar bits combined per table lookup
+#define ECDSAP256_COMB_SPACING		43		//!< Doublings, ceil(256 / teeth)
+#define ECDSAP256_COMB_SIZE			((1 << ECDSAP256_COMB_TEETH) - 1)
+
+#pragma pack(push, 4)
+
+/// Affine point, 8 x 32 bits little endian limbs
+typedef struct __EcdsaP256_Point {
+	uint32_t x[8];
+	uint32_t y[8];
+} ECDSAP256_POINT;
+
+/// Comb table of a point P, Pt[i - 1] = sum of 2^(j * spacing) * P for bits j set in i
+typedef struct __EcdsaP256_Comb {
+	ECDSAP256_POINT Pt[ECDSAP256_COMB_SIZE];
+} ECDSAP256_COMB;
+
+/// Streaming verify context
+typedef struct __EcdsaP256_Verify {
+	SHA256CTX Sha;						//!< Message digest
+	const uint8_t *pPubKey;				//!< Public key if no comb table
+	const ECDSAP256_COMB *pKeyComb;		//!< Public key comb table
+} ECDSAP256_VERIFY;
+
+#pragma pack(pop)
+
+/// Generator comb table
+extern const ECDSAP256_COMB g_EcdsaP256GComb;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Verify signature with any public key.
+ *
+ * Needs about 2.5KB of stack for the public key multiples.
+ *
+ * @param	pPubKey	: Public key X|Y, validated on curve
+ * @param	pHash	: Message SHA-256
+ * @param	pSig	: Signature r|s
+ *
+ * @return	true if signature is valid
+ */
+bool EcdsaP256Verify(const uint8_t *pPubKey, const uint8_t *pHash, const uint8_t *pSig);
+
+/**
+ * @brief	Verify signature with a precomputed public key comb table.
+ *
+ * @param	pKeyComb	: Public key comb table
+ * @param	pHash		: Message SHA-256
+ * @param	pSig		: Signature r|s
+ *
+ * @return	true if signature is valid
+ */
+bool EcdsaP256VerifyComb(const ECDSAP256_COMB *pKeyComb, const uint8_t *pHash, const uint8_t *pSig);
+
+/**
+ * @brief	Build comb table of a public key or of the generator.
+ *
+ * Needs about 9KB of stack, meant for build time generation or a one time
+ * run on targets with enough RAM.
+ *
+ * @param	pComb	: Table to fill
+ * @param	pPubKey	: Public key X|Y, NULL for the generator
+ *
+ * @return	false if the key is not a valid curve point
+ */
+bool EcdsaP256CombInit(ECDSAP256_COMB *pComb, const uint8_t *pPubKey);
+
+/**
+ * @brief	Start verifying a message received in chunks.
+ *
+ * @param	pCtx		: Context
+ * @param	pPubKey		: Public key X|Y, used if pKeyComb is NULL
+ * @param	pKeyComb	: Public key comb table, NULL to use pPubKey
+ */
+void EcdsaP256VerifyInit(ECDSAP256_VERIFY * const pCtx, const uint8_t *pPubKey, const ECDSAP256_COMB *pKeyComb);
+
+/**
+ * @brief	Hash message chunk.
+ *
+ * @param	pCtx	: Context
+ * @param	pData	: Message data
+ * @param	Len		: Length in bytes
+ */
+static inline void EcdsaP256VerifyUpdate(ECDSAP256_VERIFY * const pCtx, const uint8_t *pData, size_t Len) {
+	Sha256Update(&pCtx->Sha, pData, Len);
+}
+
+/**
+ * @brief	Verify signature of the hashed message.
+ *
+ * @param	pCtx	: Context
+ * @param	pSig	: Signature r|s
+ *
+ * @return	true if signature is valid
+ */
+bool EcdsaP256VerifyFinal(ECDSAP256_VERIFY * const pCtx, const uint8_t *pSig);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Utilities */
+
+#endif // __ECDSA_P256_H__
@@ -0,0 +1,291 @@
+/**-------------------------------------------------------------------------
+@file	esb_link.h
+
+@brief	Reliable packet link over ESB.
+
+Sliding window sequence/retransmit layer with message packing for packet
+radios that already have link level ACK but may drop packets after their
+retry count, such as Nordic Enhanced ShockBurst. No radio dependency, the
+radio is reached through callbacks so that the layer runs on Linux against a
+simulated radio.
+
+Frame format, at most MaxPayload bytes :
+
+	Flags	: 1 byte, ESBLINK_FLAG_xxx
+	Seq		: Sequence number of this data frame, 0 if no data
+	Ack		: Next sequence number expected from peer (cumulative ACK)
+	Sack	: 2 bytes, bit n set when peer frame Ack + 1 + n was received
+	Data	: One message, or with ESBLINK_FLAG_PACKED, a list of
+			  { Len:1, Message } records
+
+Every frame carries the receive state, so acknowledges ride on data frames
+going the other way. On ESB that direction is the ACK payload of the PRX.
+When there is no data to carry them, an ACK only frame is sent.
+
+Transmit side keeps up to Window frames in flight. A frame is retransmitted
+when the Rto expires or right away when a later frame is selectively
+acknowledged. Receive side buffers out of order frames within the window and
+delivers messages in order, exactly once.
+
+In packing mode, small writes are combined into the frame being built until
+it is full or the radio has room to take it. Message boundaries are kept.
+
+The PTX only hears the PRX when it transmits. With bPoll, the link sends ACK
+only frames as polls while frames are in flight or the peer reports more data
+waiting (ESBLINK_FLAG_MORE).
+
+Time is in caller defined ticks, ex. usec, or radio events count.
+
+Usage :
+
+	static uint8_t s_LinkMem[ESBLINK_MEMSIZE(8, 252)];
+
+	ESBLINK_CFG cfg = {
+		s_LinkMem, sizeof(s_LinkMem), 8, 252, 3, 2000, true, true,
+		RadioSend, MsgRecv, &g_Radio
+	};
+	EsbLinkInit(&g_Link, &cfg);
+	...
+	EsbLinkWrite(&g_Link, pData, Len, Now);		// App
+	...
+	EsbLinkRecv(&g_Link, pFrame, FrameLen, Now);	// Radio receive event
+	...
+	EsbLinkTxDone(&g_Link, bSent, Now);			// Radio transmit done/failed event
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __ESB_LINK_H__
+#define __ESB_LINK_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @addtogroup device_intrf
+  * @{
+  */
+
+#define ESBLINK_HDR_LEN				5		//!< Frame header length
+#define ESBLINK_WINDOW_MAX			16		//!< Max frames in flight, Sack bits
+#define ESBLINK_PAYLOAD_MAX			252		//!< Max frame size, ESB max payload
+#define ESBLINK_RADIOQUE_MAX		16		//!< Max frames queued in radio
+
+#define ESBLINK_FLAG_DATA			(1<<0)	//!< Frame carries data, Seq valid
+#define ESBLINK_FLAG_PACKED			(1<<1)	//!< Data is a list of { Len, Message } records
+#define ESBLINK_FLAG_MORE			(1<<2)	//!< Sender has more data waiting
+
+/// Frame slot size in bytes
+#define ESBLINK_SLOT_SIZE(MaxPayload)		(((MaxPayload) + 3) & ~3)
+
+/// Memory size in bytes required for window of Window frames of MaxPayload bytes
+#define ESBLINK_MEMSIZE(Window, MaxPayload)	(2 * (Window) * ESBLINK_SLOT_SIZE(MaxPayload))
+
+/**
+ * @brief	Radio send callback.
+ *
+ * Queue one frame into the radio. The radio must have copied the frame when
+ * returning true. On ESB PRX, this queues an ACK payload.
+ *
+ * @param	pCtx	: User context pointer from config
+ * @param	pFrame	: Pointer to frame
+ * @param	Len		: Frame length in bytes
+ *
+ * @return	true - Frame queued
+ */
+typedef bool (*ESBLINK_SENDCB)(void *pCtx, const uint8_t *pFrame, int Len);
+
+/**
+ * @brief	Message receive callback.
+ *
+ * Called once per message, in order.
+ *
+ * @param	pCtx	: User context pointer from config
+ * @param	pData	: Pointer to message
+ * @param	Len		: Message length in bytes
+ */
+typedef void (*ESBLINK_RECVCB)(void *pCtx, const uint8_t *pData, int Len);
+
+#pragma pack(push, 4)
+
+/// Link configuration
+typedef struct __Esb_Link_Config {
+	uint8_t *pMem;				//!< Frame memory, see ESBLINK_MEMSIZE
+	uint32_t MemSize;			//!< Frame memory size in bytes
+	int Window;					//!< Max frames in flight, power of 2, max ESBLINK_WINDOW_MAX
+	int MaxPayload;				//!< Max frame size, max ESBLINK_PAYLOAD_MAX
+	int RadioQueMax;			//!< Max frames queued in radio, ex. ESB TX FIFO size, max ESBLINK_RADIOQUE_MAX
+	uint32_t Rto;				//!< Retransmit timeout in ticks
+	bool bPack;					//!< Combine small writes into one frame
+	bool bPoll;					//!< PTX role, poll peer with ACK only frames
+	ESBLINK_SENDCB SendCB;		//!< Radio send callback
+	ESBLINK_RECVCB RecvCB;		//!< Message receive callback
+	void *pCtx;					//!< User context passed to callbacks
+} ESBLINK_CFG;
+
+/// Link instance data
+typedef struct __Esb_Link {
+	uint8_t *pTxMem;			//!< Transmit frame slots
+	uint8_t *pRxMem;			//!< Receive reorder slots
+	uint16_t SlotSize;			//!< Slot size in bytes
+	uint8_t Window;				//!< Max frames in flight
+	uint8_t WinMask;			//!< Window - 1
+	uint16_t MaxPayload;		//!< Max frame size
+	uint8_t RadioQueMax;		//!< Max frames queued in radio
+	uint8_t RadioQue;			//!< Frames queued in radio
+	uint8_t RadioHead;			//!< Oldest entry of RadioSeq
+	int16_t RadioSeq[ESBLINK_RADIOQUE_MAX];	//!< Sequence number of frames queued in radio, -1 ACK only
+	uint32_t Rto;				//!< Retransmit timeout in ticks
+	bool bPack;					//!< Packing mode
+	bool bPoll;					//!< Poll peer
+	// Transmit state
+	uint8_t TxBase;				//!< Oldest unacknowledged sequence number
+	uint8_t TxNext;				//!< Next sequence number to send
+	uint8_t TxEnd;				//!< Next sequence number to fill
+	bool bTxOpen;				//!< Frame TxEnd - 1 still accepts records
+	uint16_t TxLen[ESBLINK_WINDOW_MAX];		//!< Frame data length
+	uint32_t TxTime[ESBLINK_WINDOW_MAX];	//!< Time of last send
+	uint16_t TxAcked;			//!< Selectively acknowledged frames, bit per slot
+	uint16_t TxRtx;				//!< Frames to retransmit now, bit per slot
+	uint16_t TxFast;			//!< Frames fast retransmitted since last timeout, bit per slot
+	// Receive state
+	uint8_t RxBase;				//!< Next sequence number expected
+	uint16_t RxValid;			//!< Buffered out of order frames, bit per slot
+	uint16_t RxLen[ESBLINK_WINDOW_MAX];		//!< Buffered frame data length, bit 15 packed
+	bool bAckPending;			//!< Receive state changed since last sent
+	bool bPeerMore;				//!< Peer has more data waiting
+	ESBLINK_SENDCB SendCB;		//!< Radio send callback
+	ESBLINK_RECVCB RecvCB;		//!< Message receive callback
+	void *pCtx;					//!< User context passed to callbacks
+	uint32_t TxFrameCnt;		//!< Data frames sent, first time
+	uint32_t RtxCnt;			//!< Data frames retransmitted
+	uint32_t AckFrameCnt;		//!< ACK only frames sent
+	uint32_t RxFrameCnt;		//!< Frames received
+	uint32_t DupCnt;			//!< Duplicate data frames received
+	uint32_t TxMsgCnt;			//!< Messages written
+	uint32_t RxMsgCnt;			//!< Messages delivered
+} ESBLINK;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize link.
+ *
+ * @param	pLink	: Pointer to link instance data
+ * @param	pCfg	: Pointer to configuration data
+ *
+ * @return	true - Success
+ */
+bool EsbLinkInit(ESBLINK * const pLink, const ESBLINK_CFG * const pCfg);
+
+/**
+ * @brief	Write one message and send what can be sent.
+ *
+ * @param	pLink	: Pointer to link instance data
+ * @param	pData	: Pointer to message
+ * @param	Len		: Message length, max EsbLinkMsgMax
+ * @param	Now		: Current time in ticks
+ *
+ * @return	true - Message queued, false - window full or message too large
+ */
+bool EsbLinkWrite(ESBLINK * const pLink, const uint8_t *pData, int Len, uint32_t Now);
+
+/**
+ * @brief	Process one frame received from the radio.
+ *
+ * Messages are delivered through RecvCB before returning.
+ *
+ * @param	pLink	: Pointer to link instance data
+ * @param	pFrame	: Pointer to frame
+ * @param	Len		: Frame length in bytes
+ * @param	Now		: Current time in ticks
+ *
+ * @return	true - Valid frame
+ */
+bool EsbLinkRecv(ESBLINK * const pLink, const uint8_t *pFrame, int Len, uint32_t Now);
+
+/**
+ * @brief	Radio has taken the oldest queued frame out, sent or failed.
+ *
+ * A failed data frame is retransmitted right away.
+ *
+ * @param	pLink	: Pointer to link instance data
+ * @param	bSent	: true - frame sent, false - dropped after retries
+ * @param	Now		: Current time in ticks
+ */
+void EsbLinkTxDone(ESBLINK * const pLink, bool bSent, uint32_t Now);
+
+/**
+ * @brief	Radio queue was flushed, all queued frames are lost.
+ *
+ * @param	pLink	: Pointer to link instance data
+ */
+void EsbLinkRadioFlush(ESBLINK * const pLink);
+
+/**
+ * @brief	Send pending frames, retransmissions, ACK & poll.
+ *
+ * Call on radio events and periodically for retransmit timeouts.
+ *
+ * @param	pLink	: Pointer to link instance data
+ * @param	Now		: Current time in ticks
+ */
+void EsbLinkProcess(ESBLINK * const pLink, uint32_t Now);
+
+/**
+ * @brief	Max message length.
+ *
+ * @param	pLink	: Pointer to link instance data
+ *
+ * @return	Max message length in bytes
+ */
+static inline int EsbLinkMsgMax(ESBLINK * const pLink) {
+	return pLink->MaxPayload - ESBLINK_HDR_LEN - (pLink->bPack ? 1 : 0);
+}
+
+/**
+ * @brief	Number of written frames not yet acknowledged.
+ *
+ * @param	pLink	: Pointer to link instance data
+ *
+ * @return	Frames in flight or waiting to be sent
+ */
+static inline int EsbLinkPending(ESBLINK * const pLink) {
+	return (uint8_t)(pLink->TxEnd - pLink->TxBase);
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} end group device_intrf */
+
+#endif // __ESB_LINK_H__
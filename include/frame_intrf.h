@@ -0,0 +1,278 @@
+/**-------------------------------------------------------------------------
+@file	frame_intrf.h
+
+@brief	Reliable framed transport device interface.
+
+Link agnostic reliable byte stream over any byte or packet device interface
+(UART, SLIP, BLE, ESB). Data written with TxData is cut into frames protected
+by CRC and sequence number. A sliding window selective repeat ARQ recovers
+lost and corrupted frames. Data read with RxData is exactly the data written
+by the peer, in order, without loss.
+
+Frame format :
+	SOF		: 1 byte, FRAMEINTRF_SOF
+	Flags	: 1 byte, FRAMEINTRF_FLAG_xxx
+	Seq		: Sequence number of this data frame
+	Ack		: Next sequence number expected from peer (cumulative ACK)
+	Win		: Frames the receiver can take from Ack (flow control)
+	Sack	: 2 bytes, bit n set when peer frame Ack + 1 + n was received
+	Len		: 2 bytes, data length
+	HCrc	: crc8_ccitt of Flags to Len
+	Data	: Len bytes
+	Crc		: 2 bytes, crc16_ccitt of Data. Absent when Len is 0
+
+There is no byte stuffing. On byte streams the receiver resynchronizes by
+hunting for the next SOF with a valid header CRC. On packet interfaces
+(bPacket) each RxData of the physical interface must return one whole frame.
+
+Every frame carries the receive state so that acknowledges ride on data
+going the other way. A frame is retransmitted when the retransmit timeout
+expires or right away when a later frame is selectively acknowledged. The
+timeout follows the measured round trip time, which includes the time frames
+wait in the physical interface Tx buffer. Rto is its lower bound. The receiver only accepts
+frames in the window it advertised, unread data holds the window closed.
+When the peer window is closed, the sender polls every Rto so that a lost
+window update does not stall the link.
+
+Time only moves with FrameIntrfProcess. The application must call it
+periodically. Everything runs in the caller context, Process, RxData and
+TxData must not preempt each other.
+
+Usage :
+
+	static uint8_t s_FrameMem[FRAMEINTRF_MEMSIZE(8, 256)];
+
+	FRAMEINTRF_CFG cfg = {
+		s_FrameMem, sizeof(s_FrameMem), 8, 256, 50, false
+	};
+
+	g_Frame.Init(&g_Uart, cfg);
+
+	while (1)
+	{
+		g_Frame.Process(msTime);
+		g_Frame.Tx(0, pData, Len);
+		l = g_Frame.Rx(0, buff, sizeof(buff));
+	}
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __FRAME_INTRF_H__
+#define __FRAME_INTRF_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "device_intrf.h"
+
+/** @addtogroup device_intrf
+  * @{
+  */
+
+#define FRAMEINTRF_SOF				0x7E	//!< Start of frame
+#define FRAMEINTRF_HDR_LEN			10		//!< Header length, SOF to HCrc
+#define FRAMEINTRF_CRC_LEN			2		//!< Data CRC length
+#define FRAMEINTRF_WINDOW_MAX		16		//!< Max frames in flight, Sack bits
+#define FRAMEINTRF_PAYLOAD_MAX		4096	//!< Max data per frame
+
+#define FRAMEINTRF_FLAG_DATA		(1<<0)	//!< Frame carries data, Seq valid
+#define FRAMEINTRF_FLAG_POLL		(1<<1)	//!< Sender requests an immediate ACK
+
+/// Max frame length on the wire
+#define FRAMEINTRF_FRAME_MAX(MaxPayload)		(FRAMEINTRF_HDR_LEN + (MaxPayload) + FRAMEINTRF_CRC_LEN)
+
+/// Data slot size in bytes
+#define FRAMEINTRF_SLOT_SIZE(MaxPayload)		(((MaxPayload) + 3) & ~3)
+
+/// Memory size in bytes required for a window of Window frames of MaxPayload bytes
+#define FRAMEINTRF_MEMSIZE(Window, MaxPayload)	(2 * (Window) * FRAMEINTRF_SLOT_SIZE(MaxPayload) + \
+												 2 * ((FRAMEINTRF_FRAME_MAX(MaxPayload) + 3) & ~3))
+
+#pragma pack(push, 4)
+
+/// Framed transport configuration
+typedef struct __Frame_Intrf_Config {
+	uint8_t *pMem;				//!< Frame memory, see FRAMEINTRF_MEMSIZE
+	uint32_t MemSize;			//!< Frame memory size in bytes
+	int Window;					//!< Max frames in flight, power of 2, max FRAMEINTRF_WINDOW_MAX
+	int MaxPayload;				//!< Max data per frame, max FRAMEINTRF_PAYLOAD_MAX
+	uint32_t Rto;				//!< Min retransmit timeout in Process time unit
+	bool bPacket;				//!< Physical interface is packet based, one frame per RxData
+} FRAMEINTRF_CFG;
+
+/// Framed transport counters
+typedef struct __Frame_Intrf_Stat {
+	uint32_t TxFrameCnt;		//!< Data frames sent, first time
+	uint32_t RtxCnt;			//!< Data frames retransmitted
+	uint32_t AckFrameCnt;		//!< ACK only frames sent
+	uint32_t RxFrameCnt;		//!< Valid frames received
+	uint32_t CrcErrCnt;			//!< Frames dropped on header or data CRC error
+	uint32_t DupCnt;			//!< Duplicate or out of window data frames
+	uint32_t SkipCnt;			//!< Bytes skipped hunting for start of frame
+} FRAMEINTRF_STAT;
+
+/// Framed transport instance data
+typedef struct __Frame_Intrf_Device {
+	DEVINTRF DevIntrf;			//!< This interface
+	DEVINTRF *pPhyIntrf;		//!< Physical transport interface
+	uint8_t *pTxMem;			//!< Transmit data slots
+	uint8_t *pRxMem;			//!< Receive data slots
+	uint8_t *pTxOut;			//!< Frame being written to physical interface
+	uint8_t *pRxAsm;			//!< Frame being assembled from physical interface
+	uint16_t SlotSize;			//!< Slot size in bytes
+	uint16_t MaxPayload;		//!< Max data per frame
+	uint8_t Window;				//!< Max frames in flight
+	uint8_t WinMask;			//!< Window - 1
+	bool bPacket;				//!< Packet based physical interface
+	uint32_t Rto;				//!< Min retransmit timeout
+	uint32_t CurRto;			//!< Current retransmit timeout, from round trip time
+	uint32_t Srtt;				//!< Smoothed round trip time, 0 no sample yet
+	uint32_t RttVar;			//!< Round trip time variation
+	uint32_t CurTime;			//!< Time of last Process call
+	// Transmit state
+	uint8_t TxBase;				//!< Oldest unacknowledged sequence number
+	uint8_t TxNext;				//!< Next sequence number to send
+	uint8_t TxEnd;				//!< Next sequence number to fill
+	uint8_t PeerWin;			//!< Frames peer accepts from TxBase
+	uint16_t TxLen[FRAMEINTRF_WINDOW_MAX];	//!< Frame data length
+	uint32_t TxTime[FRAMEINTRF_WINDOW_MAX];	//!< Time of last send
+	uint16_t TxAcked;			//!< Selectively acknowledged frames, bit per slot
+	uint16_t TxRtx;				//!< Frames to retransmit now, bit per slot
+	uint16_t TxFast;			//!< Frames fast retransmitted since last timeout, bit per slot
+	uint16_t TxRtxd;			//!< Frames retransmitted at least once, no RTT sample, bit per slot
+	uint32_t PollTime;			//!< Time of last poll
+	uint16_t TxOutLen;			//!< Length of frame in pTxOut
+	uint16_t TxOutIdx;			//!< Bytes of pTxOut already written
+	// Receive state
+	uint8_t RxRead;				//!< Oldest frame not fully read by application
+	uint8_t RxBase;				//!< Next sequence number expected
+	uint16_t RxReadOff;			//!< Bytes already read from frame RxRead
+	uint16_t RxValid;			//!< Buffered out of order frames, bit per slot
+	uint16_t RxLen[FRAMEINTRF_WINDOW_MAX];	//!< Buffered frame data length
+	uint16_t RxAsmLen;			//!< Bytes in pRxAsm
+	uint8_t LastWin;			//!< Window last advertised
+	bool bAckPending;			//!< Receive state changed since last sent
+	FRAMEINTRF_STAT Stat;		//!< Counters
+} FRAMEINTRF_DEV;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize framed transport.
+ *
+ * @param	pDev		: Pointer to instance data
+ * @param	pPhyIntrf	: Pointer to physical transport interface
+ * @param	pCfg		: Pointer to configuration data
+ *
+ * @return	true - Success
+ */
+bool FrameIntrfInit(FRAMEINTRF_DEV * const pDev, DEVINTRF * const pPhyIntrf, const FRAMEINTRF_CFG * const pCfg);
+
+/**
+ * @brief	Receive from physical interface, send pending frames,
+ * retransmissions, ACK & poll.
+ *
+ * @param	pDev	: Pointer to instance data
+ * @param	CurTime	: Current time, same unit as Rto
+ */
+void FrameIntrfProcess(FRAMEINTRF_DEV * const pDev, uint32_t CurTime);
+
+/**
+ * @brief	Number of written bytes not yet acknowledged by peer.
+ *
+ * @param	pDev	: Pointer to instance data
+ *
+ * @return	Bytes in flight or waiting to be sent
+ */
+int FrameIntrfTxPending(FRAMEINTRF_DEV * const pDev);
+
+/**
+ * @brief	Number of received bytes waiting to be read.
+ *
+ * @param	pDev	: Pointer to instance data
+ *
+ * @return	Bytes ready for RxData
+ */
+int FrameIntrfRxAvail(FRAMEINTRF_DEV * const pDev);
+
+static inline int FrameIntrfRx(FRAMEINTRF_DEV * const pDev, uint8_t *pBuff, int BuffLen) {
+	return DeviceIntrfRx(&pDev->DevIntrf, 0, pBuff, BuffLen);
+}
+static inline int FrameIntrfTx(FRAMEINTRF_DEV * const pDev, uint8_t *pData, int DataLen) {
+	return DeviceIntrfTx(&pDev->DevIntrf, 0, pData, DataLen);
+}
+
+#ifdef __cplusplus
+}
+
+class FrameIntrf : public DeviceIntrf {
+public:
+	bool Init(DeviceIntrf * const pIntrf, const FRAMEINTRF_CFG &Cfg);
+
+	/**
+	 * @brief	Operator to convert this class to device interface handle to be
+	 * 			used with C functions.
+	 *
+	 * @return	Pointer to internal DEVINTRF to be used with C interface functions
+	 */
+	operator DEVINTRF * const () { return &vDevData.DevIntrf; }
+	operator FRAMEINTRF_DEV * const () { return &vDevData; }
+
+	/**
+	 * @brief	Receive, send & retransmit, see FrameIntrfProcess.
+	 *
+	 * @param	CurTime	: Current time, same unit as Rto
+	 */
+	void Process(uint32_t CurTime) { FrameIntrfProcess(&vDevData, CurTime); }
+
+	int TxPending() { return FrameIntrfTxPending(&vDevData); }
+	int RxAvail() { return FrameIntrfRxAvail(&vDevData); }
+
+	int Rate(int DataRate) { return DeviceIntrfSetRate(*this, DataRate); }
+	int Rate(void) { return DeviceIntrfGetRate(*this); }
+	virtual bool StartRx(int DevAddr) { return DeviceIntrfStartRx(*this, DevAddr); }
+	virtual int RxData(uint8_t *pBuff, int BuffLen)  { return DeviceIntrfRxData(*this, pBuff, BuffLen); }
+	virtual void StopRx(void) { DeviceIntrfStopRx(*this); }
+	virtual bool StartTx(int DevAddr) { return DeviceIntrfStartTx(*this, DevAddr); }
+	virtual int TxData(uint8_t *pData, int DataLen) { return DeviceIntrfTxData(*this, pData, DataLen); }
+	virtual void StopTx(void) { DeviceIntrfStopTx(*this); }
+
+private:
+	FRAMEINTRF_DEV vDevData;
+};
+
+#endif
+
+/** @} end group device_intrf */
+
+#endif // __FRAME_INTRF_H__
@@ -3,6 +3,29 @@
 
 @brief	Intel Hex parser.
 
+IHexParseRecord parses a single record line. The streaming parser accepts
+arbitrary chunks of a hex file (UART, file system reads...), tracks extended
+segment/linear addresses and hands out data with absolute addresses to a
+callback. The image builder is such a callback, it assembles the data in a
+sparse map of flash pages and gives back coalesced page aligned ranges ready
+for erase/program.
+
+Usage :
+
+	IHEXIMAGE img;
+	IHEXPARSER hex;
+	IHEXRANGE r;
+
+	IHexImageInit(&img, s_ImgMem, sizeof(s_ImgMem), 4096, 0xFF);
+	IHexParserInit(&hex, IHexImageDataCB, &img);
+
+	while ((l = read(fd, buf, sizeof(buf))) > 0)
+		if (IHexParse(&hex, buf, l) != IHEX_ERR_NONE) ... error at line hex.LineNo
+
+	if (IHexParserFinish(&hex) == IHEX_ERR_NONE)
+		for (int i = 0; (i = IHexImageRange(&img, i, &r)) > 0; )
+			program r.Len bytes at r.Addr, read with IHexImageRead
+
 @author	Hoang Nguyen Hoan
 @date	Feb. 8, 2015
 
@@ -51,7 +74,9 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define IHEX_RECTYPE_STARTLADDR	5		// Start linear address
 
 
-#define IHEX_MAX_RECSIZE	16
+#define IHEX_MAX_RECSIZE	16		//!< Max data of IHexParseRecord, streaming parser takes 255
+
+#define IHEX_LINE_MAX		(1 + 2 * (5 + 255))	//!< Longest valid record line, excluding CR LF
 
 /// Structure containing results of parsed HEX record line
 typedef struct {
@@ -62,6 +87,75 @@ typedef struct {
 	uint8_t Data[IHEX_MAX_RECSIZE];
 } IHEXDATA;
 
+typedef enum __IHex_Error {
+	IHEX_ERR_NONE,			//!< No error
+	IHEX_ERR_FORMAT,		//!< Missing ':', non hex character, odd length
+	IHEX_ERR_LENGTH,		//!< Line length does not match record count or too long
+	IHEX_ERR_CHECKSUM,		//!< Bad record checksum
+	IHEX_ERR_RECORD,		//!< Unknown record type or bad record length for type
+	IHEX_ERR_WRITE,			//!< Data callback refused data, image full
+	IHEX_ERR_NOEOF,			//!< Input ended without EOF record
+} IHEX_ERR;
+
+/**
+ * @brief	Data callback.
+ *
+ * Called once per data record, never crossing a 64KB segment.
+ *
+ * @param	pCtx	: User context given at init
+ * @param	Addr	: Absolute address of first byte
+ * @param	pData	: Record data
+ * @param	Len		: Number of bytes
+ *
+ * @return	false to abort parsing with IHEX_ERR_WRITE
+ */
+typedef bool (*IHexDataCb_t)(void *pCtx, uint32_t Addr, const uint8_t *pData, int Len);
+
+#pragma pack(push, 4)
+
+/// Streaming parser
+typedef struct __IHex_Parser {
+	IHexDataCb_t DataCB;			//!< Data handler
+	void *pCtx;						//!< Data handler context
+	uint32_t BaseAddr;				//!< From extended segment or linear address record
+	bool bSegAddr;					//!< Base address is segment, offsets wrap at 64KB
+	bool bEof;						//!< EOF record received, remaining lines ignored
+	bool bStartValid;				//!< Start address record received
+	uint32_t StartAddr;				//!< Start linear address or CS:IP converted to linear
+	uint32_t LineNo;				//!< Lines processed, line of the error if any
+	uint32_t RecCnt;				//!< Data records
+	uint32_t ByteCnt;				//!< Data bytes
+	IHEX_ERR Err;					//!< Sticky error
+	int LineLen;					//!< Partial line held across chunks
+	char Line[IHEX_LINE_MAX + 3];	//!< Room for CR and trailing spaces
+} IHEXPARSER;
+
+/// Image page entry, kept sorted by address
+typedef struct __IHex_Page {
+	uint32_t Addr;					//!< Page address
+	uint32_t Slot;					//!< Data slot in image memory
+} IHEXPAGE;
+
+/// Sparse image made of fixed size pages
+typedef struct __IHex_Image {
+	uint32_t PageSize;				//!< Power of 2, flash erase page size
+	uint8_t Fill;					//!< Value of bytes not in hex file
+	int NbPageMax;					//!< Pages fitting in memory
+	int NbPage;						//!< Pages in use
+	int LastIdx;					//!< Page of last write, sequential data hits it
+	IHEXPAGE *pPage;				//!< Sorted page table
+	uint8_t *pData;					//!< Page data slots
+	uint32_t ByteCnt;				//!< Bytes written, overwrite counted again
+} IHEXIMAGE;
+
+/// Range of contiguous pages
+typedef struct __IHex_Range {
+	uint32_t Addr;					//!< Start address, page aligned
+	uint32_t Len;					//!< Length, multiple of page size
+} IHEXRANGE;
+
+#pragma pack(pop)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -73,11 +167,111 @@ extern "C" {
  * @param	pData : Pointer to place holder for parsed record
  *
  * @return	true - Success\n
- * 			false - Bad in record data
+ * 			false - Bad in record data or more than IHEX_MAX_RECSIZE data
  */
 bool IHexParseRecord(char *pRec, IHEXDATA *pData);
 
-	
+/**
+ * @brief	Initialize streaming parser.
+ *
+ * @param	pParser	: Parser context
+ * @param	DataCB	: Data record handler, NULL to only validate
+ * @param	pCtx	: Handler context
+ */
+void IHexParserInit(IHEXPARSER * const pParser, IHexDataCb_t DataCB, void *pCtx);
+
+/**
+ * @brief	Parse a chunk of hex file.
+ *
+ * Chunks can split lines anywhere. Lines end with LF or CR LF, empty lines
+ * are skipped. Complete lines are parsed in place, only a line split across
+ * chunks is copied.
+ *
+ * @param	pParser	: Parser context
+ * @param	pBuf	: Hex file text
+ * @param	Len		: Number of characters
+ *
+ * @return	IHEX_ERR_NONE or error, errors are sticky. pParser->LineNo is the
+ * 			line in error
+ */
+IHEX_ERR IHexParse(IHEXPARSER * const pParser, const char *pBuf, int Len);
+
+/**
+ * @brief	End of input. Parses a last line without line ending.
+ *
+ * @param	pParser	: Parser context
+ *
+ * @return	IHEX_ERR_NONE, IHEX_ERR_NOEOF if no EOF record was found or
+ * 			previous error
+ */
+IHEX_ERR IHexParserFinish(IHEXPARSER * const pParser);
+
+/**
+ * @brief	Initialize image.
+ *
+ * Memory holds both the page table and the page data, each page takes
+ * PageSize + sizeof(IHEXPAGE) bytes.
+ *
+ * @param	pImg		: Image context
+ * @param	pMem		: Image memory, 4 bytes aligned
+ * @param	MemSize		: Memory size in bytes
+ * @param	PageSize	: Page size, power of 2, at least 16
+ * @param	Fill		: Value of bytes not written
+ *
+ * @return	false if parameters are invalid or memory too small for 1 page
+ */
+bool IHexImageInit(IHEXIMAGE * const pImg, uint8_t *pMem, uint32_t MemSize, uint32_t PageSize, uint8_t Fill);
+
+/**
+ * @brief	Write data to image, allocating pages as needed.
+ *
+ * @param	pImg	: Image context
+ * @param	Addr	: Address of first byte
+ * @param	pData	: Data
+ * @param	Len		: Number of bytes
+ *
+ * @return	false if out of pages, data written before that is kept
+ */
+bool IHexImageWrite(IHEXIMAGE * const pImg, uint32_t Addr, const uint8_t *pData, int Len);
+
+/**
+ * @brief	Copy image content, addresses without page read as fill value.
+ *
+ * @param	pImg	: Image context
+ * @param	Addr	: Start address
+ * @param	pBuf	: Destination buffer
+ * @param	Len		: Number of bytes
+ */
+void IHexImageRead(IHEXIMAGE * const pImg, uint32_t Addr, uint8_t *pBuf, uint32_t Len);
+
+/**
+ * @brief	Get page by index in address order.
+ *
+ * @param	pImg	: Image context
+ * @param	Idx		: Page index, 0 to pImg->NbPage - 1
+ * @param	pAddr	: Page address returned here
+ *
+ * @return	Pointer to PageSize bytes or NULL if index out of range
+ */
+uint8_t *IHexImagePage(IHEXIMAGE * const pImg, int Idx, uint32_t *pAddr);
+
+/**
+ * @brief	Get next coalesced range of contiguous pages.
+ *
+ * @param	pImg	: Image context
+ * @param	Idx		: Page index to start from, 0 for the first range
+ * @param	pRange	: Range returned here
+ *
+ * @return	Page index following the range, to pass for the next one.
+ * 			0 when there are no more ranges
+ */
+int IHexImageRange(IHEXIMAGE * const pImg, int Idx, IHEXRANGE * const pRange);
+
+/**
+ * @brief	IHexDataCb_t handler writing to image, pCtx is the IHEXIMAGE.
+ */
+bool IHexImageDataCB(void *pCtx, uint32_t Addr, const uint8_t *pData, int Len);
+
 #ifdef __cplusplus
 }
 #endif
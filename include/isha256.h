@@ -3,6 +3,9 @@
 
 @brief	SHA-256 computation.
 
+Sha256Init/Sha256Update/Sha256Final work on a caller owned context and are
+reentrant. Sha256 is the original single stream string digest interface.
+
 @author	Hoang Nguyen Hoan
 @date	Aug. 17, 2014
 
@@ -36,11 +39,27 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __ISHA256_H__
 
 #include <stdint.h>
+#include <stddef.h>
 
 /** @addtogroup Utilities
   * @{
   */
 
+#define SHA256_DIGEST_LEN		32		//!< Binary digest length in bytes
+#define SHA256_BLOCK_LEN		64		//!< Message block length in bytes
+
+#pragma pack(push, 4)
+
+/// SHA-256 context
+typedef struct __Sha256_Ctx {
+	uint32_t H[8];					//!< Intermediate hash value
+	uint64_t TotalLen;				//!< Message length in bytes
+	int BuffLen;					//!< Bytes waiting in Buff for a full block
+	uint8_t Buff[SHA256_BLOCK_LEN];
+} SHA256CTX;
+
+#pragma pack(pop)
+
 /*
  * Test cases.
  * Data   : null, zero length
@@ -85,6 +104,31 @@ extern "C" {
  */
 char *Sha256(uint8_t *pData, int DataLen, bool bLast, char *pRes);
 
+/**
+ * @brief	Start new digest.
+ *
+ * @param	pCtx	: Context
+ */
+void Sha256Init(SHA256CTX * const pCtx);
+
+/**
+ * @brief	Add message data.
+ *
+ * @param	pCtx	: Context
+ * @param	pData	: Message data
+ * @param	DataLen	: Length in bytes
+ */
+void Sha256Update(SHA256CTX * const pCtx, const uint8_t *pData, size_t DataLen);
+
+/**
+ * @brief	Pad message and return binary digest. Context must be
+ * initialized again for a new message.
+ *
+ * @param	pCtx	: Context
+ * @param	pDigest	: SHA256_DIGEST_LEN bytes digest, big endian
+ */
+void Sha256Final(SHA256CTX * const pCtx, uint8_t *pDigest);
+
 #ifdef __cplusplus
 }
 #endif
@@ -36,7 +36,9 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __LED_APA102_H__
 
 #include "led.h"
+#include "miscdev/led_apa102_frame.h"
 
+/// Bit-bang GPIO configuration
 typedef struct __APA102_Config {
 	int NbLed;
 	uint8_t CIPortNo;
@@ -46,10 +48,34 @@ typedef struct __APA102_Config {
 	uint8_t Brightness;
 } APA102_CFG;
 
+/// APA102 LED strip.
+///
+/// Either bit-banged on GPIO or, preferably, driven by an SPI interface through
+/// a double buffered pre-encoded frame (see led_apa102_frame.h). Pixels are 0x00RRGGBB.
 class LedApa102 : public Led {
 public:
+	/**
+	 * @brief	Initialize strip bit-banged on GPIO
+	 *
+	 * @param	Cfg	: GPIO configuration
+	 *
+	 * @return	true on success
+	 */
 	bool Init(APA102_CFG &Cfg);
 
+	/**
+	 * @brief	Initialize strip driven by SPI
+	 *
+	 * SPI should be configured in mode 0, MSB first, with DMA enabled when
+	 * available.
+	 *
+	 * @param	pIntrf	: SPI interface the strip is connected to
+	 * @param	Cfg		: Frame encoder configuration, frame memory is kept
+	 *
+	 * @return	true on success
+	 */
+	bool Init(DeviceIntrf * const pIntrf, APA102_FRAME_CFG &Cfg);
+
 	/**
 	 * Turns 1st LED 100% on
 	 *
@@ -90,17 +116,48 @@ public:
 	 * This function sets the levels strip RGB strip LED.  These LEDs are monrally
 	 * controlled via a serial interface.
 	 *
-	 * @param	pLevel : pointer to array of RGB LED to set
+	 * @param	pLevel : pointer to array of RGB LED to set, not modified
 	 * @param 	NbLeds : Number of LED to set.
 	 * @param	Repeat : Repeat count.
 	 */
 	virtual void Level(uint32_t * const pVal, int NbLeds, int Repeat = 0);
 
+	/**
+	 * @brief	Encode pixels into back buffer without transferring.
+	 *
+	 * SPI mode only, ignored when bit-banged. Call Show to transfer.
+	 *
+	 * @param	Idx		: Index of first LED
+	 * @param	pPixels	: Pixels, 0x00RRGGBB
+	 * @param	Count	: Number of pixels
+	 */
+	void SetPixels(int Idx, const uint32_t *pPixels, int Count) {
+		if (vpIntrf)
+			Apa102FrameSetPixels(&vFrame, Idx, pPixels, Count);
+	}
+
+	/**
+	 * @brief	Transfer changed pixels to the strip.
+	 *
+	 * SPI mode only.
+	 *
+	 * @return	false if interface busy, changes are kept for next call.
+	 * 			Always false when bit-banged
+	 */
+	bool Show() { return vpIntrf ? Apa102FrameShow(&vFrame, *vpIntrf) : false; }
+
+	APA102_FRAME * const Frame() { return &vFrame; }
+
+	// Raw bit-bang access. Data words include the header byte
 	void StartTx();
 	void TxData(uint32_t * const pData, int DataLen);
 	void StopTx();
 
 private:
+	void ShiftOut(uint32_t Data, int NbBits);
+
+	DeviceIntrf *vpIntrf;	//!< SPI interface, NULL when bit-banged
+	APA102_FRAME vFrame;	//!< Frame encoder in SPI mode
 	int vNbLed;			//!< Total number of Led in strip
 	uint8_t vCIPortNo;	//!< Clock pin i/o port number
 	uint8_t vCIPinNo;	//!< Clock pin i/o pin number
@@ -0,0 +1,274 @@
+/**-------------------------------------------------------------------------
+@file	led_apa102_frame.h
+
+@brief	APA102 LED strip frame encoder.
+
+Renders pixels into a pre-encoded APA102 SPI byte stream so that a whole strip
+update is a single interface transfer instead of a bit-banged loop.
+
+Frame layout, one buffer :
+
+	| start 4 x 0x00 | NbLed x [0xE0 | Bright, c0, c1, c2] | end zeros |
+
+The end frame is 4 zero bytes, which latches SK9822 clones, followed by
+(NbLed + 15) / 16 zero bytes. Those provide the NbLed / 2 extra clock edges
+needed for data to ripple through the chain. Zeros are used rather than 0xFF so
+that LEDs past NbLed on a longer strip are never lit.
+
+Two buffers are kept. Pixels are always encoded into the back buffer and
+Apa102FrameShow swaps it to the front then transfers it. Rendering never
+touches the buffer being transferred. Only the LED range changed since the
+last swap is copied back, so a partial update costs a copy of that range.
+With partial update enabled, the transfer is cut after the last changed LED
+and LEDs further down the strip are not clocked.
+
+Channel values go through a 256 entry gamma and level lookup table. In fixed
+brightness mode the 5 bit header brightness is constant. In HDR mode it is
+chosen per pixel from a 16 bit LUT, extending low level resolution by up to
+31 times.
+
+Pixels are 0x00RRGGBB. Wire color order is configurable, APA102 native is BGR.
+
+Usage :
+
+	static uint8_t s_LedMem[2 * APA102_FRAME_SIZE(300)];
+
+	APA102_FRAME_CFG cfg = {
+		.NbLed = 300,
+		.pMem = s_LedMem,
+		.MemSize = sizeof(s_LedMem),
+		.Order = APA102_ORDER_BGR,
+		.Brightness = 31,
+		.Level = 255,
+		.Gamma = 2.2,
+		.bHdr = false,
+		.bPartial = true,
+	};
+	Apa102FrameInit(&g_Frame, &cfg);
+
+	Apa102FrameSetPixels(&g_Frame, 0, Pixels, 300);
+	Apa102FrameShow(&g_Frame, &g_Spi);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __LED_APA102_FRAME_H__
+#define __LED_APA102_FRAME_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "device_intrf.h"
+
+/** @addtogroup MiscDev
+  * @{
+  */
+
+#define APA102_START_SIZE			4		//!< Start frame, 32 zero bits
+#define APA102_LED_SIZE				4		//!< Bytes per LED
+#define APA102_HDR					0xE0	//!< LED frame marker bits
+#define APA102_BRIGHTNESS_MAX		31		//!< Max 5 bits header brightness
+
+/// End frame size in bytes to latch NbLed LEDs
+#define APA102_END_SIZE(NbLed)		(4 + ((NbLed) + 15) / 16)
+
+/// Size in bytes of one encoded frame. Frame memory must be twice this size
+#define APA102_FRAME_SIZE(NbLed)	(APA102_START_SIZE + APA102_LED_SIZE * (NbLed) + APA102_END_SIZE(NbLed))
+
+/// Color order on the wire after the header byte
+typedef enum __Apa102_Color_Order {
+	APA102_ORDER_BGR,		//!< APA102 & SK9822 native
+	APA102_ORDER_BRG,
+	APA102_ORDER_GBR,
+	APA102_ORDER_GRB,
+	APA102_ORDER_RBG,
+	APA102_ORDER_RGB,
+} APA102_ORDER;
+
+#pragma pack(push, 4)
+
+/// Frame encoder configuration
+typedef struct __Apa102_Frame_Config {
+	int NbLed;				//!< Number of LEDs in strip
+	uint8_t *pMem;			//!< Frame memory, 2 * APA102_FRAME_SIZE(NbLed) bytes
+	uint32_t MemSize;		//!< Frame memory size in bytes
+	APA102_ORDER Order;		//!< Wire color order
+	uint8_t Brightness;		//!< Header brightness 0-31 in fixed mode
+	uint8_t Level;			//!< Master level 0-255, scales the LUT
+	float Gamma;			//!< Gamma exponent, 0 defaults to 1, linear
+	bool bHdr;				//!< Select header brightness per pixel
+	bool bPartial;			//!< Transfer only up to the last changed LED
+} APA102_FRAME_CFG;
+
+/// Frame encoder instance data
+typedef struct __Apa102_Frame {
+	uint8_t *pBuff[2];		//!< Encoded frame buffers
+	volatile int Back;		//!< Index of buffer being rendered
+	int NbLed;				//!< Number of LEDs in strip
+	int FrameSize;			//!< Bytes per buffer
+	uint8_t Shift[3];		//!< Pixel bit shift of each wire color byte
+	uint8_t Hdr;			//!< Header byte in fixed mode
+	bool bHdr;				//!< Header brightness per pixel
+	bool bPartial;			//!< Partial transfer enabled
+	int DirtyLo;			//!< First LED changed in back buffer since last swap
+	int DirtyHi;			//!< Last LED + 1 changed in back buffer since last swap
+	uint32_t ShowCnt;		//!< Frames transferred
+	uint32_t BusyCnt;		//!< Show skipped with interface busy
+	uint8_t Lut8[256];		//!< Gamma & level, 8 bits output for fixed mode
+	uint16_t Lut16[256];	//!< Gamma & level, 16 bits output for HDR mode
+} APA102_FRAME;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize frame encoder.
+ *
+ * Both buffers are filled with start frame, all LEDs off and end frame.
+ * The whole strip is marked changed so that the first Show clears it.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	pCfg	: Pointer to configuration data
+ *
+ * @return	true on success
+ */
+bool Apa102FrameInit(APA102_FRAME * const pFrame, const APA102_FRAME_CFG * const pCfg);
+
+/**
+ * @brief	Rebuild lookup tables from gamma & master level.
+ *
+ * Only pixels set afterward are affected. Set the pixels again to apply it
+ * to the whole strip.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	Gamma	: Gamma exponent, 1 is linear
+ * @param	Level	: Master level 0-255
+ */
+void Apa102FrameSetGamma(APA102_FRAME * const pFrame, float Gamma, uint8_t Level);
+
+/**
+ * @brief	Load custom 16 bits lookup table.
+ *
+ * The 8 bits table used in fixed mode is derived from it. Only pixels set
+ * afterward are affected.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	pLut	: 256 entries, 0-65535 output intensity
+ */
+void Apa102FrameSetLut(APA102_FRAME * const pFrame, const uint16_t *pLut);
+
+/**
+ * @brief	Set header brightness used in fixed mode.
+ *
+ * @param	pFrame		: Pointer to frame encoder instance
+ * @param	Brightness	: 0-31
+ */
+void Apa102FrameSetBrightness(APA102_FRAME * const pFrame, uint8_t Brightness);
+
+/**
+ * @brief	Encode pixels into the back buffer.
+ *
+ * Pixels outside of the strip are ignored.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	Idx		: Index of first LED
+ * @param	pPixels	: Pixels, 0x00RRGGBB
+ * @param	Count	: Number of pixels
+ */
+void Apa102FrameSetPixels(APA102_FRAME * const pFrame, int Idx, const uint32_t *pPixels, int Count);
+
+/**
+ * @brief	Set a range of LEDs to the same color.
+ *
+ * The pixel is encoded once and the LED frame replicated.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	Idx		: Index of first LED
+ * @param	Pixel	: Pixel, 0x00RRGGBB
+ * @param	Count	: Number of LEDs
+ */
+void Apa102FrameFill(APA102_FRAME * const pFrame, int Idx, uint32_t Pixel, int Count);
+
+/**
+ * @brief	Mark the whole strip changed.
+ *
+ * Next Show transfers the full frame. Use after the strip was power cycled.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ */
+void Apa102FrameInvalidate(APA102_FRAME * const pFrame);
+
+/**
+ * @brief	Swap buffers & transfer the frame.
+ *
+ * Does nothing when no LED changed since last Show. If the interface is busy
+ * nothing is swapped and changes keep accumulating in the back buffer for
+ * the next call.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	pIntrf	: SPI interface the strip is connected to
+ *
+ * @return	true - frame transferred or nothing to do\n
+ * 			false - interface busy or transfer failed
+ */
+bool Apa102FrameShow(APA102_FRAME * const pFrame, DEVINTRF * const pIntrf);
+
+/**
+ * @brief	Encode one LED frame.
+ *
+ * @param	pFrame	: Pointer to frame encoder instance
+ * @param	Pixel	: Pixel, 0x00RRGGBB
+ * @param	pOut	: 4 bytes output, header + 3 colors in wire order
+ */
+void Apa102FrameEncode(APA102_FRAME * const pFrame, uint32_t Pixel, uint8_t *pOut);
+
+/// Pointer to the front buffer, last frame transferred
+static inline uint8_t *Apa102FrameFront(APA102_FRAME * const pFrame) {
+	return pFrame->pBuff[pFrame->Back ^ 1];
+}
+
+/// Pointer to the back buffer, frame being rendered
+static inline uint8_t *Apa102FrameBack(APA102_FRAME * const pFrame) {
+	return pFrame->pBuff[pFrame->Back];
+}
+
+/// True when LEDs were changed since last Show
+static inline bool Apa102FrameChanged(APA102_FRAME * const pFrame) {
+	return pFrame->DirtyHi > pFrame->DirtyLo;
+}
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group MiscDev */
+
+#endif // __LED_APA102_FRAME_H__
@@ -19,6 +19,30 @@ void LedMxStartTx(LEDMXDEV *pDev, int PanelAddr);
 void LedMxStopTx(LEDMXDEV *pDev);
 void LedMxTxData(LEDMXDEV *pDev, uint32_t Data, int NbBits);
 
+Framebuffer :
+
+When LEDMXCFG.pFbMem is set, text is rendered into an in RAM copy of the panel
+columns and LedMxFlush only transmits columns that differ from what the panels
+already hold. Changed columns of a panel are sent as runs, each one write
+command. Printing the same text again sends nothing and updating a counter only
+sends the digits that changed.
+
+The HT1632 has no hardware scroll, so every column whose content moves must be
+rewritten. The scroll engine shifts the framebuffer in RAM and only renders the
+incoming column from the font. Blank areas and identical neighbor columns are
+skipped by the flush.
+
+	static uint8_t s_LedMxFb[LEDMX_FBMEM_SIZE(4)];
+	LEDMXSCROLL scroll;
+
+	cfg.pFbMem = s_LedMxFb;
+	LedMxInit(&g_LedMx, &cfg);
+
+	LedMxScrollInit(&g_LedMx, &scroll, "Hello world", false);
+	while (LedMxScrollStep(&g_LedMx, &scroll))
+	{
+		msDelay(30);
+	}
 
 @author	Hoang Nguyen Hoan
 @date	Feb. 28, 2011
@@ -53,6 +77,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <stdarg.h>
 #include <string.h>
+#include <stdbool.h>
 
 #include "ledmxfont.h"
 
@@ -71,6 +96,10 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 
 #define LEDMX_MAX_PANEL			16
+#define LEDMX_PANEL_NBCOL		32		//!< Columns per panel, 8 bits each
+
+/// Framebuffer memory size in bytes for NbPanel panels
+#define LEDMX_FBMEM_SIZE(NbPanel)	(2 * LEDMX_PANEL_NBCOL * (NbPanel))
 
 typedef enum {
 	LEDMXPRTMODE_JLEFT,
@@ -96,6 +125,7 @@ typedef struct {
     int PanelAddr[LEDMX_MAX_PANEL];
     int FontLen;
     LEDMXFONT_BITMAP const *pFont;
+    uint8_t *pFbMem;	//!< Framebuffer memory, LEDMX_FBMEM_SIZE(NbPanel) bytes. NULL to write panels directly
 } LEDMXCFG;
 
 typedef struct {
@@ -104,8 +134,21 @@ typedef struct {
     int FontLen;
     LEDMXFONT_BITMAP const *pFont;
     void *pIODev;		// Pointer to platform specific I/O control
+    uint8_t *pFb;		//!< Framebuffer, one byte per column. NULL if not used
+    uint8_t *pShadow;	//!< Columns currently in panel RAM
+    uint32_t Dirty[LEDMX_MAX_PANEL];	//!< Columns written since last flush, 1 bit per column
 } LEDMXDEV;
 
+/// Scroll engine state
+typedef struct {
+	const char *pStr;	//!< Text being scrolled, must stay valid until done
+	int Len;			//!< Text length in characters
+	int Idx;			//!< Index of character providing the next column
+	int Col;			//!< Next column in that character
+	int Trail;			//!< Blank columns left to push the text out
+	bool bRight;		//!< Scroll direction, text moves right
+} LEDMXSCROLL;
+
 #pragma pack(pop)
 
 #ifdef __cplusplus
@@ -128,6 +171,74 @@ void LedMxPrintScrollRight(LEDMXDEV *pDev, const char *pStr);
 void LedMxSetRam(LEDMXDEV *pDev, unsigned RamAddr, char Data, int Len, int PanelNo);
 void LedMxWriteRam(LEDMXDEV *pDev, unsigned Addr, uint8_t const *pData, int Len, int DevNo);
 
+/**
+ * @brief	Clear framebuffer. Nothing is sent until LedMxFlush.
+ *
+ * @param	pDev	: LED matrix device data
+ */
+void LedMxFbClear(LEDMXDEV *pDev);
+
+/**
+ * @brief	Set one framebuffer column.
+ *
+ * @param	pDev	: LED matrix device data
+ * @param	Col		: Column, out of range is ignored
+ * @param	Data	: Column pixels, bit per row
+ */
+void LedMxFbSetCol(LEDMXDEV *pDev, int Col, uint8_t Data);
+
+/**
+ * @brief	Draw text into framebuffer.
+ *
+ * Glyphs are clipped to the display. Columns not covered by the text are left
+ * untouched.
+ *
+ * @param	pDev	: LED matrix device data
+ * @param	Col		: Column of first glyph, can be negative
+ * @param	pStr	: Text
+ *
+ * @return	Column following the text
+ */
+int LedMxFbDrawStr(LEDMXDEV *pDev, int Col, const char *pStr);
+
+/**
+ * @brief	Shift framebuffer content, vacated columns are cleared.
+ *
+ * @param	pDev	: LED matrix device data
+ * @param	NbCol	: Number of columns, positive shifts right, negative left
+ */
+void LedMxFbShift(LEDMXDEV *pDev, int NbCol);
+
+/**
+ * @brief	Send framebuffer columns that differ from panel RAM.
+ *
+ * @param	pDev	: LED matrix device data
+ *
+ * @return	Number of bits transmitted
+ */
+int LedMxFlush(LEDMXDEV *pDev);
+
+/**
+ * @brief	Start scrolling text from outside of the display.
+ *
+ * @param	pDev	: LED matrix device data
+ * @param	pScroll	: Scroll state
+ * @param	pStr	: Text, must stay valid until scrolling is done
+ * @param	bRight	: true - text enters on the left and moves right\n
+ * 					  false - text enters on the right and moves left
+ */
+void LedMxScrollInit(LEDMXDEV *pDev, LEDMXSCROLL *pScroll, const char *pStr, bool bRight);
+
+/**
+ * @brief	Scroll by one column and flush.
+ *
+ * @param	pDev	: LED matrix device data
+ * @param	pScroll	: Scroll state
+ *
+ * @return	false once the text has left the display
+ */
+bool LedMxScrollStep(LEDMXDEV *pDev, LEDMXSCROLL *pScroll);
+
 // Private platform dependent impletmentation
 void LedMxIOInit(LEDMXDEV *pLedMxDev, LEDMXCFG *pCfg);
 void LedMxStartTx(LEDMXDEV *pDev, int PanelAddr);
@@ -169,7 +280,15 @@ public:
 	void SetRam(unsigned RamAddr, char Data, int Len, int PanelAddr) {
 			LedMxSetRam(&vDevData, RamAddr, Data, Len, PanelAddr); }
 	int PixStrLen(const char *pStr) { return LedMxPixStrLen(&vDevData, pStr); }
-	int GetNbCol(void) { return  vDevData.NbPanel * 32; }
+	void FbClear() { LedMxFbClear(&vDevData); }
+	void FbSetCol(int Col, uint8_t Data) { LedMxFbSetCol(&vDevData, Col, Data); }
+	int FbDrawStr(int Col, const char *pStr) { return LedMxFbDrawStr(&vDevData, Col, pStr); }
+	void FbShift(int NbCol) { LedMxFbShift(&vDevData, NbCol); }
+	int Flush() { return LedMxFlush(&vDevData); }
+	void ScrollInit(LEDMXSCROLL &Scroll, const char *pStr, bool bRight = false) {
+		LedMxScrollInit(&vDevData, &Scroll, pStr, bRight); }
+	bool ScrollStep(LEDMXSCROLL &Scroll) { return LedMxScrollStep(&vDevData, &Scroll); }
+	int GetNbCol(void) { return  vDevData.NbPanel * LEDMX_PANEL_NBCOL; }
 	operator LEDMXDEV * () { return &vDevData; }
 
 protected:
@@ -35,11 +35,111 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __PRBS_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 
 /** @addtogroup Utilities
   * @{
   */
 
+/**
+ * PRBS bit stream types. Polynomials are those of ITU-T O.150.
+ *
+ * The bit stream is packed LSB first, bit 0 of byte 0 is the first bit, same
+ * as the UART transmit order.
+ *
+ * PRBS_TYPE_PRBS8 is not a bit stream. It is the byte sequence of Prbs8()
+ * as sent by the uart_prbs_tx examples, each byte being the next LFSR state.
+ */
+typedef enum __Prbs_Type {
+	PRBS_TYPE_PRBS8,		//!< Legacy Prbs8() byte sequence, period 127 bytes
+	PRBS_TYPE_PRBS7,		//!< x^7 + x^6 + 1
+	PRBS_TYPE_PRBS15,		//!< x^15 + x^14 + 1
+	PRBS_TYPE_PRBS23,		//!< x^23 + x^18 + 1
+	PRBS_TYPE_PRBS31,		//!< x^31 + x^28 + 1
+} PRBS_TYPE;
+
+#define PRBS_HIST_SIZE			48		//!< Max generator history in bytes
+
+#define PRBSCHK_SYNC_DEFAULT	8		//!< Default consecutive good bytes to lock
+#define PRBSCHK_WIN_DEFAULT		128		//!< Default loss of sync window in bytes
+#define PRBSCHK_GAP_DEFAULT		64		//!< Default error free bits ending a burst
+
+#pragma pack(push, 4)
+
+/**
+ * Generator state.
+ *
+ * Bytes are produced 8 at a time from the stream own history. A sequence of
+ * x^n + x^m + 1 also satisfies (x^n + x^m + 1)^8 = x^8n + x^8m + 1, that is
+ * byte k = byte (k - n) ^ byte (k - m). PRBS7, 15 & 23 use a higher power of 2
+ * so 64 bits reads stay well behind the word being written.
+ */
+typedef struct __Prbs_Gen {
+	PRBS_TYPE Type;
+	bool bInvert;					//!< Inverted output (O.150 for PRBS15/23/31)
+	uint8_t Dist1;					//!< Long recurrence distance in bytes
+	uint8_t Dist2;					//!< Short recurrence distance in bytes
+	uint8_t Pending;				//!< Hist bytes not output yet (seed state after init)
+	uint8_t Hist[PRBS_HIST_SIZE];	//!< Last Dist1 bytes generated, oldest first
+} PRBSGEN;
+
+/// Checker configuration
+typedef struct __Prbs_Chk_Cfg {
+	PRBS_TYPE Type;
+	bool bInvert;					//!< Inverted stream
+	int SyncLen;					//!< Consecutive good bytes required to lock, 0 for default
+	int WinLen;						//!< Loss of sync window in bytes, 0 for default
+	int LossThres;					//!< Errored bits in window declaring loss of sync, 0 : WinLen
+	int BurstGap;					//!< Error free bits ending a burst, 0 for default
+} PRBSCHK_CFG;
+
+/// Error burst tracking, snapshot at each window start so a slipped window can be undone
+typedef struct __Prbs_Burst {
+	uint64_t ErrCnt;				//!< Bit errors
+	uint64_t BurstCnt;				//!< Number of error bursts
+	uint64_t BurstBits;				//!< Sum of burst lengths in bits
+	uint32_t BurstMax;				//!< Longest burst in bits
+	bool bInBurst;					//!< A burst is open
+	uint64_t BurstStart;			//!< Bit position of first error of open burst
+	uint64_t LastErr;				//!< Bit position of last error
+} PRBSBURST;
+
+/**
+ * Self synchronizing checker.
+ *
+ * Hunting : each received byte is predicted from previously received bytes.
+ * After SyncLen consecutive correct predictions the local reference generator
+ * is loaded from the received history and the checker locks. Locked, data is
+ * compared against the reference so each bit error counts exactly once. A
+ * window with LossThres or more errored bits is a slip (dropped or inserted
+ * data) and hunting restarts. A slip may begin near the end of the previous
+ * window without reaching the threshold there, so statistics are committed one
+ * window late and both windows are removed on a slip.
+ */
+typedef struct __Prbs_Chk {
+	PRBSGEN Ref;					//!< Reference generator, valid when locked
+	int SyncLen;
+	int WinLen;
+	int LossThres;
+	int BurstGap;
+	bool bLocked;
+	int GoodCnt;					//!< Consecutive good predictions while hunting
+	int HistCnt;					//!< Valid bytes in Ref.Hist while hunting
+	int WinCnt;						//!< Bytes checked in current window
+	uint32_t WinErr;				//!< Errored bits in current window
+	uint64_t BitCnt;				//!< Bits checked while locked (committed windows)
+	bool bPrev;						//!< Previous window not committed yet
+	uint64_t WinStart;				//!< Bit position of current window
+	uint64_t HuntBytes;				//!< Bytes received while not locked
+	uint32_t SlipCnt;				//!< Loss of sync count
+	uint32_t LockCnt;				//!< Number of times lock was acquired
+	PRBSBURST Burst;				//!< Committed error statistics
+	PRBSBURST PrevBurst;			//!< Error statistics up to previous window
+	PRBSBURST WinBurst;				//!< Error statistics including current window
+} PRBSCHK;
+
+#pragma pack(pop)
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -55,6 +155,60 @@ extern "C" {
  */
 uint8_t Prbs8(uint8_t CurVal);
 
+/**
+ * @brief	Initialize PRBS generator
+ *
+ * @param	pGen	: Generator instance
+ * @param	Type	: PRBS type
+ * @param	Seed	: LFSR seed, must be non zero for its number of bits
+ * @param	bInvert	: Invert output
+ *
+ * @return	false if parameters invalid
+ */
+bool PrbsGenInit(PRBSGEN * const pGen, PRBS_TYPE Type, uint32_t Seed, bool bInvert);
+
+/**
+ * @brief	Generate next bytes of the sequence
+ *
+ * @param	pGen	: Generator instance
+ * @param	pBuff	: Buffer to fill
+ * @param	Len		: Number of bytes
+ */
+void PrbsGenFill(PRBSGEN * const pGen, uint8_t *pBuff, int Len);
+
+/**
+ * @brief	Initialize checker. Starts hunting for sync.
+ *
+ * @param	pChk	: Checker instance
+ * @param	pCfg	: Configuration
+ *
+ * @return	false if parameters invalid
+ */
+bool PrbsChkInit(PRBSCHK * const pChk, const PRBSCHK_CFG * const pCfg);
+
+/**
+ * @brief	Check received data
+ *
+ * @param	pChk	: Checker instance
+ * @param	pData	: Received data
+ * @param	Len		: Data length in bytes
+ */
+void PrbsChkProcess(PRBSCHK * const pChk, const uint8_t *pData, int Len);
+
+/**
+ * @brief	Clear statistics, keeps sync state
+ *
+ * @param	pChk	: Checker instance
+ */
+void PrbsChkReset(PRBSCHK * const pChk);
+
+/**
+ * @brief	Bit error ratio of committed windows
+ */
+static inline double PrbsChkBer(PRBSCHK * const pChk) {
+	return pChk->BitCnt ? (double)pChk->Burst.ErrCnt / (double)pChk->BitCnt : 0.0;
+}
+
 #ifdef __cplusplus
 }
 #endif
@@ -7,6 +7,34 @@ This is a GPIO test function. It generate a pulse on each GPIO pin in turn.
 It can be used to test assembly to check that all pins are properly soldered.
 Check can be view with an Oscilloscope where only one GPIO can pulse at a time.
 
+Timed pulse trains :
+
+A pulse description (pins, polarities, pulse start & width) is compiled into
+a list of pin events sorted by time, in timer ticks. Pulses overlapping on the
+same pin are merged and events at the same tick are combined into one set of
+pins to drive high and one set to drive low.
+
+PulseTrainSched plays the compiled list asynchronously with a single Timer
+trigger, re-armed for each event against the absolute start tick so that
+interrupt latency does not accumulate. With a PulseTrainHwLink, events are
+armed ahead into hardware that drives the pins on timer compare (timer + PPI
++ GPIOTE style), the CPU only refills it. Pin edges are then exact.
+
+Usage :
+
+	PULSE_TRAIN_PULSE pulses[] = {
+		{ 0, 0, 10000 },			// Pin 0, at 0, 10 us
+		{ 1, 5000, 20000 },			// Pin 1, at 5 us, 20 us
+	};
+	PULSE_TRAIN_DESC desc = { s_Pins, 2, PULSE_TRAIN_POL_HIGH, NULL, pulses, 2, 100000 };
+	PULSE_TRAIN_EVT evt[4];
+	PULSE_TRAIN_PROG prog;
+	PulseTrainSched sched;
+
+	PulseTrainCompile(&prog, &desc, g_Timer.Frequency(), evt, 4);
+	sched.Init(&g_Timer);
+	sched.Start(&prog, 1000, DoneHandler);	// 1000 periods of 100 us
+
 @author	Hoang Nguyen Hoan
 @date	July 14, 2018
 
@@ -39,7 +67,16 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef __PULSE_TRAIN_H__
 #define __PULSE_TRAIN_H__
 
+#include <stdint.h>
+#include <stdbool.h>
+
 #include "coredev/iopincfg.h"
+#ifdef __cplusplus
+#include "coredev/timer.h"
+#endif
+
+#define PULSE_TRAIN_MAX_PIN				32		//!< Max pins per pulse train, one bit per pin in event masks
+#define PULSE_TRAIN_HWLINK_MAXDEPTH		8		//!< Max events armed ahead in hardware link
 
 #pragma pack(push, 4)
 
@@ -64,6 +101,43 @@ typedef struct __Pulse_train_config {
 	PULSE_TRAIN_POL Pol;			//!< Pulse train polarity
 } PULSE_TRAIN_CFG;
 
+/// One pulse of a pulse description
+typedef struct __Pulse_train_pulse {
+	int Pin;						//!< Pin index in pins array
+	uint32_t nsStart;				//!< Pulse start from beginning of period in nsec
+	uint32_t nsWidth;				//!< Pulse width in nsec
+} PULSE_TRAIN_PULSE;
+
+/// Pulse description
+typedef struct __Pulse_train_desc {
+	const PULSE_TRAIN_PIN *pPins;	//!< IO pins array
+	int NbPins;						//!< Total number of pins, max PULSE_TRAIN_MAX_PIN
+	PULSE_TRAIN_POL Pol;			//!< Pulse polarity
+	const PULSE_TRAIN_POL *pPinPol;	//!< Per pin polarity, NULL to use Pol for all pins
+	const PULSE_TRAIN_PULSE *pPulses;	//!< Pulses array
+	int NbPulses;					//!< Total number of pulses
+	uint32_t nsPeriod;				//!< Period in nsec when looping, 0 - end of last pulse
+} PULSE_TRAIN_DESC;
+
+/// Compiled pin event
+typedef struct __Pulse_train_evt {
+	uint32_t Tick;					//!< Timer ticks from beginning of period
+	uint32_t HiMask;				//!< Pins to drive high, bit index is pin index
+	uint32_t LoMask;				//!< Pins to drive low
+} PULSE_TRAIN_EVT;
+
+/// Compiled pulse train
+typedef struct __Pulse_train_prog {
+	const PULSE_TRAIN_PIN *pPins;	//!< IO pins array
+	int NbPins;						//!< Total number of pins
+	PULSE_TRAIN_EVT *pEvt;			//!< Events sorted by tick
+	int NbEvt;						//!< Number of events
+	uint32_t PeriodTick;			//!< Period in timer ticks
+	uint32_t Freq;					//!< Timer frequency used for compiling
+	uint32_t IdleHiMask;			//!< Pins high when inactive (active low)
+	uint32_t IdleLoMask;			//!< Pins low when inactive (active high)
+} PULSE_TRAIN_PROG;
+
 #pragma pack(pop)
 
 #ifdef __cplusplus
@@ -79,8 +153,194 @@ extern "C" {
  */
 void PulseTrain(PULSE_TRAIN_CFG *pCfg, uint32_t Loop);
 
+/**
+ * @brief	Compile pulse description into timed pin events.
+ *
+ * Times are rounded to the nearest timer tick. Overlapping pulses on the same
+ * pin are merged, zero width pulses are dropped. Pulses must end within the
+ * period.
+ *
+ * @param	pProg	: Pointer to compiled program to initialize
+ * @param	pDesc	: Pointer to pulse description
+ * @param	Freq	: Timer frequency in Hz
+ * @param	pEvtMem	: Event memory
+ * @param	MaxEvt	: Event memory size in events, at least 2 per pulse
+ *
+ * @return	true - success
+ */
+bool PulseTrainCompile(PULSE_TRAIN_PROG * const pProg, const PULSE_TRAIN_DESC * const pDesc,
+					   uint32_t Freq, PULSE_TRAIN_EVT *pEvtMem, int MaxEvt);
+
+/**
+ * @brief	Compile PulseTrain configuration into timed pin events.
+ *
+ * Same pin sequence as PulseTrain. Pins toggle in turn every Period usec.
+ * One period of the compiled program is 2 loops of PulseTrain, pins active
+ * then back to inactive.
+ *
+ * @param	pProg	: Pointer to compiled program to initialize
+ * @param	pCfg	: Pointer to pulse train configuration data
+ * @param	Freq	: Timer frequency in Hz
+ * @param	pEvtMem	: Event memory
+ * @param	MaxEvt	: Event memory size in events, at least 2 per pin
+ *
+ * @return	true - success
+ */
+bool PulseTrainCompileCfg(PULSE_TRAIN_PROG * const pProg, const PULSE_TRAIN_CFG * const pCfg,
+						  uint32_t Freq, PULSE_TRAIN_EVT *pEvtMem, int MaxEvt);
+
 #ifdef __cplusplus
 }
+
+/// @brief	Hardware pin event link interface.
+///
+/// Drives pins on timer compare without CPU, such as timer + PPI + GPIOTE.
+/// Ticks are those of the Timer used by PulseTrainSched.
+class PulseTrainHwLink {
+public:
+	/**
+	 * @brief	Number of events that can be armed at the same time.
+	 *
+	 * @return	Depth, max PULSE_TRAIN_HWLINK_MAXDEPTH
+	 */
+	virtual int Depth() = 0;
+
+	/**
+	 * @brief	Number of free slots.
+	 *
+	 * Slots of events already executed are free.
+	 *
+	 * @return	Free slots
+	 */
+	virtual int Avail() = 0;
+
+	/**
+	 * @brief	Arm one pin event.
+	 *
+	 * @param	Tick	: Absolute timer tick
+	 * @param	HiMask	: Pins to drive high, bit index is pin index
+	 * @param	LoMask	: Pins to drive low
+	 *
+	 * @return	false - no free slot or Tick is already passed
+	 */
+	virtual bool Arm(uint64_t Tick, uint32_t HiMask, uint32_t LoMask) = 0;
+
+	/**
+	 * @brief	Cancel all armed events.
+	 */
+	virtual void Disarm() = 0;
+};
+
+/**
+ * @brief	Pulse train completion callback.
+ *
+ * Called from the timer interrupt after the last event of the last period.
+ *
+ * @param	pCtx	: User context pointer
+ */
+typedef void (*PULSE_TRAIN_DONECB)(void *pCtx);
+
+/// @brief	Asynchronous pulse train player over a Timer trigger.
+class PulseTrainSched {
+public:
+	PulseTrainSched();
+	virtual ~PulseTrainSched() {}
+
+	/**
+	 * @brief	Initialize scheduler.
+	 *
+	 * @param	pTimer	: Pointer to timer, compiled programs must use its frequency
+	 * @param	TrigNo	: Timer trigger to use, -1 for first available
+	 * @param	pHwLink	: Optional hardware pin event link. NULL, pins
+	 * 					  are driven from the timer interrupt
+	 *
+	 * @return	true - success
+	 */
+	bool Init(Timer * const pTimer, int TrigNo = -1, PulseTrainHwLink * const pHwLink = NULL);
+
+	/**
+	 * @brief	Start playing compiled pulse train.
+	 *
+	 * Pins are configured as output and set inactive. The first period starts
+	 * now. Returns immediately, events are played from the timer interrupt.
+	 *
+	 * @param	pProg	: Pointer to compiled program, must remain valid while playing
+	 * @param	Loop	: Number of periods, 0 - until stopped
+	 * @param	DoneCB	: Optional completion callback
+	 * @param	pCtx	: User context passed to DoneCB
+	 *
+	 * @return	true - success
+	 */
+	bool Start(const PULSE_TRAIN_PROG * const pProg, uint32_t Loop,
+			   PULSE_TRAIN_DONECB DoneCB = NULL, void * const pCtx = NULL);
+
+	/**
+	 * @brief	Stop playing and set pins inactive.
+	 */
+	void Stop();
+
+	bool IsRunning() { return vbRunning; }
+
+	/// Number of events played
+	uint32_t EvtCount() { return vEvtCnt; }
+
+	/// Number of events driven by the CPU after their tick
+	uint32_t LateCount() { return vLateCnt; }
+
+	/// Max event delay in timer ticks
+	uint32_t LateMax() { return vLateMax; }
+
+	/// Sum of event delays in timer ticks
+	uint64_t LateSum() { return vLateSum; }
+
+	/// Number of timer interrupts handled
+	uint32_t IrqCount() { return vIrqCnt; }
+
+	void ResetStats();
+
+protected:
+	/**
+	 * @brief	Drive pins from CPU.
+	 *
+	 * Default uses IOPinSet/IOPinClear on program pins.
+	 *
+	 * @param	HiMask	: Pins to drive high
+	 * @param	LoMask	: Pins to drive low
+	 */
+	virtual void Output(uint32_t HiMask, uint32_t LoMask);
+
+	Timer *vpTimer;
+
+private:
+	static void TimerTrigHandler(Timer * const pTimer, int TrigNo, void * const pContext);
+	uint64_t Target();
+	bool Next();
+	void Process();
+	void ProcessHw();
+	void Done();
+	void Wakeup(uint64_t Tick);
+
+	int vTrigNo;
+	PulseTrainHwLink *vpHwLink;
+	const PULSE_TRAIN_PROG *vpProg;
+	PULSE_TRAIN_DONECB vDoneCB;
+	void *vpDoneCtx;
+	volatile bool vbRunning;
+	bool vbEnd;						//!< All events played or armed
+	uint32_t vLoop;					//!< Number of periods, 0 infinite
+	uint32_t vLoopCnt;				//!< Current period
+	int vIdx;						//!< Next event index
+	uint64_t vStartTick;			//!< Absolute tick of period 0
+	uint64_t vArmTick[PULSE_TRAIN_HWLINK_MAXDEPTH];	//!< Ticks of events armed in hardware link
+	int vArmHead;
+	int vArmCnt;
+	uint32_t vEvtCnt;
+	uint32_t vLateCnt;
+	uint32_t vLateMax;
+	uint64_t vLateSum;
+	uint32_t vIrqCnt;
+};
+
 #endif
 
 #endif // __PULSE_TRAIN_H__
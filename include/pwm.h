@@ -35,6 +35,10 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __PWM_H__
 
 #include <stdint.h>
+#include <stdbool.h>
+
+#define PWM_DUTY_SHIFT			15
+#define PWM_DUTY_MAX			(1 << PWM_DUTY_SHIFT)	//!< High resolution duty cycle value for 100%
 
 typedef enum __Pwm_Event {
 	PWM_EVT_STOPPED = 0,
@@ -53,6 +57,7 @@ typedef enum __Pwm_Polarity {
 } PWM_POL;
 
 typedef struct __Pwm_Device PWM_DEV;
+typedef struct __Pwm_Seq PWMSEQ;		// See pwm_seq.h
 
 typedef void (*PWMEVTHANDLER) (PWM_DEV *pDev, PWM_EVT Evt);
 
@@ -98,6 +103,40 @@ void PWMStop(PWM_DEV *pDev);
 bool PWMSetFrequency(PWM_DEV *pDev, uint32_t Freq);
 bool PWMSetDutyCycle(PWM_DEV *pDev, int Chan, int Percent);
 
+/**
+ * @brief	Set high resolution duty cycle
+ *
+ * @param 	pDev	: Pointer to PWM device
+ * @param 	Chan	: Channel number
+ * @param 	Duty	: Duty cycle, PWM_DUTY_MAX = 100%
+ *
+ * @return	true - success
+ */
+bool PWMSetDuty(PWM_DEV *pDev, int Chan, uint16_t Duty);
+
+/**
+ * @brief	Start streaming a waveform sequence
+ *
+ * The sequence is rewound, both halves filled and playback started. Halves
+ * are refilled from the PWM interrupt, which is enabled by this function.
+ * PWM stops with PWM_EVT_STOPPED when the sequence ends. Channels keep their
+ * last value.
+ *
+ * @param 	pDev	: Pointer to PWM device
+ * @param 	pSeq	: Pointer to initialized sequence, must remain valid
+ * 					  until stopped
+ *
+ * @return	true - success
+ */
+bool PWMSeqStart(PWM_DEV *pDev, PWMSEQ *pSeq);
+
+/**
+ * @brief	Stop sequence playback and return to fixed duty cycle mode
+ *
+ * @param 	pDev	: Pointer to PWM device
+ */
+void PWMSeqStop(PWM_DEV *pDev);
+
 #ifdef __cplusplus
 }
 
@@ -175,6 +214,30 @@ public:
 	 */
 	virtual bool DutyCycle(int Chan, int Percent) { return PWMSetDutyCycle(&vDev, Chan, Percent); }
 
+	/**
+	 * @brief	Set high resolution duty cycle
+	 *
+	 * @param 	Chan	: Channel number to change duty cycle
+	 * @param 	Duty	: Duty cycle, PWM_DUTY_MAX = 100%
+	 *
+	 * @return	true - success
+	 */
+	virtual bool Duty(int Chan, uint16_t Duty) { return PWMSetDuty(&vDev, Chan, Duty); }
+
+	/**
+	 * @brief	Start streaming waveform sequence
+	 *
+	 * @param 	pSeq	: Pointer to initialized sequence (see pwm_seq.h)
+	 *
+	 * @return	true - success
+	 */
+	virtual bool StartSeq(PWMSEQ *pSeq) { return PWMSeqStart(&vDev, pSeq); }
+
+	/**
+	 * @brief	Stop sequence playback
+	 */
+	virtual void StopSeq() { PWMSeqStop(&vDev); }
+
 private:
 	PWM_DEV vDev;
 };
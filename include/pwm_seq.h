@@ -0,0 +1,323 @@
+/**-------------------------------------------------------------------------
+@file	pwm_seq.h
+
+@brief	PWM sequence waveform engine.
+
+Streams arbitrary duty cycle values to PWM channels through two ping-pong
+sequence buffers, one PWM sample per frame. While the hardware plays one half,
+the other half is refilled from the interrupt of the previous half end. The
+CPU is interrupted once per half buffer instead of once per sample.
+
+Each channel takes its values from one of these sources :
+
+	Table	: Array of duty values, played once or looped, starting at a
+			  per channel phase offset. Channels sharing one table with
+			  different offsets make phase shifted waveforms.
+	Stream	: Refill callback asked for the next values of the channel.
+	Const	: Fixed duty value.
+
+Duty values are high resolution, PWM_DUTY_MAX is 100%. The engine converts
+them to hardware compare values using the counter top set by the driver.
+The buffer layout is one word per channel per frame, which is the nRF52 PWM
+individual decoder format when NbChan is 4.
+
+Playback ends when every non looping table and every stream has run out.
+Channels that ended hold their last value until then.
+
+Waveform generators fill tables with sine, ramp and ADSR envelope shapes.
+
+No hardware dependency, the PWM driver calls PwmSeqFill from its sequence end
+interrupt. See PWMSeqStart in pwm.h
+
+Usage :
+
+	uint16_t seqmem[PWMSEQ_MEMSIZE(32, 4)];
+	uint16_t sine[256];
+	PWMSEQ_CFG cfg = { seqmem, 32, 4, 1 };
+	PWMSEQ seq;
+
+	PwmWaveSine(sine, 256, 0, PWM_DUTY_MAX);
+	PwmSeqInit(&seq, &cfg);
+	PwmSeqSetTable(&seq, 0, sine, 256, 0, true);
+	PwmSeqSetTable(&seq, 1, sine, 256, 256 / 3, true);
+	PwmSeqSetTable(&seq, 2, sine, 256, 2 * 256 / 3, true);
+	PwmSeqSetConst(&seq, 3, 0);
+	PWMSeqStart(&pwmdev, &seq);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __PWM_SEQ_H__
+#define __PWM_SEQ_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "pwm.h"
+
+#define PWMSEQ_MAX_CHAN				4		//!< Max channels per frame
+#define PWMSEQ_FILL_CHUNK			32		//!< Nb of values requested per stream callback
+
+/// Sequence memory size in 16 bits words for 2 halves of NbFrame frames
+#define PWMSEQ_MEMSIZE(NbFrame, NbChan)		(2 * (NbFrame) * (NbChan))
+
+/**
+ * @brief	Stream refill callback.
+ *
+ * Called from the PWM interrupt to get the next duty values of a channel.
+ *
+ * @param	pCtx	: User context pointer
+ * @param	Chan	: Channel number
+ * @param	pDuty	: Buffer to fill with duty values, PWM_DUTY_MAX = 100%
+ * @param	Count	: Nb of values requested
+ *
+ * @return	Nb of values filled. Less than Count ends the stream
+ */
+typedef int (*PWMSEQ_FILLCB)(void *pCtx, int Chan, uint16_t *pDuty, int Count);
+
+/// Channel value source
+typedef enum __Pwm_Seq_Src {
+	PWMSEQ_SRC_CONST,			//!< Fixed duty value
+	PWMSEQ_SRC_TABLE,			//!< Duty table
+	PWMSEQ_SRC_STREAM,			//!< Stream refill callback
+} PWMSEQ_SRC;
+
+/// ADSR envelope definition for PwmWaveAdsr
+typedef struct __Pwm_Wave_Adsr {
+	uint32_t Attack;			//!< Attack length in samples, rise from 0 to Peak
+	uint32_t Decay;				//!< Decay length in samples, fall from Peak to Sustain
+	uint32_t Hold;				//!< Sustain length in samples
+	uint32_t Release;			//!< Release length in samples, fall from Sustain to 0
+	uint16_t Peak;				//!< Peak duty
+	uint16_t Sustain;			//!< Sustain duty
+} PWMWAVE_ADSR;
+
+#pragma pack(push, 4)
+
+/// Sequence configuration
+typedef struct __Pwm_Seq_Config {
+	uint16_t *pMem;				//!< Sequence memory, PWMSEQ_MEMSIZE(NbFrame, NbChan) words
+	int NbFrame;				//!< Nb of frames (samples) per half buffer
+	int NbChan;					//!< Nb of channels per frame, max PWMSEQ_MAX_CHAN
+	uint32_t Repeat;			//!< Nb of PWM periods each sample is played, 0 same as 1
+} PWMSEQ_CFG;
+
+/// Channel state
+typedef struct __Pwm_Seq_Chan {
+	PWMSEQ_SRC Src;				//!< Value source
+	bool bLoop;					//!< Loop table
+	bool bEnd;					//!< No more values, holding Last
+	uint16_t Flag;				//!< Or'ed into each compare value, polarity bit set by driver
+	uint16_t Last;				//!< Last duty value
+	const uint16_t *pTbl;		//!< Duty table
+	uint32_t Len;				//!< Nb of values in table
+	uint32_t Phase;				//!< Table start index
+	uint32_t Idx;				//!< Next table index
+	PWMSEQ_FILLCB FillCB;		//!< Stream refill callback
+	void *pCtx;					//!< Stream callback context
+} PWMSEQ_CHAN;
+
+/// Sequence instance data
+struct __Pwm_Seq {
+	uint16_t *pBuf[2];			//!< Ping-pong half buffers
+	int NbFrame;				//!< Nb of frames per half buffer
+	int NbChan;					//!< Nb of channels per frame
+	uint32_t Repeat;			//!< Nb of PWM periods per sample
+	uint32_t Top;				//!< Compare value for PWM_DUTY_MAX
+	PWMSEQ_CHAN Chan[PWMSEQ_MAX_CHAN];
+	uint32_t FillCnt;			//!< Nb of half buffers filled
+	uint32_t SampleCnt;			//!< Nb of new samples filled
+};
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize sequence.
+ *
+ * All channels are set to constant 0 duty.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	pCfg	: Pointer to configuration
+ *
+ * @return	true - success
+ */
+bool PwmSeqInit(PWMSEQ * const pSeq, const PWMSEQ_CFG * const pCfg);
+
+/**
+ * @brief	Set compare value matching PWM_DUTY_MAX.
+ *
+ * Called by the PWM driver with its counter top value.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Top		: Counter top value, max 0x7FFF
+ */
+static inline void PwmSeqSetTop(PWMSEQ * const pSeq, uint32_t Top) { pSeq->Top = Top & 0x7FFF; }
+
+/**
+ * @brief	Set value or'ed into all compare values of a channel.
+ *
+ * Called by the PWM driver for the polarity bit.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Chan	: Channel number
+ * @param	Flag	: Flag value
+ */
+static inline void PwmSeqSetFlag(PWMSEQ * const pSeq, int Chan, uint16_t Flag) {
+	if (Chan >= 0 && Chan < pSeq->NbChan) pSeq->Chan[Chan].Flag = Flag;
+}
+
+/**
+ * @brief	Play channel from a duty table.
+ *
+ * The table is not copied and must remain valid during playback.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Chan	: Channel number
+ * @param	pTbl	: Duty table, PWM_DUTY_MAX = 100%
+ * @param	Len		: Nb of values in table
+ * @param	Phase	: Start index in table, phase offset in samples
+ * @param	bLoop	: true - loop table, false - play once and hold last value
+ *
+ * @return	true - success
+ */
+bool PwmSeqSetTable(PWMSEQ * const pSeq, int Chan, const uint16_t *pTbl, uint32_t Len, uint32_t Phase, bool bLoop);
+
+/**
+ * @brief	Play channel from a stream refill callback.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Chan	: Channel number
+ * @param	FillCB	: Refill callback
+ * @param	pCtx	: Context pointer passed to the callback
+ *
+ * @return	true - success
+ */
+bool PwmSeqSetStream(PWMSEQ * const pSeq, int Chan, PWMSEQ_FILLCB FillCB, void *pCtx);
+
+/**
+ * @brief	Set channel to a fixed duty.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Chan	: Channel number
+ * @param	Duty	: Duty value, PWM_DUTY_MAX = 100%
+ *
+ * @return	true - success
+ */
+bool PwmSeqSetConst(PWMSEQ * const pSeq, int Chan, uint16_t Duty);
+
+/**
+ * @brief	Rewind all channels to the start of their source.
+ *
+ * Tables restart at their phase offset. Called by the driver on start.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ */
+void PwmSeqRewind(PWMSEQ * const pSeq);
+
+/**
+ * @brief	Refill one half buffer.
+ *
+ * Called by the driver when the hardware is done with the half. Frames
+ * following the last new sample hold the last values.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Half	: Half buffer index 0 or 1
+ *
+ * @return	Nb of frames holding new samples, less than NbFrame when the
+ * 			sequence ends in this half, 0 when it had already ended
+ */
+int PwmSeqFill(PWMSEQ * const pSeq, int Half);
+
+/**
+ * @brief	Check if all sources have run out.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ *
+ * @return	true - no more samples
+ */
+bool PwmSeqDone(PWMSEQ * const pSeq);
+
+/**
+ * @brief	Convert duty value to compare value.
+ *
+ * @param	Duty	: Duty value, PWM_DUTY_MAX = 100%
+ * @param	Top		: Counter top value
+ *
+ * @return	Compare value
+ */
+static inline uint16_t PwmDutyToCmp(uint32_t Duty, uint32_t Top) {
+	if (Duty > PWM_DUTY_MAX) Duty = PWM_DUTY_MAX;
+	return (uint16_t)((Duty * Top + (PWM_DUTY_MAX >> 1)) >> PWM_DUTY_SHIFT);
+}
+
+/**
+ * @brief	Generate one period of sine wave.
+ *
+ * pTbl[0] is at the middle value, rising.
+ *
+ * @param	pTbl	: Table to fill
+ * @param	Len		: Nb of samples per period
+ * @param	Min		: Duty at the bottom of the wave
+ * @param	Max		: Duty at the top of the wave
+ */
+void PwmWaveSine(uint16_t *pTbl, uint32_t Len, uint16_t Min, uint16_t Max);
+
+/**
+ * @brief	Generate linear ramp.
+ *
+ * pTbl[0] = Start, pTbl[Len - 1] = End.
+ *
+ * @param	pTbl	: Table to fill
+ * @param	Len		: Nb of samples
+ * @param	Start	: First duty
+ * @param	End		: Last duty
+ */
+void PwmWaveRamp(uint16_t *pTbl, uint32_t Len, uint16_t Start, uint16_t End);
+
+/**
+ * @brief	Generate ADSR envelope.
+ *
+ * Linear attack, decay, sustain and release segments.
+ *
+ * @param	pTbl	: Table to fill
+ * @param	MaxLen	: Table size in samples
+ * @param	pEnv	: Envelope definition
+ *
+ * @return	Nb of samples generated, 0 if table is too small
+ */
+uint32_t PwmWaveAdsr(uint16_t *pTbl, uint32_t MaxLen, const PWMWAVE_ADSR *pEnv);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // __PWM_SEQ_H__
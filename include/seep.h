@@ -85,6 +85,19 @@ uint8_t buff[40];
 g_Seep.Write(0x100, buff, 40);	// Write 40 bytes at address 0x100
 g_Seep.Read(0x10, buff, 40); // Read 40 bytes from address 0x10
 
+// Optional page write coalescing. Writes are kept in RAM page cache
+// until Flush is called or the cache page is needed for other page
+uint8_t s_SeepCacheMem[2][16];
+SEEP_CACHE_DESC s_SeepCache[2] = {
+	{ 0xFFFFFFFF, 0, 0, s_SeepCacheMem[0] },
+	{ 0xFFFFFFFF, 0, 0, s_SeepCacheMem[1] },
+};
+
+g_Seep.SetCache(s_SeepCache, 2);
+g_Seep.Write(0x100, buff, 4);
+g_Seep.Write(0x108, buff, 4);	// Same page, no additional write cycle
+g_Seep.Flush();					// Commit, one write cycle for the page
+
 -----
 Usage in C :
 
@@ -174,8 +187,22 @@ typedef struct __Seep_Config {
 					    //<! for a device to complete its write cycle
    					    //<! This is to allow application to perform other tasks
    					    //<! while waiting. Set to NULL is not used
+	bool bAckPoll;		//<! true - Poll device acknowledge for write cycle completion
+						//<! instead of waiting the full WrDelay after each page write.
+						//<! The poll is deferred until the next device access.
 } SEEP_CFG;
 
+/// @brief	Page write cache descriptor.
+///
+/// Page data is kept in RAM and written to the device as a single page write
+/// on flush.  Memory is provided by the application, see SeepSetCache
+typedef struct __Seep_Cache_Desc {
+	uint32_t PageAddr;	//<! EEPROM address of cached page, 0xFFFFFFFF if unused
+	uint16_t DirtyStart;//<! Start offset of modified data in the page
+	uint16_t DirtyEnd;	//<! End offset of modified data in the page. 0 - page is clean
+	uint8_t *pData;		//<! Pointer to page data memory. Must be at least 1 page size
+} SEEP_CACHE_DESC;
+
 /// @brief Device internal data.
 ///
 /// Pointer to this structure serve as handle to the implementation function
@@ -191,6 +218,11 @@ typedef struct __Seep_Device {
 					    //<! for a device to complete its write cycle
    					    //<! This is to allow application to perform other tasks
    					    //<! while waiting. Set to NULL is not used
+	bool bAckPoll;		//<! Use acknowledge polling for write cycle completion
+	bool bWrBusy;		//<! Write cycle in progress, device must be polled before access
+	int NbCache;		//<! Number of page cache
+	int LastIdx;		//<! Last allocated page cache index
+	SEEP_CACHE_DESC *pCache;//<! Page cache, NULL if not used
 } SEEPDEV;
 
 #pragma pack(pop)
@@ -266,6 +298,43 @@ int SeepWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len);
  */
 void SeepSetWriteProt(SEEPDEV * const pDev, bool bVal);
 
+/**
+ * @brief Wait for device internal write cycle to complete.
+ *
+ * With acknowledge polling enabled, this polls the device until it acknowledges
+ * its address.  Otherwise the write delay was already applied after each write.
+ *
+ * @param   pDev     : Pointer to driver data
+ *
+ * @return  true - device ready\n
+ *          false - timeout, device is still considered busy and the pending\n
+ *          read or write is aborted
+ */
+bool SeepWaitReady(SEEPDEV * const pDev);
+
+/**
+ * @brief Set page write cache.
+ *
+ * Once set, writes are stored in the page cache and only written to the device
+ * when SeepFlush is called or when a cache page is needed for another page. Reads
+ * are served from cache when the page is present.  Multiple small writes within
+ * the same page are coalesced in a single device write cycle.
+ *
+ * @param   pDev     : Pointer to driver data
+ * @param   pCache   : Pointer to array of cache descriptors
+ * @param   NbCache  : Number of cache descriptors
+ */
+void SeepSetCache(SEEPDEV * const pDev, SEEP_CACHE_DESC * const pCache, int NbCache);
+
+/**
+ * @brief Write all modified cache pages to device.
+ *
+ * @param   pDev     : Pointer to driver data
+ *
+ * @return  true - success
+ */
+bool SeepFlush(SEEPDEV * const pDev);
+
 #ifdef __cplusplus
 }
 
@@ -314,6 +383,21 @@ public:
      */
     virtual int Write(uint32_t Addr, uint8_t *pData, int Len) { return SeepWrite(&vDevData, Addr, pData, Len); }
 
+    /**
+     * @brief Set page write cache.
+     *
+     * @param   pCache   : Pointer to array of cache descriptors
+     * @param   NbCache  : Number of cache descriptors
+     */
+    void SetCache(SEEP_CACHE_DESC * const pCache, int NbCache) { SeepSetCache(&vDevData, pCache, NbCache); }
+
+    /**
+     * @brief Write all modified cache pages to device.
+     *
+     * @return  true - success
+     */
+    virtual bool Flush() { return SeepFlush(&vDevData); }
+
     /**
      * @brief Get EEPROM size.
      *
@@ -0,0 +1,164 @@
+/**-------------------------------------------------------------------------
+@file	seep_kvlog.h
+
+@brief	Wear spreading key/value record log on Serial EEPROM
+
+Small configuration values are stored as append only records instead of being
+rewritten in place.  Each update lands at a new address so that write cycles are
+spread over the whole log region rather than hammering the same page.  The region
+is split in 2 banks.  When the active bank is full, latest records are copied to
+the other bank which then becomes active.
+
+Bank layout :
+	Header : Magic (2 bytes), Generation (2 bytes), ~Generation (2 bytes), 0xFF 0xFF
+	Record : Key (1 byte), Len (1 byte), Data (Len bytes), CRC8 (1 byte)
+	...
+	0xFF   : End of log
+
+Record CRC is crc8_ccitt over Key, Len & Data seeded with the bank generation.
+A record torn by a power loss fails its CRC and terminates the log.  It is
+overwritten by the next record.
+
+Usage :
+
+SEEPDEV g_SeepDev;
+SEEP_KVLOG g_KvLog;
+
+SeepKvLogInit(&g_KvLog, &g_SeepDev, 0x100, 0x300);	// Use 768 bytes from 0x100
+
+uint32_t val = 1234;
+SeepKvLogWrite(&g_KvLog, 3, (uint8_t*)&val, sizeof(val));
+SeepKvLogRead(&g_KvLog, 3, (uint8_t*)&val, sizeof(val));
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __SEEP_KVLOG_H__
+#define __SEEP_KVLOG_H__
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "seep.h"
+
+/** @addtogroup Storage
+  * @{
+  */
+
+/// Max number of keys.  Keys are in range 0 to SEEP_KVLOG_MAXKEY - 1
+#ifndef SEEP_KVLOG_MAXKEY
+#define SEEP_KVLOG_MAXKEY			32
+#endif
+
+/// Max data length of a record in bytes
+#ifndef SEEP_KVLOG_MAXDATALEN
+#define SEEP_KVLOG_MAXDATALEN		64
+#endif
+
+#define SEEP_KVLOG_MAGIC			0x4B56
+#define SEEP_KVLOG_HDRSIZE			8		//!< Bank header size in bytes
+#define SEEP_KVLOG_RECOVR			3		//!< Record overhead in bytes (key, len, crc)
+
+#pragma pack(push,4)
+
+/// Key/Value log instance data
+typedef struct __Seep_KvLog {
+	SEEPDEV *pSeep;			//!< Serial EEPROM on which the log is stored
+	uint32_t StartAddr;		//!< Start address of log region
+	uint32_t BankSize;		//!< Size of one bank in bytes, half of log region
+	int CurBank;			//!< Active bank index (0 or 1)
+	uint16_t Gen;			//!< Active bank generation
+	uint32_t WrOff;			//!< Next record offset in active bank
+	uint32_t CompactCnt;	//!< Number of bank compactions since init
+	uint16_t KeyOff[SEEP_KVLOG_MAXKEY];	//!< Latest record offset for each key, 0 - not found
+} SEEP_KVLOG;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize key/value log.
+ *
+ * Scans the log region for the latest valid bank and builds the key index.
+ * The region is formatted if no valid bank is found.
+ *
+ * @param	pLog	  : Pointer to log instance data
+ * @param	pSeep	  : Pointer to initialized Serial EEPROM device
+ * @param	StartAddr : Start address of log region in EEPROM
+ * @param	Size	  : Size of log region in bytes.  Split in 2 banks
+ *
+ * @return	true - success
+ */
+bool SeepKvLogInit(SEEP_KVLOG * const pLog, SEEPDEV * const pSeep, uint32_t StartAddr, uint32_t Size);
+
+/**
+ * @brief	Erase all records.
+ *
+ * @param	pLog	: Pointer to log instance data
+ *
+ * @return	true - success
+ */
+bool SeepKvLogFormat(SEEP_KVLOG * const pLog);
+
+/**
+ * @brief	Read latest value of a key.
+ *
+ * @param	pLog	: Pointer to log instance data
+ * @param	Key		: Key to read
+ * @param	pBuff	: Pointer to buffer to receive data
+ * @param	BuffLen	: Size of the buffer in bytes
+ *
+ * @return	Number of bytes read.  -1 if key not found
+ */
+int SeepKvLogRead(SEEP_KVLOG * const pLog, uint8_t Key, uint8_t *pBuff, int BuffLen);
+
+/**
+ * @brief	Write new value of a key.
+ *
+ * Nothing is written if the value is identical to the stored one.  Bank
+ * compaction is performed when the active bank is full.
+ *
+ * @param	pLog	: Pointer to log instance data
+ * @param	Key		: Key to write
+ * @param	pData	: Pointer to data to write
+ * @param	Len		: Data length in bytes. Max SEEP_KVLOG_MAXDATALEN
+ *
+ * @return	Number of bytes written.  -1 on failure
+ */
+int SeepKvLogWrite(SEEP_KVLOG * const pLog, uint8_t Key, uint8_t *pData, int Len);
+
+#ifdef __cplusplus
+}
+#endif
+
+/** @} End of group Storage */
+
+#endif // __SEEP_KVLOG_H__
@@ -36,6 +36,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __STDDEV_H__
 
 #include <stdint.h>
+#include <stdbool.h>
 #include <stdio.h>
 
 #ifndef __ICCARM__
@@ -48,6 +49,12 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define STDFS_FILENO			3		//!< Default File system
 #define STDDEV_USER_FILENO		4		//!< Start of user device fileno idx
 
+// Readiness events, same values as poll.h
+#define STDDEV_POLLIN			0x0001	//!< Data available to read
+#define STDDEV_POLLOUT			0x0004	//!< Write will accept data
+#define STDDEV_POLLERR			0x0008	//!< Device error
+#define STDDEV_POLLNVAL			0x0020	//!< Descriptor not installed
+
 // open
 typedef int (*STDDEVOPEN)(void * const pDevObj, const char *pDevName, int Flags, int Mode);
 // close
@@ -56,6 +63,8 @@ typedef int (*STDDEVCLOSE)(void * const pDevObj, int Handle);
 typedef int (*STDDEVRW)(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len);
 // seek
 typedef int (*STDDEVSEEK)(void * const pDevObj, int Handle, int Offset);
+// poll, returns STDDEV_POLLxxx flags ready among Events
+typedef int (*STDDEVPOLL)(void * const pDevObj, int Handle, int Events);
 
 #pragma pack(push, 4)
 
@@ -67,8 +76,16 @@ typedef struct {
 	STDDEVRW	Read;		//!< Pointer to Read function
 	STDDEVRW	Write;		//!< Pointer to Write function
 	STDDEVSEEK	Seek;		//!< Pointer to Seek function
+	STDDEVPOLL	Poll;		//!< Pointer to readiness function, NULL - always ready
 } STDDEV;
 
+/// Readiness request, same layout as struct pollfd
+typedef struct {
+	int			Fd;			//!< Descriptor
+	short		Events;		//!< Requested STDDEV_POLLxxx
+	short		REvents;	//!< Returned STDDEV_POLLxxx
+} STDDEV_POLLFD;
+
 #pragma pack(pop)
 
 
@@ -99,6 +116,60 @@ int InstallBlkDev(STDDEV * const pDev, int MapId);
  */
 void RemoveBlkDev(int Handle);
 
+/**
+ * @brief	Set non-blocking mode of a descriptor
+ *
+ * In non-blocking mode read & write return -1 with errno EAGAIN instead of
+ * waiting when the device (or its stream buffer) is not ready.  A non-blocking
+ * write can be partial.  The mode applies to the device slot, all files of a
+ * file system share it.
+ *
+ * @param	Fd			: Descriptor
+ * @param	bNonBlock	: true - non-blocking
+ *
+ * @return	0 : success, -1 : invalid descriptor
+ */
+int StdDevSetNonBlock(int Fd, bool bNonBlock);
+
+/**
+ * @brief	Attach stream buffers to a device descriptor
+ *
+ * Writes are queued in the Tx buffer and reads served from the Rx buffer.  The
+ * buffers are exchanged with the device by StdDevPoll or StdDevProcess when the
+ * device is ready, so a slow device no longer holds up the caller.  Not
+ * available on the file system slot.
+ *
+ * @param	Fd			: Descriptor
+ * @param	pRxMem		: Rx buffer memory, NULL - unbuffered read
+ * @param	RxSize		: Rx buffer size in bytes
+ * @param	pTxMem		: Tx buffer memory, NULL - unbuffered write
+ * @param	TxSize		: Tx buffer size in bytes
+ *
+ * @return	0 : success, -1 : invalid descriptor
+ */
+int StdDevSetBuffer(int Fd, uint8_t *pRxMem, size_t RxSize, uint8_t *pTxMem, size_t TxSize);
+
+/**
+ * @brief	Check readiness of multiple descriptors
+ *
+ * Services the stream buffers of the descriptors then reports their readiness.
+ * Never blocks, the main loop sleeps until next interrupt when nothing is ready.
+ *
+ * @param	pFds	: Array of requests, REvents are updated
+ * @param	NbFds	: Number of requests
+ *
+ * @return	Number of descriptors with REvents set
+ */
+int StdDevPoll(STDDEV_POLLFD *pFds, int NbFds);
+
+/**
+ * @brief	Exchange stream buffers with their devices
+ *
+ * Flushes Tx buffers & fills Rx buffers of all buffered descriptors as far as
+ * the devices accept without blocking.  Call from the main loop.
+ */
+void StdDevProcess(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,327 @@
+/**-------------------------------------------------------------------------
+@file	sysevtlog.h
+
+@brief	Binary system event log
+
+Low overhead event log for field diagnostics.  Events are fixed size binary
+records : sequence number, time stamp, status code (see sysstatusdef.h), a
+format string id and up to SYSEVTLOG_MAXARG integer arguments.  Text is never
+formatted nor copied on target.  Format strings are only needed by the decoder,
+usually on host.
+
+Records are written into a ring in RAM.  Writing is lock free and safe from
+multiple threads and interrupts.  A writer claims the next sequence number
+atomically then fills its own slot.  The slot sequence is cleared while the
+record is being filled and set last so that a reader never sees a partial record.
+The oldest records are overwritten when the ring is full.  The ring must hold
+more records than can be logged while one writer is preempted.
+
+The ring can be persisted to a DiskIO sector region (see SysEvtLog class).  Each
+sector holds SYSEVTLOG_SECT_NBREC records, a write sequence and a CRC.  Sectors
+are written once per lap of the region, a NOR flash region must be erased
+before it is reused.
+
+Format string tables are written once as an X macro list :
+
+	#define APP_EVTFMT(X) \
+		X(APP_EVTFMT_BOOT,		"Boot, reset reason %x") \
+		X(APP_EVTFMT_BATLOW,	"Battery low %u mV")
+
+	enum { APP_EVTFMT(SYSEVTLOG_FMT_ENUM) };
+
+	// Host decoder only
+	const char * const g_AppEvtFmt[] = { APP_EVTFMT(SYSEVTLOG_FMT_STR) };
+
+Usage :
+
+	SYSEVTLOG_REC g_EvtLogMem[64];
+	SYSEVTLOG_CFG cfg = { g_EvtLogMem, 64, GetTimeStamp };
+	SYSEVTLOG g_EvtLog;
+
+	SysEvtLogInit(&g_EvtLog, &cfg);
+	SYSEVTLOG(&g_EvtLog, SYSSTATUS_TYPE_WRN | 12, APP_EVTFMT_BATLOW, mV);
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#ifndef __SYSEVTLOG_H__
+#define __SYSEVTLOG_H__
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+	#include <atomic>
+	using namespace std;
+#else
+	#include <stdatomic.h>
+#endif
+
+#include "sysstatusdef.h"
+
+/** @addtogroup Utilities
+  * @{
+  */
+
+#define SYSEVTLOG_MAXARG			4		//!< Max number of integer arguments per event
+#define SYSEVTLOG_FMTID_NONE		0xFFFF	//!< Event without format string
+
+#define SYSEVTLOG_SECT_SIZE			512		//!< Persisted sector size, same as DISKIO_SECT_SIZE
+#define SYSEVTLOG_SECT_MAGIC		0x4C564553	//!< 'SEVL'
+#define SYSEVTLOG_SECT_NBREC		15		//!< Records per persisted sector
+
+/// X macro helpers for format string tables
+#define SYSEVTLOG_FMT_ENUM(Id, Str)		Id,
+#define SYSEVTLOG_FMT_STR(Id, Str)		Str,
+
+#pragma pack(push, 4)
+
+/// Event record
+typedef struct __Sys_Evt_Log_Rec {
+	uint32_t Seq;					//!< Sequence number, from 1. 0 - being written
+	uint32_t TimeStamp;				//!< Time stamp from time stamp callback
+	STATUS Code;					//!< Status code
+	uint16_t FmtId;					//!< Format string id, SYSEVTLOG_FMTID_NONE - none
+	uint8_t NbArg;					//!< Number of arguments
+	uint8_t Rsvd;
+	uint32_t Arg[SYSEVTLOG_MAXARG];	//!< Integer arguments
+} SYSEVTLOG_REC;
+
+/// Persisted sector
+typedef struct __Sys_Evt_Log_Sect {
+	uint32_t Magic;					//!< SYSEVTLOG_SECT_MAGIC
+	uint32_t Crc;					//!< crc32 of sector from SectSeq to the end
+	uint32_t SectSeq;				//!< Sector write sequence, from 1
+	uint16_t NbRec;					//!< Number of valid records
+	uint16_t Rsvd;
+	SYSEVTLOG_REC Rec[SYSEVTLOG_SECT_NBREC];
+	uint8_t Pad[SYSEVTLOG_SECT_SIZE - 16 - SYSEVTLOG_SECT_NBREC * sizeof(SYSEVTLOG_REC)];
+} SYSEVTLOG_SECT;
+
+/**
+ * @brief	Time stamp callback
+ *
+ * Called from the context logging the event, must be interrupt safe.
+ *
+ * @return	Time stamp in application units
+ */
+typedef uint32_t (*SYSEVTLOG_TIMECB)(void);
+
+/// Event log configuration
+typedef struct __Sys_Evt_Log_Cfg {
+	SYSEVTLOG_REC *pMem;			//!< Record memory
+	int NbRec;						//!< Number of records, must be power of 2
+	SYSEVTLOG_TIMECB TimeCB;		//!< Time stamp callback, NULL - no time stamp
+} SYSEVTLOG_CFG;
+
+/// Event log
+typedef struct __Sys_Evt_Log {
+	SYSEVTLOG_REC *pRec;			//!< Record ring
+	uint32_t Mask;					//!< Number of records - 1
+	SYSEVTLOG_TIMECB TimeCB;		//!< Time stamp callback
+	atomic_uint Head;				//!< Last sequence number claimed
+} SYSEVTLOG;
+
+#pragma pack(pop)
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief	Initialize event log.
+ *
+ * @param	pLog	: Pointer to event log
+ * @param	pCfg	: Pointer to configuration
+ *
+ * @return	true - success
+ */
+bool SysEvtLogInit(SYSEVTLOG * const pLog, const SYSEVTLOG_CFG * const pCfg);
+
+/**
+ * @brief	Log one event.
+ *
+ * Lock free, can be called from interrupts.
+ *
+ * @param	pLog	: Pointer to event log
+ * @param	Code	: Status code
+ * @param	FmtId	: Format string id, SYSEVTLOG_FMTID_NONE - none
+ * @param	NbArg	: Number of arguments, extra are dropped
+ * @param	pArg	: Arguments
+ *
+ * @return	Sequence number of the event
+ */
+uint32_t SysEvtLogWrite(SYSEVTLOG * const pLog, STATUS Code, uint16_t FmtId, int NbArg, const uint32_t *pArg);
+
+/**
+ * @brief	Log one event with variable integer arguments.
+ *
+ * 		SYSEVTLOG(&g_EvtLog, Code, FmtId, Arg0, Arg1, ...)
+ */
+#define SYSEVTLOG(pLog, Code, FmtId, ...) do { \
+		const uint32_t __args[] = { 0, ##__VA_ARGS__ }; \
+		SysEvtLogWrite(pLog, Code, FmtId, sizeof(__args) / sizeof(uint32_t) - 1, &__args[1]); \
+	} while (0)
+
+/**
+ * @brief	Last sequence number claimed.
+ *
+ * @param	pLog	: Pointer to event log
+ *
+ * @return	Sequence number, 0 - log empty
+ */
+static inline uint32_t SysEvtLogHead(SYSEVTLOG * const pLog) {
+	return atomic_load_explicit(&pLog->Head, memory_order_acquire);
+}
+
+/**
+ * @brief	Read one record.
+ *
+ * @param	pLog	: Pointer to event log
+ * @param	Seq		: Sequence number of the record
+ * @param	pRec	: Pointer to record to copy to
+ *
+ * @return	false - record overwritten or not yet written
+ */
+bool SysEvtLogRead(SYSEVTLOG * const pLog, uint32_t Seq, SYSEVTLOG_REC *pRec);
+
+/**
+ * @brief	Read records in order from a cursor.
+ *
+ * Single reader.  When records at the cursor were overwritten, reading skips to
+ * the oldest record.  Reading stops at a record still being written.
+ *
+ * @param	pLog	: Pointer to event log
+ * @param	pSeq	: Cursor, sequence number of next record to read. Updated
+ * @param	pRec	: Records buffer
+ * @param	MaxRec	: Max number of records to read
+ * @param	pLost	: Optional, receives number of records lost by overwrite
+ *
+ * @return	Number of records read
+ */
+int SysEvtLogGet(SYSEVTLOG * const pLog, uint32_t *pSeq, SYSEVTLOG_REC *pRec, int MaxRec, uint32_t *pLost);
+
+/**
+ * @brief	Format event message.
+ *
+ * Expands format string with record arguments.  Conversions d, i, u, x, X, o, c
+ * with flags, width & precision are supported.  Without format string the
+ * arguments are printed in hex.
+ *
+ * @param	pRec	: Pointer to record
+ * @param	pFmtTbl	: Format string table indexed by format id
+ * @param	NbFmt	: Number of strings in table
+ * @param	pBuff	: Buffer to receive message
+ * @param	BuffLen	: Buffer size
+ *
+ * @return	Message length
+ */
+int SysEvtLogFormat(const SYSEVTLOG_REC *pRec, const char * const *pFmtTbl, int NbFmt, char *pBuff, int BuffLen);
+
+/**
+ * @brief	Validate persisted sector.
+ *
+ * @param	pSect	: Pointer to sector
+ *
+ * @return	true - magic & CRC valid
+ */
+bool SysEvtLogSectValid(const SYSEVTLOG_SECT *pSect);
+
+/**
+ * @brief	Finalize persisted sector, sets magic & CRC.
+ *
+ * @param	pSect	: Pointer to sector with SectSeq, NbRec & records set
+ */
+void SysEvtLogSectSeal(SYSEVTLOG_SECT *pSect);
+
+#ifdef __cplusplus
+}
+
+class DiskIO;
+
+/// @brief	Event log with persistence to a DiskIO sector region.
+class SysEvtLog {
+public:
+	SysEvtLog();
+	virtual ~SysEvtLog() {}
+
+	bool Init(const SYSEVTLOG_CFG &Cfg) { return SysEvtLogInit(&vLog, &Cfg); }
+
+	uint32_t Write(STATUS Code, uint16_t FmtId = SYSEVTLOG_FMTID_NONE, int NbArg = 0, const uint32_t *pArg = NULL) {
+		return SysEvtLogWrite(&vLog, Code, FmtId, NbArg, pArg);
+	}
+
+	/**
+	 * @brief	Attach a persistence region.
+	 *
+	 * Region is scanned to resume after the most recent sector.  Only events
+	 * logged after this call are persisted.
+	 *
+	 * @param	pDisk		: Disk to write to
+	 * @param	StartSect	: First sector of region
+	 * @param	NbSect		: Number of sectors in region, at least 2
+	 *
+	 * @return	true - success
+	 */
+	bool PersistInit(DiskIO * const pDisk, uint32_t StartSect, uint32_t NbSect);
+
+	/**
+	 * @brief	Write pending records to the persistence region.
+	 *
+	 * Call from thread context, not from interrupts.  Only full sectors are
+	 * written unless flushing.  A flushed partial sector is not rewritten, the
+	 * next records go to the next sector.
+	 *
+	 * @param	bFlush	: true - also write last partial sector
+	 *
+	 * @return	Number of sectors written
+	 */
+	int Persist(bool bFlush = false);
+
+	/// Number of records overwritten before they could be persisted
+	uint32_t PersistLost() { return vLost; }
+
+	operator SYSEVTLOG * const () { return &vLog; }
+
+private:
+	SYSEVTLOG vLog;
+	DiskIO *vpDisk;
+	uint32_t vStartSect;
+	uint32_t vNbSect;
+	uint32_t vCurSect;				//!< Next sector to write, relative to StartSect
+	uint32_t vSectSeq;				//!< Last sector write sequence
+	uint32_t vPersistSeq;			//!< Next record to persist
+	uint32_t vLost;
+};
+
+#endif
+
+/** @} End of group Utilities */
+
+#endif // __SYSEVTLOG_H__
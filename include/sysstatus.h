@@ -34,11 +34,23 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Modified by         Date           	Description
 Hoan                Mar. 18, 2005	namespace TS
 Hoan				Nov. 18, 2014	Reimplementing for new EHAL C based
+Hoan				Oct. 19, 2026	Status codes to binary event log
 ----------------------------------------------------------------------------*/
 #ifndef __SYSSTATUS_H__
 #define __SYSSTATUS_H__
 
 #include "sysstatusdef.h"
+#include "sysevtlog.h"
+
+/**
+ * @brief	Status code log callback.
+ *
+ * Called from SysStatusSet, can be in interrupt context.
+ *
+ * @param	pCtx	: User context
+ * @param	Code	: Status code set
+ */
+typedef void (*SYSSTATUS_LOGCB)(void *pCtx, STATUS Code);
 
 // Max number of status code queued in system
 #define SYSSTATUS_MAXQUE      2
@@ -75,6 +87,32 @@ STATUS SysStatusGetPrevCode(void);
 STATUS SysStatusSet(STATUS Code, char *pDesc);
 STATUS SysStateSet(uint32_t State);
 
+/**
+ * @brief	Forward all status codes set to a callback.
+ *
+ * Description strings are not forwarded.
+ *
+ * @param	LogCB	: Callback, NULL - stop forwarding
+ * @param	pCtx	: Callback context
+ */
+void SysStatusSetLogCB(SYSSTATUS_LOGCB LogCB, void *pCtx);
+
+static inline void SysStatusEvtLogCB(void *pCtx, STATUS Code) {
+	SysEvtLogWrite((SYSEVTLOG *)pCtx, Code, SYSEVTLOG_FMTID_NONE, 0, NULL);
+}
+
+/**
+ * @brief	Log all status codes set to an event log.
+ *
+ * Description strings are not logged.  Only applications calling this
+ * need to link sysevtlog.c.
+ *
+ * @param	pLog : Pointer to event log, NULL - stop logging
+ */
+static inline void SysStatusSetLog(SYSEVTLOG * const pLog) {
+	SysStatusSetLogCB(pLog ? SysStatusEvtLogCB : NULL, pLog);
+}
+
 #ifdef __cplusplus
 }
 
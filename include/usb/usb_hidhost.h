@@ -55,6 +55,29 @@ public:
 	virtual bool GetSerialNumber(std::string &sn)=0;
 	virtual bool ProcessInputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize) = 0;
     virtual bool WaitResponse(int TimeOutSec) = 0;
+
+	/**
+	 * @brief	Wait for an input report with usec resolution
+	 *
+	 * Default rounds up to WaitResponse seconds for implementations without
+	 * finer timeout.
+	 *
+	 * @param	TimeoutUs : Timeout in usec
+	 *
+	 * @return	true - input report available
+	 */
+	virtual bool WaitResponseUs(uint32_t TimeoutUs) { return WaitResponse((TimeoutUs + 999999) / 1000000); }
+
+	/**
+	 * @brief	Queue output report without waiting for its transfer
+	 *
+	 * Default is synchronous WriteOutputReport.
+	 *
+	 * @return	false - queue full or write failed
+	 */
+	virtual bool QueueOutputReport(int RepNo, uint8_t *pBuf, uint32_t BufSize) {
+		return WriteOutputReport(RepNo, pBuf, BufSize, false);
+	}
     
 protected:
 	virtual void ReadDeviceInfo() = 0;
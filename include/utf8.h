@@ -3,6 +3,15 @@
 
 @brief	UTF8 conversion utilities
 
+Conversions validate input strictly : overlong forms, surrogates, code points
+above U+10FFFF and the old 5 & 6 bytes forms are errors. ASCII runs are
+converted 8 bytes per step, or 16 with SSSE3/NEON on host builds. Define
+UTF8_NO_SIMD to build without SIMD.
+
+All conversions stop at the first error or when the destination is full,
+returning how much was converted so they can be called repeatedly over a
+stream. A sequence cut at the end of the input is left unconverted and
+reported as partial.
 
 @author	Hoang Nguyen Hoan
 @date	Jun. 20, 2002
@@ -36,6 +45,8 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define __UTF8_H__
 
 #include <stdio.h>
+#include <stdint.h>
+#include <stdbool.h>
 
 /** @addtogroup Utilities
   * @{
@@ -88,6 +99,82 @@ int utf8towcs(const char *pSrc, int *pSrcSize, wchar_t *pDest, int *pDestLen);
  */ 
 int wcstoutf8(const wchar_t *pSrc, int *pSrcLen, char *pDest, int *pDestSize);
 
+/**
+ * @brief	Validate UTF8 string.
+ *
+ * @param   pSrc        UTF8 string
+ * @param   SrcSize     Length in bytes
+ * @param   pValidSize  Optional, returns length of the valid part in bytes,
+ *                      ending on a sequence boundary
+ *
+ * @return  0 - Valid\n
+ *          1 - Valid but ends inside a sequence\n
+ *         -1 - Invalid sequence at pValidSize
+ */
+int utf8validate(const char *pSrc, size_t SrcSize, size_t *pValidSize);
+
+/**
+ * @brief	Convert UTF8 to UTF16.
+ *
+ * Code points above U+FFFF produce surrogate pairs. A destination of SrcSize
+ * code units always fits.
+ *
+ * @param   pSrc        Pointer to UFT8 source string
+ * @param   pSrcSize    Input length in bytes, returns number of bytes converted
+ * @param   pDest       Pointer to resulting UTF16 string
+ * @param   pDestLen    Max destination length in code units, returns number
+ *                      of code units written
+ *
+ * @return  0 - Conversion completed\n
+ *          1 - Partial conversion, destination full or input ends inside a
+ *              sequence\n
+ *         -1 - Invalid sequence at pSrcSize
+ */
+int utf8toutf16(const char *pSrc, size_t *pSrcSize, uint16_t *pDest, size_t *pDestLen);
+
+/**
+ * @brief	Convert UTF8 to UTF32.
+ *
+ * Same as utf8toutf16, one code unit per code point.
+ */
+int utf8toutf32(const char *pSrc, size_t *pSrcSize, uint32_t *pDest, size_t *pDestLen);
+
+/**
+ * @brief	Convert UTF16 to UTF8.
+ *
+ * A destination of 3 bytes per code unit always fits.
+ *
+ * @param   pSrc        Pointer to UTF16 source string
+ * @param   pSrcLen     Input length in code units, returns number of code
+ *                      units converted
+ * @param   pDest       Pointer to resulting UTF8 string
+ * @param   pDestSize   Max buffer size in bytes, returns number of bytes
+ *                      written
+ *
+ * @return  0 - Conversion completed\n
+ *          1 - Partial conversion, destination full or input ends with a
+ *              high surrogate\n
+ *         -1 - Unpaired surrogate at pSrcLen
+ */
+int utf16toutf8(const uint16_t *pSrc, size_t *pSrcLen, char *pDest, size_t *pDestSize);
+
+/**
+ * @brief	Convert UTF32 to UTF8.
+ *
+ * Same as utf16toutf8, surrogates and values above U+10FFFF are errors. A
+ * destination of 4 bytes per code unit always fits.
+ */
+int utf32toutf8(const uint32_t *pSrc, size_t *pSrcLen, char *pDest, size_t *pDestSize);
+
+/**
+ * @brief	Enable/disable SIMD conversion, for test & benchmark.
+ *
+ * @param	bEnable	: true to use SIMD when available (default)
+ *
+ * @return	true if SIMD is available on this target
+ */
+bool utf8setsimd(bool bEnable);
+
 #ifdef __cplusplus
 }
 #endif
@@ -49,7 +49,7 @@ protected:
                                       wchar_t *to, 
                                       wchar_t *to_limit, 
                                       wchar_t *&to_next) const;
-   virtual int do_length(const mbstate_t &state, const char *from, 
+   virtual int do_length(mbstate_t &state, const char *from, 
                          const char *from_end, size_t limit) const throw();
    virtual codecvt_base::result do_out(mbstate_t &state, 
                                        const wchar_t *from, 
@@ -72,7 +72,7 @@ protected:
       return 0; // 0 for variable length 
    } 
    virtual int do_max_length() const throw() { 
-      return 6; // max length for UTF-8
+      return 4; // max length for UTF-8
    }
 };
 
@@ -32,64 +32,647 @@ Modified by          Date              Description
 
 ----------------------------------------------------------------------------*/
 #include <stdint.h>
+#include <string.h>
 
-#include "istddef.h"
 #include "base64.h"
 
-/*
- * Base64 Encode binary to ASCII
+#ifndef BASE64_NO_SIMD
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define BASE64_SSSE3
+#include <tmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define BASE64_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// Decode table special values, all have bit 7 set
+#define B64_WS			0xFE		// White space, skipped
+#define B64_PAD			0xFD		// '='
+#define B64_INV			0xFF		// Not a base64 character
+
+static const char s_Base64Alpha[2][64] = {
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/",
+	"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_",
+};
+
+static const uint8_t s_Base64Dec[2][256] = {
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF, 0xFF, 0x3F,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF,
+		0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+		0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	},
+	{
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFE, 0xFE, 0xFF, 0xFF, 0xFE, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFE, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x3E, 0xFF, 0xFF,
+		0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xFF, 0xFF, 0xFF, 0xFD, 0xFF, 0xFF,
+		0xFF, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+		0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xFF, 0xFF, 0xFF, 0xFF, 0x3F,
+		0xFF, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+		0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+		0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	},
+};
+
+static bool s_bBase64Simd = true;
+
+#ifdef BASE64_SSSE3
+
+/**
+ * SSSE3 encode, 12 bytes to 16 characters per step. Bytes are spread to
+ * 32 bits lanes with pshufb, the four 6 bits fields isolated with 16 bits
+ * multiplies, then turned to ASCII by adding an offset looked up from the
+ * field range.
+ */
+__attribute__((target("ssse3")))
+static int Base64EncSsse3(const uint8_t *pSrc, int Len, char *pDest, BASE64_ALPHABET Alphabet)
+{
+	const __m128i shuf = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+	const __m128i lut = _mm_setr_epi8('a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+									  '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+									  s_Base64Alpha[Alphabet][62] - 62, s_Base64Alpha[Alphabet][63] - 63,
+									  'A', 0, 0);
+	int i = 0;
+
+	// 16 bytes loaded, 12 used
+	for (; i + 16 <= Len; i += 12)
+	{
+		__m128i in = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)&pSrc[i]), shuf);
+		__m128i t0 = _mm_mulhi_epu16(_mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00)), _mm_set1_epi32(0x04000040));
+		__m128i t1 = _mm_mullo_epi16(_mm_and_si128(in, _mm_set1_epi32(0x003f03f0)), _mm_set1_epi32(0x01000010));
+		__m128i idx = _mm_or_si128(t0, t1);
+
+		// 0..25 -> 13, 26..51 -> 0, 52..61 -> 1..10, 62 -> 11, 63 -> 12
+		__m128i r = _mm_subs_epu8(idx, _mm_set1_epi8(51));
+		r = _mm_or_si128(r, _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), idx), _mm_set1_epi8(13)));
+
+		_mm_storeu_si128((__m128i *)&pDest[i / 3 * 4], _mm_add_epi8(idx, _mm_shuffle_epi8(lut, r)));
+	}
+
+	return i;
+}
+
+/**
+ * SSSE3 decode, 16 characters to 12 bytes per step. Stops at the first
+ * block containing anything but alphabet characters.
+ */
+__attribute__((target("ssse3")))
+static int Base64DecSsse3(const char *pSrc, int Len, uint8_t *pDest, int DstLen, BASE64_ALPHABET Alphabet)
+{
+	const __m128i c62 = _mm_set1_epi8(s_Base64Alpha[Alphabet][62]);
+	const __m128i c63 = _mm_set1_epi8(s_Base64Alpha[Alphabet][63]);
+	const __m128i shuf = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+	int i = 0, o = 0;
+
+	// 16 bytes stored, 12 used
+	for (; i + 16 <= Len && o + 16 <= DstLen; i += 16, o += 12)
+	{
+		__m128i c = _mm_loadu_si128((const __m128i *)&pSrc[i]);
+
+		// Signed compares, characters >= 0x80 fall in no range
+		__m128i maz = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('A' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('Z' + 1), c));
+		__m128i mlz = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('z' + 1), c));
+		__m128i m09 = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+		__m128i m62 = _mm_cmpeq_epi8(c, c62);
+		__m128i m63 = _mm_cmpeq_epi8(c, c63);
+
+		if (_mm_movemask_epi8(_mm_or_si128(_mm_or_si128(_mm_or_si128(maz, mlz), _mm_or_si128(m09, m62)), m63)) != 0xffff)
+		{
+			break;
+		}
+
+		__m128i off = _mm_or_si128(_mm_and_si128(maz, _mm_set1_epi8(-'A')), _mm_and_si128(mlz, _mm_set1_epi8(26 - 'a')));
+		off = _mm_or_si128(off, _mm_and_si128(m09, _mm_set1_epi8(52 - '0')));
+		off = _mm_or_si128(off, _mm_and_si128(m62, _mm_sub_epi8(_mm_set1_epi8(62), c62)));
+		off = _mm_or_si128(off, _mm_and_si128(m63, _mm_sub_epi8(_mm_set1_epi8(63), c63)));
+
+		__m128i v = _mm_add_epi8(c, off);
+
+		// Merge 6 bits fields : pairs to 12 bits, then to 24 bits per 32 bits lane
+		v = _mm_maddubs_epi16(v, _mm_set1_epi32(0x01400140));
+		v = _mm_madd_epi16(v, _mm_set1_epi32(0x00011000));
+
+		_mm_storeu_si128((__m128i *)&pDest[o], _mm_shuffle_epi8(v, shuf));
+	}
+
+	return i;
+}
+
+#endif	// BASE64_SSSE3
+
+#ifdef BASE64_NEON
+
+/**
+ * NEON encode, 48 bytes to 64 characters per step. De-interleaving load
+ * splits the triplets, table lookup on the 64 entries alphabet.
+ */
+static int Base64EncNeon(const uint8_t *pSrc, int Len, char *pDest, BASE64_ALPHABET Alphabet)
+{
+	const uint8_t *a = (const uint8_t *)s_Base64Alpha[Alphabet];
+	const uint8x16x4_t tbl = { { vld1q_u8(a), vld1q_u8(a + 16), vld1q_u8(a + 32), vld1q_u8(a + 48) } };
+	const uint8x16_t m = vdupq_n_u8(0x3f);
+	int i = 0;
+
+	for (; i + 48 <= Len; i += 48)
+	{
+		uint8x16x3_t in = vld3q_u8(&pSrc[i]);
+		uint8x16x4_t out;
+
+		out.val[0] = vshrq_n_u8(in.val[0], 2);
+		out.val[1] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[0], 4), vshrq_n_u8(in.val[1], 4)), m);
+		out.val[2] = vandq_u8(vorrq_u8(vshlq_n_u8(in.val[1], 2), vshrq_n_u8(in.val[2], 6)), m);
+		out.val[3] = vandq_u8(in.val[2], m);
+
+		out.val[0] = vqtbl4q_u8(tbl, out.val[0]);
+		out.val[1] = vqtbl4q_u8(tbl, out.val[1]);
+		out.val[2] = vqtbl4q_u8(tbl, out.val[2]);
+		out.val[3] = vqtbl4q_u8(tbl, out.val[3]);
+
+		vst4q_u8((uint8_t *)&pDest[i / 3 * 4], out);
+	}
+
+	return i;
+}
+
+/**
+ * NEON decode, 64 characters to 48 bytes per step using the ASCII half of
+ * the scalar decode table. Stops at the first block containing anything but
+ * alphabet characters.
+ */
+static int Base64DecNeon(const char *pSrc, int Len, uint8_t *pDest, int DstLen, BASE64_ALPHABET Alphabet)
+{
+	const uint8_t *t = s_Base64Dec[Alphabet];
+	const uint8x16x4_t tlo = { { vld1q_u8(t), vld1q_u8(t + 16), vld1q_u8(t + 32), vld1q_u8(t + 48) } };
+	const uint8x16x4_t thi = { { vld1q_u8(t + 64), vld1q_u8(t + 80), vld1q_u8(t + 96), vld1q_u8(t + 112) } };
+	const uint8x16_t k64 = vdupq_n_u8(64);
+	int i = 0, o = 0;
+
+	for (; i + 64 <= Len && o + 48 <= DstLen; i += 64, o += 48)
+	{
+		uint8x16x4_t in = vld4q_u8((const uint8_t *)&pSrc[i]);
+		uint8x16_t err = vdupq_n_u8(0);
+		uint8x16_t v[4];
+
+		for (int k = 0; k < 4; k++)
+		{
+			// Out of range indexes give 0 (tbl) or keep previous (tbx),
+			// characters >= 0x80 are caught by their own bit 7
+			v[k] = vqtbx4q_u8(vqtbl4q_u8(tlo, in.val[k]), thi, vsubq_u8(in.val[k], k64));
+			err = vorrq_u8(err, vorrq_u8(v[k], in.val[k]));
+		}
+
+		if (vmaxvq_u8(err) & 0x80)
+		{
+			break;
+		}
+
+		uint8x16x3_t out;
+
+		out.val[0] = vorrq_u8(vshlq_n_u8(v[0], 2), vshrq_n_u8(v[1], 4));
+		out.val[1] = vorrq_u8(vshlq_n_u8(v[1], 4), vshrq_n_u8(v[2], 2));
+		out.val[2] = vorrq_u8(vshlq_n_u8(v[2], 6), v[3]);
+
+		vst3q_u8(&pDest[o], out);
+	}
+
+	return i;
+}
+
+#endif	// BASE64_NEON
+
+bool Base64SetSimd(bool bEnable)
+{
+	s_bBase64Simd = bEnable;
+
+#if defined(BASE64_SSSE3)
+	return __builtin_cpu_supports("ssse3");
+#elif defined(BASE64_NEON)
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * @brief	Encode whole triplets.
  *
- * @param 	pSrc : Pointer to source binary data
- * 			SrcLen	: Source data length in bytes
- * 			pDest	: Pointer to ASCII destination buffer
- * 			DstLen	: Destination buffer length in bytes
+ * @return	Number of characters written
+ */
+static int Base64EncBulk(const uint8_t *pSrc, int Len, char *pDest, BASE64_ALPHABET Alphabet)
+{
+	const char *a = s_Base64Alpha[Alphabet];
+	int i = 0;
+
+#if defined(BASE64_SSSE3)
+	if (s_bBase64Simd && Len >= 16 && __builtin_cpu_supports("ssse3"))
+	{
+		i = Base64EncSsse3(pSrc, Len, pDest, Alphabet);
+	}
+#elif defined(BASE64_NEON)
+	if (s_bBase64Simd)
+	{
+		i = Base64EncNeon(pSrc, Len, pDest, Alphabet);
+	}
+#endif
+
+	char *d = &pDest[i / 3 * 4];
+
+	for (; i + 3 <= Len; i += 3)
+	{
+		uint32_t v = ((uint32_t)pSrc[i] << 16) | ((uint32_t)pSrc[i + 1] << 8) | pSrc[i + 2];
+
+		d[0] = a[v >> 18];
+		d[1] = a[(v >> 12) & 0x3f];
+		d[2] = a[(v >> 6) & 0x3f];
+		d[3] = a[v & 0x3f];
+		d += 4;
+	}
+
+	return i / 3 * 4;
+}
+
+/**
+ * @brief	Decode whole quads up to the first white space, padding or invalid
+ * character.
  *
- * 	@return	Number of bytes encoded
+ * @return	Number of characters consumed, multiple of 4
+ */
+static int Base64DecBulk(const char *pSrc, int Len, uint8_t *pDest, int DstLen, BASE64_ALPHABET Alphabet)
+{
+	const uint8_t *t = s_Base64Dec[Alphabet];
+	int i = 0;
+
+#if defined(BASE64_SSSE3)
+	if (s_bBase64Simd && Len >= 16 && __builtin_cpu_supports("ssse3"))
+	{
+		i = Base64DecSsse3(pSrc, Len, pDest, DstLen, Alphabet);
+	}
+#elif defined(BASE64_NEON)
+	if (s_bBase64Simd)
+	{
+		i = Base64DecNeon(pSrc, Len, pDest, DstLen, Alphabet);
+	}
+#endif
+
+	uint8_t *d = &pDest[i / 4 * 3];
+
+	for (; i + 4 <= Len && d + 3 <= &pDest[DstLen]; i += 4)
+	{
+		uint32_t a = t[(uint8_t)pSrc[i]];
+		uint32_t b = t[(uint8_t)pSrc[i + 1]];
+		uint32_t c = t[(uint8_t)pSrc[i + 2]];
+		uint32_t e = t[(uint8_t)pSrc[i + 3]];
+
+		if ((a | b | c | e) & 0x80)
+		{
+			break;
+		}
+
+		uint32_t v = (a << 18) | (b << 12) | (c << 6) | e;
+
+		d[0] = v >> 16;
+		d[1] = v >> 8;
+		d[2] = v;
+		d += 3;
+	}
+
+	return i;
+}
+
+bool Base64EncInit(BASE64_ENCCTX * const pCtx, BASE64_ALPHABET Alphabet, bool bPad, int LineLen)
+{
+	if (LineLen < 0 || (LineLen & 3))
+	{
+		return false;
+	}
+
+	pCtx->Alphabet = Alphabet;
+	pCtx->bPad = bPad;
+	pCtx->LineLen = LineLen;
+	pCtx->Col = 0;
+	pCtx->RemLen = 0;
+
+	return true;
+}
+
+/**
+ * @brief	Encode whole triplets with line wrapping. CR LF is written before
+ * the first character of a new line so the output never ends with one.
  */
-int Base64Encode(uint8_t *pSrc, int SrcLen, char *pDest, int DstLen)
+static int Base64EncChunk(BASE64_ENCCTX * const pCtx, const uint8_t *pSrc, int Len, char *pDest)
+{
+	if (pCtx->LineLen == 0)
+	{
+		return Base64EncBulk(pSrc, Len, pDest, pCtx->Alphabet);
+	}
+
+	int cnt = 0;
+
+	while (Len > 0)
+	{
+		if (pCtx->Col >= pCtx->LineLen)
+		{
+			pDest[cnt++] = '\r';
+			pDest[cnt++] = '\n';
+			pCtx->Col = 0;
+		}
+
+		int l = (pCtx->LineLen - pCtx->Col) / 4 * 3;
+
+		l = l < Len ? l : Len;
+
+		int n = Base64EncBulk(pSrc, l, &pDest[cnt], pCtx->Alphabet);
+
+		cnt += n;
+		pCtx->Col += n;
+		pSrc += l;
+		Len -= l;
+	}
+
+	return cnt;
+}
+
+int Base64EncUpdate(BASE64_ENCCTX * const pCtx, const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen)
 {
-	int idx = 0;
-	uint32_t d = 0;
-	uint8_t *p = (uint8_t *)&d;
-	int len;
+	int need = (pCtx->RemLen + SrcLen) / 3 * 4;
+
+	if (pCtx->LineLen > 0)
+	{
+		need += (pCtx->Col + need) / pCtx->LineLen * 2;
+	}
+	if (need > DstLen)
+	{
+		return -1;
+	}
+
 	int cnt = 0;
 
-	while (SrcLen > 0)
+	if (pCtx->RemLen > 0)
 	{
-		d = 0;
-		len = min(SrcLen - 1, 2);
-		for (int i = 2; i >= 0 && SrcLen > 0; i--)
+		while (pCtx->RemLen < 3 && SrcLen > 0)
 		{
-			p[i] = *pSrc;
-			pSrc++;
+			pCtx->Rem[pCtx->RemLen++] = *pSrc++;
 			SrcLen--;
 		}
-		len += 1 + idx;
-		for (int i = idx + 3; i >= idx && cnt < DstLen - 1; i--)
+		if (pCtx->RemLen < 3)
+		{
+			return 0;
+		}
+		cnt = Base64EncChunk(pCtx, pCtx->Rem, 3, pDest);
+		pCtx->RemLen = 0;
+	}
+
+	int l = SrcLen / 3 * 3;
+
+	cnt += Base64EncChunk(pCtx, pSrc, l, &pDest[cnt]);
+
+	pCtx->RemLen = SrcLen - l;
+	memcpy(pCtx->Rem, &pSrc[l], pCtx->RemLen);
+
+	return cnt;
+}
+
+int Base64EncFinal(BASE64_ENCCTX * const pCtx, char *pDest, int DstLen)
+{
+	if (pCtx->RemLen == 0)
+	{
+		pCtx->Col = 0;
+		return 0;
+	}
+
+	bool bbrk = pCtx->LineLen > 0 && pCtx->Col >= pCtx->LineLen;
+
+	if (DstLen < (bbrk ? 2 : 0) + (pCtx->bPad ? 4 : pCtx->RemLen + 1))
+	{
+		return -1;
+	}
+
+	const char *a = s_Base64Alpha[pCtx->Alphabet];
+	uint32_t v = (uint32_t)pCtx->Rem[0] << 16;
+	int cnt = 0;
+
+	if (pCtx->RemLen > 1)
+	{
+		v |= (uint32_t)pCtx->Rem[1] << 8;
+	}
+
+	if (bbrk)
+	{
+		pDest[cnt++] = '\r';
+		pDest[cnt++] = '\n';
+	}
+
+	pDest[cnt++] = a[v >> 18];
+	pDest[cnt++] = a[(v >> 12) & 0x3f];
+	if (pCtx->RemLen > 1)
+	{
+		pDest[cnt++] = a[(v >> 6) & 0x3f];
+	}
+	else if (pCtx->bPad)
+	{
+		pDest[cnt++] = '=';
+	}
+	if (pCtx->bPad)
+	{
+		pDest[cnt++] = '=';
+	}
+
+	pCtx->RemLen = 0;
+	pCtx->Col = 0;
+
+	return cnt;
+}
+
+void Base64DecInit(BASE64_DECCTX * const pCtx, BASE64_ALPHABET Alphabet)
+{
+	pCtx->Alphabet = Alphabet;
+	pCtx->QuadLen = 0;
+	pCtx->PadCnt = 0;
+	pCtx->bEnd = false;
+}
+
+/**
+ * @brief	Output bytes of a partial or complete quad
+ */
+static int Base64DecQuad(BASE64_DECCTX * const pCtx, uint8_t *pDest)
+{
+	uint32_t v = 0;
+
+	for (int i = 0; i < pCtx->QuadLen; i++)
+	{
+		v |= (uint32_t)pCtx->Quad[i] << (18 - i * 6);
+	}
+
+	int cnt = pCtx->QuadLen - 1;
+
+	for (int i = 0; i < cnt; i++)
+	{
+		pDest[i] = v >> (16 - i * 8);
+	}
+	pCtx->QuadLen = 0;
+
+	return cnt;
+}
+
+int Base64DecUpdate(BASE64_DECCTX * const pCtx, const char *pSrc, int SrcLen, uint8_t *pDest, int DstLen)
+{
+	const uint8_t *t = s_Base64Dec[pCtx->Alphabet];
+	int i = 0, cnt = 0;
+
+	while (i < SrcLen)
+	{
+		if (pCtx->QuadLen == 0 && pCtx->PadCnt == 0 && pCtx->bEnd == false)
+		{
+			int n = Base64DecBulk(&pSrc[i], SrcLen - i, &pDest[cnt], DstLen - cnt, pCtx->Alphabet);
+
+			i += n;
+			cnt += n / 4 * 3;
+
+			if (i >= SrcLen)
+			{
+				break;
+			}
+		}
+
+		uint8_t v = t[(uint8_t)pSrc[i++]];
+
+		if (v == B64_WS)
+		{
+			continue;
+		}
+
+		if (v == B64_PAD)
 		{
-			if (i > len)
-				pDest[i] = '=';
-			else {
-				pDest[i] = d & 0x3f;
-				if (pDest[i] < 26)
-					pDest[i] += 'A';
-				else if (pDest[i] < 52)
-					pDest[i] += 'a' - 26;
-				else if (pDest[i] < 62)
-					pDest[i] += '0' - 52;
-				else if (pDest[i] == 63)
-					pDest[i] = '/';
-				else
-					pDest[i] = '+';
+			// Only 1 or 2 '=' after at least 2 characters of a quad
+			if (pCtx->bEnd || pCtx->QuadLen < 2)
+			{
+				return -1;
 			}
-			d >>= 6;
-			cnt++;
+			pCtx->PadCnt++;
+			if (pCtx->QuadLen + pCtx->PadCnt == 4)
+			{
+				if (cnt + pCtx->QuadLen - 1 > DstLen)
+				{
+					return -1;
+				}
+				cnt += Base64DecQuad(pCtx, &pDest[cnt]);
+				pCtx->PadCnt = 0;
+				pCtx->bEnd = true;
+			}
+			continue;
+		}
+
+		if (v == B64_INV || pCtx->bEnd || pCtx->PadCnt > 0)
+		{
+			return -1;
+		}
+
+		pCtx->Quad[pCtx->QuadLen++] = v;
+		if (pCtx->QuadLen == 4)
+		{
+			if (cnt + 3 > DstLen)
+			{
+				return -1;
+			}
+			cnt += Base64DecQuad(pCtx, &pDest[cnt]);
+		}
+	}
+
+	return cnt;
+}
+
+int Base64DecFinal(BASE64_DECCTX * const pCtx, uint8_t *pDest, int DstLen)
+{
+	int cnt = 0;
+
+	if (pCtx->QuadLen == 1)
+	{
+		// 6 bits do not make a byte
+		cnt = -1;
+	}
+	else if (pCtx->QuadLen > 1)
+	{
+		if (DstLen < pCtx->QuadLen - 1)
+		{
+			return -1;
 		}
-		idx += 4;
+		cnt = Base64DecQuad(pCtx, pDest);
+	}
+
+	Base64DecInit(pCtx, pCtx->Alphabet);
+
+	return cnt;
+}
+
+int Base64EncodeEx(const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen,
+				   BASE64_ALPHABET Alphabet, bool bPad)
+{
+	BASE64_ENCCTX ctx;
+	int len = bPad ? BASE64_ENCODED_LEN(SrcLen) : (SrcLen * 4 + 2) / 3;
+
+	if (pDest == NULL || DstLen < len + 1)
+	{
+		return -1;
 	}
 
+	Base64EncInit(&ctx, Alphabet, bPad, 0);
+
+	int cnt = Base64EncUpdate(&ctx, pSrc, SrcLen, pDest, DstLen);
+
+	cnt += Base64EncFinal(&ctx, &pDest[cnt], DstLen - cnt);
 	pDest[cnt] = '\0';
 
 	return cnt;
 }
 
+int Base64Encode(const uint8_t *pSrc, int SrcLen, char *pDest, int DstLen)
+{
+	if (pDest == NULL || DstLen < 1)
+	{
+		return 0;
+	}
+
+	// Truncate to whole quads that fit
+	int max = (DstLen - 1) / 4 * 3;
+
+	return Base64EncodeEx(pSrc, SrcLen < max ? SrcLen : max, pDest, DstLen, BASE64_ALPHABET_STD, true);
+}
+
+int Base64Decode(const char *pSrc, int SrcLen, uint8_t *pDest, int DstLen, BASE64_ALPHABET Alphabet)
+{
+	BASE64_DECCTX ctx;
+
+	Base64DecInit(&ctx, Alphabet);
+
+	int cnt = Base64DecUpdate(&ctx, pSrc, SrcLen, pDest, DstLen);
+
+	if (cnt < 0)
+	{
+		return -1;
+	}
+
+	int n = Base64DecFinal(&ctx, &pDest[cnt], DstLen - cnt);
+
+	return n < 0 ? -1 : cnt + n;
+}
@@ -0,0 +1,500 @@
+/**-------------------------------------------------------------------------
+@file	blueio_codec.c
+
+@brief	Compact streaming record codec for BLUEIO sensor data
+
+See blueio_codec.h for block format.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+
+#include "blueio_codec.h"
+
+#define BLUEIO_CODEC_VARINT32_MAX		5
+#define BLUEIO_CODEC_VARINT64_MAX		10
+
+static const BLUEIO_FIELD s_TphField[] = {
+	{ offsetof(BLUEIO_DATA_TPH, Pressure), BLUEIO_FIELDTYPE_U32 },
+	{ offsetof(BLUEIO_DATA_TPH, Temperature), BLUEIO_FIELDTYPE_S16 },
+	{ offsetof(BLUEIO_DATA_TPH, Humidity), BLUEIO_FIELDTYPE_U16 },
+};
+
+static const BLUEIO_FIELD s_GasField[] = {
+	{ offsetof(BLUEIO_DATA_GAS, GasRes), BLUEIO_FIELDTYPE_U32 },
+	{ offsetof(BLUEIO_DATA_GAS, AirQIdx), BLUEIO_FIELDTYPE_U16 },
+	{ offsetof(BLUEIO_DATA_GAS, AirQuality), BLUEIO_FIELDTYPE_U8 },
+};
+
+// Accel, gyro & mag have the same layout. Raw values are two's complement,
+// delta wraps on 16 bits
+static const BLUEIO_FIELD s_Xyz16Field[] = {
+	{ 0, BLUEIO_FIELDTYPE_S16 },
+	{ 2, BLUEIO_FIELDTYPE_S16 },
+	{ 4, BLUEIO_FIELDTYPE_S16 },
+};
+
+static const BLUEIO_FIELD s_ProxyField[] = {
+	{ offsetof(BLUEIO_DATA_PROXY, Id), BLUEIO_FIELDTYPE_U32 },
+	{ offsetof(BLUEIO_DATA_PROXY, Val), BLUEIO_FIELDTYPE_U32 },
+};
+
+static const BLUEIO_FIELD s_AdcField[] = {
+	{ offsetof(BLUEIO_DATA_ADC, ChanId), BLUEIO_FIELDTYPE_U32 },
+	{ offsetof(BLUEIO_DATA_ADC, Voltage), BLUEIO_FIELDTYPE_F32 },
+};
+
+static const BLUEIO_FIELD s_GpioField[] = {
+	{ offsetof(BLUEIO_DATA_GPIO, PortNo), BLUEIO_FIELDTYPE_U8 },
+	{ offsetof(BLUEIO_DATA_GPIO, PinVal), BLUEIO_FIELDTYPE_U32 },
+};
+
+static const BLUEIO_FIELD s_MotionField[] = {
+	{ offsetof(BLUEIO_DATA_MOTION, Id), BLUEIO_FIELDTYPE_U32 },
+	{ offsetof(BLUEIO_DATA_MOTION, Val), BLUEIO_FIELDTYPE_U32 },
+};
+
+static const BLUEIO_FIELD s_BatField[] = {
+	{ offsetof(BLUEIO_DATA_BAT, Level), BLUEIO_FIELDTYPE_U8 },
+	{ offsetof(BLUEIO_DATA_BAT, Voltage), BLUEIO_FIELDTYPE_S32 },
+};
+
+#define BLUEIO_SCHEMA_DEF(Type, Rec, Pred, Field)	{ Type, sizeof(Rec), Pred, sizeof(Field) / sizeof(BLUEIO_FIELD), Field }
+
+const BLUEIO_SCHEMA g_BlueIOSchemaTph = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_TPH, BLUEIO_DATA_TPH, BLUEIO_CODEC_PRED_DELTA, s_TphField);
+const BLUEIO_SCHEMA g_BlueIOSchemaGas = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_GAS, BLUEIO_DATA_GAS, BLUEIO_CODEC_PRED_DELTA, s_GasField);
+const BLUEIO_SCHEMA g_BlueIOSchemaAccel = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_ACCEL, BLUEIO_DATA_ACCEL, BLUEIO_CODEC_PRED_LINEAR, s_Xyz16Field);
+const BLUEIO_SCHEMA g_BlueIOSchemaGyro = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_GYRO, BLUEIO_DATA_GYRO, BLUEIO_CODEC_PRED_LINEAR, s_Xyz16Field);
+const BLUEIO_SCHEMA g_BlueIOSchemaMag = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_MAG, BLUEIO_DATA_MAG, BLUEIO_CODEC_PRED_LINEAR, s_Xyz16Field);
+const BLUEIO_SCHEMA g_BlueIOSchemaProxy = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_PROXY, BLUEIO_DATA_PROXY, BLUEIO_CODEC_PRED_DELTA, s_ProxyField);
+const BLUEIO_SCHEMA g_BlueIOSchemaAdc = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_ADC, BLUEIO_DATA_ADC, BLUEIO_CODEC_PRED_DELTA, s_AdcField);
+const BLUEIO_SCHEMA g_BlueIOSchemaGpio = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_GPIO, BLUEIO_DATA_GPIO, BLUEIO_CODEC_PRED_DELTA, s_GpioField);
+const BLUEIO_SCHEMA g_BlueIOSchemaMotion = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_MOT, BLUEIO_DATA_MOTION, BLUEIO_CODEC_PRED_DELTA, s_MotionField);
+const BLUEIO_SCHEMA g_BlueIOSchemaBat = BLUEIO_SCHEMA_DEF(BLUEIO_DATA_TYPE_BAT, BLUEIO_DATA_BAT, BLUEIO_CODEC_PRED_DELTA, s_BatField);
+
+static const BLUEIO_SCHEMA * const s_BlueIOSchemas[] = {
+	&g_BlueIOSchemaTph, &g_BlueIOSchemaGas, &g_BlueIOSchemaAccel, &g_BlueIOSchemaGyro,
+	&g_BlueIOSchemaMag, &g_BlueIOSchemaProxy, &g_BlueIOSchemaAdc, &g_BlueIOSchemaGpio,
+	&g_BlueIOSchemaMotion, &g_BlueIOSchemaBat,
+};
+
+static inline int FieldWidth(BLUEIO_FIELDTYPE Type)
+{
+	return Type <= BLUEIO_FIELDTYPE_S8 ? 1 : Type <= BLUEIO_FIELDTYPE_S16 ? 2 : 4;
+}
+
+static inline bool FieldSigned(BLUEIO_FIELDTYPE Type)
+{
+	return Type == BLUEIO_FIELDTYPE_S8 || Type == BLUEIO_FIELDTYPE_S16 || Type == BLUEIO_FIELDTYPE_S32;
+}
+
+static inline uint32_t FieldMask(int Width)
+{
+	return Width >= 4 ? 0xFFFFFFFFUL : (1UL << (Width << 3)) - 1UL;
+}
+
+static inline uint32_t FieldRead(const uint8_t *pRec, const BLUEIO_FIELD *pField)
+{
+	switch (FieldWidth(pField->Type))
+	{
+		case 1:
+			return pRec[pField->Offset];
+		case 2:
+			{
+				uint16_t v;
+				memcpy(&v, &pRec[pField->Offset], 2);
+				return v;
+			}
+	}
+
+	uint32_t v;
+	memcpy(&v, &pRec[pField->Offset], 4);
+
+	return v;
+}
+
+static inline void FieldWrite(uint8_t *pRec, const BLUEIO_FIELD *pField, uint32_t Val)
+{
+	switch (FieldWidth(pField->Type))
+	{
+		case 1:
+			pRec[pField->Offset] = (uint8_t)Val;
+			break;
+		case 2:
+			{
+				uint16_t v = (uint16_t)Val;
+				memcpy(&pRec[pField->Offset], &v, 2);
+			}
+			break;
+		default:
+			memcpy(&pRec[pField->Offset], &Val, 4);
+	}
+}
+
+/// Sign extend Width bytes value to 32 bits
+static inline int32_t SignExtend(uint32_t Val, int Width)
+{
+	int shift = 32 - (Width << 3);
+
+	return (int32_t)(Val << shift) >> shift;
+}
+
+/// Predicted field value from previous records, modulo field width
+static inline uint32_t FieldPredict(const BLUEIO_SCHEMA *pSchema, const BLUEIO_FIELD *pField,
+									const uint8_t *pPrev, const uint8_t *pPrev2, int Hist)
+{
+	uint32_t v = FieldRead(pPrev, pField);
+
+	if (pSchema->Pred == BLUEIO_CODEC_PRED_LINEAR && Hist >= 2)
+	{
+		v = 2 * v - FieldRead(pPrev2, pField);
+	}
+
+	return v;
+}
+
+static inline uint32_t ZigZag(int32_t Val)
+{
+	return ((uint32_t)Val << 1) ^ (uint32_t)(Val >> 31);
+}
+
+static inline int32_t UnZigZag(uint32_t Val)
+{
+	return (int32_t)(Val >> 1) ^ -(int32_t)(Val & 1);
+}
+
+static inline uint64_t ZigZag64(int64_t Val)
+{
+	return ((uint64_t)Val << 1) ^ (uint64_t)(Val >> 63);
+}
+
+static inline int64_t UnZigZag64(uint64_t Val)
+{
+	return (int64_t)(Val >> 1) ^ -(int64_t)(Val & 1);
+}
+
+static inline int VarIntPut(uint8_t *p, uint64_t Val)
+{
+	int cnt = 0;
+
+	while (Val >= 0x80)
+	{
+		p[cnt++] = (uint8_t)Val | 0x80;
+		Val >>= 7;
+	}
+	p[cnt++] = (uint8_t)Val;
+
+	return cnt;
+}
+
+/// @return	Number of bytes consumed, 0 if malformed
+static inline int VarIntGet(const uint8_t *p, const uint8_t *pEnd, uint64_t *pVal, int MaxLen)
+{
+	uint64_t v = 0;
+	int cnt = 0;
+
+	while (p < pEnd && cnt < MaxLen)
+	{
+		uint8_t b = *p++;
+
+		v |= (uint64_t)(b & 0x7F) << (7 * cnt);
+		cnt++;
+		if ((b & 0x80) == 0)
+		{
+			*pVal = v;
+			return cnt;
+		}
+	}
+
+	return 0;
+}
+
+const BLUEIO_SCHEMA *BlueIOSchemaFind(uint8_t DataType)
+{
+	for (size_t i = 0; i < sizeof(s_BlueIOSchemas) / sizeof(s_BlueIOSchemas[0]); i++)
+	{
+		if (s_BlueIOSchemas[i]->DataType == DataType)
+		{
+			return s_BlueIOSchemas[i];
+		}
+	}
+
+	return NULL;
+}
+
+bool BlueIOEncInit(BLUEIO_ENCODER * const pEnc, const BLUEIO_SCHEMA * const pSchema, uint16_t KeyInterval, bool bTime)
+{
+	if (pEnc == NULL || pSchema == NULL || pSchema->RecSize > BLUEIO_CODEC_RECSIZE_MAX)
+	{
+		return false;
+	}
+
+	memset(pEnc, 0, sizeof(BLUEIO_ENCODER));
+	pEnc->pSchema = pSchema;
+	pEnc->KeyInterval = KeyInterval;
+	pEnc->bTime = bTime;
+	pEnc->RecSinceKey = UINT32_MAX;	// First block is a key block
+
+	return true;
+}
+
+bool BlueIOEncBegin(BLUEIO_ENCODER * const pEnc, uint8_t *pBuff, int BuffSize)
+{
+	pEnc->pBlk = NULL;
+	pEnc->BlkLen = 0;
+	pEnc->Cnt = 0;
+
+	if (pBuff == NULL || BuffSize <= BLUEIO_CODEC_BLKHDR_LEN)
+	{
+		return false;
+	}
+
+	pEnc->bKey = pEnc->RecSinceKey >= pEnc->KeyInterval;
+	pEnc->pBlk = pBuff;
+	pEnc->BlkSize = BuffSize;
+
+	pBuff[0] = BLUEIO_CODEC_ID(pEnc->pSchema->DataType);
+	pBuff[1] = (pEnc->bKey ? BLUEIO_CODEC_FLAG_KEY : 0) | (pEnc->bTime ? BLUEIO_CODEC_FLAG_TIME : 0) |
+			   (pEnc->Seq & BLUEIO_CODEC_SEQ_MASK);
+	pEnc->BlkLen = BLUEIO_CODEC_BLKHDR_LEN;
+
+	return true;
+}
+
+bool BlueIOEncPut(BLUEIO_ENCODER * const pEnc, const void *pRec, uint64_t Timestamp)
+{
+	const BLUEIO_SCHEMA *schema = pEnc->pSchema;
+	const uint8_t *rec = (const uint8_t*)pRec;
+	uint8_t tmp[BLUEIO_CODEC_VARINT64_MAX + BLUEIO_CODEC_RECSIZE_MAX * BLUEIO_CODEC_VARINT32_MAX];
+	bool key = pEnc->bKey && pEnc->Cnt == 0;
+	uint64_t intv = 0;
+	int len = 0;
+
+	if (pEnc->pBlk == NULL)
+	{
+		return false;
+	}
+
+	if (pEnc->bTime)
+	{
+		if (key)
+		{
+			len += VarIntPut(tmp, Timestamp);
+		}
+		else
+		{
+			intv = Timestamp - pEnc->PrevTime;
+			len += VarIntPut(tmp, ZigZag64((int64_t)(intv - pEnc->PrevIntv)));
+		}
+	}
+
+	for (int i = 0; i < schema->NbField; i++)
+	{
+		const BLUEIO_FIELD *f = &schema->pField[i];
+		int w = FieldWidth(f->Type);
+		uint32_t v = FieldRead(rec, f);
+		uint32_t z;
+
+		if (key)
+		{
+			z = FieldSigned(f->Type) ? ZigZag(SignExtend(v, w)) : v;
+		}
+		else
+		{
+			z = ZigZag(SignExtend((v - FieldPredict(schema, f, pEnc->Prev, pEnc->Prev2, pEnc->Hist)) & FieldMask(w), w));
+		}
+		len += VarIntPut(&tmp[len], z);
+	}
+
+	if (pEnc->BlkLen + len > pEnc->BlkSize)
+	{
+		return false;
+	}
+
+	memcpy(&pEnc->pBlk[pEnc->BlkLen], tmp, len);
+	pEnc->BlkLen += len;
+	memcpy(pEnc->Prev2, pEnc->Prev, schema->RecSize);
+	memcpy(pEnc->Prev, rec, schema->RecSize);
+	pEnc->Hist = key ? 1 : pEnc->Hist < 2 ? pEnc->Hist + 1 : 2;
+	pEnc->PrevTime = Timestamp;
+	pEnc->PrevIntv = intv;
+	pEnc->Cnt++;
+	pEnc->RecSinceKey = key ? 1 : pEnc->RecSinceKey + 1;
+
+	return true;
+}
+
+int BlueIOEncEnd(BLUEIO_ENCODER * const pEnc)
+{
+	int len = pEnc->Cnt > 0 ? pEnc->BlkLen : 0;
+
+	if (len > 0)
+	{
+		pEnc->Seq++;
+	}
+	pEnc->pBlk = NULL;
+	pEnc->Cnt = 0;
+
+	return len;
+}
+
+bool BlueIODecInit(BLUEIO_DECODER * const pDec, const BLUEIO_SCHEMA * const pSchema)
+{
+	if (pDec == NULL || pSchema == NULL || pSchema->RecSize > BLUEIO_CODEC_RECSIZE_MAX)
+	{
+		return false;
+	}
+
+	memset(pDec, 0, sizeof(BLUEIO_DECODER));
+	pDec->pSchema = pSchema;
+
+	return true;
+}
+
+int BlueIODecBlock(BLUEIO_DECODER * const pDec, const uint8_t *pBlk, int Len, void *pRec,
+				   uint64_t *pTimestamp, int MaxRec)
+{
+	const BLUEIO_SCHEMA *schema = pDec->pSchema;
+	const uint8_t *p = pBlk + BLUEIO_CODEC_BLKHDR_LEN;
+	const uint8_t *pend = pBlk + Len;
+	uint8_t *rec = (uint8_t*)pRec;
+	const uint8_t *prev = pDec->Prev;
+	const uint8_t *prev2 = pDec->Prev2;
+	int hist = pDec->Hist;
+	uint64_t t = pDec->PrevTime;
+	uint64_t intv = pDec->PrevIntv;
+	int cnt = 0;
+
+	if (pBlk == NULL || Len <= BLUEIO_CODEC_BLKHDR_LEN || pBlk[0] != BLUEIO_CODEC_ID(schema->DataType))
+	{
+		return -1;
+	}
+
+	uint8_t flags = pBlk[1] & ~BLUEIO_CODEC_SEQ_MASK;
+	uint8_t seq = pBlk[1] & BLUEIO_CODEC_SEQ_MASK;
+
+	if (seq != pDec->Seq)
+	{
+		pDec->LostCnt += (seq - pDec->Seq) & BLUEIO_CODEC_SEQ_MASK;
+		pDec->bSync = false;
+	}
+	pDec->Seq = (seq + 1) & BLUEIO_CODEC_SEQ_MASK;
+
+	if ((flags & BLUEIO_CODEC_FLAG_KEY) == 0 && pDec->bSync == false)
+	{
+		// Depends on a block we do not have. Wait for next key block
+		pDec->DropCnt++;
+
+		return 0;
+	}
+
+	// Anything below leaves the chain broken if it fails
+	pDec->bSync = false;
+
+	while (p < pend)
+	{
+		bool key = (flags & BLUEIO_CODEC_FLAG_KEY) && cnt == 0;
+
+		if (cnt >= MaxRec)
+		{
+			return -1;
+		}
+
+		if (flags & BLUEIO_CODEC_FLAG_TIME)
+		{
+			uint64_t z;
+			int l = VarIntGet(p, pend, &z, BLUEIO_CODEC_VARINT64_MAX);
+
+			if (l == 0)
+			{
+				return -1;
+			}
+			p += l;
+
+			if (key)
+			{
+				t = z;
+				intv = 0;
+			}
+			else
+			{
+				intv += (uint64_t)UnZigZag64(z);
+				t += intv;
+			}
+		}
+
+		memset(rec, 0, schema->RecSize);
+
+		for (int j = 0; j < schema->NbField; j++)
+		{
+			const BLUEIO_FIELD *f = &schema->pField[j];
+			uint32_t mask = FieldMask(FieldWidth(f->Type));
+			uint64_t z;
+			int l = VarIntGet(p, pend, &z, BLUEIO_CODEC_VARINT32_MAX);
+			uint32_t v;
+
+			if (l == 0 || z > 0xFFFFFFFFULL)
+			{
+				return -1;
+			}
+			p += l;
+
+			if (key)
+			{
+				v = FieldSigned(f->Type) ? (uint32_t)UnZigZag((uint32_t)z) : (uint32_t)z;
+			}
+			else
+			{
+				v = FieldPredict(schema, f, prev, prev2, hist) + (uint32_t)UnZigZag((uint32_t)z);
+			}
+			FieldWrite(rec, f, v & mask);
+		}
+
+		if (pTimestamp)
+		{
+			pTimestamp[cnt] = t;
+		}
+		hist = key ? 1 : hist < 2 ? hist + 1 : 2;
+		prev2 = prev;
+		prev = rec;
+		rec += schema->RecSize;
+		cnt++;
+	}
+
+	// Second previous may be the saved previous record, copy it first
+	memmove(pDec->Prev2, prev2, schema->RecSize);
+	memcpy(pDec->Prev, prev, schema->RecSize);
+	pDec->Hist = hist;
+	pDec->PrevTime = t;
+	pDec->PrevIntv = intv;
+	pDec->bSync = true;
+
+	return cnt;
+}
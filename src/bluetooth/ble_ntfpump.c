@@ -0,0 +1,298 @@
+/**-------------------------------------------------------------------------
+@file	ble_ntfpump.c
+
+@brief	Batched BLE notification pump implementation.
+
+See ble_ntfpump.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "stddev.h"
+#include "bluetooth/ble_ntfpump.h"
+
+static inline BLENTFPUMP_PKT *BleNtfPumpSlot(BLENTFPUMP * const pPump, int Idx)
+{
+	if (Idx >= pPump->NbSlot)
+	{
+		Idx -= pPump->NbSlot;
+	}
+
+	return (BLENTFPUMP_PKT*)&pPump->pMem[Idx * pPump->SlotSize];
+}
+
+static inline bool BleNtfPumpLock(BLENTFPUMP * const pPump)
+{
+	return atomic_flag_test_and_set(&pPump->bBusy) == false;
+}
+
+static inline void BleNtfPumpUnlock(BLENTFPUMP * const pPump)
+{
+	atomic_flag_clear(&pPump->bBusy);
+}
+
+/**
+ * @brief	Push queued packets into the stack until it refuses.
+ *
+ * Must be called with the pump owned.
+ */
+static void BleNtfPumpSend(BLENTFPUMP * const pPump)
+{
+	// Apply transmit completes reported from the stack event context
+	unsigned done = atomic_exchange(&pPump->TxDone, 0);
+
+	if (done > 0)
+	{
+		pPump->InFlight = done >= pPump->InFlight ? 0 : pPump->InFlight - done;
+	}
+
+	while (pPump->Cnt > 0)
+	{
+		BLENTFPUMP_PKT *pkt = BleNtfPumpSlot(pPump, pPump->Head);
+		bool bpartial = pPump->Cnt == 1 && pPump->bTailOpen;
+		// Packet queued before MTU was reduced is sent in chunks
+		uint16_t len = pkt->Len < pPump->Payload ? pkt->Len : pPump->Payload;
+
+		if (bpartial && pPump->InFlight >= pPump->PartialInFlight)
+		{
+			// Stack still has packets to send this connection event.
+			// Keep coalescing until next transmit complete.
+			break;
+		}
+
+		BLENTFPUMP_SENDRES res = pPump->SendCB(pPump->pCtx, pkt->Data, len);
+
+		if (res == BLENTFPUMP_SENDRES_BUSY)
+		{
+			// Leave packet in place for retry
+			pPump->BusyCnt++;
+			break;
+		}
+
+		if (res == BLENTFPUMP_SENDRES_OK)
+		{
+			pPump->InFlight++;
+			pPump->PktCnt++;
+			pPump->ByteCnt += len;
+		}
+		else
+		{
+			pPump->DropCnt++;
+		}
+
+		if (len < pkt->Len)
+		{
+			// Keep remainder at head
+			pkt->Len -= len;
+			memmove(pkt->Data, &pkt->Data[len], pkt->Len);
+			continue;
+		}
+
+		if (bpartial)
+		{
+			pPump->bTailOpen = false;
+		}
+		pPump->Head = pPump->Head + 1 < pPump->NbSlot ? pPump->Head + 1 : 0;
+		pPump->Cnt--;
+	}
+}
+
+/**
+ * @brief	Release pump, running send requests made while it was owned.
+ */
+static void BleNtfPumpRelease(BLENTFPUMP * const pPump)
+{
+	while (true)
+	{
+		BleNtfPumpUnlock(pPump);
+
+		if (pPump->bPending == false || BleNtfPumpLock(pPump) == false)
+		{
+			break;
+		}
+		pPump->bPending = false;
+		BleNtfPumpSend(pPump);
+	}
+}
+
+bool BleNtfPumpInit(BLENTFPUMP * const pPump, const BLENTFPUMP_CFG * const pCfg)
+{
+	if (pPump == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->SendCB == NULL ||
+		pCfg->MaxPayload == 0)
+	{
+		return false;
+	}
+
+	pPump->SlotSize = (pCfg->MaxPayload + sizeof(uint16_t) + 3) & ~3;
+	pPump->NbSlot = pCfg->MemSize / pPump->SlotSize;
+
+	if (pPump->NbSlot == 0)
+	{
+		return false;
+	}
+
+	pPump->pMem = pCfg->pMem;
+	pPump->MaxPayload = pCfg->MaxPayload;
+	pPump->Payload = pCfg->MaxPayload < BLENTFPUMP_DEFAULT_PAYLOAD ? pCfg->MaxPayload : BLENTFPUMP_DEFAULT_PAYLOAD;
+	pPump->PartialInFlight = pCfg->PartialInFlight > 0 ? pCfg->PartialInFlight : 1;
+	pPump->SendCB = pCfg->SendCB;
+	pPump->pCtx = pCfg->pCtx;
+	pPump->PktCnt = 0;
+	pPump->ByteCnt = 0;
+	pPump->BusyCnt = 0;
+	pPump->DropCnt = 0;
+	pPump->bPending = false;
+	atomic_flag_clear(&pPump->bBusy);
+
+	BleNtfPumpReset(pPump);
+
+	return true;
+}
+
+void BleNtfPumpSetMtu(BLENTFPUMP * const pPump, uint16_t Mtu)
+{
+	int payload = (int)Mtu - BLENTFPUMP_ATT_HDR_LEN;
+
+	if (payload < BLENTFPUMP_DEFAULT_PAYLOAD)
+	{
+		payload = BLENTFPUMP_DEFAULT_PAYLOAD;
+	}
+	pPump->Payload = payload < pPump->MaxPayload ? payload : pPump->MaxPayload;
+}
+
+int BleNtfPumpWrite(BLENTFPUMP * const pPump, const uint8_t *pData, int DataLen)
+{
+	if (BleNtfPumpLock(pPump) == false)
+	{
+		// Pump data is being modified by a preempted context
+		return 0;
+	}
+
+	int cnt = 0;
+
+	while (DataLen > 0)
+	{
+		if (pPump->bTailOpen)
+		{
+			BLENTFPUMP_PKT *pkt = BleNtfPumpSlot(pPump, pPump->Head + pPump->Cnt - 1);
+			int l = (int)pPump->Payload - pkt->Len;
+
+			if (l > 0)
+			{
+				l = l < DataLen ? l : DataLen;
+				memcpy(&pkt->Data[pkt->Len], pData, l);
+				pkt->Len += l;
+				pData += l;
+				DataLen -= l;
+				cnt += l;
+			}
+
+			if (pkt->Len >= pPump->Payload)
+			{
+				pPump->bTailOpen = false;
+			}
+			continue;
+		}
+
+		if (pPump->Cnt >= pPump->NbSlot)
+		{
+			break;
+		}
+
+		BleNtfPumpSlot(pPump, pPump->Head + pPump->Cnt)->Len = 0;
+		pPump->Cnt++;
+		pPump->bTailOpen = true;
+	}
+
+	pPump->bPending = false;
+	BleNtfPumpSend(pPump);
+	BleNtfPumpRelease(pPump);
+
+	return cnt;
+}
+
+void BleNtfPumpProcess(BLENTFPUMP * const pPump)
+{
+	pPump->bPending = true;
+
+	if (BleNtfPumpLock(pPump) == false)
+	{
+		// Owner will run it on release
+		return;
+	}
+
+	pPump->bPending = false;
+	BleNtfPumpSend(pPump);
+	BleNtfPumpRelease(pPump);
+}
+
+void BleNtfPumpTxComplete(BLENTFPUMP * const pPump, int Count)
+{
+	// InFlight is owned by the pump lock holder. Unknown count clears all
+	atomic_fetch_add(&pPump->TxDone, Count > 0 ? (unsigned)Count : 0xFFFFU);
+
+	BleNtfPumpProcess(pPump);
+}
+
+int BleNtfPumpAvail(BLENTFPUMP * const pPump)
+{
+	int avail = (pPump->NbSlot - pPump->Cnt) * pPump->Payload;
+
+	if (pPump->bTailOpen)
+	{
+		BLENTFPUMP_PKT *pkt = BleNtfPumpSlot(pPump, pPump->Head + pPump->Cnt - 1);
+
+		if (pkt->Len < pPump->Payload)
+		{
+			avail += pPump->Payload - pkt->Len;
+		}
+	}
+
+	return avail;
+}
+
+void BleNtfPumpReset(BLENTFPUMP * const pPump)
+{
+	pPump->Head = 0;
+	pPump->Cnt = 0;
+	pPump->bTailOpen = false;
+	pPump->InFlight = 0;
+	atomic_store(&pPump->TxDone, 0);
+}
+
+int BleNtfPumpStdDevWrite(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len)
+{
+	return BleNtfPumpWrite((BLENTFPUMP*)pDevObj, pBuff, Len);
+}
+
+int BleNtfPumpStdDevPoll(void * const pDevObj, int Handle, int Events)
+{
+	return BleNtfPumpAvail((BLENTFPUMP*)pDevObj) > 0 ? Events & STDDEV_POLLOUT : 0;
+}
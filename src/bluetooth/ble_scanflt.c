@@ -0,0 +1,521 @@
+/**-------------------------------------------------------------------------
+@file	ble_scanflt.c
+
+@brief	BLE central scan report filter & deduplication engine implementation.
+
+See ble_scanflt.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "bluetooth/ble_scanflt.h"
+
+// AD structure types looked at by the filters
+#define BLESCANFLT_AD_UUID16_MORE		0x02
+#define BLESCANFLT_AD_UUID16_CMPL		0x03
+#define BLESCANFLT_AD_UUID128_MORE		0x06
+#define BLESCANFLT_AD_UUID128_CMPL		0x07
+#define BLESCANFLT_AD_SRVDATA_UUID16	0x16
+#define BLESCANFLT_AD_SRVDATA_UUID128	0x21
+#define BLESCANFLT_AD_MANDATA			0xFF
+
+#define FNV32_OFFSET		2166136261U
+#define FNV32_PRIME			16777619U
+
+static inline bool BleScanFltLock(BLESCANFLT * const pFlt)
+{
+	return atomic_flag_test_and_set(&pFlt->bBusy) == false;
+}
+
+static inline void BleScanFltUnlock(BLESCANFLT * const pFlt)
+{
+	atomic_flag_clear(&pFlt->bBusy);
+}
+
+static inline uint32_t BleScanFltHash(uint32_t Hash, const uint8_t *p, int Len)
+{
+	for (int i = 0; i < Len; i++)
+	{
+		Hash = (Hash ^ p[i]) * FNV32_PRIME;
+	}
+
+	return Hash;
+}
+
+static inline uint64_t BleScanFltAddrKey(const uint8_t *pAddr)
+{
+	uint64_t key = 0;
+
+	for (int i = BLESCANFLT_ADDR_LEN - 1; i >= 0; i--)
+	{
+		key = (key << 8) | pAddr[i];
+	}
+
+	return key;
+}
+
+/// Q4 smoothed RSSI rounded to dBm
+static inline int BleScanFltRssiDbm(int RssiQ4)
+{
+	return (RssiQ4 >= 0 ? RssiQ4 + 8 : RssiQ4 - 8) / 16;
+}
+
+static bool BleScanFltFindAddr(BLESCANFLT * const pFlt, uint64_t Key)
+{
+	int l = 0, h = pFlt->NbAddr - 1;
+
+	while (l <= h)
+	{
+		int m = (l + h) >> 1;
+
+		if (pFlt->AddrKey[m] == Key)
+		{
+			return true;
+		}
+		if (pFlt->AddrKey[m] < Key)
+		{
+			l = m + 1;
+		}
+		else
+		{
+			h = m - 1;
+		}
+	}
+
+	return false;
+}
+
+static bool BleScanFltFindUuid16(BLESCANFLT * const pFlt, uint16_t Uuid)
+{
+	int l = 0, h = pFlt->NbUuid16 - 1;
+
+	while (l <= h)
+	{
+		int m = (l + h) >> 1;
+
+		if (pFlt->Uuid16[m] == Uuid)
+		{
+			return true;
+		}
+		if (pFlt->Uuid16[m] < Uuid)
+		{
+			l = m + 1;
+		}
+		else
+		{
+			h = m - 1;
+		}
+	}
+
+	return false;
+}
+
+static bool BleScanFltFindUuid128(BLESCANFLT * const pFlt, const uint8_t *pUuid)
+{
+	for (int i = 0; i < pFlt->NbUuid128; i++)
+	{
+		if (memcmp(pFlt->pUuid128[i]->Data, pUuid, 16) == 0)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool BleScanFltInit(BLESCANFLT * const pFlt, const BLESCANFLT_CFG * const pCfg)
+{
+	if (pFlt == NULL || pCfg == NULL || pCfg->pDevTbl == NULL || pCfg->pQue == NULL ||
+		pCfg->pBatch == NULL || pCfg->BatchSize <= 0 || pCfg->EvtCB == NULL)
+	{
+		return false;
+	}
+
+	if (pCfg->NbDev <= 0 || pCfg->NbDev > 32768 || (pCfg->NbDev & (pCfg->NbDev - 1)) != 0)
+	{
+		return false;
+	}
+
+	if (pCfg->NbFilter < 0 || pCfg->NbFilter > BLESCANFLT_FILTER_MAX ||
+		(pCfg->NbFilter > 0 && pCfg->pFilter == NULL))
+	{
+		return false;
+	}
+
+	memset(pFlt, 0, sizeof(BLESCANFLT));
+
+	// Compile filter list into match table
+	for (int i = 0; i < pCfg->NbFilter; i++)
+	{
+		const BLESCANFLT_FILTER *f = &pCfg->pFilter[i];
+
+		switch (f->Type)
+		{
+			case BLESCANFLT_TYPE_ADDR:
+				if (f->Len != BLESCANFLT_ADDR_LEN)
+				{
+					return false;
+				}
+				pFlt->AddrKey[pFlt->NbAddr++] = BleScanFltAddrKey(f->Data);
+				break;
+			case BLESCANFLT_TYPE_UUID16:
+				if (f->Len != 2)
+				{
+					return false;
+				}
+				pFlt->Uuid16[pFlt->NbUuid16++] = f->Data[0] | (f->Data[1] << 8);
+				break;
+			case BLESCANFLT_TYPE_UUID128:
+				if (f->Len != 16)
+				{
+					return false;
+				}
+				pFlt->pUuid128[pFlt->NbUuid128++] = f;
+				break;
+			case BLESCANFLT_TYPE_MANDATA:
+				if (f->Len < 1 || f->Len > BLESCANFLT_FILTER_DATA_MAX)
+				{
+					return false;
+				}
+				pFlt->pManData[pFlt->NbManData++] = f;
+				break;
+			default:
+				return false;
+		}
+	}
+
+	// Sort for binary search
+	for (int i = 1; i < pFlt->NbAddr; i++)
+	{
+		uint64_t k = pFlt->AddrKey[i];
+		int j = i - 1;
+
+		for (; j >= 0 && pFlt->AddrKey[j] > k; j--)
+		{
+			pFlt->AddrKey[j + 1] = pFlt->AddrKey[j];
+		}
+		pFlt->AddrKey[j + 1] = k;
+	}
+
+	for (int i = 1; i < pFlt->NbUuid16; i++)
+	{
+		uint16_t k = pFlt->Uuid16[i];
+		int j = i - 1;
+
+		for (; j >= 0 && pFlt->Uuid16[j] > k; j--)
+		{
+			pFlt->Uuid16[j + 1] = pFlt->Uuid16[j];
+		}
+		pFlt->Uuid16[j + 1] = k;
+	}
+
+	pFlt->bAcceptAll = pCfg->NbFilter == 0;
+	pFlt->MinRssi = pCfg->MinRssi;
+	pFlt->RssiDelta = pCfg->RssiDelta;
+	pFlt->RssiShift = pCfg->RssiShift > 7 ? 7 : pCfg->RssiShift;
+	pFlt->DedupWindow = pCfg->DedupWindow;
+	pFlt->pDevTbl = pCfg->pDevTbl;
+	pFlt->DevMask = pCfg->NbDev - 1;
+	pFlt->pQue = pCfg->pQue;
+	pFlt->pBatch = pCfg->pBatch;
+	pFlt->BatchSize = pCfg->BatchSize;
+	pFlt->EvtCB = pCfg->EvtCB;
+	pFlt->pCtx = pCfg->pCtx;
+	atomic_flag_clear(&pFlt->bBusy);
+
+	BleScanFltReset(pFlt);
+
+	return true;
+}
+
+bool BleScanFltMatch(BLESCANFLT * const pFlt, const BLESCANFLT_REPORT * const pRpt)
+{
+	if (pFlt->bAcceptAll)
+	{
+		return true;
+	}
+
+	if (pFlt->NbAddr > 0 && BleScanFltFindAddr(pFlt, BleScanFltAddrKey(pRpt->Addr)))
+	{
+		return true;
+	}
+
+	if (pFlt->NbUuid16 == 0 && pFlt->NbUuid128 == 0 && pFlt->NbManData == 0)
+	{
+		return false;
+	}
+
+	// Single pass over the AD structures
+	const uint8_t *p = pRpt->pData;
+	const uint8_t *end = p + pRpt->Len;
+
+	while (p + 2 <= end)
+	{
+		int len = p[0];
+
+		if (len == 0 || p + 1 + len > end)
+		{
+			break;
+		}
+
+		const uint8_t *d = p + 2;
+		int dlen = len - 1;
+
+		switch (p[1])
+		{
+			case BLESCANFLT_AD_UUID16_MORE:
+			case BLESCANFLT_AD_UUID16_CMPL:
+				for (int i = 0; pFlt->NbUuid16 > 0 && i + 2 <= dlen; i += 2)
+				{
+					if (BleScanFltFindUuid16(pFlt, d[i] | (d[i + 1] << 8)))
+					{
+						return true;
+					}
+				}
+				break;
+			case BLESCANFLT_AD_SRVDATA_UUID16:
+				if (pFlt->NbUuid16 > 0 && dlen >= 2 && BleScanFltFindUuid16(pFlt, d[0] | (d[1] << 8)))
+				{
+					return true;
+				}
+				break;
+			case BLESCANFLT_AD_UUID128_MORE:
+			case BLESCANFLT_AD_UUID128_CMPL:
+				for (int i = 0; pFlt->NbUuid128 > 0 && i + 16 <= dlen; i += 16)
+				{
+					if (BleScanFltFindUuid128(pFlt, &d[i]))
+					{
+						return true;
+					}
+				}
+				break;
+			case BLESCANFLT_AD_SRVDATA_UUID128:
+				if (pFlt->NbUuid128 > 0 && dlen >= 16 && BleScanFltFindUuid128(pFlt, d))
+				{
+					return true;
+				}
+				break;
+			case BLESCANFLT_AD_MANDATA:
+				for (int i = 0; i < pFlt->NbManData; i++)
+				{
+					const BLESCANFLT_FILTER *f = pFlt->pManData[i];
+
+					if (dlen >= f->Len && memcmp(d, f->Data, f->Len) == 0)
+					{
+						return true;
+					}
+				}
+				break;
+		}
+		p += len + 1;
+	}
+
+	return false;
+}
+
+bool BleScanFltPut(BLESCANFLT * const pFlt, const BLESCANFLT_REPORT * const pRpt)
+{
+	pFlt->RxCnt++;
+
+	if (pRpt->Rssi < pFlt->MinRssi || BleScanFltMatch(pFlt, pRpt) == false)
+	{
+		pFlt->FltCnt++;
+
+		return false;
+	}
+
+	if (BleScanFltLock(pFlt) == false)
+	{
+		pFlt->DropCnt++;
+
+		return false;
+	}
+
+	uint32_t now = pFlt->CurTime;
+	uint32_t h = BleScanFltHash(FNV32_OFFSET, pRpt->Addr, BLESCANFLT_ADDR_LEN);
+	int nprobe = pFlt->DevMask + 1 < BLESCANFLT_PROBE_MAX ? pFlt->DevMask + 1 : BLESCANFLT_PROBE_MAX;
+	int idx = -1, freeidx = -1, oldidx = -1;
+	uint32_t oldage = 0;
+	bool bexpired = false;
+
+	h = BleScanFltHash(h, &pRpt->AddrType, 1);
+
+	for (int i = 0; i < nprobe; i++)
+	{
+		int n = (h + i) & pFlt->DevMask;
+		BLESCANFLT_DEV *e = &pFlt->pDevTbl[n];
+		uint32_t age = now - e->LastSeen;
+		bool bfree = e->DataHash == 0 || age > pFlt->DedupWindow;
+
+		if (e->DataHash != 0 && e->AddrType == pRpt->AddrType &&
+			memcmp(e->Addr, pRpt->Addr, BLESCANFLT_ADDR_LEN) == 0)
+		{
+			idx = n;
+			bexpired = bfree;
+			break;
+		}
+		if (bfree)
+		{
+			if (freeidx < 0)
+			{
+				freeidx = n;
+			}
+		}
+		else if (oldidx < 0 || age > oldage)
+		{
+			oldidx = n;
+			oldage = age;
+		}
+	}
+
+	BLESCANFLT_DEV *dev;
+	bool bchanged = false;
+
+	if (idx < 0 || bexpired)
+	{
+		// New device or seen again after expiry
+		if (idx < 0)
+		{
+			if (freeidx >= 0)
+			{
+				idx = freeidx;
+			}
+			else
+			{
+				idx = oldidx;
+				pFlt->EvictCnt++;
+			}
+		}
+		dev = &pFlt->pDevTbl[idx];
+		memcpy(dev->Addr, pRpt->Addr, BLESCANFLT_ADDR_LEN);
+		dev->AddrType = pRpt->AddrType;
+		dev->RssiQ4 = pRpt->Rssi * 16;
+		dev->DataHash = 0;
+		dev->FirstSeen = now;
+		dev->Count = 0;
+		dev->bNew = true;
+		pFlt->NewCnt++;
+		bchanged = true;
+	}
+	else
+	{
+		dev = &pFlt->pDevTbl[idx];
+		dev->RssiQ4 += (pRpt->Rssi * 16 - dev->RssiQ4) / (1 << pFlt->RssiShift);
+	}
+
+	dev->Rssi = pRpt->Rssi;
+	dev->LastSeen = now;
+	dev->Count++;
+
+	uint32_t dh = BleScanFltHash(FNV32_OFFSET, pRpt->pData, pRpt->Len);
+
+	dh = dh == 0 ? 1 : dh;
+	if (dh != dev->DataHash)
+	{
+		dev->DataHash = dh;
+		dev->Len = pRpt->Len < BLESCANFLT_DATA_MAX ? pRpt->Len : BLESCANFLT_DATA_MAX;
+		memcpy(dev->Data, pRpt->pData, dev->Len);
+		bchanged = true;
+	}
+	else if (bchanged == false)
+	{
+		pFlt->DupCnt++;
+	}
+
+	if (pFlt->RssiDelta > 0 && bchanged == false)
+	{
+		int d = BleScanFltRssiDbm(dev->RssiQ4) - dev->RssiSent;
+
+		bchanged = d >= pFlt->RssiDelta || -d >= pFlt->RssiDelta;
+	}
+
+	if (bchanged && dev->bQueued == false)
+	{
+		dev->bQueued = true;
+		pFlt->pQue[(pFlt->QueHead + pFlt->QueCnt) & pFlt->DevMask] = idx;
+		pFlt->QueCnt++;
+	}
+
+	BleScanFltUnlock(pFlt);
+
+	return bchanged;
+}
+
+int BleScanFltFlush(BLESCANFLT * const pFlt, uint32_t CurTime)
+{
+	int total = 0;
+
+	pFlt->CurTime = CurTime;
+
+	while (true)
+	{
+		int n = 0;
+
+		// Put only runs from a higher priority context, it cannot hold the
+		// table while we wait for it
+		while (BleScanFltLock(pFlt) == false);
+
+		while (pFlt->QueCnt > 0 && n < pFlt->BatchSize)
+		{
+			BLESCANFLT_DEV *dev = &pFlt->pDevTbl[pFlt->pQue[pFlt->QueHead]];
+
+			pFlt->QueHead = (pFlt->QueHead + 1) & pFlt->DevMask;
+			pFlt->QueCnt--;
+			dev->bQueued = false;
+			dev->RssiSent = BleScanFltRssiDbm(dev->RssiQ4);
+			memcpy(&pFlt->pBatch[n++], dev, sizeof(BLESCANFLT_DEV));
+			dev->bNew = false;
+		}
+
+		BleScanFltUnlock(pFlt);
+
+		if (n == 0)
+		{
+			break;
+		}
+
+		pFlt->EvtCB(pFlt->pCtx, pFlt->pBatch, n);
+		pFlt->DlvCnt += n;
+		total += n;
+	}
+
+	return total;
+}
+
+void BleScanFltReset(BLESCANFLT * const pFlt)
+{
+	while (BleScanFltLock(pFlt) == false);
+
+	memset(pFlt->pDevTbl, 0, (pFlt->DevMask + 1) * sizeof(BLESCANFLT_DEV));
+	pFlt->QueHead = 0;
+	pFlt->QueCnt = 0;
+
+	BleScanFltUnlock(pFlt);
+}
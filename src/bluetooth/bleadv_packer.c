@@ -0,0 +1,329 @@
+/**-------------------------------------------------------------------------
+@file	bleadv_packer.c
+
+@brief	Bit packed multi-reading advertising payload.
+
+See bleadv_packer.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <string.h>
+
+#include "bluetooth/bleadv_packer.h"
+
+static const BLEADV_PACK_FIELD s_TphField[] = {
+	{ -4000, 5, 12 },		// Temperature, 0.01 C unit
+	{ 30000, 2, 16 },		// Pressure, Pa
+	{ 0, 50, 8 },			// Humidity, 0.01 % unit
+};
+
+static const BLEADV_PACK_FIELD s_GasField[] = {
+	{ 0, 64, 16 },			// Gas resistance, ohm
+	{ 0, 1, 9 },			// Air quality index
+};
+
+static const BLEADV_PACK_FIELD s_BatField[] = {
+	{ 0, 1, 7 },			// Level, %
+	{ 1800, 10, 8 },		// Voltage, mV
+};
+
+static const BLEADV_PACK_FIELD s_ButField[] = {
+	{ 0, 1, 8 },			// State bit field
+};
+
+static const BLEADV_PACK_FIELD s_AccelField[] = {
+	{ -8192, 16, 10 },		// x, mG
+	{ -8192, 16, 10 },		// y, mG
+	{ -8192, 16, 10 },		// z, mG
+};
+
+#define BLEADV_PACK_TYPE_DEF(Tag, Field)	{ Tag, sizeof(Field) / sizeof(BLEADV_PACK_FIELD), Field }
+
+const BLEADV_PACK_TYPE g_BleAdvPackTypeTph = BLEADV_PACK_TYPE_DEF(BLEADV_PACK_TAG_TPH, s_TphField);
+const BLEADV_PACK_TYPE g_BleAdvPackTypeGas = BLEADV_PACK_TYPE_DEF(BLEADV_PACK_TAG_GAS, s_GasField);
+const BLEADV_PACK_TYPE g_BleAdvPackTypeBat = BLEADV_PACK_TYPE_DEF(BLEADV_PACK_TAG_BAT, s_BatField);
+const BLEADV_PACK_TYPE g_BleAdvPackTypeBut = BLEADV_PACK_TYPE_DEF(BLEADV_PACK_TAG_BUT, s_ButField);
+const BLEADV_PACK_TYPE g_BleAdvPackTypeAccel = BLEADV_PACK_TYPE_DEF(BLEADV_PACK_TAG_ACCEL, s_AccelField);
+
+static const BLEADV_PACK_TYPE * const s_BleAdvPackTypes[] = {
+	&g_BleAdvPackTypeTph, &g_BleAdvPackTypeGas, &g_BleAdvPackTypeBat,
+	&g_BleAdvPackTypeBut, &g_BleAdvPackTypeAccel,
+};
+
+/// LSB first bit stream
+typedef struct {
+	uint8_t *p;
+	int BitPos;
+	int BitLen;
+} BITSTREAM;
+
+static void BitPut(BITSTREAM *pBs, uint32_t Val, int NbBits)
+{
+	while (NbBits > 0)
+	{
+		int idx = pBs->BitPos >> 3;
+		int sh = pBs->BitPos & 7;
+		int l = 8 - sh < NbBits ? 8 - sh : NbBits;
+
+		pBs->p[idx] |= (uint8_t)((Val & ((1U << l) - 1U)) << sh);
+		Val >>= l;
+		NbBits -= l;
+		pBs->BitPos += l;
+	}
+}
+
+static uint32_t BitGet(BITSTREAM *pBs, int NbBits)
+{
+	uint32_t val = 0;
+	int n = 0;
+
+	while (n < NbBits)
+	{
+		int idx = pBs->BitPos >> 3;
+		int sh = pBs->BitPos & 7;
+		int l = 8 - sh < NbBits - n ? 8 - sh : NbBits - n;
+
+		val |= (uint32_t)((pBs->p[idx] >> sh) & ((1U << l) - 1U)) << n;
+		n += l;
+		pBs->BitPos += l;
+	}
+
+	return val;
+}
+
+static inline uint32_t FieldQuantize(const BLEADV_PACK_FIELD *pField, int32_t Val)
+{
+	uint32_t qmax = pField->NbBits >= 32 ? 0xFFFFFFFFU : (1U << pField->NbBits) - 1U;
+	int64_t d = (int64_t)Val - pField->Min;
+
+	if (d <= 0)
+	{
+		return 0;
+	}
+
+	uint64_t q = ((uint64_t)d + pField->Step / 2) / pField->Step;
+
+	return q > qmax ? qmax : (uint32_t)q;
+}
+
+static inline int32_t FieldValue(const BLEADV_PACK_FIELD *pField, uint32_t q)
+{
+	return (int32_t)(pField->Min + (int64_t)q * pField->Step);
+}
+
+int BleAdvPackTypeBits(const BLEADV_PACK_TYPE *pType)
+{
+	int bits = BLEADV_PACK_TAG_BITS;
+
+	for (int i = 0; i < pType->NbField; i++)
+	{
+		bits += pType->pField[i].NbBits;
+	}
+
+	return bits;
+}
+
+bool BleAdvPackInit(BLEADV_PACKER * const pPacker, BLEADV_PACK_SLOT *pSlot, int NbSlot)
+{
+	if (pPacker == NULL || pSlot == NULL || NbSlot <= 0 || NbSlot > BLEADV_PACK_SLOT_MAX)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < NbSlot; i++)
+	{
+		if (pSlot[i].pType == NULL || pSlot[i].pType->NbField > BLEADV_PACK_FIELD_MAX ||
+			pSlot[i].pType->Tag == BLEADV_PACK_TAG_END || pSlot[i].pType->Tag >= (1 << BLEADV_PACK_TAG_BITS))
+		{
+			return false;
+		}
+		memset(pSlot[i].Val, 0, sizeof(pSlot[i].Val));
+		pSlot[i].UpdateTime = 0;
+		pSlot[i].SentTime = 0;
+		pSlot[i].bValid = false;
+		pSlot[i].bChanged = false;
+	}
+
+	pPacker->pSlot = pSlot;
+	pPacker->NbSlot = NbSlot;
+	pPacker->Seq = 0;
+
+	return true;
+}
+
+void BleAdvPackUpdate(BLEADV_PACKER * const pPacker, int SlotIdx, const int32_t *pVal, uint32_t Time)
+{
+	if (SlotIdx < 0 || SlotIdx >= pPacker->NbSlot)
+	{
+		return;
+	}
+
+	BLEADV_PACK_SLOT *slot = &pPacker->pSlot[SlotIdx];
+	const BLEADV_PACK_TYPE *type = slot->pType;
+
+	for (int i = 0; i < type->NbField; i++)
+	{
+		if (slot->bValid == false ||
+			FieldQuantize(&type->pField[i], slot->Val[i]) != FieldQuantize(&type->pField[i], pVal[i]))
+		{
+			slot->bChanged = true;
+		}
+		slot->Val[i] = pVal[i];
+	}
+	slot->UpdateTime = Time;
+	slot->bValid = true;
+}
+
+int BleAdvPackBuild(BLEADV_PACKER * const pPacker, uint8_t *pBuff, int BuffLen, uint32_t Time)
+{
+	if (pBuff == NULL || BuffLen <= BLEADV_PACK_HDR_LEN)
+	{
+		return 0;
+	}
+
+	BITSTREAM bs = { pBuff + BLEADV_PACK_HDR_LEN, 0, (BuffLen - BLEADV_PACK_HDR_LEN) << 3 };
+	uint64_t done = 0;
+	int cnt = 0;
+
+	memset(pBuff, 0, BuffLen);
+
+	// Greedy by score : take best remaining reading that fits until none left
+	while (true)
+	{
+		uint64_t best = 0;
+		int bidx = -1;
+
+		for (int i = 0; i < pPacker->NbSlot; i++)
+		{
+			BLEADV_PACK_SLOT *slot = &pPacker->pSlot[i];
+
+			if ((done & (1ULL << i)) || slot->bValid == false || slot->Priority == 0 ||
+				(slot->MaxAge > 0 && Time - slot->UpdateTime > slot->MaxAge) ||
+				bs.BitPos + BleAdvPackTypeBits(slot->pType) > bs.BitLen)
+			{
+				continue;
+			}
+
+			uint64_t score = (uint64_t)slot->Priority * ((uint64_t)(Time - slot->SentTime) + 1);
+
+			if (slot->bChanged)
+			{
+				score <<= 1;
+			}
+			if (score > best)
+			{
+				best = score;
+				bidx = i;
+			}
+		}
+
+		if (bidx < 0)
+		{
+			break;
+		}
+
+		BLEADV_PACK_SLOT *slot = &pPacker->pSlot[bidx];
+		const BLEADV_PACK_TYPE *type = slot->pType;
+
+		BitPut(&bs, type->Tag, BLEADV_PACK_TAG_BITS);
+		for (int i = 0; i < type->NbField; i++)
+		{
+			BitPut(&bs, FieldQuantize(&type->pField[i], slot->Val[i]), type->pField[i].NbBits);
+		}
+		slot->SentTime = Time;
+		slot->bChanged = false;
+		done |= 1ULL << bidx;
+		cnt++;
+	}
+
+	if (cnt == 0)
+	{
+		return 0;
+	}
+
+	// Remaining bits are 0, decoded as end tag
+	pBuff[0] = BLEADV_MANDATA_TYPE_PACKED;
+	pBuff[1] = pPacker->Seq++;
+
+	return BLEADV_PACK_HDR_LEN + ((bs.BitPos + 7) >> 3);
+}
+
+int BleAdvPackDecode(const uint8_t *pData, int Len, const BLEADV_PACK_TYPE * const *pTypes, int NbType,
+					 BLEADV_PACK_READING *pReading, int MaxReading, uint8_t *pSeq)
+{
+	if (pData == NULL || Len < BLEADV_PACK_HDR_LEN || pData[0] != BLEADV_MANDATA_TYPE_PACKED)
+	{
+		return -1;
+	}
+
+	if (pTypes == NULL)
+	{
+		pTypes = s_BleAdvPackTypes;
+		NbType = sizeof(s_BleAdvPackTypes) / sizeof(s_BleAdvPackTypes[0]);
+	}
+
+	if (pSeq)
+	{
+		*pSeq = pData[1];
+	}
+
+	BITSTREAM bs = { (uint8_t*)pData + BLEADV_PACK_HDR_LEN, 0, (Len - BLEADV_PACK_HDR_LEN) << 3 };
+	int cnt = 0;
+
+	while (cnt < MaxReading && bs.BitPos + BLEADV_PACK_TAG_BITS <= bs.BitLen)
+	{
+		uint8_t tag = BitGet(&bs, BLEADV_PACK_TAG_BITS);
+		const BLEADV_PACK_TYPE *type = NULL;
+
+		for (int i = 0; i < NbType; i++)
+		{
+			if (pTypes[i]->Tag == tag)
+			{
+				type = pTypes[i];
+				break;
+			}
+		}
+
+		if (type == NULL || bs.BitPos + BleAdvPackTypeBits(type) - BLEADV_PACK_TAG_BITS > bs.BitLen)
+		{
+			// End tag, unknown type or truncated
+			break;
+		}
+
+		pReading[cnt].Tag = tag;
+		for (int i = 0; i < type->NbField; i++)
+		{
+			pReading[cnt].Val[i] = FieldValue(&type->pField[i], BitGet(&bs, type->pField[i].NbBits));
+		}
+		cnt++;
+	}
+
+	return cnt;
+}
@@ -0,0 +1,253 @@
+/**-------------------------------------------------------------------------
+@file	mono_clock.cpp
+
+@brief	64 bits monotonic nanosecond clock service
+
+See mono_clock.h for description.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "interrupt.h"
+#include "coredev/mono_clock.h"
+
+MonoClock::MonoClock()
+{
+	vpTimer = NULL;
+	vMask = 0;
+	vMult = 0;
+	vShift = 0;
+	vSeq = 0;
+	vBaseRaw = 0;
+	vBaseTick = 0;
+	vBaseNs = 0;
+	vBaseFrac = 0;
+}
+
+bool MonoClock::Init(Timer * const pTimer, int CntBits)
+{
+	if (pTimer == NULL || CntBits <= 0 || CntBits > 32 || pTimer->Frequency() == 0)
+	{
+		return false;
+	}
+
+	vpTimer = pTimer;
+	vMask = CntBits < 32 ? (1UL << CntBits) - 1UL : 0xFFFFFFFFUL;
+	vSeq = 0;
+	vBaseRaw = pTimer->TickCount() & vMask;
+	vBaseTick = 0;
+	vBaseNs = 0;
+	vBaseFrac = 0;
+
+	Calibrate();
+
+	return true;
+}
+
+void MonoClock::Calibrate()
+{
+	uint32_t freq = vpTimer->Frequency();
+
+	// Bring base to now with current factors before changing them
+	if (vMult != 0)
+	{
+		Update();
+	}
+
+	// Largest shift for which multiplier fits in 32 bits.  Counter delta is at
+	// most 32 bits so that delta * mult never overflows 64 bits
+	int shift = 32;
+	uint64_t mult;
+
+	do {
+		mult = ((1000000000ULL << shift) + (freq >> 1)) / freq;
+	} while (mult > 0xFFFFFFFFULL && --shift > 0);
+
+	uint32_t state = DisableInterrupt();
+
+	vSeq++;
+	MONOCLOCK_BARRIER();
+	vMult = (uint32_t)mult;
+	vShift = shift;
+	vBaseFrac = 0;
+	MONOCLOCK_BARRIER();
+	vSeq++;
+
+	EnableInterrupt(state);
+}
+
+void MonoClock::UpdateBase(uint32_t Raw)
+{
+	uint32_t d = (Raw - vBaseRaw) & vMask;
+	uint64_t acc = (uint64_t)d * vMult + vBaseFrac;
+
+	vSeq++;
+	MONOCLOCK_BARRIER();
+	vBaseNs += acc >> vShift;
+	vBaseFrac = acc & ((1ULL << vShift) - 1ULL);
+	vBaseTick += d;
+	vBaseRaw = Raw;
+	MONOCLOCK_BARRIER();
+	vSeq++;
+}
+
+void MonoClock::Update()
+{
+	uint32_t state = DisableInterrupt();
+
+	UpdateBase(vpTimer->TickCount() & vMask);
+
+	EnableInterrupt(state);
+}
+
+void MonoClock::Read(uint64_t &Tick, uint64_t &Ns)
+{
+	uint32_t seq, d;
+
+	// Retry if base was updated by an interrupt while reading
+	do {
+		seq = vSeq;
+		MONOCLOCK_BARRIER();
+
+		uint32_t raw = vpTimer->TickCount() & vMask;
+
+		d = (raw - vBaseRaw) & vMask;
+		Tick = vBaseTick + d;
+		Ns = vBaseNs + (((uint64_t)d * vMult + vBaseFrac) >> vShift);
+
+		MONOCLOCK_BARRIER();
+	} while ((seq & 1) || seq != vSeq);
+
+	// Past half wrap, move base forward so that next wrap is not missed
+	if (d > (vMask >> 1))
+	{
+		Update();
+	}
+}
+
+uint64_t MonoClock::Tick()
+{
+	uint64_t tick, ns;
+
+	Read(tick, ns);
+
+	return tick;
+}
+
+uint64_t MonoClock::TickToNs(uint64_t Tick)
+{
+	// Split in 32 bits halves to keep products within 64 bits
+	uint64_t hi = (Tick >> 32) * vMult;
+	uint64_t lo = (Tick & 0xFFFFFFFFULL) * vMult;
+
+	return (hi << (32 - vShift)) + (lo >> vShift);
+}
+
+ClockSync::ClockSync()
+{
+	vpRef = NULL;
+	vpSrc = NULL;
+	vNbSample = 0;
+	vRefNs = 0;
+	vSrcNs = 0;
+	vRefAnchor = 0;
+	vSrcAnchor = 0;
+	vRate = 0;
+}
+
+bool ClockSync::Init(MonoClock * const pRef, MonoClock * const pSrc)
+{
+	if (pRef == NULL || pSrc == NULL)
+	{
+		return false;
+	}
+
+	vpRef = pRef;
+	vpSrc = pSrc;
+	vNbSample = 0;
+	vRate = 0;
+
+	return true;
+}
+
+void ClockSync::Sample()
+{
+	uint32_t state = DisableInterrupt();
+
+	uint64_t s1 = vpSrc->nSecond();
+	uint64_t r = vpRef->nSecond();
+	uint64_t s2 = vpSrc->nSecond();
+
+	EnableInterrupt(state);
+
+	AddSample(r, s1 + ((s2 - s1) >> 1));
+}
+
+void ClockSync::AddSample(uint64_t RefNs, uint64_t SrcNs)
+{
+	if (vNbSample == 0 || SrcNs <= vSrcNs)
+	{
+		vRefAnchor = RefNs;
+		vSrcAnchor = SrcNs;
+	}
+	else
+	{
+		// Rate over the whole span since anchor sample.  Read quantization
+		// error is divided by the span length
+		int64_t dsrc = SrcNs - vSrcAnchor;
+		int64_t diff = (int64_t)(RefNs - vRefAnchor) - dsrc;
+
+		vRate = (diff << 32) / dsrc;
+
+		// Move anchor before the difference gets too large for the Q32 shift
+		if (diff > (1LL << 30) || diff < -(1LL << 30))
+		{
+			vRefAnchor = RefNs;
+			vSrcAnchor = SrcNs;
+		}
+	}
+
+	vRefNs = RefNs;
+	vSrcNs = SrcNs;
+	vNbSample++;
+}
+
+uint64_t ClockSync::Map(uint64_t SrcNs)
+{
+	int64_t delta = (int64_t)(SrcNs - vSrcNs);
+
+	return vRefNs + delta + ((delta * vRate) >> 32);
+}
+
+int32_t ClockSync::DriftPpb()
+{
+	return (int32_t)((vRate * 1000000000LL) >> 32);
+}
@@ -120,4 +120,21 @@ __attribute__((weak)) bool QuadSPISendCmd(SPIDEV * const pDev, uint8_t Cmd, uint
 	return false;
 }
 
+/**
+ * @brief	Enable Quad SPI memory mapped (execute in place) read mode
+ *
+ * Default implementation for interfaces without memory mapped support.
+ *
+ * @param	pDev : SPI device handle
+ * @param	Cmd : Flash read command code used for memory mapped access
+ * @param	AddrLen : Flash address size in bytes
+ * @param	DummyCycle : Number of dummy clock cycle of the read command
+ *
+ * @return	NULL - not supported
+ */
+__attribute__((weak)) const uint8_t *QuadSPIMemMap(SPIDEV * const pDev, uint8_t Cmd, uint8_t AddrLen, uint8_t DummyCycle)
+{
+	return NULL;
+}
+
 
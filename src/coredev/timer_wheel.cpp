@@ -0,0 +1,483 @@
+/**-------------------------------------------------------------------------
+@file	timer_wheel.cpp
+
+@brief	Software timer service multiplexed over a single hardware timer trigger
+
+See timer_wheel.h for description.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stddef.h>
+
+#include "interrupt.h"
+#include "coredev/timer_wheel.h"
+
+#define TIMER_WHEEL_SPAN_BITS		(TIMER_WHEEL_SLOT_BITS * TIMER_WHEEL_LEVELS)
+#define TIMER_WHEEL_NOTICK			UINT64_MAX
+
+// Align expiry on the coarsest tick boundary within the slack window so that
+// timers with overlapping windows expire on the same tick
+static inline uint64_t TimerWheelAlign(uint64_t Tick, uint64_t Slack)
+{
+	if (Slack == 0)
+	{
+		return Tick;
+	}
+
+	uint64_t end = Tick + Slack;
+	int bit = 63 - __builtin_clzll(Tick ^ end);
+
+	return end & ~((1ULL << bit) - 1ULL);
+}
+
+TimerWheel::TimerWheel()
+{
+	vpTimer = NULL;
+	vTrigNo = -1;
+	vCurTick = 0;
+	vArmedTick = TIMER_WHEEL_NOTICK;
+	vCount = 0;
+	vWakeupCnt = 0;
+	vbInProcess = false;
+	vpOverflow = NULL;
+
+	for (int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+	{
+		vOccupied[l] = 0;
+		for (int i = 0; i < TIMER_WHEEL_NBSLOT; i++)
+		{
+			vpSlot[l][i] = NULL;
+			if (l > 0)
+			{
+				vSlotMin[l - 1][i] = UINT32_MAX;
+			}
+		}
+	}
+}
+
+TimerWheel::~TimerWheel()
+{
+	if (vpTimer && vTrigNo >= 0)
+	{
+		vpTimer->DisableTimerTrigger(vTrigNo);
+	}
+}
+
+bool TimerWheel::Init(Timer * const pTimer, int TrigNo)
+{
+	if (pTimer == NULL)
+	{
+		return false;
+	}
+
+	if (TrigNo < 0)
+	{
+		TrigNo = pTimer->FindAvailTimerTrigger();
+	}
+
+	if (TrigNo < 0 || TrigNo >= pTimer->MaxTimerTrigger())
+	{
+		return false;
+	}
+
+	vpTimer = pTimer;
+	vTrigNo = TrigNo;
+	vCurTick = pTimer->TickCount();
+	vArmedTick = TIMER_WHEEL_NOTICK;
+
+	return true;
+}
+
+void TimerWheel::Insert(SWTIMER * const pSwTimer)
+{
+	uint64_t tick = pSwTimer->WheelTick < vCurTick ? vCurTick : pSwTimer->WheelTick;
+	uint64_t diff = tick ^ vCurTick;
+	SWTIMER **pp;
+
+	// Level is the highest tick digit that differs from current wheel time
+	int level = diff ? (63 - __builtin_clzll(diff)) / TIMER_WHEEL_SLOT_BITS : 0;
+
+	if (level >= TIMER_WHEEL_LEVELS)
+	{
+		pp = &vpOverflow;
+	}
+	else
+	{
+		int slot = (tick >> (level * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+
+		pp = &vpSlot[level][slot];
+		vOccupied[level] |= 1ULL << slot;
+
+		if (level > 0)
+		{
+			uint32_t off = tick & ((1ULL << (level * TIMER_WHEEL_SLOT_BITS)) - 1ULL);
+
+			if (off < vSlotMin[level - 1][slot])
+			{
+				vSlotMin[level - 1][slot] = off;
+			}
+		}
+	}
+
+	pSwTimer->pNext = *pp;
+	if (*pp)
+	{
+		(*pp)->ppPrev = &pSwTimer->pNext;
+	}
+	pSwTimer->ppPrev = pp;
+	*pp = pSwTimer;
+}
+
+void TimerWheel::Remove(SWTIMER * const pSwTimer)
+{
+	SWTIMER **pp = pSwTimer->ppPrev;
+
+	*pp = pSwTimer->pNext;
+	if (pSwTimer->pNext)
+	{
+		pSwTimer->pNext->ppPrev = pp;
+	}
+	pSwTimer->pNext = NULL;
+	pSwTimer->ppPrev = NULL;
+
+	// Removed the last timer of a slot, clear occupied bit
+	if (*pp == NULL && pp >= &vpSlot[0][0] && pp < &vpSlot[0][0] + TIMER_WHEEL_LEVELS * TIMER_WHEEL_NBSLOT)
+	{
+		int idx = pp - &vpSlot[0][0];
+		int l = idx / TIMER_WHEEL_NBSLOT;
+
+		vOccupied[l] &= ~(1ULL << (idx & TIMER_WHEEL_SLOT_MASK));
+		if (l > 0)
+		{
+			vSlotMin[l - 1][idx & TIMER_WHEEL_SLOT_MASK] = UINT32_MAX;
+		}
+	}
+}
+
+// Next wheel event tick.  Either a level 0 expiry, a higher level slot to be
+// cascaded down or the overflow list to be redistributed
+uint64_t TimerWheel::NextEvent()
+{
+	uint64_t evt = TIMER_WHEEL_NOTICK;
+
+	for (int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+	{
+		int shift = l * TIMER_WHEEL_SLOT_BITS;
+		int c = (vCurTick >> shift) & TIMER_WHEEL_SLOT_MASK;
+		uint64_t bits = vOccupied[l] & (~0ULL << c);
+
+		if (bits)
+		{
+			uint64_t base = (vCurTick >> (shift + TIMER_WHEEL_SLOT_BITS)) << (shift + TIMER_WHEEL_SLOT_BITS);
+			uint64_t t = base | ((uint64_t)__builtin_ctzll(bits) << shift);
+
+			if (t < evt)
+			{
+				evt = t;
+			}
+		}
+	}
+
+	if (vpOverflow)
+	{
+		uint64_t t = ((vCurTick >> TIMER_WHEEL_SPAN_BITS) + 1) << TIMER_WHEEL_SPAN_BITS;
+
+		if (t < evt)
+		{
+			evt = t;
+		}
+	}
+
+	return evt;
+}
+
+uint64_t TimerWheel::NextExpire()
+{
+	uint64_t exp = TIMER_WHEEL_NOTICK;
+
+	// Only the first occupied slot of each level needs to be looked at. Timers
+	// in later slots of the same level expire after it.
+	for (int l = 0; l < TIMER_WHEEL_LEVELS; l++)
+	{
+		int shift = l * TIMER_WHEEL_SLOT_BITS;
+		int c = (vCurTick >> shift) & TIMER_WHEEL_SLOT_MASK;
+		uint64_t bits = vOccupied[l] & (~0ULL << c);
+
+		if (bits == 0)
+		{
+			continue;
+		}
+
+		int s = __builtin_ctzll(bits);
+		uint64_t base = (vCurTick >> (shift + TIMER_WHEEL_SLOT_BITS)) << (shift + TIMER_WHEEL_SLOT_BITS);
+		uint64_t t = base | ((uint64_t)s << shift);
+
+		if (l > 0)
+		{
+			// Slot minimum is a lower bound, it is not raised when timers are
+			// stopped.  Refresh it once it is found to be already passed
+			if (t + vSlotMin[l - 1][s] <= vCurTick)
+			{
+				uint32_t off = UINT32_MAX;
+
+				for (SWTIMER *p = vpSlot[l][s]; p != NULL; p = p->pNext)
+				{
+					if (p->WheelTick - t < off)
+					{
+						off = p->WheelTick - t;
+					}
+				}
+				vSlotMin[l - 1][s] = off;
+			}
+			t += vSlotMin[l - 1][s];
+		}
+
+		if (t < exp)
+		{
+			exp = t;
+		}
+	}
+
+	for (SWTIMER *p = vpOverflow; p != NULL; p = p->pNext)
+	{
+		if (p->WheelTick < exp)
+		{
+			exp = p->WheelTick;
+		}
+	}
+
+	return exp;
+}
+
+void TimerWheel::Reprogram()
+{
+	uint64_t next = NextExpire();
+
+	if (next == TIMER_WHEEL_NOTICK)
+	{
+		if (vArmedTick != TIMER_WHEEL_NOTICK)
+		{
+			vpTimer->DisableTimerTrigger(vTrigNo);
+			vArmedTick = TIMER_WHEEL_NOTICK;
+		}
+
+		return;
+	}
+
+	uint64_t now = vpTimer->TickCount();
+	uint64_t delay = next > now ? next - now : 0;
+
+	if (delay < TIMER_WHEEL_MIN_TICK)
+	{
+		delay = TIMER_WHEEL_MIN_TICK;
+	}
+
+	vpTimer->EnableTimerTrigger(vTrigNo, TickToNs(delay),
+								TIMER_TRIG_TYPE_SINGLE, TimerTrigHandler, this);
+	vArmedTick = now + delay;
+}
+
+bool TimerWheel::Start(SWTIMER * const pSwTimer, uint64_t nsPeriod, TIMER_TRIG_TYPE Type,
+					   uint64_t nsSlack, SWTIMER_CB const Handler, void * const pContext)
+{
+	if (vpTimer == NULL || pSwTimer == NULL || Handler == NULL)
+	{
+		return false;
+	}
+
+	uint64_t period = nsToTick(nsPeriod);
+
+	if (period == 0)
+	{
+		period = 1;
+	}
+
+	uint32_t state = DisableInterrupt();
+
+	if (pSwTimer->ppPrev)
+	{
+		Remove(pSwTimer);
+		vCount--;
+	}
+
+	uint64_t now = vpTimer->TickCount();
+
+	// Wheel time is not advanced while idle. Catch up if nothing is pending
+	// so that the timer is placed at the lowest possible level
+	if (NextEvent() > now)
+	{
+		vCurTick = now;
+	}
+
+	pSwTimer->Expire = now + period;
+	pSwTimer->Period = Type == TIMER_TRIG_TYPE_CONTINUOUS ? period : 0;
+	pSwTimer->Slack = nsToTick(nsSlack);
+	pSwTimer->WheelTick = TimerWheelAlign(pSwTimer->Expire, pSwTimer->Slack);
+	pSwTimer->Handler = Handler;
+	pSwTimer->pContext = pContext;
+
+	Insert(pSwTimer);
+	vCount++;
+
+	// Only an earlier deadline needs the hardware trigger to be moved
+	if (vbInProcess == false && pSwTimer->WheelTick < vArmedTick)
+	{
+		Reprogram();
+	}
+
+	EnableInterrupt(state);
+
+	return true;
+}
+
+void TimerWheel::Stop(SWTIMER * const pSwTimer)
+{
+	uint32_t state = DisableInterrupt();
+
+	// Hardware trigger is left as is.  Worst case is one wakeup with
+	// nothing to expire
+	if (pSwTimer->ppPrev)
+	{
+		Remove(pSwTimer);
+		vCount--;
+	}
+
+	EnableInterrupt(state);
+}
+
+void TimerWheel::Advance(uint64_t Tick, uint32_t &IntState)
+{
+	uint64_t evt;
+
+	while ((evt = NextEvent()) <= Tick)
+	{
+		vCurTick = evt;
+
+		if (vpOverflow && (vCurTick & ((1ULL << TIMER_WHEEL_SPAN_BITS) - 1)) == 0)
+		{
+			SWTIMER *p = vpOverflow;
+
+			vpOverflow = NULL;
+			while (p)
+			{
+				SWTIMER *next = p->pNext;
+
+				Insert(p);
+				p = next;
+			}
+		}
+
+		// Cascade from top level down so that timers can drop through
+		// multiple levels in one step
+		for (int l = TIMER_WHEEL_LEVELS - 1; l > 0; l--)
+		{
+			int c = (vCurTick >> (l * TIMER_WHEEL_SLOT_BITS)) & TIMER_WHEEL_SLOT_MASK;
+
+			if (vOccupied[l] & (1ULL << c))
+			{
+				SWTIMER *p = vpSlot[l][c];
+
+				vpSlot[l][c] = NULL;
+				vOccupied[l] &= ~(1ULL << c);
+				vSlotMin[l - 1][c] = UINT32_MAX;
+
+				while (p)
+				{
+					SWTIMER *next = p->pNext;
+
+					Insert(p);
+					p = next;
+				}
+			}
+		}
+
+		int c = vCurTick & TIMER_WHEEL_SLOT_MASK;
+
+		// Expire one at a time, handler may start or stop other timers
+		while (vpSlot[0][c])
+		{
+			SWTIMER *p = vpSlot[0][c];
+
+			Remove(p);
+
+			if (p->Period)
+			{
+				p->Expire += p->Period;
+				if (p->Expire <= vCurTick)
+				{
+					// Missed periods, restart from now
+					p->Expire = vCurTick + p->Period;
+				}
+				p->WheelTick = TimerWheelAlign(p->Expire, p->Slack);
+				Insert(p);
+			}
+			else
+			{
+				vCount--;
+			}
+
+			// Do not hold off other interrupts while in user handler
+			EnableInterrupt(IntState);
+			p->Handler(p, p->pContext);
+			IntState = DisableInterrupt();
+		}
+	}
+
+	if (Tick > vCurTick)
+	{
+		vCurTick = Tick;
+	}
+}
+
+void TimerWheel::Process()
+{
+	if (vpTimer == NULL)
+	{
+		return;
+	}
+
+	uint32_t state = DisableInterrupt();
+
+	vbInProcess = true;
+	Advance(vpTimer->TickCount(), state);
+	vbInProcess = false;
+	Reprogram();
+
+	EnableInterrupt(state);
+}
+
+void TimerWheel::TimerTrigHandler(Timer * const pTimer, int TrigNo, void * const pContext)
+{
+	TimerWheel *wheel = (TimerWheel *)pContext;
+
+	wheel->vWakeupCnt++;
+	wheel->vArmedTick = TIMER_WHEEL_NOTICK;
+	wheel->Process();
+}
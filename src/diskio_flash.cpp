@@ -43,6 +43,8 @@ FlashDiskIO::FlashDiskIO() : DiskIO()
 {
 	vpWaitCB = NULL;
 	vpInterf = NULL;
+	vpMemMap = NULL;
+	vbMemMap = false;
 }
 
 bool FlashDiskIO::Init(const FLASHDISKIO_CFG &Cfg, DeviceIntrf * const pInterf,
@@ -72,6 +74,8 @@ bool FlashDiskIO::Init(const FLASHDISKIO_CFG &Cfg, DeviceIntrf * const pInterf,
     vRdCmd			= Cfg.RdCmd;
 	vWrCmd			= Cfg.WrCmd;
     vpInterf        = pInterf;
+    vpMemMap		= NULL;
+    vbMemMap		= false;
 
     if (pInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
@@ -116,7 +120,7 @@ uint32_t FlashDiskIO::ReadId(int Len)
 		if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
 		{
 			vpInterf->StartRx(vDevNo);
-			QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_READID, -1, 0, Len, 0);
+			QSPISendCmd(FLASH_CMD_READID, -1, 0, Len, 0);
 			vpInterf->RxData((uint8_t*)&id, Len);
 			vpInterf->StopRx();
 		}
@@ -145,7 +149,7 @@ uint8_t FlashDiskIO::ReadStatus()
 	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
 		vpInterf->StartRx(vDevNo);
-    	QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_READSTATUS, -1, 0, 1, 0);
+    	QSPISendCmd(FLASH_CMD_READSTATUS, -1, 0, 1, 0);
 		vpInterf->RxData((uint8_t*)&d, 1);
 		vpInterf->StopRx();
     }
@@ -189,7 +193,7 @@ void FlashDiskIO::WriteDisable()
 	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
 		vpInterf->StartTx(vDevNo);
-    	QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_WRDISABLE, -1, 0, 0, 0);
+    	QSPISendCmd(FLASH_CMD_WRDISABLE, -1, 0, 0, 0);
 		vpInterf->StopTx();
     }
     else
@@ -208,7 +212,7 @@ bool FlashDiskIO::WriteEnable(uint32_t Timeout)
 	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
 		vpInterf->StartTx(vDevNo);
-    	QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_WRENABLE, -1, 0, 0, 0);
+    	QSPISendCmd(FLASH_CMD_WRENABLE, -1, 0, 0, 0);
 		vpInterf->StopTx();
     }
     else
@@ -229,7 +233,7 @@ void FlashDiskIO::Erase()
 	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
 		vpInterf->StartTx(vDevNo);
-    	QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_BULK_ERASE, -1, 0, 0, 0);
+    	QSPISendCmd(FLASH_CMD_BULK_ERASE, -1, 0, 0, 0);
 		vpInterf->StopTx();
     }
     else
@@ -241,6 +245,7 @@ void FlashDiskIO::Erase()
     // This is a long wait polling at every second only
     WaitReady(-1, 1000000);
     WriteDisable();
+    MemMapRestore();
 }
 
 /**
@@ -269,7 +274,7 @@ void FlashDiskIO::EraseBlock(uint32_t BlkNo, int NbBlk)
     	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
         {
     		vpInterf->StartTx(vDevNo);
-    		QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_BLOCK_ERASE, addr, vAddrSize, 0, 0);
+    		QSPISendCmd(FLASH_CMD_BLOCK_ERASE, addr, vAddrSize, 0, 0);
     		vpInterf->StopTx();
         }
         else
@@ -282,6 +287,7 @@ void FlashDiskIO::EraseBlock(uint32_t BlkNo, int NbBlk)
     }
     WaitReady(-1, 1000000);
     WriteDisable();
+    MemMapRestore();
 }
 
 /**
@@ -310,7 +316,7 @@ void FlashDiskIO::EraseSector(uint32_t SectNo, int NbSect)
     	if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
         {
     		vpInterf->StartTx(vDevNo);
-    		QuadSPISendCmd(*(SPI*)vpInterf, FLASH_CMD_SECTOR_ERASE, addr, vAddrSize, 0, 0);
+    		QSPISendCmd(FLASH_CMD_SECTOR_ERASE, addr, vAddrSize, 0, 0);
     		vpInterf->StopTx();
         }
         else
@@ -323,6 +329,7 @@ void FlashDiskIO::EraseSector(uint32_t SectNo, int NbSect)
     }
     WaitReady(-1, 1000000);
     WriteDisable();
+    MemMapRestore();
 }
 
 /**
@@ -335,13 +342,21 @@ bool FlashDiskIO::SectRead(uint32_t SectNo, uint8_t *pBuff)
     uint8_t *p = (uint8_t*)&addr;
     int cnt = DISKIO_SECT_SIZE;
 
+    if (vbMemMap && MemMap())
+    {
+    	// Memory mapped, no need to go through interface
+    	memcpy(pBuff, vpMemMap + addr, DISKIO_SECT_SIZE);
+
+    	return true;
+    }
+
     // Makesure there is no write access pending
     WaitReady(100000);
 
     if (vpInterf->Type() == DEVINTRF_TYPE_QSPI)
     {
 		vpInterf->StartRx(vDevNo);
-    	QuadSPISendCmd(*(SPI*)vpInterf, vRdCmd.Cmd , addr, vAddrSize, DISKIO_SECT_SIZE, vRdCmd.DummyCycle);
+    	QSPISendCmd(vRdCmd.Cmd , addr, vAddrSize, DISKIO_SECT_SIZE, vRdCmd.DummyCycle);
 		int l = vpInterf->RxData(pBuff, DISKIO_SECT_SIZE);
 		vpInterf->StopRx();
     }
@@ -388,7 +403,7 @@ bool FlashDiskIO::SectWrite(uint32_t SectNo, uint8_t *pData)
 			WriteEnable();
 			vpInterf->StartTx(vDevNo);
 
-			QuadSPISendCmd(*(SPI*)vpInterf, vWrCmd.Cmd, addr, vAddrSize, l, vWrCmd.DummyCycle);
+			QSPISendCmd(vWrCmd.Cmd, addr, vAddrSize, l, vWrCmd.DummyCycle);
 
 			l = vpInterf->TxData(pData, l);
 			vpInterf->StopTx();
@@ -428,8 +443,72 @@ bool FlashDiskIO::SectWrite(uint32_t SectNo, uint8_t *pData)
     }
 
 	WriteDisable();
+	MemMapRestore();
 
 	return true;
 }
 
+int FlashDiskIO::Read(uint64_t Offset, uint8_t *pBuff, uint32_t Len)
+{
+	if (vbMemMap == false)
+	{
+		return DiskIO::Read(Offset, pBuff, Len);
+	}
+
+	if (pBuff == NULL)
+		return -1;
+
+	uint64_t size = (uint64_t)vTotalSize * 1024ULL;
+
+	if (Offset >= size)
+		return 0;
+
+	if (Offset + Len > size)
+		Len = size - Offset;
+
+	// Write back pending cache data so that the mapped content is up to date
+	Flush(Offset, Len);
+
+	const uint8_t *p = MemMap();
+
+	if (p == NULL)
+	{
+		return DiskIO::Read(Offset, pBuff, Len);
+	}
+
+	memcpy(pBuff, p + Offset, Len);
+
+	return Len;
+}
+
+const uint8_t *FlashDiskIO::MemMap()
+{
+	// Remap only when first requested or when a command exited mapped mode
+	if (vpMemMap == NULL && vpInterf && vpInterf->Type() == DEVINTRF_TYPE_QSPI)
+	{
+	    // Makesure there is no write access pending
+	    WaitReady(100000);
+
+		vpMemMap = QuadSPIMemMap(*(SPI*)vpInterf, vRdCmd.Cmd, vAddrSize, vRdCmd.DummyCycle);
+		vbMemMap = vpMemMap != NULL;
+	}
+
+	return vpMemMap;
+}
 
+void FlashDiskIO::MemMapRestore()
+{
+	if (vbMemMap)
+	{
+		// Write/erase commands exit memory mapped mode. Re-enable it
+		WaitReady(-1, 100);
+		vpMemMap = QuadSPIMemMap(*(SPI*)vpInterf, vRdCmd.Cmd, vAddrSize, vRdCmd.DummyCycle);
+	}
+}
+
+bool FlashDiskIO::QSPISendCmd(uint8_t Cmd, uint32_t Addr, uint8_t AddrLen, uint32_t DataLen, uint8_t DummyCycle)
+{
+	vpMemMap = NULL;
+
+	return QuadSPISendCmd(*(SPI*)vpInterf, Cmd, Addr, AddrLen, DataLen, DummyCycle);
+}
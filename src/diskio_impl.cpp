@@ -238,3 +238,22 @@ void DiskIO::Flush()
         }
     }
 }
+
+void DiskIO::Flush(uint64_t Offset, uint32_t Len)
+{
+	if (Len == 0)
+		return;
+
+	uint64_t first = Offset / DISKIO_SECT_SIZE;
+	uint64_t last = (Offset + Len - 1) / DISKIO_SECT_SIZE;
+
+    for (int i = 0; i < vNbCache; i++)
+    {
+        if ((vpCacheSect[i].UseCnt & DISKIO_CACHE_DIRTY_BIT) &&
+        	vpCacheSect[i].SectNo >= first && vpCacheSect[i].SectNo <= last)
+        {
+            SectWrite(vpCacheSect[i].SectNo, vpCacheSect[i].pSectData);
+            vpCacheSect[i].UseCnt &= ~DISKIO_CACHE_DIRTY_BIT;
+        }
+    }
+}
@@ -0,0 +1,395 @@
+/**-------------------------------------------------------------------------
+@file	dlog.c
+
+@brief	Deferred formatting log implementation
+
+See dlog.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stdio.h>
+#include <string.h>
+#include <stdatomic.h>
+
+#include "dlog.h"
+
+// Format string section bounds, defined by the linker when DLOG is used
+extern const char __start_dlog_fmt[] __attribute__((weak));
+
+static inline DLOG_ARG DLogRecHdr(int NbArg)
+{
+	return DLOG_REC_MARK | (NbArg << 8) | (DLOG_REC_HDRLEN + NbArg);
+}
+
+bool DLogInit(DLOG * const pLog, const DLOG_CFG * const pCfg)
+{
+	size_t nbword = pCfg ? pCfg->MemSize / sizeof(DLOG_ARG) : 0;
+
+	if (pLog == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->WriteCB == NULL ||
+		nbword < 2 * (DLOG_REC_HDRLEN + DLOG_MAXARG) || (nbword & (nbword - 1)) != 0)
+	{
+		return false;
+	}
+
+	// Zero header marks a record not yet committed
+	memset(pCfg->pMem, 0, nbword * sizeof(DLOG_ARG));
+
+	pLog->pRing = pCfg->pMem;
+	pLog->Mask = nbword - 1;
+	atomic_store((atomic_uint*)&pLog->Head, 0);
+	atomic_store((atomic_uint*)&pLog->Tail, 0);
+	atomic_store((atomic_uint*)&pLog->DropCnt, 0);
+	pLog->DropRep = 0;
+	pLog->Mode = pCfg->Mode;
+	pLog->WriteCB = pCfg->WriteCB;
+	pLog->pCtx = pCfg->pCtx;
+	pLog->TimeCB = pCfg->TimeCB;
+	pLog->bSync = false;
+	pLog->OutLen = 0;
+	pLog->OutOff = 0;
+
+	return true;
+}
+
+bool DLogWrite(DLOG * const pLog, const char *pFmt, int NbArg, const DLOG_ARG *pArg)
+{
+	NbArg = NbArg < DLOG_MAXARG ? NbArg : DLOG_MAXARG;
+
+	uint32_t len = DLOG_REC_HDRLEN + NbArg;
+	uint32_t head = atomic_load_explicit((atomic_uint*)&pLog->Head, memory_order_relaxed);
+
+	// Reserve space
+	do {
+		if (head + len - atomic_load_explicit((atomic_uint*)&pLog->Tail, memory_order_acquire) > pLog->Mask + 1)
+		{
+			atomic_fetch_add_explicit((atomic_uint*)&pLog->DropCnt, 1, memory_order_relaxed);
+			return false;
+		}
+	} while (atomic_compare_exchange_weak_explicit((atomic_uint*)&pLog->Head, &head, head + len,
+												   memory_order_relaxed, memory_order_relaxed) == false);
+
+	DLOG_ARG *ring = pLog->pRing;
+	uint32_t mask = pLog->Mask;
+
+	ring[(head + 1) & mask] = pLog->TimeCB ? pLog->TimeCB() : 0;
+	ring[(head + 2) & mask] = (uint32_t)(pFmt - __start_dlog_fmt);
+	for (int i = 0; i < NbArg; i++)
+	{
+		ring[(head + DLOG_REC_HDRLEN + i) & mask] = pArg[i];
+	}
+
+	// Commit
+	atomic_store_explicit((atomic_uintptr_t*)&ring[head & mask], DLogRecHdr(NbArg), memory_order_release);
+
+	return true;
+}
+
+/**
+ * @brief	Write pending output.
+ *
+ * @return	true - all written
+ */
+static bool DLogFlushOut(DLOG * const pLog)
+{
+	while (pLog->OutOff < pLog->OutLen)
+	{
+		int l = pLog->WriteCB(pLog->pCtx, &pLog->OutBuf[pLog->OutOff], pLog->OutLen - pLog->OutOff);
+
+		if (l <= 0)
+		{
+			return false;
+		}
+		pLog->OutOff += l;
+	}
+
+	pLog->OutLen = 0;
+	pLog->OutOff = 0;
+
+	return true;
+}
+
+/**
+ * @brief	Encode one record into output buffer.
+ *
+ * @param	pRec	: Record, header, time stamp, format id then arguments
+ */
+static void DLogEncode(DLOG * const pLog, const DLOG_ARG *pRec)
+{
+	int nbarg = (pRec[0] >> 8) & 0xF;
+
+	if (pLog->Mode == DLOG_MODE_BIN)
+	{
+		pLog->OutLen = (DLOG_REC_HDRLEN + nbarg) * sizeof(DLOG_ARG);
+		memcpy(pLog->OutBuf, pRec, pLog->OutLen);
+
+		return;
+	}
+
+	char *p = (char*)pLog->OutBuf;
+	int len = 0;
+
+	if (pLog->TimeCB)
+	{
+		len = snprintf(p, DLOG_OUTBUF_SIZE, "[%u] ", (unsigned)pRec[1]);
+	}
+
+	if ((uint32_t)pRec[2] == DLOG_FMTID_DROP)
+	{
+		len += snprintf(&p[len], DLOG_OUTBUF_SIZE - len, "*** %u messages dropped\r\n", (unsigned)pRec[3]);
+	}
+	else
+	{
+		// Signed, format may be outside dlog_fmt, see DLogWrite
+		len += DLogFormat(&p[len], DLOG_OUTBUF_SIZE - len, __start_dlog_fmt + (int32_t)pRec[2],
+						  nbarg, &pRec[DLOG_REC_HDRLEN], NULL, NULL);
+	}
+
+	pLog->OutLen = len < DLOG_OUTBUF_SIZE - 1 ? len : DLOG_OUTBUF_SIZE - 1;
+}
+
+int DLogProcess(DLOG * const pLog)
+{
+	DLOG_ARG rec[DLOG_REC_HDRLEN + DLOG_MAXARG];
+	int cnt = 0;
+
+	while (DLogFlushOut(pLog))
+	{
+		if (pLog->Mode == DLOG_MODE_BIN && pLog->bSync == false)
+		{
+			rec[0] = DLogRecHdr(DLOG_SYNC_NBARG);
+			rec[1] = pLog->TimeCB ? pLog->TimeCB() : 0;
+			rec[2] = DLOG_FMTID_SYNC;
+			rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_MAGIC] = DLOG_SYNC_MAGIC;
+			rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_WORDSIZE] = sizeof(DLOG_ARG);
+			rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_FMTADDR] = (DLOG_ARG)__start_dlog_fmt;
+			rec[DLOG_REC_HDRLEN + DLOG_SYNC_ARG_FLAGS] = pLog->TimeCB ? DLOG_SYNC_FLAG_TIMESTAMP : 0;
+			DLogEncode(pLog, rec);
+			pLog->bSync = true;
+			continue;
+		}
+
+		uint32_t drop = atomic_load_explicit((atomic_uint*)&pLog->DropCnt, memory_order_relaxed);
+
+		if (drop != pLog->DropRep)
+		{
+			rec[0] = DLogRecHdr(1);
+			rec[1] = pLog->TimeCB ? pLog->TimeCB() : 0;
+			rec[2] = DLOG_FMTID_DROP;
+			rec[3] = drop - pLog->DropRep;
+			DLogEncode(pLog, rec);
+			pLog->DropRep = drop;
+			continue;
+		}
+
+		uint32_t tail = atomic_load_explicit((atomic_uint*)&pLog->Tail, memory_order_relaxed);
+		DLOG_ARG *ring = pLog->pRing;
+		uint32_t mask = pLog->Mask;
+		DLOG_ARG hdr = atomic_load_explicit((atomic_uintptr_t*)&ring[tail & mask], memory_order_acquire);
+
+		if (hdr == 0)
+		{
+			// Empty or being written
+			break;
+		}
+
+		int len = hdr & 0xFF;
+
+		// Copy record out and release its space, zeroed for next commit
+		for (int i = 0; i < len; i++)
+		{
+			rec[i] = ring[(tail + i) & mask];
+			ring[(tail + i) & mask] = 0;
+		}
+		atomic_store_explicit((atomic_uint*)&pLog->Tail, tail + len, memory_order_release);
+
+		DLogEncode(pLog, rec);
+		cnt++;
+	}
+
+	return cnt;
+}
+
+static int DLogAppend(char *pBuff, int BuffLen, int Len, const char *pStr, int StrLen)
+{
+	if (Len < BuffLen - 1)
+	{
+		int l = BuffLen - 1 - Len;
+
+		l = StrLen < l ? StrLen : l;
+		memcpy(&pBuff[Len], pStr, l);
+		pBuff[Len + l] = 0;
+	}
+
+	return Len + StrLen;
+}
+
+int DLogFormat(char *pBuff, int BuffLen, const char *pFmt, int NbArg, const DLOG_ARG *pArg,
+			   DLOG_STRCB StrCB, void *pCtx)
+{
+	char tmp[64];
+	int len = 0;
+	int argidx = 0;
+
+	if (pBuff == NULL || BuffLen <= 0)
+	{
+		return 0;
+	}
+
+	pBuff[0] = 0;
+
+	if (pFmt == NULL)
+	{
+		return 0;
+	}
+
+	while (*pFmt)
+	{
+		const char *lit = pFmt;
+
+		while (*pFmt && *pFmt != '%')
+		{
+			pFmt++;
+		}
+		len = DLogAppend(pBuff, BuffLen, len, lit, pFmt - lit);
+
+		if (*pFmt == 0)
+		{
+			break;
+		}
+
+		if (pFmt[1] == '%')
+		{
+			len = DLogAppend(pBuff, BuffLen, len, "%", 1);
+			pFmt += 2;
+			continue;
+		}
+
+		// Rebuild conversion with its own length modifier
+		char spec[16];
+		const char *start = pFmt++;
+		int sl = 1;
+		int lmod = 0;
+
+		spec[0] = '%';
+		while (*pFmt && strchr("-+ #0123456789.", *pFmt) && sl < (int)sizeof(spec) - 4)
+		{
+			spec[sl++] = *pFmt++;
+		}
+		while (*pFmt == 'h' || *pFmt == 'l' || *pFmt == 'z' || *pFmt == 't' || *pFmt == 'j')
+		{
+			if (*pFmt != 'h')
+			{
+				lmod = 1;
+			}
+			pFmt++;
+		}
+
+		char conv = *pFmt;
+
+		if (conv == 0 || strchr("diuxXocspfFeEgG", conv) == NULL)
+		{
+			if (conv)
+			{
+				pFmt++;
+			}
+			len = DLogAppend(pBuff, BuffLen, len, start, pFmt - start);
+			continue;
+		}
+		pFmt++;
+
+		if (argidx >= NbArg)
+		{
+			len = DLogAppend(pBuff, BuffLen, len, "?", 1);
+			continue;
+		}
+
+		DLOG_ARG a = pArg[argidx++];
+		int l;
+
+		if (lmod && strchr("diuxXo", conv))
+		{
+			spec[sl++] = 'l';
+		}
+		spec[sl++] = conv;
+		spec[sl] = 0;
+
+		switch (conv)
+		{
+			case 'd':
+			case 'i':
+				l = lmod ? snprintf(tmp, sizeof(tmp), spec, (long)(intptr_t)a) :
+						   snprintf(tmp, sizeof(tmp), spec, (int)a);
+				break;
+			case 'c':
+				l = snprintf(tmp, sizeof(tmp), spec, (int)a);
+				break;
+			case 's':
+				{
+					const char *str = StrCB ? StrCB(pCtx, a) : (const char*)a;
+
+					// String may be longer than tmp
+					if (str == NULL)
+					{
+						str = "(null)";
+					}
+					if (sl == 2)
+					{
+						len = DLogAppend(pBuff, BuffLen, len, str, strlen(str));
+						continue;
+					}
+					l = snprintf(tmp, sizeof(tmp), spec, str);
+				}
+				break;
+			case 'p':
+				l = snprintf(tmp, sizeof(tmp), spec, (void*)a);
+				break;
+			case 'f':
+			case 'F':
+			case 'e':
+			case 'E':
+			case 'g':
+			case 'G':
+				{
+					union { uint32_t u; float f; } v;
+
+					v.u = (uint32_t)a;
+					l = snprintf(tmp, sizeof(tmp), spec, (double)v.f);
+				}
+				break;
+			default:
+				l = lmod ? snprintf(tmp, sizeof(tmp), spec, (unsigned long)a) :
+						   snprintf(tmp, sizeof(tmp), spec, (unsigned)a);
+		}
+
+		l = l < (int)sizeof(tmp) - 1 ? l : (int)sizeof(tmp) - 1;
+		len = DLogAppend(pBuff, BuffLen, len, tmp, l);
+	}
+
+	return len;
+}
@@ -0,0 +1,892 @@
+/**-------------------------------------------------------------------------
+@file	ecdsa_p256.c
+
+@brief	ECDSA P-256 signature verification implementation.
+
+See ecdsa_p256.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "ecdsa_p256.h"
+
+#if defined(__SIZEOF_INT128__) && defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+#define P256_MUL64
+#endif
+
+/// Jacobian point, x = X / Z^2, y = Y / Z^3, Z = 0 is the point at infinity
+typedef struct {
+	uint32_t X[8];
+	uint32_t Y[8];
+	uint32_t Z[8];
+} P256_JPOINT;
+
+static const uint32_t s_P256p[8] = {
+	0xffffffff, 0xffffffff, 0xffffffff, 0x00000000, 0x00000000, 0x00000000, 0x00000001, 0xffffffff
+};
+
+static const uint32_t s_P256n[8] = {
+	0xfc632551, 0xf3b9cac2, 0xa7179e84, 0xbce6faad, 0xffffffff, 0xffffffff, 0x00000000, 0xffffffff
+};
+
+static const uint32_t s_P256b[8] = {
+	0x27d2604b, 0x3bce3c3e, 0xcc53b0f6, 0x651d06b0, 0x769886bc, 0xb3ebbd55, 0xaa3a93e7, 0x5ac635d8
+};
+
+static const uint32_t s_P256Gx[8] = {
+	0xd898c296, 0xf4a13945, 0x2deb33a0, 0x77037d81, 0x63a440f2, 0xf8bce6e5, 0xe12c4247, 0x6b17d1f2
+};
+
+static const uint32_t s_P256Gy[8] = {
+	0x37bf51f5, 0xcbb64068, 0x6b315ece, 0x2bce3357, 0x7c0f9e16, 0x8ee7eb4a, 0xfe1a7f9b, 0x4fe342e2
+};
+
+// 2^512 mod n, converts out of Montgomery form
+static const uint32_t s_P256nR2[8] = {
+	0xbe79eea2, 0x83244c95, 0x49bd6fa6, 0x4699799c, 0x2b6bec59, 0x2845b239, 0xf3d95620, 0x66e12d94
+};
+
+#define P256_N0INV		0xee00bc4f		// -n^-1 mod 2^32
+
+static inline bool P256IsZero(const uint32_t *a)
+{
+	return (a[0] | a[1] | a[2] | a[3] | a[4] | a[5] | a[6] | a[7]) == 0;
+}
+
+static inline bool P256IsOne(const uint32_t *a)
+{
+	return ((a[0] ^ 1) | a[1] | a[2] | a[3] | a[4] | a[5] | a[6] | a[7]) == 0;
+}
+
+static inline bool P256Equal(const uint32_t *a, const uint32_t *b)
+{
+	return memcmp(a, b, 32) == 0;
+}
+
+static int P256Cmp(const uint32_t *a, const uint32_t *b)
+{
+	for (int i = 7; i >= 0; i--)
+	{
+		if (a[i] != b[i])
+		{
+			return a[i] > b[i] ? 1 : -1;
+		}
+	}
+
+	return 0;
+}
+
+/// r = a + b, returns carry
+static uint32_t P256AddRaw(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	uint64_t c = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		c += (uint64_t)a[i] + b[i];
+		r[i] = (uint32_t)c;
+		c >>= 32;
+	}
+
+	return (uint32_t)c;
+}
+
+/// r = a - b, returns borrow
+static uint32_t P256SubRaw(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	int64_t c = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		c += (int64_t)a[i] - b[i];
+		r[i] = (uint32_t)c;
+		c >>= 32;
+	}
+
+	return (uint32_t)-c;
+}
+
+/// r = a + b mod m, a b < m
+static void P256ModAdd(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m)
+{
+	if (P256AddRaw(r, a, b) || P256Cmp(r, m) >= 0)
+	{
+		P256SubRaw(r, r, m);
+	}
+}
+
+/// r = a - b mod m, a b < m
+static void P256ModSub(uint32_t *r, const uint32_t *a, const uint32_t *b, const uint32_t *m)
+{
+	if (P256SubRaw(r, a, b))
+	{
+		P256AddRaw(r, r, m);
+	}
+}
+
+static inline void P256Add(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	P256ModAdd(r, a, b, s_P256p);
+}
+
+static inline void P256Sub(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	P256ModSub(r, a, b, s_P256p);
+}
+
+/**
+ * @brief	NIST fast reduction of 512 bits product mod p (FIPS 186-4 D.2.3).
+ */
+static void P256Reduce(uint32_t *r, const uint32_t *c)
+{
+	int64_t w[8];
+
+	w[0] = (int64_t)c[0] + c[8] + c[9] - c[11] - c[12] - c[13] - c[14];
+	w[1] = (int64_t)c[1] + c[9] + c[10] - c[12] - c[13] - c[14] - c[15];
+	w[2] = (int64_t)c[2] + c[10] + c[11] - c[13] - c[14] - c[15];
+	w[3] = (int64_t)c[3] + 2 * ((int64_t)c[11] + c[12]) + c[13] - c[15] - c[8] - c[9];
+	w[4] = (int64_t)c[4] + 2 * ((int64_t)c[12] + c[13]) + c[14] - c[9] - c[10];
+	w[5] = (int64_t)c[5] + 2 * ((int64_t)c[13] + c[14]) + c[15] - c[10] - c[11];
+	w[6] = (int64_t)c[6] + 3 * (int64_t)c[14] + 2 * (int64_t)c[15] + c[13] - c[8] - c[9];
+	w[7] = (int64_t)c[7] + 3 * (int64_t)c[15] + c[8] - c[10] - c[11] - c[12] - c[13];
+
+	int64_t k = 0;
+
+	for (int i = 0; i < 8; i++)
+	{
+		k += w[i];
+		r[i] = (uint32_t)k;
+		k >>= 32;
+	}
+
+	// Fold carry back with 2^256 = 2^224 - 2^192 - 2^96 + 1 mod p
+	while (k != 0)
+	{
+		int64_t c2 = k;
+
+		k = 0;
+		for (int i = 0; i < 8; i++)
+		{
+			k += r[i];
+			if (i == 0 || i == 7)
+			{
+				k += c2;
+			}
+			else if (i == 3 || i == 6)
+			{
+				k -= c2;
+			}
+			r[i] = (uint32_t)k;
+			k >>= 32;
+		}
+	}
+
+	while (P256Cmp(r, s_P256p) >= 0)
+	{
+		P256SubRaw(r, r, s_P256p);
+	}
+}
+
+/// r = a * b mod p
+static void P256Mul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	uint32_t t[16];
+
+#ifdef P256_MUL64
+	uint64_t a64[4], b64[4], t64[8];
+	unsigned __int128 acc = 0;
+
+	memcpy(a64, a, 32);
+	memcpy(b64, b, 32);
+
+	for (int k = 0; k < 7; k++)
+	{
+		uint64_t hi = 0;
+		int i0 = k < 4 ? 0 : k - 3;
+		int i1 = k < 4 ? k : 3;
+
+		for (int i = i0; i <= i1; i++)
+		{
+			unsigned __int128 p = (unsigned __int128)a64[i] * b64[k - i];
+
+			acc += p;
+			hi += acc < p;
+		}
+		t64[k] = (uint64_t)acc;
+		acc = (acc >> 64) | ((unsigned __int128)hi << 64);
+	}
+	t64[7] = (uint64_t)acc;
+	memcpy(t, t64, 64);
+#else
+	uint64_t acc = 0;
+
+	// Product scanning, 96 bits accumulator
+	for (int k = 0; k < 15; k++)
+	{
+		uint32_t hi = 0;
+		int i0 = k < 8 ? 0 : k - 7;
+		int i1 = k < 8 ? k : 7;
+
+		for (int i = i0; i <= i1; i++)
+		{
+			uint64_t p = (uint64_t)a[i] * b[k - i];
+
+			acc += p;
+			hi += acc < p;
+		}
+		t[k] = (uint32_t)acc;
+		acc = (acc >> 32) | ((uint64_t)hi << 32);
+	}
+	t[15] = (uint32_t)acc;
+#endif
+
+	P256Reduce(r, t);
+}
+
+static inline void P256Sqr(uint32_t *r, const uint32_t *a)
+{
+	P256Mul(r, a, a);
+}
+
+/// r = a^(2^n) * b
+static void P256SqrnMul(uint32_t *r, const uint32_t *a, int n, const uint32_t *b)
+{
+	uint32_t t[8];
+
+	memcpy(t, a, 32);
+	while (n-- > 0)
+	{
+		P256Sqr(t, t);
+	}
+	P256Mul(r, t, b);
+}
+
+/**
+ * @brief	r = a^-1 mod p as a^(p-2), fixed addition chain.
+ */
+static void P256Inv(uint32_t *r, const uint32_t *a)
+{
+	uint32_t x2[8], x4[8], x8[8], x16[8], x30[8], x32[8], t[8];
+
+	P256SqrnMul(x2, a, 1, a);
+	P256SqrnMul(x4, x2, 2, x2);
+	P256SqrnMul(x8, x4, 4, x4);
+	P256SqrnMul(x16, x8, 8, x8);
+	P256SqrnMul(t, x16, 8, x8);			// x24
+	P256SqrnMul(t, t, 4, x4);			// x28
+	P256SqrnMul(x30, t, 2, x2);
+	P256SqrnMul(x32, x30, 2, x2);
+
+	// p - 2 = ffffffff 00000001 00000000 00000000 00000000 ffffffff ffffffff fffffffd
+	P256SqrnMul(t, x32, 32, a);
+	P256SqrnMul(t, t, 128, x32);
+	P256SqrnMul(t, t, 32, x32);
+	P256SqrnMul(t, t, 30, x30);
+	P256SqrnMul(r, t, 2, a);
+}
+
+/// Halve mod m, m odd
+static void P256ModHalve(uint32_t *a, const uint32_t *m)
+{
+	uint32_t c = 0;
+
+	if (a[0] & 1)
+	{
+		c = P256AddRaw(a, a, m);
+	}
+	for (int i = 0; i < 7; i++)
+	{
+		a[i] = (a[i] >> 1) | (a[i + 1] << 31);
+	}
+	a[7] = (a[7] >> 1) | (c << 31);
+}
+
+static void P256Shr1(uint32_t *a)
+{
+	for (int i = 0; i < 7; i++)
+	{
+		a[i] = (a[i] >> 1) | (a[i + 1] << 31);
+	}
+	a[7] >>= 1;
+}
+
+/**
+ * @brief	r = a^-1 mod m, binary extended Euclid. m odd, 0 < a < m.
+ */
+static void P256ModInv(uint32_t *r, const uint32_t *a, const uint32_t *m)
+{
+	uint32_t u[8], v[8], x1[8] = { 1, }, x2[8] = { 0, };
+
+	memcpy(u, a, 32);
+	memcpy(v, m, 32);
+
+	while (P256IsOne(u) == false && P256IsOne(v) == false)
+	{
+		while ((u[0] & 1) == 0)
+		{
+			P256Shr1(u);
+			P256ModHalve(x1, m);
+		}
+		while ((v[0] & 1) == 0)
+		{
+			P256Shr1(v);
+			P256ModHalve(x2, m);
+		}
+		if (P256Cmp(u, v) >= 0)
+		{
+			P256SubRaw(u, u, v);
+			P256ModSub(x1, x1, x2, m);
+		}
+		else
+		{
+			P256SubRaw(v, v, u);
+			P256ModSub(x2, x2, x1, m);
+		}
+	}
+
+	memcpy(r, P256IsOne(u) ? x1 : x2, 32);
+}
+
+/**
+ * @brief	Montgomery multiplication mod n, r = a * b / 2^256 mod n.
+ */
+static void P256nMontMul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	uint32_t t[10] = { 0, };
+
+	for (int i = 0; i < 8; i++)
+	{
+		uint64_t c = 0;
+
+		for (int j = 0; j < 8; j++)
+		{
+			c += (uint64_t)a[j] * b[i] + t[j];
+			t[j] = (uint32_t)c;
+			c >>= 32;
+		}
+		c += t[8];
+		t[8] = (uint32_t)c;
+		t[9] = (uint32_t)(c >> 32);
+
+		uint32_t m = t[0] * P256_N0INV;
+
+		c = ((uint64_t)m * s_P256n[0] + t[0]) >> 32;
+		for (int j = 1; j < 8; j++)
+		{
+			c += (uint64_t)m * s_P256n[j] + t[j];
+			t[j - 1] = (uint32_t)c;
+			c >>= 32;
+		}
+		c += t[8];
+		t[7] = (uint32_t)c;
+		t[8] = t[9] + (uint32_t)(c >> 32);
+	}
+
+	if (t[8] || P256Cmp(t, s_P256n) >= 0)
+	{
+		P256SubRaw(t, t, s_P256n);
+	}
+	memcpy(r, t, 32);
+}
+
+/// r = a * b mod n
+static void P256nMul(uint32_t *r, const uint32_t *a, const uint32_t *b)
+{
+	uint32_t t[8];
+
+	P256nMontMul(t, a, b);
+	P256nMontMul(r, t, s_P256nR2);
+}
+
+/**
+ * @brief	Point doubling in place, a = -3 (dbl-2001-b).
+ */
+static void P256Double(P256_JPOINT *p)
+{
+	uint32_t delta[8], gamma[8], beta[8], alpha[8], t[8];
+
+	if (P256IsZero(p->Z))
+	{
+		return;
+	}
+
+	P256Sqr(delta, p->Z);
+	P256Sqr(gamma, p->Y);
+	P256Mul(beta, p->X, gamma);
+
+	// alpha = 3 * (X - delta) * (X + delta)
+	P256Sub(t, p->X, delta);
+	P256Add(alpha, p->X, delta);
+	P256Mul(alpha, t, alpha);
+	P256Add(t, alpha, alpha);
+	P256Add(alpha, t, alpha);
+
+	// Z3 = (Y + Z)^2 - gamma - delta
+	P256Add(t, p->Y, p->Z);
+	P256Sqr(t, t);
+	P256Sub(t, t, gamma);
+	P256Sub(p->Z, t, delta);
+
+	// X3 = alpha^2 - 8 * beta
+	P256Add(beta, beta, beta);
+	P256Add(beta, beta, beta);
+	P256Sqr(p->X, alpha);
+	P256Sub(p->X, p->X, beta);
+	P256Sub(p->X, p->X, beta);
+
+	// Y3 = alpha * (4 * beta - X3) - 8 * gamma^2
+	P256Sub(t, beta, p->X);
+	P256Mul(t, alpha, t);
+	P256Sqr(gamma, gamma);
+	P256Add(gamma, gamma, gamma);
+	P256Add(gamma, gamma, gamma);
+	P256Add(gamma, gamma, gamma);
+	P256Sub(p->Y, t, gamma);
+}
+
+/**
+ * @brief	Add affine point in place (madd-2004-hmv).
+ */
+static void P256AddAffine(P256_JPOINT *p, const uint32_t *x, const uint32_t *y)
+{
+	uint32_t z1z1[8], u2[8], s2[8], h[8], r[8], hh[8], hhh[8], v[8];
+
+	if (P256IsZero(p->Z))
+	{
+		memcpy(p->X, x, 32);
+		memcpy(p->Y, y, 32);
+		memset(p->Z, 0, 32);
+		p->Z[0] = 1;
+		return;
+	}
+
+	P256Sqr(z1z1, p->Z);
+	P256Mul(u2, x, z1z1);
+	P256Mul(s2, y, p->Z);
+	P256Mul(s2, s2, z1z1);
+	P256Sub(h, u2, p->X);
+	P256Sub(r, s2, p->Y);
+
+	if (P256IsZero(h))
+	{
+		if (P256IsZero(r))
+		{
+			// Same point
+			P256Double(p);
+		}
+		else
+		{
+			// Opposite points
+			memset(p->Z, 0, 32);
+		}
+		return;
+	}
+
+	P256Sqr(hh, h);
+	P256Mul(hhh, h, hh);
+	P256Mul(v, p->X, hh);
+	P256Mul(p->Z, p->Z, h);
+
+	// X3 = r^2 - H^3 - 2 * V
+	P256Sqr(p->X, r);
+	P256Sub(p->X, p->X, hhh);
+	P256Sub(p->X, p->X, v);
+	P256Sub(p->X, p->X, v);
+
+	// Y3 = r * (V - X3) - Y1 * H^3
+	P256Sub(v, v, p->X);
+	P256Mul(v, r, v);
+	P256Mul(hhh, p->Y, hhh);
+	P256Sub(p->Y, v, hhh);
+}
+
+/**
+ * @brief	Convert Jacobian points to affine in place, one inversion for all.
+ *
+ * Points are not at infinity. Affine x, y are returned in X, Y.
+ *
+ * @param	p		: Points
+ * @param	Cnt		: Number of points
+ * @param	c		: Scratch, Cnt field elements
+ */
+static void P256BatchAffine(P256_JPOINT *p, int Cnt, uint32_t (*c)[8])
+{
+	uint32_t inv[8], zi[8], zi2[8];
+
+	memcpy(c[0], p[0].Z, 32);
+	for (int i = 1; i < Cnt; i++)
+	{
+		P256Mul(c[i], c[i - 1], p[i].Z);
+	}
+
+	P256Inv(inv, c[Cnt - 1]);
+
+	for (int i = Cnt - 1; i >= 0; i--)
+	{
+		if (i > 0)
+		{
+			P256Mul(zi, inv, c[i - 1]);
+			P256Mul(inv, inv, p[i].Z);
+		}
+		else
+		{
+			memcpy(zi, inv, 32);
+		}
+		P256Sqr(zi2, zi);
+		P256Mul(p[i].X, p[i].X, zi2);
+		P256Mul(zi2, zi2, zi);
+		P256Mul(p[i].Y, p[i].Y, zi2);
+		memset(p[i].Z, 0, 32);
+		p[i].Z[0] = 1;
+	}
+}
+
+/// 32 bytes value to limbs
+static void P256FromBytes(uint32_t *r, const uint8_t *p)
+{
+	for (int i = 0; i < 8; i++)
+	{
+#if ECDSAP256_LITTLE_ENDIAN
+		const uint8_t *b = &p[i << 2];
+
+		r[i] = ((uint32_t)b[3] << 24) | ((uint32_t)b[2] << 16) | ((uint32_t)b[1] << 8) | b[0];
+#else
+		const uint8_t *b = &p[28 - (i << 2)];
+
+		r[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+#endif
+	}
+}
+
+/// Big endian hash to limbs, independent of ECDSAP256_LITTLE_ENDIAN
+static void P256FromDigest(uint32_t *r, const uint8_t *p)
+{
+	for (int i = 0; i < 8; i++)
+	{
+		const uint8_t *b = &p[28 - (i << 2)];
+
+		r[i] = ((uint32_t)b[0] << 24) | ((uint32_t)b[1] << 16) | ((uint32_t)b[2] << 8) | b[3];
+	}
+}
+
+/// Check y^2 = x^3 - 3x + b
+static bool P256OnCurve(const uint32_t *x, const uint32_t *y)
+{
+	uint32_t l[8], r[8], t[8];
+
+	if (P256Cmp(x, s_P256p) >= 0 || P256Cmp(y, s_P256p) >= 0)
+	{
+		return false;
+	}
+
+	P256Sqr(l, y);
+	P256Sqr(r, x);
+	P256Mul(r, r, x);
+	P256Add(t, x, x);
+	P256Add(t, t, x);
+	P256Sub(r, r, t);
+	P256Add(r, r, s_P256b);
+
+	return P256Equal(l, r);
+}
+
+/// Comb column index of scalar k, bits i, i + spacing, i + 2 * spacing...
+static inline int P256CombIdx(const uint32_t *k, int i)
+{
+	int idx = 0;
+
+	for (int j = 0; j < ECDSAP256_COMB_TEETH; j++, i += ECDSAP256_COMB_SPACING)
+	{
+		if (i < 256)
+		{
+			idx |= ((k[i >> 5] >> (i & 31)) & 1) << j;
+		}
+	}
+
+	return idx;
+}
+
+bool EcdsaP256CombInit(ECDSAP256_COMB *pComb, const uint8_t *pPubKey)
+{
+	P256_JPOINT j[ECDSAP256_COMB_SIZE];
+	P256_JPOINT base[ECDSAP256_COMB_TEETH];
+	uint32_t c[ECDSAP256_COMB_SIZE][8];
+
+	memset(&base[0], 0, sizeof(P256_JPOINT));
+	if (pPubKey != NULL)
+	{
+		P256FromBytes(base[0].X, pPubKey);
+		P256FromBytes(base[0].Y, &pPubKey[32]);
+		if (P256OnCurve(base[0].X, base[0].Y) == false)
+		{
+			return false;
+		}
+	}
+	else
+	{
+		memcpy(base[0].X, s_P256Gx, 32);
+		memcpy(base[0].Y, s_P256Gy, 32);
+	}
+	base[0].Z[0] = 1;
+
+	// Teeth 2^(i * spacing) * P, affine so combinations use mixed addition
+	for (int i = 1; i < ECDSAP256_COMB_TEETH; i++)
+	{
+		base[i] = base[i - 1];
+		for (int k = 0; k < ECDSAP256_COMB_SPACING; k++)
+		{
+			P256Double(&base[i]);
+		}
+	}
+	P256BatchAffine(base, ECDSAP256_COMB_TEETH, c);
+
+	for (int idx = 1; idx <= ECDSAP256_COMB_SIZE; idx++)
+	{
+		int lsb = idx & -idx;
+		int bit = 0;
+
+		while ((1 << bit) != lsb)
+		{
+			bit++;
+		}
+
+		if (idx == lsb)
+		{
+			j[idx - 1] = base[bit];
+		}
+		else
+		{
+			// Lower index holds the other teeth
+			j[idx - 1] = j[idx - lsb - 1];
+			P256AddAffine(&j[idx - 1], base[bit].X, base[bit].Y);
+		}
+	}
+	P256BatchAffine(j, ECDSAP256_COMB_SIZE, c);
+
+	for (int i = 0; i < ECDSAP256_COMB_SIZE; i++)
+	{
+		memcpy(pComb->Pt[i].x, j[i].X, 32);
+		memcpy(pComb->Pt[i].y, j[i].Y, 32);
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Compute u1, u2 from signature and hash. Returns false on r or s
+ * out of range.
+ */
+static bool EcdsaP256Scalars(const uint32_t *e, const uint32_t *r, const uint32_t *s, uint32_t *u1, uint32_t *u2)
+{
+	uint32_t w[8], em[8];
+
+	if (P256IsZero(r) || P256IsZero(s) || P256Cmp(r, s_P256n) >= 0 || P256Cmp(s, s_P256n) >= 0)
+	{
+		return false;
+	}
+
+	memcpy(em, e, 32);
+	if (P256Cmp(em, s_P256n) >= 0)
+	{
+		P256SubRaw(em, em, s_P256n);
+	}
+
+	P256ModInv(w, s, s_P256n);
+	P256nMul(u1, em, w);
+	P256nMul(u2, r, w);
+
+	return true;
+}
+
+/**
+ * @brief	Check x(R) mod n == r without converting R to affine.
+ */
+static bool EcdsaP256CheckR(P256_JPOINT *R, const uint32_t *r)
+{
+	uint32_t z2[8], t[8], rn[8];
+
+	if (P256IsZero(R->Z))
+	{
+		return false;
+	}
+
+	P256Sqr(z2, R->Z);
+	P256Mul(t, r, z2);
+	if (P256Equal(t, R->X))
+	{
+		return true;
+	}
+
+	// x(R) in [n, p) reduces to r too
+	if (P256AddRaw(rn, r, s_P256n) == 0 && P256Cmp(rn, s_P256p) < 0)
+	{
+		P256Mul(t, rn, z2);
+		return P256Equal(t, R->X);
+	}
+
+	return false;
+}
+
+static bool EcdsaP256VerifyDigest(const uint8_t *pPubKey, const ECDSAP256_COMB *pKeyComb,
+								  const uint32_t *e, const uint8_t *pSig)
+{
+	uint32_t r[8], s[8], u1[8], u2[8];
+	P256_JPOINT R;
+
+	P256FromBytes(r, pSig);
+	P256FromBytes(s, &pSig[32]);
+
+	if (EcdsaP256Scalars(e, r, s, u1, u2) == false)
+	{
+		return false;
+	}
+
+	memset(&R, 0, sizeof(R));
+
+	if (pKeyComb != NULL)
+	{
+		// Both terms by comb, shared doublings
+		for (int i = ECDSAP256_COMB_SPACING - 1; i >= 0; i--)
+		{
+			int ig = P256CombIdx(u1, i);
+			int iq = P256CombIdx(u2, i);
+
+			P256Double(&R);
+			if (ig)
+			{
+				P256AddAffine(&R, g_EcdsaP256GComb.Pt[ig - 1].x, g_EcdsaP256GComb.Pt[ig - 1].y);
+			}
+			if (iq)
+			{
+				P256AddAffine(&R, pKeyComb->Pt[iq - 1].x, pKeyComb->Pt[iq - 1].y);
+			}
+		}
+	}
+	else
+	{
+		// Shamir's trick, Q by 4 bits windows, G by comb in the last doublings
+		P256_JPOINT q[15];
+		uint32_t c[15][8];
+
+		P256FromBytes(q[0].X, pPubKey);
+		P256FromBytes(q[0].Y, &pPubKey[32]);
+		if (P256OnCurve(q[0].X, q[0].Y) == false)
+		{
+			return false;
+		}
+		memset(q[0].Z, 0, 32);
+		q[0].Z[0] = 1;
+		q[1] = q[0];
+		P256Double(&q[1]);
+		for (int i = 2; i < 15; i++)
+		{
+			q[i] = q[i - 1];
+			P256AddAffine(&q[i], q[0].X, q[0].Y);
+		}
+		P256BatchAffine(q, 15, c);
+
+		for (int i = 255; i >= 0; i--)
+		{
+			P256Double(&R);
+
+			if ((i & 3) == 0)
+			{
+				int d = (u2[i >> 5] >> (i & 31)) & 0xf;
+
+				if (d)
+				{
+					P256AddAffine(&R, q[d - 1].X, q[d - 1].Y);
+				}
+			}
+			if (i < ECDSAP256_COMB_SPACING)
+			{
+				int ig = P256CombIdx(u1, i);
+
+				if (ig)
+				{
+					P256AddAffine(&R, g_EcdsaP256GComb.Pt[ig - 1].x, g_EcdsaP256GComb.Pt[ig - 1].y);
+				}
+			}
+		}
+	}
+
+	return EcdsaP256CheckR(&R, r);
+}
+
+bool EcdsaP256Verify(const uint8_t *pPubKey, const uint8_t *pHash, const uint8_t *pSig)
+{
+	uint32_t e[8];
+
+	if (pPubKey == NULL || pHash == NULL || pSig == NULL)
+	{
+		return false;
+	}
+
+	P256FromBytes(e, pHash);
+
+	return EcdsaP256VerifyDigest(pPubKey, NULL, e, pSig);
+}
+
+bool EcdsaP256VerifyComb(const ECDSAP256_COMB *pKeyComb, const uint8_t *pHash, const uint8_t *pSig)
+{
+	uint32_t e[8];
+
+	if (pKeyComb == NULL || pHash == NULL || pSig == NULL)
+	{
+		return false;
+	}
+
+	P256FromBytes(e, pHash);
+
+	return EcdsaP256VerifyDigest(NULL, pKeyComb, e, pSig);
+}
+
+void EcdsaP256VerifyInit(ECDSAP256_VERIFY * const pCtx, const uint8_t *pPubKey, const ECDSAP256_COMB *pKeyComb)
+{
+	Sha256Init(&pCtx->Sha);
+	pCtx->pPubKey = pPubKey;
+	pCtx->pKeyComb = pKeyComb;
+}
+
+bool EcdsaP256VerifyFinal(ECDSAP256_VERIFY * const pCtx, const uint8_t *pSig)
+{
+	uint8_t d[SHA256_DIGEST_LEN];
+	uint32_t e[8];
+
+	Sha256Final(&pCtx->Sha, d);
+	P256FromDigest(e, d);
+
+	if (pSig == NULL || (pCtx->pPubKey == NULL && pCtx->pKeyComb == NULL))
+	{
+		return false;
+	}
+
+	return EcdsaP256VerifyDigest(pCtx->pPubKey, pCtx->pKeyComb, e, pSig);
+}
@@ -0,0 +1,291 @@
+/**-------------------------------------------------------------------------
+@file	ecdsa_p256_gcomb.c
+
+@brief	ECDSA P-256 generator comb table.
+
+Generated by Linux/exemples/EcdsaCombGen, do not edit.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include "ecdsa_p256.h"
+
+const ECDSAP256_COMB g_EcdsaP256GComb = { {
+	{
+		{ 0xd898c296, 0xf4a13945, 0x2deb33a0, 0x77037d81, 0x63a440f2, 0xf8bce6e5, 0xe12c4247, 0x6b17d1f2 },
+		{ 0x37bf51f5, 0xcbb64068, 0x6b315ece, 0x2bce3357, 0x7c0f9e16, 0x8ee7eb4a, 0xfe1a7f9b, 0x4fe342e2 }
+	},
+	{
+		{ 0xb049e7cd, 0xcd013f88, 0xe57fdc00, 0xe8f9257a, 0xfc3a9301, 0x3be71969, 0x58cff937, 0x987f256d },
+		{ 0x6efa35d6, 0xb7254bbc, 0x07aaffdb, 0x47b46052, 0x0007e39e, 0xe860ebd6, 0x94ec505c, 0x8e926956 }
+	},
+	{
+		{ 0x5a1c3fb1, 0x59db167c, 0xbf318eb2, 0x98b3ce2a, 0xd2bc2fa6, 0x2df1c41e, 0x6ed1b2af, 0xefcc2c43 },
+		{ 0x97b25513, 0x17fe07f1, 0x3734a589, 0x46824533, 0xed34f543, 0xa5384a77, 0x8d9f3863, 0xf3684f9c }
+	},
+	{
+		{ 0xbf780c2c, 0xfdc73e83, 0x2d666817, 0xffdc6794, 0x02436893, 0xc14b66dd, 0x0d54650c, 0x6eec9567 },
+		{ 0xedbfcd32, 0x089ec1a1, 0x3a07ff89, 0x79ab6615, 0x65ea0105, 0xfc281de0, 0x997732c2, 0x14bb5350 }
+	},
+	{
+		{ 0x7318188e, 0xaec90264, 0xca167099, 0x410bec28, 0x099c202b, 0xbf664d2f, 0x55fa625c, 0x13ccca34 },
+		{ 0x05421c0c, 0xaa84c231, 0x6cdb0d71, 0x6b647521, 0xfb216a5e, 0xe90446b1, 0xaf46893d, 0x4b5ba5a5 }
+	},
+	{
+		{ 0x4862c5db, 0xaca2fa08, 0xa1717f8a, 0xddffc222, 0xe4e09fd2, 0xab839a14, 0x980330f5, 0xf86a9078 },
+		{ 0xc1dd7dcc, 0x6890f24c, 0xea6efd98, 0xf75dccfa, 0xff9a093b, 0xba2612b8, 0x2568653c, 0x20347d0c }
+	},
+	{
+		{ 0xcbdb1c78, 0xd3b22809, 0x30f6cda4, 0x5591c8eb, 0xbfe80f8b, 0xb6e28740, 0x40e7e7e7, 0x0f74342a },
+		{ 0x351c51f2, 0xd2968e87, 0xf5e17b5e, 0x65c5c581, 0x9d994e2e, 0x6f58f02a, 0xf5c1ec07, 0x531c0b00 }
+	},
+	{
+		{ 0x1a6b665e, 0xeb042121, 0xa7f6803a, 0x802f779e, 0x3c0804c3, 0x47501f2a, 0x4945a1d4, 0xa263919b },
+		{ 0x30bcdcfb, 0x9ee40400, 0x4c00efe2, 0xac3f83df, 0xe60d60c5, 0x2e9d3c9d, 0x2aed20fc, 0x873200bd }
+	},
+	{
+		{ 0x8b21aa51, 0x2b52c47d, 0x5a7e870d, 0x0f503629, 0x88b45127, 0xbaa92814, 0xc402e050, 0x27d6451e },
+		{ 0x5567432d, 0x5c96ec14, 0x0f4150c7, 0xcdeb9829, 0xcdeef566, 0x5d91740c, 0x1be9e583, 0x2a58fa5e }
+	},
+	{
+		{ 0x5788c0f6, 0xd8142dff, 0x247fde25, 0x89bf5229, 0x14e2280f, 0x5c971ddb, 0x09904e3f, 0x785b7e91 },
+		{ 0x2e7e6f0b, 0x445e4519, 0x4ce293dd, 0x8789440e, 0xc797be30, 0x96b84f57, 0xfa3ea32d, 0x6b44059d }
+	},
+	{
+		{ 0x2195a979, 0x73b7c550, 0xb8dd5813, 0x2d7ed474, 0xe104e9ac, 0xc0b9ecd2, 0xa2bd0ed8, 0xdc90d975 },
+		{ 0x4dd6eb2e, 0x9fb55203, 0xc01dfde8, 0x50d554bb, 0xf0977a30, 0x4cfd3277, 0x815374c4, 0xc87ce232 }
+	},
+	{
+		{ 0xcf9a3ca9, 0xe4b541b6, 0x08b49b2f, 0x1c650587, 0xf552641e, 0xb95f91b3, 0x5c301277, 0xbddc23ac },
+		{ 0x04daba43, 0x519d0700, 0x8450cfa2, 0xc003dcc3, 0x4e48efde, 0x73a1c8f5, 0x5b04f761, 0x7d0ca942 }
+	},
+	{
+		{ 0x1703406d, 0xcb4dc35b, 0x75dac54c, 0x4fd3afc9, 0x29f02878, 0x112321eb, 0xad6b225f, 0xafb18d2f },
+		{ 0xf1776a67, 0xddf58273, 0xf6b96c2f, 0x96889755, 0x22208ffb, 0x31a8d663, 0xfcca4877, 0x5ed81c10 }
+	},
+	{
+		{ 0xe834a3c4, 0xff0e1f34, 0x1c4ab236, 0x0d59b6ae, 0x015a211b, 0x10eb194a, 0x3892ddc5, 0xed6e13e0 },
+		{ 0xfb3f678d, 0xac88df04, 0x544026a9, 0x6f0fbf44, 0x619cecba, 0xcde8cd7a, 0x80d9a8cc, 0x02f322e5 }
+	},
+	{
+		{ 0x336aaf40, 0x2dc61e1b, 0x4251f5b7, 0x897e87bd, 0x6511b370, 0x2fb32023, 0x2341f499, 0x460fa9cf },
+		{ 0xcbaf01a7, 0x03e63b79, 0x44157434, 0x937e123f, 0x809e4a1a, 0x9d59226e, 0x41775e62, 0x18d6f63a }
+	},
+	{
+		{ 0xa9aa52df, 0x3cd5f4e4, 0xb42a627f, 0x18c452b1, 0xd991ece6, 0x6dbc4189, 0x7f608bf7, 0x45a511c9 },
+		{ 0x125ec16c, 0x7b52bd12, 0xd22955ce, 0x5a919b27, 0xcb625ad2, 0x3fe3337f, 0x73ea9b6d, 0x73be0ec7 }
+	},
+	{
+		{ 0x016476ea, 0xc6e4b6d0, 0xd4ec2510, 0x71b9a7e5, 0xcbe490d2, 0x1975b71e, 0xb52acd25, 0xdf6b472f },
+		{ 0x784055eb, 0xf1738716, 0xb87d399e, 0xccc7b0b3, 0x1bb51119, 0x3c9a1337, 0xa88fd593, 0xb42639e1 }
+	},
+	{
+		{ 0xc219c20b, 0x86a38d54, 0xb50a4733, 0xafcdd2ca, 0x72096638, 0xf4cf8797, 0x24ce0e94, 0xd949caa2 },
+		{ 0x96f9ae13, 0x678664ae, 0xc984de46, 0x00ef5ba9, 0x8d549567, 0x622abc7f, 0x57db924d, 0x673ed500 }
+	},
+	{
+		{ 0x20b4d697, 0x41e94206, 0x29fa0df9, 0xa10fd0d9, 0x76022c38, 0xf11eb0a7, 0xa5621c63, 0xffcb7ddc },
+		{ 0x0927965a, 0x24e37b1b, 0xbd2c199e, 0x8d9fc102, 0x907f3f85, 0x862de75e, 0x5a9c778e, 0xd3985129 }
+	},
+	{
+		{ 0xb56bc451, 0x48d63748, 0xa939440a, 0x0544de81, 0x664ec19c, 0xda24eb0b, 0x41f42bf6, 0x4fb6e562 },
+		{ 0x66bb5d6b, 0x21b2c80e, 0xd25bd41b, 0xa4123924, 0xbce2d418, 0x6f95f5f2, 0x4d6d91d8, 0xa9232776 }
+	},
+	{
+		{ 0xf119b8cc, 0x546a08e7, 0x8afc696a, 0x03b7d523, 0x459f70b4, 0x0a896132, 0xa86a9116, 0x57a46257 },
+		{ 0xbb314c65, 0xfaa56fef, 0x74795c6d, 0xf4e61f40, 0x437850d6, 0x1a3c5652, 0x6621ec11, 0x7c4b127d }
+	},
+	{
+		{ 0xe83cfa35, 0x6dd25e26, 0x1ff3bddc, 0x61e44da0, 0x121733fa, 0xb7b67b02, 0xfcd798ca, 0x7c48f60d },
+		{ 0x090f5154, 0x244d234a, 0x8cae33bb, 0x93b7f2fb, 0x426d1516, 0x158bf2f6, 0xa801e86e, 0xa8a947a8 }
+	},
+	{
+		{ 0x56c8815e, 0xf41e0307, 0x7d37a2f1, 0xbaf647e3, 0xfefafbf5, 0x7791eb36, 0x35b7f606, 0x158262fb },
+		{ 0x32dce9e5, 0xf6c32255, 0x361b4780, 0x6c7cd4ce, 0x3f85288f, 0xe5be5e70, 0xc98e624a, 0x4c281aa3 }
+	},
+	{
+		{ 0x7fd58ae5, 0x9d7f749e, 0x37ea57a2, 0xc78ba263, 0x4f5ab5b7, 0xb5c05127, 0x5f2d643b, 0x6fd3f54d },
+		{ 0x2116b8ce, 0x3428e311, 0x71b28987, 0xc52d1d24, 0x8299421f, 0x87f70be9, 0x64f49798, 0x0a5fd098 }
+	},
+	{
+		{ 0x4d6a3def, 0x5b2911dd, 0xb96008f1, 0x4bedd07c, 0xe36e7d64, 0xee748a6f, 0x4bbf5cf4, 0xbfc49934 },
+		{ 0x8e74750f, 0x55c6f62d, 0x48919902, 0x22639f87, 0x958a248f, 0xfa01aa94, 0xed51aa40, 0x2743ae8a }
+	},
+	{
+		{ 0xe76ccbc0, 0x75ea69cb, 0xa762deb7, 0xc9736051, 0xaf2bff4c, 0xa720d4c6, 0xbe6d6dba, 0x8e4c7b10 },
+		{ 0x2f128433, 0xaf5c0efe, 0xa1fe85ec, 0x834cbf1f, 0x2685f018, 0xd321c5a6, 0x717a5340, 0xb5b09cf6 }
+	},
+	{
+		{ 0x86eb7815, 0x9cdda821, 0xce413265, 0x8c003612, 0x91b577f5, 0x8bce1fab, 0x488f730c, 0x0f3f29ff },
+		{ 0xe6960d55, 0xebb08063, 0xaecbf467, 0x1a9699e2, 0x4ce5761b, 0x6b1564a4, 0x81382996, 0x08f00ea5 }
+	},
+	{
+		{ 0x96bf8ea5, 0x6c10cdd2, 0xe8cd868f, 0xe28c488a, 0x46442d00, 0xba9226c3, 0xfa1f864b, 0x9125caed },
+		{ 0x2e21b4af, 0xf33bd66e, 0x68dbe58c, 0x12dc5537, 0xe5353044, 0xd9b85123, 0x07bc6b60, 0xf4925bde }
+	},
+	{
+		{ 0x70514a21, 0x0d17ff39, 0xdadd80ee, 0xd2a7b5ba, 0x8126c8c4, 0x941e33c3, 0x1d57c1de, 0xb9e156d0 },
+		{ 0xea8105ad, 0x220d500d, 0x0202f3ae, 0x6a2aa462, 0x3dc96356, 0x450056ab, 0x452142c3, 0x506ab6aa }
+	},
+	{
+		{ 0x1b20d599, 0xe0cb1029, 0x10a5fba0, 0x7b1ed83d, 0x04007713, 0x7d5fb32b, 0x79c82639, 0x93bab590 },
+		{ 0x49b97d9d, 0x977fa5a6, 0x3551254a, 0xa3592333, 0xa9f7a3eb, 0x8f277388, 0xe3026e2c, 0x36aba935 }
+	},
+	{
+		{ 0xc05131cd, 0xf197735b, 0x22beb567, 0x05650768, 0xf7f55b1f, 0xdbf2b189, 0x132c2614, 0xaa144c82 },
+		{ 0xb3822251, 0xf41cbe14, 0xffd0afbe, 0xb1ce72b2, 0x844743fa, 0x01a14d18, 0x923739b8, 0xc1d89fe3 }
+	},
+	{
+		{ 0x0b79847d, 0xf0f679f1, 0x6bb19be6, 0x3719a8b6, 0xdc7f43d5, 0x2ddb6c3d, 0xda0982e2, 0x2800043a },
+		{ 0x908d9eda, 0xfe5b0083, 0xb8513ae9, 0xa87058db, 0x84a4dc3b, 0xb6c07965, 0x67e82909, 0x0f991746 }
+	},
+	{
+		{ 0x5f3f5b80, 0x12416a5c, 0xda522422, 0x58e903db, 0x4291867e, 0x18cc80f1, 0x7a152c2b, 0xb2035cf8 },
+		{ 0x95c80ede, 0x71125691, 0xaf97c5b0, 0xbfe02568, 0x8a14e493, 0x603e1dc5, 0x749680de, 0xf12f359c }
+	},
+	{
+		{ 0x6aa2b49d, 0x1caab0ba, 0x6f7fc502, 0x6a75a768, 0x57ea120f, 0x6a5ea5a8, 0xdb6bdf96, 0x998cd5f9 },
+		{ 0x467184a9, 0xd2d7ba4c, 0x25c03723, 0xbe178e54, 0xbc389ef3, 0x6bfc1707, 0x7b7d9fb3, 0x3256a8a0 }
+	},
+	{
+		{ 0xfea77b0c, 0x40429d1b, 0x595e9a31, 0x4651a4dc, 0xe712693a, 0x8900aab1, 0x84bf612d, 0x90ea7767 },
+		{ 0x0d02f2b6, 0xbdd10425, 0xfb4d594f, 0xf5583bcc, 0x5ba7b6a1, 0x75754462, 0x101e86f4, 0xd1a321d3 }
+	},
+	{
+		{ 0x5ac0b3db, 0x7a2f10b2, 0xf0b98928, 0xe6deffa0, 0xe6b0b01a, 0xb4b2939b, 0x0a3f2ca8, 0xa03e1d52 },
+		{ 0x2cbead24, 0xfc779531, 0xd30fa3f9, 0xe8362908, 0xf23b00bb, 0x6f29d6f4, 0xebb82e0a, 0xea1ad22f }
+	},
+	{
+		{ 0xe62da069, 0x6890b26c, 0x7c586265, 0xa5702319, 0x865672ab, 0xe64e19bf, 0xa07d9893, 0xa66503f5 },
+		{ 0x21fe4743, 0xe4deb7c0, 0x7d7100be, 0x3bae847d, 0xe17b1d29, 0x1769fca7, 0x320afc60, 0xadba60ec }
+	},
+	{
+		{ 0x89806e19, 0x74814e1c, 0xf9ec85de, 0x9135fc8d, 0x09afd25b, 0x0ee660a6, 0x6740a284, 0x943de3b7 },
+		{ 0x622227d9, 0xdba0327f, 0xd4c486e8, 0xa524c6d6, 0x7134581a, 0x217fb779, 0xe4254a7e, 0xafa3b65f }
+	},
+	{
+		{ 0xc4e48158, 0xa3c9d614, 0xae8fc508, 0xb26b4a98, 0x38b68e18, 0x44ef8be0, 0xdb271fcd, 0xbe9cf596 },
+		{ 0x8e6f95ad, 0x737b653e, 0x9b9e4d0a, 0x73dbe6ff, 0xa4139f59, 0x4b772a8c, 0x66c67e8a, 0xa1f335e5 }
+	},
+	{
+		{ 0x2d00715b, 0x0abfa3ee, 0xc8297b47, 0xf3f65dc1, 0x00669e85, 0x4199b659, 0x23c09567, 0x7588df7f },
+		{ 0x868d3227, 0xabdf62fa, 0x8099a8fc, 0xa0844d34, 0x3babbc72, 0x3361b9c0, 0x6d5bf03b, 0xbb0357a4 }
+	},
+	{
+		{ 0xf77cf152, 0xc0b161fb, 0x8ce30043, 0x243c4fed, 0x050e20df, 0xb1b4a2d0, 0xc34999ae, 0x5a61a286 },
+		{ 0x70214eb7, 0x8c7baf68, 0xf2c261fe, 0x975bca7d, 0x1ed91ae8, 0x03c6df31, 0xa1380d38, 0xe8cfaaad }
+	},
+	{
+		{ 0x016f613c, 0xa6bcc84d, 0xc2ec4e56, 0xae5ce038, 0xf8be76b4, 0xad80f035, 0x84642dd4, 0x00456c5c },
+		{ 0xde3648c8, 0x0ef7079f, 0x68d0a170, 0x7bf0b3ab, 0x56c684e3, 0xa85c96b8, 0x91d65c88, 0xfd39b0f2 }
+	},
+	{
+		{ 0x966d28dd, 0xc79e3178, 0x89f8a2c1, 0x67ba8686, 0x4acf8d42, 0xaf1f9c6d, 0xe0847f7d, 0x2d2b4273 },
+		{ 0x69130cec, 0x1d9e1a90, 0x9383e7b5, 0x95cb10fd, 0x44cc71ae, 0x73438a26, 0x1ee4ea49, 0x37eaeb10 }
+	},
+	{
+		{ 0x620c767b, 0x2a675b54, 0x5ae6598e, 0xf1235f08, 0x48a35e9b, 0x3cf6a1cd, 0xd8a1b5f8, 0xf11a113e },
+		{ 0x1742a887, 0xa401985d, 0xb6a73d9b, 0x3f83bd07, 0x82736067, 0x3c7307a0, 0x1f12fbb6, 0x64a1a66d }
+	},
+	{
+		{ 0xd84a37de, 0x1c12b5cb, 0xc7b1ea1a, 0x56d66db4, 0x2ce31e9a, 0x852be420, 0xe40faf48, 0x17be9c2d },
+		{ 0x38cc8797, 0x735b3ccb, 0x34b1093e, 0x1f8d9d80, 0xe75b81c0, 0xd8cc6e86, 0x3fdbe697, 0x6914bf94 }
+	},
+	{
+		{ 0x0ccf3981, 0x422618c9, 0x8dab3936, 0x7f5f9610, 0x8e0a6a28, 0xca4ab750, 0xd5bab133, 0x8266e2fe },
+		{ 0xab5500f6, 0xfaa7545b, 0x5d994d86, 0xa91edaeb, 0x67fb462d, 0x0a5b194b, 0x287178ce, 0x089cfd68 }
+	},
+	{
+		{ 0x00b16f35, 0x54b44d33, 0x002d5707, 0x59988ef3, 0xd0494f94, 0x256fe1eb, 0x7f710de4, 0xaef84169 },
+		{ 0x8bd49604, 0xca38fb1f, 0xbfa0b15c, 0xaec9daae, 0x642cf6dd, 0x1551365e, 0x160e8fff, 0x75b8b0fa }
+	},
+	{
+		{ 0x01feea35, 0xb2466027, 0x317c61f1, 0xea17f580, 0x786aaceb, 0x8d71eaba, 0x1cc47dab, 0x7de7454a },
+		{ 0xff1b1266, 0x10b69d62, 0xb9ab079c, 0xe22cc59b, 0x42b2d441, 0x9a57e43f, 0xe8c85f85, 0x22340fec }
+	},
+	{
+		{ 0xedab9cb9, 0x6033d113, 0xe69d45ee, 0x1df87ba3, 0xe4d65a03, 0x93436236, 0x3f98a508, 0x5893f6f9 },
+		{ 0xaad54fab, 0xb3832e15, 0x6bc7365e, 0x3277ff0d, 0x200c4fb8, 0xe8301118, 0xd4e9384d, 0x26e471bc }
+	},
+	{
+		{ 0x68c28f39, 0x1c1dd91a, 0xf35669ca, 0xfa494334, 0x51abb743, 0x77b40abd, 0xe7873a25, 0xee7400ba },
+		{ 0xed2309d9, 0xf15d9bf5, 0x3da8785a, 0x8a90d13f, 0x1be8b67d, 0x7e4fb96c, 0xcae9ed81, 0x196c1ba4 }
+	},
+	{
+		{ 0xc52427d8, 0x3276c5a4, 0xf5a34b64, 0x66958243, 0xf36e0d92, 0x04166798, 0xc6e9e63f, 0x43e33927 },
+		{ 0xf0ca8d2b, 0x899aed76, 0x0af50dd8, 0x43b89cde, 0x5951e13b, 0x805ea21e, 0x28413043, 0xe210daa4 }
+	},
+	{
+		{ 0x98a174fc, 0xe17f627b, 0x4dfa285e, 0x5ebce1ff, 0x54c5f925, 0xc95fe23d, 0x3188ba78, 0x5ea59a09 },
+		{ 0x2d2d8163, 0x6615bb54, 0x5db03d95, 0x37be4a1e, 0x4fc47762, 0xc51b5692, 0xd142931d, 0xb994ca42 }
+	},
+	{
+		{ 0x0758035b, 0xce46a165, 0xe070a0c9, 0xb33df1ad, 0x686934c9, 0xbf01fb38, 0xf0f16ed0, 0x1cba6257 },
+		{ 0xee93409c, 0xe538a9b6, 0x4a6b38da, 0xd82429a1, 0xa5c215b1, 0x1488770d, 0x891d7658, 0x4ade1f8e }
+	},
+	{
+		{ 0x51a03105, 0xbf93cda8, 0x7be433ed, 0xb14f4a60, 0xfa1c97a1, 0x0aa4c4c3, 0xbced726e, 0xfe1a6375 },
+		{ 0x0409c304, 0x4db68287, 0xebf37af4, 0x08fb9622, 0xf6abdff4, 0x677003ec, 0x3fb7cc37, 0xe6b2e872 }
+	},
+	{
+		{ 0x27ade63f, 0xfe702b4b, 0xa105673a, 0x5df11a33, 0xa362b9ce, 0x0d33cb80, 0x855bb209, 0xa7bb42f5 },
+		{ 0xc95fe575, 0xfdcc6096, 0x2351dec6, 0xff0e08d7, 0xbb6a5b28, 0xa3323ff5, 0x89f7a2ab, 0x2caa2dae }
+	},
+	{
+		{ 0x51ff89bb, 0x252566b6, 0xdb973ddc, 0x453c333e, 0xd83f2cc2, 0xfbcd5a09, 0x3121dbd5, 0x187818ec },
+		{ 0x3b46b949, 0xaea1b45f, 0x55f753e0, 0x42314623, 0xb09991fa, 0xd59ab00b, 0x0ae0c8d7, 0xee05650d }
+	},
+	{
+		{ 0x2da7eb49, 0x2096d676, 0xfb775e41, 0x6e04768e, 0xaf24f76c, 0xc3349c3d, 0xde0c90f6, 0xe6db6cca },
+		{ 0xa416fd87, 0x98aa01f5, 0x781ec427, 0x84c3270b, 0x021034b2, 0x37680f04, 0x654bf735, 0xeb90fe3c }
+	},
+	{
+		{ 0xe4976dd8, 0xeaf7623c, 0xe29bd0b4, 0x92528b1a, 0x645cec2a, 0x78158ecd, 0xb11325e9, 0x3265ead8 },
+		{ 0xc04780b7, 0x1ca27af8, 0x2465867d, 0x14ef0845, 0x2feefe38, 0xb45c1887, 0x5d8730e9, 0x7c4d96bc }
+	},
+	{
+		{ 0xb3571976, 0x8e35bf16, 0x346864e7, 0xe2eb0c63, 0x7e9b6c7f, 0x2b7b57e0, 0x70b35a98, 0x3157cf6f },
+		{ 0x5ac49ea5, 0xfec24c14, 0x6b1a32ae, 0xc20c5690, 0x345fa335, 0xeaef7b4e, 0x4077475f, 0xb4c9655d }
+	},
+	{
+		{ 0x6c38b3da, 0x3c3d8c9b, 0x754433e3, 0x80818302, 0xe29e542a, 0xfe68ab07, 0xd12cbb2c, 0x81a25a61 },
+		{ 0x8f685647, 0x559948a7, 0x83a56574, 0xe14ebcf6, 0x7a77db0f, 0x1a606632, 0x0892ce93, 0xf49d838f }
+	},
+	{
+		{ 0xfcf866b9, 0xf3f4e3fe, 0xe18b0ad5, 0x152a0807, 0x1b9b2e7b, 0x2ec4c706, 0xdadd006f, 0x41d7e92b },
+		{ 0x1d4b6ef7, 0xff0a8a79, 0xb2aa2f47, 0x02344dff, 0x357a0681, 0x1726d704, 0xc1bc85f4, 0x4ce6bb77 }
+	},
+	{
+		{ 0x8916a00d, 0x651ebb86, 0x001e908d, 0xba4d2da9, 0x1684fcb0, 0x5f2b68e6, 0x10ac6edf, 0xc3ff8d75 },
+		{ 0xf5c49a61, 0x6997e3ea, 0xb1a4dc68, 0x8f4ff372, 0xc95c2db2, 0xbea7ce04, 0x9d10f761, 0x2accb4f4 }
+	},
+	{
+		{ 0xafcc2bef, 0xb9e437f4, 0x3ada2b53, 0x4f1fb2d6, 0xbb580c9a, 0xe6c0e12d, 0x33c7546d, 0x25183734 },
+		{ 0xbfd92fb9, 0xab12d90f, 0xa185ae46, 0x2cb9b9b3, 0x9ce6f49f, 0x2a0c7a7e, 0xb48f21f2, 0x531f307f }
+	},
+} };
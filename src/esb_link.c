@@ -0,0 +1,510 @@
+/**-------------------------------------------------------------------------
+@file	esb_link.c
+
+@brief	Reliable packet link over ESB implementation.
+
+See esb_link.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "esb_link.h"
+
+static inline uint8_t *EsbLinkTxSlot(ESBLINK * const pLink, uint8_t Seq)
+{
+	return &pLink->pTxMem[(Seq & pLink->WinMask) * pLink->SlotSize];
+}
+
+static inline uint8_t *EsbLinkRxSlot(ESBLINK * const pLink, uint8_t Seq)
+{
+	return &pLink->pRxMem[(Seq & pLink->WinMask) * pLink->SlotSize];
+}
+
+static inline uint16_t EsbLinkBit(ESBLINK * const pLink, uint8_t Seq)
+{
+	return 1 << (Seq & pLink->WinMask);
+}
+
+/**
+ * @brief	Check if data frame is still queued in radio.
+ */
+static bool EsbLinkInRadio(ESBLINK * const pLink, uint8_t Seq)
+{
+	for (int i = 0; i < pLink->RadioQue; i++)
+	{
+		if (pLink->RadioSeq[(pLink->RadioHead + i) % ESBLINK_RADIOQUE_MAX] == Seq)
+		{
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/**
+ * @brief	Fill frame header with current receive state.
+ */
+static void EsbLinkSetHdr(ESBLINK * const pLink, uint8_t *pFrame, uint8_t Flags, uint8_t Seq)
+{
+	uint16_t sack = 0;
+
+	for (int i = 0; i < pLink->Window - 1; i++)
+	{
+		if (pLink->RxValid & EsbLinkBit(pLink, pLink->RxBase + 1 + i))
+		{
+			sack |= 1 << i;
+		}
+	}
+
+	if (pLink->TxEnd != pLink->TxNext)
+	{
+		Flags |= ESBLINK_FLAG_MORE;
+	}
+
+	pFrame[0] = Flags;
+	pFrame[1] = Seq;
+	pFrame[2] = pLink->RxBase;
+	pFrame[3] = sack & 0xFF;
+	pFrame[4] = sack >> 8;
+}
+
+/**
+ * @brief	Hand one frame to the radio.
+ *
+ * @param	Seq	: Data frame sequence number, -1 for ACK only frame
+ *
+ * @return	true - radio took it
+ */
+static bool EsbLinkSendFrame(ESBLINK * const pLink, int Seq, uint32_t Now)
+{
+	uint8_t ackfrm[ESBLINK_HDR_LEN];
+	uint8_t *frm = ackfrm;
+	int len = ESBLINK_HDR_LEN;
+
+	if (Seq >= 0)
+	{
+		frm = EsbLinkTxSlot(pLink, Seq);
+		len += pLink->TxLen[Seq & pLink->WinMask];
+		EsbLinkSetHdr(pLink, frm, ESBLINK_FLAG_DATA | (pLink->bPack ? ESBLINK_FLAG_PACKED : 0), Seq);
+	}
+	else
+	{
+		EsbLinkSetHdr(pLink, frm, 0, 0);
+	}
+
+	if (pLink->SendCB(pLink->pCtx, frm, len) == false)
+	{
+		return false;
+	}
+
+	pLink->RadioSeq[(pLink->RadioHead + pLink->RadioQue) % ESBLINK_RADIOQUE_MAX] = Seq;
+	pLink->RadioQue++;
+	pLink->bAckPending = false;
+
+	if (Seq >= 0)
+	{
+		pLink->TxTime[Seq & pLink->WinMask] = Now;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Deliver messages of one frame.
+ */
+static void EsbLinkDeliver(ESBLINK * const pLink, const uint8_t *pData, int Len, bool bPacked)
+{
+	if (bPacked == false)
+	{
+		pLink->RxMsgCnt++;
+		pLink->RecvCB(pLink->pCtx, pData, Len);
+
+		return;
+	}
+
+	while (Len > 0)
+	{
+		int l = pData[0];
+
+		if (l + 1 > Len)
+		{
+			break;
+		}
+		pLink->RxMsgCnt++;
+		pLink->RecvCB(pLink->pCtx, pData + 1, l);
+		pData += l + 1;
+		Len -= l + 1;
+	}
+}
+
+/**
+ * @brief	Process peer cumulative & selective ACK.
+ */
+static void EsbLinkAck(ESBLINK * const pLink, uint8_t Ack, uint16_t Sack)
+{
+	uint8_t inflight = pLink->TxNext - pLink->TxBase;
+	uint8_t acked = Ack - pLink->TxBase;
+
+	if (acked > inflight)
+	{
+		// Stale or invalid
+		return;
+	}
+
+	while (pLink->TxBase != Ack)
+	{
+		uint16_t b = EsbLinkBit(pLink, pLink->TxBase);
+
+		pLink->TxAcked &= ~b;
+		pLink->TxRtx &= ~b;
+		pLink->TxFast &= ~b;
+		pLink->TxBase++;
+	}
+
+	inflight = pLink->TxNext - pLink->TxBase;
+
+	int high = -1;
+
+	for (int i = 0; i < pLink->Window - 1 && i + 1 < inflight; i++)
+	{
+		if (Sack & (1 << i))
+		{
+			pLink->TxAcked |= EsbLinkBit(pLink, Ack + 1 + i);
+			high = i + 1;
+		}
+	}
+
+	// Frames before a selectively acknowledged one were lost, radio
+	// queue is in order
+	for (int i = 0; i < high; i++)
+	{
+		uint16_t b = EsbLinkBit(pLink, Ack + i);
+
+		if ((pLink->TxAcked & b) == 0 && (pLink->TxFast & b) == 0)
+		{
+			pLink->TxRtx |= b;
+			pLink->TxFast |= b;
+		}
+	}
+}
+
+bool EsbLinkInit(ESBLINK * const pLink, const ESBLINK_CFG * const pCfg)
+{
+	if (pLink == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->SendCB == NULL || pCfg->RecvCB == NULL)
+	{
+		return false;
+	}
+
+	if (pCfg->Window < 1 || pCfg->Window > ESBLINK_WINDOW_MAX || (pCfg->Window & (pCfg->Window - 1)) != 0)
+	{
+		return false;
+	}
+
+	if (pCfg->MaxPayload <= ESBLINK_HDR_LEN + 1 || pCfg->MaxPayload > ESBLINK_PAYLOAD_MAX ||
+		pCfg->MemSize < (uint32_t)ESBLINK_MEMSIZE(pCfg->Window, pCfg->MaxPayload))
+	{
+		return false;
+	}
+
+	memset(pLink, 0, sizeof(ESBLINK));
+
+	pLink->SlotSize = ESBLINK_SLOT_SIZE(pCfg->MaxPayload);
+	pLink->pTxMem = pCfg->pMem;
+	pLink->pRxMem = pCfg->pMem + pCfg->Window * pLink->SlotSize;
+	pLink->Window = pCfg->Window;
+	pLink->WinMask = pCfg->Window - 1;
+	pLink->MaxPayload = pCfg->MaxPayload;
+	pLink->RadioQueMax = pCfg->RadioQueMax < 1 ? 1 :
+						 pCfg->RadioQueMax > ESBLINK_RADIOQUE_MAX ? ESBLINK_RADIOQUE_MAX : pCfg->RadioQueMax;
+	pLink->Rto = pCfg->Rto;
+	pLink->bPack = pCfg->bPack;
+	pLink->bPoll = pCfg->bPoll;
+	pLink->SendCB = pCfg->SendCB;
+	pLink->RecvCB = pCfg->RecvCB;
+	pLink->pCtx = pCfg->pCtx;
+
+	return true;
+}
+
+bool EsbLinkWrite(ESBLINK * const pLink, const uint8_t *pData, int Len, uint32_t Now)
+{
+	int maxdata = pLink->MaxPayload - ESBLINK_HDR_LEN;
+
+	if (Len <= 0 || Len > EsbLinkMsgMax(pLink))
+	{
+		return false;
+	}
+
+	if (pLink->bPack)
+	{
+		if (pLink->bTxOpen)
+		{
+			uint8_t seq = pLink->TxEnd - 1;
+			uint16_t *txlen = &pLink->TxLen[seq & pLink->WinMask];
+
+			if (*txlen + 1 + Len <= maxdata)
+			{
+				uint8_t *p = EsbLinkTxSlot(pLink, seq) + ESBLINK_HDR_LEN + *txlen;
+
+				p[0] = Len;
+				memcpy(p + 1, pData, Len);
+				*txlen += Len + 1;
+				pLink->TxMsgCnt++;
+				EsbLinkProcess(pLink, Now);
+
+				return true;
+			}
+			pLink->bTxOpen = false;
+		}
+
+		if ((uint8_t)(pLink->TxEnd - pLink->TxBase) >= pLink->Window)
+		{
+			return false;
+		}
+
+		uint8_t *p = EsbLinkTxSlot(pLink, pLink->TxEnd) + ESBLINK_HDR_LEN;
+
+		p[0] = Len;
+		memcpy(p + 1, pData, Len);
+		pLink->TxLen[pLink->TxEnd & pLink->WinMask] = Len + 1;
+		pLink->bTxOpen = true;
+	}
+	else
+	{
+		if ((uint8_t)(pLink->TxEnd - pLink->TxBase) >= pLink->Window)
+		{
+			return false;
+		}
+
+		memcpy(EsbLinkTxSlot(pLink, pLink->TxEnd) + ESBLINK_HDR_LEN, pData, Len);
+		pLink->TxLen[pLink->TxEnd & pLink->WinMask] = Len;
+	}
+
+	pLink->TxEnd++;
+	pLink->TxMsgCnt++;
+	EsbLinkProcess(pLink, Now);
+
+	return true;
+}
+
+bool EsbLinkRecv(ESBLINK * const pLink, const uint8_t *pFrame, int Len, uint32_t Now)
+{
+	if (pFrame == NULL || Len < ESBLINK_HDR_LEN || Len > pLink->MaxPayload)
+	{
+		return false;
+	}
+
+	uint8_t flags = pFrame[0];
+
+	pLink->RxFrameCnt++;
+	EsbLinkAck(pLink, pFrame[2], pFrame[3] | (pFrame[4] << 8));
+	pLink->bPeerMore = (flags & ESBLINK_FLAG_MORE) != 0;
+
+	if (flags & ESBLINK_FLAG_DATA)
+	{
+		uint8_t seq = pFrame[1];
+		uint8_t d = seq - pLink->RxBase;
+		bool bpacked = (flags & ESBLINK_FLAG_PACKED) != 0;
+		const uint8_t *data = pFrame + ESBLINK_HDR_LEN;
+		int dlen = Len - ESBLINK_HDR_LEN;
+
+		// Always acknowledge, duplicates mean our ACK was lost
+		pLink->bAckPending = true;
+
+		if (d == 0)
+		{
+			// In order, deliver from frame then drain reorder slots
+			EsbLinkDeliver(pLink, data, dlen, bpacked);
+			pLink->RxBase++;
+
+			while (pLink->RxValid & EsbLinkBit(pLink, pLink->RxBase))
+			{
+				uint16_t l = pLink->RxLen[pLink->RxBase & pLink->WinMask];
+
+				pLink->RxValid &= ~EsbLinkBit(pLink, pLink->RxBase);
+				EsbLinkDeliver(pLink, EsbLinkRxSlot(pLink, pLink->RxBase), l & 0x7FFF, (l & 0x8000) != 0);
+				pLink->RxBase++;
+			}
+		}
+		else if (d < pLink->Window)
+		{
+			if (pLink->RxValid & EsbLinkBit(pLink, seq))
+			{
+				pLink->DupCnt++;
+			}
+			else
+			{
+				memcpy(EsbLinkRxSlot(pLink, seq), data, dlen);
+				pLink->RxLen[seq & pLink->WinMask] = dlen | (bpacked ? 0x8000 : 0);
+				pLink->RxValid |= EsbLinkBit(pLink, seq);
+			}
+		}
+		else
+		{
+			// Already delivered, or beyond window
+			pLink->DupCnt++;
+		}
+	}
+
+	EsbLinkProcess(pLink, Now);
+
+	return true;
+}
+
+void EsbLinkTxDone(ESBLINK * const pLink, bool bSent, uint32_t Now)
+{
+	if (pLink->RadioQue == 0)
+	{
+		return;
+	}
+
+	int seq = pLink->RadioSeq[pLink->RadioHead];
+
+	pLink->RadioHead = (pLink->RadioHead + 1) % ESBLINK_RADIOQUE_MAX;
+	pLink->RadioQue--;
+
+	if (bSent)
+	{
+		if (seq >= 0)
+		{
+			// Retransmit timer starts when the frame leaves the radio
+			pLink->TxTime[seq & pLink->WinMask] = Now;
+		}
+	}
+	else
+	{
+		if (seq >= 0 && (uint8_t)(seq - pLink->TxBase) < (uint8_t)(pLink->TxNext - pLink->TxBase))
+		{
+			pLink->TxRtx |= EsbLinkBit(pLink, seq);
+		}
+		else if (seq < 0)
+		{
+			pLink->bAckPending = true;
+		}
+	}
+
+	EsbLinkProcess(pLink, Now);
+}
+
+void EsbLinkRadioFlush(ESBLINK * const pLink)
+{
+	while (pLink->RadioQue > 0)
+	{
+		int seq = pLink->RadioSeq[pLink->RadioHead];
+
+		if (seq >= 0 && (uint8_t)(seq - pLink->TxBase) < (uint8_t)(pLink->TxNext - pLink->TxBase))
+		{
+			pLink->TxRtx |= EsbLinkBit(pLink, seq);
+		}
+		pLink->RadioHead = (pLink->RadioHead + 1) % ESBLINK_RADIOQUE_MAX;
+		pLink->RadioQue--;
+	}
+}
+
+void EsbLinkProcess(ESBLINK * const pLink, uint32_t Now)
+{
+	bool bsent = false;
+
+	while (pLink->RadioQue < pLink->RadioQueMax)
+	{
+		int seq = -1;
+
+		// Retransmit first, oldest first
+		for (uint8_t s = pLink->TxBase; s != pLink->TxNext; s++)
+		{
+			uint16_t b = EsbLinkBit(pLink, s);
+
+			if (pLink->TxAcked & b)
+			{
+				continue;
+			}
+			if (pLink->TxRtx & b)
+			{
+				seq = s;
+				break;
+			}
+			if (Now - pLink->TxTime[s & pLink->WinMask] >= pLink->Rto && EsbLinkInRadio(pLink, s) == false)
+			{
+				pLink->TxFast &= ~b;
+				seq = s;
+				break;
+			}
+		}
+
+		if (seq >= 0)
+		{
+			if (EsbLinkSendFrame(pLink, seq, Now) == false)
+			{
+				break;
+			}
+			pLink->TxRtx &= ~EsbLinkBit(pLink, seq);
+			pLink->RtxCnt++;
+			bsent = true;
+			continue;
+		}
+
+		if (pLink->TxNext == pLink->TxEnd)
+		{
+			break;
+		}
+
+		if (pLink->bTxOpen && (uint8_t)(pLink->TxNext + 1) == pLink->TxEnd)
+		{
+			// Frame still filling, keep packing while the radio is busy
+			if (pLink->RadioQue > 0)
+			{
+				break;
+			}
+			pLink->bTxOpen = false;
+		}
+
+		seq = pLink->TxNext++;
+		if (EsbLinkSendFrame(pLink, seq, Now) == false)
+		{
+			pLink->TxNext--;
+			break;
+		}
+		pLink->TxFrameCnt++;
+		bsent = true;
+	}
+
+	if (bsent == false && pLink->RadioQue == 0)
+	{
+		bool bpoll = pLink->bPoll && (pLink->TxNext != pLink->TxBase || pLink->bPeerMore);
+
+		if (pLink->bAckPending || bpoll)
+		{
+			if (EsbLinkSendFrame(pLink, -1, Now))
+			{
+				pLink->AckFrameCnt++;
+			}
+		}
+	}
+}
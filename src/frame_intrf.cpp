@@ -0,0 +1,778 @@
+/**-------------------------------------------------------------------------
+@file	frame_intrf.cpp
+
+@brief	Reliable framed transport device interface implementation.
+
+See frame_intrf.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "crc.h"
+#include "frame_intrf.h"
+
+#define FRAMEINTRF_CRC16_SEED		0xFFFF
+
+static inline uint8_t *FrameIntrfTxSlot(FRAMEINTRF_DEV * const pDev, uint8_t Seq)
+{
+	return &pDev->pTxMem[(Seq & pDev->WinMask) * pDev->SlotSize];
+}
+
+static inline uint8_t *FrameIntrfRxSlot(FRAMEINTRF_DEV * const pDev, uint8_t Seq)
+{
+	return &pDev->pRxMem[(Seq & pDev->WinMask) * pDev->SlotSize];
+}
+
+static inline uint16_t FrameIntrfBit(FRAMEINTRF_DEV * const pDev, uint8_t Seq)
+{
+	return 1 << (Seq & pDev->WinMask);
+}
+
+/**
+ * @brief	Frames the receiver can take from RxBase.
+ */
+static inline uint8_t FrameIntrfRxWin(FRAMEINTRF_DEV * const pDev)
+{
+	return (uint8_t)(pDev->RxRead + pDev->Window - pDev->RxBase);
+}
+
+/**
+ * @brief	Build frame into pTxOut.
+ *
+ * @param	Flags	: FRAMEINTRF_FLAG_xxx
+ * @param	Seq		: Data frame sequence number, ignored without FRAMEINTRF_FLAG_DATA
+ */
+static void FrameIntrfBuild(FRAMEINTRF_DEV * const pDev, uint8_t Flags, uint8_t Seq)
+{
+	uint8_t *p = pDev->pTxOut;
+	uint16_t sack = 0;
+	uint16_t len = 0;
+
+	for (int i = 0; i < pDev->Window - 1; i++)
+	{
+		if (pDev->RxValid & FrameIntrfBit(pDev, pDev->RxBase + 1 + i))
+		{
+			sack |= 1 << i;
+		}
+	}
+
+	if (Flags & FRAMEINTRF_FLAG_DATA)
+	{
+		len = pDev->TxLen[Seq & pDev->WinMask];
+	}
+	else
+	{
+		Seq = 0;
+	}
+
+	pDev->LastWin = FrameIntrfRxWin(pDev);
+
+	p[0] = FRAMEINTRF_SOF;
+	p[1] = Flags;
+	p[2] = Seq;
+	p[3] = pDev->RxBase;
+	p[4] = pDev->LastWin;
+	p[5] = sack & 0xFF;
+	p[6] = sack >> 8;
+	p[7] = len & 0xFF;
+	p[8] = len >> 8;
+	p[9] = crc8_ccitt(&p[1], FRAMEINTRF_HDR_LEN - 2, 0);
+
+	pDev->TxOutLen = FRAMEINTRF_HDR_LEN;
+
+	if (len > 0)
+	{
+		uint8_t *d = &p[FRAMEINTRF_HDR_LEN];
+
+		memcpy(d, FrameIntrfTxSlot(pDev, Seq), len);
+
+		uint16_t crc = crc16_ccitt(d, len, FRAMEINTRF_CRC16_SEED);
+
+		d[len] = crc & 0xFF;
+		d[len + 1] = crc >> 8;
+		pDev->TxOutLen += len + FRAMEINTRF_CRC_LEN;
+	}
+
+	pDev->TxOutIdx = 0;
+	pDev->bAckPending = false;
+}
+
+/**
+ * @brief	Write frames to physical interface until it stops taking data.
+ */
+static void FrameIntrfSend(FRAMEINTRF_DEV * const pDev)
+{
+	DEVINTRF *phy = pDev->pPhyIntrf;
+
+	while (true)
+	{
+		if (pDev->TxOutIdx < pDev->TxOutLen)
+		{
+			int l = phy->TxData(phy, &pDev->pTxOut[pDev->TxOutIdx], pDev->TxOutLen - pDev->TxOutIdx);
+
+			if (l <= 0)
+			{
+				return;
+			}
+			pDev->TxOutIdx += l;
+			continue;
+		}
+
+		int seq = -1;
+
+		// Retransmit first, oldest first
+		for (uint8_t s = pDev->TxBase; s != pDev->TxNext; s++)
+		{
+			uint16_t b = FrameIntrfBit(pDev, s);
+
+			if (pDev->TxAcked & b)
+			{
+				continue;
+			}
+			if (pDev->TxRtx & b)
+			{
+				seq = s;
+				break;
+			}
+			if (pDev->CurTime - pDev->TxTime[s & pDev->WinMask] >= pDev->CurRto)
+			{
+				pDev->TxFast &= ~b;
+				seq = s;
+				break;
+			}
+		}
+
+		if (seq >= 0)
+		{
+			pDev->TxRtx &= ~FrameIntrfBit(pDev, seq);
+			pDev->TxRtxd |= FrameIntrfBit(pDev, seq);
+			pDev->Stat.RtxCnt++;
+		}
+		else if (pDev->TxNext != pDev->TxEnd && (uint8_t)(pDev->TxNext - pDev->TxBase) < pDev->PeerWin)
+		{
+			seq = pDev->TxNext++;
+			pDev->TxRtxd &= ~FrameIntrfBit(pDev, seq);
+			pDev->Stat.TxFrameCnt++;
+		}
+
+		if (seq >= 0)
+		{
+			pDev->TxTime[seq & pDev->WinMask] = pDev->CurTime;
+			FrameIntrfBuild(pDev, FRAMEINTRF_FLAG_DATA, seq);
+			continue;
+		}
+
+		if (pDev->TxNext != pDev->TxEnd && pDev->CurTime - pDev->PollTime >= pDev->CurRto)
+		{
+			// Peer window closed, window update may have been lost
+			pDev->PollTime = pDev->CurTime;
+			pDev->Stat.AckFrameCnt++;
+			FrameIntrfBuild(pDev, FRAMEINTRF_FLAG_POLL, 0);
+			continue;
+		}
+
+		if (pDev->bAckPending)
+		{
+			pDev->Stat.AckFrameCnt++;
+			FrameIntrfBuild(pDev, 0, 0);
+			continue;
+		}
+
+		return;
+	}
+}
+
+/**
+ * @brief	Process peer cumulative & selective ACK.
+ */
+static void FrameIntrfAck(FRAMEINTRF_DEV * const pDev, uint8_t Ack, uint16_t Sack)
+{
+	uint8_t inflight = pDev->TxNext - pDev->TxBase;
+
+	if ((uint8_t)(Ack - pDev->TxBase) > inflight)
+	{
+		// Stale or invalid
+		return;
+	}
+
+	int32_t rtt = -1;
+
+	while (pDev->TxBase != Ack)
+	{
+		uint16_t b = FrameIntrfBit(pDev, pDev->TxBase);
+
+		if (((pDev->TxRtxd | pDev->TxAcked) & b) == 0)
+		{
+			// Only frames sent once and acknowledged now give a valid sample
+			rtt = pDev->CurTime - pDev->TxTime[pDev->TxBase & pDev->WinMask];
+		}
+		pDev->TxAcked &= ~b;
+		pDev->TxRtx &= ~b;
+		pDev->TxFast &= ~b;
+		pDev->TxBase++;
+	}
+
+	inflight = pDev->TxNext - pDev->TxBase;
+
+	int high = -1;
+
+	for (int i = 0; i < pDev->Window - 1 && i + 1 < inflight; i++)
+	{
+		if (Sack & (1 << i))
+		{
+			uint16_t b = FrameIntrfBit(pDev, Ack + 1 + i);
+
+			if (((pDev->TxRtxd | pDev->TxAcked) & b) == 0)
+			{
+				rtt = pDev->CurTime - pDev->TxTime[(Ack + 1 + i) & pDev->WinMask];
+			}
+			pDev->TxAcked |= b;
+			high = i + 1;
+		}
+	}
+
+	if (rtt >= 0)
+	{
+		if (pDev->Srtt == 0)
+		{
+			// Non zero marks first sample taken
+			pDev->Srtt = rtt + 1;
+			pDev->RttVar = rtt >> 1;
+		}
+		else
+		{
+			int32_t d = (int32_t)pDev->Srtt - rtt;
+
+			pDev->RttVar = (3 * pDev->RttVar + (d < 0 ? -d : d)) >> 2;
+			pDev->Srtt = (7 * pDev->Srtt + rtt) >> 3;
+		}
+
+		uint32_t rto = pDev->Srtt + 4 * pDev->RttVar;
+
+		pDev->CurRto = rto > pDev->Rto ? rto : pDev->Rto;
+	}
+
+	// Frames before a selectively acknowledged one were lost
+	for (int i = 0; i < high; i++)
+	{
+		uint16_t b = FrameIntrfBit(pDev, Ack + i);
+
+		if ((pDev->TxAcked & b) == 0 && (pDev->TxFast & b) == 0)
+		{
+			pDev->TxRtx |= b;
+			pDev->TxFast |= b;
+		}
+	}
+}
+
+/**
+ * @brief	Process one valid frame.
+ */
+static void FrameIntrfRxFrame(FRAMEINTRF_DEV * const pDev, const uint8_t *pFrame)
+{
+	uint8_t flags = pFrame[1];
+	uint16_t len = pFrame[7] | (pFrame[8] << 8);
+
+	pDev->Stat.RxFrameCnt++;
+
+	if ((uint8_t)(pFrame[3] - pDev->TxBase) <= (uint8_t)(pDev->TxNext - pDev->TxBase))
+	{
+		FrameIntrfAck(pDev, pFrame[3], pFrame[5] | (pFrame[6] << 8));
+		pDev->PeerWin = pFrame[4] < pDev->Window ? pFrame[4] : pDev->Window;
+	}
+
+	if (flags & FRAMEINTRF_FLAG_POLL)
+	{
+		pDev->bAckPending = true;
+	}
+
+	if ((flags & FRAMEINTRF_FLAG_DATA) == 0)
+	{
+		return;
+	}
+
+	uint8_t seq = pFrame[2];
+
+	// Always acknowledge, duplicates mean our ACK was lost
+	pDev->bAckPending = true;
+
+	if ((uint8_t)(seq - pDev->RxBase) >= FrameIntrfRxWin(pDev) || (pDev->RxValid & FrameIntrfBit(pDev, seq)))
+	{
+		pDev->Stat.DupCnt++;
+		return;
+	}
+
+	memcpy(FrameIntrfRxSlot(pDev, seq), &pFrame[FRAMEINTRF_HDR_LEN], len);
+	pDev->RxLen[seq & pDev->WinMask] = len;
+	pDev->RxValid |= FrameIntrfBit(pDev, seq);
+
+	// Frames in order become readable
+	while (pDev->RxValid & FrameIntrfBit(pDev, pDev->RxBase))
+	{
+		pDev->RxValid &= ~FrameIntrfBit(pDev, pDev->RxBase);
+		pDev->RxBase++;
+	}
+}
+
+/**
+ * @brief	Validate frame at start of pRxAsm.
+ *
+ * @return	Frame length, 0 more data needed, -1 invalid
+ */
+static int FrameIntrfCheck(FRAMEINTRF_DEV * const pDev)
+{
+	uint8_t *p = pDev->pRxAsm;
+
+	if (pDev->RxAsmLen < FRAMEINTRF_HDR_LEN)
+	{
+		return 0;
+	}
+
+	if (crc8_ccitt(&p[1], FRAMEINTRF_HDR_LEN - 2, 0) != p[9])
+	{
+		return -1;
+	}
+
+	int len = p[7] | (p[8] << 8);
+
+	if (len > pDev->MaxPayload)
+	{
+		return -1;
+	}
+
+	int flen = FRAMEINTRF_HDR_LEN + (len > 0 ? len + FRAMEINTRF_CRC_LEN : 0);
+
+	if (pDev->RxAsmLen < flen)
+	{
+		return 0;
+	}
+
+	if (len > 0)
+	{
+		uint16_t crc = p[FRAMEINTRF_HDR_LEN + len] | (p[FRAMEINTRF_HDR_LEN + len + 1] << 8);
+
+		if (crc16_ccitt(&p[FRAMEINTRF_HDR_LEN], len, FRAMEINTRF_CRC16_SEED) != crc)
+		{
+			return -1;
+		}
+	}
+
+	return flen;
+}
+
+/**
+ * @brief	Remove Len bytes from start of pRxAsm.
+ */
+static void FrameIntrfAsmSkip(FRAMEINTRF_DEV * const pDev, int Len)
+{
+	pDev->RxAsmLen -= Len;
+	if (pDev->RxAsmLen > 0)
+	{
+		memmove(pDev->pRxAsm, &pDev->pRxAsm[Len], pDev->RxAsmLen);
+	}
+}
+
+/**
+ * @brief	Read physical interface and process all complete frames.
+ */
+static void FrameIntrfRecv(FRAMEINTRF_DEV * const pDev)
+{
+	DEVINTRF *phy = pDev->pPhyIntrf;
+	int asmsize = FRAMEINTRF_FRAME_MAX(pDev->MaxPayload);
+
+	if (pDev->bPacket)
+	{
+		while (true)
+		{
+			pDev->RxAsmLen = 0;
+
+			int l = phy->RxData(phy, pDev->pRxAsm, asmsize);
+
+			if (l <= 0)
+			{
+				break;
+			}
+			pDev->RxAsmLen = l;
+
+			if (pDev->pRxAsm[0] == FRAMEINTRF_SOF && FrameIntrfCheck(pDev) == l)
+			{
+				FrameIntrfRxFrame(pDev, pDev->pRxAsm);
+			}
+			else
+			{
+				pDev->Stat.CrcErrCnt++;
+			}
+		}
+		pDev->RxAsmLen = 0;
+
+		return;
+	}
+
+	while (true)
+	{
+		int l = phy->RxData(phy, &pDev->pRxAsm[pDev->RxAsmLen], asmsize - pDev->RxAsmLen);
+
+		if (l <= 0)
+		{
+			break;
+		}
+		pDev->RxAsmLen += l;
+
+		while (pDev->RxAsmLen > 0)
+		{
+			if (pDev->pRxAsm[0] != FRAMEINTRF_SOF)
+			{
+				// Hunt for start of frame
+				uint8_t *p = (uint8_t*)memchr(pDev->pRxAsm, FRAMEINTRF_SOF, pDev->RxAsmLen);
+				int skip = p ? p - pDev->pRxAsm : pDev->RxAsmLen;
+
+				pDev->Stat.SkipCnt += skip;
+				FrameIntrfAsmSkip(pDev, skip);
+				continue;
+			}
+
+			int flen = FrameIntrfCheck(pDev);
+
+			if (flen == 0)
+			{
+				break;
+			}
+
+			if (flen < 0)
+			{
+				// False start or corrupted, resync after this SOF
+				pDev->Stat.CrcErrCnt++;
+				FrameIntrfAsmSkip(pDev, 1);
+				continue;
+			}
+
+			FrameIntrfRxFrame(pDev, pDev->pRxAsm);
+			FrameIntrfAsmSkip(pDev, flen);
+		}
+	}
+}
+
+void FrameIntrfDisable(DEVINTRF * const pDevIntrf)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	dev->pPhyIntrf->Disable(dev->pPhyIntrf);
+}
+
+void FrameIntrfEnable(DEVINTRF * const pDevIntrf)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	dev->pPhyIntrf->Enable(dev->pPhyIntrf);
+}
+
+int FrameIntrfGetRate(DEVINTRF * const pDevIntrf)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	return dev->pPhyIntrf->GetRate(dev->pPhyIntrf);
+}
+
+int FrameIntrfSetRate(DEVINTRF * const pDevIntrf, int Rate)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	return dev->pPhyIntrf->SetRate(dev->pPhyIntrf, Rate);
+}
+
+bool FrameIntrfStartRx(DEVINTRF * const pDevIntrf, int DevAddr)
+{
+	return true;
+}
+
+/**
+ * @brief	Read received data in order.
+ *
+ * Non blocking, returns what is available.
+ *
+ * @param	pDevIntrf : Pointer to an instance of the Device Interface
+ * @param	pBuff 	  : Pointer to memory area to receive data.
+ * @param	BuffLen   : Length of buffer memory in bytes
+ *
+ * @return	Number of bytes read
+ */
+int FrameIntrfRxData(DEVINTRF * const pDevIntrf, uint8_t *pBuff, int BuffLen)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+	int cnt = 0;
+
+	FrameIntrfRecv(dev);
+
+	while (BuffLen > 0 && dev->RxRead != dev->RxBase)
+	{
+		uint16_t flen = dev->RxLen[dev->RxRead & dev->WinMask];
+		int l = flen - dev->RxReadOff;
+
+		l = l < BuffLen ? l : BuffLen;
+		memcpy(pBuff, FrameIntrfRxSlot(dev, dev->RxRead) + dev->RxReadOff, l);
+		pBuff += l;
+		BuffLen -= l;
+		cnt += l;
+		dev->RxReadOff += l;
+
+		if (dev->RxReadOff >= flen)
+		{
+			dev->RxRead++;
+			dev->RxReadOff = 0;
+		}
+	}
+
+	// Reopen peer window once it grew enough, or was closed
+	if (dev->LastWin == 0 || FrameIntrfRxWin(dev) >= dev->LastWin + (dev->Window >> 1))
+	{
+		if (FrameIntrfRxWin(dev) != dev->LastWin)
+		{
+			dev->bAckPending = true;
+		}
+	}
+
+	FrameIntrfSend(dev);
+
+	return cnt;
+}
+
+void FrameIntrfStopRx(DEVINTRF * const pDevIntrf)
+{
+}
+
+bool FrameIntrfStartTx(DEVINTRF * const pDevIntrf, int DevAddr)
+{
+	return true;
+}
+
+/**
+ * @brief	Queue data for reliable transmission and send what can be sent.
+ *
+ * Data is appended to the last frame if not yet sent, then to new frames.
+ *
+ * @param	pDevIntrf : Pointer to an instance of the Device Interface
+ * @param	pData 	: Pointer to memory area of data to send.
+ * @param	DataLen : Length of data memory in bytes
+ *
+ * @return	Number of bytes queued. Less than DataLen when window is full
+ */
+int FrameIntrfTxData(DEVINTRF * const pDevIntrf, uint8_t *pData, int DataLen)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+	int cnt = 0;
+
+	while (DataLen > 0)
+	{
+		if (dev->TxNext != dev->TxEnd)
+		{
+			// Last frame not sent yet, fill it up
+			uint8_t seq = dev->TxEnd - 1;
+			uint16_t *txlen = &dev->TxLen[seq & dev->WinMask];
+			int l = dev->MaxPayload - *txlen;
+
+			if (l > 0)
+			{
+				l = l < DataLen ? l : DataLen;
+				memcpy(FrameIntrfTxSlot(dev, seq) + *txlen, pData, l);
+				*txlen += l;
+				pData += l;
+				DataLen -= l;
+				cnt += l;
+				continue;
+			}
+		}
+
+		if ((uint8_t)(dev->TxEnd - dev->TxBase) >= dev->Window)
+		{
+			break;
+		}
+
+		dev->TxLen[dev->TxEnd & dev->WinMask] = 0;
+		dev->TxEnd++;
+	}
+
+	FrameIntrfSend(dev);
+
+	return cnt;
+}
+
+void FrameIntrfStopTx(DEVINTRF * const pDevIntrf)
+{
+}
+
+/**
+ * @brief	Discard all link state, counters are kept.
+ *
+ * @param	pDev : Pointer to instance data
+ */
+static void FrameIntrfResetState(FRAMEINTRF_DEV * const pDev)
+{
+	pDev->TxBase = pDev->TxNext = pDev->TxEnd = 0;
+	pDev->PeerWin = pDev->Window;
+	memset(pDev->TxLen, 0, sizeof(pDev->TxLen));
+	memset(pDev->TxTime, 0, sizeof(pDev->TxTime));
+	pDev->TxAcked = pDev->TxRtx = pDev->TxFast = pDev->TxRtxd = 0;
+	pDev->CurRto = pDev->Rto;
+	pDev->Srtt = pDev->RttVar = 0;
+	pDev->PollTime = 0;
+	pDev->TxOutLen = pDev->TxOutIdx = 0;
+	pDev->RxRead = pDev->RxBase = 0;
+	pDev->RxReadOff = 0;
+	pDev->RxValid = 0;
+	memset(pDev->RxLen, 0, sizeof(pDev->RxLen));
+	pDev->RxAsmLen = 0;
+	pDev->LastWin = pDev->Window;
+	pDev->bAckPending = false;
+}
+
+/**
+ * @brief	Reset physical interface and discard all link state.
+ *
+ * Both ends must be reset together.
+ *
+ * @param	pDevIntrf : Pointer to an instance of the Device Interface
+ */
+void FrameIntrfReset(DEVINTRF * const pDevIntrf)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	dev->pPhyIntrf->Reset(dev->pPhyIntrf);
+
+	FrameIntrfResetState(dev);
+}
+
+void FrameIntrfPowerOff(DEVINTRF * const pDevIntrf)
+{
+	FRAMEINTRF_DEV *dev = (FRAMEINTRF_DEV *)pDevIntrf->pDevData;
+
+	dev->pPhyIntrf->PowerOff(dev->pPhyIntrf);
+}
+
+void FrameIntrfProcess(FRAMEINTRF_DEV * const pDev, uint32_t CurTime)
+{
+	pDev->CurTime = CurTime;
+
+	FrameIntrfRecv(pDev);
+	FrameIntrfSend(pDev);
+}
+
+int FrameIntrfTxPending(FRAMEINTRF_DEV * const pDev)
+{
+	int cnt = 0;
+
+	for (uint8_t s = pDev->TxBase; s != pDev->TxEnd; s++)
+	{
+		cnt += pDev->TxLen[s & pDev->WinMask];
+	}
+
+	return cnt;
+}
+
+int FrameIntrfRxAvail(FRAMEINTRF_DEV * const pDev)
+{
+	int cnt = -pDev->RxReadOff;
+
+	for (uint8_t s = pDev->RxRead; s != pDev->RxBase; s++)
+	{
+		cnt += pDev->RxLen[s & pDev->WinMask];
+	}
+
+	return cnt;
+}
+
+bool FrameIntrfInit(FRAMEINTRF_DEV * const pDev, DEVINTRF * const pPhyIntrf, const FRAMEINTRF_CFG * const pCfg)
+{
+	if (pDev == nullptr || pPhyIntrf == nullptr || pCfg == nullptr || pCfg->pMem == nullptr)
+	{
+		return false;
+	}
+
+	if (pCfg->Window < 1 || pCfg->Window > FRAMEINTRF_WINDOW_MAX || (pCfg->Window & (pCfg->Window - 1)) != 0)
+	{
+		return false;
+	}
+
+	if (pCfg->MaxPayload <= 0 || pCfg->MaxPayload > FRAMEINTRF_PAYLOAD_MAX ||
+		pCfg->MemSize < (uint32_t)FRAMEINTRF_MEMSIZE(pCfg->Window, pCfg->MaxPayload))
+	{
+		return false;
+	}
+
+	int slotsize = FRAMEINTRF_SLOT_SIZE(pCfg->MaxPayload);
+	int framesize = (FRAMEINTRF_FRAME_MAX(pCfg->MaxPayload) + 3) & ~3;
+
+	pDev->pPhyIntrf = pPhyIntrf;
+	pDev->SlotSize = slotsize;
+	pDev->pTxMem = pCfg->pMem;
+	pDev->pRxMem = pDev->pTxMem + pCfg->Window * slotsize;
+	pDev->pTxOut = pDev->pRxMem + pCfg->Window * slotsize;
+	pDev->pRxAsm = pDev->pTxOut + framesize;
+	pDev->MaxPayload = pCfg->MaxPayload;
+	pDev->Window = pCfg->Window;
+	pDev->WinMask = pCfg->Window - 1;
+	pDev->bPacket = pCfg->bPacket;
+	pDev->Rto = pCfg->Rto;
+	pDev->CurTime = 0;
+	FrameIntrfResetState(pDev);
+	memset(&pDev->Stat, 0, sizeof(pDev->Stat));
+
+	pDev->DevIntrf.pDevData = pDev;
+	pDev->DevIntrf.Type = pPhyIntrf->Type;
+	pDev->DevIntrf.Disable = FrameIntrfDisable;
+	pDev->DevIntrf.Enable = FrameIntrfEnable;
+	pDev->DevIntrf.GetRate = FrameIntrfGetRate;
+	pDev->DevIntrf.SetRate = FrameIntrfSetRate;
+	pDev->DevIntrf.StartRx = FrameIntrfStartRx;
+	pDev->DevIntrf.RxData = FrameIntrfRxData;
+	pDev->DevIntrf.StopRx = FrameIntrfStopRx;
+	pDev->DevIntrf.StartTx = FrameIntrfStartTx;
+	pDev->DevIntrf.TxData = FrameIntrfTxData;
+	pDev->DevIntrf.StopTx = FrameIntrfStopTx;
+	pDev->DevIntrf.Reset = FrameIntrfReset;
+	pDev->DevIntrf.PowerOff = FrameIntrfPowerOff;
+	pDev->DevIntrf.IntPrio = 0;
+	pDev->DevIntrf.EvtCB = nullptr;
+	pDev->DevIntrf.MaxRetry = 0;
+	pDev->DevIntrf.bDma = false;
+	pDev->DevIntrf.EnCnt = 1;
+	atomic_flag_clear(&pDev->DevIntrf.bBusy);
+
+	return true;
+}
+
+bool FrameIntrf::Init(DeviceIntrf * const pIntrf, const FRAMEINTRF_CFG &Cfg)
+{
+	if (pIntrf == nullptr)
+	{
+		return false;
+	}
+
+	return FrameIntrfInit(&vDevData, *pIntrf, &Cfg);
+}
@@ -31,9 +31,152 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Modified by          Date              Description
 
 ----------------------------------------------------------------------------*/
-#include "convutil.h"
+#include <string.h>
+
 #include "intelhex.h"
 
+#if !defined(IHEX_NO_SIMD) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define IHEX_SSSE3
+#include <tmmintrin.h>
+#endif
+
+// Hex character to nibble, 0xFF for non hex characters
+static const uint8_t s_IHexNibble[256] = {
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+	0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
+#ifdef IHEX_SSSE3
+
+/**
+ * SSSE3 hex decode, 32 characters to 16 bytes per step.
+ *
+ * @return	Number of characters decoded, stops at first block with a non
+ * 			hex character
+ */
+__attribute__((target("ssse3")))
+static int IHexDecodeSsse3(const char *pSrc, int Len, uint8_t *pDest)
+{
+	int i = 0;
+
+	for (; i + 32 <= Len; i += 32)
+	{
+		__m128i v[2];
+
+		for (int k = 0; k < 2; k++)
+		{
+			__m128i c = _mm_loadu_si128((const __m128i *)&pSrc[i + k * 16]);
+			__m128i lc = _mm_or_si128(c, _mm_set1_epi8(0x20));
+			__m128i dig = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('9' + 1), c));
+			__m128i alp = _mm_and_si128(_mm_cmpgt_epi8(lc, _mm_set1_epi8('a' - 1)), _mm_cmpgt_epi8(_mm_set1_epi8('f' + 1), lc));
+
+			if (_mm_movemask_epi8(_mm_or_si128(dig, alp)) != 0xffff)
+			{
+				return i;
+			}
+
+			v[k] = _mm_or_si128(_mm_and_si128(dig, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+								_mm_and_si128(alp, _mm_sub_epi8(lc, _mm_set1_epi8('a' - 10))));
+
+			// High nibble * 16 + low nibble
+			v[k] = _mm_maddubs_epi16(v[k], _mm_set1_epi16(0x0110));
+		}
+		_mm_storeu_si128((__m128i *)&pDest[i >> 1], _mm_packus_epi16(v[0], v[1]));
+	}
+
+	return i;
+}
+
+#endif	// IHEX_SSSE3
+
+/**
+ * @brief	Decode hex characters to binary.
+ *
+ * @param	pSrc	: Hex characters
+ * @param	Len		: Number of characters, even
+ * @param	pDest	: Len / 2 bytes
+ *
+ * @return	false on non hex character
+ */
+static bool IHexDecode(const char *pSrc, int Len, uint8_t *pDest)
+{
+	int i = 0;
+
+#ifdef IHEX_SSSE3
+	if (Len >= 32 && __builtin_cpu_supports("ssse3"))
+	{
+		i = IHexDecodeSsse3(pSrc, Len, pDest);
+	}
+#endif
+
+	uint8_t err = 0;
+
+	// No branch in loop, error bits accumulated
+	for (; i < Len; i += 2)
+	{
+		uint8_t h = s_IHexNibble[(uint8_t)pSrc[i]];
+		uint8_t l = s_IHexNibble[(uint8_t)pSrc[i + 1]];
+
+		err |= h | l;
+		pDest[i >> 1] = (h << 4) | l;
+	}
+
+	return (err & 0xF0) == 0;
+}
+
+/**
+ * @brief	Decode and validate one record.
+ *
+ * @param	pRec	: Characters following ':'
+ * @param	Len		: Number of characters, line ending removed
+ * @param	pBin	: Binary record, Count, Offset, Type, Data, Checksum
+ */
+static IHEX_ERR IHexDecodeRecord(const char *pRec, int Len, uint8_t *pBin)
+{
+	if (Len & 1)
+	{
+		return IHEX_ERR_FORMAT;
+	}
+	if (Len < 10 || Len > IHEX_LINE_MAX - 1)
+	{
+		return IHEX_ERR_LENGTH;
+	}
+	if (IHexDecode(pRec, Len, pBin) == false)
+	{
+		return IHEX_ERR_FORMAT;
+	}
+
+	int n = Len >> 1;
+
+	if (pBin[0] + 5 != n)
+	{
+		return IHEX_ERR_LENGTH;
+	}
+
+	uint8_t cs = 0;
+
+	for (int i = 0; i < n; i++)
+	{
+		cs += pBin[i];
+	}
+
+	return cs == 0 ? IHEX_ERR_NONE : IHEX_ERR_CHECKSUM;
+}
+
 /*
  * Parse Intel Hex record (one line)
  *
@@ -51,30 +194,377 @@ bool IHexParseRecord(char *pRec, IHEXDATA *pData)
 	if (pRec[0] != ':')
 		return false;
 
-	char *p = pRec + 1;
-	int8_t cs = 0;
-	
-	pData->Count = (chex2i(*p++) << 4);
-	pData->Count += chex2i(*p++);
-	pData->Offset = (chex2i(*p++) << 12);
-	pData->Offset += (chex2i(*p++) << 8);
-	pData->Offset += (chex2i(*p++) << 4);
-	pData->Offset += chex2i(*p++);
-	pData->Type = (chex2i(*p++) << 4);
-	pData->Type += chex2i(*p++);
-	
-	cs += pData->Count + (pData->Offset & 0xff) + ((pData->Offset >> 8u) & 0xff) + pData->Type;
-	
-	for (int i = 0; i < pData->Count; i++)
+	uint8_t bin[5 + IHEX_MAX_RECSIZE];
+
+	if (IHexDecode(&pRec[1], 2, bin) == false || bin[0] > IHEX_MAX_RECSIZE)
+		return false;
+
+	// Record length is known from count, line ending does not matter.
+	// Characters are checked before the end of the string is reached.
+	for (int i = 3; i < 11 + bin[0] * 2; i++)
 	{
-		pData->Data[i] = (chex2i(*p++) << 4);
-		pData->Data[i] += chex2i(*p++);
-		cs += pData->Data[i];
+		if (pRec[i] == '\0')
+			return false;
 	}
-	
-	pData->Checksum = (chex2i(*p++) << 4);
-	pData->Checksum += chex2i(*p++);
-	cs += pData->Checksum;
-	
-	return cs == 0;
+
+	if (IHexDecodeRecord(&pRec[1], 10 + bin[0] * 2, bin) != IHEX_ERR_NONE)
+		return false;
+
+	pData->Count = bin[0];
+	pData->Offset = ((int)bin[1] << 8) | bin[2];
+	pData->Type = bin[3];
+	memcpy(pData->Data, &bin[4], pData->Count);
+	pData->Checksum = bin[4 + pData->Count];
+
+	return true;
+}
+
+void IHexParserInit(IHEXPARSER * const pParser, IHexDataCb_t DataCB, void *pCtx)
+{
+	pParser->DataCB = DataCB;
+	pParser->pCtx = pCtx;
+	pParser->BaseAddr = 0;
+	pParser->bSegAddr = false;
+	pParser->bEof = false;
+	pParser->bStartValid = false;
+	pParser->StartAddr = 0;
+	pParser->LineNo = 0;
+	pParser->RecCnt = 0;
+	pParser->ByteCnt = 0;
+	pParser->Err = IHEX_ERR_NONE;
+	pParser->LineLen = 0;
+}
+
+/**
+ * @brief	Process one line, line ending excluded.
+ */
+static IHEX_ERR IHexParseLine(IHEXPARSER * const pParser, const char *pLine, int Len)
+{
+	uint8_t bin[5 + 255];
+
+	pParser->LineNo++;
+
+	// Strip CR and trailing spaces
+	while (Len > 0 && (pLine[Len - 1] == '\r' || pLine[Len - 1] == ' ' || pLine[Len - 1] == '\t'))
+	{
+		Len--;
+	}
+
+	if (Len == 0 || pParser->bEof)
+	{
+		return IHEX_ERR_NONE;
+	}
+
+	if (pLine[0] != ':')
+	{
+		return IHEX_ERR_FORMAT;
+	}
+
+	IHEX_ERR err = IHexDecodeRecord(&pLine[1], Len - 1, bin);
+
+	if (err != IHEX_ERR_NONE)
+	{
+		return err;
+	}
+
+	int cnt = bin[0];
+	uint32_t offset = ((uint32_t)bin[1] << 8) | bin[2];
+
+	switch (bin[3])
+	{
+		case IHEX_RECTYPE_DATA:
+			{
+				// Offset wraps within 64KB segment, split data crossing it
+				int l = offset + cnt > 0x10000 ? (int)(0x10000 - offset) : cnt;
+				uint32_t base = pParser->BaseAddr;
+
+				if (pParser->DataCB == NULL)
+				{
+					// Validation only
+				}
+				else if (l > 0 && pParser->DataCB(pParser->pCtx, base + offset, &bin[4], l) == false)
+				{
+					return IHEX_ERR_WRITE;
+				}
+				else if (l < cnt && pParser->DataCB(pParser->pCtx, base, &bin[4 + l], cnt - l) == false)
+				{
+					return IHEX_ERR_WRITE;
+				}
+				pParser->RecCnt++;
+				pParser->ByteCnt += cnt;
+			}
+			break;
+		case IHEX_RECTYPE_EOF:
+			if (cnt != 0)
+			{
+				return IHEX_ERR_RECORD;
+			}
+			pParser->bEof = true;
+			break;
+		case IHEX_RECTYPE_EXTSEG:
+			if (cnt != 2)
+			{
+				return IHEX_ERR_RECORD;
+			}
+			pParser->BaseAddr = (((uint32_t)bin[4] << 8) | bin[5]) << 4;
+			pParser->bSegAddr = true;
+			break;
+		case IHEX_RECTYPE_STARTSEG:
+			if (cnt != 4)
+			{
+				return IHEX_ERR_RECORD;
+			}
+			pParser->StartAddr = ((((uint32_t)bin[4] << 8) | bin[5]) << 4) + (((uint32_t)bin[6] << 8) | bin[7]);
+			pParser->bStartValid = true;
+			break;
+		case IHEX_RECTYPE_EXTLADDR:
+			if (cnt != 2)
+			{
+				return IHEX_ERR_RECORD;
+			}
+			pParser->BaseAddr = (((uint32_t)bin[4] << 8) | bin[5]) << 16;
+			pParser->bSegAddr = false;
+			break;
+		case IHEX_RECTYPE_STARTLADDR:
+			if (cnt != 4)
+			{
+				return IHEX_ERR_RECORD;
+			}
+			pParser->StartAddr = ((uint32_t)bin[4] << 24) | ((uint32_t)bin[5] << 16) | ((uint32_t)bin[6] << 8) | bin[7];
+			pParser->bStartValid = true;
+			break;
+		default:
+			return IHEX_ERR_RECORD;
+	}
+
+	return IHEX_ERR_NONE;
+}
+
+IHEX_ERR IHexParse(IHEXPARSER * const pParser, const char *pBuf, int Len)
+{
+	while (Len > 0 && pParser->Err == IHEX_ERR_NONE)
+	{
+		const char *eol = (const char *)memchr(pBuf, '\n', Len);
+		int l = eol != NULL ? eol - pBuf : Len;
+
+		if (pParser->LineLen > 0 || eol == NULL)
+		{
+			// Line split across chunks
+			if (pParser->LineLen + l > (int)sizeof(pParser->Line))
+			{
+				pParser->LineNo++;
+				pParser->Err = IHEX_ERR_LENGTH;
+				break;
+			}
+			memcpy(&pParser->Line[pParser->LineLen], pBuf, l);
+			pParser->LineLen += l;
+
+			if (eol == NULL)
+			{
+				break;
+			}
+			pParser->Err = IHexParseLine(pParser, pParser->Line, pParser->LineLen);
+			pParser->LineLen = 0;
+		}
+		else
+		{
+			pParser->Err = IHexParseLine(pParser, pBuf, l);
+		}
+
+		pBuf += l + 1;
+		Len -= l + 1;
+	}
+
+	return pParser->Err;
+}
+
+IHEX_ERR IHexParserFinish(IHEXPARSER * const pParser)
+{
+	if (pParser->Err == IHEX_ERR_NONE && pParser->LineLen > 0)
+	{
+		pParser->Err = IHexParseLine(pParser, pParser->Line, pParser->LineLen);
+		pParser->LineLen = 0;
+	}
+
+	if (pParser->Err == IHEX_ERR_NONE && pParser->bEof == false)
+	{
+		pParser->Err = IHEX_ERR_NOEOF;
+	}
+
+	return pParser->Err;
+}
+
+bool IHexImageInit(IHEXIMAGE * const pImg, uint8_t *pMem, uint32_t MemSize, uint32_t PageSize, uint8_t Fill)
+{
+	if (pImg == NULL || pMem == NULL || PageSize < 16 || (PageSize & (PageSize - 1)))
+	{
+		return false;
+	}
+
+	pImg->NbPageMax = MemSize / (PageSize + sizeof(IHEXPAGE));
+
+	if (pImg->NbPageMax < 1)
+	{
+		return false;
+	}
+
+	pImg->PageSize = PageSize;
+	pImg->Fill = Fill;
+	pImg->NbPage = 0;
+	pImg->LastIdx = 0;
+	pImg->pPage = (IHEXPAGE *)pMem;
+	pImg->pData = &pMem[pImg->NbPageMax * sizeof(IHEXPAGE)];
+	pImg->ByteCnt = 0;
+
+	return true;
+}
+
+/**
+ * @brief	Find page table index of page address.
+ *
+ * @return	Index of page or where it would be inserted
+ */
+static int IHexImageFind(IHEXIMAGE * const pImg, uint32_t PageAddr)
+{
+	int lo = 0, hi = pImg->NbPage;
+
+	// Sequential data goes to the last page or a new one after it
+	if (hi > 0 && pImg->pPage[hi - 1].Addr < PageAddr)
+	{
+		return hi;
+	}
+
+	while (lo < hi)
+	{
+		int mid = (lo + hi) >> 1;
+
+		if (pImg->pPage[mid].Addr < PageAddr)
+		{
+			lo = mid + 1;
+		}
+		else
+		{
+			hi = mid;
+		}
+	}
+
+	return lo;
+}
+
+static inline uint8_t *IHexImageSlot(IHEXIMAGE * const pImg, int Idx)
+{
+	return &pImg->pData[pImg->pPage[Idx].Slot * pImg->PageSize];
+}
+
+bool IHexImageWrite(IHEXIMAGE * const pImg, uint32_t Addr, const uint8_t *pData, int Len)
+{
+	while (Len > 0)
+	{
+		uint32_t paddr = Addr & ~(pImg->PageSize - 1);
+		uint32_t off = Addr - paddr;
+		int idx = pImg->LastIdx;
+
+		if (idx >= pImg->NbPage || pImg->pPage[idx].Addr != paddr)
+		{
+			idx = IHexImageFind(pImg, paddr);
+
+			if (idx >= pImg->NbPage || pImg->pPage[idx].Addr != paddr)
+			{
+				if (pImg->NbPage >= pImg->NbPageMax)
+				{
+					return false;
+				}
+
+				memmove(&pImg->pPage[idx + 1], &pImg->pPage[idx], (pImg->NbPage - idx) * sizeof(IHEXPAGE));
+				pImg->pPage[idx].Addr = paddr;
+				pImg->pPage[idx].Slot = pImg->NbPage;
+				pImg->NbPage++;
+				memset(IHexImageSlot(pImg, idx), pImg->Fill, pImg->PageSize);
+			}
+			pImg->LastIdx = idx;
+		}
+
+		int l = pImg->PageSize - off;
+
+		l = l < Len ? l : Len;
+		memcpy(IHexImageSlot(pImg, idx) + off, pData, l);
+		pImg->ByteCnt += l;
+		Addr += l;
+		pData += l;
+		Len -= l;
+	}
+
+	return true;
+}
+
+void IHexImageRead(IHEXIMAGE * const pImg, uint32_t Addr, uint8_t *pBuf, uint32_t Len)
+{
+	int idx = IHexImageFind(pImg, Addr & ~(pImg->PageSize - 1));
+
+	while (Len > 0)
+	{
+		uint32_t paddr = Addr & ~(pImg->PageSize - 1);
+		uint32_t off = Addr - paddr;
+		uint32_t l = pImg->PageSize - off;
+
+		l = l < Len ? l : Len;
+
+		// Pages are sorted, walk forward
+		while (idx < pImg->NbPage && pImg->pPage[idx].Addr < paddr)
+		{
+			idx++;
+		}
+
+		if (idx < pImg->NbPage && pImg->pPage[idx].Addr == paddr)
+		{
+			memcpy(pBuf, IHexImageSlot(pImg, idx) + off, l);
+		}
+		else
+		{
+			memset(pBuf, pImg->Fill, l);
+		}
+		Addr += l;
+		pBuf += l;
+		Len -= l;
+	}
+}
+
+uint8_t *IHexImagePage(IHEXIMAGE * const pImg, int Idx, uint32_t *pAddr)
+{
+	if (Idx < 0 || Idx >= pImg->NbPage)
+	{
+		return NULL;
+	}
+
+	if (pAddr)
+	{
+		*pAddr = pImg->pPage[Idx].Addr;
+	}
+
+	return IHexImageSlot(pImg, Idx);
+}
+
+int IHexImageRange(IHEXIMAGE * const pImg, int Idx, IHEXRANGE * const pRange)
+{
+	if (Idx < 0 || Idx >= pImg->NbPage)
+	{
+		return 0;
+	}
+
+	pRange->Addr = pImg->pPage[Idx].Addr;
+	pRange->Len = pImg->PageSize;
+
+	// Stop on gap or 4GB wrap
+	while (++Idx < pImg->NbPage && pImg->pPage[Idx].Addr == pRange->Addr + pRange->Len &&
+		   pImg->pPage[Idx].Addr != 0)
+	{
+		pRange->Len += pImg->PageSize;
+	}
+
+	return Idx;
+}
+
+bool IHexImageDataCB(void *pCtx, uint32_t Addr, const uint8_t *pData, int Len)
+{
+	return IHexImageWrite((IHEXIMAGE *)pCtx, Addr, pData, Len);
 }
@@ -80,42 +80,42 @@ static uint32_t g_Sha256KValue[] = {
 	0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
 };
 
-inline uint32_t ROTR(uint32_t x, uint32_t n) 
+static inline uint32_t ROTR(uint32_t x, uint32_t n) 
 {
     return (x >> n) | (x << (32-n));
 }
 
-inline uint32_t ROTL(uint32_t x, uint32_t n) 
+static inline uint32_t ROTL(uint32_t x, uint32_t n) 
 {
 	return (x << n) | (x >> (32 - n));
 }
 		
-inline uint32_t SUM0(uint32_t x)
+static inline uint32_t SUM0(uint32_t x)
 { 
 	return ROTR(x, 2) ^ ROTR(x, 13) ^ ROTR(x, 22);
 }
 
-inline uint32_t SUM1(uint32_t x)
+static inline uint32_t SUM1(uint32_t x)
 { 
 	return ROTR(x, 6) ^ ROTR(x, 11) ^ ROTR(x, 25);
 }
 
-inline uint32_t SIGMA0(uint32_t x)
+static inline uint32_t SIGMA0(uint32_t x)
 { 
 	return ROTR(x, 7) ^ ROTR(x, 18) ^ (x >> 3);
 }
 
-inline uint32_t SIGMA1(uint32_t x)
+static inline uint32_t SIGMA1(uint32_t x)
 { 
 	return ROTR(x, 17) ^ ROTR(x, 19) ^ (x >> 10);
 }
 
-inline uint32_t CH(uint32_t x, uint32_t y, uint32_t z)
+static inline uint32_t CH(uint32_t x, uint32_t y, uint32_t z)
 { 
 	return (x & y) ^ (~x & z); 
 }
 
-inline uint32_t MAJ(uint32_t x, uint32_t y, uint32_t z)
+static inline uint32_t MAJ(uint32_t x, uint32_t y, uint32_t z)
 { 
 	return (x & y) ^ (x & z) ^ (y & z); 
 }
@@ -165,14 +165,6 @@ void Sha256Compute(uint32_t *W, uint32_t *H)
 	H[7] = (H[7] + h);
 }
 
-static int g_LastWIdx = 0;
-static int g_LastOctet = 0;
-static uint64_t g_TotalBitLen = 0;
-static char g_Sha256Digest[66] = { 0,};
-static uint32_t H[8] = { H0, H1, H2, H3, H4, H5, H6, H7 };
-static uint32_t W[64];
-
-
 /*
  * Generate SHA digest code.  Call this function until all data are processed.
  * set bLast parameter to true for last data packet to process.
@@ -191,120 +183,120 @@ static uint32_t W[64];
  */
 char *Sha256(uint8_t *pData, int DataLen, bool bLast, char *pRes)
 {
-	uint8_t *p = pData;
-	int t = 0, j = 0;
-	char *digest = g_Sha256Digest;
+	static SHA256CTX s_Sha256Ctx = { { H0, H1, H2, H3, H4, H5, H6, H7 }, 0, 0, { 0, } };
+	static char s_Sha256Digest[66] = { 0,};
+	char *digest = pRes ? pRes : s_Sha256Digest;
+	uint8_t d[SHA256_DIGEST_LEN];
 
-	g_TotalBitLen += DataLen << 3;
-
-	if (g_LastOctet || g_LastWIdx)
+	if (DataLen > 0)
 	{
-		// We have incomplete buffer from previous call
-		t = g_LastWIdx;
-
-		// Fill up left over from previous 32bits
-		for (int j = g_LastOctet; j < 4; j++)
-		{
-			W[t] |= *p << (24 - (j << 3));
-			DataLen--;
-			p++;
-		}
-		t++;
-		// Fill up th rest of the 512 bits message
-		for (; t < 16 && DataLen > 3; t++)
-		{
-			W[t] = p[3] | (p[2] << 8) | (p[1] << 16) | (p[0] << 24);
-			p += 4;
-			DataLen -= 4;
-		}
-		if (t >= 16)
-		{
-			// We have complete 512
-			Sha256Compute(W, H);
-			memset(W, 0, sizeof(W));
-			t = 0; j = 0;
-		}
+		Sha256Update(&s_Sha256Ctx, pData, DataLen);
 	}
 
-	if (DataLen > 64)
+	if (bLast == false)
 	{
-		// Process N complete 512 bits message
-		int n = DataLen / 64;
-		for (int i = 0; i < n; i++)
-		{
-			for (t = 0; t < 16; t++)
-			{
-				W[t] = p[3] | (p[2] << 8) | (p[1] << 16) | (p[0] << 24);
-				p += 4;
-				DataLen -= 4;
-			}
-			Sha256Compute(W, H);
-		}
-		t = 0;
-		j = 0;
-		memset(W, 0, sizeof(W));
+		// More data to come
+		return NULL;
 	}
-	g_LastWIdx = 0;
-	g_LastOctet = 0;
-	if (DataLen)
+
+	Sha256Final(&s_Sha256Ctx, d);
+
+	for (int i = 0; i < SHA256_DIGEST_LEN; i++)
 	{
-		// Still have incompleted data
-		for (t = 0; t < 16 && DataLen > 3; t++)
-		{
-			W[t] = p[3] | (p[2] << 8) | (p[1] << 16) | (p[0] << 24);
-			p += 4;
-			DataLen -= 4;
-		}
-		for (j = 0; j < DataLen; j++)
-		{
-			W[t] |= *p << (24 - (j << 3));
-			p++;
-		}
+		sprintf(&digest[i << 1], "%02X", d[i]);
 	}
-	if (bLast == false)
-	{
-		// More data to come, remember where we are
-		g_LastWIdx = t;
-		g_LastOctet = j;
 
-		return NULL;
+	// Reset, ready for new processing
+	Sha256Init(&s_Sha256Ctx);
+
+	return digest;
+}
+
+void Sha256Init(SHA256CTX * const pCtx)
+{
+	pCtx->H[0] = H0;
+	pCtx->H[1] = H1;
+	pCtx->H[2] = H2;
+	pCtx->H[3] = H3;
+	pCtx->H[4] = H4;
+	pCtx->H[5] = H5;
+	pCtx->H[6] = H6;
+	pCtx->H[7] = H7;
+	pCtx->TotalLen = 0;
+	pCtx->BuffLen = 0;
+}
+
+static void Sha256Block(SHA256CTX * const pCtx, const uint8_t *p)
+{
+	uint32_t w[64];
+
+	for (int t = 0; t < 16; t++, p += 4)
+	{
+		w[t] = ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | p[3];
 	}
 
-	if (bLast)
+	Sha256Compute(w, pCtx->H);
+}
+
+void Sha256Update(SHA256CTX * const pCtx, const uint8_t *pData, size_t DataLen)
+{
+	pCtx->TotalLen += DataLen;
+
+	if (pCtx->BuffLen > 0)
 	{
-		// All data processed.  add the 1 bit & data len
-		W[t] |= 0x80 << (24 - (j << 3));
-		t++;
-		if (t > 14)
-			Sha256Compute(W, H);
+		size_t l = SHA256_BLOCK_LEN - pCtx->BuffLen;
+
+		l = l < DataLen ? l : DataLen;
+		memcpy(&pCtx->Buff[pCtx->BuffLen], pData, l);
+		pCtx->BuffLen += l;
+		pData += l;
+		DataLen -= l;
+
+		if (pCtx->BuffLen < SHA256_BLOCK_LEN)
 		{
-			W[14] = g_TotalBitLen >> 32;
-			W[15] = g_TotalBitLen & 0xffffffff;
+			return;
 		}
-		Sha256Compute(W, H);
+		Sha256Block(pCtx, pCtx->Buff);
+		pCtx->BuffLen = 0;
+	}
 
-		if (pRes)
-			digest = pRes;
+	// Whole blocks straight from caller data
+	for (; DataLen >= SHA256_BLOCK_LEN; DataLen -= SHA256_BLOCK_LEN, pData += SHA256_BLOCK_LEN)
+	{
+		Sha256Block(pCtx, pData);
+	}
 
-		//sprintf(digest, "%08lX%08lX%08lX%08lX%08lX%08lX%08lX%08lX", H[0], H[1], H[2], H[3], H[4], H[5], H[6], H[7]);
+	memcpy(pCtx->Buff, pData, DataLen);
+	pCtx->BuffLen = DataLen;
+}
 
-		// Reset memory, ready for new processing
+void Sha256Final(SHA256CTX * const pCtx, uint8_t *pDigest)
+{
+	uint64_t bitlen = pCtx->TotalLen << 3;
+	int l = pCtx->BuffLen;
 
-		H[0] = H0;
-		H[1] = H1;
-		H[2] = H2;
-		H[3] = H3;
-		H[4] = H4;
-		H[5] = H5;
-		H[6] = H6;
-		H[7] = H7;
+	pCtx->Buff[l++] = 0x80;
 
-		memset(W, 0, sizeof(W));
-		g_LastWIdx = 0;
-		g_LastOctet = 0;
-		g_TotalBitLen = 0;
+	if (l > SHA256_BLOCK_LEN - 8)
+	{
+		memset(&pCtx->Buff[l], 0, SHA256_BLOCK_LEN - l);
+		Sha256Block(pCtx, pCtx->Buff);
+		l = 0;
 	}
+	memset(&pCtx->Buff[l], 0, SHA256_BLOCK_LEN - 8 - l);
 
-	return digest;
-}
+	for (int i = 0; i < 8; i++)
+	{
+		pCtx->Buff[SHA256_BLOCK_LEN - 1 - i] = bitlen >> (i << 3);
+	}
+	Sha256Block(pCtx, pCtx->Buff);
 
+	for (int i = 0; i < 8; i++)
+	{
+		pDigest[(i << 2)] = pCtx->H[i] >> 24;
+		pDigest[(i << 2) + 1] = pCtx->H[i] >> 16;
+		pDigest[(i << 2) + 2] = pCtx->H[i] >> 8;
+		pDigest[(i << 2) + 3] = pCtx->H[i];
+	}
+	pCtx->BuffLen = 0;
+}
@@ -31,7 +31,6 @@ ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ----------------------------------------------------------------------------*/
-#include "idelay.h"
 #include "iopinctrl.h"
 #include "miscdev/led_apa102.h"
 
@@ -40,12 +39,27 @@ bool LedApa102::Init(APA102_CFG &Cfg)
 	IOPinConfig(Cfg.CIPortNo, Cfg.CIPinNo, 0, IOPINDIR_OUTPUT, IOPINRES_NONE, IOPINTYPE_NORMAL);
 	IOPinConfig(Cfg.DIPortNo, Cfg.DIPinNo, 0, IOPINDIR_OUTPUT, IOPINRES_NONE, IOPINTYPE_NORMAL);
 
+	vpIntrf = NULL;
 	vNbLed = Cfg.NbLed;
 	vCIPortNo = Cfg.CIPortNo;
 	vCIPinNo = Cfg.CIPinNo;
 	vDIPortNo = Cfg.DIPortNo;
 	vDIPinNo = Cfg.DIPinNo;
-	vBrightness = Cfg.Brightness;
+	vBrightness = Cfg.Brightness > APA102_BRIGHTNESS_MAX ? APA102_BRIGHTNESS_MAX : Cfg.Brightness;
+
+	return true;
+}
+
+bool LedApa102::Init(DeviceIntrf * const pIntrf, APA102_FRAME_CFG &Cfg)
+{
+	if (pIntrf == NULL || Apa102FrameInit(&vFrame, &Cfg) == false)
+	{
+		return false;
+	}
+
+	vpIntrf = pIntrf;
+	vNbLed = Cfg.NbLed;
+	vBrightness = vFrame.Hdr & APA102_BRIGHTNESS_MAX;
 
 	return true;
 }
@@ -81,112 +95,78 @@ void LedApa102::Off()
  */
 void LedApa102::Level(uint32_t * const pVal, int NbLeds, int Repeat)
 {
-	uint32_t bit = 0x80000000;
-
-	// Start frame
-	IOPinClear(vDIPortNo, vDIPinNo);
-	while (bit != 0)
+	if (vpIntrf)
 	{
-		IOPinClear(vCIPortNo, vCIPinNo);
-		usDelay(1);
-		IOPinSet(vCIPortNo, vCIPinNo);
+		int idx = 0;
 
-		bit >>= 1;
+		do {
+			Apa102FrameSetPixels(&vFrame, idx, pVal, NbLeds);
+			idx += NbLeds;
+		} while (Repeat-- > 0 && idx < vNbLed);
+
+		Apa102FrameShow(&vFrame, *vpIntrf);
+
+		return;
 	}
 
+	StartTx();
+
 	do {
 		uint32_t *p = pVal;
 
 		for (int i = 0; i < NbLeds; i++, p++)
 		{
-			bit = 0x80000000;
-			*p = (*p & 0xFFFFFF) | (0xe0 | vBrightness);
-
-			while (bit != 0)
-			{
-				IOPinClear(vCIPortNo, vCIPinNo);
-
-				if (*p & bit)
-				{
-					IOPinSet(vDIPortNo, vDIPinNo);
-				}
-				else
-				{
-					IOPinClear(vDIPortNo, vDIPinNo);
-				}
-				IOPinSet(vCIPortNo, vCIPinNo);
-				bit >>= 1;
-			}
+			// Header + BGR wire order
+			uint32_t d = ((uint32_t)(APA102_HDR | vBrightness) << 24) | ((*p & 0xFF) << 16) |
+						 (*p & 0xFF00) | ((*p >> 16) & 0xFF);
+
+			ShiftOut(d, 32);
 		}
 	} while (Repeat-- > 0);
 
-	// Stop frame
-	bit = 0x80000000;
-	IOPinSet(vDIPortNo, vDIPinNo);
+	StopTx();
+}
+
+void LedApa102::ShiftOut(uint32_t Data, int NbBits)
+{
+	uint32_t bit = 1UL << (NbBits - 1);
+
 	while (bit != 0)
 	{
 		IOPinClear(vCIPortNo, vCIPinNo);
-		usDelay(1);
-		IOPinSet(vCIPortNo, vCIPinNo);
 
+		if (Data & bit)
+		{
+			IOPinSet(vDIPortNo, vDIPinNo);
+		}
+		else
+		{
+			IOPinClear(vDIPortNo, vDIPinNo);
+		}
+		IOPinSet(vCIPortNo, vCIPinNo);
 		bit >>= 1;
 	}
 }
 
 void LedApa102::StartTx()
 {
-	uint32_t bit = 0x80000000;
-
 	// Start frame
-	IOPinClear(vDIPortNo, vDIPinNo);
-	while (bit != 0)
-	{
-		IOPinClear(vCIPortNo, vCIPinNo);
-		usDelay(1);
-		IOPinSet(vCIPortNo, vCIPinNo);
-
-		bit >>= 1;
-	}
+	ShiftOut(0, 32);
 }
 
 void LedApa102::TxData(uint32_t * const pData, int DataLen)
 {
-	uint32_t *p = pData;
-
-	for (int i = 0; i < DataLen; i++, p++)
+	for (int i = 0; i < DataLen; i++)
 	{
-		uint32_t bit = 0x80000000;
-
-		while (bit != 0)
-		{
-			IOPinClear(vCIPortNo, vCIPinNo);
-
-			if (*p & bit)
-			{
-				IOPinSet(vDIPortNo, vDIPinNo);
-			}
-			else
-			{
-				IOPinClear(vDIPortNo, vDIPinNo);
-			}
-			IOPinSet(vCIPortNo, vCIPinNo);
-			bit >>= 1;
-		}
+		ShiftOut(pData[i], 32);
 	}
 }
 
 void LedApa102::StopTx()
 {
-	// Stop frame
-	uint32_t bit = 0x80000000;
-	IOPinSet(vDIPortNo, vDIPinNo);
-	while (bit != 0)
+	// End frame, zeros so that extra LEDs stay off
+	for (int i = 0; i < APA102_END_SIZE(vNbLed); i += 4)
 	{
-		IOPinClear(vCIPortNo, vCIPinNo);
-		usDelay(1);
-		IOPinSet(vCIPortNo, vCIPinNo);
-
-		bit >>= 1;
+		ShiftOut(0, 32);
 	}
 }
-
@@ -0,0 +1,323 @@
+/**-------------------------------------------------------------------------
+@file	led_apa102_frame.c
+
+@brief	APA102 LED strip frame encoder implementation.
+
+See led_apa102_frame.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+
+#include "miscdev/led_apa102_frame.h"
+
+/// Pixel bit shift of each wire color byte, indexed by APA102_ORDER
+static const uint8_t s_Apa102OrderShift[][3] = {
+	{ 0, 8, 16 },	// BGR
+	{ 0, 16, 8 },	// BRG
+	{ 8, 0, 16 },	// GBR
+	{ 8, 16, 0 },	// GRB
+	{ 16, 0, 8 },	// RBG
+	{ 16, 8, 0 },	// RGB
+};
+
+/// HDR channel scale for header brightness B : round(255 * 31 * 2^20 / (65535 * B))
+static const uint32_t s_Apa102HdrScale[32] = {
+	0, 126482, 63241, 42161, 31620, 25296, 21080, 18069, 15810, 14054, 12648, 11498, 10540, 9729, 9034, 8432,
+	7905, 7440, 7027, 6657, 6324, 6023, 5749, 5499, 5270, 5059, 4865, 4685, 4517, 4361, 4216, 4080
+};
+
+static inline uint8_t Apa102HdrChan(uint32_t V, uint32_t Scale)
+{
+	// V <= 65535 * B / 31 so V * Scale stays below 255 << 20
+	V = (V * Scale + (1 << 19)) >> 20;
+
+	return V > 255 ? 255 : V;
+}
+
+static inline void Apa102Encode(APA102_FRAME * const pFrame, uint32_t Pixel, uint8_t *pOut)
+{
+	uint8_t c0 = Pixel >> pFrame->Shift[0];
+	uint8_t c1 = Pixel >> pFrame->Shift[1];
+	uint8_t c2 = Pixel >> pFrame->Shift[2];
+
+	if (pFrame->bHdr == false)
+	{
+		pOut[0] = pFrame->Hdr;
+		pOut[1] = pFrame->Lut8[c0];
+		pOut[2] = pFrame->Lut8[c1];
+		pOut[3] = pFrame->Lut8[c2];
+
+		return;
+	}
+
+	uint32_t v0 = pFrame->Lut16[c0];
+	uint32_t v1 = pFrame->Lut16[c1];
+	uint32_t v2 = pFrame->Lut16[c2];
+	uint32_t m = v0 > v1 ? v0 : v1;
+
+	m = m > v2 ? m : v2;
+
+	if (m == 0)
+	{
+		pOut[0] = APA102_HDR;
+		pOut[1] = pOut[2] = pOut[3] = 0;
+
+		return;
+	}
+
+	// Smallest header brightness that can still reach the brightest channel
+	uint32_t b = ((m * APA102_BRIGHTNESS_MAX) >> 16) + 1;
+
+	b = b > APA102_BRIGHTNESS_MAX ? APA102_BRIGHTNESS_MAX : b;
+
+	uint32_t scale = s_Apa102HdrScale[b];
+
+	pOut[0] = APA102_HDR | b;
+	pOut[1] = Apa102HdrChan(v0, scale);
+	pOut[2] = Apa102HdrChan(v1, scale);
+	pOut[3] = Apa102HdrChan(v2, scale);
+}
+
+static inline void Apa102FrameMark(APA102_FRAME * const pFrame, int Lo, int Hi)
+{
+	if (pFrame->DirtyHi <= pFrame->DirtyLo)
+	{
+		pFrame->DirtyLo = Lo;
+		pFrame->DirtyHi = Hi;
+	}
+	else
+	{
+		pFrame->DirtyLo = Lo < pFrame->DirtyLo ? Lo : pFrame->DirtyLo;
+		pFrame->DirtyHi = Hi > pFrame->DirtyHi ? Hi : pFrame->DirtyHi;
+	}
+}
+
+/**
+ * @brief	Clip LED range to the strip.
+ *
+ * @return	Number of LEDs left in range
+ */
+static inline int Apa102FrameClip(APA102_FRAME * const pFrame, int *pIdx, int Count)
+{
+	if (*pIdx < 0)
+	{
+		Count += *pIdx;
+		*pIdx = 0;
+	}
+	if (Count > pFrame->NbLed - *pIdx)
+	{
+		Count = pFrame->NbLed - *pIdx;
+	}
+
+	return Count;
+}
+
+bool Apa102FrameInit(APA102_FRAME * const pFrame, const APA102_FRAME_CFG * const pCfg)
+{
+	if (pFrame == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->NbLed <= 0 ||
+		pCfg->Order > APA102_ORDER_RGB)
+	{
+		return false;
+	}
+
+	int fsize = APA102_FRAME_SIZE(pCfg->NbLed);
+
+	if (pCfg->MemSize < 2 * (uint32_t)fsize)
+	{
+		return false;
+	}
+
+	pFrame->NbLed = pCfg->NbLed;
+	pFrame->FrameSize = fsize;
+	pFrame->pBuff[0] = pCfg->pMem;
+	pFrame->pBuff[1] = pCfg->pMem + fsize;
+	pFrame->Back = 0;
+	memcpy(pFrame->Shift, s_Apa102OrderShift[pCfg->Order], 3);
+	pFrame->bHdr = pCfg->bHdr;
+	pFrame->bPartial = pCfg->bPartial;
+	pFrame->DirtyLo = pFrame->DirtyHi = 0;
+	pFrame->ShowCnt = 0;
+	pFrame->BusyCnt = 0;
+
+	Apa102FrameSetBrightness(pFrame, pCfg->Brightness);
+	Apa102FrameSetGamma(pFrame, pCfg->Gamma > 0 ? pCfg->Gamma : 1.0, pCfg->Level);
+
+	// Start & end frames are zeros, LEDs off
+	uint8_t off[APA102_LED_SIZE];
+
+	Apa102Encode(pFrame, 0, off);
+	memset(pCfg->pMem, 0, 2 * fsize);
+	for (int i = 0; i < 2; i++)
+	{
+		uint8_t *p = pFrame->pBuff[i] + APA102_START_SIZE;
+
+		for (int j = 0; j < pFrame->NbLed; j++, p += APA102_LED_SIZE)
+		{
+			memcpy(p, off, APA102_LED_SIZE);
+		}
+	}
+
+	Apa102FrameInvalidate(pFrame);
+
+	return true;
+}
+
+void Apa102FrameSetGamma(APA102_FRAME * const pFrame, float Gamma, uint8_t Level)
+{
+	float scale = 65535.0f * Level / 255.0f;
+
+	for (int i = 0; i < 256; i++)
+	{
+		pFrame->Lut16[i] = (uint16_t)(powf(i / 255.0f, Gamma) * scale + 0.5f);
+	}
+
+	Apa102FrameSetLut(pFrame, pFrame->Lut16);
+}
+
+void Apa102FrameSetLut(APA102_FRAME * const pFrame, const uint16_t *pLut)
+{
+	for (int i = 0; i < 256; i++)
+	{
+		pFrame->Lut16[i] = pLut[i];
+		pFrame->Lut8[i] = ((uint32_t)pLut[i] * 255 + 32767) / 65535;
+	}
+}
+
+void Apa102FrameSetBrightness(APA102_FRAME * const pFrame, uint8_t Brightness)
+{
+	Brightness = Brightness > APA102_BRIGHTNESS_MAX ? APA102_BRIGHTNESS_MAX : Brightness;
+	pFrame->Hdr = APA102_HDR | Brightness;
+}
+
+void Apa102FrameEncode(APA102_FRAME * const pFrame, uint32_t Pixel, uint8_t *pOut)
+{
+	Apa102Encode(pFrame, Pixel, pOut);
+}
+
+void Apa102FrameSetPixels(APA102_FRAME * const pFrame, int Idx, const uint32_t *pPixels, int Count)
+{
+	int idx = Idx;
+
+	Count = Apa102FrameClip(pFrame, &idx, Count);
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	pPixels += idx - Idx;
+
+	uint8_t *p = Apa102FrameBack(pFrame) + APA102_START_SIZE + idx * APA102_LED_SIZE;
+
+	for (int i = 0; i < Count; i++, p += APA102_LED_SIZE)
+	{
+		Apa102Encode(pFrame, pPixels[i], p);
+	}
+
+	Apa102FrameMark(pFrame, idx, idx + Count);
+}
+
+void Apa102FrameFill(APA102_FRAME * const pFrame, int Idx, uint32_t Pixel, int Count)
+{
+	Count = Apa102FrameClip(pFrame, &Idx, Count);
+	if (Count <= 0)
+	{
+		return;
+	}
+
+	uint8_t *p = Apa102FrameBack(pFrame) + APA102_START_SIZE + Idx * APA102_LED_SIZE;
+	uint8_t led[APA102_LED_SIZE];
+
+	Apa102Encode(pFrame, Pixel, led);
+
+	for (int i = 0; i < Count; i++, p += APA102_LED_SIZE)
+	{
+		memcpy(p, led, APA102_LED_SIZE);
+	}
+
+	Apa102FrameMark(pFrame, Idx, Idx + Count);
+}
+
+void Apa102FrameInvalidate(APA102_FRAME * const pFrame)
+{
+	Apa102FrameMark(pFrame, 0, pFrame->NbLed);
+}
+
+bool Apa102FrameShow(APA102_FRAME * const pFrame, DEVINTRF * const pIntrf)
+{
+	if (Apa102FrameChanged(pFrame) == false)
+	{
+		return true;
+	}
+
+	if (DeviceIntrfStartTx(pIntrf, 0) == false)
+	{
+		// Keep accumulating changes until interface is free
+		pFrame->BusyCnt++;
+
+		return false;
+	}
+
+	int lo = pFrame->DirtyLo;
+	int hi = pFrame->DirtyHi;
+	uint8_t *front = Apa102FrameBack(pFrame);
+
+	pFrame->Back ^= 1;
+	pFrame->DirtyLo = pFrame->DirtyHi = 0;
+
+	// Bring the new back buffer up to date with what is being sent
+	memcpy(Apa102FrameBack(pFrame) + APA102_START_SIZE + lo * APA102_LED_SIZE,
+		   front + APA102_START_SIZE + lo * APA102_LED_SIZE, (hi - lo) * APA102_LED_SIZE);
+
+	int n = pFrame->bPartial ? hi : pFrame->NbLed;
+	int len = APA102_START_SIZE + n * APA102_LED_SIZE;
+	int elen = APA102_END_SIZE(n);
+	int cnt = DeviceIntrfTxData(pIntrf, front, len);
+
+	if (cnt == len)
+	{
+		// End frame of the full strip is zeros and at least as long
+		cnt += DeviceIntrfTxData(pIntrf, front + APA102_START_SIZE + pFrame->NbLed * APA102_LED_SIZE, elen);
+	}
+
+	DeviceIntrfStopTx(pIntrf);
+
+	if (cnt != len + elen)
+	{
+		// Resend on next call
+		Apa102FrameMark(pFrame, lo, hi);
+
+		return false;
+	}
+
+	pFrame->ShowCnt++;
+
+	return true;
+}
@@ -29,6 +29,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ----------------------------------------------------------------------------
 Modified by          Date              Description
+Hoan Hoang           Oct. 19, 2026     In RAM framebuffer, dirty column flush & scroll engine
 
 ----------------------------------------------------------------------------*/
 #include <stdio.h>
@@ -39,11 +40,258 @@ Modified by          Date              Description
 #include "miscdev/ledmx.h"
 #include "miscdev/ledmxfont.h"
 
-extern char s_Buffer[];	// defined in sbuffer.c
-extern int s_BufferSize;
+/// Merge runs of changed columns separated by at most this many unchanged
+/// columns. Resending one column (8 bits) is cheaper than a new write
+/// command (10 bits + chip select)
+#define LEDMX_FLUSH_MERGE_GAP		1
+
+static inline LEDMXFONT_BITMAP const *LedMxGlyph(LEDMXDEV *pDev, char c, LEDMXFONT_BITMAP *pTmp)
+{
+	uint8_t fidx = (uint8_t)c;
+
+#ifdef __AVR__
+	memcpy_P(pTmp, &pDev->pFont[fidx], sizeof(LEDMXFONT_BITMAP));
+
+	return pTmp;
+#else
+	return &pDev->pFont[fidx];
+#endif
+}
+
+static inline void LedMxFbMark(LEDMXDEV *pDev, int Col)
+{
+	pDev->Dirty[Col / LEDMX_PANEL_NBCOL] |= 1UL << (Col % LEDMX_PANEL_NBCOL);
+}
+
+static inline void LedMxFbMarkAll(LEDMXDEV *pDev)
+{
+	for (int i = 0; i < pDev->NbPanel; i++)
+	{
+		pDev->Dirty[i] = 0xFFFFFFFFUL;
+	}
+}
+
+void LedMxFbClear(LEDMXDEV *pDev)
+{
+	memset(pDev->pFb, 0, pDev->NbPanel * LEDMX_PANEL_NBCOL);
+	LedMxFbMarkAll(pDev);
+}
+
+void LedMxFbSetCol(LEDMXDEV *pDev, int Col, uint8_t Data)
+{
+	if (Col < 0 || Col >= pDev->NbPanel * LEDMX_PANEL_NBCOL)
+		return;
+
+	pDev->pFb[Col] = Data;
+	LedMxFbMark(pDev, Col);
+}
+
+int LedMxFbDrawStr(LEDMXDEV *pDev, int Col, const char *pStr)
+{
+	int nbcol = pDev->NbPanel * LEDMX_PANEL_NBCOL;
+
+	for (; *pStr != 0 && Col < nbcol; pStr++)
+	{
+		LEDMXFONT_BITMAP tmp;
+		LEDMXFONT_BITMAP const *font = LedMxGlyph(pDev, *pStr, &tmp);
+
+		for (int i = 0; i < font->Width; i++, Col++)
+		{
+			if (Col >= 0 && Col < nbcol)
+			{
+				pDev->pFb[Col] = font->Data[i];
+				LedMxFbMark(pDev, Col);
+			}
+		}
+	}
+
+	return Col;
+}
+
+void LedMxFbShift(LEDMXDEV *pDev, int NbCol)
+{
+	int nbcol = pDev->NbPanel * LEDMX_PANEL_NBCOL;
+
+	if (NbCol == 0)
+		return;
+
+	if (NbCol >= nbcol || -NbCol >= nbcol)
+	{
+		LedMxFbClear(pDev);
+		return;
+	}
+
+	if (NbCol > 0)
+	{
+		memmove(pDev->pFb + NbCol, pDev->pFb, nbcol - NbCol);
+		memset(pDev->pFb, 0, NbCol);
+	}
+	else
+	{
+		memmove(pDev->pFb, pDev->pFb - NbCol, nbcol + NbCol);
+		memset(pDev->pFb + nbcol + NbCol, 0, -NbCol);
+	}
+	LedMxFbMarkAll(pDev);
+}
+
+int LedMxFlush(LEDMXDEV *pDev)
+{
+	int bits = 0;
+
+	if (pDev->pFb == NULL)
+		return 0;
+
+	for (int p = 0; p < pDev->NbPanel; p++)
+	{
+		uint8_t *fb = &pDev->pFb[p * LEDMX_PANEL_NBCOL];
+		uint8_t *shadow = &pDev->pShadow[p * LEDMX_PANEL_NBCOL];
+		uint32_t dirty = pDev->Dirty[p];
+		int c = 0;
+
+		pDev->Dirty[p] = 0;
+
+		while (dirty != 0 && c < LEDMX_PANEL_NBCOL)
+		{
+			// Find first changed column
+			while (c < LEDMX_PANEL_NBCOL && ((dirty & (1UL << c)) == 0 || fb[c] == shadow[c]))
+				c++;
+
+			if (c >= LEDMX_PANEL_NBCOL)
+				break;
+
+			// Extend run over small gaps of unchanged columns
+			int start = c;
+			int end = c;
+
+			for (c++; c < LEDMX_PANEL_NBCOL && c - end <= LEDMX_FLUSH_MERGE_GAP + 1; c++)
+			{
+				if ((dirty & (1UL << c)) && fb[c] != shadow[c])
+					end = c;
+			}
+			c = end + 1;
+
+			LedMxStartTx(pDev, pDev->PanelAddr[p]);
+
+			// 101aaaaaaa
+			LedMxTxData(pDev, 0x280 | ((start << 1) & 0x7f), 10);
+			for (int i = start; i <= end; i++)
+			{
+				LedMxTxData(pDev, fb[i], 8);
+				shadow[i] = fb[i];
+			}
+
+			LedMxStopTx(pDev, pDev->PanelAddr[p]);
+
+			bits += 10 + 8 * (end - start + 1);
+		}
+	}
+
+	return bits;
+}
+
+void LedMxScrollInit(LEDMXDEV *pDev, LEDMXSCROLL *pScroll, const char *pStr, bool bRight)
+{
+	pScroll->pStr = pStr;
+	pScroll->Len = strlen(pStr);
+	pScroll->bRight = bRight;
+	pScroll->Trail = pDev->NbPanel * LEDMX_PANEL_NBCOL;
+	pScroll->Col = 0;
+
+	if (bRight)
+	{
+		// Text enters from its last column
+		pScroll->Idx = pScroll->Len - 1;
+		if (pScroll->Idx >= 0)
+		{
+			LEDMXFONT_BITMAP tmp;
+
+			pScroll->Col = LedMxGlyph(pDev, pStr[pScroll->Idx], &tmp)->Width - 1;
+		}
+	}
+	else
+	{
+		pScroll->Idx = 0;
+	}
+}
+
+/**
+ * @brief	Get next column entering the display
+ *
+ * @return	false when text and trailing blank are exhausted
+ */
+static bool LedMxScrollNextCol(LEDMXDEV *pDev, LEDMXSCROLL *pScroll, uint8_t *pData)
+{
+	LEDMXFONT_BITMAP tmp;
+
+	while (pScroll->Idx >= 0 && pScroll->Idx < pScroll->Len)
+	{
+		LEDMXFONT_BITMAP const *font = LedMxGlyph(pDev, pScroll->pStr[pScroll->Idx], &tmp);
+
+		if (pScroll->Col >= 0 && pScroll->Col < font->Width)
+		{
+			*pData = font->Data[pScroll->Col];
+			pScroll->Col += pScroll->bRight ? -1 : 1;
+
+			return true;
+		}
+
+		if (pScroll->bRight)
+		{
+			if (--pScroll->Idx >= 0)
+			{
+				pScroll->Col = LedMxGlyph(pDev, pScroll->pStr[pScroll->Idx], &tmp)->Width - 1;
+			}
+		}
+		else
+		{
+			pScroll->Idx++;
+			pScroll->Col = 0;
+		}
+	}
+
+	if (pScroll->Trail <= 0)
+		return false;
+
+	pScroll->Trail--;
+	*pData = 0;
+
+	return true;
+}
+
+bool LedMxScrollStep(LEDMXDEV *pDev, LEDMXSCROLL *pScroll)
+{
+	uint8_t d;
+
+	if (pDev->pFb == NULL || LedMxScrollNextCol(pDev, pScroll, &d) == false)
+		return false;
+
+	if (pScroll->bRight)
+	{
+		LedMxFbShift(pDev, 1);
+		LedMxFbSetCol(pDev, 0, d);
+	}
+	else
+	{
+		LedMxFbShift(pDev, -1);
+		LedMxFbSetCol(pDev, pDev->NbPanel * LEDMX_PANEL_NBCOL - 1, d);
+	}
+
+	LedMxFlush(pDev);
+
+	return true;
+}
 
 void LedMxPrintAt(LEDMXDEV *pDev, int col, const char *pStr)
 {
+	if (pDev->pFb)
+	{
+		LedMxFbClear(pDev);
+		LedMxFbDrawStr(pDev, col, pStr);
+		LedMxFlush(pDev);
+
+		return;
+	}
+
 	int panelidx = col / 32;
 	int paneladdr = pDev->PanelAddr[panelidx];
 	int addr = (col % 32) << 1;
@@ -168,6 +416,16 @@ void LedMxPrintScrollLeft(LEDMXDEV *pDev, const char *pStr)
 	int i = col;
 	int pixlen;
 
+	if (pDev->pFb)
+	{
+		LEDMXSCROLL scroll;
+
+		LedMxScrollInit(pDev, &scroll, pStr, false);
+		while (LedMxScrollStep(pDev, &scroll));
+
+		return;
+	}
+
 	pixlen = LedMxPixStrLen(pDev, pStr);
 	for (i = col; i + pixlen > 0; i-= 1)
 	{
@@ -177,7 +435,23 @@ void LedMxPrintScrollLeft(LEDMXDEV *pDev, const char *pStr)
 
 void LedMxPrintScrollRight(LEDMXDEV *pDev, const char *pStr)
 {
+	int col = pDev->NbPanel * 32;
+	int i;
 
+	if (pDev->pFb)
+	{
+		LEDMXSCROLL scroll;
+
+		LedMxScrollInit(pDev, &scroll, pStr, true);
+		while (LedMxScrollStep(pDev, &scroll));
+
+		return;
+	}
+
+	for (i = 1 - LedMxPixStrLen(pDev, pStr); i < col; i++)
+	{
+		LedMxPrintAt(pDev, i, pStr);
+	}
 }
 
 void LedMxvPrintf(LEDMXDEV *pDev, LEDMXPRTMODE Mode, const char *pFormat, va_list vl)
@@ -185,7 +459,7 @@ void LedMxvPrintf(LEDMXDEV *pDev, LEDMXPRTMODE Mode, const char *pFormat, va_lis
 	char buff[80];
 
     vsnprintf(buff, 80, pFormat, vl);
-    s_Buffer[80 - 1] = '\0';
+    buff[80 - 1] = '\0';
 
     switch (Mode)
     {
@@ -382,6 +656,27 @@ void LedMxInit(LEDMXDEV *pDev, LEDMXCFG *pCfg)
 		pDev->FontLen = pCfg->FontLen;
 		pDev->pFont = pCfg->pFont;
 	}
+
+	if (pCfg->pFbMem)
+	{
+		int nbcol = pDev->NbPanel * LEDMX_PANEL_NBCOL;
+
+		pDev->pFb = pCfg->pFbMem;
+		pDev->pShadow = pCfg->pFbMem + nbcol;
+		memset(pDev->pFb, 0, 2 * nbcol);
+		memset(pDev->Dirty, 0, sizeof(pDev->Dirty));
+
+		// Panel RAM content is unknown after power up
+		for (i = 0; i < pDev->NbPanel; i++)
+		{
+			LedMxSetRam(pDev, 0, 0, LEDMX_PANEL_NBCOL, pDev->PanelAddr[i]);
+		}
+	}
+	else
+	{
+		pDev->pFb = NULL;
+		pDev->pShadow = NULL;
+	}
 }
 
 
@@ -31,6 +31,8 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Modified by          Date              Description
 
 ----------------------------------------------------------------------------*/
+#include <string.h>
+
 #include "prbs.h"
 
 /**
@@ -48,3 +50,406 @@ uint8_t Prbs8(uint8_t CurVal)
 	uint8_t newbit = (((CurVal >> 6) ^ (CurVal >> 5)) & 1);
 	return ((CurVal << 1) | newbit) & 0x7f;
 }
+
+/// Polynomial x^n + x^m + 1 and power of 2 applied to get byte distances
+typedef struct {
+	uint8_t n;
+	uint8_t m;
+	uint8_t Mul;		// Byte distance = n * Mul, (Mul * 8)th power of polynomial
+} PRBS_POLY;
+
+static const PRBS_POLY s_PrbsPoly[] = {
+	{ 7, 6, 1 },		// PRBS_TYPE_PRBS8, LFSR state sequence
+	{ 7, 6, 4 },		// PRBS_TYPE_PRBS7
+	{ 15, 14, 2 },		// PRBS_TYPE_PRBS15
+	{ 23, 18, 2 },		// PRBS_TYPE_PRBS23
+	{ 31, 28, 1 },		// PRBS_TYPE_PRBS31
+};
+
+bool PrbsGenInit(PRBSGEN * const pGen, PRBS_TYPE Type, uint32_t Seed, bool bInvert)
+{
+	if (pGen == NULL || Type < PRBS_TYPE_PRBS8 || Type > PRBS_TYPE_PRBS31)
+	{
+		return false;
+	}
+
+	const PRBS_POLY *poly = &s_PrbsPoly[Type];
+	uint32_t mask = (1UL << poly->n) - 1;
+
+	Seed &= mask;
+	if (Seed == 0)
+	{
+		return false;
+	}
+
+	pGen->Type = Type;
+	pGen->bInvert = bInvert;
+
+	if (Type == PRBS_TYPE_PRBS8)
+	{
+		pGen->Dist1 = 1;
+		pGen->Dist2 = 1;
+		pGen->Pending = 0;
+		pGen->Hist[0] = Seed;
+
+		return true;
+	}
+
+	pGen->Dist1 = poly->n * poly->Mul;
+	pGen->Dist2 = poly->m * poly->Mul;
+
+	// Bootstrap history one bit at a time, Fibonacci LFSR
+	uint8_t inv = bInvert ? 1 : 0;
+
+	for (int i = 0; i < pGen->Dist1; i++)
+	{
+		uint8_t d = 0;
+
+		for (int j = 0; j < 8; j++)
+		{
+			uint32_t b = ((Seed >> (poly->n - 1)) ^ (Seed >> (poly->m - 1))) & 1;
+
+			Seed = ((Seed << 1) | b) & mask;
+			d |= (b ^ inv) << j;
+		}
+		pGen->Hist[i] = d;
+	}
+
+	// Sequence starts with the bootstrap bytes
+	pGen->Pending = pGen->Dist1;
+
+	return true;
+}
+
+void PrbsGenFill(PRBSGEN * const pGen, uint8_t *pBuff, int Len)
+{
+	if (Len <= 0)
+	{
+		return;
+	}
+
+	if (pGen->Type == PRBS_TYPE_PRBS8)
+	{
+		uint8_t v = pGen->Hist[0];
+
+		for (int i = 0; i < Len; i++)
+		{
+			v = Prbs8(v);
+			pBuff[i] = v;
+		}
+		pGen->Hist[0] = v;
+
+		return;
+	}
+
+	if (pGen->Pending > 0)
+	{
+		int l = Len < pGen->Pending ? Len : pGen->Pending;
+
+		memcpy(pBuff, &pGen->Hist[pGen->Dist1 - pGen->Pending], l);
+		pGen->Pending -= l;
+		pBuff += l;
+		Len -= l;
+		if (Len <= 0)
+		{
+			return;
+		}
+	}
+
+	int d1 = pGen->Dist1;
+	int d2 = pGen->Dist2;
+	uint8_t inv = pGen->bInvert ? 0xff : 0;
+	uint64_t inv64 = pGen->bInvert ? ~0ULL : 0;
+	int i = 0;
+
+	// Head, long distance source still in history
+	for (; i < Len && i < d1; i++)
+	{
+		uint8_t b = i < d2 ? pGen->Hist[d1 - d2 + i] : pBuff[i - d2];
+
+		pBuff[i] = pGen->Hist[i] ^ b ^ inv;
+	}
+
+	// Body, 8 bytes per step. Dist2 >= 8 so sources are never being written
+	for (; i + 8 <= Len; i += 8)
+	{
+		uint64_t a, b;
+
+		memcpy(&a, &pBuff[i - d1], 8);
+		memcpy(&b, &pBuff[i - d2], 8);
+		a ^= b ^ inv64;
+		memcpy(&pBuff[i], &a, 8);
+	}
+
+	for (; i < Len; i++)
+	{
+		pBuff[i] = pBuff[i - d1] ^ pBuff[i - d2] ^ inv;
+	}
+
+	if (Len >= d1)
+	{
+		memcpy(pGen->Hist, &pBuff[Len - d1], d1);
+	}
+	else
+	{
+		memmove(pGen->Hist, &pGen->Hist[Len], d1 - Len);
+		memcpy(&pGen->Hist[d1 - Len], pBuff, Len);
+	}
+}
+
+void PrbsChkReset(PRBSCHK * const pChk)
+{
+	memset(&pChk->Burst, 0, sizeof(PRBSBURST));
+	pChk->PrevBurst = pChk->Burst;
+	pChk->WinBurst = pChk->Burst;
+	pChk->bPrev = false;
+	pChk->BitCnt = 0;
+	pChk->WinStart = 0;
+	pChk->WinCnt = 0;
+	pChk->WinErr = 0;
+	pChk->HuntBytes = 0;
+	pChk->SlipCnt = 0;
+	pChk->LockCnt = 0;
+}
+
+bool PrbsChkInit(PRBSCHK * const pChk, const PRBSCHK_CFG * const pCfg)
+{
+	if (pChk == NULL || pCfg == NULL || PrbsGenInit(&pChk->Ref, pCfg->Type, 1, pCfg->bInvert) == false)
+	{
+		return false;
+	}
+
+	pChk->SyncLen = pCfg->SyncLen > 0 ? pCfg->SyncLen : PRBSCHK_SYNC_DEFAULT;
+	pChk->WinLen = pCfg->WinLen > 0 ? pCfg->WinLen : PRBSCHK_WIN_DEFAULT;
+	pChk->LossThres = pCfg->LossThres > 0 ? pCfg->LossThres : pChk->WinLen;
+	pChk->BurstGap = pCfg->BurstGap > 0 ? pCfg->BurstGap : PRBSCHK_GAP_DEFAULT;
+	pChk->bLocked = false;
+	pChk->GoodCnt = 0;
+	pChk->HistCnt = 0;
+
+	PrbsChkReset(pChk);
+
+	return true;
+}
+
+/**
+ * @brief	Predict next byte from received history.
+ */
+static inline uint8_t PrbsChkPredict(PRBSCHK * const pChk)
+{
+	PRBSGEN *g = &pChk->Ref;
+
+	if (g->Type == PRBS_TYPE_PRBS8)
+	{
+		return Prbs8(g->Hist[0]);
+	}
+
+	return g->Hist[0] ^ g->Hist[g->Dist1 - g->Dist2] ^ (g->bInvert ? 0xff : 0);
+}
+
+/**
+ * @brief	Reject lock on an idle line. A real sequence never has a full
+ * history of constant bits.
+ */
+static inline bool PrbsChkIdle(PRBSCHK * const pChk)
+{
+	PRBSGEN *g = &pChk->Ref;
+
+	if (g->Type == PRBS_TYPE_PRBS8)
+	{
+		return g->Hist[0] == 0;
+	}
+
+	for (int i = 0; i < g->Dist1; i++)
+	{
+		if (g->Hist[i] != 0 && g->Hist[i] != 0xff)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Hunt for sync.
+ *
+ * @return	Number of bytes consumed
+ */
+static int PrbsChkHunt(PRBSCHK * const pChk, const uint8_t *pData, int Len)
+{
+	PRBSGEN *g = &pChk->Ref;
+	int i = 0;
+
+	while (i < Len && pChk->bLocked == false)
+	{
+		uint8_t d = pData[i++];
+
+		if (pChk->HistCnt >= g->Dist1)
+		{
+			pChk->GoodCnt = PrbsChkPredict(pChk) == d ? pChk->GoodCnt + 1 : 0;
+			memmove(g->Hist, &g->Hist[1], g->Dist1 - 1);
+			g->Hist[g->Dist1 - 1] = d;
+
+			if (pChk->GoodCnt >= pChk->SyncLen)
+			{
+				if (PrbsChkIdle(pChk))
+				{
+					pChk->GoodCnt = 0;
+					continue;
+				}
+
+				// History is now the reference generator state
+				g->Pending = 0;
+				pChk->bLocked = true;
+				pChk->bPrev = false;
+				pChk->LockCnt++;
+				pChk->WinCnt = 0;
+				pChk->WinErr = 0;
+				pChk->Burst.bInBurst = false;
+				pChk->PrevBurst = pChk->Burst;
+				pChk->WinBurst = pChk->Burst;
+			}
+		}
+		else
+		{
+			g->Hist[pChk->HistCnt++] = d;
+		}
+	}
+
+	pChk->HuntBytes += i;
+
+	return i;
+}
+
+static inline void PrbsChkErr(PRBSCHK * const pChk, uint64_t Pos)
+{
+	PRBSBURST *b = &pChk->WinBurst;
+
+	b->ErrCnt++;
+
+	if (b->bInBurst && Pos - b->LastErr > (uint64_t)pChk->BurstGap)
+	{
+		b->bInBurst = false;
+	}
+
+	if (b->bInBurst == false)
+	{
+		b->bInBurst = true;
+		b->BurstStart = Pos;
+		b->BurstCnt++;
+		b->BurstBits++;
+	}
+	else
+	{
+		b->BurstBits += Pos - b->LastErr;
+	}
+
+	uint64_t len = Pos - b->BurstStart + 1;
+	if (len > b->BurstMax)
+	{
+		b->BurstMax = len;
+	}
+	b->LastErr = Pos;
+}
+
+/**
+ * @brief	Compare against reference, Len must not cross window end
+ */
+static void PrbsChkCompare(PRBSCHK * const pChk, const uint8_t *pData, int Len)
+{
+	uint8_t ref[256];
+	uint64_t pos = pChk->WinStart + (uint64_t)pChk->WinCnt * 8;
+
+	while (Len > 0)
+	{
+		int n = Len < (int)sizeof(ref) ? Len : (int)sizeof(ref);
+		int i = 0;
+
+		PrbsGenFill(&pChk->Ref, ref, n);
+
+		while (i < n)
+		{
+			uint64_t a, b;
+
+			if (i + 8 <= n)
+			{
+				memcpy(&a, &ref[i], 8);
+				memcpy(&b, &pData[i], 8);
+				if (a == b)
+				{
+					i += 8;
+					continue;
+				}
+			}
+
+			// Errors, locate bits in stream order (LSB first)
+			int e = i + 8 <= n ? i + 8 : n;
+			for (; i < e; i++)
+			{
+				uint32_t x = ref[i] ^ pData[i];
+
+				while (x)
+				{
+					int bit = __builtin_ctz(x);
+
+					pChk->WinErr++;
+					PrbsChkErr(pChk, pos + i * 8 + bit);
+					x &= x - 1;
+				}
+			}
+		}
+
+		pData += n;
+		Len -= n;
+		pos += n * 8;
+		pChk->WinCnt += n;
+	}
+}
+
+void PrbsChkProcess(PRBSCHK * const pChk, const uint8_t *pData, int Len)
+{
+	while (Len > 0)
+	{
+		if (pChk->bLocked == false)
+		{
+			int n = PrbsChkHunt(pChk, pData, Len);
+
+			pData += n;
+			Len -= n;
+			continue;
+		}
+
+		int n = pChk->WinLen - pChk->WinCnt;
+
+		n = n < Len ? n : Len;
+		PrbsChkCompare(pChk, pData, n);
+		pData += n;
+		Len -= n;
+
+		if (pChk->WinErr >= (uint32_t)pChk->LossThres)
+		{
+			// Slip, drop statistics of this window and the previous one, hunt again
+			pChk->SlipCnt++;
+			pChk->HuntBytes += pChk->WinCnt + (pChk->bPrev ? pChk->WinLen : 0);
+			pChk->PrevBurst = pChk->Burst;
+			pChk->WinBurst = pChk->Burst;
+			pChk->bLocked = false;
+			pChk->GoodCnt = 0;
+			pChk->HistCnt = 0;
+		}
+		else if (pChk->WinCnt >= pChk->WinLen)
+		{
+			if (pChk->bPrev)
+			{
+				pChk->BitCnt += (uint64_t)pChk->WinLen * 8;
+				pChk->Burst = pChk->PrevBurst;
+			}
+			pChk->PrevBurst = pChk->WinBurst;
+			pChk->bPrev = true;
+			pChk->WinStart += (uint64_t)pChk->WinCnt * 8;
+			pChk->WinCnt = 0;
+			pChk->WinErr = 0;
+		}
+	}
+}
@@ -73,6 +73,171 @@ void PulseTrain(PULSE_TRAIN_CFG *pCfg, uint32_t Loop)
 	} while (--Loop > 0);
 }
 
+static inline uint32_t PulseTrainNsToTick(uint64_t nsTime, uint32_t Freq)
+{
+	return (uint32_t)((nsTime * Freq + 500000000ULL) / 1000000000ULL);
+}
+
+bool PulseTrainCompile(PULSE_TRAIN_PROG * const pProg, const PULSE_TRAIN_DESC * const pDesc,
+					   uint32_t Freq, PULSE_TRAIN_EVT *pEvtMem, int MaxEvt)
+{
+	if (pProg == NULL || pDesc == NULL || pEvtMem == NULL || Freq == 0 || pDesc->pPins == NULL ||
+		pDesc->NbPins <= 0 || pDesc->NbPins > PULSE_TRAIN_MAX_PIN || pDesc->NbPulses < 0 ||
+		(pDesc->NbPulses > 0 && pDesc->pPulses == NULL) || MaxEvt < 2 * pDesc->NbPulses)
+	{
+		return false;
+	}
+
+	uint32_t period = PulseTrainNsToTick(pDesc->nsPeriod, Freq);
+	uint32_t pinmask = pDesc->NbPins < 32 ? (1UL << pDesc->NbPins) - 1 : 0xFFFFFFFF;
+	uint32_t actlow = 0;
+	uint32_t last = 0;
+	int n = 0;
+
+	if (pDesc->nsPeriod > 0 && period == 0)
+	{
+		return false;
+	}
+
+	for (int i = 0; i < pDesc->NbPins; i++)
+	{
+		PULSE_TRAIN_POL pol = pDesc->pPinPol ? pDesc->pPinPol[i] : pDesc->Pol;
+
+		if (pol == PULSE_TRAIN_POL_LOW)
+		{
+			actlow |= 1UL << i;
+		}
+	}
+
+	// Edge list. Until merged, HiMask is 1 for pulse start, 0 for pulse end
+	// and LoMask is the pin index
+	for (int i = 0; i < pDesc->NbPulses; i++)
+	{
+		const PULSE_TRAIN_PULSE *p = &pDesc->pPulses[i];
+
+		if (p->Pin < 0 || p->Pin >= pDesc->NbPins)
+		{
+			return false;
+		}
+
+		uint32_t start = PulseTrainNsToTick(p->nsStart, Freq);
+		uint32_t end = PulseTrainNsToTick((uint64_t)p->nsStart + p->nsWidth, Freq);
+
+		if (end <= start)
+		{
+			continue;
+		}
+
+		if (pDesc->nsPeriod > 0 && end > period)
+		{
+			return false;
+		}
+
+		pEvtMem[n].Tick = start;
+		pEvtMem[n].HiMask = 1;
+		pEvtMem[n].LoMask = p->Pin;
+		n++;
+		pEvtMem[n].Tick = end;
+		pEvtMem[n].HiMask = 0;
+		pEvtMem[n].LoMask = p->Pin;
+		n++;
 
+		last = end > last ? end : last;
+	}
+
+	// Insertion sort by tick, lists are short and mostly in order
+	for (int i = 1; i < n; i++)
+	{
+		PULSE_TRAIN_EVT e = pEvtMem[i];
+		int j = i - 1;
+
+		while (j >= 0 && pEvtMem[j].Tick > e.Tick)
+		{
+			pEvtMem[j + 1] = pEvtMem[j];
+			j--;
+		}
+		pEvtMem[j + 1] = e;
+	}
 
+	// Merge edges of the same tick into pin level changes, in place
+	uint8_t cnt[PULSE_TRAIN_MAX_PIN] = { 0, };
+	uint32_t active = 0;
+	int w = 0;
 
+	for (int r = 0; r < n; )
+	{
+		uint32_t t = pEvtMem[r].Tick;
+		uint32_t newact = active;
+
+		for (; r < n && pEvtMem[r].Tick == t; r++)
+		{
+			int pin = pEvtMem[r].LoMask;
+
+			if (pEvtMem[r].HiMask)
+			{
+				cnt[pin]++;
+			}
+			else
+			{
+				cnt[pin]--;
+			}
+			if (cnt[pin] > 0)
+			{
+				newact |= 1UL << pin;
+			}
+			else
+			{
+				newact &= ~(1UL << pin);
+			}
+		}
+
+		uint32_t rise = newact & ~active;
+		uint32_t fall = active & ~newact;
+
+		if (rise | fall)
+		{
+			pEvtMem[w].Tick = t;
+			pEvtMem[w].HiMask = (rise & ~actlow) | (fall & actlow);
+			pEvtMem[w].LoMask = (rise & actlow) | (fall & ~actlow);
+			w++;
+		}
+		active = newact;
+	}
+
+	pProg->pPins = pDesc->pPins;
+	pProg->NbPins = pDesc->NbPins;
+	pProg->pEvt = pEvtMem;
+	pProg->NbEvt = w;
+	pProg->PeriodTick = pDesc->nsPeriod > 0 ? period : last;
+	pProg->Freq = Freq;
+	pProg->IdleHiMask = actlow & pinmask;
+	pProg->IdleLoMask = ~actlow & pinmask;
+
+	return true;
+}
+
+bool PulseTrainCompileCfg(PULSE_TRAIN_PROG * const pProg, const PULSE_TRAIN_CFG * const pCfg,
+						  uint32_t Freq, PULSE_TRAIN_EVT *pEvtMem, int MaxEvt)
+{
+	if (pCfg == NULL || pCfg->NbPins <= 0 || pCfg->NbPins > PULSE_TRAIN_MAX_PIN)
+	{
+		return false;
+	}
+
+	PULSE_TRAIN_PULSE pulses[PULSE_TRAIN_MAX_PIN];
+	uint32_t nsperiod = pCfg->Period * 1000UL;
+	PULSE_TRAIN_DESC desc = {
+		pCfg->pPins, pCfg->NbPins, pCfg->Pol, NULL, pulses, pCfg->NbPins,
+		2 * pCfg->NbPins * nsperiod
+	};
+
+	// Each pin is toggled once per loop, in turn
+	for (int i = 0; i < pCfg->NbPins; i++)
+	{
+		pulses[i].Pin = i;
+		pulses[i].nsStart = i * nsperiod;
+		pulses[i].nsWidth = pCfg->NbPins * nsperiod;
+	}
+
+	return PulseTrainCompile(pProg, &desc, Freq, pEvtMem, MaxEvt);
+}
@@ -0,0 +1,369 @@
+/**-------------------------------------------------------------------------
+@file	pulse_train_sched.cpp
+
+@brief	Asynchronous pulse train player
+
+Plays PulseTrainCompile output from a Timer trigger. See pulse_train.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include "iopinctrl.h"
+#include "pulse_train.h"
+
+PulseTrainSched::PulseTrainSched()
+{
+	vpTimer = NULL;
+	vTrigNo = -1;
+	vpHwLink = NULL;
+	vpProg = NULL;
+	vDoneCB = NULL;
+	vpDoneCtx = NULL;
+	vbRunning = false;
+	vbEnd = true;
+	vLoop = 0;
+	vLoopCnt = 0;
+	vIdx = 0;
+	vStartTick = 0;
+	vArmHead = 0;
+	vArmCnt = 0;
+
+	ResetStats();
+}
+
+bool PulseTrainSched::Init(Timer * const pTimer, int TrigNo, PulseTrainHwLink * const pHwLink)
+{
+	if (pTimer == NULL)
+	{
+		return false;
+	}
+
+	if (TrigNo < 0)
+	{
+		TrigNo = pTimer->FindAvailTimerTrigger();
+	}
+
+	if (TrigNo < 0 || TrigNo >= pTimer->MaxTimerTrigger())
+	{
+		return false;
+	}
+
+	if (pHwLink != NULL && (pHwLink->Depth() <= 0 || pHwLink->Depth() > PULSE_TRAIN_HWLINK_MAXDEPTH))
+	{
+		return false;
+	}
+
+	Stop();
+
+	vpTimer = pTimer;
+	vTrigNo = TrigNo;
+	vpHwLink = pHwLink;
+
+	return true;
+}
+
+bool PulseTrainSched::Start(const PULSE_TRAIN_PROG * const pProg, uint32_t Loop,
+							PULSE_TRAIN_DONECB DoneCB, void * const pCtx)
+{
+	if (vpTimer == NULL || pProg == NULL || pProg->pEvt == NULL || pProg->NbEvt <= 0 ||
+		pProg->NbPins <= 0 || pProg->NbPins > PULSE_TRAIN_MAX_PIN || pProg->PeriodTick == 0 ||
+		pProg->Freq != vpTimer->Frequency())
+	{
+		return false;
+	}
+
+	Stop();
+
+	for (int i = 0; i < pProg->NbPins; i++)
+	{
+		IOPinConfig(pProg->pPins[i].PortNo, pProg->pPins[i].PinNo, pProg->pPins[i].PinOp,
+					IOPINDIR_OUTPUT, IOPINRES_NONE, IOPINTYPE_NORMAL);
+	}
+
+	vpProg = pProg;
+	Output(pProg->IdleHiMask, pProg->IdleLoMask);
+
+	vDoneCB = DoneCB;
+	vpDoneCtx = pCtx;
+	vLoop = Loop;
+	vLoopCnt = 0;
+	vIdx = 0;
+	vArmHead = 0;
+	vArmCnt = 0;
+	vbEnd = false;
+	vStartTick = vpTimer->TickCount();
+	vbRunning = true;
+
+	// Events at tick 0 are played now
+	if (vpHwLink)
+	{
+		ProcessHw();
+	}
+	else
+	{
+		Process();
+	}
+
+	return true;
+}
+
+void PulseTrainSched::Stop()
+{
+	vbRunning = false;
+
+	if (vpTimer)
+	{
+		vpTimer->DisableTimerTrigger(vTrigNo);
+	}
+	if (vpHwLink)
+	{
+		vpHwLink->Disarm();
+	}
+	vArmCnt = 0;
+
+	if (vpProg)
+	{
+		Output(vpProg->IdleHiMask, vpProg->IdleLoMask);
+	}
+}
+
+void PulseTrainSched::ResetStats()
+{
+	vEvtCnt = 0;
+	vLateCnt = 0;
+	vLateMax = 0;
+	vLateSum = 0;
+	vIrqCnt = 0;
+}
+
+void PulseTrainSched::Output(uint32_t HiMask, uint32_t LoMask)
+{
+	for (int i = 0; i < vpProg->NbPins; i++)
+	{
+		uint32_t bit = 1UL << i;
+
+		if (HiMask & bit)
+		{
+			IOPinSet(vpProg->pPins[i].PortNo, vpProg->pPins[i].PinNo);
+		}
+		else if (LoMask & bit)
+		{
+			IOPinClear(vpProg->pPins[i].PortNo, vpProg->pPins[i].PinNo);
+		}
+	}
+}
+
+void PulseTrainSched::TimerTrigHandler(Timer * const pTimer, int TrigNo, void * const pContext)
+{
+	PulseTrainSched *sched = (PulseTrainSched*)pContext;
+
+	sched->vIrqCnt++;
+
+	if (sched->vpHwLink)
+	{
+		sched->ProcessHw();
+	}
+	else
+	{
+		sched->Process();
+	}
+}
+
+/**
+ * @brief	Absolute tick of next event.
+ */
+uint64_t PulseTrainSched::Target()
+{
+	return vStartTick + vpProg->pEvt[vIdx].Tick;
+}
+
+/**
+ * @brief	Move to next event, wrapping to next period.
+ *
+ * @return	false - last event of last period was consumed
+ */
+bool PulseTrainSched::Next()
+{
+	if (++vIdx >= vpProg->NbEvt)
+	{
+		vIdx = 0;
+		vStartTick += vpProg->PeriodTick;
+		vLoopCnt++;
+		if (vLoop > 0 && vLoopCnt >= vLoop)
+		{
+			vbEnd = true;
+		}
+	}
+
+	return vbEnd == false;
+}
+
+/**
+ * @brief	Wake up at Tick. Timer trigger is single shot and relative.
+ */
+void PulseTrainSched::Wakeup(uint64_t Tick)
+{
+	uint64_t now = vpTimer->TickCount();
+	uint64_t dt = Tick > now ? Tick - now : 1;
+
+	// Round up so that it never fires before Tick
+	uint64_t ns = (dt * 1000000000ULL + vpProg->Freq - 1) / vpProg->Freq;
+
+	vpTimer->EnableTimerTrigger(vTrigNo, ns, TIMER_TRIG_TYPE_SINGLE, TimerTrigHandler, this);
+}
+
+void PulseTrainSched::Done()
+{
+	vbRunning = false;
+	vpTimer->DisableTimerTrigger(vTrigNo);
+
+	if (vDoneCB)
+	{
+		vDoneCB(vpDoneCtx);
+	}
+}
+
+/**
+ * @brief	Play events from CPU, all events due are played at once.
+ */
+void PulseTrainSched::Process()
+{
+	while (vbRunning && vbEnd == false)
+	{
+		uint64_t t = Target();
+		uint64_t now = vpTimer->TickCount();
+
+		if (t > now)
+		{
+			Wakeup(t);
+			return;
+		}
+
+		const PULSE_TRAIN_EVT *evt = &vpProg->pEvt[vIdx];
+		uint32_t late = (uint32_t)(now - t);
+
+		Output(evt->HiMask, evt->LoMask);
+
+		vEvtCnt++;
+		if (late > 0)
+		{
+			vLateCnt++;
+			vLateSum += late;
+			vLateMax = late > vLateMax ? late : vLateMax;
+		}
+		Next();
+	}
+
+	if (vbRunning)
+	{
+		Done();
+	}
+}
+
+/**
+ * @brief	Keep hardware link filled.
+ *
+ * Wakes up halfway through armed events to refill. Events already due are
+ * played from CPU.
+ */
+void PulseTrainSched::ProcessHw()
+{
+	uint64_t now = vpTimer->TickCount();
+
+	// Retire events executed by hardware
+	while (vArmCnt > 0 && vArmTick[vArmHead] <= now)
+	{
+		vArmHead = vArmHead + 1 < PULSE_TRAIN_HWLINK_MAXDEPTH ? vArmHead + 1 : 0;
+		vArmCnt--;
+	}
+
+	while (vbRunning && vbEnd == false && vArmCnt < PULSE_TRAIN_HWLINK_MAXDEPTH && vpHwLink->Avail() > 0)
+	{
+		uint64_t t = Target();
+		const PULSE_TRAIN_EVT *evt = &vpProg->pEvt[vIdx];
+
+		if (t > now)
+		{
+			if (vpHwLink->Arm(t, evt->HiMask, evt->LoMask) == false)
+			{
+				now = vpTimer->TickCount();
+				if (t > now)
+				{
+					break;
+				}
+				// Passed while arming
+				continue;
+			}
+
+			int idx = vArmHead + vArmCnt;
+
+			vArmTick[idx < PULSE_TRAIN_HWLINK_MAXDEPTH ? idx : idx - PULSE_TRAIN_HWLINK_MAXDEPTH] = t;
+			vArmCnt++;
+		}
+		else
+		{
+			uint32_t late = (uint32_t)(now - t);
+
+			Output(evt->HiMask, evt->LoMask);
+
+			if (late > 0)
+			{
+				vLateCnt++;
+				vLateSum += late;
+				vLateMax = late > vLateMax ? late : vLateMax;
+			}
+		}
+		vEvtCnt++;
+		Next();
+	}
+
+	if (vbRunning == false)
+	{
+		return;
+	}
+
+	if (vArmCnt == 0)
+	{
+		if (vbEnd)
+		{
+			Done();
+		}
+		else
+		{
+			// Link full of events armed by someone else, poll next event
+			Wakeup(Target());
+		}
+		return;
+	}
+
+	// Last one when ending, middle one otherwise
+	int n = vbEnd ? vArmCnt - 1 : (vArmCnt - 1) >> 1;
+	int idx = vArmHead + n;
+
+	Wakeup(vArmTick[idx < PULSE_TRAIN_HWLINK_MAXDEPTH ? idx : idx - PULSE_TRAIN_HWLINK_MAXDEPTH]);
+}
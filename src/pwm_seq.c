@@ -0,0 +1,331 @@
+/**-------------------------------------------------------------------------
+@file	pwm_seq.c
+
+@brief	PWM sequence waveform engine implementation.
+
+See pwm_seq.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+#include <math.h>
+
+#include "pwm_seq.h"
+
+bool PwmSeqInit(PWMSEQ * const pSeq, const PWMSEQ_CFG * const pCfg)
+{
+	if (pSeq == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->NbFrame <= 0 ||
+		pCfg->NbChan <= 0 || pCfg->NbChan > PWMSEQ_MAX_CHAN)
+	{
+		return false;
+	}
+
+	memset(pSeq, 0, sizeof(PWMSEQ));
+
+	pSeq->pBuf[0] = pCfg->pMem;
+	pSeq->pBuf[1] = pCfg->pMem + pCfg->NbFrame * pCfg->NbChan;
+	pSeq->NbFrame = pCfg->NbFrame;
+	pSeq->NbChan = pCfg->NbChan;
+	pSeq->Repeat = pCfg->Repeat > 0 ? pCfg->Repeat : 1;
+	pSeq->Top = 0x7FFF;
+
+	for (int i = 0; i < pSeq->NbChan; i++)
+	{
+		pSeq->Chan[i].Src = PWMSEQ_SRC_CONST;
+		pSeq->Chan[i].bEnd = true;
+	}
+
+	return true;
+}
+
+bool PwmSeqSetTable(PWMSEQ * const pSeq, int Chan, const uint16_t *pTbl, uint32_t Len, uint32_t Phase, bool bLoop)
+{
+	if (Chan < 0 || Chan >= pSeq->NbChan || pTbl == NULL || Len == 0)
+	{
+		return false;
+	}
+
+	PWMSEQ_CHAN *ch = &pSeq->Chan[Chan];
+
+	ch->Src = PWMSEQ_SRC_TABLE;
+	ch->pTbl = pTbl;
+	ch->Len = Len;
+	ch->Phase = Phase % Len;
+	ch->bLoop = bLoop;
+	ch->Idx = ch->Phase;
+	ch->bEnd = false;
+
+	return true;
+}
+
+bool PwmSeqSetStream(PWMSEQ * const pSeq, int Chan, PWMSEQ_FILLCB FillCB, void *pCtx)
+{
+	if (Chan < 0 || Chan >= pSeq->NbChan || FillCB == NULL)
+	{
+		return false;
+	}
+
+	PWMSEQ_CHAN *ch = &pSeq->Chan[Chan];
+
+	ch->Src = PWMSEQ_SRC_STREAM;
+	ch->FillCB = FillCB;
+	ch->pCtx = pCtx;
+	ch->bEnd = false;
+
+	return true;
+}
+
+bool PwmSeqSetConst(PWMSEQ * const pSeq, int Chan, uint16_t Duty)
+{
+	if (Chan < 0 || Chan >= pSeq->NbChan)
+	{
+		return false;
+	}
+
+	PWMSEQ_CHAN *ch = &pSeq->Chan[Chan];
+
+	ch->Src = PWMSEQ_SRC_CONST;
+	ch->Last = Duty;
+	ch->bEnd = true;
+
+	return true;
+}
+
+void PwmSeqRewind(PWMSEQ * const pSeq)
+{
+	for (int i = 0; i < pSeq->NbChan; i++)
+	{
+		PWMSEQ_CHAN *ch = &pSeq->Chan[i];
+
+		ch->Idx = ch->Phase;
+		ch->bEnd = ch->Src == PWMSEQ_SRC_CONST;
+	}
+	pSeq->FillCnt = 0;
+	pSeq->SampleCnt = 0;
+}
+
+/**
+ * @brief	Fill one channel column of a half buffer.
+ *
+ * @param	pSeq	: Pointer to sequence instance
+ * @param	Chan	: Channel number
+ * @param	p		: First word of the channel in the half buffer
+ *
+ * @return	Nb of new samples written
+ */
+static int PwmSeqFillChan(PWMSEQ * const pSeq, int Chan, uint16_t *p)
+{
+	PWMSEQ_CHAN *ch = &pSeq->Chan[Chan];
+	const int stride = pSeq->NbChan;
+	const uint32_t top = pSeq->Top;
+	const uint16_t flag = ch->Flag;
+	int n = 0;
+
+	if (ch->Src == PWMSEQ_SRC_TABLE)
+	{
+		while (ch->bEnd == false && n < pSeq->NbFrame)
+		{
+			uint32_t cnt = ch->Len - ch->Idx;
+			const uint16_t *s = &ch->pTbl[ch->Idx];
+
+			if (cnt > (uint32_t)(pSeq->NbFrame - n))
+			{
+				cnt = pSeq->NbFrame - n;
+			}
+
+			for (uint32_t i = 0; i < cnt; i++, p += stride)
+			{
+				*p = PwmDutyToCmp(s[i], top) | flag;
+			}
+
+			ch->Last = s[cnt - 1];
+			ch->Idx += cnt;
+			n += cnt;
+
+			if (ch->Idx >= ch->Len)
+			{
+				ch->Idx = 0;
+				ch->bEnd = !ch->bLoop;
+			}
+		}
+	}
+	else if (ch->Src == PWMSEQ_SRC_STREAM)
+	{
+		uint16_t buf[PWMSEQ_FILL_CHUNK];
+
+		while (ch->bEnd == false && n < pSeq->NbFrame)
+		{
+			int req = pSeq->NbFrame - n;
+
+			req = req < PWMSEQ_FILL_CHUNK ? req : PWMSEQ_FILL_CHUNK;
+
+			int cnt = ch->FillCB(ch->pCtx, Chan, buf, req);
+
+			cnt = cnt < 0 ? 0 : (cnt > req ? req : cnt);
+
+			for (int i = 0; i < cnt; i++, p += stride)
+			{
+				*p = PwmDutyToCmp(buf[i], top) | flag;
+			}
+
+			if (cnt > 0)
+			{
+				ch->Last = buf[cnt - 1];
+			}
+			n += cnt;
+
+			if (cnt < req)
+			{
+				ch->bEnd = true;
+			}
+		}
+	}
+
+	if (n < pSeq->NbFrame)
+	{
+		// Hold last value
+		uint16_t hold = PwmDutyToCmp(ch->Last, top) | flag;
+
+		for (int i = n; i < pSeq->NbFrame; i++, p += stride)
+		{
+			*p = hold;
+		}
+	}
+
+	return n;
+}
+
+int PwmSeqFill(PWMSEQ * const pSeq, int Half)
+{
+	uint16_t *p = pSeq->pBuf[Half & 1];
+	int n = 0;
+
+	for (int i = 0; i < pSeq->NbChan; i++)
+	{
+		int cnt = PwmSeqFillChan(pSeq, i, p + i);
+
+		n = cnt > n ? cnt : n;
+	}
+
+	pSeq->FillCnt++;
+	pSeq->SampleCnt += n;
+
+	return n;
+}
+
+bool PwmSeqDone(PWMSEQ * const pSeq)
+{
+	for (int i = 0; i < pSeq->NbChan; i++)
+	{
+		if (pSeq->Chan[i].bEnd == false)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static inline uint16_t PwmWaveClip(int32_t v)
+{
+	return v < 0 ? 0 : (v > PWM_DUTY_MAX ? PWM_DUTY_MAX : (uint16_t)v);
+}
+
+void PwmWaveSine(uint16_t *pTbl, uint32_t Len, uint16_t Min, uint16_t Max)
+{
+	float mid = ((float)Min + (float)Max) * 0.5f;
+	float amp = ((float)Max - (float)Min) * 0.5f;
+	float w = 2.0f * (float)M_PI / (float)Len;
+
+	for (uint32_t i = 0; i < Len; i++)
+	{
+		pTbl[i] = PwmWaveClip((int32_t)floorf(mid + amp * sinf(w * (float)i) + 0.5f));
+	}
+}
+
+void PwmWaveRamp(uint16_t *pTbl, uint32_t Len, uint16_t Start, uint16_t End)
+{
+	if (Len == 1)
+	{
+		pTbl[0] = Start;
+		return;
+	}
+
+	int32_t d = (int32_t)End - (int32_t)Start;
+	int32_t div = (int32_t)Len - 1;
+
+	for (uint32_t i = 0; i < Len; i++)
+	{
+		int32_t x = d * (int32_t)i;
+
+		// Round half away from 0 so that the ramp is symmetric
+		x = x >= 0 ? (x + (div >> 1)) / div : (x - (div >> 1)) / div;
+		pTbl[i] = PwmWaveClip(Start + x);
+	}
+}
+
+/**
+ * @brief	Linear segment, excluding From, ending on To.
+ */
+static uint16_t *PwmWaveSegment(uint16_t *p, uint32_t Len, uint16_t From, uint16_t To)
+{
+	int32_t d = (int32_t)To - (int32_t)From;
+	int64_t h = Len >> 1;
+
+	for (uint32_t i = 1; i <= Len; i++)
+	{
+		int64_t x = (int64_t)d * i;
+
+		x = x >= 0 ? (x + h) / Len : (x - h) / (int64_t)Len;
+		*p++ = PwmWaveClip(From + (int32_t)x);
+	}
+
+	return p;
+}
+
+uint32_t PwmWaveAdsr(uint16_t *pTbl, uint32_t MaxLen, const PWMWAVE_ADSR *pEnv)
+{
+	uint32_t len = pEnv->Attack + pEnv->Decay + pEnv->Hold + pEnv->Release;
+
+	if (len > MaxLen)
+	{
+		return 0;
+	}
+
+	uint16_t *p = PwmWaveSegment(pTbl, pEnv->Attack, 0, pEnv->Peak);
+
+	p = PwmWaveSegment(p, pEnv->Decay, pEnv->Peak, pEnv->Sustain);
+	for (uint32_t i = 0; i < pEnv->Hold; i++)
+	{
+		*p++ = pEnv->Sustain;
+	}
+	PwmWaveSegment(p, pEnv->Release, pEnv->Sustain, 0);
+
+	return len;
+}
@@ -41,6 +41,9 @@ using namespace std;
 #include "seep.h"
 #include "iopinctrl.h"
 
+/// Acknowledge polling retry interval in usec
+#define SEEP_ACKPOLL_INTERVAL		100
+
 Seep::Seep()
 {
     memset(&vDevData, 0, sizeof(SEEPDEV));
@@ -60,6 +63,11 @@ bool SeepInit(SEEPDEV * const pDev, const SEEP_CFG *pCfgData, DEVINTRF * const p
     pDev->WrProtPin = pCfgData->WrProtPin;
     pDev->WrDelay = pCfgData->WrDelay * 1000; // convert to usec
     pDev->Size = pCfgData->Size;
+    pDev->bAckPoll = pCfgData->bAckPoll;
+    pDev->bWrBusy = false;
+    pDev->NbCache = 0;
+    pDev->LastIdx = 0;
+    pDev->pCache = NULL;
 
     if (pCfgData->WrProtPin.PortNo >= 0 && pCfgData->WrProtPin.PinNo >= 0)
     {
@@ -74,7 +82,49 @@ bool SeepInit(SEEPDEV * const pDev, const SEEP_CFG *pCfgData, DEVINTRF * const p
     return true;
 }
 
-int SeepRead(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
+bool SeepWaitReady(SEEPDEV * const pDev)
+{
+	if (pDev->bWrBusy == false)
+	{
+		return true;
+	}
+
+	// Device does not acknowledge its address while internal write cycle
+	// is in progress. Poll with a current address read until it does.
+	uint32_t timeout = pDev->WrDelay + SEEP_ACKPOLL_INTERVAL;
+	uint8_t d;
+
+	do {
+		int maxrtry = pDev->pInterf->MaxRetry;
+
+		pDev->pInterf->MaxRetry = 0;
+		int l = DeviceIntrfRx(pDev->pInterf, pDev->DevAddr, &d, 1);
+		pDev->pInterf->MaxRetry = maxrtry;
+
+		if (l > 0)
+		{
+			pDev->bWrBusy = false;
+
+			return true;
+		}
+
+		if (pDev->pWaitCB)
+		{
+			pDev->pWaitCB(pDev->DevAddr, pDev->pInterf);
+		}
+		else
+		{
+			usDelay(SEEP_ACKPOLL_INTERVAL);
+		}
+
+		timeout = timeout > SEEP_ACKPOLL_INTERVAL ? timeout - SEEP_ACKPOLL_INTERVAL : 0;
+	} while (timeout > 0);
+
+	// Still busy, next access polls again
+	return false;
+}
+
+static int SeepDevRead(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
 {
     uint8_t ad[4];
     uint8_t *p = (uint8_t*)&Addr;
@@ -82,6 +132,12 @@ int SeepRead(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
     uint32_t admask = 0xFFFFFFFF << shift;
     int count = 0;
 
+    if (SeepWaitReady(pDev) == false)
+    {
+    	// Device never acknowledged
+    	return 0;
+    }
+
     while (Len > 0 && Addr < pDev->Size)
     {
         uint8_t devaddr = pDev->DevAddr;
@@ -115,7 +171,7 @@ int SeepRead(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
 }
 
 // Note: Sequential write is bound by page size boundary
-int SeepWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
+static int SeepDevWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
 {
     int count = 0;
     uint8_t ad[4];
@@ -140,12 +196,22 @@ int SeepWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
         	devaddr |= (Addr >> shift) & 7;
         }
 
+        if (SeepWaitReady(pDev) == false)
+        {
+        	break;
+        }
+
         l = DeviceIntrfWrite(pDev->pInterf, devaddr, ad, pDev->AddrLen, pData, l);
         if (l <= 0)
         {
         	break;
         }
-        if (pDev->pWaitCB)
+        if (pDev->bAckPoll)
+        {
+        	// Defer write cycle completion check to next access
+        	pDev->bWrBusy = true;
+        }
+        else if (pDev->pWaitCB)
         {
             pDev->pWaitCB(devaddr, pDev->pInterf);
         }
@@ -163,6 +229,236 @@ int SeepWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
     return count;
 }
 
+void SeepSetCache(SEEPDEV * const pDev, SEEP_CACHE_DESC * const pCache, int NbCache)
+{
+	if (pDev->pCache)
+	{
+		SeepFlush(pDev);
+	}
+
+	if (pCache == NULL || NbCache <= 0)
+	{
+		pDev->pCache = NULL;
+		pDev->NbCache = 0;
+
+		return;
+	}
+
+	for (int i = 0; i < NbCache; i++)
+	{
+		pCache[i].PageAddr = -1;
+		pCache[i].DirtyStart = 0;
+		pCache[i].DirtyEnd = 0;
+	}
+
+	pDev->pCache = pCache;
+	pDev->NbCache = NbCache;
+	pDev->LastIdx = 0;
+}
+
+static bool SeepFlushCache(SEEPDEV * const pDev, SEEP_CACHE_DESC * const pCache)
+{
+	if (pCache->DirtyEnd <= pCache->DirtyStart)
+	{
+		return true;
+	}
+
+	int l = pCache->DirtyEnd - pCache->DirtyStart;
+
+	// Dirty range is within one page, single write cycle
+	if (SeepDevWrite(pDev, pCache->PageAddr + pCache->DirtyStart, pCache->pData + pCache->DirtyStart, l) != l)
+	{
+		return false;
+	}
+
+	pCache->DirtyStart = 0;
+	pCache->DirtyEnd = 0;
+
+	return true;
+}
+
+bool SeepFlush(SEEPDEV * const pDev)
+{
+	bool retval = true;
+
+	for (int i = 0; i < pDev->NbCache; i++)
+	{
+		if (SeepFlushCache(pDev, &pDev->pCache[i]) == false)
+		{
+			retval = false;
+		}
+	}
+
+	return retval;
+}
+
+static int SeepFindCache(SEEPDEV * const pDev, uint32_t PageAddr)
+{
+	for (int i = 0; i < pDev->NbCache; i++)
+	{
+		if (pDev->pCache[i].PageAddr == PageAddr)
+		{
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+static int SeepGetCache(SEEPDEV * const pDev, uint32_t PageAddr)
+{
+	int idx = SeepFindCache(pDev, PageAddr);
+
+	if (idx >= 0)
+	{
+		return idx;
+	}
+
+	// Not in cache, pick unused or clean page first
+	for (int i = 0; i < pDev->NbCache; i++)
+	{
+		pDev->LastIdx++;
+		if (pDev->LastIdx >= pDev->NbCache)
+		{
+			pDev->LastIdx = 0;
+		}
+
+		if (pDev->pCache[pDev->LastIdx].DirtyEnd == 0)
+		{
+			idx = pDev->LastIdx;
+			break;
+		}
+	}
+
+	if (idx < 0)
+	{
+		// All dirty, evict next
+		pDev->LastIdx++;
+		if (pDev->LastIdx >= pDev->NbCache)
+		{
+			pDev->LastIdx = 0;
+		}
+		idx = pDev->LastIdx;
+
+		if (SeepFlushCache(pDev, &pDev->pCache[idx]) == false)
+		{
+			return -1;
+		}
+	}
+
+	SEEP_CACHE_DESC *c = &pDev->pCache[idx];
+
+	// Load full page so that it can be served for reads
+	c->PageAddr = -1;
+	if (SeepDevRead(pDev, PageAddr, c->pData, pDev->PageSize) != pDev->PageSize)
+	{
+		return -1;
+	}
+	c->PageAddr = PageAddr;
+	c->DirtyStart = 0;
+	c->DirtyEnd = 0;
+
+	return idx;
+}
+
+int SeepRead(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
+{
+	if (pDev->pCache == NULL)
+	{
+		return SeepDevRead(pDev, Addr, pData, Len);
+	}
+
+	int count = 0;
+
+	while (Len > 0 && Addr < pDev->Size)
+	{
+		uint32_t off = Addr % pDev->PageSize;
+		int l = min(Len, pDev->PageSize - off);
+		int idx = SeepFindCache(pDev, Addr - off);
+
+		if (idx >= 0)
+		{
+			memcpy(pData, pDev->pCache[idx].pData + off, l);
+		}
+		else
+		{
+			// Read all consecutive uncached pages in one transfer
+			while (l < Len && SeepFindCache(pDev, Addr + l) < 0)
+			{
+				l += min(Len - l, pDev->PageSize);
+			}
+
+			l = SeepDevRead(pDev, Addr, pData, l);
+			if (l <= 0)
+			{
+				break;
+			}
+		}
+
+		count += l;
+		Addr += l;
+		Len -= l;
+		pData += l;
+	}
+
+	return count;
+}
+
+int SeepWrite(SEEPDEV * const pDev, uint32_t Addr, uint8_t *pData, int Len)
+{
+	if (pDev->pCache == NULL)
+	{
+		return SeepDevWrite(pDev, Addr, pData, Len);
+	}
+
+	int count = 0;
+
+	while (Len > 0 && Addr < pDev->Size)
+	{
+		uint32_t off = Addr % pDev->PageSize;
+		int l = min(Len, pDev->PageSize - off);
+		int idx = SeepGetCache(pDev, Addr - off);
+
+		if (idx < 0)
+		{
+			// Cache not available, write through
+			l = SeepDevWrite(pDev, Addr, pData, l);
+			if (l <= 0)
+			{
+				break;
+			}
+		}
+		else
+		{
+			SEEP_CACHE_DESC *c = &pDev->pCache[idx];
+
+			// Only mark modified if data actually changed
+			if (memcmp(c->pData + off, pData, l) != 0)
+			{
+				memcpy(c->pData + off, pData, l);
+
+				if (c->DirtyEnd == 0)
+				{
+					c->DirtyStart = off;
+					c->DirtyEnd = off + l;
+				}
+				else
+				{
+					c->DirtyStart = min(c->DirtyStart, off);
+					c->DirtyEnd = max(c->DirtyEnd, off + l);
+				}
+			}
+		}
+
+		Addr += l;
+		Len -= l;
+		pData += l;
+		count += l;
+	}
+
+	return count;
+}
+
 void SeepSetWriteProt(SEEPDEV * const pDev, bool bVal)
 {
     if (pDev->WrProtPin.PortNo < 0 || pDev->WrProtPin.PinNo < 0)
@@ -0,0 +1,350 @@
+/**-------------------------------------------------------------------------
+@file	seep_kvlog.cpp
+
+@brief	Wear spreading key/value record log on Serial EEPROM
+
+See seep_kvlog.h for the storage layout.
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "crc.h"
+#include "seep_kvlog.h"
+
+static inline uint32_t SeepKvLogBankAddr(SEEP_KVLOG * const pLog, int Bank)
+{
+	return pLog->StartAddr + Bank * pLog->BankSize;
+}
+
+static bool SeepKvLogReadHdr(SEEP_KVLOG * const pLog, int Bank, uint16_t *pGen)
+{
+	uint16_t hdr[SEEP_KVLOG_HDRSIZE / 2];
+
+	if (SeepRead(pLog->pSeep, SeepKvLogBankAddr(pLog, Bank), (uint8_t*)hdr, SEEP_KVLOG_HDRSIZE) != SEEP_KVLOG_HDRSIZE)
+	{
+		return false;
+	}
+
+	if (hdr[0] != SEEP_KVLOG_MAGIC || hdr[1] != (uint16_t)~hdr[2])
+	{
+		return false;
+	}
+
+	*pGen = hdr[1];
+
+	return true;
+}
+
+static bool SeepKvLogWriteHdr(SEEP_KVLOG * const pLog, int Bank, uint16_t Gen)
+{
+	uint16_t hdr[SEEP_KVLOG_HDRSIZE / 2] = { SEEP_KVLOG_MAGIC, Gen, (uint16_t)~Gen, 0xFFFF };
+
+	if (SeepWrite(pLog->pSeep, SeepKvLogBankAddr(pLog, Bank), (uint8_t*)hdr, SEEP_KVLOG_HDRSIZE) != SEEP_KVLOG_HDRSIZE)
+	{
+		return false;
+	}
+
+	return SeepFlush(pLog->pSeep);
+}
+
+// Read and validate record at offset Off of the active bank. Returns data length
+// or -1 if end of log or invalid record.  pRec receives Key, Len & Data
+static int SeepKvLogReadRec(SEEP_KVLOG * const pLog, int Bank, uint16_t Gen, uint32_t Off, uint8_t *pRec)
+{
+	uint32_t addr = SeepKvLogBankAddr(pLog, Bank) + Off;
+
+	if (Off + SEEP_KVLOG_RECOVR > pLog->BankSize)
+	{
+		return -1;
+	}
+
+	if (SeepRead(pLog->pSeep, addr, pRec, 2) != 2)
+	{
+		return -1;
+	}
+
+	int len = pRec[1];
+
+	if (pRec[0] >= SEEP_KVLOG_MAXKEY || len > SEEP_KVLOG_MAXDATALEN ||
+		Off + len + SEEP_KVLOG_RECOVR > pLog->BankSize)
+	{
+		// End marker (0xFF) or garbage
+		return -1;
+	}
+
+	if (SeepRead(pLog->pSeep, addr + 2, &pRec[2], len + 1) != len + 1)
+	{
+		return -1;
+	}
+
+	if (crc8_ccitt(pRec, len + 2, (uint8_t)Gen) != pRec[len + 2])
+	{
+		// Torn write
+		return -1;
+	}
+
+	return len;
+}
+
+// Append record & end marker at current write offset
+static bool SeepKvLogAppend(SEEP_KVLOG * const pLog, uint8_t *pRec, int Len)
+{
+	uint32_t addr = SeepKvLogBankAddr(pLog, pLog->CurBank) + pLog->WrOff;
+	int l = Len + SEEP_KVLOG_RECOVR;
+
+	pRec[Len + 2] = crc8_ccitt(pRec, Len + 2, (uint8_t)pLog->Gen);
+
+	// Only write end marker if there is room for it.  An end of bank also
+	// terminates the log
+	if (pLog->WrOff + l < pLog->BankSize)
+	{
+		pRec[l++] = 0xFF;
+	}
+
+	if (SeepWrite(pLog->pSeep, addr, pRec, l) != l)
+	{
+		return false;
+	}
+
+	if (SeepFlush(pLog->pSeep) == false)
+	{
+		return false;
+	}
+
+	pLog->KeyOff[pRec[0]] = pLog->WrOff;
+	pLog->WrOff += Len + SEEP_KVLOG_RECOVR;
+
+	return true;
+}
+
+// Copy latest records to the other bank.  The new bank header is written last
+// so that an interrupted compaction leaves the current bank active.
+static bool SeepKvLogCompact(SEEP_KVLOG * const pLog)
+{
+	uint8_t rec[SEEP_KVLOG_MAXDATALEN + SEEP_KVLOG_RECOVR + 1];
+	uint16_t keyoff[SEEP_KVLOG_MAXKEY];
+	int oldbank = pLog->CurBank;
+	uint16_t oldgen = pLog->Gen;
+	uint32_t oldwroff = pLog->WrOff;
+	int bank = oldbank ^ 1;
+	uint32_t hdr = 0xFFFFFFFF;
+	bool res = true;
+
+	// Invalidate target bank
+	if (SeepWrite(pLog->pSeep, SeepKvLogBankAddr(pLog, bank), (uint8_t*)&hdr, 4) != 4)
+	{
+		return false;
+	}
+
+	memcpy(keyoff, pLog->KeyOff, sizeof(keyoff));
+	memset(pLog->KeyOff, 0, sizeof(pLog->KeyOff));
+	pLog->CurBank = bank;
+	pLog->Gen = oldgen + 1;
+	pLog->WrOff = SEEP_KVLOG_HDRSIZE;
+
+	for (int i = 0; i < SEEP_KVLOG_MAXKEY; i++)
+	{
+		if (keyoff[i] == 0)
+		{
+			continue;
+		}
+
+		int len = SeepKvLogReadRec(pLog, oldbank, oldgen, keyoff[i], rec);
+
+		if (len < 0 || SeepKvLogAppend(pLog, rec, len) == false)
+		{
+			res = false;
+			break;
+		}
+	}
+
+	if (res == false || SeepKvLogWriteHdr(pLog, bank, pLog->Gen) == false)
+	{
+		// Revert to old bank, it is still intact
+		pLog->CurBank = oldbank;
+		pLog->Gen = oldgen;
+		memcpy(pLog->KeyOff, keyoff, sizeof(keyoff));
+		pLog->WrOff = oldwroff;
+
+		return false;
+	}
+
+	pLog->CompactCnt++;
+
+	return true;
+}
+
+bool SeepKvLogFormat(SEEP_KVLOG * const pLog)
+{
+	uint8_t d[SEEP_KVLOG_HDRSIZE + 1];
+
+	memset(d, 0xFF, sizeof(d));
+
+	// Invalidate both banks
+	if (SeepWrite(pLog->pSeep, SeepKvLogBankAddr(pLog, 1), d, SEEP_KVLOG_HDRSIZE) != SEEP_KVLOG_HDRSIZE)
+	{
+		return false;
+	}
+
+	if (SeepWrite(pLog->pSeep, SeepKvLogBankAddr(pLog, 0), d, SEEP_KVLOG_HDRSIZE + 1) != SEEP_KVLOG_HDRSIZE + 1)
+	{
+		return false;
+	}
+
+	pLog->CurBank = 0;
+	pLog->Gen = 0;
+	pLog->WrOff = SEEP_KVLOG_HDRSIZE;
+	memset(pLog->KeyOff, 0, sizeof(pLog->KeyOff));
+
+	return SeepKvLogWriteHdr(pLog, 0, 0);
+}
+
+bool SeepKvLogInit(SEEP_KVLOG * const pLog, SEEPDEV * const pSeep, uint32_t StartAddr, uint32_t Size)
+{
+	uint16_t gen[2];
+	bool valid[2];
+	uint8_t rec[SEEP_KVLOG_MAXDATALEN + SEEP_KVLOG_RECOVR + 1];
+
+	if (pLog == NULL || pSeep == NULL || StartAddr + Size > SeepGetSize(pSeep))
+	{
+		return false;
+	}
+
+	pLog->pSeep = pSeep;
+	pLog->StartAddr = StartAddr;
+	// Record offsets are 16 bits
+	pLog->BankSize = Size / 2 > 0xFFFF ? 0xFFFF : Size / 2;
+	pLog->CompactCnt = 0;
+
+	if (pLog->BankSize < SEEP_KVLOG_HDRSIZE + SEEP_KVLOG_MAXDATALEN + SEEP_KVLOG_RECOVR + 1)
+	{
+		return false;
+	}
+
+	valid[0] = SeepKvLogReadHdr(pLog, 0, &gen[0]);
+	valid[1] = SeepKvLogReadHdr(pLog, 1, &gen[1]);
+
+	if (valid[0] == false && valid[1] == false)
+	{
+		return SeepKvLogFormat(pLog);
+	}
+
+	// Most recent generation wins, rollover safe compare
+	if (valid[0] && valid[1])
+	{
+		pLog->CurBank = (int16_t)(gen[1] - gen[0]) > 0 ? 1 : 0;
+	}
+	else
+	{
+		pLog->CurBank = valid[1] ? 1 : 0;
+	}
+
+	pLog->Gen = gen[pLog->CurBank];
+	pLog->WrOff = SEEP_KVLOG_HDRSIZE;
+	memset(pLog->KeyOff, 0, sizeof(pLog->KeyOff));
+
+	while (true)
+	{
+		int len = SeepKvLogReadRec(pLog, pLog->CurBank, pLog->Gen, pLog->WrOff, rec);
+
+		if (len < 0)
+		{
+			break;
+		}
+
+		pLog->KeyOff[rec[0]] = pLog->WrOff;
+		pLog->WrOff += len + SEEP_KVLOG_RECOVR;
+	}
+
+	return true;
+}
+
+int SeepKvLogRead(SEEP_KVLOG * const pLog, uint8_t Key, uint8_t *pBuff, int BuffLen)
+{
+	uint8_t rec[SEEP_KVLOG_MAXDATALEN + SEEP_KVLOG_RECOVR + 1];
+
+	if (Key >= SEEP_KVLOG_MAXKEY || pLog->KeyOff[Key] == 0)
+	{
+		return -1;
+	}
+
+	int len = SeepKvLogReadRec(pLog, pLog->CurBank, pLog->Gen, pLog->KeyOff[Key], rec);
+
+	if (len < 0)
+	{
+		return -1;
+	}
+
+	len = len < BuffLen ? len : BuffLen;
+	memcpy(pBuff, &rec[2], len);
+
+	return len;
+}
+
+int SeepKvLogWrite(SEEP_KVLOG * const pLog, uint8_t Key, uint8_t *pData, int Len)
+{
+	uint8_t rec[SEEP_KVLOG_MAXDATALEN + SEEP_KVLOG_RECOVR + 1];
+
+	if (Key >= SEEP_KVLOG_MAXKEY || Len < 0 || Len > SEEP_KVLOG_MAXDATALEN)
+	{
+		return -1;
+	}
+
+	if (pLog->KeyOff[Key] != 0)
+	{
+		int l = SeepKvLogReadRec(pLog, pLog->CurBank, pLog->Gen, pLog->KeyOff[Key], rec);
+
+		if (l == Len && memcmp(&rec[2], pData, Len) == 0)
+		{
+			// Unchanged, save a write cycle
+			return Len;
+		}
+	}
+
+	if (pLog->WrOff + Len + SEEP_KVLOG_RECOVR > pLog->BankSize)
+	{
+		if (SeepKvLogCompact(pLog) == false ||
+			pLog->WrOff + Len + SEEP_KVLOG_RECOVR > pLog->BankSize)
+		{
+			return -1;
+		}
+	}
+
+	rec[0] = Key;
+	rec[1] = Len;
+	memcpy(&rec[2], pData, Len);
+
+	if (SeepKvLogAppend(pLog, rec, Len) == false)
+	{
+		return -1;
+	}
+
+	return Len;
+}
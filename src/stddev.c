@@ -29,10 +29,12 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ----------------------------------------------------------------------------
 Modified by          Date              Description
+Hoan				Oct. 19, 2026		Non-blocking descriptors, stream buffers & poll
 
 ----------------------------------------------------------------------------*/
 #include <stdlib.h>
 #include <string.h>
+#include <errno.h>
 #ifdef __ICCARM__
 #define STDIN_FILENO    0       /* standard input file descriptor */
 #define STDOUT_FILENO   1       /* standard output file descriptor */
@@ -46,12 +48,110 @@ Modified by          Date              Description
 #define STDDEV_FDIDX_MASK		0xF
 #define STDDEV_FDIDX_NBITS		4
 
+#define STDDEV_FLAG_NONBLOCK	1
 
+/// Stream buffer, free running counters
+typedef struct {
+	uint8_t *pMem;
+	uint32_t Size;
+	volatile uint32_t PutCnt;
+	volatile uint32_t GetCnt;
+} STDDEV_BUFF;
+
+/// Per device slot state
+typedef struct {
+	uint32_t Flags;
+	int Handle;				// Device handle of buffered descriptor
+	STDDEV_BUFF Rx;
+	STDDEV_BUFF Tx;
+} STDDEV_SLOT;
 
 STDDEV *g_DevTable[STDDEV_MAX] = {
 	NULL,
 };
 
+static STDDEV_SLOT s_DevSlot[STDDEV_MAX];
+
+/**
+ * @brief	Get device slot of descriptor
+ *
+ * @param	Fd		: Descriptor
+ * @param	pHandle	: On return, device handle
+ *
+ * @return	Slot index, -1 if not installed
+ */
+static int StdDevIdx(int Fd, int *pHandle)
+{
+	int idx = Fd & STDDEV_FDIDX_MASK;
+
+	if (Fd < 0 || idx >= STDDEV_MAX || g_DevTable[idx] == NULL)
+		return -1;
+
+	*pHandle = idx >= STDFS_FILENO ? Fd >> STDDEV_FDIDX_NBITS : Fd;
+
+	return idx;
+}
+
+static inline uint32_t StdDevBuffUsed(STDDEV_BUFF * const pBuff)
+{
+	return pBuff->PutCnt - pBuff->GetCnt;
+}
+
+static int StdDevPollDev(int Idx, int Handle, int Events)
+{
+	STDDEV *dev = g_DevTable[Idx];
+
+	if (dev->Poll)
+		return dev->Poll(dev->pDevObj, Handle, Events) & (Events | STDDEV_POLLERR);
+
+	// No readiness function, device always ready
+	return Events & ((dev->Read ? STDDEV_POLLIN : 0) | (dev->Write ? STDDEV_POLLOUT : 0));
+}
+
+/**
+ * @brief	Exchange stream buffers of a slot with its device, without blocking
+ */
+static void StdDevPump(int Idx)
+{
+	STDDEV *dev = g_DevTable[Idx];
+	STDDEV_SLOT *slot = &s_DevSlot[Idx];
+	STDDEV_BUFF *b = &slot->Tx;
+
+	while (b->pMem && StdDevBuffUsed(b) > 0 && StdDevPollDev(Idx, slot->Handle, STDDEV_POLLOUT))
+	{
+		uint32_t i = b->GetCnt % b->Size;
+		uint32_t l = b->Size - i;
+
+		l = l < StdDevBuffUsed(b) ? l : StdDevBuffUsed(b);
+
+		int n = dev->Write(dev->pDevObj, slot->Handle, &b->pMem[i], l);
+		if (n <= 0)
+			break;
+
+		b->GetCnt += n;
+		if (n < l)
+			break;
+	}
+
+	b = &slot->Rx;
+	while (b->pMem && StdDevBuffUsed(b) < b->Size && StdDevPollDev(Idx, slot->Handle, STDDEV_POLLIN))
+	{
+		uint32_t i = b->PutCnt % b->Size;
+		uint32_t l = b->Size - i;
+		uint32_t avail = b->Size - StdDevBuffUsed(b);
+
+		l = l < avail ? l : avail;
+
+		int n = dev->Read(dev->pDevObj, slot->Handle, &b->pMem[i], l);
+		if (n <= 0)
+			break;
+
+		b->PutCnt += n;
+		if (n < l)
+			break;
+	}
+}
+
 int InstallBlkDev(STDDEV * const pDev, int MapId)
 {
 	int retval = -1;
@@ -77,6 +177,7 @@ int InstallBlkDev(STDDEV * const pDev, int MapId)
 	}
 	if (retval >= 0)
 	{
+		memset(&s_DevSlot[retval], 0, sizeof(STDDEV_SLOT));
 		g_DevTable[retval] = pDev;
 	}
 
@@ -86,7 +187,109 @@ int InstallBlkDev(STDDEV * const pDev, int MapId)
 void RemoveBlkDev(int Idx)
 {
 	if (Idx >=0 && Idx < STDDEV_MAX)
+	{
 		g_DevTable[Idx] = NULL;
+		memset(&s_DevSlot[Idx], 0, sizeof(STDDEV_SLOT));
+	}
+}
+
+int StdDevSetNonBlock(int Fd, bool bNonBlock)
+{
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
+
+	if (idx < 0)
+		return -1;
+
+	if (bNonBlock)
+		s_DevSlot[idx].Flags |= STDDEV_FLAG_NONBLOCK;
+	else
+		s_DevSlot[idx].Flags &= ~STDDEV_FLAG_NONBLOCK;
+
+	return 0;
+}
+
+int StdDevSetBuffer(int Fd, uint8_t *pRxMem, size_t RxSize, uint8_t *pTxMem, size_t TxSize)
+{
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
+
+	// File system slot is shared by all its files
+	if (idx < 0 || idx == STDFS_FILENO)
+		return -1;
+
+	STDDEV_SLOT *slot = &s_DevSlot[idx];
+
+	slot->Handle = handle;
+	slot->Rx.pMem = RxSize > 0 ? pRxMem : NULL;
+	slot->Rx.Size = RxSize;
+	slot->Rx.PutCnt = slot->Rx.GetCnt = 0;
+	slot->Tx.pMem = TxSize > 0 ? pTxMem : NULL;
+	slot->Tx.Size = TxSize;
+	slot->Tx.PutCnt = slot->Tx.GetCnt = 0;
+
+	return 0;
+}
+
+int StdDevPoll(STDDEV_POLLFD *pFds, int NbFds)
+{
+	int cnt = 0;
+
+	for (int i = 0; i < NbFds; i++)
+	{
+		int handle;
+		int idx = StdDevIdx(pFds[i].Fd, &handle);
+		int ev = 0;
+
+		if (idx < 0)
+		{
+			pFds[i].REvents = STDDEV_POLLNVAL;
+			cnt++;
+			continue;
+		}
+
+		STDDEV_SLOT *slot = &s_DevSlot[idx];
+
+		if (slot->Rx.pMem || slot->Tx.pMem)
+		{
+			StdDevPump(idx);
+		}
+
+		if (slot->Rx.pMem && (pFds[i].Events & STDDEV_POLLIN))
+		{
+			ev |= StdDevBuffUsed(&slot->Rx) > 0 ? STDDEV_POLLIN : 0;
+		}
+		else
+		{
+			ev |= StdDevPollDev(idx, handle, pFds[i].Events & (STDDEV_POLLIN | STDDEV_POLLERR));
+		}
+
+		if (slot->Tx.pMem && (pFds[i].Events & STDDEV_POLLOUT))
+		{
+			ev |= StdDevBuffUsed(&slot->Tx) < slot->Tx.Size ? STDDEV_POLLOUT : 0;
+		}
+		else
+		{
+			ev |= StdDevPollDev(idx, handle, pFds[i].Events & STDDEV_POLLOUT);
+		}
+
+		pFds[i].REvents = ev;
+		if (ev)
+			cnt++;
+	}
+
+	return cnt;
+}
+
+void StdDevProcess(void)
+{
+	for (int i = 0; i < STDDEV_MAX; i++)
+	{
+		if (g_DevTable[i] && (s_DevSlot[i].Rx.pMem || s_DevSlot[i].Tx.pMem))
+		{
+			StdDevPump(i);
+		}
+	}
 }
 
 int _open(const char * const pPathName, int Flags, int Mode)
@@ -102,6 +305,9 @@ int _open(const char * const pPathName, int Flags, int Mode)
 
 	if (p == NULL || strncmp(pPathName, "FAT:", 4) == 0)
 	{
+		if (g_DevTable[STDFS_FILENO] == NULL)
+			return -1;
+
 		retval = g_DevTable[STDFS_FILENO]->Open(g_DevTable[STDFS_FILENO]->pDevObj, pPathName, Flags, Mode);
 		if (retval != -1)
 		{
@@ -110,17 +316,23 @@ int _open(const char * const pPathName, int Flags, int Mode)
 	}
 	else
 	{
-		// check for named device
+		// check for named device, name is the path prefix up to ':'
+		int l = p - pPathName;
+
 		for (int i = STDFS_FILENO; i < STDDEV_MAX; i++)
 		{
-			if (strncmp(g_DevTable[i]->Name, pPathName, 4) == 0)
+			STDDEV *dev = g_DevTable[i];
+
+			if (dev && dev->Open && strncmp(dev->Name, pPathName, l) == 0 &&
+				(l >= STDDEV_NAME_MAX || dev->Name[l] == 0 || dev->Name[l] == ':'))
 			{
-				retval = g_DevTable[i]->Open(g_DevTable[i]->pDevObj, pPathName, Flags, Mode);
+				retval = dev->Open(dev->pDevObj, pPathName, Flags, Mode);
 
 				if (retval != -1)
 				{
 					retval = (retval << 4) | i;
 				}
+				break;
 			}
 		}
 	}
@@ -130,66 +342,133 @@ int _open(const char * const pPathName, int Flags, int Mode)
 
 int _close(int Fd)
 {
-	int idx = Fd & STDDEV_FDIDX_MASK;
-
-	if (idx < 0 || idx >= STDDEV_MAX)
-		return -1;
-
-	if (idx >= STDFS_FILENO)
-		Fd >>= STDDEV_FDIDX_NBITS;
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
 
-	if (g_DevTable[idx] && g_DevTable[idx]->Close)
-		return g_DevTable[idx]->Close(g_DevTable[idx]->pDevObj, Fd);
+	if (idx >= 0 && g_DevTable[idx]->Close)
+		return g_DevTable[idx]->Close(g_DevTable[idx]->pDevObj, handle);
 
 	return -1;
 }
 
 int _lseek(int Fd, int Offset)
 {
-	int idx = Fd & STDDEV_FDIDX_MASK;
-
-	if (idx < 0 || idx >= STDDEV_MAX)
-		return -1;
-
-	if (idx >= STDFS_FILENO)
-		Fd >>= STDDEV_FDIDX_NBITS;
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
 
-	if (g_DevTable[idx]  && g_DevTable[idx]->Seek)
-		return g_DevTable[idx]->Seek(g_DevTable[idx]->pDevObj, Fd, Offset);
+	if (idx >= 0 && g_DevTable[idx]->Seek)
+		return g_DevTable[idx]->Seek(g_DevTable[idx]->pDevObj, handle, Offset);
 
 	return -1;
 }
 
 int _read (int Fd, char *pBuff, size_t Len)
 {
-	int idx = Fd & STDDEV_FDIDX_MASK;
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
 
-	if (idx < 0 || idx >= STDDEV_MAX)
+	if (idx < 0 || g_DevTable[idx]->Read == NULL)
 		return -1;
 
-	if (idx >= STDFS_FILENO)
-		Fd >>= STDDEV_FDIDX_NBITS;
+	STDDEV *dev = g_DevTable[idx];
+	STDDEV_SLOT *slot = &s_DevSlot[idx];
+	bool nonblock = slot->Flags & STDDEV_FLAG_NONBLOCK;
+
+	if (slot->Rx.pMem)
+	{
+		STDDEV_BUFF *b = &slot->Rx;
+		int cnt = 0;
 
-	if (g_DevTable[idx] && g_DevTable[idx]->Read)
-		return g_DevTable[idx]->Read(g_DevTable[idx]->pDevObj, Fd, (uint8_t*)pBuff, Len);
+		StdDevPump(idx);
 
-	return -1;
+		while (cnt < Len && StdDevBuffUsed(b) > 0)
+		{
+			uint32_t i = b->GetCnt % b->Size;
+			uint32_t l = b->Size - i;
+
+			l = l < StdDevBuffUsed(b) ? l : StdDevBuffUsed(b);
+			l = l < Len - cnt ? l : Len - cnt;
+			memcpy(&pBuff[cnt], &b->pMem[i], l);
+			b->GetCnt += l;
+			cnt += l;
+		}
+
+		if (cnt > 0 || Len == 0)
+			return cnt;
+
+		if (nonblock)
+		{
+			errno = EAGAIN;
+			return -1;
+		}
+
+		// Buffer empty, wait on device
+		return dev->Read(dev->pDevObj, handle, (uint8_t*)pBuff, Len);
+	}
+
+	if (nonblock && StdDevPollDev(idx, handle, STDDEV_POLLIN) == 0)
+	{
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return dev->Read(dev->pDevObj, handle, (uint8_t*)pBuff, Len);
 }
 
 int _write (int Fd, char *pBuff, size_t Len)
 {
-	int idx = Fd & STDDEV_FDIDX_MASK;
+	int handle;
+	int idx = StdDevIdx(Fd, &handle);
 
-	if (idx < 0 || idx >= STDDEV_MAX)
+	if (idx < 0 || g_DevTable[idx]->Write == NULL)
 		return -1;
 
-	if (idx >= STDFS_FILENO)
-		Fd >>= STDDEV_FDIDX_NBITS;
+	STDDEV *dev = g_DevTable[idx];
+	STDDEV_SLOT *slot = &s_DevSlot[idx];
+	bool nonblock = slot->Flags & STDDEV_FLAG_NONBLOCK;
 
-	if (g_DevTable[idx] && g_DevTable[idx]->Write)
+	if (slot->Tx.pMem)
 	{
-		return g_DevTable[idx]->Write(g_DevTable[idx]->pDevObj, Fd, (uint8_t*)pBuff, Len);
+		STDDEV_BUFF *b = &slot->Tx;
+		int cnt = 0;
+
+		while (true)
+		{
+			while (cnt < Len && StdDevBuffUsed(b) < b->Size)
+			{
+				uint32_t i = b->PutCnt % b->Size;
+				uint32_t l = b->Size - i;
+				uint32_t avail = b->Size - StdDevBuffUsed(b);
+
+				l = l < avail ? l : avail;
+				l = l < Len - cnt ? l : Len - cnt;
+				memcpy(&b->pMem[i], &pBuff[cnt], l);
+				b->PutCnt += l;
+				cnt += l;
+			}
+
+			StdDevPump(idx);
+
+			if (cnt >= Len || nonblock)
+				break;
+
+			// Blocking, wait for device to drain the buffer
+		}
+
+		if (cnt == 0 && Len > 0)
+		{
+			errno = EAGAIN;
+			return -1;
+		}
+
+		return cnt;
 	}
 
-	return -1;
+	if (nonblock && StdDevPollDev(idx, handle, STDDEV_POLLOUT) == 0)
+	{
+		errno = EAGAIN;
+		return -1;
+	}
+
+	return dev->Write(dev->pDevObj, handle, (uint8_t*)pBuff, Len);
 }
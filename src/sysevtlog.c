@@ -0,0 +1,304 @@
+/**-------------------------------------------------------------------------
+@file	sysevtlog.c
+
+@brief	Binary system event log implementation
+
+See sysevtlog.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "crc.h"
+#include "sysevtlog.h"
+
+bool SysEvtLogInit(SYSEVTLOG * const pLog, const SYSEVTLOG_CFG * const pCfg)
+{
+	if (pLog == NULL || pCfg == NULL || pCfg->pMem == NULL || pCfg->NbRec < 2 ||
+		(pCfg->NbRec & (pCfg->NbRec - 1)) != 0)
+	{
+		return false;
+	}
+
+	memset(pCfg->pMem, 0, pCfg->NbRec * sizeof(SYSEVTLOG_REC));
+
+	pLog->pRec = pCfg->pMem;
+	pLog->Mask = pCfg->NbRec - 1;
+	pLog->TimeCB = pCfg->TimeCB;
+	atomic_store(&pLog->Head, 0);
+
+	return true;
+}
+
+uint32_t SysEvtLogWrite(SYSEVTLOG * const pLog, STATUS Code, uint16_t FmtId, int NbArg, const uint32_t *pArg)
+{
+	uint32_t seq = atomic_fetch_add_explicit(&pLog->Head, 1, memory_order_relaxed) + 1;
+
+	if (seq == 0)
+	{
+		// Sequence wrapped, 0 marks a record being written
+		seq = atomic_fetch_add_explicit(&pLog->Head, 1, memory_order_relaxed) + 1;
+	}
+
+	SYSEVTLOG_REC *rec = &pLog->pRec[seq & pLog->Mask];
+	atomic_uint *pseq = (atomic_uint*)&rec->Seq;
+
+	atomic_store_explicit(pseq, 0, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+
+	NbArg = NbArg < SYSEVTLOG_MAXARG ? NbArg : SYSEVTLOG_MAXARG;
+
+	rec->TimeStamp = pLog->TimeCB ? pLog->TimeCB() : 0;
+	rec->Code = Code;
+	rec->FmtId = FmtId;
+	rec->NbArg = NbArg > 0 ? NbArg : 0;
+	for (int i = 0; i < NbArg; i++)
+	{
+		rec->Arg[i] = pArg[i];
+	}
+
+	atomic_store_explicit(pseq, seq, memory_order_release);
+
+	return seq;
+}
+
+bool SysEvtLogRead(SYSEVTLOG * const pLog, uint32_t Seq, SYSEVTLOG_REC *pRec)
+{
+	SYSEVTLOG_REC *rec = &pLog->pRec[Seq & pLog->Mask];
+	atomic_uint *pseq = (atomic_uint*)&rec->Seq;
+
+	if (Seq == 0 || atomic_load_explicit(pseq, memory_order_acquire) != Seq)
+	{
+		return false;
+	}
+
+	memcpy(pRec, rec, sizeof(SYSEVTLOG_REC));
+
+	// Record was not rewritten while copying
+	atomic_thread_fence(memory_order_acquire);
+	if (atomic_load_explicit(pseq, memory_order_relaxed) != Seq)
+	{
+		return false;
+	}
+
+	pRec->Seq = Seq;
+
+	return true;
+}
+
+int SysEvtLogGet(SYSEVTLOG * const pLog, uint32_t *pSeq, SYSEVTLOG_REC *pRec, int MaxRec, uint32_t *pLost)
+{
+	uint32_t head = SysEvtLogHead(pLog);
+	uint32_t seq = *pSeq;
+	uint32_t lost = 0;
+	int cnt = 0;
+
+	if ((int32_t)(head - seq) > (int32_t)pLog->Mask)
+	{
+		// Overwritten, skip to oldest
+		lost = head - pLog->Mask - seq;
+		seq = head - pLog->Mask;
+	}
+
+	while (cnt < MaxRec && (int32_t)(head - seq) >= 0)
+	{
+		if (seq == 0)
+		{
+			seq++;
+			continue;
+		}
+
+		if (SysEvtLogRead(pLog, seq, &pRec[cnt]))
+		{
+			cnt++;
+			seq++;
+			continue;
+		}
+
+		uint32_t s = atomic_load_explicit((atomic_uint*)&pLog->pRec[seq & pLog->Mask].Seq, memory_order_acquire);
+
+		if (s == 0 || (int32_t)(s - seq) < 0)
+		{
+			// Still being written
+			break;
+		}
+
+		// Overwritten by a newer record
+		lost++;
+		seq++;
+	}
+
+	*pSeq = seq;
+	if (pLost)
+	{
+		*pLost = lost;
+	}
+
+	return cnt;
+}
+
+static int SysEvtLogAppend(char *pBuff, int BuffLen, int Len, const char *pStr, int StrLen)
+{
+	if (Len < BuffLen - 1)
+	{
+		int l = BuffLen - 1 - Len;
+
+		l = StrLen < l ? StrLen : l;
+		memcpy(&pBuff[Len], pStr, l);
+		pBuff[Len + l] = 0;
+	}
+
+	return Len + StrLen;
+}
+
+int SysEvtLogFormat(const SYSEVTLOG_REC *pRec, const char * const *pFmtTbl, int NbFmt, char *pBuff, int BuffLen)
+{
+	char tmp[32];
+	int len = 0;
+
+	if (pRec == NULL || pBuff == NULL || BuffLen <= 0)
+	{
+		return 0;
+	}
+
+	pBuff[0] = 0;
+
+	if (pFmtTbl == NULL || pRec->FmtId >= NbFmt || pFmtTbl[pRec->FmtId] == NULL)
+	{
+		if (pRec->FmtId != SYSEVTLOG_FMTID_NONE)
+		{
+			int l = snprintf(tmp, sizeof(tmp), "fmt %u", pRec->FmtId);
+			len = SysEvtLogAppend(pBuff, BuffLen, len, tmp, l);
+		}
+		for (int i = 0; i < pRec->NbArg && i < SYSEVTLOG_MAXARG; i++)
+		{
+			int l = snprintf(tmp, sizeof(tmp), len > 0 ? " 0x%x" : "0x%x", (unsigned)pRec->Arg[i]);
+			len = SysEvtLogAppend(pBuff, BuffLen, len, tmp, l);
+		}
+
+		return len;
+	}
+
+	const char *p = pFmtTbl[pRec->FmtId];
+	int argidx = 0;
+
+	while (*p)
+	{
+		const char *lit = p;
+
+		while (*p && *p != '%')
+		{
+			p++;
+		}
+		len = SysEvtLogAppend(pBuff, BuffLen, len, lit, p - lit);
+
+		if (*p == 0)
+		{
+			break;
+		}
+
+		if (p[1] == '%')
+		{
+			len = SysEvtLogAppend(pBuff, BuffLen, len, "%", 1);
+			p += 2;
+			continue;
+		}
+
+		// Conversion specification without length modifier
+		char spec[16];
+		const char *start = p++;
+		int sl = 1;
+
+		spec[0] = '%';
+		while (*p && strchr("-+ #0123456789.", *p) && sl < (int)sizeof(spec) - 2)
+		{
+			spec[sl++] = *p++;
+		}
+		while (*p == 'h' || *p == 'l' || *p == 'z' || *p == 't' || *p == 'j')
+		{
+			p++;
+		}
+
+		char conv = *p;
+
+		if (conv == 0 || strchr("diuxXoc", conv) == NULL)
+		{
+			// Unsupported, copy as is
+			if (conv)
+			{
+				p++;
+			}
+			len = SysEvtLogAppend(pBuff, BuffLen, len, start, p - start);
+			continue;
+		}
+		p++;
+		spec[sl++] = conv;
+		spec[sl] = 0;
+
+		int l;
+
+		if (argidx >= pRec->NbArg || argidx >= SYSEVTLOG_MAXARG)
+		{
+			l = snprintf(tmp, sizeof(tmp), "?");
+		}
+		else if (conv == 'd' || conv == 'i' || conv == 'c')
+		{
+			l = snprintf(tmp, sizeof(tmp), spec, (int)pRec->Arg[argidx]);
+		}
+		else
+		{
+			l = snprintf(tmp, sizeof(tmp), spec, (unsigned)pRec->Arg[argidx]);
+		}
+		argidx++;
+
+		l = l < (int)sizeof(tmp) - 1 ? l : (int)sizeof(tmp) - 1;
+		len = SysEvtLogAppend(pBuff, BuffLen, len, tmp, l);
+	}
+
+	return len;
+}
+
+static inline uint32_t SysEvtLogSectCrc(const SYSEVTLOG_SECT *pSect)
+{
+	return crc32((uint8_t*)&pSect->SectSeq, sizeof(SYSEVTLOG_SECT) - offsetof(SYSEVTLOG_SECT, SectSeq));
+}
+
+bool SysEvtLogSectValid(const SYSEVTLOG_SECT *pSect)
+{
+	return pSect->Magic == SYSEVTLOG_SECT_MAGIC && pSect->NbRec <= SYSEVTLOG_SECT_NBREC &&
+		   pSect->Crc == SysEvtLogSectCrc(pSect);
+}
+
+void SysEvtLogSectSeal(SYSEVTLOG_SECT *pSect)
+{
+	pSect->Magic = SYSEVTLOG_SECT_MAGIC;
+	pSect->Crc = SysEvtLogSectCrc(pSect);
+}
@@ -0,0 +1,137 @@
+/**-------------------------------------------------------------------------
+@file	sysevtlog_impl.cpp
+
+@brief	Binary system event log persistence
+
+See sysevtlog.h
+
+@author	Hoang Nguyen Hoan
+@date	Oct. 19, 2026
+
+@license
+
+MIT License
+
+Copyright (c) 2026 I-SYST inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+
+----------------------------------------------------------------------------*/
+#include <string.h>
+
+#include "diskio.h"
+#include "sysevtlog.h"
+
+SysEvtLog::SysEvtLog()
+{
+	vLog.pRec = NULL;
+	vLog.Mask = 0;
+	vLog.TimeCB = NULL;
+	atomic_store(&vLog.Head, 0);
+	vpDisk = NULL;
+	vStartSect = 0;
+	vNbSect = 0;
+	vCurSect = 0;
+	vSectSeq = 0;
+	vPersistSeq = 1;
+	vLost = 0;
+}
+
+bool SysEvtLog::PersistInit(DiskIO * const pDisk, uint32_t StartSect, uint32_t NbSect)
+{
+	if (pDisk == NULL || NbSect < 2 || vLog.pRec == NULL)
+	{
+		return false;
+	}
+
+	SYSEVTLOG_SECT sect;
+	uint32_t maxseq = 0;
+	uint32_t cur = 0;
+
+	// Resume after most recent sector
+	for (uint32_t i = 0; i < NbSect; i++)
+	{
+		if (pDisk->SectRead(StartSect + i, (uint8_t*)&sect) && SysEvtLogSectValid(&sect) &&
+			sect.SectSeq > maxseq)
+		{
+			maxseq = sect.SectSeq;
+			cur = i + 1;
+		}
+	}
+
+	vpDisk = pDisk;
+	vStartSect = StartSect;
+	vNbSect = NbSect;
+	vCurSect = cur < NbSect ? cur : 0;
+	vSectSeq = maxseq;
+	vPersistSeq = SysEvtLogHead(&vLog) + 1;
+	vLost = 0;
+
+	return true;
+}
+
+int SysEvtLog::Persist(bool bFlush)
+{
+	SYSEVTLOG_SECT sect;
+	int cnt = 0;
+
+	if (vpDisk == NULL)
+	{
+		return 0;
+	}
+
+	while (true)
+	{
+		uint32_t pending = SysEvtLogHead(&vLog) + 1 - vPersistSeq;
+
+		if (pending == 0 || (pending < SYSEVTLOG_SECT_NBREC && bFlush == false))
+		{
+			break;
+		}
+
+		uint32_t lost = 0;
+
+		memset(&sect, 0xFF, sizeof(sect));
+
+		int n = SysEvtLogGet(&vLog, &vPersistSeq, sect.Rec, SYSEVTLOG_SECT_NBREC, &lost);
+
+		vLost += lost;
+		if (n <= 0)
+		{
+			break;
+		}
+
+		sect.SectSeq = vSectSeq + 1;
+		sect.NbRec = n;
+		sect.Rsvd = 0;
+		SysEvtLogSectSeal(&sect);
+
+		if (vpDisk->SectWrite(vStartSect + vCurSect, (uint8_t*)&sect) == false)
+		{
+			vLost += n;
+			break;
+		}
+
+		vSectSeq++;
+		vCurSect = vCurSect + 1 < vNbSect ? vCurSect + 1 : 0;
+		cnt++;
+	}
+
+	return cnt;
+}
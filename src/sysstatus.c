@@ -29,7 +29,7 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ----------------------------------------------------------------------------
 Modified by          Date              Description
-
+Hoan                 Oct. 19, 2026     Interrupt safe queue update, event log
 ----------------------------------------------------------------------------*/
 //#pragma file_attr("prefersMem=external")
 #include <string.h>
@@ -45,6 +45,19 @@ STATUS g_SysState = 0;
 SYSSTATUS g_StatusQue[SYSSTATUS_MAXQUE];
 int g_StatusQCurrIdx = 0;
 
+static atomic_uint s_StatusQCnt = 0;
+
+// Optional log receiving all status codes, ex. event log
+static SYSSTATUS_LOGCB s_SysStatusLogCB = NULL;
+static void *s_pSysStatusLogCtx = NULL;
+
+void SysStatusSetLogCB(SYSSTATUS_LOGCB LogCB, void *pCtx)
+{
+	s_SysStatusLogCB = NULL;
+	s_pSysStatusLogCtx = pCtx;
+	s_SysStatusLogCB = LogCB;
+}
+
 STATUS SysStateGet(void)
 {
 	return g_SysState;
@@ -94,17 +107,26 @@ STATUS SysStatusSet(STATUS Code, char *pDesc)
 		atomic_store((sig_atomic_t *)&g_SysState, Code);
 	}
 
-	g_StatusQCurrIdx = (g_StatusQCurrIdx + 1) % SYSSTATUS_MAXQUE;
+	SYSSTATUS_LOGCB logcb = s_SysStatusLogCB;
 
-	atomic_store((sig_atomic_t *)g_StatusQue[g_StatusQCurrIdx].Code, Code);
+	if (logcb)
+	{
+		logcb(s_pSysStatusLogCtx, Code);
+	}
+
+	// Claim entry, can be called from interrupts
+	int idx = (atomic_fetch_add(&s_StatusQCnt, 1) + 1) % SYSSTATUS_MAXQUE;
+
+	g_StatusQue[idx].Code = Code;
 	if (pDesc)
 	{
-		strncpy(g_StatusQue[g_StatusQCurrIdx].Desc, pDesc, SYSSTATUS_DESC_MAX);
+		strncpy(g_StatusQue[idx].Desc, pDesc, SYSSTATUS_DESC_MAX);
 		len = SYSSTATUS_DESC_MAX - 1;
 	}
-	g_StatusQue[g_StatusQCurrIdx].Desc[len] = '\0';
+	g_StatusQue[idx].Desc[len] = '\0';
+
+	g_StatusQCurrIdx = idx;
 
-	// Store special case Runtime State
 	return Code;
 }
 
@@ -29,6 +29,8 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 ----------------------------------------------------------------------------
 Modified by          Date              Description
+Hoan				Oct. 19, 2026		Add UARTDLogWrite, deferred log output
+Hoan				Oct. 19, 2026		Add UARTStdDevPoll, fix multi byte read count
 
 ----------------------------------------------------------------------------*/
 #include <string.h>
@@ -61,6 +63,8 @@ int UARTStdDevClose(void *pDevObj, int Handle);
 int UARTStdDevRead(void *pDevObj, int Handle, uint8_t *pBuff, size_t Len);
 int UARTStdDevWrite(void *pDevObj, int Handle, uint8_t *pBuff, size_t Len);
 // seek
+// poll
+int UARTStdDevPoll(void *pDevObj, int Handle, int Events);
 
 
 STDDEV g_UartStdDev = {
@@ -70,7 +74,8 @@ STDDEV g_UartStdDev = {
 	UARTStdDevClose,
 	UARTStdDevRead,
 	UARTStdDevWrite,
-	NULL
+	NULL,
+	UARTStdDevPoll
 };
 
 void UARTRetargetEnable(UARTDEV * const pDev, int FileNo)
@@ -129,7 +134,7 @@ int UARTStdDevRead(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len)
 	{
 		while (l < Len)
 		{
-			int cnt = UARTRx(dev, pBuff, Len);
+			int cnt = UARTRx(dev, pBuff, 1);
 			if (cnt > 0)
 			{
 				l++;
@@ -158,3 +163,47 @@ int UARTStdDevWrite(void * const pDevObj, int Handle, uint8_t *pBuff, size_t Len
 	return 0;
 }
 
+int UARTStdDevPoll(void * const pDevObj, int Handle, int Events)
+{
+	UARTDEV *dev = (UARTDEV *)pDevObj;
+	int ev = 0;
+
+	// Without FIFO the driver waits on the hardware, report ready
+	if ((Events & STDDEV_POLLIN) && Handle == dev->hStdIn)
+	{
+		if (dev->hRxFifo == NULL || CFifoUsed(dev->hRxFifo) > 0)
+			ev |= STDDEV_POLLIN;
+	}
+	if ((Events & STDDEV_POLLOUT) && Handle == dev->hStdOut)
+	{
+		if (dev->hTxFifo == NULL || CFifoAvail(dev->hTxFifo) > 0)
+			ev |= STDDEV_POLLOUT;
+	}
+
+	return ev;
+}
+
+int UARTDLogWrite(void *pCtx, const uint8_t *pData, int Len)
+{
+	UARTDEV *dev = (UARTDEV *)pCtx;
+	int cnt = 0;
+
+	if (dev->hTxFifo == NULL)
+		return 0;
+
+	// Only what fits in Tx FIFO, the driver then never waits.
+	// Busy interface is not retried, dlog keeps the data for next time
+	int avail = CFifoAvail(dev->hTxFifo);
+
+	if (Len > avail)
+		Len = avail;
+
+	if (Len > 0 && DeviceIntrfStartTx(&dev->DevIntrf, 0))
+	{
+		cnt = dev->DevIntrf.TxData(&dev->DevIntrf, (uint8_t *)pData, Len);
+		DeviceIntrfStopTx(&dev->DevIntrf);
+	}
+
+	return cnt;
+}
+
@@ -29,62 +29,1363 @@ THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 Modified by          Date              Description
 Hoan Hoang           Nov. 10, 2006     For codecvt_utf8 which requires 
                                        conversion states
+Hoan Hoang           Oct. 19, 2026     DFA validation, ASCII & SIMD fast
+                                       paths, UTF-16/32 conversions
 ----------------------------------------------------------------------------*/
+#include <stdint.h>
+#include <string.h>
 #include <wchar.h>
 
 #include "utf8.h"
 
-int uft8towcs_octetcount(char c)
+#ifndef UTF8_NO_SIMD
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define UTF8_SSSE3
+#include <tmmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#define UTF8_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+#define UTF8_ACCEPT     0
+#define UTF8_REJECT     6
+
+#define ASCII_MASK64    0x8080808080808080ULL
+
+// Conversion cores are specialized per code unit width by the public entries
+#if defined(__GNUC__)
+#define UTF8_INLINE     static inline __attribute__((always_inline))
+#else
+#define UTF8_INLINE     static inline
+#endif
+
+/*
+ * Bjoern Hoehrmann's UTF-8 DFA. Bytes map to 12 character classes.
+ * Overlongs, surrogates, code points above U+10FFFF and the old 5 & 6 bytes
+ * forms all end in the reject state.
+ */
+static const uint8_t s_Utf8Class[256] = {
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,
+    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,
+    7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,
+    8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,
+   10,3,3,3,3,3,3,3,3,3,3,3,3,4,3,3,11,6,6,6,5,8,8,8,8,8,8,8,8,8,8,8,
+};
+
+/*
+ * Transition table in shift form : the 9 states are bit offsets 0, 6, ... 48
+ * and the row of a class packs the next state of each of them. A step is a
+ * single shift, which keeps the dependency chain between bytes short.
+ */
+static const uint64_t s_Utf8Row[12] = {
+   0x0006186186186180ULL, 0x0012486306300186ULL, 0x000618618618618cULL, 0x0006186186186192ULL,
+   0x000618618618619eULL, 0x00061861861861b0ULL, 0x00061861861861aaULL, 0x000649218c300186ULL,
+   0x0006186186186186ULL, 0x0006492306300186ULL, 0x0006186186186198ULL, 0x00061861861861a4ULL,
+};
+
+static bool s_bUtf8Simd = true;
+
+static inline uint32_t Utf8DfaNext(uint32_t State, uint8_t b)
+{
+   return (uint32_t)(s_Utf8Row[s_Utf8Class[b]] >> (State & 63)) & 63;
+}
+
+/**
+ * Decode one multi-byte sequence, DFA
+ *
+ * @return  Sequence length, 0 if input ends inside the sequence, -1 if invalid
+ */
+static int Utf8DecodeDfa(const uint8_t *pSrc, const uint8_t *pEnd, uint32_t *pCp)
+{
+   const uint8_t *p = pSrc;
+   uint32_t state = Utf8DfaNext(UTF8_ACCEPT, *p);
+   uint32_t cp = (0xffu >> s_Utf8Class[*p]) & *p;
+
+   p++;
+   while (state != UTF8_ACCEPT)
+   {
+      if (state == UTF8_REJECT)
+      {
+         return -1;
+      }
+      if (p >= pEnd)
+      {
+         return 0;
+      }
+      state = Utf8DfaNext(state, *p);
+      cp = (cp << 6) | (*p & 0x3f);
+      p++;
+   }
+   *pCp = cp;
+
+   return (int)(p - pSrc);
+}
+
+/**
+ * Decode one multi-byte sequence. Well formed 2 & 3 bytes sequences, the
+ * bulk of non ASCII text, are decoded directly. Everything else goes
+ * through the DFA.
+ *
+ * @return  Sequence length, 0 if input ends inside the sequence, -1 if invalid
+ */
+static inline int Utf8DecodeOne(const uint8_t *pSrc, const uint8_t *pEnd, uint32_t *pCp)
+{
+   uint32_t b0 = pSrc[0];
+
+   if (b0 < 0xe0)
+   {
+      if (b0 >= 0xc2 && pEnd - pSrc >= 2 && (pSrc[1] & 0xc0) == 0x80)
+      {
+         *pCp = ((b0 & 0x1f) << 6) | (pSrc[1] & 0x3f);
+         return 2;
+      }
+   }
+   else if (b0 < 0xf0)
+   {
+      if (pEnd - pSrc >= 3 && (pSrc[1] & 0xc0) == 0x80 && (pSrc[2] & 0xc0) == 0x80)
+      {
+         uint32_t cp = ((b0 & 0xf) << 12) | ((pSrc[1] & 0x3f) << 6) | (pSrc[2] & 0x3f);
+
+         // Not overlong, not surrogate
+         if (cp >= 0x800 && (cp & 0xf800) != 0xd800)
+         {
+            *pCp = cp;
+            return 3;
+         }
+      }
+   }
+
+   return Utf8DecodeDfa(pSrc, pEnd, pCp);
+}
+
+/// UTF-16 or UTF-32 code unit store, Width in bytes. memcpy keeps wchar_t
+/// destinations free of aliasing issues and compiles to a plain store.
+static inline void Utf8StoreUnit(void *pDest, size_t Idx, uint32_t c, int Width)
+{
+   if (Width == 2)
+   {
+      uint16_t v = (uint16_t)c;
+      memcpy((uint8_t*)pDest + Idx * 2, &v, 2);
+   }
+   else
+   {
+      memcpy((uint8_t*)pDest + Idx * 4, &c, 4);
+   }
+}
+
+static inline uint32_t Utf8LoadUnit(const void *pSrc, size_t Idx, int Width)
+{
+   if (Width == 2)
+   {
+      uint16_t v;
+      memcpy(&v, (const uint8_t*)pSrc + Idx * 2, 2);
+      return v;
+   }
+
+   uint32_t v;
+   memcpy(&v, (const uint8_t*)pSrc + Idx * 4, 4);
+
+   return v;
+}
+
+/**
+ * Start of the sequence left open before Idx, Idx if none. Bytes before the
+ * returned boundary are complete sequences.
+ */
+static inline size_t Utf8SeqStart(const uint8_t *pSrc, size_t Idx)
+{
+   for (size_t k = 1; k <= 3 && k <= Idx; k++)
+   {
+      uint8_t b = pSrc[Idx - k];
+
+      if (b < 0x80)
+      {
+         break;
+      }
+      if (b >= 0xc0)
+      {
+         return Idx - k;
+      }
+   }
+
+   return Idx;
+}
+
+#if defined(UTF8_SSSE3) || defined(UTF8_NEON)
+
+/*
+ * Block decode compaction shuffles, one per removal mask of 8 x 16 bits
+ * lanes, and kept lanes count. Built on first use, concurrent builds write
+ * the same values.
+ */
+static uint8_t s_Utf8Compact[256][16];
+static uint8_t s_Utf8Count[256];
+
+/*
+ * Block encode packing shuffles. Code points are expanded to 3 bytes slots in
+ * 32 bits lanes, the mask has bit k set for a 1 or 2 bytes code point in lane
+ * k, bit k + 4 for a 1 byte one.
+ */
+static uint8_t s_Utf8Pack[256][16];
+static uint8_t s_Utf8PackLen[256];
+static volatile bool s_bUtf8CompactInit = false;
+
+static void Utf8CompactInit(void)
+{
+   for (int m = 0; m < 256; m++)
+   {
+      int j = 0;
+
+      memset(s_Utf8Compact[m], 0x80, 16);
+      for (int k = 0; k < 8; k++)
+      {
+         if ((m & (1 << k)) == 0)
+         {
+            s_Utf8Compact[m][j++] = k * 2;
+            s_Utf8Compact[m][j++] = k * 2 + 1;
+         }
+      }
+      s_Utf8Count[m] = j / 2;
+
+      j = 0;
+      memset(s_Utf8Pack[m], 0x80, 16);
+      for (int k = 0; k < 4; k++)
+      {
+         if ((m & (1 << k)) == 0)
+         {
+            s_Utf8Pack[m][j++] = k * 4;
+         }
+         if ((m & (0x10 << k)) == 0)
+         {
+            s_Utf8Pack[m][j++] = k * 4 + 1;
+         }
+         s_Utf8Pack[m][j++] = k * 4 + 2;
+      }
+      s_Utf8PackLen[m] = j;
+   }
+   s_bUtf8CompactInit = true;
+}
+
+#endif
+
+#ifdef UTF8_SSSE3
+
+/*
+ * Keiser & Lemire lookup validation. Each byte is classified by the high
+ * nibble of the previous byte, the low nibble of the previous byte and the
+ * high nibble of itself. Each table entry is a set of error bits that the
+ * pair may raise, a pair is invalid when all three agree on one bit. The
+ * remaining bit 7 marks a required 3rd or 4th continuation byte and is
+ * checked against the lead 2 or 3 bytes back.
+ */
+#define U8E_TOO_SHORT      (1 << 0)
+#define U8E_TOO_LONG       (1 << 1)
+#define U8E_OVERLONG_3     (1 << 2)
+#define U8E_TOO_LARGE      (1 << 3)
+#define U8E_SURROGATE      (1 << 4)
+#define U8E_OVERLONG_2     (1 << 5)
+#define U8E_TOO_LARGE_1000 (1 << 6)
+#define U8E_OVERLONG_4     (1 << 6)
+#define U8E_TWO_CONTS      (1 << 7)
+#define U8E_CARRY          (U8E_TOO_SHORT | U8E_TOO_LONG | U8E_TWO_CONTS)
+
+__attribute__((target("ssse3")))
+static inline __m128i Utf8CheckSsse3(__m128i In, __m128i Prev)
+{
+   const __m128i m0f = _mm_set1_epi8(0x0f);
+   const __m128i b1htbl = _mm_setr_epi8(
+      U8E_TOO_LONG, U8E_TOO_LONG, U8E_TOO_LONG, U8E_TOO_LONG,
+      U8E_TOO_LONG, U8E_TOO_LONG, U8E_TOO_LONG, U8E_TOO_LONG,
+      U8E_TWO_CONTS, U8E_TWO_CONTS, U8E_TWO_CONTS, U8E_TWO_CONTS,
+      U8E_TOO_SHORT | U8E_OVERLONG_2,
+      U8E_TOO_SHORT,
+      U8E_TOO_SHORT | U8E_OVERLONG_3 | U8E_SURROGATE,
+      U8E_TOO_SHORT | U8E_TOO_LARGE | U8E_TOO_LARGE_1000 | U8E_OVERLONG_4);
+   const __m128i b1ltbl = _mm_setr_epi8(
+      U8E_CARRY | U8E_OVERLONG_3 | U8E_OVERLONG_2 | U8E_OVERLONG_4,
+      U8E_CARRY | U8E_OVERLONG_2,
+      U8E_CARRY,
+      U8E_CARRY,
+      U8E_CARRY | U8E_TOO_LARGE,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000 | U8E_SURROGATE,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000,
+      U8E_CARRY | U8E_TOO_LARGE | U8E_TOO_LARGE_1000);
+   const __m128i b2htbl = _mm_setr_epi8(
+      U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT,
+      U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT,
+      U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_OVERLONG_3 | U8E_TOO_LARGE_1000 | U8E_OVERLONG_4,
+      U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_OVERLONG_3 | U8E_TOO_LARGE,
+      U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_SURROGATE | U8E_TOO_LARGE,
+      U8E_TOO_LONG | U8E_OVERLONG_2 | U8E_TWO_CONTS | U8E_SURROGATE | U8E_TOO_LARGE,
+      U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT, U8E_TOO_SHORT);
+
+   __m128i prev1 = _mm_alignr_epi8(In, Prev, 15);
+   __m128i sc = _mm_shuffle_epi8(b1htbl, _mm_and_si128(_mm_srli_epi16(prev1, 4), m0f));
+
+   sc = _mm_and_si128(sc, _mm_shuffle_epi8(b1ltbl, _mm_and_si128(prev1, m0f)));
+   sc = _mm_and_si128(sc, _mm_shuffle_epi8(b2htbl, _mm_and_si128(_mm_srli_epi16(In, 4), m0f)));
+
+   __m128i is3 = _mm_subs_epu8(_mm_alignr_epi8(In, Prev, 14), _mm_set1_epi8((char)(0xe0 - 0x80)));
+   __m128i is4 = _mm_subs_epu8(_mm_alignr_epi8(In, Prev, 13), _mm_set1_epi8((char)(0xf0 - 0x80)));
+   __m128i must23 = _mm_and_si128(_mm_or_si128(is3, is4), _mm_set1_epi8((char)0x80));
+
+   return _mm_xor_si128(must23, sc);
+}
+
+/**
+ * Validate whole 16 bytes blocks
+ *
+ * @return  Sequence boundary from which to resume scalar validation. All
+ *          bytes before it are valid. If a block fails, the boundary is the
+ *          start of the first sequence touching that block.
+ */
+__attribute__((target("ssse3")))
+static size_t Utf8ValidateSsse3(const uint8_t *pSrc, size_t Len)
+{
+   const __m128i maxval = _mm_setr_epi8(-1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                        (char)(0xf0 - 1), (char)(0xe0 - 1), (char)(0xc0 - 1));
+   __m128i prev = _mm_setzero_si128();
+   __m128i incomplete = _mm_setzero_si128();
+   size_t i = 0;
+
+   for (; i + 16 <= Len; i += 16)
+   {
+      __m128i in = _mm_loadu_si128((const __m128i*)&pSrc[i]);
+      __m128i err;
+
+      if (_mm_movemask_epi8(in) == 0)
+      {
+         // ASCII block, only a sequence left open by the previous one can fail
+         err = incomplete;
+         incomplete = _mm_setzero_si128();
+      }
+      else
+      {
+         err = Utf8CheckSsse3(in, prev);
+         incomplete = _mm_subs_epu8(in, maxval);
+      }
+
+      if (_mm_movemask_epi8(_mm_cmpeq_epi8(err, _mm_setzero_si128())) != 0xffff)
+      {
+         break;
+      }
+      prev = in;
+   }
+
+   return Utf8SeqStart(pSrc, i);
+}
+
+/**
+ * Widen ASCII run to UTF-16 or UTF-32. Len must not exceed destination room,
+ * code units past the returned count may be overwritten.
+ *
+ * @return  Number of ASCII bytes converted
+ */
+__attribute__((target("ssse3")))
+static size_t Utf8AsciiWidenSsse3(const uint8_t *pSrc, size_t Len, void *pDest, int Width)
+{
+   const __m128i z = _mm_setzero_si128();
+   uint8_t *d = (uint8_t*)pDest;
+   size_t i = 0;
+
+   for (; i + 16 <= Len; i += 16)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)&pSrc[i]);
+      __m128i lo = _mm_unpacklo_epi8(v, z);
+      __m128i hi = _mm_unpackhi_epi8(v, z);
+      int m = _mm_movemask_epi8(v);
+
+      if (Width == 2)
+      {
+         _mm_storeu_si128((__m128i*)&d[i * 2], lo);
+         _mm_storeu_si128((__m128i*)&d[i * 2 + 16], hi);
+      }
+      else
+      {
+         _mm_storeu_si128((__m128i*)&d[i * 4], _mm_unpacklo_epi16(lo, z));
+         _mm_storeu_si128((__m128i*)&d[i * 4 + 16], _mm_unpackhi_epi16(lo, z));
+         _mm_storeu_si128((__m128i*)&d[i * 4 + 32], _mm_unpacklo_epi16(hi, z));
+         _mm_storeu_si128((__m128i*)&d[i * 4 + 48], _mm_unpackhi_epi16(hi, z));
+      }
+
+      if (m != 0)
+      {
+         return i + __builtin_ctz(m);
+      }
+   }
+
+   return i;
+}
+
+/**
+ * Narrow ASCII run of UTF-16 or UTF-32 code units, 16 per step.
+ *
+ * @return  Number of code units converted, always a multiple of 16
+ */
+__attribute__((target("ssse3")))
+static size_t Utf8AsciiNarrowSsse3(const void *pSrc, size_t Len, uint8_t *pDest, int Width)
+{
+   const uint8_t *s = (const uint8_t*)pSrc;
+   const __m128i z = _mm_setzero_si128();
+   size_t i = 0;
+
+   if (Width == 2)
+   {
+      const __m128i m = _mm_set1_epi16((short)0xff80);
+
+      for (; i + 16 <= Len; i += 16)
+      {
+         __m128i a = _mm_loadu_si128((const __m128i*)&s[i * 2]);
+         __m128i b = _mm_loadu_si128((const __m128i*)&s[i * 2 + 16]);
+
+         if (_mm_movemask_epi8(_mm_cmpeq_epi16(_mm_and_si128(_mm_or_si128(a, b), m), z)) != 0xffff)
+         {
+            break;
+         }
+         _mm_storeu_si128((__m128i*)&pDest[i], _mm_packus_epi16(a, b));
+      }
+   }
+   else
+   {
+      const __m128i m = _mm_set1_epi32((int)0xffffff80);
+
+      for (; i + 16 <= Len; i += 16)
+      {
+         __m128i a = _mm_loadu_si128((const __m128i*)&s[i * 4]);
+         __m128i b = _mm_loadu_si128((const __m128i*)&s[i * 4 + 16]);
+         __m128i c = _mm_loadu_si128((const __m128i*)&s[i * 4 + 32]);
+         __m128i d = _mm_loadu_si128((const __m128i*)&s[i * 4 + 48]);
+         __m128i t = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+
+         if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(t, m), z)) != 0xffff)
+         {
+            break;
+         }
+         _mm_storeu_si128((__m128i*)&pDest[i], _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+      }
+   }
+
+   return i;
+}
+
+
+__attribute__((target("ssse3")))
+static inline void Utf8StoreBlockSsse3(uint8_t *pDest, __m128i V, int Width)
+{
+   if (Width == 2)
+   {
+      _mm_storeu_si128((__m128i*)pDest, V);
+   }
+   else
+   {
+      _mm_storeu_si128((__m128i*)pDest, _mm_unpacklo_epi16(V, _mm_setzero_si128()));
+      _mm_storeu_si128((__m128i*)&pDest[16], _mm_unpackhi_epi16(V, _mm_setzero_si128()));
+   }
+}
+
+/**
+ * Decode a 16 bytes block of 1, 2 & 3 bytes sequences. The block starts on a
+ * sequence boundary, a sequence started in its last 2 bytes is included.
+ * Blocks with 4 bytes sequences or any error are left to the scalar path.
+ * Needs 18 readable bytes and room for 16 code units.
+ *
+ * @return  Bytes consumed, 0 if block was not converted
+ */
+__attribute__((target("ssse3")))
+static size_t Utf8DecodeBlockSsse3(const uint8_t *pSrc, void *pDest, int Width, size_t *pCnt)
+{
+   const __m128i z = _mm_setzero_si128();
+   const __m128i c0 = _mm_set1_epi8((char)0xc0);
+   const __m128i x80 = _mm_set1_epi8((char)0x80);
+   const __m128i m3f = _mm_set1_epi16(0x3f);
+   __m128i b = _mm_loadu_si128((const __m128i*)pSrc);
+   __m128i n1 = _mm_loadu_si128((const __m128i*)&pSrc[1]);
+   __m128i n2 = _mm_loadu_si128((const __m128i*)&pSrc[2]);
+
+   __m128i lead = _mm_cmpeq_epi8(_mm_and_si128(b, c0), c0);
+   __m128i lead3 = _mm_cmpeq_epi8(_mm_and_si128(b, _mm_set1_epi8((char)0xf0)), _mm_set1_epi8((char)0xe0));
+   __m128i cont = _mm_cmpeq_epi8(_mm_and_si128(b, c0), x80);
+   __m128i cont1 = _mm_cmpeq_epi8(_mm_and_si128(n1, c0), x80);
+
+   // 4 bytes leads & invalid bytes, C0/C1 overlong leads
+   __m128i err = _mm_cmpeq_epi8(_mm_max_epu8(b, _mm_set1_epi8((char)0xf0)), b);
+   err = _mm_or_si128(err, _mm_cmpeq_epi8(_mm_and_si128(b, _mm_set1_epi8((char)0xfe)), c0));
+   // Each byte after a lead, and 2 after a 3 bytes lead, is a continuation
+   err = _mm_or_si128(err, _mm_xor_si128(cont1, _mm_or_si128(lead, _mm_slli_si128(lead3, 1))));
+   // E0 overlong, ED surrogate
+   __m128i lo2 = _mm_cmpeq_epi8(_mm_max_epu8(n1, _mm_set1_epi8((char)0x9f)), _mm_set1_epi8((char)0x9f));
+   err = _mm_or_si128(err, _mm_and_si128(_mm_cmpeq_epi8(b, _mm_set1_epi8((char)0xe0)), lo2));
+   err = _mm_or_si128(err, _mm_andnot_si128(lo2, _mm_cmpeq_epi8(b, _mm_set1_epi8((char)0xed))));
+
+   int lmask = _mm_movemask_epi8(lead3);
+
+   if (_mm_movemask_epi8(err) != 0 || (pSrc[0] & 0xc0) == 0x80 ||
+       ((lmask & 0x8000) && (pSrc[17] & 0xc0) != 0x80))
+   {
+      return 0;
+   }
+
+   size_t cnt = 0;
+   int cmask = _mm_movemask_epi8(cont);
+
+   for (int h = 0; h < 2; h++)
+   {
+      __m128i bw, w1, w2, l2, l3;
+
+      if (h == 0)
+      {
+         bw = _mm_unpacklo_epi8(b, z);
+         w1 = _mm_unpacklo_epi8(n1, z);
+         w2 = _mm_unpacklo_epi8(n2, z);
+         l2 = _mm_unpacklo_epi8(lead, lead);
+         l3 = _mm_unpacklo_epi8(lead3, lead3);
+      }
+      else
+      {
+         bw = _mm_unpackhi_epi8(b, z);
+         w1 = _mm_unpackhi_epi8(n1, z);
+         w2 = _mm_unpackhi_epi8(n2, z);
+         l2 = _mm_unpackhi_epi8(lead, lead);
+         l3 = _mm_unpackhi_epi8(lead3, lead3);
+      }
+
+      __m128i v2 = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(bw, _mm_set1_epi16(0x1f)), 6), _mm_and_si128(w1, m3f));
+      __m128i v3 = _mm_or_si128(_mm_slli_epi16(bw, 12), _mm_slli_epi16(_mm_and_si128(w1, m3f), 6));
+      v3 = _mm_or_si128(v3, _mm_and_si128(w2, m3f));
+
+      __m128i v = _mm_or_si128(_mm_and_si128(l2, v2), _mm_andnot_si128(l2, bw));
+      v = _mm_or_si128(_mm_and_si128(l3, v3), _mm_andnot_si128(l3, v));
+
+      int m = (cmask >> (h * 8)) & 0xff;
+
+      v = _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i*)s_Utf8Compact[m]));
+      Utf8StoreBlockSsse3((uint8_t*)pDest + cnt * Width, v, Width);
+      cnt += s_Utf8Count[m];
+   }
+
+   *pCnt = cnt;
+
+   // Sequences started in the last 2 bytes
+   int l2mask = _mm_movemask_epi8(lead);
+
+   return 16 + ((lmask & 0x8000) ? 2 : ((l2mask & 0x8000) || (lmask & 0x4000)) ? 1 : 0);
+}
+
+/**
+ * Encode 4 code points below U+10000 to 3 bytes slots and pack
+ *
+ * @return  Number of bytes written, -1 if a code point needs the scalar path
+ */
+__attribute__((target("ssse3")))
+static inline int Utf8Encode4Ssse3(__m128i C, uint8_t *pDest)
+{
+   const __m128i z = _mm_setzero_si128();
+   const __m128i m3f = _mm_set1_epi32(0x3f);
+   const __m128i x80 = _mm_set1_epi32(0x80);
+   __m128i bad = _mm_cmpeq_epi32(_mm_and_si128(C, _mm_set1_epi32(0xf800)), _mm_set1_epi32(0xd800));
+
+   bad = _mm_or_si128(bad, _mm_xor_si128(_mm_cmpeq_epi32(_mm_srli_epi32(C, 16), z), _mm_set1_epi32(-1)));
+   if (_mm_movemask_epi8(bad) != 0)
+   {
+      return -1;
+   }
+
+   __m128i is1 = _mm_cmpgt_epi32(x80, C);
+   __m128i is2 = _mm_cmpgt_epi32(_mm_set1_epi32(0x800), C);
+   __m128i c6 = _mm_srli_epi32(C, 6);
+   __m128i t0 = _mm_or_si128(_mm_srli_epi32(C, 12), _mm_set1_epi32(0xe0));
+   __m128i t1 = _mm_or_si128(_mm_and_si128(is2, _mm_or_si128(c6, _mm_set1_epi32(0xc0))),
+                             _mm_andnot_si128(is2, _mm_or_si128(_mm_and_si128(c6, m3f), x80)));
+   __m128i t2 = _mm_or_si128(_mm_and_si128(is1, C), _mm_andnot_si128(is1, _mm_or_si128(_mm_and_si128(C, m3f), x80)));
+   __m128i v = _mm_or_si128(t0, _mm_or_si128(_mm_slli_epi32(t1, 8), _mm_slli_epi32(t2, 16)));
+   int m = _mm_movemask_ps(_mm_castsi128_ps(is2)) | (_mm_movemask_ps(_mm_castsi128_ps(is1)) << 4);
+
+   _mm_storeu_si128((__m128i*)pDest, _mm_shuffle_epi8(v, _mm_loadu_si128((const __m128i*)s_Utf8Pack[m])));
+
+   return s_Utf8PackLen[m];
+}
+
+/**
+ * Encode a block of 8 code units below U+10000, surrogates excluded. Needs
+ * room for 32 bytes.
+ *
+ * @return  Number of bytes written, 0 if block was not converted
+ */
+__attribute__((target("ssse3")))
+static size_t Utf8EncodeBlockSsse3(const uint8_t *pSrc, uint8_t *pDest, int Width)
+{
+   __m128i a, b;
+
+   if (Width == 2)
+   {
+      __m128i v = _mm_loadu_si128((const __m128i*)pSrc);
+
+      a = _mm_unpacklo_epi16(v, _mm_setzero_si128());
+      b = _mm_unpackhi_epi16(v, _mm_setzero_si128());
+   }
+   else
+   {
+      a = _mm_loadu_si128((const __m128i*)pSrc);
+      b = _mm_loadu_si128((const __m128i*)&pSrc[16]);
+   }
+
+   int la = Utf8Encode4Ssse3(a, pDest);
+
+   if (la < 0)
+   {
+      return 0;
+   }
+
+   int lb = Utf8Encode4Ssse3(b, &pDest[la]);
+
+   if (lb < 0)
+   {
+      return 0;
+   }
+
+   return la + lb;
+}
+
+#endif   // UTF8_SSSE3
+
+#ifdef UTF8_NEON
+
+/// Same lookup validation as the SSSE3 version, see comments above
+static size_t Utf8ValidateNeon(const uint8_t *pSrc, size_t Len)
+{
+   static const uint8_t s_Tbl[3][16] = {
+      { 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x02, 0x80, 0x80, 0x80, 0x80, 0x21, 0x01, 0x15, 0x49 },
+      { 0xe7, 0xa3, 0x83, 0x83, 0x8b, 0xcb, 0xcb, 0xcb, 0xcb, 0xcb, 0xcb, 0xcb, 0xcb, 0xdb, 0xcb, 0xcb },
+      { 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0x01, 0xe6, 0xae, 0xba, 0xba, 0x01, 0x01, 0x01, 0x01 },
+   };
+   static const uint8_t s_MaxVal[16] = {
+      0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf
+   };
+   const uint8x16_t b1htbl = vld1q_u8(s_Tbl[0]);
+   const uint8x16_t b1ltbl = vld1q_u8(s_Tbl[1]);
+   const uint8x16_t b2htbl = vld1q_u8(s_Tbl[2]);
+   const uint8x16_t maxval = vld1q_u8(s_MaxVal);
+   const uint8x16_t m0f = vdupq_n_u8(0x0f);
+   uint8x16_t prev = vdupq_n_u8(0);
+   uint8x16_t incomplete = vdupq_n_u8(0);
+   size_t i = 0;
+
+   for (; i + 16 <= Len; i += 16)
+   {
+      uint8x16_t in = vld1q_u8(&pSrc[i]);
+      uint8x16_t err;
+
+      if (vmaxvq_u8(in) < 0x80)
+      {
+         err = incomplete;
+         incomplete = vdupq_n_u8(0);
+      }
+      else
+      {
+         uint8x16_t prev1 = vextq_u8(prev, in, 15);
+         uint8x16_t sc = vqtbl1q_u8(b1htbl, vshrq_n_u8(prev1, 4));
+
+         sc = vandq_u8(sc, vqtbl1q_u8(b1ltbl, vandq_u8(prev1, m0f)));
+         sc = vandq_u8(sc, vqtbl1q_u8(b2htbl, vshrq_n_u8(in, 4)));
+
+         uint8x16_t is3 = vqsubq_u8(vextq_u8(prev, in, 14), vdupq_n_u8(0xe0 - 0x80));
+         uint8x16_t is4 = vqsubq_u8(vextq_u8(prev, in, 13), vdupq_n_u8(0xf0 - 0x80));
+
+         err = veorq_u8(vandq_u8(vorrq_u8(is3, is4), vdupq_n_u8(0x80)), sc);
+         incomplete = vqsubq_u8(in, maxval);
+      }
+
+      if (vmaxvq_u8(err) != 0)
+      {
+         break;
+      }
+      prev = in;
+   }
+
+   return Utf8SeqStart(pSrc, i);
+}
+
+static size_t Utf8AsciiWidenNeon(const uint8_t *pSrc, size_t Len, void *pDest, int Width)
+{
+   uint8_t *d = (uint8_t*)pDest;
+   size_t i = 0;
+
+   for (; i + 16 <= Len; i += 16)
+   {
+      uint8x16_t v = vld1q_u8(&pSrc[i]);
+
+      if (vmaxvq_u8(v) >= 0x80)
+      {
+         break;
+      }
+
+      uint16x8_t lo = vmovl_u8(vget_low_u8(v));
+      uint16x8_t hi = vmovl_u8(vget_high_u8(v));
+
+      if (Width == 2)
+      {
+         vst1q_u16((uint16_t*)&d[i * 2], lo);
+         vst1q_u16((uint16_t*)&d[i * 2 + 16], hi);
+      }
+      else
+      {
+         vst1q_u32((uint32_t*)&d[i * 4], vmovl_u16(vget_low_u16(lo)));
+         vst1q_u32((uint32_t*)&d[i * 4 + 16], vmovl_u16(vget_high_u16(lo)));
+         vst1q_u32((uint32_t*)&d[i * 4 + 32], vmovl_u16(vget_low_u16(hi)));
+         vst1q_u32((uint32_t*)&d[i * 4 + 48], vmovl_u16(vget_high_u16(hi)));
+      }
+   }
+
+   return i;
+}
+
+static size_t Utf8AsciiNarrowNeon(const void *pSrc, size_t Len, uint8_t *pDest, int Width)
+{
+   const uint8_t *s = (const uint8_t*)pSrc;
+   size_t i = 0;
+
+   for (; i + 16 <= Len; i += 16)
+   {
+      uint16x8_t a, b;
+
+      if (Width == 2)
+      {
+         a = vld1q_u16((const uint16_t*)&s[i * 2]);
+         b = vld1q_u16((const uint16_t*)&s[i * 2 + 16]);
+         if (vmaxvq_u16(vorrq_u16(a, b)) >= 0x80)
+         {
+            break;
+         }
+      }
+      else
+      {
+         uint32x4_t a0 = vld1q_u32((const uint32_t*)&s[i * 4]);
+         uint32x4_t a1 = vld1q_u32((const uint32_t*)&s[i * 4 + 16]);
+         uint32x4_t b0 = vld1q_u32((const uint32_t*)&s[i * 4 + 32]);
+         uint32x4_t b1 = vld1q_u32((const uint32_t*)&s[i * 4 + 48]);
+
+         if (vmaxvq_u32(vorrq_u32(vorrq_u32(a0, a1), vorrq_u32(b0, b1))) >= 0x80)
+         {
+            break;
+         }
+         a = vcombine_u16(vmovn_u32(a0), vmovn_u32(a1));
+         b = vcombine_u16(vmovn_u32(b0), vmovn_u32(b1));
+      }
+      vst1q_u8(&pDest[i], vcombine_u8(vmovn_u16(a), vmovn_u16(b)));
+   }
+
+   return i;
+}
+
+
+/// Same as Utf8DecodeBlockSsse3
+static size_t Utf8DecodeBlockNeon(const uint8_t *pSrc, void *pDest, int Width, size_t *pCnt)
+{
+   const uint8x16_t c0 = vdupq_n_u8(0xc0);
+   uint8x16_t b = vld1q_u8(pSrc);
+   uint8x16_t n1 = vld1q_u8(&pSrc[1]);
+   uint8x16_t n2 = vld1q_u8(&pSrc[2]);
+
+   uint8x16_t lead = vcgeq_u8(b, c0);
+   uint8x16_t lead3 = vceqq_u8(vandq_u8(b, vdupq_n_u8(0xf0)), vdupq_n_u8(0xe0));
+   uint8x16_t cont = vceqq_u8(vandq_u8(b, c0), vdupq_n_u8(0x80));
+   uint8x16_t cont1 = vceqq_u8(vandq_u8(n1, c0), vdupq_n_u8(0x80));
+
+   uint8x16_t err = vcgeq_u8(b, vdupq_n_u8(0xf0));
+   err = vorrq_u8(err, vceqq_u8(vandq_u8(b, vdupq_n_u8(0xfe)), c0));
+   err = vorrq_u8(err, veorq_u8(cont1, vorrq_u8(lead, vextq_u8(vdupq_n_u8(0), lead3, 15))));
+   uint8x16_t lo2 = vcleq_u8(n1, vdupq_n_u8(0x9f));
+   err = vorrq_u8(err, vandq_u8(vceqq_u8(b, vdupq_n_u8(0xe0)), lo2));
+   err = vorrq_u8(err, vbicq_u8(vceqq_u8(b, vdupq_n_u8(0xed)), lo2));
+
+   bool l3last = vgetq_lane_u8(lead3, 15) != 0;
+
+   if (vmaxvq_u8(err) != 0 || (pSrc[0] & 0xc0) == 0x80 || (l3last && (pSrc[17] & 0xc0) != 0x80))
+   {
+      return 0;
+   }
+
+   size_t cnt = 0;
+
+   for (int h = 0; h < 2; h++)
+   {
+      uint8x8_t bh = h ? vget_high_u8(b) : vget_low_u8(b);
+      uint8x8_t n1h = h ? vget_high_u8(n1) : vget_low_u8(n1);
+      uint8x8_t n2h = h ? vget_high_u8(n2) : vget_low_u8(n2);
+      uint8x8_t ch = h ? vget_high_u8(cont) : vget_low_u8(cont);
+      uint16x8_t bw = vmovl_u8(bh);
+      uint16x8_t w1 = vandq_u16(vmovl_u8(n1h), vdupq_n_u16(0x3f));
+      uint16x8_t w2 = vandq_u16(vmovl_u8(n2h), vdupq_n_u16(0x3f));
+      uint16x8_t l2 = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(h ? vget_high_u8(lead) : vget_low_u8(lead))));
+      uint16x8_t l3 = vreinterpretq_u16_s16(vmovl_s8(vreinterpret_s8_u8(h ? vget_high_u8(lead3) : vget_low_u8(lead3))));
+
+      uint16x8_t v2 = vorrq_u16(vshlq_n_u16(vandq_u16(bw, vdupq_n_u16(0x1f)), 6), w1);
+      uint16x8_t v3 = vorrq_u16(vorrq_u16(vshlq_n_u16(bw, 12), vshlq_n_u16(w1, 6)), w2);
+      uint16x8_t v = vbslq_u16(l3, v3, vbslq_u16(l2, v2, bw));
+
+      int m = vaddv_u8(vand_u8(ch, vcreate_u8(0x8040201008040201ULL)));
+
+      v = vreinterpretq_u16_u8(vqtbl1q_u8(vreinterpretq_u8_u16(v), vld1q_u8(s_Utf8Compact[m])));
+      if (Width == 2)
+      {
+         vst1q_u16((uint16_t*)((uint8_t*)pDest + cnt * 2), v);
+      }
+      else
+      {
+         vst1q_u32((uint32_t*)((uint8_t*)pDest + cnt * 4), vmovl_u16(vget_low_u16(v)));
+         vst1q_u32((uint32_t*)((uint8_t*)pDest + cnt * 4 + 16), vmovl_u16(vget_high_u16(v)));
+      }
+      cnt += s_Utf8Count[m];
+   }
+
+   *pCnt = cnt;
+
+   if (l3last)
+   {
+      return 18;
+   }
+
+   return 16 + ((vgetq_lane_u8(lead, 15) || vgetq_lane_u8(lead3, 14)) ? 1 : 0);
+}
+
+/// Same as Utf8Encode4Ssse3
+static inline int Utf8Encode4Neon(uint32x4_t C, uint8_t *pDest)
 {
-   char mask = (char)0xfc;
-   int retval = 6; 
+   static const uint32_t s_Bit[4] = { 1, 2, 4, 8 };
+   const uint32x4_t m3f = vdupq_n_u32(0x3f);
+   const uint32x4_t x80 = vdupq_n_u32(0x80);
+   uint32x4_t bad = vceqq_u32(vandq_u32(C, vdupq_n_u32(0xf800)), vdupq_n_u32(0xd800));
 
-   if ((c & 0x80) == 0)
-      return 1;
+   bad = vorrq_u32(bad, vcgeq_u32(C, vdupq_n_u32(0x10000)));
+   if (vmaxvq_u32(bad) != 0)
+   {
+      return -1;
+   }
+
+   uint32x4_t is1 = vcltq_u32(C, x80);
+   uint32x4_t is2 = vcltq_u32(C, vdupq_n_u32(0x800));
+   uint32x4_t c6 = vshrq_n_u32(C, 6);
+   uint32x4_t t0 = vorrq_u32(vshrq_n_u32(C, 12), vdupq_n_u32(0xe0));
+   uint32x4_t t1 = vbslq_u32(is2, vorrq_u32(c6, vdupq_n_u32(0xc0)), vorrq_u32(vandq_u32(c6, m3f), x80));
+   uint32x4_t t2 = vbslq_u32(is1, C, vorrq_u32(vandq_u32(C, m3f), x80));
+   uint32x4_t v = vorrq_u32(t0, vorrq_u32(vshlq_n_u32(t1, 8), vshlq_n_u32(t2, 16)));
+   uint32x4_t bit = vld1q_u32(s_Bit);
+   int m = vaddvq_u32(vandq_u32(is2, bit)) | (vaddvq_u32(vandq_u32(is1, bit)) << 4);
+
+   vst1q_u8(pDest, vqtbl1q_u8(vreinterpretq_u8_u32(v), vld1q_u8(s_Utf8Pack[m])));
+
+   return s_Utf8PackLen[m];
+}
+
+/// Same as Utf8EncodeBlockSsse3
+static size_t Utf8EncodeBlockNeon(const uint8_t *pSrc, uint8_t *pDest, int Width)
+{
+   uint32x4_t a, b;
 
+   if (Width == 2)
+   {
+      uint16x8_t v = vld1q_u16((const uint16_t*)pSrc);
 
-   while ((c & mask) != mask && retval > 0)
+      a = vmovl_u16(vget_low_u16(v));
+      b = vmovl_u16(vget_high_u16(v));
+   }
+   else
    {
-      retval--;
-      mask <<= 1;
+      a = vld1q_u32((const uint32_t*)pSrc);
+      b = vld1q_u32((const uint32_t*)&pSrc[16]);
    }
 
-   return retval;
+   int la = Utf8Encode4Neon(a, pDest);
+
+   if (la < 0)
+   {
+      return 0;
+   }
+
+   int lb = Utf8Encode4Neon(b, &pDest[la]);
+
+   if (lb < 0)
+   {
+      return 0;
+   }
+
+   return la + lb;
+}
+
+#endif   // UTF8_NEON
+
+static inline bool Utf8SimdAvail(void)
+{
+#if defined(UTF8_SSSE3)
+   return s_bUtf8Simd && __builtin_cpu_supports("ssse3");
+#elif defined(UTF8_NEON)
+   return s_bUtf8Simd;
+#else
+   return false;
+#endif
+}
+
+bool utf8setsimd(bool bEnable)
+{
+   s_bUtf8Simd = bEnable;
+
+#if defined(UTF8_SSSE3)
+   return __builtin_cpu_supports("ssse3");
+#elif defined(UTF8_NEON)
+   return true;
+#else
+   return false;
+#endif
 }
 
-int wcstoutf8_octetcount(int c)
+/**
+ * Precise scalar validation, byte at a time
+ */
+static int Utf8ValidateBytes(const uint8_t *pSrc, size_t Len, size_t *pValidSize)
 {
-   if (c < 0x80)
+   const uint8_t *s = pSrc, *end = pSrc + Len, *seq = pSrc;
+   uint32_t state = UTF8_ACCEPT;
+
+   for (; s < end; s++)
+   {
+      if (state == UTF8_ACCEPT)
+      {
+         seq = s;
+      }
+      state = Utf8DfaNext(state, *s);
+      if (state == UTF8_REJECT)
+      {
+         *pValidSize = seq - pSrc;
+         return -1;
+      }
+   }
+
+   if (state != UTF8_ACCEPT)
+   {
+      *pValidSize = seq - pSrc;
       return 1;
+   }
+
+   *pValidSize = Len;
+
+   return 0;
+}
+
+/**
+ * Scalar validation, 8 bytes per step. ASCII words are skipped, others run
+ * through the DFA without branches as the reject state is final. A failing
+ * word is rescanned byte at a time for the error position.
+ */
+static int Utf8ValidateScalar(const uint8_t *pSrc, size_t Len, size_t *pValidSize)
+{
+   uint32_t state = UTF8_ACCEPT;
+   size_t i = 0, valid;
+   int res;
+
+   for (; i + 8 <= Len; i += 8)
+   {
+      uint64_t w;
+
+      memcpy(&w, &pSrc[i], 8);
+      if (state == UTF8_ACCEPT && (w & ASCII_MASK64) == 0)
+      {
+         continue;
+      }
+
+      uint32_t st = state;
+
+      for (int k = 0; k < 8; k++)
+      {
+         st = Utf8DfaNext(st, pSrc[i + k]);
+      }
+      if (st == UTF8_REJECT)
+      {
+         break;
+      }
+      state = st;
+   }
+
+   // Resume from the sequence open at i, if any
+   size_t start = Utf8SeqStart(pSrc, i);
+
+   res = Utf8ValidateBytes(&pSrc[start], Len - start, &valid);
+   *pValidSize = start + valid;
+
+   return res;
+}
+
+int utf8validate(const char *pSrc, size_t SrcSize, size_t *pValidSize)
+{
+   const uint8_t *s = (const uint8_t*)pSrc;
+   size_t valid, i = 0;
+   int res;
+
+   if (pSrc == NULL)
+   {
+      if (pValidSize)
+      {
+         *pValidSize = 0;
+      }
+      return SrcSize > 0 ? -1 : 0;
+   }
+
+   if (Utf8SimdAvail())
+   {
+#if defined(UTF8_SSSE3)
+      i = Utf8ValidateSsse3(s, SrcSize);
+#elif defined(UTF8_NEON)
+      i = Utf8ValidateNeon(s, SrcSize);
+#endif
+   }
+
+   res = Utf8ValidateScalar(s + i, SrcSize - i, &valid);
+
+   if (pValidSize)
+   {
+      *pValidSize = i + valid;
+   }
+
+   return res;
+}
+
+/**
+ * UTF-8 to UTF-16 or UTF-32, Width is code unit size in bytes
+ */
+UTF8_INLINE int Utf8Decode(const char *pSrc, size_t *pSrcSize, void *pDest, size_t *pDestLen, int Width)
+{
+   const uint8_t *s = (const uint8_t*)pSrc, *end = s + *pSrcSize;
+   size_t d = 0, dlen = *pDestLen;
+   int res = 0;
+
+#if defined(UTF8_SSSE3) || defined(UTF8_NEON)
+   const uint8_t *retry = s;
+   bool simd = Utf8SimdAvail();
+
+   if (simd && s_bUtf8CompactInit == false)
+   {
+      Utf8CompactInit();
+   }
+#endif
+
+   while (s < end)
+   {
+      if (d >= dlen)
+      {
+         res = 1;
+         break;
+      }
+
+#if defined(UTF8_SSSE3) || defined(UTF8_NEON)
+      if (simd && end - s >= 18 && dlen - d >= 16)
+      {
+         size_t room = (size_t)(end - s) < dlen - d ? (size_t)(end - s) : dlen - d;
+         size_t n = 0, cnt = 0;
+
+         // ASCII run first, then mixed blocks of 1 to 3 bytes sequences
+         if (*s < 0x80)
+         {
+#if defined(UTF8_SSSE3)
+            n = Utf8AsciiWidenSsse3(s, room, (uint8_t*)pDest + d * Width, Width);
+#elif defined(UTF8_NEON)
+            n = Utf8AsciiWidenNeon(s, room, (uint8_t*)pDest + d * Width, Width);
+#endif
+            cnt = n;
+         }
+         if (n == 0 && s >= retry)
+         {
+#if defined(UTF8_SSSE3)
+            n = Utf8DecodeBlockSsse3(s, (uint8_t*)pDest + d * Width, Width, &cnt);
+#elif defined(UTF8_NEON)
+            n = Utf8DecodeBlockNeon(s, (uint8_t*)pDest + d * Width, Width, &cnt);
+#endif
+            if (n == 0)
+            {
+               // Has 4 bytes sequences or error, scalar until next block
+               retry = s + 16;
+            }
+         }
+         if (n > 0)
+         {
+            s += n;
+            d += cnt;
+            continue;
+         }
+      }
+#endif
+
+      if (*s < 0x80)
+      {
+         size_t n = (size_t)(end - s) < dlen - d ? (size_t)(end - s) : dlen - d;
+         size_t k = 0;
+
+         while (k + 8 <= n)
+         {
+            uint64_t w;
+
+            memcpy(&w, &s[k], 8);
+            if (w & ASCII_MASK64)
+            {
+               break;
+            }
+            for (int i = 0; i < 8; i++)
+            {
+               Utf8StoreUnit(pDest, d + k + i, s[k + i], Width);
+            }
+            k += 8;
+         }
+
+         while (k < n && s[k] < 0x80)
+         {
+            Utf8StoreUnit(pDest, d + k, s[k], Width);
+            k++;
+         }
+
+         s += k;
+         d += k;
+         continue;
+      }
+
+      uint32_t cp;
+      int cnt = Utf8DecodeOne(s, end, &cp);
+
+      if (cnt <= 0)
+      {
+         res = cnt < 0 ? -1 : 1;
+         break;
+      }
+
+      if (Width == 2 && cp >= 0x10000)
+      {
+         if (dlen - d < 2)
+         {
+            res = 1;
+            break;
+         }
+         cp -= 0x10000;
+         Utf8StoreUnit(pDest, d++, 0xd800 | (cp >> 10), Width);
+         Utf8StoreUnit(pDest, d++, 0xdc00 | (cp & 0x3ff), Width);
+      }
+      else
+      {
+         Utf8StoreUnit(pDest, d++, cp, Width);
+      }
+      s += cnt;
+   }
+
+   *pSrcSize = s - (const uint8_t*)pSrc;
+   *pDestLen = d;
+
+   return res;
+}
+
+/**
+ * UTF-16 or UTF-32 to UTF-8, Width is code unit size in bytes
+ */
+UTF8_INLINE int Utf8Encode(const void *pSrc, size_t *pSrcLen, char *pDest, size_t *pDestSize, int Width)
+{
+   uint8_t *d = (uint8_t*)pDest;
+   size_t s = 0, slen = *pSrcLen;
+   size_t di = 0, dsize = *pDestSize;
+   int res = 0;
+
+#if defined(UTF8_SSSE3) || defined(UTF8_NEON)
+   size_t retry = 0;
+   bool simd = Utf8SimdAvail();
+
+   if (simd && s_bUtf8CompactInit == false)
+   {
+      Utf8CompactInit();
+   }
+#endif
+
+   while (s < slen)
+   {
+      uint32_t c = Utf8LoadUnit(pSrc, s, Width);
+
+#if defined(UTF8_SSSE3) || defined(UTF8_NEON)
+      if (simd && slen - s >= 16 && dsize - di >= 32)
+      {
+         const uint8_t *p = (const uint8_t*)pSrc + s * Width;
+         size_t n = 0;
+
+         // ASCII run first, then blocks of code points below U+10000
+         if (c < 0x80)
+         {
+#if defined(UTF8_SSSE3)
+            n = Utf8AsciiNarrowSsse3(p, slen - s < dsize - di ? slen - s : dsize - di, &d[di], Width);
+#elif defined(UTF8_NEON)
+            n = Utf8AsciiNarrowNeon(p, slen - s < dsize - di ? slen - s : dsize - di, &d[di], Width);
+#endif
+            if (n > 0)
+            {
+               s += n;
+               di += n;
+               continue;
+            }
+         }
+         if (s >= retry)
+         {
+#if defined(UTF8_SSSE3)
+            n = Utf8EncodeBlockSsse3(p, &d[di], Width);
+#elif defined(UTF8_NEON)
+            n = Utf8EncodeBlockNeon(p, &d[di], Width);
+#endif
+            if (n > 0)
+            {
+               s += 8;
+               di += n;
+               continue;
+            }
+            // Has surrogates or errors, scalar until next block
+            retry = s + 8;
+         }
+      }
+#endif
+
+      if (c < 0x80)
+      {
+         size_t n = slen - s < dsize - di ? slen - s : dsize - di;
+         size_t k = 0;
+
+         if (n == 0)
+         {
+            res = 1;
+            break;
+         }
+
+         while (k < n && (c = Utf8LoadUnit(pSrc, s + k, Width)) < 0x80)
+         {
+            d[di + k] = (uint8_t)c;
+            k++;
+         }
+
+         s += k;
+         di += k;
+         continue;
+      }
+
+      size_t used = 1;
+
+      if (c >= 0xd800 && c < 0xe000)
+      {
+         if (Width != 2 || c >= 0xdc00)
+         {
+            // Surrogate in UTF-32 or unpaired low surrogate
+            res = -1;
+            break;
+         }
+         if (s + 1 >= slen)
+         {
+            res = 1;
+            break;
+         }
+
+         uint32_t lo = Utf8LoadUnit(pSrc, s + 1, Width);
+
+         if (lo < 0xdc00 || lo >= 0xe000)
+         {
+            res = -1;
+            break;
+         }
+         c = 0x10000 + ((c - 0xd800) << 10) + (lo - 0xdc00);
+         used = 2;
+      }
+      else if (c > 0x10ffff)
+      {
+         res = -1;
+         break;
+      }
+
+      int cnt = c < 0x800 ? 2 : c < 0x10000 ? 3 : 4;
+
+      if (dsize - di < (size_t)cnt)
+      {
+         res = 1;
+         break;
+      }
+
+      switch (cnt)
+      {
+         case 2:
+            d[di++] = 0xc0 | (c >> 6);
+            break;
+         case 3:
+            d[di++] = 0xe0 | (c >> 12);
+            d[di++] = 0x80 | ((c >> 6) & 0x3f);
+            break;
+         default:
+            d[di++] = 0xf0 | (c >> 18);
+            d[di++] = 0x80 | ((c >> 12) & 0x3f);
+            d[di++] = 0x80 | ((c >> 6) & 0x3f);
+            break;
+      }
+      d[di++] = 0x80 | (c & 0x3f);
+      s += used;
+   }
+
+   *pSrcLen = s;
+   *pDestSize = di;
 
-   if (c < 0x800)
-      return 2;
+   return res;
+}
 
-   if (sizeof(c) < 3 || c < 0x10000)
-      return 3;
+int utf8toutf16(const char *pSrc, size_t *pSrcSize, uint16_t *pDest, size_t *pDestLen)
+{
+   return Utf8Decode(pSrc, pSrcSize, pDest, pDestLen, 2);
+}
 
-   if (c < 0x200000)
-      return 4;
+int utf8toutf32(const char *pSrc, size_t *pSrcSize, uint32_t *pDest, size_t *pDestLen)
+{
+   return Utf8Decode(pSrc, pSrcSize, pDest, pDestLen, 4);
+}
 
-   if (c < 0x4000000)
-      return 5;
+int utf16toutf8(const uint16_t *pSrc, size_t *pSrcLen, char *pDest, size_t *pDestSize)
+{
+   return Utf8Encode(pSrc, pSrcLen, pDest, pDestSize, 2);
+}
 
-   return 6;
+int utf32toutf8(const uint32_t *pSrc, size_t *pSrcLen, char *pDest, size_t *pDestSize)
+{
+   return Utf8Encode(pSrc, pSrcLen, pDest, pDestSize, 4);
 }
 
 size_t utf8towcs_length(const char *pSrc, size_t SrcSize, size_t DestLen)
 {
+   const uint8_t *s = (const uint8_t*)pSrc, *end = s + SrcSize;
    size_t retval = 0;
-   size_t cnt, len = 0;
 
-   while (len < SrcSize && retval < DestLen)
+   while (s < end && retval < DestLen)
    {
-      cnt = uft8towcs_octetcount(*pSrc);
-      if (cnt <= 0 || (len + cnt) > SrcSize)
-         break;
+      uint32_t cp = *s;
+      int cnt = 1;
+
+      if (cp >= 0x80)
+      {
+         cnt = Utf8DecodeOne(s, end, &cp);
+         if (cnt <= 0)
+            break;
+      }
 
+      if (sizeof(wchar_t) == 2 && cp >= 0x10000)
+      {
+         if (retval + 2 > DestLen)
+            break;
+         retval++;
+      }
       retval++;
-      pSrc += cnt;
+      s += cnt;
    }
 
    return retval;
@@ -106,72 +1407,26 @@ size_t utf8towcs_length(const char *pSrc, size_t SrcSize, size_t DestLen)
  */ 
 int utf8towcs(const char *pSrc, int *pSrcSize, wchar_t *pDest, int *pDestLen)
 {
-   int retval = 0, len;
-   char *srcend;
-   wchar_t *destend;
-   
+   size_t srcsize, destlen;
+   int retval;
+
    if (pSrc == NULL || pDest == NULL || pSrcSize == NULL || *pSrcSize <= 0 || pDestLen == NULL || *pDestLen <=0)
    {
       if (pSrcSize)
          *pSrcSize = 0;
-      if (*pDestLen)
-      {
+      if (pDestLen)
          *pDestLen = 0;
-      }
+
       return -1;
    }
 
-   len = *pSrcSize;
-   srcend = (char *)pSrc + *pSrcSize;
-   destend = pDest + *pDestLen;
-   *pSrcSize = 0;
-   *pDestLen = 0;
-   while (pSrc < srcend && pDest < destend)
-   {
-      int cnt = uft8towcs_octetcount(*pSrc);
-
-      if (cnt <= 0)
-      {
-         return -1;
-      }
-      if (cnt > len)
-         return 1;
-
-      if (cnt > 1)
-      {
-         char mask = (char)0x7f;
-         //char *b = (char *)pSrc;
-         int i;
-
-         *pDest = (*pSrc & (mask >> cnt));
-         pSrc++;
-         ++*pSrcSize;
+   srcsize = *pSrcSize;
+   destlen = *pDestLen;
+   retval = Utf8Decode(pSrc, &srcsize, pDest, &destlen, sizeof(wchar_t));
+   *pSrcSize = (int)srcsize;
+   *pDestLen = (int)destlen;
 
-         for (i = 1; i < cnt && pSrc != srcend; i++)
-         {
-            if ((*pSrc & 0xc0) != 0x80)
-            {
-               return retval;
-            }
-            *pDest <<= 6;
-            *pDest |= (*pSrc & 0x3f);
-            pSrc++;
-            ++*pSrcSize;
-         }
-      }
-      else
-      {
-         *pDest = (*pSrc & 0x7f);
-         pSrc++;
-         ++*pSrcSize;
-      }
-      pDest++;
-      ++*pDestLen;
-      retval++;
-      len -= cnt;
-   } 
-   
-   return 0;
+   return retval;
 }
 
 /**
@@ -190,12 +1445,8 @@ int utf8towcs(const char *pSrc, int *pSrcSize, wchar_t *pDest, int *pDestLen)
  */ 
 int wcstoutf8(const wchar_t *pSrc, int *pSrcLen, char *pDest, int *pDestSize)
 {
-  // int retval = 0;
-   wchar_t *srcend;
-   char *destend;
-   char *p, mask;
-   wchar_t c;
-   int i;
+   size_t srclen, destsize;
+   int retval;
 
    if (pSrc == NULL || pDest == NULL || pSrcLen == NULL || *pSrcLen <= 0 || pDestSize == NULL || *pDestSize <=0)
    {
@@ -207,47 +1458,11 @@ int wcstoutf8(const wchar_t *pSrc, int *pSrcLen, char *pDest, int *pDestSize)
       return -1;
    }
 
-   srcend = (wchar_t *)pSrc + *pSrcLen;
-   destend = (char *)pDest + *pDestSize;
-   *pSrcLen = 0;
-   *pDestSize = 0;
-
-   while (pSrc < srcend && pDest < destend)
-   {
-      int cnt = wcstoutf8_octetcount(*pSrc);
-
-      if (cnt > 1)
-      {
-         if ((pDest + cnt) >= destend)
-         {
-            return 1;
-         }
-
-         p = pDest + cnt - 1;
-         c = *pSrc;
-
-         for (i = 1; i < cnt; i++)
-         {
-            *p = 0x80 | (c & 0x3f);
-            p--;
-            c >>= 6;
-         }
-         mask = 0xfc << (6 - cnt);
-         
-         *p = mask | (c & ~mask);
-         pDest += cnt;
-         (*pDestSize) += cnt;
-      }
-      else
-      {
-         *pDest = (char)*pSrc;
-         pDest++;
-         ++*pDestSize;
-      }
-
-      pSrc++;
-      ++*pSrcLen;
-   }
+   srclen = *pSrcLen;
+   destsize = *pDestSize;
+   retval = Utf8Encode(pSrc, &srclen, pDest, &destsize, sizeof(wchar_t));
+   *pSrcLen = (int)srclen;
+   *pDestSize = (int)destsize;
 
-   return 0;
+   return retval;
 }
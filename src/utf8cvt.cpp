@@ -50,10 +50,26 @@ codecvt_base::result codecvt_utf8::do_in(mbstate_t &state, const char *from,
    return codecvt_base::ok;
 }
 
-int codecvt_utf8::do_length(const mbstate_t &, const char *from, 
+// Number of bytes that convert to at most limit wchar_t
+int codecvt_utf8::do_length(mbstate_t &, const char *from, 
                             const char *from_end, size_t limit) const throw()
 {
-   return utf8towcs_length(from, from_end - from, limit);
+   wchar_t buf[256];
+   const char *p = from;
+
+   while (p < from_end && limit > 0)
+   {
+      int len = from_end - p;
+      int destlen = limit < 256 ? limit : 256;
+
+      int res = utf8towcs(p, &len, buf, &destlen);
+      p += len;
+      limit -= destlen;
+      if (res < 0 || len == 0)
+         break;
+   }
+
+   return p - from;
 }
 
 codecvt_base::result codecvt_utf8::do_out(mbstate_t &state, const wchar_t *from, 